@@ -21,6 +21,7 @@ public:
 	static obj<Buffer> createIndex(obj<DeviceMemory> memory, size_t offset, IndexType type, size_t count);
 	static obj<Buffer> createUniform(obj<Device> device, size_t size);
 	static obj<Buffer> createStorage(obj<Device> device, size_t size);
+	static obj<Buffer> createIndirect(obj<Device> device, size_t size);
 	static obj<Buffer> createStaging(obj<Device> device, size_t size);
 	static obj<Buffer> create(obj<Device> device, const BufferCreateInfo& info);
 	static obj<Buffer> create(obj<DeviceMemory> memory, size_t offset, const BufferCreateInfo& info);
@@ -28,11 +29,27 @@ public:
 
 	void resize(size_t new_size);
 
+	// buffers may share device memory, map() already points at this buffer's range
+	VERA_NODISCARD void* map();
+	void flush();
+
+	// host visible buffers are written in place, others go through the device staging ring
+	template <class T>
+	void upload(array_view<T> arr, size_t offset = 0);
+	void upload(const void* data, size_t size, size_t offset = 0);
+
 	obj<DeviceMemory> getDeviceMemory();
 
 	BufferUsageFlags getUsageFlags() const;
 
+	size_t offset() const;
 	size_t size() const;
 };
 
+template <class T>
+void Buffer::upload(array_view<T> arr, size_t offset)
+{
+	upload(arr.data(), arr.size() * sizeof(T), offset);
+}
+
 VERA_NAMESPACE_END
\ No newline at end of file
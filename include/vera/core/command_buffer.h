@@ -15,11 +15,48 @@ class Pipeline;
 class PipelineLayout;
 class ShaderParameter;
 class DescriptorSet;
+class RenderContext;
 class Buffer;
 class Texture;
 class GraphicsState;
 class ShaderParameter;
 
+enum class CommandBufferLevel VERA_ENUM
+{
+	Primary,
+	Secondary
+};
+
+enum class RenderingContents VERA_ENUM
+{
+	Inline,
+	SecondaryCommandBuffers
+};
+
+VERA_VK_ABI_COMPATIBLE struct DrawIndirectCommand
+{
+	uint32_t vertexCount;
+	uint32_t instanceCount;
+	uint32_t firstVertex;
+	uint32_t firstInstance;
+};
+
+VERA_VK_ABI_COMPATIBLE struct DrawIndexedIndirectCommand
+{
+	uint32_t indexCount;
+	uint32_t instanceCount;
+	uint32_t firstIndex;
+	int32_t  vertexOffset;
+	uint32_t firstInstance;
+};
+
+VERA_VK_ABI_COMPATIBLE struct DrawMeshTaskIndirectCommand
+{
+	uint32_t groupCountX;
+	uint32_t groupCountY;
+	uint32_t groupCountZ;
+};
+
 struct Viewport
 {
 	float posX     = 0.f;
@@ -79,20 +116,45 @@ struct SubmitInfo
 	small_vector<SignalInfo> signalInfos;
 };
 
+// counts of state commands issued by bindShaderParameter since the last reset,
+// skipped counts are binds elided because the same state was already bound
+struct CommandBufferBindStatistics
+{
+	uint32_t descriptorSetBinds;        // bindDescriptorSets calls recorded
+	uint32_t descriptorSetsBound;       // descriptor sets covered by those calls
+	uint32_t descriptorSetsSkipped;
+	uint32_t pushConstantRanges;
+	uint32_t pushConstantRangesSkipped;
+};
+
 class CommandBuffer : public CoreObject // TODO: consider rename to command buffer
 {
 	VERA_CORE_OBJECT_INIT(CommandBuffer)
 public:
 	static obj<CommandBuffer> create(obj<Device> device);
+	// secondary command buffer of the current frame taken from the calling thread's pool, it must be
+	// recorded on that thread and is recycled with the frame, so it cannot be reset or kept
+	static obj<CommandBuffer> createSecondary(obj<RenderContext> render_context);
 	~CommandBuffer() VERA_NOEXCEPT override;
 
 	VERA_NODISCARD obj<Device> getDevice() VERA_NOEXCEPT;
 
+	VERA_NODISCARD CommandBufferLevel getLevel() const VERA_NOEXCEPT;
 	VERA_NODISCARD CommandSync getSync() const VERA_NOEXCEPT;
+	VERA_NODISCARD CommandBufferBindStatistics getBindStatistics() const VERA_NOEXCEPT;
 
 	void reset();
 
 	void begin();
+	// begins a secondary command buffer continuing the rendering of info started by its primary
+	void begin(const RenderingInfo& info);
+
+	void copyBuffer(
+		ref<Buffer> dst,
+		ref<Buffer> src,
+		size_t      dst_offset,
+		size_t      src_offset,
+		size_t      size);
 
 	void copyBufferToTexture(
 		ref<Texture> dst,
@@ -141,6 +203,7 @@ public:
 	void bindShaderParameter(ref<ShaderParameter> params);
 
 	void beginRendering(const RenderingInfo& info);
+	void beginRendering(const RenderingInfo& info, RenderingContents contents);
 
 	void draw(
 		uint32_t vtx_count,
@@ -160,8 +223,58 @@ public:
 		uint32_t group_count_y,
 		uint32_t group_count_z);
 
+	// indirect draws read draw_count commands stride bytes apart from an IndirectBuffer buffer,
+	// more than one draw needs DeviceFeatureType::MultiDrawIndirect and a nonzero firstInstance
+	// needs DeviceFeatureType::DrawIndirectFirstInstance
+	void drawIndirect(
+		cref<Buffer> buffer,
+		size_t       offset,
+		uint32_t     draw_count,
+		uint32_t     stride = sizeof(DrawIndirectCommand));
+
+	void drawIndexedIndirect(
+		cref<Buffer> buffer,
+		size_t       offset,
+		uint32_t     draw_count,
+		uint32_t     stride = sizeof(DrawIndexedIndirectCommand));
+
+	void drawMeshTaskIndirect(
+		cref<Buffer> buffer,
+		size_t       offset,
+		uint32_t     draw_count,
+		uint32_t     stride = sizeof(DrawMeshTaskIndirectCommand));
+
+	// the draw count is read from count_buffer on the device and clamped to max_draw_count,
+	// needs DeviceFeatureType::DrawIndirectCount
+	void drawIndirectCount(
+		cref<Buffer> buffer,
+		size_t       offset,
+		cref<Buffer> count_buffer,
+		size_t       count_offset,
+		uint32_t     max_draw_count,
+		uint32_t     stride = sizeof(DrawIndirectCommand));
+
+	void drawIndexedIndirectCount(
+		cref<Buffer> buffer,
+		size_t       offset,
+		cref<Buffer> count_buffer,
+		size_t       count_offset,
+		uint32_t     max_draw_count,
+		uint32_t     stride = sizeof(DrawIndexedIndirectCommand));
+
+	void drawMeshTaskIndirectCount(
+		cref<Buffer> buffer,
+		size_t       offset,
+		cref<Buffer> count_buffer,
+		size_t       count_offset,
+		uint32_t     max_draw_count,
+		uint32_t     stride = sizeof(DrawMeshTaskIndirectCommand));
+
 	void endRendering();
 
+	// secondary command buffers leave the bound state of this one undefined
+	void executeCommands(array_view<obj<CommandBuffer>> cmd_buffers);
+
 	void end();
 
 	CommandSync submit(const SubmitInfo& info = {});
@@ -16,6 +16,7 @@ class Texture;
 class TextureView;
 class Buffer;
 class BufferView;
+class CommandSync;
 
 struct DeviceFaultAddressInfo
 {
@@ -50,18 +51,40 @@ struct DeviceMemoryType
 	MemoryPropertyFlags propertyFlags;
 };
 
+struct DeviceMemoryStatistics
+{
+	uint32_t blockCount;
+	uint32_t allocationCount;
+	uint32_t freeRangeCount;
+	size_t   blockBytes;
+	size_t   allocationBytes;
+	size_t   largestFreeRange;
+	float    fragmentation; // 0 when all free space is contiguous, approaches 1 as it scatters
+};
+
 struct DeviceCreateInfo
 {
-	std::vector<std::string_view> deviceLayers          = {};
-	std::vector<std::string_view> deviceExtensions      = {};
+	std::vector<std::string_view> deviceLayers               = {};
+	std::vector<std::string_view> deviceExtensions           = {};
+
+	uint32_t                      deviceID                   = 0;
 
-	uint32_t                      deviceID              = 0;
+	Format                        colorFormat                = Format::RGBA8Unorm;
+	Format                        depthFormat                = Format::D32Float;
 
-	Format                        colorFormat           = Format::RGBA8Unorm;
-	Format                        depthFormat           = Format::D32Float;
+	bool                          enablePipelineCache        = true;
+	std::string_view              pipelineCacheFilePath      = {};
 
-	bool                          enablePipelineCache   = true;
-	std::string_view              pipelineCacheFilePath = {};
+	// every pipeline built is recorded here, on the next run they are compiled in the background
+	std::string_view              pipelineIndexFilePath      = {};
+	bool                          precompilePipelines        = true;
+	uint32_t                      pipelineCompileThreadCount = 0; // 0 uses half of the hardware threads
+
+	// shader reflections are stored here, on the next run shaders found in it are not parsed
+	std::string_view              reflectionCacheFilePath    = {};
+
+	size_t                        memoryBlockSize            = VERA_MIB(64);
+	size_t                        stagingRingSize            = VERA_MIB(32);
 };
 
 class Device : public CoreObject
@@ -82,9 +105,16 @@ public:
 	VERA_NODISCARD bool isFeatureEnabled(DeviceFeatureType feature) const VERA_NOEXCEPT;
 
 	array_view<DeviceMemoryType> enumerateMemoryTypes() const;
+
+	VERA_NODISCARD DeviceMemoryStatistics getMemoryStatistics() const;
+	VERA_NODISCARD DeviceMemoryStatistics getMemoryStatistics(uint32_t memory_type_index) const;
 	
 	DeviceFaultInfo getDeviceFaultInfo() const;
 
+	// submits copies gathered by Texture::upload, Buffer::upload and DeviceMemory::upload,
+	// this happens implicitly before any command buffer submission on the device
+	CommandSync flushUploads();
+
 	void waitIdle() const;
 };
 
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "buffer.h"
+#include "command_buffer.h"
+#include "../util/array_view.h"
+#include <vector>
+
+VERA_NAMESPACE_BEGIN
+
+// index range of a mesh in the bound vertex and index buffers
+struct DrawMeshRange
+{
+	uint32_t indexCount   = 0;
+	uint32_t firstIndex   = 0;
+	int32_t  vertexOffset = 0;
+};
+
+// draws of one bucket, their commands and instance data are contiguous
+struct DrawPacket
+{
+	uint32_t bucket;
+	uint32_t firstCommand;
+	uint32_t commandCount;
+	uint32_t firstInstance;
+	uint32_t instanceCount;
+};
+
+// Builds the indirect draw stream of a frame on the CPU, without touching the device.
+// Every draw is added to a bucket, usually one per material, with instance_size bytes of per draw
+// data. build() orders the draws by bucket and first index, merges draws of the same mesh into one
+// instanced command and lays the instance data out so that firstInstance of a command indexes its
+// first element, shaders find their data at gl_InstanceIndex, which needs the device feature
+// DrawIndirectFirstInstance. One packet per bucket is submitted with one drawIndexedIndirect() call.
+class DrawPacketBuilder
+{
+public:
+	DrawPacketBuilder(uint32_t instance_size) VERA_NOEXCEPT;
+
+	void clear() VERA_NOEXCEPT;
+	void reserve(size_t draw_count);
+
+	// instance_data holds getInstanceSize() bytes, it may be null when the size is zero
+	void add(uint32_t bucket, const DrawMeshRange& mesh, const void* instance_data);
+
+	template <class T>
+	void add(uint32_t bucket, const DrawMeshRange& mesh, const T& instance);
+
+	// builds packets of the draws added since clear(), packets are ordered by bucket
+	void build();
+
+	// dst buffers hold getCommandSize() and getInstanceDataSize() bytes, usually mapped memory
+	void write(void* command_dst, void* instance_dst) const;
+
+	VERA_NODISCARD array_view<DrawPacket> getPackets() const VERA_NOEXCEPT;
+	VERA_NODISCARD array_view<DrawIndexedIndirectCommand> getCommands() const VERA_NOEXCEPT;
+	VERA_NODISCARD uint32_t getInstanceSize() const VERA_NOEXCEPT;
+	VERA_NODISCARD uint32_t getDrawCount() const VERA_NOEXCEPT;
+	VERA_NODISCARD size_t getCommandSize() const VERA_NOEXCEPT;
+	VERA_NODISCARD size_t getInstanceDataSize() const VERA_NOEXCEPT;
+
+private:
+	struct Draw
+	{
+		uint32_t      bucket;
+		DrawMeshRange mesh;
+	};
+
+	struct SortItem
+	{
+		uint64_t key; // bucket and first index
+		uint32_t draw;
+	};
+
+	uint32_t                                m_instance_size;
+	std::vector<Draw>                       m_draws;          // in the order of add()
+	std::vector<std::byte>                  m_instance_data;  // in the order of add()
+	std::vector<uint32_t>                   m_instance_order; // add() order of each built instance
+	std::vector<DrawIndexedIndirectCommand> m_commands;
+	std::vector<DrawPacket>                 m_packets;
+	std::vector<SortItem>                   m_sort_items;
+	std::vector<SortItem>                   m_sort_temp;
+};
+
+// Indirect and instance buffers of a DrawPacketBuilder written through their persistent mapping.
+// upload() overwrites the buffers in place, so the device must be done reading them, keep one
+// per frame in flight.
+class DrawPacketBuffer : public ManagedObject
+{
+	DrawPacketBuffer() VERA_NOEXCEPT = default;
+public:
+	VERA_NODISCARD static obj<DrawPacketBuffer> create(obj<Device> device);
+	~DrawPacketBuffer() VERA_NOEXCEPT = default;
+
+	// returns true when a buffer was recreated to grow, descriptors of the instance buffer must be
+	// written again then
+	bool upload(const DrawPacketBuilder& builder);
+
+	VERA_NODISCARD obj<Buffer> getIndirectBuffer() const VERA_NOEXCEPT;
+	VERA_NODISCARD obj<Buffer> getInstanceBuffer() const VERA_NOEXCEPT;
+
+	// byte offset of the first command of packet in the indirect buffer
+	VERA_NODISCARD static size_t getCommandOffset(const DrawPacket& packet) VERA_NOEXCEPT;
+
+private:
+	obj<Device> m_device;
+	obj<Buffer> m_indirect_buffer;
+	obj<Buffer> m_instance_buffer;
+};
+
+template <class T>
+void DrawPacketBuilder::add(uint32_t bucket, const DrawMeshRange& mesh, const T& instance)
+{
+	VERA_ASSERT_MSG(sizeof(T) == m_instance_size, "instance type does not match the instance size");
+	add(bucket, mesh, static_cast<const void*>(&instance));
+}
+
+VERA_NAMESPACE_END
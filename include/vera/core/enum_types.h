@@ -59,6 +59,9 @@ enum class DeviceFeatureType VERA_ENUM
 	MeshShaderQueries,
 	RayTracing,
 	DeviceFault,
+	MultiDrawIndirect,
+	DrawIndirectFirstInstance,
+	DrawIndirectCount,
 	__COUNT__
 };
 
@@ -112,6 +112,8 @@ class ManagedObject abstract
 	friend class cref;
 	template <class Object>
 	friend class ref;
+	template <class Target, class T>
+	friend obj<Target> try_obj_cast(ref<T>) VERA_NOEXCEPT;
 
 protected:
 	VERA_INLINE ManagedObject() VERA_NOEXCEPT :
@@ -132,6 +134,8 @@ class obj
 	friend class obj;
 	template <class Target, class T>
 	friend VERA_CONSTEXPR obj<Target> obj_cast(obj<T>) VERA_NOEXCEPT;
+	template <class Target, class T>
+	friend obj<Target> try_obj_cast(ref<T>) VERA_NOEXCEPT;
 public:
 	VERA_INLINE obj() VERA_NOEXCEPT :
 		m_ptr(nullptr) {}
@@ -708,4 +712,25 @@ VERA_NODISCARD VERA_CONSTEXPR obj<Target> unsafe_obj_cast(ref<T> source) VERA_NO
 	return obj<Target>(source.get());
 }
 
+// Takes a reference only while the object is still alive, returns null once its destructor has started.
+// Meant for caches shared between threads, where the entry may be erased concurrently by its destructor.
+template <class Target, class T>
+VERA_NODISCARD obj<Target> try_obj_cast(ref<T> source) VERA_NOEXCEPT
+{
+	ManagedObject* ptr = static_cast<ManagedObject*>(source.get());
+	obj<Target>    result;
+
+	if (!ptr) return result;
+
+	uint64_t count = ptr->m_atomic.load(std::memory_order_relaxed);
+
+	do {
+		if (count == 0) return result;
+	} while (!ptr->m_atomic.compare_exchange_weak(count, count + 1, std::memory_order_acquire));
+
+	result.m_ptr = ptr;
+
+	return result;
+}
+
 VERA_NAMESPACE_END
@@ -131,9 +131,20 @@ public:
 	static obj<Pipeline> create(obj<Device> device, const GraphicsPipelineCreateInfo& info);
 	static obj<Pipeline> create(obj<Device> device, const MeshPipelineCreateInfo& info);
 	static obj<Pipeline> create(obj<Device> device, const ComputePipelineCreateInfo& info);
+
+	// Returns at once and compiles on the device's compile workers. While it is not ready,
+	// binding it binds the fallback instead, which must use a compatible pipeline layout.
+	// Without a fallback the bind waits for the compile. A pipeline that was already requested
+	// is returned as is, keeping the fallback it was first created with.
+	static obj<Pipeline> createAsync(obj<Device> device, const GraphicsPipelineCreateInfo& info, obj<Pipeline> fallback = {});
+	static obj<Pipeline> createAsync(obj<Device> device, const MeshPipelineCreateInfo& info, obj<Pipeline> fallback = {});
+	static obj<Pipeline> createAsync(obj<Device> device, const ComputePipelineCreateInfo& info, obj<Pipeline> fallback = {});
 	~Pipeline() VERA_NOEXCEPT override;
 
 	VERA_NODISCARD obj<Device> getDevice() const VERA_NOEXCEPT;
+	VERA_NODISCARD obj<Pipeline> getFallback() const VERA_NOEXCEPT;
+	VERA_NODISCARD bool isReady() const VERA_NOEXCEPT;
+	void waitReady() const; // rethrows the compile error if compiling failed
 	VERA_NODISCARD obj<PipelineLayout> getPipelineLayout() const VERA_NOEXCEPT;
 	VERA_NODISCARD array_view<obj<Shader>> enumerateShaders() const VERA_NOEXCEPT;
 	VERA_NODISCARD obj<Shader> getShader(ShaderStageFlagBits stage_flag) const VERA_NOEXCEPT;
@@ -57,6 +57,18 @@ public:
 		uint32_t             idx_off,
 		uint32_t             vtx_off);
 
+	// draws draw_count commands of an indirect buffer with one state bind, such as a DrawPacket
+	void drawIndexedIndirect(
+		const GraphicsState& states,
+		obj<ShaderParameter> param,
+		cref<Buffer>         buffer,
+		size_t               offset,
+		uint32_t             draw_count);
+
+	// renders secondary command buffers of the current frame into the attachments of info, which
+	// must match the info they were begun with, see CommandBuffer::createSecondary()
+	void executeCommands(const RenderingInfo& info, array_view<obj<CommandBuffer>> cmd_buffers);
+
 	void submit(const SubmitInfo& info = {});
 };
 
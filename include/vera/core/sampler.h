@@ -19,7 +19,7 @@ struct SamplerCreateInfo
 	bool               compareEnable           = false;
 	SamplerCompareOp   compareOp               = SamplerCompareOp::Never;
 	float              minLod                  = 0.f;
-	float              maxLod                  = 0.f;
+	float              maxLod                  = 1000.f; // no clamp, every mip level of the texture is sampled
 	Color              borderColor             = Colors::Black;
 	bool               unnormalizedCoordinates = false;
 };
@@ -2,6 +2,7 @@
 
 #include "device.h"
 #include <string_view>
+#include <vector>
 
 VERA_NAMESPACE_BEGIN
 
@@ -14,6 +15,8 @@ public:
 	static obj<Shader> create(obj<Device> device, std::string_view path);
 	static obj<Shader> create(obj<Device> device, std::vector<uint32_t>&& spirv_code);
 	static obj<Shader> create(obj<Device> device, array_view<uint32_t> spirv_code);
+	// loads, hashes and reflects the files across all hardware threads, results are in the order of paths
+	static std::vector<obj<Shader>> createMany(obj<Device> device, array_view<std::string_view> paths);
 	~Shader() VERA_NOEXCEPT override;
 
 	VERA_NODISCARD obj<Device> getDevice() const VERA_NOEXCEPT;
@@ -22,6 +25,9 @@ public:
 	VERA_NODISCARD std::string_view getEntryPointName() const VERA_NOEXCEPT;
 
 	VERA_NODISCARD size_t hash() const;
+
+private:
+	static obj<Shader> createUncached(obj<Device> device, std::vector<uint32_t>&& spirv_code, const hash128_t& code_key);
 };
 
 VERA_NAMESPACE_END
\ No newline at end of file
@@ -42,6 +42,12 @@ public:
 	array_view<ReflectionSpecConstant> enumerateSpecConstants() const VERA_NOEXCEPT;
 
 	VERA_NODISCARD hash_t hash() const VERA_NOEXCEPT;
+
+private:
+	friend class Shader;
+
+	// Shader::create() passes the key it already computed for the same code
+	static VERA_NODISCARD obj<ShaderReflection> create(obj<Device> device, array_view<uint32_t> spirv_code, const hash128_t& code_key);
 };
 
 VERA_NAMESPACE_END
@@ -7,6 +7,7 @@ VERA_NAMESPACE_BEGIN
 
 class TextureView;
 class Image;
+class MipImage;
 
 struct TextureCreateInfo
 {
@@ -30,10 +31,12 @@ public:
 	static obj<Texture> createDepth(obj<Device> device, uint32_t width, uint32_t height, DepthFormat format);
 	static obj<Texture> createStencil(obj<Device> device, uint32_t width, uint32_t height, StencilFormat format);
 	static obj<Texture> create(obj<Device> device, const Image& image);
+	static obj<Texture> create(obj<Device> device, const MipImage& image);
 	static obj<Texture> create(obj<Device> device, const TextureCreateInfo& info);
 	~Texture() VERA_NOEXCEPT override;
 
 	void upload(const Image& image);
+	void upload(const MipImage& image);
 
 	obj<Device> getDevice();
 	obj<DeviceMemory> getDeviceMemory();
@@ -46,6 +49,7 @@ public:
 	uint32_t width() const;
 	uint32_t height() const;
 	uint32_t depth() const;
+	uint32_t mipLevels() const;
 	extent3d extent() const;
 };
 
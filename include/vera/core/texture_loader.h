@@ -0,0 +1,106 @@
+#pragma once
+
+#include "texture.h"
+#include "command_sync.h"
+#include "../graphics/image.h"
+#include <condition_variable>
+#include <string_view>
+#include <exception>
+#include <future>
+#include <thread>
+#include <string>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+VERA_NAMESPACE_BEGIN
+
+typedef std::shared_future<obj<Texture>> TextureFuture;
+
+struct TextureLoaderCreateInfo
+{
+	uint32_t threadCount  = 0;         // decoding threads, 0 uses all hardware threads but one
+	size_t   memoryBudget = 256 << 20; // bytes being decoded or waiting for upload before decoding pauses
+	bool     expandRGB    = true;      // three channel images get an opaque alpha, few devices sample RGB formats
+};
+
+struct TextureLoaderStatistics
+{
+	uint64_t loadedCount;    // textures uploaded
+	uint64_t failedCount;    // files that could not be read, their futures hold the exception
+	uint64_t decodedBytes;
+	size_t   peakBytes;      // most bytes reserved for decoding or waiting for upload at once
+	uint32_t batchCount;     // update calls that submitted uploads
+};
+
+// Decodes image files on a pool of worker threads and uploads them in batches. Decoded pixels
+// live in pooled images until update() creates their textures, copies them to the staging ring
+// and submits every copy in one flush, so a level load is bound by reading and decoding rather
+// than by one submit per texture. Before decoding, a worker reserves the bytes of the pooled image
+// and of the pixels stb_image decodes the file into, sized from the file header, and waits until
+// they fit in the memory budget. Only an image larger than the whole budget exceeds it, and that
+// image is decoded alone.
+// load is safe on any thread, update and finish belong to the thread that owns the device.
+class TextureLoader : public ManagedObject
+{
+	TextureLoader() VERA_NOEXCEPT = default;
+public:
+	VERA_NODISCARD static obj<TextureLoader> create(obj<Device> device, const TextureLoaderCreateInfo& info = {});
+	~TextureLoader() VERA_NOEXCEPT;
+
+	// files read by ImageReader, in their own channel count and bit depth
+	VERA_NODISCARD TextureFuture load(std::string_view path);
+	// raw pixels without a header, tightly packed
+	VERA_NODISCARD TextureFuture loadRaw(std::string_view path, uint32_t width, uint32_t height, Format format);
+
+	// uploads the images decoded so far in one batch and resolves their futures, returns an
+	// empty sync when nothing was decoded
+	CommandSync update();
+	// waits for every queued load and uploads it, returns the sync of the last batch
+	CommandSync finish();
+
+	VERA_NODISCARD uint32_t getPendingCount() const VERA_NOEXCEPT;
+	VERA_NODISCARD TextureLoaderStatistics getStatistics() const VERA_NOEXCEPT;
+
+private:
+	struct DecodeRequest
+	{
+		std::string                path;
+		uint32_t                   width;
+		uint32_t                   height;
+		Format                     format; // Unknown for files with a header
+		std::promise<obj<Texture>> promise;
+	};
+
+	struct DecodedImage
+	{
+		Image                      image;
+		std::exception_ptr         error;
+		std::promise<obj<Texture>> promise;
+	};
+
+	TextureFuture enqueue(DecodeRequest&& request);
+	void decode(DecodeRequest& request, DecodedImage& out_decoded);
+	void runWorker() VERA_NOEXCEPT;
+	void reserveBytes(size_t size);
+	void releaseBytes(size_t size) VERA_NOEXCEPT;
+	Image acquireImage(uint32_t width, uint32_t height, Format format);
+	void releaseImage(Image&& image) VERA_NOEXCEPT;
+
+	obj<Device>                m_device;
+	TextureLoaderCreateInfo    m_info;
+	std::vector<std::thread>   m_workers;
+	std::deque<DecodeRequest>  m_requests;
+	std::vector<DecodedImage>  m_decoded;
+	std::vector<Image>         m_free_images;
+	size_t                     m_pending_bytes;  // reserved for decoding or decoded and not uploaded yet
+	size_t                     m_free_bytes;     // capacity of the pooled images
+	uint32_t                   m_decoding_count;
+	TextureLoaderStatistics    m_statistics;
+	bool                       m_stopping;
+	mutable std::mutex         m_mutex;
+	std::condition_variable    m_decode_cv;      // a request was queued or budget was freed
+	std::condition_variable    m_decoded_cv;     // an image was decoded
+};
+
+VERA_NAMESPACE_END
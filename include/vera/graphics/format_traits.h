@@ -10,5 +10,9 @@ bool format_has_depth(Format format);
 bool format_has_stencil(Format format);
 bool format_is_depth_stencil(Format format);
 bool format_has_alpha(Format format);
+bool format_is_srgb(Format format);
+bool format_is_unorm(Format format);
+bool format_is_snorm(Format format);
+bool format_is_float(Format format);
 
 VERA_NAMESPACE_END
\ No newline at end of file
@@ -1,14 +1,18 @@
 #pragma once
 
 #include "../core/enum_types.h"
+#include "image_view.h"
 #include <string_view>
 
 VERA_NAMESPACE_BEGIN
 
+// Owns a tightly packed image in memory. loadFromFile(path) expands every file to RGBA8, use an
+// ImageReader to keep the channels and bit depth of the file or to read only part of it.
 class Image
 {
 public:
 	static Image loadFromFile(std::string_view path);
+	// raw pixels without a header, tightly packed
 	static Image loadFromFile(uint32_t width, uint32_t height, Format format, std::string_view path);
 	static Image loadFromMemory(uint32_t width, uint32_t height, Format format, void* ptr, size_t size);
 
@@ -16,6 +20,7 @@ public:
 	Image(std::string_view path);
 	Image(uint32_t width, uint32_t height, Format format);
 	Image(uint32_t width, uint32_t height, Format format, const void* ptr);
+	explicit Image(ConstImageView view);
 	Image(const Image& rhs);
 	Image(Image&& rhs) noexcept;
 	~Image();
@@ -24,6 +29,9 @@ public:
 	Image& operator=(Image&& rhs) noexcept;
 
 	void clear();
+	// changes the extent and format, memory is only reallocated when the capacity is too small
+	// and the pixels are left undefined
+	void resize(uint32_t width, uint32_t height, Format format);
 
 	size_t size() const;
 	size_t capacity() const;
@@ -33,6 +41,11 @@ public:
 	void* data();
 	const void* data() const;
 
+	ImageView view();
+	ConstImageView view() const;
+	ImageView view(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+	ConstImageView view(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const;
+
 	void saveToFile(std::string_view path);
 
 	bool empty() const;
@@ -40,6 +40,16 @@ struct ImageEdit
 	static void rotate(Image& result, const Image& image, Rotation rot);
 	static void rotateCW(Image& result, const Image& image);
 	static void rotateCCW(Image& result, const Image& image);
+
+	// Views may be tiles of larger images, the destination must have the format of the source and
+	// its extent after the edit. flip works in place when both views are the same pixels, the
+	// others need views that do not overlap.
+	static void copy(ImageView dst, ConstImageView src);
+	static void flip(ImageView dst, ConstImageView src, bool horizontal, bool vertical);
+	static void flip(ImageView dst, ConstImageView src, ImageFlipFlags flags);
+	static void rotate(ImageView dst, ConstImageView src, Rotation rot);
+	static void rotateCW(ImageView dst, ConstImageView src);
+	static void rotateCCW(ImageView dst, ConstImageView src);
 };
 
 VERA_NAMESPACE_END
\ No newline at end of file
@@ -36,15 +36,24 @@ public:
 	ImageSampler();
 	ImageSampler(const ImageSamplerCreateInfo& info);
 
+	ImageSamplerFilter getFilter() const;
+	ImageSamplerAddressMode getAddressModeU() const;
+	ImageSamplerAddressMode getAddressModeV() const;
+	const float4& getBorderColor() const;
+	bool isUnnormalized() const;
+
 	float4 sample(const Image& image, const float2& uv) const;
 	float4 sample(const Image& image, float u, float v) const;
 
 private:
 	typedef float4(*SampleFPtr)(const Image&, float, float, const float4&);
 
-	SampleFPtr      m_sample_fptr;
-	float4          m_border_color;
-	bool            m_unnormalized;
+	SampleFPtr              m_sample_fptr;
+	float4                  m_border_color;
+	ImageSamplerFilter      m_filter;
+	ImageSamplerAddressMode m_address_mode_u;
+	ImageSamplerAddressMode m_address_mode_v;
+	bool                    m_unnormalized;
 };
 
 VERA_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "image.h"
+#include "../util/mapped_file.h"
+#include <functional>
+#include <fstream>
+#include <vector>
+
+VERA_NAMESPACE_BEGIN
+
+// Called for each band of rows, band_y is the row of the band within the region being read.
+typedef std::function<void(ConstImageView band, uint32_t band_y)> ImageBandCallback;
+
+// Reads an image file in its own channel count and bit depth. Raw files and uncompressed bitmaps
+// are mapped and read in place, so reading a region or a band only touches the pages under it and
+// never holds the whole image. Other formats are decoded whole by stb_image when opened.
+class ImageReader
+{
+public:
+	ImageReader() VERA_NOEXCEPT;
+	ImageReader(std::string_view path);
+	ImageReader(std::string_view path, uint32_t width, uint32_t height, Format format, size_t offset = 0);
+	ImageReader(ImageReader&& rhs) VERA_NOEXCEPT;
+	~ImageReader() VERA_NOEXCEPT;
+
+	ImageReader& operator=(ImageReader&& rhs) VERA_NOEXCEPT;
+
+	ImageReader(const ImageReader&) = delete;
+	ImageReader& operator=(const ImageReader&) = delete;
+
+	void open(std::string_view path);
+	// raw pixels starting offset bytes into the file, rows tightly packed
+	void openRaw(std::string_view path, uint32_t width, uint32_t height, Format format, size_t offset = 0);
+	void close() VERA_NOEXCEPT;
+
+	// reads the extent and format of an image file from its header, returns false when open maps
+	// the file and true when it decodes the pixels into memory of that extent and format
+	static bool readHeader(std::string_view path, uint32_t& out_width, uint32_t& out_height, Format& out_format);
+
+	VERA_NODISCARD bool isOpen() const VERA_NOEXCEPT;
+	// false when the file was decoded into memory on open
+	VERA_NODISCARD bool isMapped() const VERA_NOEXCEPT;
+
+	VERA_NODISCARD uint32_t width() const VERA_NOEXCEPT;
+	VERA_NODISCARD uint32_t height() const VERA_NOEXCEPT;
+	VERA_NODISCARD Format format() const VERA_NOEXCEPT;
+
+	// the whole image, valid until the reader is closed
+	VERA_NODISCARD ConstImageView view() const VERA_NOEXCEPT;
+
+	// copies the region at x, y with the extent and format of dst
+	void read(ImageView dst, uint32_t x, uint32_t y) const;
+	VERA_NODISCARD Image read(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const;
+	VERA_NODISCARD Image read() const;
+
+	// hands the region to callback in bands of at most band_height rows from the top down
+	void readBands(
+		uint32_t                 x,
+		uint32_t                 y,
+		uint32_t                 width,
+		uint32_t                 height,
+		uint32_t                 band_height,
+		const ImageBandCallback& callback) const;
+
+private:
+	MappedFile     m_file;
+	void*          m_decoded; // pixels decoded by stb_image, null when mapped
+	ConstImageView m_view;
+};
+
+// Writes an image file band by band from the top row down without holding the whole image.
+// Bitmaps take R8, RGB8, BGR8, RGBA8 and BGRA8 pixels, raw files take any format.
+class ImageWriter
+{
+public:
+	ImageWriter() VERA_NOEXCEPT;
+	ImageWriter(std::string_view path, uint32_t width, uint32_t height, Format format);
+	~ImageWriter();
+
+	ImageWriter(const ImageWriter&) = delete;
+	ImageWriter& operator=(const ImageWriter&) = delete;
+
+	// the extension picks the file type, .bmp or .raw
+	void open(std::string_view path, uint32_t width, uint32_t height, Format format);
+	// throws when fewer rows than the height were written
+	void close();
+
+	// appends the rows of band below the rows written so far
+	void write(ConstImageView band);
+
+	VERA_NODISCARD bool isOpen() const VERA_NOEXCEPT;
+	VERA_NODISCARD uint32_t getWrittenRowCount() const VERA_NOEXCEPT;
+
+private:
+	std::ofstream        m_stream;
+	std::vector<uint8_t> m_row;       // a row converted to the file layout
+	uint32_t             m_width;
+	uint32_t             m_height;
+	Format               m_format;
+	uint32_t             m_row_count;
+	bool                 m_bitmap;
+};
+
+VERA_NAMESPACE_END
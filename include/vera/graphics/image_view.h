@@ -0,0 +1,128 @@
+#pragma once
+
+#include "../core/assertion.h"
+#include "format_traits.h"
+#include <type_traits>
+#include <cstddef>
+
+VERA_NAMESPACE_BEGIN
+
+// Non-owning window into pixels stored row by row. Rows are rowPitch bytes apart, the pitch is
+// larger than a row for a region of a wider image and negative for images stored bottom up.
+template <bool Const>
+class BasicImageView
+{
+public:
+	using byte_type    = std::conditional_t<Const, const uint8_t, uint8_t>;
+	using void_pointer = std::conditional_t<Const, const void*, void*>;
+
+	BasicImageView() VERA_NOEXCEPT :
+		m_ptr(nullptr),
+		m_width(0),
+		m_height(0),
+		m_format(Format::Unknown),
+		m_pixel_size(0),
+		m_row_pitch(0) {}
+
+	BasicImageView(void_pointer ptr, uint32_t width, uint32_t height, Format format) VERA_NOEXCEPT :
+		BasicImageView(ptr, width, height, format, static_cast<ptrdiff_t>(width) * get_format_size(format)) {}
+
+	BasicImageView(void_pointer ptr, uint32_t width, uint32_t height, Format format, ptrdiff_t row_pitch) VERA_NOEXCEPT :
+		m_ptr(static_cast<byte_type*>(ptr)),
+		m_width(width),
+		m_height(height),
+		m_format(format),
+		m_pixel_size(get_format_size(format)),
+		m_row_pitch(row_pitch) {}
+
+	template <bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+	BasicImageView(const BasicImageView<OtherConst>& rhs) VERA_NOEXCEPT :
+		m_ptr(rhs.row(0)),
+		m_width(rhs.width()),
+		m_height(rhs.height()),
+		m_format(rhs.format()),
+		m_pixel_size(rhs.pixelSize()),
+		m_row_pitch(rhs.rowPitch()) {}
+
+	VERA_NODISCARD BasicImageView subview(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const VERA_NOEXCEPT
+	{
+		VERA_ASSERT_MSG(x + width <= m_width && y + height <= m_height, "image subview out of range");
+
+		BasicImageView result = *this;
+		result.m_ptr    = pixel(x, y);
+		result.m_width  = width;
+		result.m_height = height;
+
+		return result;
+	}
+
+	VERA_NODISCARD void_pointer data() const VERA_NOEXCEPT
+	{
+		return m_ptr;
+	}
+
+	VERA_NODISCARD byte_type* row(uint32_t y) const VERA_NOEXCEPT
+	{
+		return m_ptr + m_row_pitch * static_cast<ptrdiff_t>(y);
+	}
+
+	VERA_NODISCARD byte_type* pixel(uint32_t x, uint32_t y) const VERA_NOEXCEPT
+	{
+		return row(y) + static_cast<size_t>(m_pixel_size) * x;
+	}
+
+	VERA_NODISCARD uint32_t width() const VERA_NOEXCEPT
+	{
+		return m_width;
+	}
+
+	VERA_NODISCARD uint32_t height() const VERA_NOEXCEPT
+	{
+		return m_height;
+	}
+
+	VERA_NODISCARD Format format() const VERA_NOEXCEPT
+	{
+		return m_format;
+	}
+
+	VERA_NODISCARD uint32_t pixelSize() const VERA_NOEXCEPT
+	{
+		return m_pixel_size;
+	}
+
+	// bytes of pixels in one row, without the padding up to the pitch
+	VERA_NODISCARD size_t rowSize() const VERA_NOEXCEPT
+	{
+		return static_cast<size_t>(m_width) * m_pixel_size;
+	}
+
+	VERA_NODISCARD ptrdiff_t rowPitch() const VERA_NOEXCEPT
+	{
+		return m_row_pitch;
+	}
+
+	// true when the rows follow each other top down without padding, the view is one memory block
+	VERA_NODISCARD bool isContiguous() const VERA_NOEXCEPT
+	{
+		return m_row_pitch == static_cast<ptrdiff_t>(rowSize());
+	}
+
+	VERA_NODISCARD bool empty() const VERA_NOEXCEPT
+	{
+		return !m_ptr || m_width == 0 || m_height == 0;
+	}
+
+private:
+	byte_type* m_ptr; // first pixel of the top row
+	uint32_t   m_width;
+	uint32_t   m_height;
+	Format     m_format;
+	uint32_t   m_pixel_size;
+	ptrdiff_t  m_row_pitch;
+};
+
+typedef BasicImageView<false> ImageView;
+typedef BasicImageView<true>  ConstImageView;
+
+VERA_NAMESPACE_END
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "image.h"
+#include <memory>
+#include <vector>
+
+VERA_NAMESPACE_BEGIN
+
+enum class MipFilter VERA_ENUM
+{
+	Box,
+	Kaiser,
+	Lanczos
+};
+
+struct MipGenerateInfo
+{
+	MipFilter filter      = MipFilter::Box;
+	uint32_t  levelCount  = 0;     // 0 generates the whole chain down to 1x1
+	bool      srgb        = false; // color channels of unorm formats hold srgb encoded values
+	float     alphaCutoff = 0.f;   // when non zero every level keeps the alpha tested coverage of level 0
+};
+
+// Image with its mip chain stored in a single allocation. Levels are laid out from the largest
+// one and each of them begins at an offset a texture copy can read from, so the whole chain is
+// uploaded with one staging copy.
+class MipImage
+{
+public:
+	static MipImage generate(const Image& image, const MipGenerateInfo& info = {});
+	static void generate(MipImage& result, const Image& image, const MipGenerateInfo& info = {});
+	static uint32_t getMaxLevelCount(uint32_t width, uint32_t height);
+
+	MipImage();
+	MipImage(uint32_t width, uint32_t height, Format format, uint32_t level_count = 0);
+	MipImage(const MipImage& rhs);
+	MipImage(MipImage&& rhs) noexcept;
+
+	MipImage& operator=(const MipImage& rhs);
+	MipImage& operator=(MipImage&& rhs) noexcept;
+
+	void clear();
+
+	size_t size() const;
+	uint32_t levelCount() const;
+	uint32_t width(uint32_t level = 0) const;
+	uint32_t height(uint32_t level = 0) const;
+	Format format() const;
+	void* data();
+	const void* data() const;
+
+	size_t levelOffset(uint32_t level) const;
+	size_t levelSize(uint32_t level) const;
+	void* levelData(uint32_t level);
+	const void* levelData(uint32_t level) const;
+	Image level(uint32_t level) const;
+
+	const std::vector<size_t>& levelOffsets() const;
+
+	bool empty() const;
+
+	void swap(MipImage& rhs) noexcept;
+
+private:
+	uint32_t                   m_width;
+	uint32_t                   m_height;
+	Format                     m_format;
+	std::vector<size_t>        m_offsets;
+	std::unique_ptr<uint8_t[]> m_storage; // left uninitialized, every level is written by its producer
+	size_t                     m_size;
+};
+
+VERA_NAMESPACE_END
@@ -19,9 +19,11 @@ public:
 
 	bool empty() const;
 
-	std::vector<float3> vertices;
-	std::vector<float3> normals;
-	std::vector<float2> uvs;
+	// welded vertex streams, normals and uvs are empty when the model has none
+	std::vector<float3>   vertices;
+	std::vector<float3>   normals;
+	std::vector<float2>   uvs;
+	std::vector<uint32_t> indices;
 };
 
 VERA_NAMESPACE_END
\ No newline at end of file
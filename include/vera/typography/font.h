@@ -27,12 +27,13 @@ class Font : public ManagedObject
 {
 	friend class FontManager;
 	friend class FontAtlas;
+	friend class TextLayout;
 	Font() VERA_NOEXCEPT;
 public:
 	VERA_NODISCARD static array_view<CodeRange> getDefaultCodeRanges() VERA_NOEXCEPT;
 
-	VERA_NODISCARD obj<Font> create() VERA_NOEXCEPT;
-	VERA_NODISCARD obj<Font> create(std::string_view path);
+	VERA_NODISCARD static obj<Font> create() VERA_NOEXCEPT;
+	VERA_NODISCARD static obj<Font> create(std::string_view path);
 	~Font() VERA_NOEXCEPT;
 
 	void load(std::string_view path);
@@ -46,6 +47,8 @@ public:
 
 	VERA_NODISCARD uint32_t getGlyphCount() const VERA_NOEXCEPT;
 	VERA_NODISCARD GlyphID getGlyphID(char32_t codepoint) const;
+	// false when the font does not map the codepoint, glyph_id is left untouched then
+	VERA_NODISCARD bool tryGetGlyphID(char32_t codepoint, GlyphID& glyph_id) const VERA_NOEXCEPT;
 	VERA_NODISCARD const Glyph& findGlyph(GlyphID glyph_id) const;
 	VERA_NODISCARD const Glyph& getGlyph(GlyphID glyph_id);
 	VERA_NODISCARD const Glyph& findGlyphByCodepoint(char32_t codepoint) const;
@@ -5,13 +5,19 @@
 #include "../util/rect_packer.h"
 #include "font.h"
 #include <unordered_map>
+#include <string_view>
+#include <atomic>
+#include <span>
 
 VERA_NAMESPACE_BEGIN
+
+class Image;
 VERA_PRIV_NAMESPACE_BEGIN
 
 class FontAtlasGlobalResource;
 class FontAtlasResource;
 struct GlyphPage;
+struct GlyphResidency;
 
 VERA_PRIV_NAMESPACE_END
 
@@ -25,50 +31,89 @@ enum class AtlasType VERA_ENUM
 	MTSDF
 };
 
-struct PackedGlyph
+enum class AtlasGenerator VERA_ENUM
 {
-	GlyphID  glyphID;
-	uint32_t px;
-	uint32_t layer;
-	AABB2D   rect;
+	Auto,       // mesh shaders when the device enables them, the cpu otherwise
+	MeshShader,
+	CPU         // distance fields are generated on the cpu and uploaded, no device needed
 };
 
 struct FontAtlasCreateInfo
 {
-	obj<Font>     font                  = {};
-	AtlasType     type                  = AtlasType::SDF;
-	PackingMethod packingMethod         = PackingMethod::Shelf;
-	uint32_t      atlasWidth            = 2048;
-	uint32_t      atlasHeight           = 2048;
-	uint32_t      padding               = 2;
-	uint32_t      sdfFontSize           = 0;
-	uint32_t      sdfPadding            = 5;
-	bool          hasOverlappingContour = false;
+	obj<Font>      font                  = {};
+	AtlasType      type                  = AtlasType::SDF;
+	PackingMethod  packingMethod         = PackingMethod::Skyline;
+	uint32_t       atlasWidth            = 2048;
+	uint32_t       atlasHeight           = 2048;
+	uint32_t       padding               = 2;
+	uint32_t       sdfFontSize           = 0;
+	uint32_t       sdfPadding            = 5;
+	bool           hasOverlappingContour = false;
+	AtlasGenerator generator             = AtlasGenerator::Auto; // masks are always rasterized on the cpu
+	uint32_t       maxLayerCount         = 0; // texture layers over all pixel sizes, 0 never evicts
+};
+
+struct FontAtlasStatistics
+{
+	uint64_t hitCount;           // lookups answered by a resident glyph
+	uint64_t missCount;          // lookups that found no resident glyph
+	uint64_t evictCount;         // glyphs evicted to stay within maxLayerCount
+	uint32_t residentGlyphCount;
+	uint32_t layerCount;
 };
 
 class FontAtlas : public ManagedObject
 {
 	FontAtlas() VERA_NOEXCEPT = default;
 public:
+	// device may be null for mask and cpu generated atlases, glyphs then only land in the cpu layers
 	VERA_NODISCARD static obj<FontAtlas> create(obj<Device> device, const FontAtlasCreateInfo& info = {});
 	~FontAtlas() VERA_NOEXCEPT;
 
 	VERA_NODISCARD obj<Font> getFont() const VERA_NOEXCEPT;
 	VERA_NODISCARD obj<TextureView> getTextureView(uint32_t px, uint32_t layer) VERA_NOEXCEPT;
 	VERA_NODISCARD uint32_t getTextureCount(uint32_t px) const VERA_NOEXCEPT;
+	// cpu copy of a layer of mask and cpu generated atlases, also kept without a device
+	VERA_NODISCARD const Image* getLayerImage(uint32_t px, uint32_t layer) const VERA_NOEXCEPT;
 	VERA_NODISCARD extent2d getTextureSize() const VERA_NOEXCEPT;
 
 	CommandSync loadGlyphRange(const basic_range<GlyphID>& range, uint32_t px);
 	CommandSync loadCodeRange(const CodeRange& range, uint32_t px);
 
+	// loads the glyph when it is missing, throws when the font does not map the codepoint
 	VERA_NODISCARD const PackedGlyph& getGlyph(char32_t codepoint, uint32_t px);
+	// loads the missing glyphs of the text in one batch and resolves every codepoint into
+	// out_glyphs, which must hold text.size() entries. Unmapped codepoints are left null and
+	// counted in the returned miss count.
+	uint32_t getGlyphs(std::u32string_view text, uint32_t px, std::span<const PackedGlyph*> out_glyphs);
+
+	// Lookups without loading, throwing or locking. Safe on any thread while the owning thread
+	// loads glyphs, a glyph shows up once getGlyph, getGlyphs or loadCodeRange has resolved its
+	// codepoint. Misses are null and counted in the returned miss count.
+	VERA_NODISCARD const PackedGlyph* findGlyph(char32_t codepoint, uint32_t px) const VERA_NOEXCEPT;
+	uint32_t findGlyphs(std::u32string_view text, uint32_t px, std::span<const PackedGlyph*> out_glyphs) const VERA_NOEXCEPT;
+
+	// Lookups mark glyphs as used in the current frame. Once the atlas holds maxLayerCount layers,
+	// loads evict the least recently used glyphs of the size being loaded and reuse their rects,
+	// sizes not used in the current frame give up all their layers first. Glyphs used in the
+	// current frame are never evicted, packed glyphs must not be kept across frames.
+	void nextFrame() VERA_NOEXCEPT;
+
+	// regenerates the resident glyphs of a size tallest first into as few layers as possible, in
+	// one mesh shader pass or one upload, layers left empty are released
+	CommandSync compact(uint32_t px);
+
+	VERA_NODISCARD FontAtlasStatistics getStatistics() const VERA_NOEXCEPT;
+	void resetStatistics() VERA_NOEXCEPT;
 
 	VERA_NODISCARD AtlasType getAtlasType() const VERA_NOEXCEPT;
 
 private:
 	obj<Device>                                   m_device;
 	std::unique_ptr<priv::FontAtlasResource>      m_resource;
+	std::unique_ptr<priv::GlyphResidency>         m_residency;
 	std::unordered_map<uint32_t, priv::GlyphPage> m_pages;
+	std::atomic<priv::GlyphPage*>                 m_pageList = nullptr;
 	FontAtlasCreateInfo                           m_info;
 };
 
@@ -14,11 +14,123 @@ struct GlyphPoint
 	bool   onCurve;
 };
 
+// Contours of a glyph stored back to back, ends holds one past the last point of every contour.
+// Iterating yields an array_view per contour, the points are owned by the font.
+class GlyphContourList
+{
+public:
+	class iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = array_view<GlyphPoint>;
+		using difference_type   = ptrdiff_t;
+		using pointer           = void;
+		using reference         = array_view<GlyphPoint>;
+
+		VERA_CONSTEXPR iterator() VERA_NOEXCEPT :
+			m_points(nullptr),
+			m_ends(nullptr),
+			m_idx(0) {}
+
+		VERA_CONSTEXPR iterator(const GlyphPoint* points, const uint32_t* ends, uint32_t idx) VERA_NOEXCEPT :
+			m_points(points),
+			m_ends(ends),
+			m_idx(idx) {}
+
+		VERA_NODISCARD VERA_CONSTEXPR array_view<GlyphPoint> operator*() const VERA_NOEXCEPT
+		{
+			const uint32_t first = m_idx == 0 ? 0 : m_ends[m_idx - 1];
+			return array_view<GlyphPoint>(m_points + first, m_ends[m_idx] - first);
+		}
+
+		VERA_CONSTEXPR iterator& operator++() VERA_NOEXCEPT
+		{
+			++m_idx;
+			return *this;
+		}
+
+		VERA_CONSTEXPR iterator operator++(int) VERA_NOEXCEPT
+		{
+			iterator temp = *this;
+			++m_idx;
+			return temp;
+		}
+
+		VERA_NODISCARD VERA_CONSTEXPR bool operator==(const iterator& rhs) const VERA_NOEXCEPT
+		{
+			return m_idx == rhs.m_idx;
+		}
+
+		VERA_NODISCARD VERA_CONSTEXPR bool operator!=(const iterator& rhs) const VERA_NOEXCEPT
+		{
+			return m_idx != rhs.m_idx;
+		}
+
+	private:
+		const GlyphPoint* m_points;
+		const uint32_t*   m_ends;
+		uint32_t          m_idx;
+	};
+
+	VERA_CONSTEXPR GlyphContourList() VERA_NOEXCEPT :
+		m_points(nullptr),
+		m_ends(nullptr),
+		m_count(0) {}
+
+	VERA_CONSTEXPR GlyphContourList(const GlyphPoint* points, const uint32_t* ends, uint32_t count) VERA_NOEXCEPT :
+		m_points(points),
+		m_ends(ends),
+		m_count(count) {}
+
+	VERA_NODISCARD VERA_CONSTEXPR array_view<GlyphPoint> operator[](size_t idx) const VERA_NOEXCEPT
+	{
+		VERA_ASSERT(idx < m_count);
+		return *iterator(m_points, m_ends, static_cast<uint32_t>(idx));
+	}
+
+	// every point of the glyph in contour order
+	VERA_NODISCARD VERA_CONSTEXPR array_view<GlyphPoint> points() const VERA_NOEXCEPT
+	{
+		return array_view<GlyphPoint>(m_points, m_count == 0 ? 0 : m_ends[m_count - 1]);
+	}
+
+	VERA_NODISCARD VERA_CONSTEXPR array_view<uint32_t> ends() const VERA_NOEXCEPT
+	{
+		return array_view<uint32_t>(m_ends, m_count);
+	}
+
+	VERA_NODISCARD VERA_CONSTEXPR bool empty() const VERA_NOEXCEPT
+	{
+		return m_count == 0;
+	}
+
+	VERA_NODISCARD VERA_CONSTEXPR size_t size() const VERA_NOEXCEPT
+	{
+		return m_count;
+	}
+
+	VERA_NODISCARD VERA_CONSTEXPR iterator begin() const VERA_NOEXCEPT
+	{
+		return iterator(m_points, m_ends, 0);
+	}
+
+	VERA_NODISCARD VERA_CONSTEXPR iterator end() const VERA_NOEXCEPT
+	{
+		return iterator(m_points, m_ends, m_count);
+	}
+
+private:
+	const GlyphPoint* m_points;
+	const uint32_t*   m_ends;
+	uint32_t          m_count;
+};
+
 class Glyph
 {
 public:
-	using ContourType = std::vector<GlyphPoint>;
-	using ContourList = std::vector<ContourType>;
+	using ContourType = array_view<GlyphPoint>;
+	using ContourList = GlyphContourList;
 
 	GlyphID             glyphID;
 	AABB2D              aabb;
@@ -26,4 +138,13 @@ public:
 	array_view<uint8_t> instructions;
 };
 
+// placement of a glyph inside an atlas layer, rect is in texels
+struct PackedGlyph
+{
+	GlyphID  glyphID;
+	uint32_t px;
+	uint32_t layer;
+	AABB2D   rect;
+};
+
 VERA_NAMESPACE_END
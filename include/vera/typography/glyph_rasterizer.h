@@ -0,0 +1,65 @@
+#pragma once
+
+#include "../graphics/image.h"
+#include "../util/extent.h"
+#include "../util/rect_packer.h"
+#include "glyph.h"
+#include <vector>
+
+VERA_NAMESPACE_BEGIN
+
+enum class GlyphMaskType VERA_ENUM
+{
+	Hard, // every texel is either 0 or 255
+	Soft  // texels hold the anti-aliased coverage
+};
+
+struct GlyphMaskBakeInfo
+{
+	GlyphMaskType type  = GlyphMaskType::Soft;
+	float         scale = 1.f; // font units to pixels
+	uint32_t      px    = 0;   // font size recorded in the packed glyphs
+};
+
+// CPU coverage rasterizer for glyph outlines. Edges are accumulated as signed areas into a cell
+// buffer and a prefix sum along each row turns them into coverage, quadratic curves are flattened
+// with a segment count bounding their distance to the curve. Needs no device, so atlases can be
+// baked offline. A rasterizer keeps its cell buffer between calls and is not thread safe.
+class GlyphRasterizer
+{
+public:
+	// size of the mask a glyph covers at the given scale, zero for glyphs without contours
+	VERA_NODISCARD static extent2d getGlyphExtent(const Glyph& glyph, float scale) VERA_NOEXCEPT;
+
+	GlyphRasterizer(GlyphMaskType type = GlyphMaskType::Soft) VERA_NOEXCEPT;
+
+	// writes the R8 mask of the glyph, the top left texel maps to the glyph aabb (min.x, max.y)
+	void rasterize(void* dst, size_t row_pitch, const Glyph& glyph, float scale);
+	VERA_NODISCARD Image rasterize(const Glyph& glyph, float scale);
+
+	VERA_NODISCARD GlyphMaskType getMaskType() const VERA_NOEXCEPT;
+
+private:
+	GlyphMaskType      m_type;
+	std::vector<float> m_cells;
+};
+
+// Packs the glyphs through the packer and rasterizes them in parallel into R8Unorm layers of the
+// packer size. The last layer is the one the packer is filling, a new zeroed layer is appended
+// whenever a glyph does not fit anymore. Returns the index of the first layer written to.
+uint32_t bake_glyph_masks(
+	std::vector<Image>&       layers,
+	RectPacker&               packer,
+	std::vector<PackedGlyph>& out_glyphs,
+	array_view<const Glyph*>  glyphs,
+	const GlyphMaskBakeInfo&  info);
+
+// Rasterizes glyphs whose rects are already packed into existing layers, packed_glyphs matches
+// glyphs in order. Glyphs with an empty rect are skipped.
+void bake_glyph_masks(
+	std::vector<Image>&      layers,
+	array_view<PackedGlyph>  packed_glyphs,
+	array_view<const Glyph*> glyphs,
+	const GlyphMaskBakeInfo& info);
+
+VERA_NAMESPACE_END
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "../core/intrusive_ptr.h"
+#include "../math/vector_types.h"
+#include "../util/hash.h"
+#include "font.h"
+#include <unordered_map>
+#include <string_view>
+#include <memory>
+#include <vector>
+
+VERA_NAMESPACE_BEGIN
+VERA_PRIV_NAMESPACE_BEGIN
+
+class TextShaper;
+
+VERA_PRIV_NAMESPACE_END
+
+// A glyph placed by the layout, ready to be drawn as one instance.
+struct ShapedGlyph
+{
+	GlyphID glyphID;
+	float2  position; // glyph origin on the baseline in pixels, y points down from the top of the text
+};
+
+struct ShapedText
+{
+	std::vector<ShapedGlyph> glyphs;    // whitespace only advances and has no glyph
+	float2                   size;      // widest line and the height of all lines in pixels
+	uint32_t                 lineCount;
+};
+
+struct TextLayoutInfo
+{
+	uint32_t px          = 16;
+	float    maxWidth    = 0.f;  // lines wrap at spaces past this width in pixels, 0 disables wrapping
+	float    lineSpacing = 1.f;  // scale of the font line height
+	bool     kerning     = true;
+	bool     ligatures   = true; // 'liga' and 'clig' substitutions, required substitutions always apply
+};
+
+// Shapes UTF-8 and UTF-32 text with the cmap, hmtx, GSUB single and ligature substitutions, GPOS
+// pair adjustments or the legacy kern table of a font, then breaks it into lines. Shaped texts are
+// cached by font, layout info and the 128-bit hash and length of the text, so a static label is
+// shaped once and every later call is a hash lookup. Once the cache holds more texts than its
+// capacity, the least recently shaped ones are evicted. A layout is not thread safe, references stay
+// valid until clearCache or until a later shape call evicts their text.
+class TextLayout : public ManagedObject
+{
+	TextLayout() VERA_NOEXCEPT;
+public:
+	VERA_NODISCARD static obj<TextLayout> create() VERA_NOEXCEPT;
+	~TextLayout() VERA_NOEXCEPT;
+
+	VERA_NODISCARD const ShapedText& shape(const obj<Font>& font, std::string_view text, const TextLayoutInfo& info = {});
+	VERA_NODISCARD const ShapedText& shape(const obj<Font>& font, std::u32string_view text, const TextLayoutInfo& info = {});
+
+	// shapes into out without touching the cache, for text that changes every frame
+	void shapeUncached(ShapedText& out, const obj<Font>& font, std::string_view text, const TextLayoutInfo& info = {});
+	void shapeUncached(ShapedText& out, const obj<Font>& font, std::u32string_view text, const TextLayoutInfo& info = {});
+
+	// 0 disables eviction, a smaller capacity takes effect on the next text added to the cache
+	void setCacheCapacity(size_t capacity) VERA_NOEXCEPT;
+	VERA_NODISCARD size_t getCacheCapacity() const VERA_NOEXCEPT;
+	VERA_NODISCARD size_t getCachedTextCount() const VERA_NOEXCEPT;
+	void clearCache() VERA_NOEXCEPT;
+
+private:
+	struct CacheKey
+	{
+		const Font*    font;
+		TextLayoutInfo info;
+		hash128_t      textHash;
+		size_t         textSize; // code units of the text
+		bool           utf32;
+
+		VERA_NODISCARD bool operator==(const CacheKey& rhs) const VERA_NOEXCEPT;
+	};
+
+	struct CacheKeyHash
+	{
+		VERA_NODISCARD size_t operator()(const CacheKey& key) const VERA_NOEXCEPT;
+	};
+
+	struct CachedText
+	{
+		obj<Font>  font;    // keeps the font alive so its address is not reused by another key
+		uint64_t   lastUse; // shape call the text was last returned by
+		ShapedText text;
+	};
+
+	typedef std::unordered_map<CacheKey, CachedText, CacheKeyHash> TextCache;
+
+	const ShapedText& shapeIntoCache(const obj<Font>& font, const CacheKey& key, std::u32string_view text);
+	void evictLeastRecent();
+
+	std::unique_ptr<priv::TextShaper> m_shaper;
+	TextCache                         m_cache;
+	size_t                            m_cache_capacity;
+	uint64_t                          m_use_count;
+	std::u32string                    m_codepoints;
+};
+
+VERA_NAMESPACE_END
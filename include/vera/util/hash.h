@@ -2,11 +2,32 @@
 
 #include "../core/coredefs.h"
 #include <type_traits>
+#include <cstddef>
+#include <cstdint>
 
 VERA_NAMESPACE_BEGIN
 
 typedef uint64_t hash_t;
 
+// 128-bit hash for keys that are persisted or must not collide in practice
+struct hash128_t
+{
+	uint64_t low;
+	uint64_t high;
+
+	VERA_NODISCARD bool operator==(const hash128_t& rhs) const VERA_NOEXCEPT
+	{
+		return low == rhs.low && high == rhs.high;
+	}
+
+	VERA_NODISCARD bool operator!=(const hash128_t& rhs) const VERA_NOEXCEPT
+	{
+		return !(*this == rhs);
+	}
+};
+
+VERA_NODISCARD hash128_t hash_bytes_128(const void* data, size_t size, uint64_t seed = 0) VERA_NOEXCEPT;
+
 // A hash combine function based on boost::hash_combine
 template <class T>
 void hash_combine(hash_t& seed, const T& val)
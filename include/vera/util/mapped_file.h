@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../core/coredefs.h"
+#include "array_view.h"
+#include <string_view>
+#include <cstdint>
+
+VERA_NAMESPACE_BEGIN
+
+// Read-only view of a whole file mapped into the address space, pages are brought in by the OS
+// on first access so large files can be parsed without copying them into memory up front.
+class MappedFile
+{
+public:
+	MappedFile() VERA_NOEXCEPT;
+	MappedFile(std::string_view path);
+	MappedFile(MappedFile&& rhs) VERA_NOEXCEPT;
+	~MappedFile() VERA_NOEXCEPT;
+
+	MappedFile& operator=(MappedFile&& rhs) VERA_NOEXCEPT;
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	void open(std::string_view path);
+	void close() VERA_NOEXCEPT;
+
+	VERA_NODISCARD VERA_INLINE const uint8_t* data() const VERA_NOEXCEPT { return m_data; }
+	VERA_NODISCARD VERA_INLINE size_t size() const VERA_NOEXCEPT { return m_size; }
+	VERA_NODISCARD VERA_INLINE bool empty() const VERA_NOEXCEPT { return m_size == 0; }
+
+	VERA_NODISCARD VERA_INLINE array_view<uint8_t> bytes() const VERA_NOEXCEPT
+	{
+		return array_view<uint8_t>(m_data, m_size);
+	}
+
+	VERA_NODISCARD VERA_INLINE std::string_view text() const VERA_NOEXCEPT
+	{
+		return std::string_view(reinterpret_cast<const char*>(m_data), m_size);
+	}
+
+private:
+	const uint8_t* m_data;
+	size_t         m_size;
+	void*          m_mapping; // file mapping handle on windows, unused elsewhere
+};
+
+VERA_NAMESPACE_END
@@ -11,9 +11,14 @@ VERA_NAMESPACE_BEGIN
 
 enum class PackingMethod VERA_ENUM
 {
-	Shelf
+	Shelf,    // rows of the tallest rect, fastest but wastes the space above shorter rects
+	Skyline,  // bottom-left skyline, the gaps it leaves below rects are reused
+	MaxRects  // best short side fit over maximal free rects, densest and slowest
 };
 
+// Packs rects into a fixed area. Every rect keeps padding texels to its neighbours and the borders.
+// Batch packing sorts the extents by height before packing and reports the rects that did not fit,
+// released rects are reused by later packs without clearing the packer.
 class RectPacker
 {
 public:
@@ -23,6 +28,9 @@ public:
 		uint32_t      height,
 		uint32_t      padding = 0) VERA_NOEXCEPT;
 
+	// false for the rects a batch pack could not place
+	VERA_NODISCARD static bool isPacked(const urect2d& rect) VERA_NOEXCEPT;
+
 	RectPacker(uint32_t width, uint32_t height, uint32_t padding = 0) VERA_NOEXCEPT;
 	virtual ~RectPacker() VERA_NOEXCEPT = default;
 
@@ -31,13 +39,22 @@ public:
 	VERA_NODISCARD extent2d getExtent() const VERA_NOEXCEPT;
 	VERA_NODISCARD uint32_t getPadding() const VERA_NOEXCEPT;
 
+	// area of the packed rects without padding and its ratio to the packer area
+	VERA_NODISCARD uint64_t getUsedArea() const VERA_NOEXCEPT;
+	VERA_NODISCARD float getOccupancy() const VERA_NOEXCEPT;
+
 	VERA_NODISCARD virtual uint32_t pack(const extent2d& extent, urect2d& out_rect) VERA_NOEXCEPT = 0;
 
+	// out_rects matches extents in order, rects that did not fit keep their extent and fail isPacked,
+	// returns the number of packed rects
 	VERA_NODISCARD virtual uint32_t pack(
 		array_view<extent2d>  extents,
-		std::vector<urect2d>& out_rects) VERA_NOEXCEPT = 0;
+		std::vector<urect2d>& out_rects) VERA_NOEXCEPT;
 
-	VERA_NODISCARD virtual uint32_t packInplace(std::span<urect2d> out_rects) VERA_NOEXCEPT = 0;
+	VERA_NODISCARD virtual uint32_t packInplace(std::span<urect2d> out_rects) VERA_NOEXCEPT;
+
+	// rect must be one returned by this packer since the last clear
+	virtual void release(const urect2d& rect) VERA_NOEXCEPT = 0;
 
 	virtual void clear() VERA_NOEXCEPT = 0;
 
@@ -45,6 +62,7 @@ protected:
 	const uint32_t m_width;
 	const uint32_t m_height;
 	const uint32_t m_padding;
+	uint64_t       m_used_area;
 };
 
 class ShelfPacker : public RectPacker
@@ -54,12 +72,10 @@ public:
 
 	VERA_NODISCARD uint32_t pack(const extent2d& extent, urect2d& out_rect) VERA_NOEXCEPT override;
 
-	VERA_NODISCARD uint32_t pack(
-		array_view<extent2d>  extents,
-		std::vector<urect2d>& out_rects
-	) VERA_NOEXCEPT override;
+	using RectPacker::pack;
 
-	VERA_NODISCARD uint32_t packInplace(std::span<urect2d> out_rects) VERA_NOEXCEPT override;
+	// space is only reclaimed from the end of the last shelf or once every rect is released
+	void release(const urect2d& rect) VERA_NOEXCEPT override;
 
 	void clear() VERA_NOEXCEPT override;
 
@@ -68,4 +84,62 @@ private:
 	uint32_t m_max_height;
 };
 
+class SkylinePacker : public RectPacker
+{
+	struct Node
+	{
+		uint32_t x;
+		uint32_t y;
+		uint32_t width;
+	};
+
+public:
+	SkylinePacker(uint32_t width, uint32_t height, uint32_t padding = 0) VERA_NOEXCEPT;
+
+	VERA_NODISCARD uint32_t pack(const extent2d& extent, urect2d& out_rect) VERA_NOEXCEPT override;
+
+	using RectPacker::pack;
+
+	// a rect the skyline rests on lowers the skyline again, any other released rect is only reused
+	// by rects fitting in it together with the free rects sharing one of its whole edges
+	void release(const urect2d& rect) VERA_NOEXCEPT override;
+
+	void clear() VERA_NOEXCEPT override;
+
+private:
+	bool findFreeRect(uint32_t width, uint32_t height, urect2d& out_rect) VERA_NOEXCEPT;
+	bool fitNode(size_t idx, uint32_t width, uint32_t height, uint32_t& out_y) const VERA_NOEXCEPT;
+	void addNode(size_t idx, uint32_t x, uint32_t y, uint32_t width, uint32_t height) VERA_NOEXCEPT;
+	bool lowerNodes(const urect2d& rect) VERA_NOEXCEPT;
+	void mergeNodes() VERA_NOEXCEPT;
+	void addFreeRect(const urect2d& rect) VERA_NOEXCEPT;
+
+	std::vector<Node>    m_nodes;
+	std::vector<urect2d> m_free_rects; // disjoint, the space left below the skyline and released rects
+};
+
+class MaxRectsPacker : public RectPacker
+{
+public:
+	MaxRectsPacker(uint32_t width, uint32_t height, uint32_t padding = 0) VERA_NOEXCEPT;
+
+	VERA_NODISCARD uint32_t pack(const extent2d& extent, urect2d& out_rect) VERA_NOEXCEPT override;
+
+	using RectPacker::pack;
+
+	// the maximal free rects through the released space are rebuilt, so it joins the free space around it
+	void release(const urect2d& rect) VERA_NOEXCEPT override;
+
+	void clear() VERA_NOEXCEPT override;
+
+private:
+	void splitFreeRects(const urect2d& rect) VERA_NOEXCEPT;
+	void joinReleasedRect(const urect2d& lhs, urect2d rhs) VERA_NOEXCEPT;
+	void pruneFreeRects() VERA_NOEXCEPT;
+
+	std::vector<urect2d> m_free_rects; // maximal, may overlap each other
+	std::vector<urect2d> m_new_rects;
+	std::vector<urect2d> m_cross_rects; // free rects sharing rows or columns with a released rect
+};
+
 VERA_NAMESPACE_END
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../core/assertion.h"
+#include <vector>
+#include <array>
+#include <cstddef>
+
+VERA_NAMESPACE_BEGIN
+
+struct TLSFAllocation
+{
+	uint32_t id;
+	size_t   offset;
+	size_t   size;
+};
+
+struct TLSFStatistics
+{
+	size_t   totalSize;
+	size_t   usedSize;
+	size_t   largestFreeRange;
+	uint32_t allocationCount;
+	uint32_t freeRangeCount;
+};
+
+// Two-level segregated fit allocator that only manages offsets into an externally owned range.
+// It never touches the managed memory, so the same core serves device memory blocks or anything else.
+class TLSFAllocator
+{
+public:
+	static constexpr uint32_t INVALID_ID = UINT32_MAX;
+
+	TLSFAllocator(size_t size) VERA_NOEXCEPT;
+
+	VERA_NODISCARD bool allocate(size_t size, size_t alignment, TLSFAllocation& out_allocation) VERA_NOEXCEPT;
+	void free(uint32_t id) VERA_NOEXCEPT;
+	void clear() VERA_NOEXCEPT;
+
+	VERA_NODISCARD size_t size() const VERA_NOEXCEPT;
+	VERA_NODISCARD size_t usedSize() const VERA_NOEXCEPT;
+	VERA_NODISCARD uint32_t allocationCount() const VERA_NOEXCEPT;
+	VERA_NODISCARD bool empty() const VERA_NOEXCEPT;
+
+	VERA_NODISCARD TLSFStatistics getStatistics() const VERA_NOEXCEPT;
+
+private:
+	static constexpr uint32_t SL_BITS  = 4;
+	static constexpr uint32_t SL_COUNT = 1 << SL_BITS;
+	static constexpr uint32_t FL_COUNT = 64 - SL_BITS + 1;
+
+	struct Node
+	{
+		size_t   offset;
+		size_t   size;
+		uint32_t prevPhysical;
+		uint32_t nextPhysical;
+		uint32_t prevFree;
+		uint32_t nextFree;
+		bool     used;
+	};
+
+	uint32_t createNode(size_t offset, size_t size) VERA_NOEXCEPT;
+	void releaseNode(uint32_t id) VERA_NOEXCEPT;
+	void insertFreeNode(uint32_t id) VERA_NOEXCEPT;
+	void removeFreeNode(uint32_t id) VERA_NOEXCEPT;
+	uint32_t findFreeNode(size_t size) const VERA_NOEXCEPT;
+
+	using FreeListHeads = std::array<std::array<uint32_t, SL_COUNT>, FL_COUNT>;
+
+	std::vector<Node>              m_nodes;
+	std::vector<uint32_t>          m_unused_nodes;
+	FreeListHeads                  m_heads;
+	std::array<uint32_t, FL_COUNT> m_sl_bitmaps;
+	uint64_t                       m_fl_bitmap;
+	size_t                         m_size;
+	size_t                         m_used_size;
+	uint32_t                       m_allocation_count;
+	uint32_t                       m_free_count;
+};
+
+VERA_NAMESPACE_END
@@ -18,6 +18,7 @@
 #include "core/descriptor_set_layout.h"
 #include "core/device.h"
 #include "core/device_memory.h"
+#include "core/draw_packet.h"
 #include "core/enum_types.h"
 #include "core/exception.h"
 #include "core/fence.h"
@@ -35,6 +36,7 @@
 #include "core/shader_reflection.h"
 #include "core/swapchain.h"
 #include "core/texture.h"
+#include "core/texture_loader.h"
 #include "core/texture_view.h"
 
 // geometry
@@ -56,6 +58,9 @@
 #include "graphics/image.h"
 #include "graphics/image_edit.h"
 #include "graphics/image_sampler.h"
+#include "graphics/image_stream.h"
+#include "graphics/image_view.h"
+#include "graphics/mip_image.h"
 #include "graphics/model_loader.h"
 #include "graphics/transform2d.h"
 #include "graphics/transform3d.h"
@@ -95,7 +100,9 @@
 #include "typography/font_atlas.h"
 #include "typography/font_manager.h"
 #include "typography/glyph.h"
+#include "typography/glyph_rasterizer.h"
 #include "typography/language.h"
+#include "typography/text_layout.h"
 
 // util
 #include "util/arcball.h"
@@ -110,6 +117,7 @@
 #include "util/hash.h"
 #include "util/index_map.h"
 #include "util/lookup_table.h"
+#include "util/mapped_file.h"
 #include "util/property.h"
 #include "util/range.h"
 #include "util/ranged_set.h"
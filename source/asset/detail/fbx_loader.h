@@ -4,9 +4,13 @@
 #include "../../../include/vera/scene/mesh_attribute.h"
 #include "../../../include/vera/util/result_message.h"
 #include "../../../include/vera/util/stack_allocator.h"
+#include "../../../include/vera/util/mapped_file.h"
 #include <zlib.h>
 #include <string_view>
-#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <atomic>
+#include <thread>
 #include <vector>
 
 #define FBX_HEADER_MAGIC "Kaydara FBX Binary  \x00\x1a\x00"
@@ -23,6 +27,11 @@
 		return { AssetResult::AllocationFailed, "memory allocation failed" }; \
 	} while (0)
 
+#define FBX_CHECK_READ(expression)                                         \
+	while (!(expression)) {                                                \
+		return { AssetResult::InvalidFormat, "unexpected end of file" };   \
+	} while (0)
+
 VERA_NAMESPACE_BEGIN
 
 static bool memvcmp(const void* ptr, size_t length, uint8_t value)
@@ -34,6 +43,9 @@ static bool memvcmp(const void* ptr, size_t length, uint8_t value)
 	return true;
 }
 
+// The file is mapped as a whole and records are decoded straight from the mapping, names, strings
+// and array payloads are referenced in place rather than copied out. Compressed arrays are only
+// inflated once the scene extraction asks for them, in parallel when several are asked at once.
 struct FBXLoader
 {
 	typedef ResultMessage<AssetResult> Result;
@@ -155,110 +167,31 @@ struct FBXLoader
 	template <>
 	struct PropertyRecordType<BINARY> : PropertyRecord
 	{
-		uint32_t length;
-		uint8_t* value;
+		uint32_t       length;
+		const uint8_t* value; // points into the mapped file
 	};
 
 	template <>
 	struct PropertyRecordType<STRING> : PropertyRecord
 	{
 		uint32_t    length;
-		const char* value;
-	};
-
-	template <>
-	struct PropertyRecordType<ARRAY_BOOL> : PropertyRecord
-	{
-		uint32_t length;
-		bool*    value;
+		const char* value; // points into the mapped file, not null terminated
 	};
 
-	template <>
-	struct PropertyRecordType<ARRAY_UBYTE> : PropertyRecord
-	{
-		uint32_t length;
-		uint8_t* value;
-	};
-
-	template <>
-	struct PropertyRecordType<ARRAY_INT> : PropertyRecord
-	{
-		uint32_t length;
-		int32_t* value;
-	};
-
-	template <>
-	struct PropertyRecordType<ARRAY_LONG> : PropertyRecord
+	// every ARRAY_* and ARRAY_COMP_* property, elements in the file are not aligned
+	struct ArrayPropertyRecord : PropertyRecord
 	{
-		uint32_t length;
-		int64_t* value;
-	};
-
-	template <>
-	struct PropertyRecordType<ARRAY_FLOAT> : PropertyRecord
-	{
-		uint32_t length;
-		float*   value;
-	};
-
-	template <>
-	struct PropertyRecordType<ARRAY_DOUBLE> : PropertyRecord
-	{
-		uint32_t length;
-		double*  value;
-	};
-
-	template <>
-	struct PropertyRecordType<ARRAY_COMP_BOOL> : PropertyRecord
-	{
-		uint32_t length;
-		uint32_t size;
-		uint8_t* value;
-	};
-
-	template <>
-	struct PropertyRecordType<ARRAY_COMP_UBYTE> : PropertyRecord
-	{
-		uint32_t length;
-		uint32_t size;
-		uint8_t* value;
-	};
-	template <>
-	struct PropertyRecordType<ARRAY_COMP_INT> : PropertyRecord
-	{
-		uint32_t length;
-		uint32_t size;
-		uint8_t* value;
-	};
-
-	template <>
-	struct PropertyRecordType<ARRAY_COMP_LONG> : PropertyRecord
-	{
-		uint32_t length;
-		uint32_t size;
-		uint8_t* value;
-	};
-
-	template <>
-	struct PropertyRecordType<ARRAY_COMP_FLOAT> : PropertyRecord
-	{
-		uint32_t length;
-		uint32_t size;
-		uint8_t* value;
-	};
-
-	template <>
-	struct PropertyRecordType<ARRAY_COMP_DOUBLE> : PropertyRecord
-	{
-		uint32_t length;
-		uint32_t size;
-		uint8_t* value;
+		uint32_t       length;   // element count
+		uint32_t       size;     // payload size in the file
+		const uint8_t* data;     // payload in the mapped file
+		uint8_t*       inflated; // decompressed payload, null until first requested
+		bool           failed;
 	};
 
 	class NodeRecord
 	{
 	public:
-		const char*      name;
+		std::string_view name; // points into the mapped file
 		uint32_t         propertyCount;
 		PropertyRecord** properties;
 		uint32_t         childCount;
@@ -297,31 +230,74 @@ struct FBXLoader
 	};
 #pragma pack(pop)
 
-	static Result load(AssetLoader& loader, std::string_view path)
+	struct Cursor
 	{
-		NodeRecord     root_node = {};
-		stack_allocator allocator;
-		Header         header;
+		const uint8_t* begin;
+		const uint8_t* ptr;
+		const uint8_t* end;
+
+		VERA_NODISCARD size_t offset() const VERA_NOEXCEPT
+		{
+			return static_cast<size_t>(ptr - begin);
+		}
+
+		VERA_NODISCARD size_t remaining() const VERA_NOEXCEPT
+		{
+			return static_cast<size_t>(end - ptr);
+		}
+
+		template <class T>
+		VERA_NODISCARD bool read(T& out) VERA_NOEXCEPT
+		{
+			if (remaining() < sizeof(T)) return false;
+			memcpy(&out, ptr, sizeof(T));
+			ptr += sizeof(T);
+			return true;
+		}
+
+		VERA_NODISCARD const uint8_t* take(size_t size) VERA_NOEXCEPT
+		{
+			if (remaining() < size) return nullptr;
+			const uint8_t* result = ptr;
+			ptr += size;
+			return result;
+		}
+
+		VERA_NODISCARD bool seek(size_t offset) VERA_NOEXCEPT
+		{
+			if (static_cast<size_t>(end - begin) < offset) return false;
+			ptr = begin + offset;
+			return true;
+		}
+	};
 
-		std::ifstream input_file(path.data(), std::ios::binary);
+	static Result load(AssetLoader& loader, std::string_view path)
+	{
+		NodeRecord      root_node = {};
+		stack_allocator allocator(VERA_KIB(64));
+		MappedFile      file;
+		Header          header;
 
-		if (!input_file.is_open())
+		try {
+			file.open(path);
+		} catch (const std::exception&) {
 			return AssetResult::FileNotFound;
+		}
 
-		input_file.read(reinterpret_cast<char*>(&header), sizeof(Header));
-		if (memcmp(header.magic, FBX_HEADER_MAGIC, sizeof(header.magic)) != 0)
+		Cursor cursor = { file.data(), file.data(), file.data() + file.size() };
+
+		if (!cursor.read(header) || memcmp(header.magic, FBX_HEADER_MAGIC, sizeof(header.magic)) != 0)
 			return { AssetResult::InvalidMagic, "invalid header magic" };
 		
 		if (header.version < 7500)
-			FBX_FORWARD_RESULT(parse_node<NodeRecord32Raw>(input_file, allocator, root_node));
+			FBX_FORWARD_RESULT(parse_node<NodeRecord32Raw>(cursor, allocator, root_node));
 		else
-			FBX_FORWARD_RESULT(parse_node<NodeRecord64Raw>(input_file, allocator, root_node));
-
-		FBX_FORWARD_RESULT(check_footer(input_file, header.version));
+			FBX_FORWARD_RESULT(parse_node<NodeRecord64Raw>(cursor, allocator, root_node));
 
-		input_file.close();
+		FBX_FORWARD_RESULT(check_footer(cursor, header.version));
 
-		FBX_FORWARD_RESULT(parse_objects_node(loader, find_node(&root_node, "Objects")));
+		// records keep pointing into the mapping, it is released only after the scene is built
+		FBX_FORWARD_RESULT(parse_objects_node(loader, allocator, find_node(&root_node, "Objects")));
 		
 		loader.m_file_format = AssetFileFormat::FBX;
 		loader.m_version     = Version(
@@ -333,24 +309,42 @@ struct FBXLoader
 	}
 
 private:
-	static Result parse_objects_node(AssetLoader& loader, NodeRecord* node)
+	static Result parse_objects_node(AssetLoader& loader, stack_allocator& allocator, NodeRecord* node)
 	{
 		if (!node)
 			return { AssetResult::InvalidFormat, "missing Objects node" };
 
+		std::vector<ArrayPropertyRecord*> mesh_arrays;
+
+		// inflate everything the geometry extraction is about to read in one parallel batch
+		for (uint32_t i = 0; i < node->childCount; ++i) {
+			auto* child_node = &node->childs[i];
+
+			if (child_node->name != "Geometry") continue;
+
+			if (auto* array = find_array_property(child_node, "Vertices"))
+				mesh_arrays.push_back(array);
+			if (auto* array = find_array_property(child_node, "PolygonVertexIndex"))
+				mesh_arrays.push_back(array);
+		}
+
+		FBX_FORWARD_RESULT(inflate_arrays(allocator, std::move(mesh_arrays)));
+
 		auto model_node = scene::Node::create("model");
 
 		for (uint32_t i = 0; i < node->childCount; ++i) {
 			auto* child_node = &node->childs[i];
 
-			if (strcmp(child_node->name, "NodeAttribute") == 0) {
+			if (child_node->name == "NodeAttribute") {
 				FBX_FORWARD_RESULT(parse_node_attribute(loader, child_node));
-			} else if (strcmp(child_node->name, "Geometry") == 0) {
-				FBX_FORWARD_RESULT(parse_geometry_node(model_node, child_node));
+			} else if (child_node->name == "Geometry") {
+				FBX_FORWARD_RESULT(parse_geometry_node(allocator, model_node, child_node));
 			}
 		}
 
 		loader.m_scene->getRootNode()->addChild(model_node);
+
+		return AssetResult::Success;
 	}
 
 	static Result parse_node_attribute(AssetLoader& loader, NodeRecord* node)
@@ -358,60 +352,58 @@ private:
 		return AssetResult::Success;
 	}
 
-	// TODO: check error handling
-	static Result parse_geometry_node(ref<scene::Node> model_node, NodeRecord* node)
+	static Result parse_geometry_node(stack_allocator& allocator, ref<scene::Node> model_node, NodeRecord* node)
 	{
-		auto* vertex_node = find_node(node, "Vertices");
-		auto* index_node  = find_node(node, "PolygonVertexIndex");
+		auto* vertex_prop = find_array_property(node, "Vertices");
+		auto* index_prop  = find_array_property(node, "PolygonVertexIndex");
+
+		if (!vertex_prop || !index_prop)
+			return { AssetResult::InvalidFormat, "geometry without vertices or polygon indices" };
 
-		auto* vert_prop = static_cast<PropertyRecordType<ARRAY_COMP_DOUBLE>*>(vertex_node->properties[0]);
-		auto* idx_prop  = static_cast<PropertyRecordType<ARRAY_COMP_INT>*>(index_node->properties[0]);
+		const uint8_t* vertex_data;
+		const uint8_t* index_data;
+		uint32_t       vertex_length;
+		uint32_t       index_length;
 
-		std::vector<float3>   vertices(vert_prop->length / 3);
+		FBX_FORWARD_RESULT(get_array(allocator, vertex_prop, ARRAY_DOUBLE, vertex_data, vertex_length));
+		FBX_FORWARD_RESULT(get_array(allocator, index_prop, ARRAY_INT, index_data, index_length));
+
+		std::vector<float3>   vertices(vertex_length / 3);
 		std::vector<uint32_t> indices;
 
-		std::vector<double3> vert_buffer(vert_prop->length / 3);
-		std::vector<int32_t> idx_buffer(idx_prop->length);
-		uint32_t             vert_buffer_size;
-		uint32_t             idx_buffer_size;
-
-		uncompress(
-			reinterpret_cast<Bytef*>(vert_buffer.data()),
-			reinterpret_cast<uLongf*>(&vert_buffer_size),
-			reinterpret_cast<const Bytef*>(vert_prop->value),
-			vert_prop->size);
-
-		for (size_t i = 0; i < vert_buffer.size(); ++i) {
-			vertices[i].x = 0.01f * static_cast<float>(vert_buffer[i].x);
-			vertices[i].y = 0.01f * static_cast<float>(vert_buffer[i].y);
-			vertices[i].z = 0.01f * static_cast<float>(vert_buffer[i].z);
+		for (size_t i = 0; i < vertices.size(); ++i) {
+			auto vertex = load_array_element<double3>(vertex_data, i);
+
+			vertices[i].x = 0.01f * static_cast<float>(vertex.x);
+			vertices[i].y = 0.01f * static_cast<float>(vertex.y);
+			vertices[i].z = 0.01f * static_cast<float>(vertex.z);
 		}
 
-		uncompress(
-			reinterpret_cast<Bytef*>(idx_buffer.data()),
-			reinterpret_cast<uLongf*>(&idx_buffer_size),
-			reinterpret_cast<const Bytef*>(idx_prop->value),
-			idx_prop->size);
-
-		for (size_t i = 0, count = 0; i < idx_buffer.size(); i++) {
-			count++;
-
-			if (0 <= idx_buffer[i]) continue;
-
-			if (count == 3) {
-				indices.push_back(static_cast<uint32_t>(idx_buffer[i - 2]));
-				indices.push_back(static_cast<uint32_t>(idx_buffer[i - 1]));
-				indices.push_back(static_cast<uint32_t>(~idx_buffer[i - 0]));
-			} else if (count == 4) {
-				indices.push_back(static_cast<uint32_t>(idx_buffer[i - 3]));
-				indices.push_back(static_cast<uint32_t>(idx_buffer[i - 2]));
-				indices.push_back(static_cast<uint32_t>(idx_buffer[i - 1]));
-				indices.push_back(static_cast<uint32_t>(idx_buffer[i - 3]));
-				indices.push_back(static_cast<uint32_t>(idx_buffer[i - 1]));
-				indices.push_back(static_cast<uint32_t>(~idx_buffer[i - 0]));
+		indices.reserve(index_length / 4 * 6);
+
+		// the last index of each polygon is stored bitwise negated, polygons are fanned around their first corner
+		for (uint32_t i = 0, first = 0; i < index_length; ++i) {
+			if (0 <= load_array_element<int32_t>(index_data, i)) continue;
+
+			for (uint32_t corner = first + 1; corner + 1 <= i; ++corner) {
+				int32_t idx0 = load_array_element<int32_t>(index_data, first);
+				int32_t idx1 = load_array_element<int32_t>(index_data, corner);
+				int32_t idx2 = load_array_element<int32_t>(index_data, corner + 1);
+
+				if (corner + 1 == i)
+					idx2 = ~idx2;
+
+				if (vertices.size() <= static_cast<uint32_t>(idx0) ||
+					vertices.size() <= static_cast<uint32_t>(idx1) ||
+					vertices.size() <= static_cast<uint32_t>(idx2))
+					return { AssetResult::InvalidFormat, "polygon vertex index out of range" };
+
+				indices.push_back(static_cast<uint32_t>(idx0));
+				indices.push_back(static_cast<uint32_t>(idx1));
+				indices.push_back(static_cast<uint32_t>(idx2));
 			}
 
-			count = 0;
+			first = i + 1;
 		}
 
 		auto mesh_attr = scene::MeshAttribute::create();
@@ -425,298 +417,132 @@ private:
 	}
 
 	template <class NodeRecordType>
-	static Result parse_node(std::ifstream& input_file, stack_allocator& allocator, NodeRecord& parent_node)
+	static Result parse_node(Cursor& cursor, stack_allocator& allocator, NodeRecord& parent_node)
 	{
 		NodeRecordType raw_node;
 		size_t         prop_end_offset;
-		char*          name_buffer;
 
-		if ((parent_node.childCount = count_child_node(input_file)) != 0) {
+		FBX_FORWARD_RESULT(count_child_node<NodeRecordType>(cursor, parent_node.childCount));
+
+		if (parent_node.childCount != 0) {
 			parent_node.childs = allocator.allocate<NodeRecord>(parent_node.childCount);
 			FBX_CHECK_ALLOC(parent_node.childs);
 		}
 
 		for (uint32_t i = 0; i < parent_node.childCount + 1; ++i) {
-			input_file.read(reinterpret_cast<char*>(&raw_node), sizeof(NodeRecordType));
+			FBX_CHECK_READ(cursor.read(raw_node));
 
 			if (raw_node.endOffset == 0) break;
 			
 			NodeRecord& node = parent_node.childs[i] = {};
 
 			node.parent = &parent_node;
-			
-			name_buffer = allocator.allocate<char>(raw_node.nameLength + 1);
-			FBX_CHECK_ALLOC(name_buffer);
 
 			// parse name
-			input_file.read(name_buffer, raw_node.nameLength);
-			name_buffer[raw_node.nameLength] = '\0';
+			const uint8_t* name = cursor.take(raw_node.nameLength);
+			FBX_CHECK_READ(name);
 
-			node.name = name_buffer;
+			node.name = std::string_view(reinterpret_cast<const char*>(name), raw_node.nameLength);
 
 			// parse properties
-			prop_end_offset = raw_node.propertyListLength + input_file.tellg();
+			prop_end_offset = cursor.offset() + raw_node.propertyListLength;
+
+			if (cursor.remaining() < raw_node.propertyListLength)
+				return { AssetResult::InvalidFormat, "property record end offset mismatch" };
 
 			if ((node.propertyCount = static_cast<uint32_t>(raw_node.propertyCount)) != 0) {
-				node.properties = allocator.allocate<PropertyRecordPtr>(raw_node.propertyCount);
+				node.properties = allocator.allocate<PropertyRecordPtr>(node.propertyCount);
 				FBX_CHECK_ALLOC(node.properties);
 
-				for (uint32_t i = 0; i < raw_node.propertyCount; ++i)
-					FBX_FORWARD_RESULT(parse_property(input_file, allocator, &node.properties[i]));
+				for (uint32_t j = 0; j < node.propertyCount; ++j)
+					FBX_FORWARD_RESULT(parse_property(cursor, allocator, &node.properties[j]));
 			}
 
-			input_file.seekg(prop_end_offset);
+			FBX_CHECK_READ(cursor.seek(prop_end_offset));
 
-			if (input_file.tellg() != prop_end_offset)
-				return { AssetResult::InvalidFormat, "property record end offset mismatch" };
-
-			if (input_file.tellg() == raw_node.endOffset) continue;
+			if (cursor.offset() == raw_node.endOffset) continue;
 
 			// parse child nodes
-			FBX_FORWARD_RESULT(parse_node<NodeRecordType>(input_file, allocator, node));
+			FBX_FORWARD_RESULT(parse_node<NodeRecordType>(cursor, allocator, node));
 
-			if (input_file.tellg() != raw_node.endOffset)
+			if (cursor.offset() != raw_node.endOffset)
 				return { AssetResult::InvalidFormat, "node record end offset mismatch" };
 		}
 
 		return AssetResult::Success;
 	}
 
-	static Result parse_property(std::ifstream& input_file, stack_allocator& allocator, PropertyRecordPtr* prop_ptr)
-	{
-		PropertyRecordArrayRaw raw_prop;
-		uint32_t               length;
-		char*                  string_buffer;
-
-		switch (static_cast<PropertyTypeCode>(input_file.get())) {
-		case BYTE: {
-			auto* new_prop = allocator.allocate<PropertyRecordType<BYTE>>();
-			FBX_CHECK_ALLOC(new_prop);
-			new_prop->type = BYTE;
-			input_file.read(reinterpret_cast<char*>(&new_prop->value), sizeof(int8_t));
-			*prop_ptr = new_prop;
-		} break;
-		case SHORT: {
-			auto* new_prop = allocator.allocate<PropertyRecordType<SHORT>>();
-			FBX_CHECK_ALLOC(new_prop);
-			new_prop->type = SHORT;
-			input_file.read(reinterpret_cast<char*>(&new_prop->value), sizeof(int16_t));
-			*prop_ptr = new_prop;
-		} break;
-		case BOOL: {
-			auto* new_prop = allocator.allocate<PropertyRecordType<BOOL>>();
-			FBX_CHECK_ALLOC(new_prop);
-			new_prop->type = BOOL;
-			input_file.read(reinterpret_cast<char*>(&new_prop->value), sizeof(bool));
-			*prop_ptr = new_prop;
-		} break;
-		case CHAR: {
-			auto* new_prop = allocator.allocate<PropertyRecordType<CHAR>>();
-			FBX_CHECK_ALLOC(new_prop);
-			new_prop->type = CHAR;
-			input_file.read(reinterpret_cast<char*>(&new_prop->value), sizeof(char));
-			*prop_ptr = new_prop;
-		} break;
-		case INT: {
-			auto* new_prop = allocator.allocate<PropertyRecordType<INT>>();
-			FBX_CHECK_ALLOC(new_prop);
-			new_prop->type = INT;
-			input_file.read(reinterpret_cast<char*>(&new_prop->value), sizeof(int32_t));
-			*prop_ptr = new_prop;
-		} break;
-		case FLOAT: {
-			auto* new_prop = allocator.allocate<PropertyRecordType<FLOAT>>();
-			FBX_CHECK_ALLOC(new_prop);
-			new_prop->type = FLOAT;
-			input_file.read(reinterpret_cast<char*>(&new_prop->value), sizeof(float));
-			*prop_ptr = new_prop;
-		} break;
-		case DOUBLE: {
-			auto* new_prop = allocator.allocate<PropertyRecordType<DOUBLE>>();
-			FBX_CHECK_ALLOC(new_prop);
-			new_prop->type = DOUBLE;
-			input_file.read(reinterpret_cast<char*>(&new_prop->value), sizeof(double));
-			*prop_ptr = new_prop;
-		} break;
-		case LONG: {
-			auto* new_prop = allocator.allocate<PropertyRecordType<LONG>>();
-			FBX_CHECK_ALLOC(new_prop);
-			new_prop->type = LONG;
-			input_file.read(reinterpret_cast<char*>(&new_prop->value), sizeof(int64_t));
-			*prop_ptr = new_prop;
-		} break;
+	static Result parse_property(Cursor& cursor, stack_allocator& allocator, PropertyRecordPtr* prop_ptr)
+	{
+		uint8_t code;
+
+		FBX_CHECK_READ(cursor.read(code));
+
+		switch (static_cast<PropertyTypeCode>(code)) {
+		case BYTE:
+			return parse_scalar_property<BYTE>(cursor, allocator, prop_ptr);
+		case SHORT:
+			return parse_scalar_property<SHORT>(cursor, allocator, prop_ptr);
+		case BOOL:
+			return parse_scalar_property<BOOL>(cursor, allocator, prop_ptr);
+		case CHAR:
+			return parse_scalar_property<CHAR>(cursor, allocator, prop_ptr);
+		case INT:
+			return parse_scalar_property<INT>(cursor, allocator, prop_ptr);
+		case FLOAT:
+			return parse_scalar_property<FLOAT>(cursor, allocator, prop_ptr);
+		case DOUBLE:
+			return parse_scalar_property<DOUBLE>(cursor, allocator, prop_ptr);
+		case LONG:
+			return parse_scalar_property<LONG>(cursor, allocator, prop_ptr);
 		case BINARY: {
 			auto* new_prop = allocator.allocate<PropertyRecordType<BINARY>>();
 			FBX_CHECK_ALLOC(new_prop);
 			new_prop->type = BINARY;
-			input_file.read(reinterpret_cast<char*>(&length), sizeof(uint32_t));
-			new_prop->value = allocator.allocate<uint8_t>(length);
-			FBX_CHECK_ALLOC(new_prop->value);
-			input_file.read(reinterpret_cast<char*>(new_prop->value), length);
+			FBX_CHECK_READ(cursor.read(new_prop->length));
+			FBX_CHECK_READ(new_prop->value = cursor.take(new_prop->length));
 			*prop_ptr = new_prop;
 		} break;
 		case STRING: {
 			auto* new_prop = allocator.allocate<PropertyRecordType<STRING>>();
 			FBX_CHECK_ALLOC(new_prop);
 			new_prop->type = STRING;
-			input_file.read(reinterpret_cast<char*>(&length), sizeof(uint32_t));
-			string_buffer = allocator.allocate<char>(length + 1);
-			FBX_CHECK_ALLOC(string_buffer);
-			input_file.read(string_buffer, length);
-			string_buffer[length] = '\0';
-			new_prop->length = length;
-			new_prop->value  = string_buffer;
+			FBX_CHECK_READ(cursor.read(new_prop->length));
+			FBX_CHECK_READ(new_prop->value = reinterpret_cast<const char*>(cursor.take(new_prop->length)));
 			*prop_ptr = new_prop;
 		} break;
-		case ARRAY_BOOL: {
-			input_file.read(reinterpret_cast<char*>(&raw_prop), sizeof(PropertyRecordArrayRaw));
-			if (raw_prop.encoding == 0) {
-				auto* new_prop = allocator.allocate<PropertyRecordType<ARRAY_BOOL>>();
-				FBX_CHECK_ALLOC(new_prop);
-				new_prop->type   = ARRAY_BOOL;
-				new_prop->length = raw_prop.arrayLength;
-				new_prop->value  = allocator.allocate<bool>(raw_prop.arrayLength);
-				FBX_CHECK_ALLOC(new_prop->value);
-				input_file.read(reinterpret_cast<char*>(new_prop->value), raw_prop.arrayLength);
-				*prop_ptr = new_prop;
-			} else if (raw_prop.encoding == 1) {
-				auto* new_prop = allocator.allocate<PropertyRecordType<ARRAY_COMP_BOOL>>();
-				FBX_CHECK_ALLOC(new_prop);
-				new_prop->type   = ARRAY_COMP_BOOL;
-				new_prop->length = raw_prop.arrayLength;
-				new_prop->size   = raw_prop.compressedLength;
-				new_prop->value  = allocator.allocate<uint8_t>(raw_prop.compressedLength);
-				FBX_CHECK_ALLOC(new_prop->value);
-				input_file.read(reinterpret_cast<char*>(new_prop->value), raw_prop.compressedLength);
-				*prop_ptr = new_prop;
-			} else {
-				return { AssetResult::InvalidFormat, "invalid array encoding"};
-			}
-		} break;
-		case ARRAY_UBYTE: {
-			input_file.read(reinterpret_cast<char*>(&raw_prop), sizeof(PropertyRecordArrayRaw));
-			if (raw_prop.encoding == 0) {
-				auto* new_prop = allocator.allocate<PropertyRecordType<ARRAY_UBYTE>>();
-				FBX_CHECK_ALLOC(new_prop);
-				new_prop->type   = ARRAY_UBYTE;
-				new_prop->length = raw_prop.arrayLength;
-				new_prop->value  = allocator.allocate<uint8_t>(raw_prop.arrayLength);
-				FBX_CHECK_ALLOC(new_prop->value);
-				input_file.read(reinterpret_cast<char*>(new_prop->value), raw_prop.arrayLength);
-				*prop_ptr = new_prop;
-			} else if (raw_prop.encoding == 1) {
-				auto* new_prop = allocator.allocate<PropertyRecordType<ARRAY_COMP_UBYTE>>();
-				FBX_CHECK_ALLOC(new_prop);
-				new_prop->type   = ARRAY_COMP_UBYTE;
-				new_prop->length = raw_prop.arrayLength;
-				new_prop->size   = raw_prop.compressedLength;
-				new_prop->value  = allocator.allocate<uint8_t>(raw_prop.compressedLength);
-				FBX_CHECK_ALLOC(new_prop->value);
-				input_file.read(reinterpret_cast<char*>(new_prop->value), raw_prop.compressedLength);
-				*prop_ptr = new_prop;
-			} else {
-				return { AssetResult::InvalidFormat, "invalid array encoding"};
-			}
-		} break;
-		case ARRAY_INT: {
-			input_file.read(reinterpret_cast<char*>(&raw_prop), sizeof(PropertyRecordArrayRaw));
-			if (raw_prop.encoding == 0) {
-				auto* new_prop = allocator.allocate<PropertyRecordType<ARRAY_INT>>();
-				FBX_CHECK_ALLOC(new_prop);
-				new_prop->type   = ARRAY_INT;
-				new_prop->length = raw_prop.arrayLength;
-				new_prop->value  = allocator.allocate<int32_t>(raw_prop.arrayLength);
-				FBX_CHECK_ALLOC(new_prop->value);
-				input_file.read(reinterpret_cast<char*>(new_prop->value), raw_prop.arrayLength * sizeof(int32_t));
-				*prop_ptr = new_prop;
-			} else if (raw_prop.encoding == 1) {
-				auto* new_prop = allocator.allocate<PropertyRecordType<ARRAY_COMP_INT>>();
-				FBX_CHECK_ALLOC(new_prop);
-				new_prop->type   = ARRAY_COMP_INT;
-				new_prop->length = raw_prop.arrayLength;
-				new_prop->size   = raw_prop.compressedLength;
-				new_prop->value  = allocator.allocate<uint8_t>(raw_prop.compressedLength);
-				FBX_CHECK_ALLOC(new_prop->value);
-				input_file.read(reinterpret_cast<char*>(new_prop->value), raw_prop.compressedLength);
-				*prop_ptr = new_prop;
-			} else {
-				return { AssetResult::InvalidFormat, "invalid array encoding"};
-			}
-		} break;
-		case ARRAY_LONG: {
-			input_file.read(reinterpret_cast<char*>(&raw_prop), sizeof(PropertyRecordArrayRaw));
-			if (raw_prop.encoding == 0) {
-				auto* new_prop = allocator.allocate<PropertyRecordType<ARRAY_LONG>>();
-				FBX_CHECK_ALLOC(new_prop);
-				new_prop->type   = ARRAY_LONG;
-				new_prop->length = raw_prop.arrayLength;
-				new_prop->value  = allocator.allocate<int64_t>(raw_prop.arrayLength);
-				FBX_CHECK_ALLOC(new_prop->value);
-				input_file.read(reinterpret_cast<char*>(new_prop->value), raw_prop.arrayLength * sizeof(int64_t));
-				*prop_ptr = new_prop;
-			} else if (raw_prop.encoding == 1) {
-				auto* new_prop = allocator.allocate<PropertyRecordType<ARRAY_COMP_LONG>>();
-				FBX_CHECK_ALLOC(new_prop);
-				new_prop->type   = ARRAY_COMP_LONG;
-				new_prop->length = raw_prop.arrayLength;
-				new_prop->size   = raw_prop.compressedLength;
-				new_prop->value  = allocator.allocate<uint8_t>(raw_prop.compressedLength);
-				FBX_CHECK_ALLOC(new_prop->value);
-				input_file.read(reinterpret_cast<char*>(new_prop->value), raw_prop.compressedLength);
-				*prop_ptr = new_prop;
-			} else {
-				return { AssetResult::InvalidFormat, "invalid array encoding"};
-			}
-		} break;
-		case ARRAY_FLOAT: {
-			input_file.read(reinterpret_cast<char*>(&raw_prop), sizeof(PropertyRecordArrayRaw));
-			if (raw_prop.encoding == 0) {
-				auto* new_prop = allocator.allocate<PropertyRecordType<ARRAY_FLOAT>>();
-				FBX_CHECK_ALLOC(new_prop);
-				new_prop->type   = ARRAY_FLOAT;
-				new_prop->length = raw_prop.arrayLength;
-				new_prop->value  = allocator.allocate<float>(raw_prop.arrayLength);
-				FBX_CHECK_ALLOC(new_prop->value);
-				input_file.read(reinterpret_cast<char*>(new_prop->value), raw_prop.arrayLength * sizeof(float));
-				*prop_ptr = new_prop;
-			} else if (raw_prop.encoding == 1) {
-				auto* new_prop = allocator.allocate<PropertyRecordType<ARRAY_COMP_FLOAT>>();
-				FBX_CHECK_ALLOC(new_prop);
-				new_prop->type   = ARRAY_COMP_FLOAT;
-				new_prop->length = raw_prop.arrayLength;
-				new_prop->size   = raw_prop.compressedLength;
-				new_prop->value  = allocator.allocate<uint8_t>(raw_prop.compressedLength);
-				FBX_CHECK_ALLOC(new_prop->value);
-				input_file.read(reinterpret_cast<char*>(new_prop->value), raw_prop.compressedLength);
-				*prop_ptr = new_prop;
-			} else {
-				return { AssetResult::InvalidFormat, "invalid array encoding"};
-			}
-		} break;
+		case ARRAY_BOOL:
+		case ARRAY_UBYTE:
+		case ARRAY_INT:
+		case ARRAY_LONG:
+		case ARRAY_FLOAT:
 		case ARRAY_DOUBLE: {
-			input_file.read(reinterpret_cast<char*>(&raw_prop), sizeof(PropertyRecordArrayRaw));
+			PropertyRecordArrayRaw raw_prop;
+			FBX_CHECK_READ(cursor.read(raw_prop));
+
+			auto* new_prop = allocator.allocate<ArrayPropertyRecord>();
+			FBX_CHECK_ALLOC(new_prop);
+
 			if (raw_prop.encoding == 0) {
-				auto* new_prop = allocator.allocate<PropertyRecordType<ARRAY_DOUBLE>>();
-				FBX_CHECK_ALLOC(new_prop);
-				new_prop->type   = ARRAY_DOUBLE;
-				new_prop->length = raw_prop.arrayLength;
-				new_prop->value  = allocator.allocate<double>(raw_prop.arrayLength);
-				FBX_CHECK_ALLOC(new_prop->value);
-				input_file.read(reinterpret_cast<char*>(new_prop->value), raw_prop.arrayLength * sizeof(double));
-				*prop_ptr = new_prop;
+				uint64_t size = uint64_t(raw_prop.arrayLength) * get_array_element_size(static_cast<PropertyTypeCode>(code));
+
+				if (UINT32_MAX < size)
+					return { AssetResult::InvalidFormat, "array property too large" };
+
+				new_prop->type = static_cast<PropertyTypeCode>(code);
+				new_prop->size = static_cast<uint32_t>(size);
 			} else if (raw_prop.encoding == 1) {
-				auto* new_prop = allocator.allocate<PropertyRecordType<ARRAY_COMP_DOUBLE>>();
-				FBX_CHECK_ALLOC(new_prop);
-				new_prop->type   = ARRAY_COMP_DOUBLE;
-				new_prop->length = raw_prop.arrayLength;
-				new_prop->size   = raw_prop.compressedLength;
-				new_prop->value  = allocator.allocate<uint8_t>(raw_prop.compressedLength);
-				FBX_CHECK_ALLOC(new_prop->value);
-				input_file.read(reinterpret_cast<char*>(new_prop->value), raw_prop.compressedLength);
-				*prop_ptr = new_prop;
+				new_prop->type = get_compressed_code(static_cast<PropertyTypeCode>(code));
+				new_prop->size = raw_prop.compressedLength;
 			} else {
 				return { AssetResult::InvalidFormat, "invalid array encoding"};
 			}
+
+			new_prop->length   = raw_prop.arrayLength;
+			new_prop->inflated = nullptr;
+			new_prop->failed   = false;
+			FBX_CHECK_READ(new_prop->data = cursor.take(new_prop->size));
+			*prop_ptr = new_prop;
 		} break;
 		default:
 			return { AssetResult::InvalidFormat, "invalid property record type"};
@@ -725,75 +551,248 @@ private:
 		return AssetResult::Success;
 	}
 
-	static Result check_footer(std::ifstream& input_file, uint32_t header_version)
+	template <PropertyTypeCode Code>
+	static Result parse_scalar_property(Cursor& cursor, stack_allocator& allocator, PropertyRecordPtr* prop_ptr)
 	{
-		char     footer_id[16];
-		char     padding[16];
-		char     zeros[4];
-		char     static_padding[120];
-		char     magic[16];
-		size_t   padding_size;
-		uint32_t version;
+		auto* new_prop = allocator.allocate<PropertyRecordType<Code>>();
+		FBX_CHECK_ALLOC(new_prop);
+		new_prop->type = Code;
+		FBX_CHECK_READ(cursor.read(new_prop->value));
+		*prop_ptr = new_prop;
+
+		return AssetResult::Success;
+	}
+
+	static Result check_footer(Cursor& cursor, uint32_t header_version)
+	{
+		const uint8_t* footer_id;
+		const uint8_t* padding;
+		const uint8_t* zeros;
+		const uint8_t* static_padding;
+		const uint8_t* magic;
+		size_t         padding_size;
+		uint32_t       version;
 
-		input_file.read(reinterpret_cast<char*>(&footer_id), sizeof(footer_id));
+		FBX_CHECK_READ(footer_id = cursor.take(16));
 
-		padding_size = 0x10 - input_file.tellg() % 0x10;
+		padding_size = 0x10 - cursor.offset() % 0x10;
 
-		input_file.read(reinterpret_cast<char*>(&padding), padding_size);
+		FBX_CHECK_READ(padding = cursor.take(padding_size));
 		if (!memvcmp(padding, padding_size, 0))
 			return { AssetResult::InvalidPadding, "found non-zero values in alignment padding" };
 
-		input_file.read(reinterpret_cast<char*>(&zeros), sizeof(zeros));
-		if (!memvcmp(zeros, sizeof(zeros), 0))
+		FBX_CHECK_READ(zeros = cursor.take(4));
+		if (!memvcmp(zeros, 4, 0))
 			return { AssetResult::InvalidPadding, "found non-zero values after footer id" };
 
-		input_file.read(reinterpret_cast<char*>(&version), sizeof(version));
+		FBX_CHECK_READ(cursor.read(version));
 		if (version != header_version)
 			return { AssetResult::InvalidFormat, "footer version mismatch" };
 
-		input_file.read(reinterpret_cast<char*>(&static_padding), sizeof(static_padding));
-		if (!memvcmp(static_padding, sizeof(static_padding), 0))
+		FBX_CHECK_READ(static_padding = cursor.take(120));
+		if (!memvcmp(static_padding, 120, 0))
 			return { AssetResult::InvalidPadding, "found non-zero values in static padding" };
 		
-		input_file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
-		if (memcmp(magic, FBX_FOOTER_MAGIC, sizeof(magic)) != 0)
+		FBX_CHECK_READ(magic = cursor.take(16));
+		if (memcmp(magic, FBX_FOOTER_MAGIC, 16) != 0)
 			return { AssetResult::InvalidMagic, "invalid footer magic" };
 
 		return AssetResult::Success;
 	}
 
+	// Inflates the compressed arrays of the list that have not been inflated yet. Output memory is
+	// taken from the allocator up front, then the arrays are handed out to worker threads largest first.
+	static Result inflate_arrays(stack_allocator& allocator, std::vector<ArrayPropertyRecord*> arrays)
+	{
+		std::erase_if(arrays, [](const ArrayPropertyRecord* array) {
+			return !is_compressed_code(array->type) || array->inflated;
+		});
+
+		if (arrays.empty())
+			return AssetResult::Success;
+
+		for (auto* array : arrays) {
+			size_t size = get_array_byte_size(*array);
+
+			// 8 byte granularity keeps inflated elements naturally aligned
+			array->inflated = reinterpret_cast<uint8_t*>(allocator.allocate<uint64_t>(std::max<size_t>((size + 7) / 8, 1)));
+			FBX_CHECK_ALLOC(array->inflated);
+		}
+
+		std::sort(VERA_SPAN(arrays), [](const ArrayPropertyRecord* lhs, const ArrayPropertyRecord* rhs) {
+			return lhs->size > rhs->size;
+		});
+
+		std::atomic<size_t> next_array = 0;
+
+		auto inflate_next = [&]() {
+			for (size_t i; (i = next_array.fetch_add(1, std::memory_order_relaxed)) < arrays.size();)
+				inflate_array(*arrays[i]);
+		};
+
+		size_t thread_count = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), arrays.size());
+
+		std::vector<std::thread> workers;
+		workers.reserve(thread_count - 1);
+
+		for (size_t i = 1; i < thread_count; ++i)
+			workers.emplace_back(inflate_next);
+
+		inflate_next();
+
+		for (auto& worker : workers)
+			worker.join();
+
+		for (const auto* array : arrays)
+			if (array->failed)
+				return { AssetResult::InvalidFormat, "failed to inflate compressed array" };
+
+		return AssetResult::Success;
+	}
+
+	static void inflate_array(ArrayPropertyRecord& array) VERA_NOEXCEPT
+	{
+		uLongf expected_size = static_cast<uLongf>(get_array_byte_size(array));
+		uLongf inflated_size = expected_size;
+
+		int result = uncompress(
+			reinterpret_cast<Bytef*>(array.inflated),
+			&inflated_size,
+			reinterpret_cast<const Bytef*>(array.data),
+			static_cast<uLong>(array.size));
+
+		array.failed = result != Z_OK || inflated_size != expected_size;
+	}
+
+	// returns the elements of an array property, inflating it first if nothing has requested it yet
+	static Result get_array(
+		stack_allocator&     allocator,
+		ArrayPropertyRecord* array,
+		PropertyTypeCode     code,
+		const uint8_t*&      out_data,
+		uint32_t&            out_length
+	) {
+		if (array->type == code) {
+			out_data   = array->data;
+			out_length = array->length;
+			return AssetResult::Success;
+		}
+
+		if (array->type != get_compressed_code(code))
+			return { AssetResult::InvalidFormat, "unexpected array property type" };
+
+		if (!array->inflated)
+			FBX_FORWARD_RESULT(inflate_arrays(allocator, { array }));
+
+		if (array->failed)
+			return { AssetResult::InvalidFormat, "failed to inflate compressed array" };
+
+		out_data   = array->inflated;
+		out_length = array->length;
+
+		return AssetResult::Success;
+	}
+
+	template <class T>
+	static T load_array_element(const uint8_t* data, size_t idx) VERA_NOEXCEPT
+	{
+		T result;
+		memcpy(&result, data + idx * sizeof(T), sizeof(T));
+		return result;
+	}
+
+	static ArrayPropertyRecord* find_array_property(NodeRecord* node, std::string_view name)
+	{
+		auto* child_node = find_node(node, name);
+
+		if (!child_node || child_node->propertyCount == 0)
+			return nullptr;
+
+		auto* prop = child_node->properties[0];
+
+		if (get_array_element_size(prop->type) == 0)
+			return nullptr;
+
+		return static_cast<ArrayPropertyRecord*>(prop);
+	}
+
+	static bool is_compressed_code(PropertyTypeCode code)
+	{
+		return ARRAY_COMP_BOOL <= code && code <= ARRAY_COMP_DOUBLE;
+	}
+
+	static PropertyTypeCode get_compressed_code(PropertyTypeCode code)
+	{
+		switch (code) {
+		case ARRAY_BOOL:   return ARRAY_COMP_BOOL;
+		case ARRAY_UBYTE:  return ARRAY_COMP_UBYTE;
+		case ARRAY_INT:    return ARRAY_COMP_INT;
+		case ARRAY_LONG:   return ARRAY_COMP_LONG;
+		case ARRAY_FLOAT:  return ARRAY_COMP_FLOAT;
+		case ARRAY_DOUBLE: return ARRAY_COMP_DOUBLE;
+		}
+
+		return code;
+	}
+
+	// zero for every non array type
+	static size_t get_array_element_size(PropertyTypeCode code)
+	{
+		switch (code) {
+		case ARRAY_BOOL:
+		case ARRAY_UBYTE:
+		case ARRAY_COMP_BOOL:
+		case ARRAY_COMP_UBYTE:  return 1;
+		case ARRAY_INT:
+		case ARRAY_FLOAT:
+		case ARRAY_COMP_INT:
+		case ARRAY_COMP_FLOAT:  return 4;
+		case ARRAY_LONG:
+		case ARRAY_DOUBLE:
+		case ARRAY_COMP_LONG:
+		case ARRAY_COMP_DOUBLE: return 8;
+		}
+
+		return 0;
+	}
+
+	static size_t get_array_byte_size(const ArrayPropertyRecord& array)
+	{
+		return static_cast<size_t>(array.length) * get_array_element_size(array.type);
+	}
+
 	static NodeAttributeType get_node_attribute_type(NodeRecord* node)
 	{
-		if (strcmp(node->name, "NodeAttribute"))
+		if (node->name != "NodeAttribute")
 			return NodeAttributeType::Unknown;
 
 		if (auto* type_node = find_node(node, "TypeFlags")) {
 			if (type_node->propertyCount == 0)
 				return NodeAttributeType::Unknown;
 
-			auto* type_prop = static_cast<PropertyRecordType<STRING>*>(type_node->properties[0]);
-
-			if (strcmp(type_prop->value, "Null") == 0)             return NodeAttributeType::Null;
-			if (strcmp(type_prop->value, "Marker") == 0)           return NodeAttributeType::Marker;
-			if (strcmp(type_prop->value, "Skeleton") == 0)         return NodeAttributeType::Skeleton;
-			if (strcmp(type_prop->value, "Mesh") == 0)             return NodeAttributeType::Mesh;
-			if (strcmp(type_prop->value, "Nurbs") == 0)            return NodeAttributeType::Nurbs;
-			if (strcmp(type_prop->value, "Patch") == 0)            return NodeAttributeType::Patch;
-			if (strcmp(type_prop->value, "Camera") == 0)           return NodeAttributeType::Camera;
-			if (strcmp(type_prop->value, "CameraStereo") == 0)     return NodeAttributeType::CameraStereo;
-			if (strcmp(type_prop->value, "CameraSwitcher") == 0)   return NodeAttributeType::CameraSwitcher;
-			if (strcmp(type_prop->value, "Light") == 0)            return NodeAttributeType::Light;
-			if (strcmp(type_prop->value, "OpticalReference") == 0) return NodeAttributeType::OpticalReference;
-			if (strcmp(type_prop->value, "OpticalMarker") == 0)    return NodeAttributeType::OpticalMarker;
-			if (strcmp(type_prop->value, "NurbsCurve") == 0)       return NodeAttributeType::NurbsCurve;
-			if (strcmp(type_prop->value, "TrimNurbsSurface") == 0) return NodeAttributeType::TrimNurbsSurface;
-			if (strcmp(type_prop->value, "Boundary") == 0)         return NodeAttributeType::Boundary;
-			if (strcmp(type_prop->value, "NurbsSurface") == 0)     return NodeAttributeType::NurbsSurface;
-			if (strcmp(type_prop->value, "Shape") == 0)            return NodeAttributeType::Shape;
-			if (strcmp(type_prop->value, "LODGroup") == 0)         return NodeAttributeType::LODGroup;
-			if (strcmp(type_prop->value, "SubDiv") == 0)           return NodeAttributeType::SubDiv;
-			if (strcmp(type_prop->value, "CachedEffect") == 0)     return NodeAttributeType::CachedEffect;
-			if (strcmp(type_prop->value, "Line") == 0)             return NodeAttributeType::Line;
+			auto type_name = get_string_property(type_node->properties[0]);
+
+			if (type_name == "Null")             return NodeAttributeType::Null;
+			if (type_name == "Marker")           return NodeAttributeType::Marker;
+			if (type_name == "Skeleton")         return NodeAttributeType::Skeleton;
+			if (type_name == "Mesh")             return NodeAttributeType::Mesh;
+			if (type_name == "Nurbs")            return NodeAttributeType::Nurbs;
+			if (type_name == "Patch")            return NodeAttributeType::Patch;
+			if (type_name == "Camera")           return NodeAttributeType::Camera;
+			if (type_name == "CameraStereo")     return NodeAttributeType::CameraStereo;
+			if (type_name == "CameraSwitcher")   return NodeAttributeType::CameraSwitcher;
+			if (type_name == "Light")            return NodeAttributeType::Light;
+			if (type_name == "OpticalReference") return NodeAttributeType::OpticalReference;
+			if (type_name == "OpticalMarker")    return NodeAttributeType::OpticalMarker;
+			if (type_name == "NurbsCurve")       return NodeAttributeType::NurbsCurve;
+			if (type_name == "TrimNurbsSurface") return NodeAttributeType::TrimNurbsSurface;
+			if (type_name == "Boundary")         return NodeAttributeType::Boundary;
+			if (type_name == "NurbsSurface")     return NodeAttributeType::NurbsSurface;
+			if (type_name == "Shape")            return NodeAttributeType::Shape;
+			if (type_name == "LODGroup")         return NodeAttributeType::LODGroup;
+			if (type_name == "SubDiv")           return NodeAttributeType::SubDiv;
+			if (type_name == "CachedEffect")     return NodeAttributeType::CachedEffect;
+			if (type_name == "Line")             return NodeAttributeType::Line;
 		}
 
 		return NodeAttributeType::Unknown;
@@ -829,12 +828,14 @@ private:
 		return "UNKNOWN";
 	}
 
-	static const char* get_string_property(PropertyRecord* prop)
+	static std::string_view get_string_property(PropertyRecord* prop)
 	{
 		if (prop->type != STRING)
-			return nullptr;
+			return {};
+
+		auto* string_prop = static_cast<PropertyRecordType<STRING>*>(prop);
 
-		return static_cast<PropertyRecordType<STRING>*>(prop)->value;
+		return std::string_view(string_prop->value, string_prop->length);
 	}
 
 	static NodeRecord* find_node(NodeRecord* parent_node, std::string_view name)
@@ -861,25 +862,26 @@ private:
 		return nullptr;
 	}
 
-	static uint32_t count_child_node(std::ifstream& input_file)
+	template <class NodeRecordType>
+	static Result count_child_node(Cursor cursor, uint32_t& out_count)
 	{
-		size_t   offset = input_file.tellg();
-		uint32_t result = 0;
-		uint32_t end_offset;
+		decltype(NodeRecordType::endOffset) end_offset;
+
+		out_count = 0;
 
 		while (true) {
-			input_file.read(reinterpret_cast<char*>(&end_offset), sizeof(uint32_t));
+			FBX_CHECK_READ(cursor.read(end_offset));
 
 			if (end_offset == 0) break;
 
-			input_file.seekg(end_offset);
+			// offsets must move forward or a malformed file could loop forever
+			if (end_offset <= cursor.offset() || !cursor.seek(end_offset))
+				return { AssetResult::InvalidFormat, "node record end offset out of range" };
 
-			result++;
+			out_count++;
 		}
 
-		input_file.seekg(offset);
-
-		return result;
+		return AssetResult::Success;
 	}
 };
 
@@ -0,0 +1,239 @@
+#include "../impl/command_pool_manager.h"
+#include "../impl/device_impl.h"
+
+#include "../../include/vera/core/device.h"
+
+VERA_NAMESPACE_BEGIN
+
+// command buffers allocated at once when a frame pool runs out
+static constexpr uint32_t FRAME_BUFFER_ALLOCATE_COUNT = 4;
+
+// free standalone pools kept per queue family, pools released beyond it are destroyed
+static constexpr size_t MAX_FREE_STANDALONE_POOLS = 32;
+
+// free frame pools kept per queue family, pools of complete frames beyond it are destroyed
+static constexpr size_t MAX_FREE_FRAME_POOLS = 64;
+
+CommandPoolManager::CommandPoolManager(ref<Device> device) VERA_NOEXCEPT :
+	m_device(device),
+	m_next_frame_key(1) {}
+
+CommandPoolManager::~CommandPoolManager() VERA_NOEXCEPT
+{
+	auto vk_device = get_vk_device(m_device);
+
+	// destroying a pool frees the command buffers allocated from it
+	for (auto& [queue_family, pools] : m_standalone)
+		for (auto& cmd : pools)
+			vk_device.destroy(cmd.pool);
+
+	for (auto& [queue_family, pools] : m_free_frame_pools)
+		destroyPools(pools);
+
+	for (auto& [frame_key, frame] : m_frames)
+		destroyPools(frame.pools);
+}
+
+CommandPoolManager::StandaloneCommandBuffer CommandPoolManager::acquireStandalone(uint32_t queue_family)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (auto& pools = m_standalone[queue_family]; !pools.empty()) {
+			auto result = pools.back();
+			pools.pop_back();
+			return result;
+		}
+	}
+
+	auto vk_device = get_vk_device(m_device);
+
+	vk::CommandPoolCreateInfo pool_info;
+	pool_info.flags            = vk::CommandPoolCreateFlagBits::eResetCommandBuffer;
+	pool_info.queueFamilyIndex = queue_family;
+
+	StandaloneCommandBuffer result;
+	result.pool = vk_device.createCommandPool(pool_info);
+
+	vk::CommandBufferAllocateInfo alloc_info;
+	alloc_info.commandPool        = result.pool;
+	alloc_info.level              = vk::CommandBufferLevel::ePrimary;
+	alloc_info.commandBufferCount = 1;
+
+	try {
+		result.buffer = vk_device.allocateCommandBuffers(alloc_info).front();
+	} catch (...) {
+		vk_device.destroy(result.pool);
+		throw;
+	}
+
+	return result;
+}
+
+void CommandPoolManager::releaseStandalone(uint32_t queue_family, const StandaloneCommandBuffer& cmd) VERA_NOEXCEPT
+{
+	auto vk_device = get_vk_device(m_device);
+
+	// the pool only holds this buffer, resetting it here keeps acquireStandalone() cheap
+	vk_device.resetCommandPool(cmd.pool);
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (auto& pools = m_standalone[queue_family]; pools.size() < MAX_FREE_STANDALONE_POOLS) {
+			pools.push_back(cmd);
+			return;
+		}
+	}
+
+	vk_device.destroy(cmd.pool);
+}
+
+uint64_t CommandPoolManager::beginFrame()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	uint64_t frame_key = m_next_frame_key++;
+
+	m_frames.emplace(frame_key, FrameState{ {}, {}, false });
+
+	return frame_key;
+}
+
+vk::CommandBuffer CommandPoolManager::acquireFrameBuffer(uint64_t frame_key, uint32_t queue_family, vk::CommandBufferLevel level)
+{
+	auto       vk_device   = get_vk_device(m_device);
+	auto       thread_id   = std::this_thread::get_id();
+	FramePool* frame_pool  = nullptr;
+	bool       needs_reset = false;
+	FramePools dropped;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto iter = m_frames.find(frame_key);
+
+		VERA_ASSERT_MSG(iter != m_frames.end() && !iter->second.retired, "command buffer requested for a retired frame");
+
+		// a pool is only recorded by the thread it is bound to, the lock guards the lists of pools
+		for (auto& pool : iter->second.pools) {
+			if (pool->thread == thread_id && pool->queueFamily == queue_family) {
+				frame_pool = pool.get();
+				break;
+			}
+		}
+
+		if (!frame_pool) {
+			reclaimFrames(dropped);
+
+			std::unique_ptr<FramePool> new_pool;
+
+			if (auto& free_pools = m_free_frame_pools[queue_family]; !free_pools.empty()) {
+				new_pool = std::move(free_pools.back());
+				free_pools.pop_back();
+				needs_reset = true;
+			} else {
+				new_pool = std::make_unique<FramePool>();
+				new_pool->pool           = nullptr;
+				new_pool->queueFamily    = queue_family;
+				new_pool->primaryCount   = 0;
+				new_pool->secondaryCount = 0;
+			}
+
+			new_pool->thread = thread_id;
+			frame_pool       = iter->second.pools.emplace_back(std::move(new_pool)).get();
+		}
+	}
+
+	destroyPools(dropped);
+
+	if (!frame_pool->pool) {
+		vk::CommandPoolCreateInfo pool_info;
+		pool_info.flags            = vk::CommandPoolCreateFlagBits::eTransient;
+		pool_info.queueFamilyIndex = queue_family;
+
+		frame_pool->pool = vk_device.createCommandPool(pool_info);
+	} else if (needs_reset) {
+		vk_device.resetCommandPool(frame_pool->pool);
+
+		frame_pool->primaryCount   = 0;
+		frame_pool->secondaryCount = 0;
+	}
+
+	bool  is_primary = level == vk::CommandBufferLevel::ePrimary;
+	auto& buffers    = is_primary ? frame_pool->primaries : frame_pool->secondaries;
+	auto& count      = is_primary ? frame_pool->primaryCount : frame_pool->secondaryCount;
+
+	if (count == buffers.size()) {
+		vk::CommandBufferAllocateInfo alloc_info;
+		alloc_info.commandPool        = frame_pool->pool;
+		alloc_info.level              = level;
+		alloc_info.commandBufferCount = FRAME_BUFFER_ALLOCATE_COUNT;
+
+		auto new_buffers = vk_device.allocateCommandBuffers(alloc_info);
+		buffers.insert(buffers.end(), new_buffers.begin(), new_buffers.end());
+	}
+
+	return buffers[count++];
+}
+
+void CommandPoolManager::retireFrame(uint64_t frame_key, CommandSync sync)
+{
+	FramePools dropped;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto iter = m_frames.find(frame_key);
+
+		VERA_ASSERT_MSG(iter != m_frames.end() && !iter->second.retired, "frame is retired twice");
+
+		if (iter->second.pools.empty()) {
+			m_frames.erase(iter);
+			return;
+		}
+
+		iter->second.sync    = std::move(sync);
+		iter->second.retired = true;
+
+		// frames are reclaimed here as well, so their syncs are not kept alive until some thread
+		// happens to need a new pool
+		reclaimFrames(dropped);
+	}
+
+	destroyPools(dropped);
+}
+
+void CommandPoolManager::reclaimFrames(FramePools& dropped)
+{
+	for (auto iter = m_frames.begin(); iter != m_frames.end();) {
+		auto& frame = iter->second;
+
+		if (!frame.retired || (!frame.sync.empty() && !frame.sync.isComplete())) {
+			++iter;
+			continue;
+		}
+
+		for (auto& pool : frame.pools) {
+			auto& free_pools = m_free_frame_pools[pool->queueFamily];
+
+			if (free_pools.size() < MAX_FREE_FRAME_POOLS)
+				free_pools.push_back(std::move(pool));
+			else
+				dropped.push_back(std::move(pool));
+		}
+
+		iter = m_frames.erase(iter);
+	}
+}
+
+void CommandPoolManager::destroyPools(const FramePools& pools) VERA_NOEXCEPT
+{
+	auto vk_device = get_vk_device(m_device);
+
+	for (const auto& pool : pools)
+		if (pool->pool)
+			vk_device.destroy(pool->pool);
+}
+
+VERA_NAMESPACE_END
@@ -0,0 +1,238 @@
+#include "../../include/vera/core/draw_packet.h"
+
+#include "../../include/vera/core/device.h"
+#include <algorithm>
+#include <cstring>
+
+VERA_NAMESPACE_BEGIN
+
+static bool is_same_mesh(const DrawIndexedIndirectCommand& cmd, const DrawMeshRange& mesh)
+{
+	return
+		cmd.indexCount   == mesh.indexCount &&
+		cmd.firstIndex   == mesh.firstIndex &&
+		cmd.vertexOffset == mesh.vertexOffset;
+}
+
+static size_t grow_buffer_size(size_t curr_size, size_t required_size)
+{
+	return std::max(required_size, curr_size + curr_size / 2);
+}
+
+// stable LSD radix sort by bytes of the key, passes over bytes every key shares are skipped
+template <class SortItem>
+static void radix_sort(std::vector<SortItem>& items, std::vector<SortItem>& temp)
+{
+	if (items.empty()) return;
+
+	uint32_t counts[8][256] = {};
+
+	for (const auto& item : items)
+		for (uint32_t b = 0; b < 8; ++b)
+			counts[b][(item.key >> (b * 8)) & 0xff]++;
+
+	temp.resize(items.size());
+
+	for (uint32_t b = 0; b < 8; ++b) {
+		auto& count = counts[b];
+
+		if (count[(items.front().key >> (b * 8)) & 0xff] == items.size())
+			continue;
+
+		uint32_t offsets[256];
+		uint32_t sum = 0;
+
+		for (uint32_t d = 0; d < 256; ++d) {
+			offsets[d] = sum;
+			sum       += count[d];
+		}
+
+		for (const auto& item : items)
+			temp[offsets[(item.key >> (b * 8)) & 0xff]++] = item;
+
+		items.swap(temp);
+	}
+}
+
+DrawPacketBuilder::DrawPacketBuilder(uint32_t instance_size) VERA_NOEXCEPT :
+	m_instance_size(instance_size) {}
+
+void DrawPacketBuilder::clear() VERA_NOEXCEPT
+{
+	m_draws.clear();
+	m_instance_data.clear();
+	m_instance_order.clear();
+	m_commands.clear();
+	m_packets.clear();
+}
+
+void DrawPacketBuilder::reserve(size_t draw_count)
+{
+	m_draws.reserve(draw_count);
+	m_instance_data.reserve(draw_count * m_instance_size);
+	m_instance_order.reserve(draw_count);
+	m_sort_items.reserve(draw_count);
+	m_commands.reserve(draw_count);
+}
+
+void DrawPacketBuilder::add(uint32_t bucket, const DrawMeshRange& mesh, const void* instance_data)
+{
+	auto& draw = m_draws.emplace_back();
+	draw.bucket = bucket;
+	draw.mesh   = mesh;
+
+	if (m_instance_size != 0) {
+		auto* data_ptr = static_cast<const std::byte*>(instance_data);
+		m_instance_data.insert(m_instance_data.end(), data_ptr, data_ptr + m_instance_size);
+	}
+}
+
+void DrawPacketBuilder::build()
+{
+	m_sort_items.resize(m_draws.size());
+
+	for (uint32_t i = 0; i < m_draws.size(); ++i) {
+		m_sort_items[i].key  = static_cast<uint64_t>(m_draws[i].bucket) << 32 | m_draws[i].mesh.firstIndex;
+		m_sort_items[i].draw = i;
+	}
+
+	radix_sort(m_sort_items, m_sort_temp);
+
+	m_instance_order.resize(m_draws.size());
+	m_commands.clear();
+	m_packets.clear();
+
+	DrawPacket* packet = nullptr;
+
+	for (uint32_t i = 0; i < m_sort_items.size(); ++i) {
+		uint32_t    draw_idx = m_sort_items[i].draw;
+		const auto& draw     = m_draws[draw_idx];
+
+		if (!packet || packet->bucket != draw.bucket) {
+			packet = &m_packets.emplace_back();
+			packet->bucket        = draw.bucket;
+			packet->firstCommand  = static_cast<uint32_t>(m_commands.size());
+			packet->commandCount  = 0;
+			packet->firstInstance = i;
+			packet->instanceCount = 0;
+		}
+
+		// meshes sharing a first index may interleave, they only merge less
+		if (packet->commandCount != 0 && is_same_mesh(m_commands.back(), draw.mesh)) {
+			m_commands.back().instanceCount++;
+		} else {
+			auto& cmd = m_commands.emplace_back();
+			cmd.indexCount    = draw.mesh.indexCount;
+			cmd.instanceCount = 1;
+			cmd.firstIndex    = draw.mesh.firstIndex;
+			cmd.vertexOffset  = draw.mesh.vertexOffset;
+			cmd.firstInstance = i;
+
+			packet->commandCount++;
+		}
+
+		packet->instanceCount++;
+		m_instance_order[i] = draw_idx;
+	}
+}
+
+void DrawPacketBuilder::write(void* command_dst, void* instance_dst) const
+{
+	if (!m_commands.empty())
+		memcpy(command_dst, m_commands.data(), getCommandSize());
+
+	if (m_instance_size == 0) return;
+
+	auto*       dst_ptr = static_cast<std::byte*>(instance_dst);
+	const auto* src_ptr = m_instance_data.data();
+
+	// mapped memory is usually write combined, so instances are gathered and written in order
+	for (uint32_t index : m_instance_order) {
+		memcpy(dst_ptr, src_ptr + static_cast<size_t>(index) * m_instance_size, m_instance_size);
+		dst_ptr += m_instance_size;
+	}
+}
+
+array_view<DrawPacket> DrawPacketBuilder::getPackets() const VERA_NOEXCEPT
+{
+	return m_packets;
+}
+
+array_view<DrawIndexedIndirectCommand> DrawPacketBuilder::getCommands() const VERA_NOEXCEPT
+{
+	return m_commands;
+}
+
+uint32_t DrawPacketBuilder::getInstanceSize() const VERA_NOEXCEPT
+{
+	return m_instance_size;
+}
+
+uint32_t DrawPacketBuilder::getDrawCount() const VERA_NOEXCEPT
+{
+	return static_cast<uint32_t>(m_draws.size());
+}
+
+size_t DrawPacketBuilder::getCommandSize() const VERA_NOEXCEPT
+{
+	return m_commands.size() * sizeof(DrawIndexedIndirectCommand);
+}
+
+size_t DrawPacketBuilder::getInstanceDataSize() const VERA_NOEXCEPT
+{
+	return m_instance_order.size() * m_instance_size;
+}
+
+obj<DrawPacketBuffer> DrawPacketBuffer::create(obj<Device> device)
+{
+	auto new_obj = obj<DrawPacketBuffer>(new DrawPacketBuffer());
+
+	new_obj->m_device = std::move(device);
+
+	return new_obj;
+}
+
+bool DrawPacketBuffer::upload(const DrawPacketBuilder& builder)
+{
+	size_t command_size  = builder.getCommandSize();
+	size_t instance_size = builder.getInstanceDataSize();
+	bool   recreated     = false;
+
+	// buffers are recreated rather than resized, so a descriptor still pointing at the old one
+	// is never left with a destroyed buffer handle
+	if (command_size != 0 && (!m_indirect_buffer || m_indirect_buffer->size() < command_size)) {
+		size_t curr_size = m_indirect_buffer ? m_indirect_buffer->size() : 0;
+		m_indirect_buffer = Buffer::createIndirect(m_device, grow_buffer_size(curr_size, command_size));
+		recreated         = true;
+	}
+
+	if (instance_size != 0 && (!m_instance_buffer || m_instance_buffer->size() < instance_size)) {
+		size_t curr_size = m_instance_buffer ? m_instance_buffer->size() : 0;
+		m_instance_buffer = Buffer::createStorage(m_device, grow_buffer_size(curr_size, instance_size));
+		recreated         = true;
+	}
+
+	// both buffers are host coherent, the writes need no flush
+	builder.write(
+		command_size != 0 ? m_indirect_buffer->map() : nullptr,
+		instance_size != 0 ? m_instance_buffer->map() : nullptr);
+
+	return recreated;
+}
+
+obj<Buffer> DrawPacketBuffer::getIndirectBuffer() const VERA_NOEXCEPT
+{
+	return m_indirect_buffer;
+}
+
+obj<Buffer> DrawPacketBuffer::getInstanceBuffer() const VERA_NOEXCEPT
+{
+	return m_instance_buffer;
+}
+
+size_t DrawPacketBuffer::getCommandOffset(const DrawPacket& packet) VERA_NOEXCEPT
+{
+	return static_cast<size_t>(packet.firstCommand) * sizeof(DrawIndexedIndirectCommand);
+}
+
+VERA_NAMESPACE_END
@@ -0,0 +1,82 @@
+#include "../impl/pipeline_compiler.h"
+#include <algorithm>
+
+VERA_NAMESPACE_BEGIN
+
+PipelineCompiler::PipelineCompiler(uint32_t thread_count) VERA_NOEXCEPT :
+	m_thread_count(thread_count),
+	m_stop(false)
+{
+	if (m_thread_count == 0)
+		m_thread_count = std::max(std::thread::hardware_concurrency() / 2, 1u);
+}
+
+PipelineCompiler::~PipelineCompiler() VERA_NOEXCEPT
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+
+	m_job_cond.notify_all();
+
+	for (auto& thread : m_threads)
+		thread.join();
+
+	VERA_ASSERT_MSG(m_jobs.empty(), "pipeline compile jobs left in queue");
+}
+
+void PipelineCompiler::enqueue(Job job)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (m_threads.empty())
+			for (uint32_t i = 0; i < m_thread_count; ++i)
+				m_threads.emplace_back(&PipelineCompiler::run, this);
+
+		m_jobs.push_back(std::move(job));
+	}
+
+	m_job_cond.notify_one();
+}
+
+void PipelineCompiler::signal(std::atomic<bool>& ready) VERA_NOEXCEPT
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		ready.store(true, std::memory_order_release);
+	}
+
+	m_ready_cond.notify_all();
+}
+
+void PipelineCompiler::wait(const std::atomic<bool>& ready) VERA_NOEXCEPT
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	m_ready_cond.wait(lock, [&] { return ready.load(std::memory_order_acquire); });
+}
+
+void PipelineCompiler::run() VERA_NOEXCEPT
+{
+	while (true) {
+		Job job;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			m_job_cond.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+
+			if (m_jobs.empty())
+				return;
+
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+		}
+
+		job();
+	}
+}
+
+VERA_NAMESPACE_END
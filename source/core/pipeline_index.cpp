@@ -0,0 +1,600 @@
+#include "../impl/pipeline_index.h"
+#include "../impl/byte_stream.h"
+#include "../impl/device_impl.h"
+#include "../impl/descriptor_set_layout_impl.h"
+#include "../impl/pipeline_impl.h"
+#include "../impl/shader_impl.h"
+
+#include "../../include/vera/core/device.h"
+#include "../../include/vera/core/shader.h"
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
+#define PIPELINE_INDEX_MAGIC   0x49505256 // "VRPI"
+#define PIPELINE_INDEX_VERSION 2
+
+VERA_NAMESPACE_BEGIN
+
+static void write_stencil_op_state(ByteWriter& writer, const StencilOpState& state)
+{
+	writer.u32(static_cast<uint32_t>(state.failOp));
+	writer.u32(static_cast<uint32_t>(state.passOp));
+	writer.u32(static_cast<uint32_t>(state.depthFailOp));
+	writer.u32(static_cast<uint32_t>(state.compareOp));
+	writer.u32(state.compareMask);
+	writer.u32(state.writeMask);
+	writer.u32(state.reference);
+}
+
+static void read_stencil_op_state(ByteReader& reader, StencilOpState& state)
+{
+	state.failOp      = read_enum<StencilOp>(reader);
+	state.passOp      = read_enum<StencilOp>(reader);
+	state.depthFailOp = read_enum<StencilOp>(reader);
+	state.compareOp   = read_enum<CompareOp>(reader);
+	state.compareMask = reader.u32();
+	state.writeMask   = reader.u32();
+	state.reference   = reader.u32();
+}
+
+static void write_set_layout(ByteWriter& writer, const PipelineSetLayoutRecipe& set_layout)
+{
+	writer.u32(set_layout.flags.mask());
+	writer.u32(static_cast<uint32_t>(set_layout.bindings.size()));
+
+	for (const auto& binding : set_layout.bindings) {
+		writer.u32(binding.flags.mask());
+		writer.u32(binding.binding);
+		writer.u32(static_cast<uint32_t>(binding.descriptorType));
+		writer.u32(binding.descriptorCount);
+		writer.u32(binding.stageFlags.mask());
+	}
+}
+
+static void write_push_constant_range(ByteWriter& writer, const PushConstantRange& range)
+{
+	writer.u32(range.stageFlags.mask());
+	writer.u32(range.offset);
+	writer.u32(range.size);
+}
+
+std::vector<uint8_t> PipelineRecipe::serialize() const
+{
+	ByteWriter writer;
+
+	writer.u32(static_cast<uint32_t>(bindPoint));
+
+	writer.u32(static_cast<uint32_t>(stages.size()));
+	for (const auto& stage : stages) {
+		writer.u32(static_cast<uint32_t>(stage.stage));
+		writer.key(stage.codeKey);
+		writer.bytes(array_view<uint8_t>(
+			reinterpret_cast<const uint8_t*>(stage.entryPoint.data()),
+			stage.entryPoint.size()));
+	}
+
+	writer.u32(static_cast<uint32_t>(setLayouts.size()));
+	for (const auto& set_layout : setLayouts)
+		write_set_layout(writer, set_layout);
+
+	writer.u32(static_cast<uint32_t>(pushConstantRanges.size()));
+	for (const auto& range : pushConstantRanges)
+		write_push_constant_range(writer, range);
+
+	writer.u8(hasVertexInput);
+	writer.u32(static_cast<uint32_t>(vertexBindings.size()));
+	for (const auto& binding : vertexBindings) {
+		writer.u32(binding.binding);
+		writer.u32(binding.stride);
+		writer.u8(binding.perInstance);
+		writer.u32(static_cast<uint32_t>(binding.attributes.size()));
+
+		for (const auto& attribute : binding.attributes) {
+			writer.u32(attribute.id);
+			writer.u32(attribute.offset);
+			writer.u32(static_cast<uint32_t>(attribute.format));
+		}
+	}
+
+	writer.u8(primitive.enableRestart);
+	writer.u32(static_cast<uint32_t>(primitive.topology));
+	writer.u32(patchControlPoints);
+
+	writer.u8(rasterization.depthClampEnable);
+	writer.u8(rasterization.rasterizerDiscardEnable);
+	writer.u32(static_cast<uint32_t>(rasterization.polygonMode));
+	writer.u32(rasterization.cullMode.mask());
+	writer.u32(static_cast<uint32_t>(rasterization.frontFace));
+	writer.u8(rasterization.depthBiasEnable);
+	writer.f32(rasterization.depthBiasConstantFactor);
+	writer.f32(rasterization.depthBiasClamp);
+	writer.f32(rasterization.depthBiasSlopeFactor);
+	writer.f32(rasterization.lineWidth);
+
+	writer.u32(static_cast<uint32_t>(depthStencil.depthFormat));
+	writer.u8(depthStencil.depthWriteEnable);
+	writer.u32(static_cast<uint32_t>(depthStencil.depthCompareOp));
+	writer.u8(depthStencil.depthBoundsTestEnable);
+	writer.u32(static_cast<uint32_t>(depthStencil.stencilFormat));
+	write_stencil_op_state(writer, depthStencil.front);
+	write_stencil_op_state(writer, depthStencil.back);
+	writer.f32(depthStencil.minDepthBounds);
+	writer.f32(depthStencil.maxDepthBounds);
+
+	writer.u8(colorBlend.enableLogicOp);
+	writer.u32(static_cast<uint32_t>(colorBlend.logicOp));
+	writer.u32(static_cast<uint32_t>(colorBlend.attachments.size()));
+	for (const auto& attachment : colorBlend.attachments) {
+		writer.u8(static_cast<bool>(attachment.blendEnable));
+		writer.u32(static_cast<uint32_t>(attachment.srcColorBlendFactor));
+		writer.u32(static_cast<uint32_t>(attachment.dstColorBlendFactor));
+		writer.u32(static_cast<uint32_t>(attachment.colorBlendOp));
+		writer.u32(static_cast<uint32_t>(attachment.srcAlphaBlendFactor));
+		writer.u32(static_cast<uint32_t>(attachment.dstAlphaBlendFactor));
+		writer.u32(static_cast<uint32_t>(attachment.alphaBlendOp));
+		writer.u32(attachment.colorWriteMask.mask());
+	}
+	for (float constant : colorBlend.blendConstants)
+		writer.f32(constant);
+
+	writer.u32(static_cast<uint32_t>(colorFormats.size()));
+	for (auto format : colorFormats)
+		writer.u32(static_cast<uint32_t>(format));
+
+	writer.u32(static_cast<uint32_t>(dynamicStates.size()));
+	for (auto state : dynamicStates)
+		writer.u32(static_cast<uint32_t>(state));
+
+	return std::move(writer.data());
+}
+
+bool PipelineRecipe::deserialize(PipelineRecipe& recipe, array_view<uint8_t> bytes)
+{
+	ByteReader reader(bytes);
+
+	recipe.bindPoint = read_enum<PipelineBindPoint>(reader);
+
+	recipe.stages.resize(reader.count(24));
+	for (auto& stage : recipe.stages) {
+		stage.stage   = read_enum<ShaderStageFlagBits>(reader);
+		stage.codeKey = reader.key();
+
+		auto entry_point = reader.bytes();
+		stage.entryPoint = std::string(reinterpret_cast<const char*>(entry_point.data()), entry_point.size());
+	}
+
+	recipe.setLayouts.resize(reader.count(8));
+	for (auto& set_layout : recipe.setLayouts) {
+		set_layout.flags = read_flags<DescriptorSetLayoutCreateFlags>(reader);
+		set_layout.bindings.resize(reader.count(20));
+
+		for (auto& binding : set_layout.bindings) {
+			binding.flags           = read_flags<DescriptorSetLayoutBindingFlags>(reader);
+			binding.binding         = reader.u32();
+			binding.descriptorType  = read_enum<DescriptorType>(reader);
+			binding.descriptorCount = reader.u32();
+			binding.stageFlags      = read_flags<ShaderStageFlags>(reader);
+		}
+	}
+
+	recipe.pushConstantRanges.resize(reader.count(12));
+	for (auto& range : recipe.pushConstantRanges) {
+		range.stageFlags = read_flags<ShaderStageFlags>(reader);
+		range.offset     = reader.u32();
+		range.size       = reader.u32();
+	}
+
+	recipe.hasVertexInput = reader.u8();
+	recipe.vertexBindings.resize(reader.count(13));
+	for (auto& binding : recipe.vertexBindings) {
+		binding.binding     = reader.u32();
+		binding.stride      = reader.u32();
+		binding.perInstance = reader.u8();
+		binding.attributes.resize(reader.count(12));
+
+		for (auto& attribute : binding.attributes) {
+			attribute.id     = reader.u32();
+			attribute.offset = reader.u32();
+			attribute.format = read_enum<VertexFormat>(reader);
+		}
+	}
+
+	recipe.primitive.enableRestart = reader.u8();
+	recipe.primitive.topology      = read_enum<PrimitiveTopology>(reader);
+	recipe.patchControlPoints      = reader.u32();
+
+	auto& rs = recipe.rasterization;
+	rs.depthClampEnable        = reader.u8();
+	rs.rasterizerDiscardEnable = reader.u8();
+	rs.polygonMode             = read_enum<PolygonMode>(reader);
+	rs.cullMode                = read_flags<CullModeFlags>(reader);
+	rs.frontFace               = read_enum<FrontFace>(reader);
+	rs.depthBiasEnable         = reader.u8();
+	rs.depthBiasConstantFactor = reader.f32();
+	rs.depthBiasClamp          = reader.f32();
+	rs.depthBiasSlopeFactor    = reader.f32();
+	rs.lineWidth               = reader.f32();
+
+	auto& ds = recipe.depthStencil;
+	ds.depthFormat           = read_enum<DepthFormat>(reader);
+	ds.depthWriteEnable      = reader.u8();
+	ds.depthCompareOp        = read_enum<CompareOp>(reader);
+	ds.depthBoundsTestEnable = reader.u8();
+	ds.stencilFormat         = read_enum<StencilFormat>(reader);
+	read_stencil_op_state(reader, ds.front);
+	read_stencil_op_state(reader, ds.back);
+	ds.minDepthBounds        = reader.f32();
+	ds.maxDepthBounds        = reader.f32();
+
+	auto& cb = recipe.colorBlend;
+	cb.enableLogicOp = reader.u8();
+	cb.logicOp       = read_enum<LogicOp>(reader);
+	cb.attachments.resize(reader.count(29));
+	for (auto& attachment : cb.attachments) {
+		attachment.blendEnable         = static_cast<bool>(reader.u8());
+		attachment.srcColorBlendFactor = read_enum<BlendFactor>(reader);
+		attachment.dstColorBlendFactor = read_enum<BlendFactor>(reader);
+		attachment.colorBlendOp        = read_enum<BlendOp>(reader);
+		attachment.srcAlphaBlendFactor = read_enum<BlendFactor>(reader);
+		attachment.dstAlphaBlendFactor = read_enum<BlendFactor>(reader);
+		attachment.alphaBlendOp        = read_enum<BlendOp>(reader);
+		attachment.colorWriteMask      = read_flags<ColorComponentFlags>(reader);
+	}
+	for (float& constant : cb.blendConstants)
+		constant = reader.f32();
+
+	recipe.colorFormats.resize(reader.count(4));
+	for (auto& format : recipe.colorFormats)
+		format = read_enum<Format>(reader);
+
+	recipe.dynamicStates.resize(reader.count(4));
+	for (auto& state : recipe.dynamicStates)
+		state = read_enum<DynamicState>(reader);
+
+	return !reader.failed() && reader.atEnd();
+}
+
+PipelineIndex::PipelineIndex(ref<Device> device, std::string_view path) VERA_NOEXCEPT :
+	m_device(device),
+	m_path(path),
+	m_stop(false),
+	m_dirty(false) {}
+
+PipelineIndex::~PipelineIndex() VERA_NOEXCEPT
+{
+	stopPrecompile();
+}
+
+void PipelineIndex::load()
+{
+	auto& device_impl = CoreObject::getImpl(m_device);
+	auto& props       = device_impl.vkDeviceProperties;
+
+	std::vector<uint8_t> binary;
+	std::ifstream        file(m_path, std::ios::binary | std::ios::ate);
+
+	// a missing or stale index only means a cold start
+	if (!file.is_open())
+		return;
+
+	binary.resize(static_cast<size_t>(file.tellg()));
+	file.seekg(0, std::ios::beg);
+	file.read(reinterpret_cast<char*>(binary.data()), binary.size());
+
+	ByteReader reader(binary);
+
+	if (reader.u32() != PIPELINE_INDEX_MAGIC || reader.u32() != PIPELINE_INDEX_VERSION)
+		return;
+	if (reader.u32() != props.vendorID || reader.u32() != props.deviceID)
+		return;
+	for (uint8_t uuid_byte : props.pipelineCacheUUID)
+		if (reader.u8() != uuid_byte) return;
+
+	std::vector<Entry>                       entries;
+	std::unordered_map<uint64_t, size_t>     entry_map;
+	std::unordered_map<uint64_t, ShaderCode> shaders;
+
+	uint32_t shader_count = reader.count(20);
+	for (uint32_t i = 0; i < shader_count; ++i) {
+		ShaderCode code;
+		code.key = reader.key();
+		code.spirv.resize(reader.count(4));
+
+		for (auto& word : code.spirv)
+			word = reader.u32();
+
+		shaders.emplace(code.key.low, std::move(code));
+	}
+
+	uint32_t entry_count = reader.count(20);
+	for (uint32_t i = 0; i < entry_count; ++i) {
+		auto& entry = entries.emplace_back();
+		entry.key   = reader.key();
+		entry.state = EntryState::Pending;
+
+		auto bytes = reader.bytes();
+		entry.recipe.assign(bytes.begin(), bytes.end());
+
+		if (!entry_map.emplace(entry.key.low, entries.size() - 1).second)
+			entries.pop_back();
+	}
+
+	if (reader.failed())
+		return;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_entries   = std::move(entries);
+	m_entry_map = std::move(entry_map);
+	m_shaders   = std::move(shaders);
+}
+
+void PipelineIndex::save() VERA_NOEXCEPT
+{
+	auto& device_impl = CoreObject::getImpl(m_device);
+	auto& props       = device_impl.vkDeviceProperties;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (!m_dirty || m_path.empty())
+		return;
+
+	ByteWriter writer;
+
+	writer.u32(PIPELINE_INDEX_MAGIC);
+	writer.u32(PIPELINE_INDEX_VERSION);
+	writer.u32(props.vendorID);
+	writer.u32(props.deviceID);
+	for (uint8_t uuid_byte : props.pipelineCacheUUID)
+		writer.u8(uuid_byte);
+
+	writer.u32(static_cast<uint32_t>(m_shaders.size()));
+	for (const auto& [low, code] : m_shaders) {
+		writer.key(code.key);
+		writer.u32(static_cast<uint32_t>(code.spirv.size()));
+
+		for (uint32_t word : code.spirv)
+			writer.u32(word);
+	}
+
+	writer.u32(static_cast<uint32_t>(m_entries.size()));
+	for (const auto& entry : m_entries) {
+		writer.key(entry.key);
+		writer.bytes(entry.recipe);
+	}
+
+	std::ofstream file(m_path, std::ios::binary);
+
+	// called while the device is torn down, losing the index only costs a cold start
+	if (!file.is_open()) {
+		Logger::warn("failed to write pipeline index: {}", m_path);
+		return;
+	}
+
+	file.write(reinterpret_cast<const char*>(writer.data().data()), writer.data().size());
+	m_dirty = false;
+}
+
+void PipelineIndex::startPrecompile()
+{
+	VERA_ASSERT_MSG(!m_worker.joinable(), "pipeline precompile already started");
+
+	if (m_entries.empty())
+		return;
+
+	m_stop   = false;
+	m_worker = std::thread(&PipelineIndex::precompile, this);
+}
+
+void PipelineIndex::stopPrecompile() VERA_NOEXCEPT
+{
+	auto& device_impl = CoreObject::getImpl(m_device);
+
+	m_stop = true;
+
+	if (m_worker.joinable())
+		m_worker.join();
+
+	// nobody asked for these during this run, they stay in the index for the next one
+	for (auto& entry : m_entries) {
+		if (entry.pipeline) {
+			device_impl.vkDevice.destroy(entry.pipeline);
+			entry.pipeline = nullptr;
+			entry.state    = EntryState::Claimed;
+		}
+	}
+
+	for (auto& [low, code] : m_shaders) {
+		if (code.module) {
+			device_impl.vkDevice.destroy(code.module);
+			code.module = nullptr;
+		}
+	}
+
+	for (const auto& [low, layout] : m_pipeline_layouts)
+		device_impl.vkDevice.destroy(layout.pipelineLayout);
+	for (const auto& [low, layout] : m_set_layouts)
+		device_impl.vkDevice.destroy(layout.setLayout);
+
+	m_pipeline_layouts.clear();
+	m_set_layouts.clear();
+}
+
+vk::Pipeline PipelineIndex::claim(const hash128_t& key)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	auto iter = m_entry_map.find(key.low);
+	if (iter == m_entry_map.end() || m_entries[iter->second].key != key)
+		return {};
+
+	size_t idx = iter->second;
+
+	m_cond.wait(lock, [&] { return m_entries[idx].state != EntryState::Building; });
+
+	auto&        entry  = m_entries[idx];
+	vk::Pipeline result = entry.pipeline;
+
+	entry.pipeline = nullptr;
+	entry.state    = EntryState::Claimed;
+
+	return result;
+}
+
+void PipelineIndex::record(const hash128_t& key, const PipelineRecipe& recipe, array_view<obj<Shader>> shaders)
+{
+	auto bytes = recipe.serialize();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (m_entry_map.contains(key.low))
+		return;
+
+	auto& entry = m_entries.emplace_back();
+	entry.key    = key;
+	entry.recipe = std::move(bytes);
+	entry.state  = EntryState::Claimed;
+
+	m_entry_map.emplace(key.low, m_entries.size() - 1);
+
+	for (const auto& shader : shaders) {
+		auto& shader_impl = CoreObject::getImpl(shader);
+
+		if (m_shaders.contains(shader_impl.codeKey.low))
+			continue;
+
+		auto& code = m_shaders[shader_impl.codeKey.low];
+		code.key   = shader_impl.codeKey;
+		code.spirv = shader_impl.spirvCode;
+	}
+
+	m_dirty = true;
+}
+
+void PipelineIndex::precompile() VERA_NOEXCEPT
+{
+	size_t entry_count;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		entry_count = m_entries.size();
+	}
+
+	for (size_t i = 0; i < entry_count && !m_stop; ++i) {
+		std::vector<uint8_t> bytes;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			auto& entry = m_entries[i];
+			if (entry.state != EntryState::Pending)
+				continue;
+
+			entry.state = EntryState::Building;
+			bytes       = entry.recipe;
+		}
+
+		PipelineRecipe recipe;
+		vk::Pipeline   pipeline;
+
+		try {
+			if (PipelineRecipe::deserialize(recipe, bytes))
+				pipeline = build(recipe);
+		} catch (const std::exception&) {
+			// leave it to Pipeline::create, which reports the error to the caller
+			pipeline = nullptr;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			auto& entry = m_entries[i];
+			entry.pipeline = pipeline;
+			entry.state    = pipeline ? EntryState::Ready : EntryState::Claimed;
+		}
+
+		m_cond.notify_all();
+	}
+}
+
+vk::Pipeline PipelineIndex::build(const PipelineRecipe& recipe)
+{
+	auto& device_impl = CoreObject::getImpl(m_device);
+
+	std::vector<vk::ShaderModule>        modules;
+	std::vector<vk::DescriptorSetLayout> set_layouts;
+	std::vector<vk::PushConstantRange>   push_constant_ranges;
+
+	for (const auto& stage : recipe.stages) {
+		ShaderCode* code = nullptr;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			if (auto iter = m_shaders.find(stage.codeKey.low); iter != m_shaders.end())
+				code = &iter->second;
+		}
+
+		if (!code || code->key != stage.codeKey)
+			return {};
+
+		// modules are only touched by this thread until it is joined
+		if (!code->module) {
+			vk::ShaderModuleCreateInfo module_info;
+			module_info.codeSize = code->spirv.size() * sizeof(uint32_t);
+			module_info.pCode    = code->spirv.data();
+
+			code->module = device_impl.vkDevice.createShaderModule(module_info);
+		}
+
+		modules.push_back(code->module);
+	}
+
+	// permutations mostly share their layouts, so layouts are kept once per serialized content
+	ByteWriter layout_writer;
+
+	for (const auto& set_layout : recipe.setLayouts) {
+		ByteWriter set_writer;
+		write_set_layout(set_writer, set_layout);
+
+		const auto  set_key = hash_bytes_128(set_writer.data().data(), set_writer.data().size());
+		auto&       entry   = m_set_layouts[set_key.low];
+
+		if (!entry.setLayout) {
+			entry.key       = set_key;
+			entry.setLayout = create_vk_descriptor_set_layout(device_impl, set_layout.flags, set_layout.bindings);
+		} else if (entry.key != set_key) {
+			return {};
+		}
+
+		set_layouts.push_back(entry.setLayout);
+		layout_writer.key(set_key);
+	}
+
+	for (const auto& range : recipe.pushConstantRanges) {
+		push_constant_ranges.push_back(get_vk_push_constant_range(range));
+		write_push_constant_range(layout_writer, range);
+	}
+
+	const auto layout_key = hash_bytes_128(layout_writer.data().data(), layout_writer.data().size());
+	auto&      layout     = m_pipeline_layouts[layout_key.low];
+
+	if (!layout.pipelineLayout) {
+		// a layout compatible with the one Pipeline::create will use, binding works across compatible layouts
+		vk::PipelineLayoutCreateInfo layout_info;
+		layout_info.setLayoutCount         = static_cast<uint32_t>(set_layouts.size());
+		layout_info.pSetLayouts            = set_layouts.data();
+		layout_info.pushConstantRangeCount = static_cast<uint32_t>(push_constant_ranges.size());
+		layout_info.pPushConstantRanges    = push_constant_ranges.data();
+
+		layout.key            = layout_key;
+		layout.pipelineLayout = device_impl.vkDevice.createPipelineLayout(layout_info);
+	} else if (layout.key != layout_key) {
+		return {};
+	}
+
+	return create_vk_pipeline(device_impl, recipe, modules, layout.pipelineLayout);
+}
+
+VERA_NAMESPACE_END
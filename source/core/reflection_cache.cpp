@@ -0,0 +1,107 @@
+#include "../impl/reflection_cache.h"
+#include "../impl/byte_stream.h"
+
+#include "../../include/vera/core/logger.h"
+#include <fstream>
+
+#define REFLECTION_CACHE_MAGIC   0x43525256 // "VRRC"
+#define REFLECTION_CACHE_VERSION 2
+
+VERA_NAMESPACE_BEGIN
+
+ReflectionCache::ReflectionCache(std::string_view path) VERA_NOEXCEPT :
+	m_path(path),
+	m_dirty(false) {}
+
+void ReflectionCache::load()
+{
+	std::vector<uint8_t> binary;
+	std::ifstream        file(m_path, std::ios::binary | std::ios::ate);
+
+	// a missing or stale cache only means every shader is parsed again
+	if (!file.is_open())
+		return;
+
+	binary.resize(static_cast<size_t>(file.tellg()));
+	file.seekg(0, std::ios::beg);
+	file.read(reinterpret_cast<char*>(binary.data()), binary.size());
+
+	ByteReader reader(binary);
+
+	if (reader.u32() != REFLECTION_CACHE_MAGIC || reader.u32() != REFLECTION_CACHE_VERSION)
+		return;
+
+	std::unordered_map<uint64_t, Entry> entries;
+
+	uint32_t entry_count = reader.count(20);
+	for (uint32_t i = 0; i < entry_count; ++i) {
+		Entry entry;
+		entry.key = reader.key();
+
+		auto bytes = reader.bytes();
+		entry.bytes.assign(bytes.begin(), bytes.end());
+
+		entries.emplace(entry.key.low, std::move(entry));
+	}
+
+	if (reader.failed())
+		return;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_entries = std::move(entries);
+}
+
+void ReflectionCache::save() VERA_NOEXCEPT
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (!m_dirty || m_path.empty())
+		return;
+
+	ByteWriter writer;
+
+	writer.u32(REFLECTION_CACHE_MAGIC);
+	writer.u32(REFLECTION_CACHE_VERSION);
+
+	writer.u32(static_cast<uint32_t>(m_entries.size()));
+	for (const auto& [low, entry] : m_entries) {
+		writer.key(entry.key);
+		writer.bytes(entry.bytes);
+	}
+
+	std::ofstream file(m_path, std::ios::binary);
+
+	if (!file.is_open()) {
+		Logger::warn("failed to write reflection cache: {}", m_path);
+		return;
+	}
+
+	file.write(reinterpret_cast<const char*>(writer.data().data()), writer.data().size());
+	m_dirty = false;
+}
+
+bool ReflectionCache::find(const hash128_t& key, std::vector<uint8_t>& out_bytes) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto iter = m_entries.find(key.low);
+	if (iter == m_entries.end() || iter->second.key != key)
+		return false;
+
+	out_bytes = iter->second.bytes;
+	return true;
+}
+
+void ReflectionCache::record(const hash128_t& key, std::vector<uint8_t>&& bytes)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto& entry = m_entries[key.low];
+	entry.key   = key;
+	entry.bytes = std::move(bytes);
+
+	m_dirty = true;
+}
+
+VERA_NAMESPACE_END
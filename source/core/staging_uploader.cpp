@@ -0,0 +1,493 @@
+#include "../impl/staging_uploader.h"
+#include "../impl/device_impl.h"
+#include "../impl/device_memory_impl.h"
+#include "../impl/buffer_impl.h"
+#include "../impl/texture_impl.h"
+#include "../impl/command_buffer_impl.h"
+
+#include "../../include/vera/core/device.h"
+#include "../../include/vera/core/buffer.h"
+#include "../../include/vera/core/texture.h"
+#include "../../include/vera/core/command_buffer.h"
+#include "../../include/vera/graphics/format_traits.h"
+#include <algorithm>
+#include <numeric>
+#include <cstring>
+#include <tuple>
+
+VERA_NAMESPACE_BEGIN
+
+static size_t align_up(size_t value, size_t alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+StagingUploader::StagingUploader(ref<Device> device, size_t ring_size) VERA_NOEXCEPT :
+	m_device(device),
+	m_ring(),
+	m_ring_ptr(nullptr),
+	m_ring_size(ring_size),
+	m_ring_head(0),
+	m_ring_tail(0),
+	m_ring_used(0),
+	m_pending(),
+	m_has_pending(false)
+{
+	VERA_ASSERT_MSG(ring_size != 0, "cannot create staging ring with zero size");
+}
+
+StagingUploader::~StagingUploader() VERA_NOEXCEPT
+{
+	waitIdle();
+
+	release(m_pending);
+}
+
+void StagingUploader::uploadTexture(ref<Texture> texture, const void* data, size_t size)
+{
+	const size_t base_level = 0;
+
+	uploadTexture(texture, data, size, array_view<size_t>(&base_level, 1));
+}
+
+void StagingUploader::uploadTexture(ref<Texture> texture, const void* data, size_t size, array_view<size_t> level_offsets)
+{
+	auto&  texture_impl = CoreObject::getImpl(texture);
+	size_t alignment    = std::lcm<size_t>(get_format_size(texture_impl.textureFormat), 4);
+
+	VERA_ASSERT_MSG(level_offsets.size() <= texture_impl.mipLevels, "texture has fewer mip levels than uploaded");
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto range = allocate(size, alignment);
+	memcpy(range.mapPtr, data, size);
+
+	// the whole image is overwritten, so a texture uploaded twice in a batch only needs the latest copy
+	auto iter = std::find_if(VERA_SPAN(m_pending.textureCopies),
+		[=](const auto& copy) {
+			return copy.texture == texture;
+		});
+
+	if (iter == m_pending.textureCopies.end()) {
+		m_pending.textureCopies.push_back(TextureCopy{
+			.texture      = texture,
+			.srcBuffer    = range.buffer,
+			.srcOffset    = range.offset,
+			.levelOffsets = std::vector<size_t>(VERA_SPAN(level_offsets))
+		});
+		m_pending.resources.push_back(unsafe_obj_cast<Texture>(texture));
+	} else {
+		iter->srcBuffer = range.buffer;
+		iter->srcOffset = range.offset;
+		iter->levelOffsets.assign(VERA_SPAN(level_offsets));
+	}
+
+	m_has_pending = true;
+}
+
+void StagingUploader::uploadBuffer(ref<Buffer> buffer, size_t offset, const void* data, size_t size)
+{
+	auto& buffer_impl = CoreObject::getImpl(buffer);
+
+	if (buffer_impl.size < offset + size)
+		throw Exception("attempt to upload more data than buffer size");
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto range = allocate(size, 16);
+	memcpy(range.mapPtr, data, size);
+
+	auto& copy = m_pending.bufferCopies.emplace_back();
+	copy.buffer           = buffer;
+	copy.srcBuffer        = range.buffer;
+	copy.region.srcOffset = range.offset;
+	copy.region.dstOffset = offset;
+	copy.region.size      = size;
+
+	m_pending.resources.push_back(unsafe_obj_cast<Buffer>(buffer));
+
+	m_has_pending = true;
+}
+
+void StagingUploader::uploadMemory(ref<DeviceMemory> memory, size_t offset, const void* data, size_t size)
+{
+	auto& memory_impl = CoreObject::getImpl(memory);
+	auto  vk_device   = get_vk_device(m_device);
+
+	if (memory_impl.allocated < offset + size)
+		throw Exception("attempt to upload more data than allocated memory size");
+
+	// raw device memory has no buffer to copy into, so a transfer-only buffer aliases the whole allocation
+	vk::BufferCreateInfo buffer_info;
+	buffer_info.size        = memory_impl.allocated;
+	buffer_info.usage       = vk::BufferUsageFlagBits::eTransferDst;
+	buffer_info.sharingMode = vk::SharingMode::eExclusive;
+
+	auto alias_buffer = vk_device.createBuffer(buffer_info);
+	auto requirements = vk_device.getBufferMemoryRequirements(alias_buffer);
+
+	if (!(requirements.memoryTypeBits & (1u << memory_impl.typeIndex))) {
+		vk_device.destroy(alias_buffer);
+		throw Exception("device memory can not be used as transfer destination");
+	}
+
+	vk_device.bindBufferMemory(alias_buffer, memory_impl.vkMemory, 0);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// allocating may submit the pending batch, the alias has to join the batch holding its copy
+	auto range = allocate(size, 16);
+	memcpy(range.mapPtr, data, size);
+
+	m_pending.aliasBuffers.push_back(alias_buffer);
+
+	auto& copy = m_pending.bufferCopies.emplace_back();
+	copy.dstBuffer        = alias_buffer;
+	copy.srcBuffer        = range.buffer;
+	copy.region.srcOffset = range.offset;
+	copy.region.dstOffset = offset;
+	copy.region.size      = size;
+
+	m_pending.resources.push_back(unsafe_obj_cast<DeviceMemory>(memory));
+
+	m_has_pending = true;
+}
+
+bool StagingUploader::hasPendingUploads() const VERA_NOEXCEPT
+{
+	return m_has_pending.load(std::memory_order_acquire);
+}
+
+CommandSync StagingUploader::flush()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return submit();
+}
+
+void StagingUploader::waitIdle()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	submit();
+
+	while (!m_in_flight.empty())
+		reclaim(true);
+}
+
+StagingUploader::StagingRange StagingUploader::allocate(size_t size, size_t alignment)
+{
+	StagingRange result;
+	size_t       consumed;
+
+	// never stalls the ring, such uploads are rare enough to afford their own buffer
+	if (m_ring_size < size) {
+		auto  buffer      = Buffer::createStaging(unsafe_obj_cast<Device>(m_device), size);
+		auto& buffer_impl = CoreObject::getImpl(buffer);
+
+		result.buffer = buffer_impl.vkBuffer;
+		result.offset = 0;
+		result.mapPtr = buffer->map();
+
+		m_pending.overflowBuffers.push_back(std::move(buffer));
+
+		return result;
+	}
+
+	if (!m_ring) {
+		BufferCreateInfo ring_info;
+		ring_info.size         = m_ring_size;
+		ring_info.usage        = BufferUsageFlagBits::TransferSrc;
+		ring_info.propetyFlags =
+			MemoryPropertyFlagBits::HostVisible |
+			MemoryPropertyFlagBits::HostCoherent;
+
+		m_ring     = Buffer::create(unsafe_obj_cast<Device>(m_device), ring_info);
+		m_ring_ptr = reinterpret_cast<uint8_t*>(m_ring->map());
+	}
+
+	reclaim(false);
+
+	while (!allocateRing(size, alignment, result.offset, consumed)) {
+		if (m_in_flight.empty())
+			submit();
+		else
+			reclaim(true);
+	}
+
+	result.buffer         = CoreObject::getImpl(m_ring).vkBuffer;
+	result.mapPtr         = m_ring_ptr + result.offset;
+	m_pending.ringBytes  += consumed;
+
+	return result;
+}
+
+bool StagingUploader::allocateRing(size_t size, size_t alignment, size_t& out_offset, size_t& out_consumed) VERA_NOEXCEPT
+{
+	if (m_ring_used == 0)
+		m_ring_head = m_ring_tail = 0;
+
+	// free space is [head, tail) once the head wrapped around, otherwise [head, end) and [0, tail)
+	bool   wrapped = m_ring_head < m_ring_tail || (m_ring_head == m_ring_tail && m_ring_used != 0);
+	size_t end     = wrapped ? m_ring_tail : m_ring_size;
+	size_t aligned = align_up(m_ring_head, alignment);
+
+	if (aligned <= end && size <= end - aligned) {
+		out_offset   = aligned;
+		out_consumed = aligned + size - m_ring_head;
+		m_ring_head  = aligned + size;
+	} else if (!wrapped && size <= m_ring_tail) {
+		out_offset   = 0;
+		out_consumed = m_ring_size - m_ring_head + size;
+		m_ring_head  = size;
+	} else {
+		return false;
+	}
+
+	m_ring_used += out_consumed;
+
+	return true;
+}
+
+CommandSync StagingUploader::submit()
+{
+	if (m_pending.textureCopies.empty() && m_pending.bufferCopies.empty())
+		return {};
+
+	auto& batch = m_in_flight.emplace_back(std::move(m_pending));
+
+	m_pending       = Batch{};
+	m_has_pending   = false;
+	batch.ringHead  = m_ring_head;
+
+	if (m_free_command_buffers.empty()) {
+		batch.commandBuffer = CommandBuffer::create(unsafe_obj_cast<Device>(m_device));
+	} else {
+		batch.commandBuffer = std::move(m_free_command_buffers.back());
+		m_free_command_buffers.pop_back();
+	}
+
+	record(batch);
+
+	auto& cmd_impl = CoreObject::getImpl(batch.commandBuffer);
+
+	vk::SubmitInfo submit_info;
+	submit_info.commandBufferCount = 1;
+	submit_info.pCommandBuffers    = &cmd_impl.vkCommandBuffer;
+
+	cmd_impl.submitToDedicatedQueue(submit_info);
+
+	return batch.sync = batch.commandBuffer->getSync();
+}
+
+void StagingUploader::record(Batch& batch)
+{
+	auto& cmd_buffer = batch.commandBuffer;
+	auto& cmd_impl   = CoreObject::getImpl(cmd_buffer);
+	auto& vk_cmd     = cmd_impl.vkCommandBuffer;
+
+	cmd_buffer->reset();
+	cmd_buffer->begin();
+
+	// uploads are consumed by rendering, submission order on the graphics queue keeps barriers valid
+	cmd_impl.submitQueueType = SubmitQueueType::Graphics;
+
+	// a buffer resized since the upload has a new handle, copies past its new size are dropped
+	// since a resize does not keep the contents anyway
+	std::erase_if(batch.bufferCopies, [](BufferCopy& copy) {
+		if (!copy.buffer) return false;
+
+		auto& buffer_impl = CoreObject::getImpl(copy.buffer);
+
+		copy.dstBuffer = buffer_impl.vkBuffer;
+		return buffer_impl.size < copy.region.dstOffset + copy.region.size;
+	});
+
+	if (!batch.bufferCopies.empty()) {
+		// destinations may still be read by work submitted earlier
+		vk::MemoryBarrier barrier;
+
+		vk_cmd.pipelineBarrier(
+			vk::PipelineStageFlagBits::eAllCommands,
+			vk::PipelineStageFlagBits::eTransfer,
+			vk::DependencyFlagBits{},
+			1,
+			&barrier,
+			0,
+			nullptr,
+			0,
+			nullptr);
+
+		std::stable_sort(VERA_SPAN(batch.bufferCopies),
+			[](const auto& lhs, const auto& rhs) {
+				return std::tie(lhs.dstBuffer, lhs.srcBuffer) < std::tie(rhs.dstBuffer, rhs.srcBuffer);
+			});
+
+		std::vector<vk::BufferCopy> regions;
+
+		for (size_t i = 0; i < batch.bufferCopies.size();) {
+			const auto& first = batch.bufferCopies[i];
+
+			regions.clear();
+			for (; i < batch.bufferCopies.size(); ++i) {
+				const auto& copy = batch.bufferCopies[i];
+
+				if (copy.dstBuffer != first.dstBuffer || copy.srcBuffer != first.srcBuffer)
+					break;
+
+				regions.push_back(copy.region);
+			}
+
+			vk_cmd.copyBuffer(
+				first.srcBuffer,
+				first.dstBuffer,
+				static_cast<uint32_t>(regions.size()),
+				regions.data());
+		}
+
+		barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+		barrier.dstAccessMask =
+			vk::AccessFlagBits::eIndirectCommandRead |
+			vk::AccessFlagBits::eIndexRead |
+			vk::AccessFlagBits::eVertexAttributeRead |
+			vk::AccessFlagBits::eUniformRead |
+			vk::AccessFlagBits::eShaderRead |
+			vk::AccessFlagBits::eTransferRead;
+
+		vk_cmd.pipelineBarrier(
+			vk::PipelineStageFlagBits::eTransfer,
+			vk::PipelineStageFlagBits::eAllCommands,
+			vk::DependencyFlagBits{},
+			1,
+			&barrier,
+			0,
+			nullptr,
+			0,
+			nullptr);
+	}
+
+	if (!batch.textureCopies.empty()) {
+		std::vector<vk::ImageMemoryBarrier> barriers;
+
+		barriers.reserve(batch.textureCopies.size());
+
+		for (const auto& copy : batch.textureCopies) {
+			auto& texture_impl = CoreObject::getImpl(copy.texture);
+			auto& barrier      = barriers.emplace_back();
+
+			barrier.srcAccessMask                   = vk::AccessFlags{};
+			barrier.dstAccessMask                   = vk::AccessFlagBits::eTransferWrite;
+			barrier.oldLayout                       = vk::ImageLayout::eUndefined;
+			barrier.newLayout                       = vk::ImageLayout::eTransferDstOptimal;
+			barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+			barrier.image                           = texture_impl.vkImage;
+			barrier.subresourceRange.aspectMask     = to_vk_image_aspect_flags(texture_impl.textureAspect);
+			barrier.subresourceRange.baseMipLevel   = 0;
+			barrier.subresourceRange.levelCount     = texture_impl.mipLevels;
+			barrier.subresourceRange.baseArrayLayer = 0;
+			barrier.subresourceRange.layerCount     = 1;
+		}
+
+		vk_cmd.pipelineBarrier(
+			vk::PipelineStageFlagBits::eAllCommands,
+			vk::PipelineStageFlagBits::eTransfer,
+			vk::DependencyFlagBits{},
+			0,
+			nullptr,
+			0,
+			nullptr,
+			static_cast<uint32_t>(barriers.size()),
+			barriers.data());
+
+		std::vector<vk::BufferImageCopy> regions;
+
+		for (const auto& copy : batch.textureCopies) {
+			auto& texture_impl = CoreObject::getImpl(copy.texture);
+			auto  level_count  = static_cast<uint32_t>(copy.levelOffsets.size());
+
+			regions.clear();
+
+			// every level of the chain comes from the same staging range, so one copy covers them all
+			for (uint32_t level = 0; level < level_count; ++level) {
+				auto& copy_info = regions.emplace_back();
+				copy_info.bufferOffset                    = copy.srcOffset + copy.levelOffsets[level];
+				copy_info.bufferRowLength                 = 0;
+				copy_info.bufferImageHeight               = 0;
+				copy_info.imageSubresource.aspectMask     = to_vk_image_aspect_flags(texture_impl.textureAspect);
+				copy_info.imageSubresource.mipLevel       = level;
+				copy_info.imageSubresource.baseArrayLayer = 0;
+				copy_info.imageSubresource.layerCount     = 1;
+				copy_info.imageOffset                     = vk::Offset3D{ 0, 0, 0 };
+				copy_info.imageExtent.width               = std::max(1u, texture_impl.width >> level);
+				copy_info.imageExtent.height              = std::max(1u, texture_impl.height >> level);
+				copy_info.imageExtent.depth               = std::max(1u, texture_impl.depth >> level);
+			}
+
+			vk_cmd.copyBufferToImage(
+				copy.srcBuffer,
+				texture_impl.vkImage,
+				vk::ImageLayout::eTransferDstOptimal,
+				static_cast<uint32_t>(regions.size()),
+				regions.data());
+		}
+
+		for (auto& barrier : barriers) {
+			barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+			barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+			barrier.oldLayout     = vk::ImageLayout::eTransferDstOptimal;
+			barrier.newLayout     = vk::ImageLayout::eShaderReadOnlyOptimal;
+		}
+
+		vk_cmd.pipelineBarrier(
+			vk::PipelineStageFlagBits::eTransfer,
+			vk::PipelineStageFlagBits::eAllCommands,
+			vk::DependencyFlagBits{},
+			0,
+			nullptr,
+			0,
+			nullptr,
+			static_cast<uint32_t>(barriers.size()),
+			barriers.data());
+
+		for (const auto& copy : batch.textureCopies)
+			CoreObject::getImpl(copy.texture).textureLayout = TextureLayout::ShaderReadOnlyOptimal;
+	}
+
+	cmd_buffer->end();
+}
+
+void StagingUploader::reclaim(bool wait_oldest)
+{
+	if (wait_oldest && !m_in_flight.empty())
+		m_in_flight.front().sync.wait();
+
+	// batches complete in submission order, so ring space is handed back from the tail
+	while (!m_in_flight.empty() && m_in_flight.front().sync.isComplete()) {
+		auto& batch = m_in_flight.front();
+
+		m_ring_tail  = batch.ringHead;
+		m_ring_used -= batch.ringBytes;
+
+		m_free_command_buffers.push_back(std::move(batch.commandBuffer));
+
+		release(batch);
+		m_in_flight.pop_front();
+	}
+}
+
+void StagingUploader::release(Batch& batch) VERA_NOEXCEPT
+{
+	auto vk_device = get_vk_device(m_device);
+
+	for (auto alias_buffer : batch.aliasBuffers)
+		vk_device.destroy(alias_buffer);
+
+	batch.aliasBuffers.clear();
+	batch.overflowBuffers.clear();
+	batch.resources.clear();
+	batch.textureCopies.clear();
+	batch.bufferCopies.clear();
+}
+
+VERA_NAMESPACE_END
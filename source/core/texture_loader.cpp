@@ -0,0 +1,377 @@
+#include "../../include/vera/core/texture_loader.h"
+
+#include "../../include/vera/core/device.h"
+#include "../../include/vera/core/exception.h"
+#include "../../include/vera/graphics/format_traits.h"
+#include "../../include/vera/graphics/image_edit.h"
+#include "../../include/vera/graphics/image_stream.h"
+#include <algorithm>
+
+VERA_NAMESPACE_BEGIN
+
+static Format get_rgba_format(Format format)
+{
+	switch (format) {
+	case Format::RGB8Unorm:  return Format::RGBA8Unorm;
+	case Format::RGB8Srgb:   return Format::RGBA8Srgb;
+	case Format::BGR8Unorm:  return Format::BGRA8Unorm;
+	case Format::BGR8Srgb:   return Format::BGRA8Srgb;
+	case Format::RGB16Unorm: return Format::RGBA16Unorm;
+	case Format::RGB32Float: return Format::RGBA32Float;
+	default:                 return format;
+	}
+}
+
+template <class T>
+static void expand_rgb_rows(ImageView dst, ConstImageView src, T alpha)
+{
+	for (uint32_t y = 0; y < src.height(); ++y) {
+		const T* src_row = reinterpret_cast<const T*>(src.row(y));
+		T*       dst_row = reinterpret_cast<T*>(dst.row(y));
+
+		for (uint32_t x = 0; x < src.width(); ++x) {
+			dst_row[4 * x + 0] = src_row[3 * x + 0];
+			dst_row[4 * x + 1] = src_row[3 * x + 1];
+			dst_row[4 * x + 2] = src_row[3 * x + 2];
+			dst_row[4 * x + 3] = alpha;
+		}
+	}
+}
+
+// copies src into dst, appending an opaque alpha when dst has one more channel
+static void copy_pixels(ImageView dst, ConstImageView src)
+{
+	if (dst.format() == src.format()) {
+		ImageEdit::copy(dst, src);
+		return;
+	}
+
+	switch (src.pixelSize()) {
+	case 3:  expand_rgb_rows<uint8_t>(dst, src, UINT8_MAX); break;
+	case 6:  expand_rgb_rows<uint16_t>(dst, src, UINT16_MAX); break;
+	case 12: expand_rgb_rows<float>(dst, src, 1.f); break;
+	default: VERA_ERROR_MSG("unexpected pixel size for alpha expansion");
+	}
+}
+
+obj<TextureLoader> TextureLoader::create(obj<Device> device, const TextureLoaderCreateInfo& info)
+{
+	auto new_obj = obj<TextureLoader>(new TextureLoader());
+
+	new_obj->m_device         = std::move(device);
+	new_obj->m_info           = info;
+	new_obj->m_pending_bytes  = 0;
+	new_obj->m_free_bytes     = 0;
+	new_obj->m_decoding_count = 0;
+	new_obj->m_statistics     = {};
+	new_obj->m_stopping       = false;
+
+	uint32_t thread_count = info.threadCount;
+
+	if (thread_count == 0)
+		thread_count = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+	auto* loader = new_obj.get();
+
+	for (uint32_t i = 0; i < thread_count; ++i)
+		new_obj->m_workers.emplace_back([loader]() { loader->runWorker(); });
+
+	return new_obj;
+}
+
+TextureLoader::~TextureLoader() VERA_NOEXCEPT
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+
+	m_decode_cv.notify_all();
+
+	for (auto& worker : m_workers)
+		worker.join();
+
+	// futures of loads never uploaded report a broken promise
+}
+
+TextureFuture TextureLoader::load(std::string_view path)
+{
+	return enqueue(DecodeRequest{
+		.path   = std::string(path),
+		.width  = 0,
+		.height = 0,
+		.format = Format::Unknown
+	});
+}
+
+TextureFuture TextureLoader::loadRaw(std::string_view path, uint32_t width, uint32_t height, Format format)
+{
+	return enqueue(DecodeRequest{
+		.path   = std::string(path),
+		.width  = width,
+		.height = height,
+		.format = format
+	});
+}
+
+CommandSync TextureLoader::update()
+{
+	std::vector<DecodedImage> decoded;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		decoded.swap(m_decoded);
+	}
+
+	if (decoded.empty()) return {};
+
+	std::vector<obj<Texture>> textures(decoded.size());
+	uint32_t                  failed_count = 0;
+
+	// the staging uploader copies each image into its ring, so images go back to the pool at once
+	for (size_t i = 0; i < decoded.size(); ++i) {
+		auto& entry = decoded[i];
+
+		if (!entry.error) {
+			try {
+				textures[i] = Texture::create(m_device, entry.image);
+			} catch (...) {
+				entry.error = std::current_exception();
+			}
+		}
+
+		releaseImage(std::move(entry.image));
+
+		if (entry.error)
+			failed_count++;
+	}
+
+	m_decode_cv.notify_all();
+
+	CommandSync sync = m_device->flushUploads();
+
+	for (size_t i = 0; i < decoded.size(); ++i) {
+		if (decoded[i].error)
+			decoded[i].promise.set_exception(decoded[i].error);
+		else
+			decoded[i].promise.set_value(std::move(textures[i]));
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_statistics.loadedCount += decoded.size() - failed_count;
+	m_statistics.failedCount += failed_count;
+	m_statistics.batchCount  += failed_count < decoded.size();
+
+	return sync;
+}
+
+CommandSync TextureLoader::finish()
+{
+	CommandSync last_sync;
+
+	while (true) {
+		CommandSync sync = update();
+
+		if (!sync.empty())
+			last_sync = sync;
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		m_decoded_cv.wait(lock, [this]() {
+			return !m_decoded.empty() || (m_requests.empty() && m_decoding_count == 0);
+		});
+
+		if (m_decoded.empty())
+			return last_sync;
+	}
+}
+
+uint32_t TextureLoader::getPendingCount() const VERA_NOEXCEPT
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return static_cast<uint32_t>(m_requests.size() + m_decoding_count + m_decoded.size());
+}
+
+TextureLoaderStatistics TextureLoader::getStatistics() const VERA_NOEXCEPT
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_statistics;
+}
+
+TextureFuture TextureLoader::enqueue(DecodeRequest&& request)
+{
+	TextureFuture future = request.promise.get_future().share();
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_requests.push_back(std::move(request));
+	}
+
+	m_decode_cv.notify_one();
+
+	return future;
+}
+
+void TextureLoader::decode(DecodeRequest& request, DecodedImage& out_decoded)
+{
+	uint32_t width      = request.width;
+	uint32_t height     = request.height;
+	Format   src_format = request.format;
+	bool     decodes    = false;
+
+	if (request.format == Format::Unknown)
+		decodes = ImageReader::readHeader(request.path, width, height, src_format);
+
+	const Format format      = m_info.expandRGB ? get_rgba_format(src_format) : src_format;
+	const size_t image_size  = static_cast<size_t>(width) * height * get_format_size(format);
+	const size_t decode_size = decodes ? static_cast<size_t>(width) * height * get_format_size(src_format) : 0;
+
+	// the pixels stb_image decodes into live next to the pooled copy until the copy is made
+	reserveBytes(image_size + decode_size);
+
+	ImageReader reader;
+
+	try {
+		if (request.format == Format::Unknown)
+			reader.open(request.path);
+		else
+			reader.openRaw(request.path, width, height, src_format);
+
+		const ConstImageView src = reader.view();
+
+		if (src.width() != width || src.height() != height || src.format() != src_format)
+			throw Exception("image at {} does not match its header", request.path);
+
+		out_decoded.image = acquireImage(width, height, format);
+
+		copy_pixels(out_decoded.image.view(), src);
+	} catch (...) {
+		// an acquired image gives its bytes back once it is released
+		releaseBytes(decode_size + (out_decoded.image.empty() ? image_size : 0));
+		throw;
+	}
+
+	reader.close();
+	releaseBytes(decode_size);
+}
+
+void TextureLoader::runWorker() VERA_NOEXCEPT
+{
+	while (true) {
+		DecodedImage  decoded;
+		DecodeRequest request;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			m_decode_cv.wait(lock, [this]() {
+				return m_stopping || !m_requests.empty();
+			});
+
+			if (m_stopping) return;
+
+			request = std::move(m_requests.front());
+			m_requests.pop_front();
+			m_decoding_count++;
+		}
+
+		try {
+			decode(request, decoded);
+		} catch (...) {
+			decoded.error = std::current_exception();
+		}
+
+		decoded.promise = std::move(request.promise);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			m_decoded.push_back(std::move(decoded));
+			m_decoding_count--;
+		}
+
+		m_decoded_cv.notify_all();
+	}
+}
+
+// waits until size more bytes fit in the budget and counts them, an image larger than the whole
+// budget is decoded once nothing else is pending
+void TextureLoader::reserveBytes(size_t size)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	m_decode_cv.wait(lock, [=, this]() {
+		return m_stopping || m_pending_bytes == 0 || m_pending_bytes + size <= m_info.memoryBudget;
+	});
+
+	if (m_stopping)
+		throw Exception("texture loader was destroyed before decoding");
+
+	m_pending_bytes       += size;
+	m_statistics.peakBytes = std::max(m_statistics.peakBytes, m_pending_bytes);
+}
+
+void TextureLoader::releaseBytes(size_t size) VERA_NOEXCEPT
+{
+	if (size == 0) return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pending_bytes -= size;
+	}
+
+	m_decode_cv.notify_all();
+}
+
+// takes the smallest pooled image large enough, its bytes were reserved before decoding and the
+// budget counts them until the image is released
+Image TextureLoader::acquireImage(uint32_t width, uint32_t height, Format format)
+{
+	const size_t size = static_cast<size_t>(width) * height * get_format_size(format);
+
+	Image image;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto best_iter = m_free_images.end();
+
+		for (auto iter = m_free_images.begin(); iter != m_free_images.end(); ++iter)
+			if (size <= iter->capacity() && (best_iter == m_free_images.end() || iter->capacity() < best_iter->capacity()))
+				best_iter = iter;
+
+		if (best_iter != m_free_images.end()) {
+			m_free_bytes -= best_iter->capacity();
+			image = std::move(*best_iter);
+			*best_iter = std::move(m_free_images.back());
+			m_free_images.pop_back();
+		}
+
+		m_statistics.decodedBytes += size;
+	}
+
+	image.resize(width, height, format);
+
+	return image;
+}
+
+// pooled images are dropped once keeping them would push the pool and pending images past the budget
+void TextureLoader::releaseImage(Image&& image) VERA_NOEXCEPT
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_pending_bytes -= image.size();
+
+	if (image.capacity() == 0 || m_free_bytes + m_pending_bytes + image.capacity() > m_info.memoryBudget) {
+		image.clear();
+		return;
+	}
+
+	m_free_bytes += image.capacity();
+	m_free_images.push_back(std::move(image));
+}
+
+VERA_NAMESPACE_END
@@ -33,25 +33,41 @@ static uint32_t find_buffer_bind_idx(DeviceMemoryImpl& impl, Buffer* this_ptr)
 	return static_cast<uint32_t>(iter - impl.resourceBind.cbegin());
 }
 
-static void allocate_device_memory(
-	DeviceMemoryImpl&   impl,
-	obj<Device>         device,
-	vk::Buffer          buffer,
-	MemoryPropertyFlags flags
-) {
-	auto& device_impl = CoreObject::getImpl(device);
-	auto  req         = device_impl.vkDevice.getBufferMemoryRequirements(buffer);
-
-	vk::MemoryAllocateInfo info;
-	info.allocationSize  = req.size;
-	info.memoryTypeIndex = device_impl.findMemoryTypeIndex(flags, req.memoryTypeBits);
-
-	impl.device        = std::move(device);
-	impl.vkMemory      = device_impl.vkDevice.allocateMemory(info);
-	impl.propertyFlags = flags;
-	impl.allocated     = info.allocationSize;
-	impl.typeIndex     = info.memoryTypeIndex;
-	impl.mapPtr        = nullptr;
+static void bind_device_memory(BufferImpl& impl, Buffer* this_ptr, MemoryAllocation&& allocation)
+{
+	auto& memory_impl = CoreObject::getImpl(allocation.memory);
+	auto& device_impl = CoreObject::getImpl(impl.device);
+
+	impl.memory       = std::move(allocation.memory);
+	impl.memoryOffset = allocation.offset;
+	impl.allocationID = allocation.allocationID;
+
+	// shared blocks are never resized, so only dedicated memory tracks its bindings
+	if (!memory_impl.allocator) {
+		auto& binding = memory_impl.resourceBind.emplace_back();
+		binding.resourceType = MemoryResourceType::Buffer;
+		binding.size         = impl.size;
+		binding.offset       = impl.memoryOffset;
+		binding.resourcePtr  = this_ptr;
+	}
+
+	device_impl.vkDevice.bindBufferMemory(impl.vkBuffer, memory_impl.vkMemory, impl.memoryOffset);
+}
+
+static void unbind_device_memory(BufferImpl& impl, Buffer* this_ptr)
+{
+	auto& memory_impl = CoreObject::getImpl(impl.memory);
+
+	if (memory_impl.allocator) {
+		free_device_memory(memory_impl, impl.allocationID);
+	} else {
+		auto idx = find_buffer_bind_idx(memory_impl, this_ptr);
+
+		std::swap(memory_impl.resourceBind[idx], memory_impl.resourceBind.back());
+		memory_impl.resourceBind.pop_back();
+	}
+
+	impl.allocationID = TLSFAllocator::INVALID_ID;
 }
 
 const vk::Buffer& get_vk_buffer(cref<Buffer> buffer) VERA_NOEXCEPT
@@ -170,6 +186,23 @@ obj<Buffer> Buffer::createStorage(obj<Device> device, size_t size)
 	return create(device, info);
 }
 
+obj<Buffer> Buffer::createIndirect(obj<Device> device, size_t size)
+{
+	BufferCreateInfo info;
+	info.size         = size;
+	info.usage        =
+		BufferUsageFlagBits::IndirectBuffer |
+		BufferUsageFlagBits::StorageBuffer |
+		BufferUsageFlagBits::TransferDst |
+		BufferUsageFlagBits::TransferSrc;
+	info.propetyFlags = 
+		MemoryPropertyFlagBits::DeviceLocal |
+		MemoryPropertyFlagBits::HostVisible |
+		MemoryPropertyFlagBits::HostCoherent;
+
+	return create(device, info);
+}
+
 obj<Buffer> Buffer::createStaging(obj<Device> device, size_t size)
 {
 	BufferCreateInfo info;
@@ -187,11 +220,9 @@ obj<Buffer> Buffer::createStaging(obj<Device> device, size_t size)
 
 obj<Buffer> Buffer::create(obj<Device> device, const BufferCreateInfo& info)
 {
-	auto  obj           = createNewCoreObject<Buffer>();
-	auto  memory_obj    = createNewCoreObject<DeviceMemory>();
-	auto& impl          = getImpl(obj);
-	auto& memory_impl   = getImpl(memory_obj);
-	auto& device_impl   = getImpl(device);
+	auto  obj         = createNewCoreObject<Buffer>();
+	auto& impl        = getImpl(obj);
+	auto& device_impl = getImpl(device);
 
 	if (info.size == 0)
 		throw Exception("cannot create a buffer which size is zero");
@@ -201,21 +232,16 @@ obj<Buffer> Buffer::create(obj<Device> device, const BufferCreateInfo& info)
 	buffer_info.usage       = to_vk_buffer_usage_flags(info.usage);
 	buffer_info.sharingMode = vk::SharingMode::eExclusive;
 
-	impl.device   = device;
-	impl.memory   = std::move(memory_obj);
-	impl.vkBuffer = device_impl.vkDevice.createBuffer(buffer_info);
-	impl.size     = info.size;
-	impl.usage    = info.usage;
-
-	allocate_device_memory(memory_impl, std::move(device), impl.vkBuffer, info.propetyFlags);
+	impl.device        = device;
+	impl.vkBuffer      = device_impl.vkDevice.createBuffer(buffer_info);
+	impl.size          = info.size;
+	impl.usage         = info.usage;
+	impl.propertyFlags = info.propetyFlags;
 
-	auto& binding = memory_impl.resourceBind.emplace_back();
-	binding.resourceType = MemoryResourceType::Buffer;
-	binding.size         = info.size;
-	binding.offset       = 0;
-	binding.resourcePtr  = obj.get();
+	auto req = device_impl.vkDevice.getBufferMemoryRequirements(impl.vkBuffer);
 
-	device_impl.vkDevice.bindBufferMemory(impl.vkBuffer, memory_impl.vkMemory, 0);
+	bind_device_memory(impl, obj.get(),
+		allocate_device_memory(std::move(device), req, info.propetyFlags, MemoryResourceType::Buffer));
 
 	return obj;
 }
@@ -232,33 +258,27 @@ obj<Buffer> Buffer::create(obj<DeviceMemory> memory, size_t offset, const Buffer
 	buffer_info.usage       = to_vk_buffer_usage_flags(info.usage);
 	buffer_info.sharingMode = vk::SharingMode::eExclusive;
 
-	impl.device   = memory_impl.device;
-	impl.memory   = std::move(memory);
-	impl.vkBuffer = device_impl.vkDevice.createBuffer(buffer_info);
-	impl.size     = info.size;
-	impl.usage    = info.usage;
-
-	auto& binding = memory_impl.resourceBind.emplace_back();
-	binding.resourceType = MemoryResourceType::Buffer;
-	binding.size         = info.size;
-	binding.offset       = offset;
-	binding.resourcePtr  = obj.get();
+	impl.device        = memory_impl.device;
+	impl.vkBuffer      = device_impl.vkDevice.createBuffer(buffer_info);
+	impl.size          = info.size;
+	impl.usage         = info.usage;
+	impl.propertyFlags = memory_impl.propertyFlags;
 
-	device_impl.vkDevice.bindBufferMemory(impl.vkBuffer, memory_impl.vkMemory, offset);
+	bind_device_memory(impl, obj.get(), MemoryAllocation{
+		.memory       = std::move(memory),
+		.offset       = offset,
+		.allocationID = TLSFAllocator::INVALID_ID
+	});
 
 	return obj;
 }
 
 Buffer::~Buffer() VERA_NOEXCEPT
 {
-	auto& impl        = getImpl(this);
-	auto& memory_impl = getImpl(impl.memory);
-	auto  vk_device   = get_vk_device(impl.device);
+	auto& impl      = getImpl(this);
+	auto  vk_device = get_vk_device(impl.device);
 	
-	auto idx = find_buffer_bind_idx(memory_impl, this);
-
-	std::swap(memory_impl.resourceBind[idx], memory_impl.resourceBind.back());
-	memory_impl.resourceBind.pop_back();
+	unbind_device_memory(impl, this);
 	
 	vk_device.destroy(impl.vkBuffer);
 
@@ -273,8 +293,6 @@ void Buffer::resize(size_t new_size)
 
 	auto& memory_impl = getImpl(impl.memory);
 	auto  vk_device   = get_vk_device(impl.device);
-	auto  idx         = find_buffer_bind_idx(memory_impl, this);
-	auto& binding     = memory_impl.resourceBind[idx];
 
 	vk::BufferCreateInfo buffer_info;
 	buffer_info.size        = new_size;
@@ -287,12 +305,55 @@ void Buffer::resize(size_t new_size)
 
 	auto req = vk_device.getBufferMemoryRequirements(impl.vkBuffer);
 
-	if (memory_impl.allocated < binding.offset + new_size)
+	if (memory_impl.allocator) {
+		// suballocated buffers move to a new range, contents are not preserved as with dedicated memory
+		unbind_device_memory(impl, this);
+		bind_device_memory(impl, this,
+			allocate_device_memory(impl.device, req, impl.propertyFlags, MemoryResourceType::Buffer));
+		return;
+	}
+
+	auto  idx     = find_buffer_bind_idx(memory_impl, this);
+	auto& binding = memory_impl.resourceBind[idx];
+
+	if (memory_impl.allocated < binding.offset + req.size)
 		impl.memory->resize(binding.offset + req.size);
+	else
+		vk_device.bindBufferMemory(impl.vkBuffer, memory_impl.vkMemory, binding.offset);
 
 	binding.size = new_size;
 }
 
+void* Buffer::map()
+{
+	auto& impl = getImpl(this);
+
+	return reinterpret_cast<uint8_t*>(impl.memory->map()) + impl.memoryOffset;
+}
+
+void Buffer::flush()
+{
+	auto& impl = getImpl(this);
+
+	// only this buffer's range, the memory may be a block shared with other resources
+	flush_device_memory(getImpl(impl.memory), impl.memoryOffset, impl.size);
+}
+
+void Buffer::upload(const void* data, size_t size, size_t offset)
+{
+	auto& impl = getImpl(this);
+
+	if (impl.size < offset + size)
+		throw Exception("attempt to upload more data than buffer size");
+
+	if (impl.propertyFlags.has(MemoryPropertyFlagBits::HostVisible)) {
+		memcpy(reinterpret_cast<uint8_t*>(map()) + offset, data, size);
+		flush_device_memory(getImpl(impl.memory), impl.memoryOffset + offset, size);
+	} else {
+		getImpl(impl.device).stagingUploader->uploadBuffer(this, offset, data, size);
+	}
+}
+
 obj<DeviceMemory> Buffer::getDeviceMemory()
 {
 	return getImpl(this).memory;
@@ -303,6 +364,11 @@ BufferUsageFlags Buffer::getUsageFlags() const
 	return getImpl(this).usage;
 }
 
+size_t Buffer::offset() const
+{
+	return getImpl(this).memoryOffset;
+}
+
 size_t Buffer::size() const
 {
 	return getImpl(this).size;
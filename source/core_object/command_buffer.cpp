@@ -9,6 +9,7 @@
 #include "../impl/texture_impl.h"
 #include "../impl/device_memory_impl.h"
 #include "../impl/shader_parameter_impl.h"
+#include "../impl/render_context_impl.h"
 
 #include "../../include/vera/core/context.h"
 #include "../../include/vera/core/pipeline_layout.h"
@@ -18,11 +19,16 @@
 #include "../../include/vera/core/shader_parameter.h"
 #include "../../include/vera/core/buffer.h"
 #include "../../include/vera/core/texture_view.h"
+#include "../../include/vera/core/render_context.h"
 #include "../../include/vera/graphics/graphics_state.h"
 #include "../../include/vera/util/static_vector.h"
 
 VERA_NAMESPACE_BEGIN
 
+static_assert(sizeof(DrawIndirectCommand) == sizeof(vk::DrawIndirectCommand));
+static_assert(sizeof(DrawIndexedIndirectCommand) == sizeof(vk::DrawIndexedIndirectCommand));
+static_assert(sizeof(DrawMeshTaskIndirectCommand) == sizeof(vk::DrawMeshTasksIndirectCommandEXT));
+
 template <class ClearType>
 bool operator==(const AttachmentInfo<ClearType>& lhs, const AttachmentInfo<ClearType>& rhs)
 {
@@ -55,12 +61,67 @@ static bool operator==(const RenderingInfo& lhs, const RenderingInfo& rhs)
 	return true;
 }
 
+static const BufferImpl& check_indirect_buffer(
+	const CommandBufferImpl& impl,
+	cref<Buffer>             buffer,
+	size_t                   offset,
+	uint32_t                 draw_count
+) {
+	auto& buffer_impl = CoreObject::getImpl(buffer);
+	auto& device_impl = CoreObject::getImpl(impl.device);
+
+	if (!buffer_impl.usage.has(BufferUsageFlagBits::IndirectBuffer))
+		throw Exception("buffer is not for indirect draw");
+	if (offset % 4 != 0)
+		throw Exception("indirect draw offset must be a multiple of 4");
+	if (draw_count > 1 && !device_impl.isFeatureEnabled(DeviceFeatureType::MultiDrawIndirect))
+		throw Exception("multi draw indirect feature is not enabled");
+
+	return buffer_impl;
+}
+
+static const BufferImpl& check_indirect_count_buffer(
+	const CommandBufferImpl& impl,
+	cref<Buffer>             count_buffer,
+	size_t                   count_offset
+) {
+	auto& buffer_impl = CoreObject::getImpl(count_buffer);
+	auto& device_impl = CoreObject::getImpl(impl.device);
+
+	if (!device_impl.isFeatureEnabled(DeviceFeatureType::DrawIndirectCount))
+		throw Exception("draw indirect count feature is not enabled");
+	if (!buffer_impl.usage.has(BufferUsageFlagBits::IndirectBuffer))
+		throw Exception("count buffer is not for indirect draw");
+	if (count_offset % 4 != 0)
+		throw Exception("indirect draw count offset must be a multiple of 4");
+
+	return buffer_impl;
+}
+
+static void check_mesh_shader_feature(const CommandBufferImpl& impl)
+{
+	auto& device_impl = CoreObject::getImpl(impl.device);
+
+	if (!device_impl.isFeatureEnabled(DeviceFeatureType::MeshShader))
+		throw Exception("mesh shader feature is not enabled on device");
+}
+
 static bool check_command_buffer_in_use(const CommandBufferImpl& impl)
 {
 	const auto& tracker = *impl.tracker;
 	return tracker.state == CommandBufferState::Pending && !tracker.fence->signaled();
 }
 
+static void invalidate_bound_descriptor_set(CommandBufferImpl& impl, vk::PipelineLayout layout, uint32_t set)
+{
+	auto& state = impl.boundState;
+
+	if (state.bindPoint != vk::PipelineBindPoint::eGraphics || state.pipelineLayout != layout)
+		state.reset({}, {});
+	else if (set < state.descriptorSets.size())
+		state.descriptorSets[set] = nullptr;
+}
+
 static vk::ImageView get_vk_image_view(ref<Texture> texture)
 {
 	return get_vk_image_view(texture->getTextureView());
@@ -76,25 +137,9 @@ vk::CommandBuffer& get_vk_command_buffer(ref<CommandBuffer> cmd_buffer) VERA_NOE
 	return CoreObject::getImpl(cmd_buffer).vkCommandBuffer;
 }
 
-obj<CommandBuffer> CommandBuffer::create(obj<Device> device)
+static void init_command_buffer_state(CommandBufferImpl& impl)
 {
-	auto  obj       = createNewCoreObject<CommandBuffer>();
-	auto& impl      = getImpl(obj);
-	auto  vk_device = get_vk_device(device);
-
-	vk::CommandPoolCreateInfo pool_info;
-	pool_info.flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer;
-
-	vk::CommandBufferAllocateInfo alloc_info;
-	alloc_info.commandPool        = vk_device.createCommandPool(pool_info);
-	alloc_info.level              = vk::CommandBufferLevel::ePrimary;
-	alloc_info.commandBufferCount = 1;
-
-	impl.device                = device;
-	impl.vkCommandPool         = alloc_info.commandPool;
-	impl.vkCommandBuffer       = vk_device.allocateCommandBuffers(alloc_info).front();
 	impl.submitQueueType       = SubmitQueueType::Transfer;
-	impl.tracker               = std::make_shared<CommandBufferTracker>();
 	impl.currentViewport       = {};
 	impl.currentScissor        = {};
 	impl.currentVertexBuffer   = {};
@@ -102,6 +147,27 @@ obj<CommandBuffer> CommandBuffer::create(obj<Device> device)
 	impl.currentRenderingInfo  = {};
 	impl.currentDescriptorSets = {};
 	impl.currentPipeline       = {};
+	impl.boundState            = {};
+	impl.bindStatistics        = {};
+}
+
+obj<CommandBuffer> CommandBuffer::create(obj<Device> device)
+{
+	auto  obj         = createNewCoreObject<CommandBuffer>();
+	auto& impl        = getImpl(obj);
+	auto& device_impl = getImpl(device);
+	auto  queue_index = static_cast<uint32_t>(device_impl.graphicsQueueFamilyIndex);
+	auto  cmd         = device_impl.commandPoolManager->acquireStandalone(queue_index);
+
+	impl.device           = device;
+	impl.vkCommandPool    = cmd.pool;
+	impl.vkCommandBuffer  = cmd.buffer;
+	impl.level            = CommandBufferLevel::Primary;
+	impl.queueFamilyIndex = queue_index;
+	impl.frameKey         = 0;
+	impl.tracker          = std::make_shared<CommandBufferTracker>();
+
+	init_command_buffer_state(impl);
 
 	impl.tracker->semaphore = Semaphore::create(impl.device);
 	impl.tracker->fence     = Fence::create(impl.device);
@@ -111,18 +177,49 @@ obj<CommandBuffer> CommandBuffer::create(obj<Device> device)
 	return obj;
 }
 
+obj<CommandBuffer> CommandBuffer::createSecondary(obj<RenderContext> render_context)
+{
+	auto  obj         = createNewCoreObject<CommandBuffer>();
+	auto& impl        = getImpl(obj);
+	auto& ctx_impl    = getImpl(render_context);
+	auto& device_impl = getImpl(ctx_impl.device);
+	auto  queue_index = static_cast<uint32_t>(device_impl.graphicsQueueFamilyIndex);
+	auto  frame_key   = ctx_impl.renderFrames[ctx_impl.frameIndex].poolFrameKey;
+
+	impl.device           = ctx_impl.device;
+	impl.vkCommandPool    = nullptr;
+	impl.vkCommandBuffer  = device_impl.commandPoolManager->acquireFrameBuffer(
+		frame_key, queue_index, vk::CommandBufferLevel::eSecondary);
+	impl.level            = CommandBufferLevel::Secondary;
+	impl.queueFamilyIndex = queue_index;
+	impl.frameKey         = frame_key;
+	impl.tracker          = std::make_shared<CommandBufferTracker>();
+
+	init_command_buffer_state(impl);
+
+	// never submitted on its own, the primary executing it is the one tracked
+	impl.tracker->state    = CommandBufferState::Initial;
+	impl.tracker->submitID = 0;
+
+	return obj;
+}
+
 CommandBuffer::~CommandBuffer() VERA_NOEXCEPT
 {
-	auto& impl      = getImpl(this);
-	auto  vk_device = get_vk_device(impl.device);
+	auto& impl        = getImpl(this);
+	auto& device_impl = getImpl(impl.device);
 
-	// TODO: use CommandSync later
-	vk_device.waitIdle();
+	// frame command buffers go back to their pool when the frame completes
+	if (impl.frameKey == 0) {
+		if (check_command_buffer_in_use(impl))
+			impl.tracker->fence->wait();
 
-	impl.tracker->state = CommandBufferState::Invalid;
+		device_impl.commandPoolManager->releaseStandalone(
+			impl.queueFamilyIndex,
+			{ impl.vkCommandPool, impl.vkCommandBuffer });
+	}
 
-	vk_device.freeCommandBuffers(impl.vkCommandPool, impl.vkCommandBuffer);
-	vk_device.destroy(impl.vkCommandPool);
+	impl.tracker->state = CommandBufferState::Invalid;
 
 	destroyObjectImpl(this);
 }
@@ -132,17 +229,34 @@ obj<Device> CommandBuffer::getDevice() VERA_NOEXCEPT
 	return getImpl(this).device;
 }
 
+CommandBufferLevel CommandBuffer::getLevel() const VERA_NOEXCEPT
+{
+	return getImpl(this).level;
+}
+
 CommandSync CommandBuffer::getSync() const VERA_NOEXCEPT
 {
 	auto& impl = getImpl(this);
+
+	// frame command buffers complete with the primary command buffer of their frame
+	if (impl.frameKey != 0)
+		return {};
+
 	return CommandSync(impl.tracker, impl.tracker->submitID);
 }
 
+CommandBufferBindStatistics CommandBuffer::getBindStatistics() const VERA_NOEXCEPT
+{
+	return getImpl(this).bindStatistics;
+}
+
 void CommandBuffer::reset()
 {
 	auto& impl      = getImpl(this);
 	auto  vk_device = get_vk_device(impl.device);
 
+	if (impl.frameKey != 0)
+		throw Exception("frame command buffers are reset with their frame");
 	if (check_command_buffer_in_use(impl))
 		throw Exception("cannot reset a submitted command buffer that is not completed");
 
@@ -150,14 +264,7 @@ void CommandBuffer::reset()
 	impl.tracker->state     = CommandBufferState::Initial;
 	impl.tracker->submitID += 1;
 
-	impl.submitQueueType       = SubmitQueueType::Transfer;
-	impl.currentViewport       = {};
-	impl.currentScissor        = {};
-	impl.currentVertexBuffer   = {};
-	impl.currentIndexBuffer    = {};
-	impl.currentRenderingInfo  = {};
-	impl.currentDescriptorSets = {};
-	impl.currentPipeline       = {};
+	init_command_buffer_state(impl);
 
 	vk_device.resetCommandPool(impl.vkCommandPool);
 }
@@ -167,11 +274,76 @@ void CommandBuffer::begin()
 	auto& impl = getImpl(this);
 
 	impl.tracker->state = CommandBufferState::Recording;
+	impl.boundState.reset({}, {});
+
+	// secondary command buffers always need inheritance info, empty outside of rendering
+	vk::CommandBufferInheritanceInfo inheritance_info;
+
+	vk::CommandBufferBeginInfo begin_info;
+	begin_info.flags            = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+	begin_info.pInheritanceInfo = impl.level == CommandBufferLevel::Secondary ? &inheritance_info : nullptr;
+
+	impl.vkCommandBuffer.begin(begin_info);
+}
+
+void CommandBuffer::begin(const RenderingInfo& info)
+{
+	auto& impl = getImpl(this);
+
+	if (impl.level != CommandBufferLevel::Secondary)
+		throw Exception("only secondary command buffers continue rendering");
+
+	impl.tracker->state = CommandBufferState::Recording;
+	impl.boundState.reset({}, {});
+
+	static_vector<vk::Format, 16> color_formats;
+	for (const auto& color_info : info.colorAttachments)
+		color_formats.push_back(to_vk_format(getImpl(color_info.texture).textureFormat));
+
+	vk::CommandBufferInheritanceRenderingInfo rendering_info;
+	rendering_info.viewMask                = {};
+	rendering_info.colorAttachmentCount    = static_cast<uint32_t>(color_formats.size());
+	rendering_info.pColorAttachmentFormats = color_formats.data();
+	rendering_info.rasterizationSamples    = vk::SampleCountFlagBits::e1;
+
+	if (info.depthAttachment)
+		rendering_info.depthAttachmentFormat = to_vk_format(getImpl(info.depthAttachment->texture).textureFormat);
+	if (info.stencilAttachment)
+		rendering_info.stencilAttachmentFormat = to_vk_format(getImpl(info.stencilAttachment->texture).textureFormat);
+
+	vk::CommandBufferInheritanceInfo inheritance_info;
+	inheritance_info.pNext = &rendering_info;
 
 	vk::CommandBufferBeginInfo begin_info;
-	begin_info.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+	begin_info.flags =
+		vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+		vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+	begin_info.pInheritanceInfo = &inheritance_info;
 
 	impl.vkCommandBuffer.begin(begin_info);
+
+	// graphics states rendering into the same attachments do not begin rendering again
+	impl.submitQueueType      = SubmitQueueType::Graphics;
+	impl.currentRenderingInfo = info;
+}
+
+void CommandBuffer::copyBuffer(
+	ref<Buffer> dst,
+	ref<Buffer> src,
+	size_t      dst_offset,
+	size_t      src_offset,
+	size_t      size
+) {
+	auto& impl     = getImpl(this);
+	auto& dst_impl = getImpl(dst);
+	auto& src_impl = getImpl(src);
+
+	vk::BufferCopy copy_info;
+	copy_info.srcOffset = src_offset;
+	copy_info.dstOffset = dst_offset;
+	copy_info.size      = size;
+
+	impl.vkCommandBuffer.copyBuffer(src_impl.vkBuffer, dst_impl.vkBuffer, 1, &copy_info);
 }
 
 void CommandBuffer::copyBufferToTexture(
@@ -304,6 +476,18 @@ void CommandBuffer::bindIndexBuffer(cref<Buffer> buffer, size_t offset)
 
 void CommandBuffer::bindPipeline(cref<Pipeline> pipeline)
 {
+	// a pipeline still compiling is stood in for by its fallback, without one the bind waits,
+	// a failed compile rethrows its error rather than leaving the fallback bound for good
+	if (!pipeline->isReady()) {
+		auto& pipeline_impl = getImpl(pipeline);
+		auto& fallback      = pipeline_impl.fallback;
+
+		if (!pipeline_impl.ready.load(std::memory_order_acquire) && fallback && fallback->isReady())
+			pipeline = fallback;
+		else
+			pipeline->waitReady();
+	}
+
 	auto& impl          = getImpl(this);
 	auto& pipeline_impl = getImpl(pipeline);
 
@@ -321,6 +505,10 @@ void CommandBuffer::pushConstant(
 	uint32_t                  size)
 {
 	auto& impl = getImpl(this);
+
+	// bytes written behind the shader parameter's back, it must push again
+	impl.boundState.pushConstants.clear();
+
 	impl.vkCommandBuffer.pushConstants(
 		get_vk_pipeline_layout(pipeline_layout),
 		to_vk_shader_stage_flags(stage_flags),
@@ -336,6 +524,8 @@ void CommandBuffer::bindDescriptorSet(
 ) {
 	auto& impl = getImpl(this);
 
+	invalidate_bound_descriptor_set(impl, get_vk_pipeline_layout(pipeline_layout), set);
+
 	impl.vkCommandBuffer.bindDescriptorSets(
 		vk::PipelineBindPoint::eGraphics,
 		get_vk_pipeline_layout(pipeline_layout),
@@ -356,6 +546,8 @@ void CommandBuffer::bindDescriptorSet(
 	
 	auto& impl = getImpl(this);
 
+	invalidate_bound_descriptor_set(impl, get_vk_pipeline_layout(pipeline_layout), set);
+
 	impl.vkCommandBuffer.bindDescriptorSets(
 		vk::PipelineBindPoint::eGraphics,
 		get_vk_pipeline_layout(pipeline_layout),
@@ -403,6 +595,11 @@ void CommandBuffer::bindShaderParameter(ref<ShaderParameter> params)
 }
 
 void CommandBuffer::beginRendering(const RenderingInfo& info)
+{
+	beginRendering(info, RenderingContents::Inline);
+}
+
+void CommandBuffer::beginRendering(const RenderingInfo& info, RenderingContents contents)
 {
 	auto& impl = getImpl(this);
 
@@ -465,6 +662,8 @@ void CommandBuffer::beginRendering(const RenderingInfo& info)
 	}
 
 	vk::RenderingInfo render_info;
+	render_info.flags                = contents == RenderingContents::SecondaryCommandBuffers ?
+		vk::RenderingFlags(vk::RenderingFlagBits::eContentsSecondaryCommandBuffers) : vk::RenderingFlags{};
 	render_info.renderArea           = to_vk_rect2d(info.renderArea);
 	render_info.layerCount           = info.layerCount;
 	render_info.viewMask             = {};
@@ -504,9 +703,117 @@ void CommandBuffer::drawMeshTask(
 	uint32_t group_count_z
 ) {
 	auto& impl = getImpl(this);
+
+	check_mesh_shader_feature(impl);
+
 	impl.vkCommandBuffer.drawMeshTasksEXT(group_count_x, group_count_y, group_count_z);
 }
 
+void CommandBuffer::drawIndirect(
+	cref<Buffer> buffer,
+	size_t       offset,
+	uint32_t     draw_count,
+	uint32_t     stride
+) {
+	auto& impl        = getImpl(this);
+	auto& buffer_impl = check_indirect_buffer(impl, buffer, offset, draw_count);
+
+	impl.vkCommandBuffer.drawIndirect(buffer_impl.vkBuffer, offset, draw_count, stride);
+}
+
+void CommandBuffer::drawIndexedIndirect(
+	cref<Buffer> buffer,
+	size_t       offset,
+	uint32_t     draw_count,
+	uint32_t     stride
+) {
+	auto& impl        = getImpl(this);
+	auto& buffer_impl = check_indirect_buffer(impl, buffer, offset, draw_count);
+
+	impl.vkCommandBuffer.drawIndexedIndirect(buffer_impl.vkBuffer, offset, draw_count, stride);
+}
+
+void CommandBuffer::drawMeshTaskIndirect(
+	cref<Buffer> buffer,
+	size_t       offset,
+	uint32_t     draw_count,
+	uint32_t     stride
+) {
+	auto& impl = getImpl(this);
+
+	check_mesh_shader_feature(impl);
+
+	auto& buffer_impl = check_indirect_buffer(impl, buffer, offset, draw_count);
+
+	impl.vkCommandBuffer.drawMeshTasksIndirectEXT(buffer_impl.vkBuffer, offset, draw_count, stride);
+}
+
+void CommandBuffer::drawIndirectCount(
+	cref<Buffer> buffer,
+	size_t       offset,
+	cref<Buffer> count_buffer,
+	size_t       count_offset,
+	uint32_t     max_draw_count,
+	uint32_t     stride
+) {
+	auto& impl         = getImpl(this);
+	auto& buffer_impl  = check_indirect_buffer(impl, buffer, offset, 1); // no multi draw feature needed
+	auto& counter_impl = check_indirect_count_buffer(impl, count_buffer, count_offset);
+
+	impl.vkCommandBuffer.drawIndirectCount(
+		buffer_impl.vkBuffer,
+		offset,
+		counter_impl.vkBuffer,
+		count_offset,
+		max_draw_count,
+		stride);
+}
+
+void CommandBuffer::drawIndexedIndirectCount(
+	cref<Buffer> buffer,
+	size_t       offset,
+	cref<Buffer> count_buffer,
+	size_t       count_offset,
+	uint32_t     max_draw_count,
+	uint32_t     stride
+) {
+	auto& impl         = getImpl(this);
+	auto& buffer_impl  = check_indirect_buffer(impl, buffer, offset, 1); // no multi draw feature needed
+	auto& counter_impl = check_indirect_count_buffer(impl, count_buffer, count_offset);
+
+	impl.vkCommandBuffer.drawIndexedIndirectCount(
+		buffer_impl.vkBuffer,
+		offset,
+		counter_impl.vkBuffer,
+		count_offset,
+		max_draw_count,
+		stride);
+}
+
+void CommandBuffer::drawMeshTaskIndirectCount(
+	cref<Buffer> buffer,
+	size_t       offset,
+	cref<Buffer> count_buffer,
+	size_t       count_offset,
+	uint32_t     max_draw_count,
+	uint32_t     stride
+) {
+	auto& impl = getImpl(this);
+
+	check_mesh_shader_feature(impl);
+
+	auto& buffer_impl  = check_indirect_buffer(impl, buffer, offset, 1); // no multi draw feature needed
+	auto& counter_impl = check_indirect_count_buffer(impl, count_buffer, count_offset);
+
+	impl.vkCommandBuffer.drawMeshTasksIndirectCountEXT(
+		buffer_impl.vkBuffer,
+		offset,
+		counter_impl.vkBuffer,
+		count_offset,
+		max_draw_count,
+		stride);
+}
+
 void CommandBuffer::endRendering()
 {
 	auto& impl = getImpl(this);
@@ -517,6 +824,41 @@ void CommandBuffer::endRendering()
 	impl.currentRenderingInfo = {};
 }
 
+void CommandBuffer::executeCommands(array_view<obj<CommandBuffer>> cmd_buffers)
+{
+	auto& impl = getImpl(this);
+
+	if (impl.level != CommandBufferLevel::Primary)
+		throw Exception("secondary command buffers cannot execute other command buffers");
+
+	small_vector<vk::CommandBuffer, 16> vk_cmd_buffers;
+	vk_cmd_buffers.reserve(cmd_buffers.size());
+
+	for (const auto& cmd_buffer : cmd_buffers) {
+		auto& cmd_impl = getImpl(cmd_buffer);
+
+		if (cmd_impl.level != CommandBufferLevel::Secondary)
+			throw Exception("only secondary command buffers can be executed");
+
+		vk_cmd_buffers.push_back(cmd_impl.vkCommandBuffer);
+	}
+
+	if (vk_cmd_buffers.empty())
+		return;
+
+	impl.vkCommandBuffer.executeCommands(
+		static_cast<uint32_t>(vk_cmd_buffers.size()),
+		vk_cmd_buffers.data());
+
+	impl.submitQueueType     = SubmitQueueType::Graphics;
+	impl.currentViewport     = {};
+	impl.currentScissor      = {};
+	impl.currentVertexBuffer = {};
+	impl.currentIndexBuffer  = {};
+	impl.currentPipeline     = {};
+	impl.boundState.reset({}, {});
+}
+
 void CommandBuffer::end()
 {
 	auto& impl = getImpl(this);
@@ -530,6 +872,9 @@ CommandSync CommandBuffer::submit(const SubmitInfo& info)
 {
 	auto& impl = getImpl(this);
 
+	if (impl.level != CommandBufferLevel::Primary)
+		throw Exception("secondary command buffers are submitted by executing them in a primary one");
+
 	vk::SubmitInfo                          submit_info;
 	small_vector<vk::Semaphore, 8>          wait_semaphores;
 	small_vector<vk::PipelineStageFlags, 8> wait_stages;
@@ -565,7 +910,7 @@ CommandSync CommandBuffer::submit(const SubmitInfo& info)
 
 	impl.submitToDedicatedQueue(submit_info);
 
-	return CommandSync();
+	return CommandSync(impl.tracker, impl.tracker->submitID);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -574,6 +919,10 @@ void CommandBufferImpl::submitToDedicatedQueue(const vk::SubmitInfo& submit_info
 {
 	auto& device_impl = CoreObject::getImpl(device);
 
+	// staged copies have to reach the queue ahead of the work that consumes them
+	if (device_impl.stagingUploader->hasPendingUploads())
+		device_impl.stagingUploader->flush();
+
 	tracker->state = CommandBufferState::Pending;
 
 	switch (submitQueueType) {
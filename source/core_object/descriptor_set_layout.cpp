@@ -62,6 +62,41 @@ static hash_t hash_descriptor_set_layout(const DescriptorSetLayoutCreateInfo& in
 	return seed;
 }
 
+vk::DescriptorSetLayout create_vk_descriptor_set_layout(
+	const DeviceImpl&                      device_impl,
+	DescriptorSetLayoutCreateFlags         flags,
+	array_view<DescriptorSetLayoutBinding> bindings
+) {
+	static_vector<vk::DescriptorSetLayoutBinding, 32> vk_bindings;
+	static_vector<vk::DescriptorBindingFlags, 32>     binding_flags;
+
+	for (const auto& binding : bindings) {
+		auto& vk_binding = vk_bindings.emplace_back();
+		vk_binding.binding            = binding.binding;
+		vk_binding.descriptorType     = to_vk_descriptor_type(binding.descriptorType);
+		vk_binding.descriptorCount    = binding.descriptorCount;
+		vk_binding.stageFlags         = to_vk_shader_stage_flags(binding.stageFlags);
+		vk_binding.pImmutableSamplers = nullptr;
+
+		if (vk_binding.descriptorCount == UINT32_MAX)
+			vk_binding.descriptorCount = get_max_resource_count(device_impl, binding.descriptorType);
+
+		binding_flags.push_back(to_vk_descriptor_binding_flags(binding.flags));
+	}
+
+	vk::DescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info;
+	binding_flags_info.bindingCount  = static_cast<uint32_t>(binding_flags.size());
+	binding_flags_info.pBindingFlags = binding_flags.data();
+
+	vk::DescriptorSetLayoutCreateInfo desc_info;
+	desc_info.flags        = to_vk_descriptor_set_layout_create_flags(flags);
+	desc_info.bindingCount = static_cast<uint32_t>(vk_bindings.size());
+	desc_info.pBindings    = vk_bindings.data();
+	desc_info.pNext        = &binding_flags_info;
+
+	return device_impl.vkDevice.createDescriptorSetLayout(desc_info);
+}
+
 const vk::DescriptorSetLayout& get_vk_descriptor_set_layout(cref<DescriptorSetLayout> set_layout) VERA_NOEXCEPT
 {
 	return CoreObject::getImpl(set_layout).vkDescriptorSetLayout;
@@ -80,61 +115,33 @@ obj<DescriptorSetLayout> DescriptorSetLayout::create(obj<Device> device, const D
 	auto&  device_impl = getImpl(device);
 	hash_t hash_value  = hash_descriptor_set_layout(info);
 
-	if (auto cached_obj = device_impl.findCachedObject<DescriptorSetLayout>(hash_value))
-		return cached_obj;
-
-	auto  obj  = createNewCoreObject<DescriptorSetLayout>();
-	auto& impl = getImpl(obj);
+	return device_impl.acquireCachedObject<DescriptorSetLayout>(hash_value, [&]() {
+		auto  obj  = createNewCoreObject<DescriptorSetLayout>();
+		auto& impl = getImpl(obj);
 
-	impl.bindings.assign(VERA_SPAN(info.bindings));
+		impl.bindings.assign(VERA_SPAN(info.bindings));
 
-	std::sort(VERA_SPAN(impl.bindings),
-		[](const auto& lhs, const auto& rhs) {
-			return lhs.binding < rhs.binding;
-		});
+		std::sort(VERA_SPAN(impl.bindings),
+			[](const auto& lhs, const auto& rhs) {
+				return lhs.binding < rhs.binding;
+			});
 
-	for (const auto& binding : impl.bindings) {
-		if (&binding == &impl.bindings.back()) break;
-		if (binding.flags.has(DescriptorSetLayoutBindingFlagBits::VariableDescriptorCount))
-			throw Exception("only the last binding can have VariableDescriptorCount flag set");
-	}
+		for (const auto& binding : impl.bindings) {
+			if (&binding == &impl.bindings.back()) break;
+			if (binding.flags.has(DescriptorSetLayoutBindingFlagBits::VariableDescriptorCount))
+				throw Exception("only the last binding can have VariableDescriptorCount flag set");
+		}
 
-	static_vector<vk::DescriptorSetLayoutBinding, 32> bindings;
-	static_vector<vk::DescriptorBindingFlags, 32>     binding_flags;
-
-	for (auto& binding : impl.bindings) {
-		auto& vk_binding = bindings.emplace_back();
-		vk_binding.binding            = binding.binding;
-		vk_binding.descriptorType     = to_vk_descriptor_type(binding.descriptorType);
-		vk_binding.descriptorCount    = binding.descriptorCount;
-		vk_binding.stageFlags         = to_vk_shader_stage_flags(binding.stageFlags);
-		vk_binding.pImmutableSamplers = nullptr;
-
-		if (vk_binding.descriptorCount == UINT32_MAX)
-			vk_binding.descriptorCount = get_max_resource_count(device_impl, binding.descriptorType);
-
-		binding_flags.push_back(to_vk_descriptor_binding_flags(binding.flags));
-
-		impl.bindingMap[binding.binding] = &binding;
-	}
-
-	vk::DescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info;
-	binding_flags_info.bindingCount  = static_cast<uint32_t>(binding_flags.size());
-	binding_flags_info.pBindingFlags = binding_flags.data();
-
-	vk::DescriptorSetLayoutCreateInfo desc_info;
-	desc_info.flags        = to_vk_descriptor_set_layout_create_flags(info.flags);
-	desc_info.bindingCount = static_cast<uint32_t>(bindings.size());
-	desc_info.pBindings    = bindings.data();
-	desc_info.pNext        = &binding_flags_info;
+		for (auto& binding : impl.bindings)
+			impl.bindingMap[binding.binding] = &binding;
 	
-	impl.device                = std::move(device);
-	impl.vkDescriptorSetLayout = device_impl.vkDevice.createDescriptorSetLayout(desc_info);
-	impl.hashValue             = hash_value;
-	
-	device_impl.registerCachedObject<DescriptorSetLayout>(hash_value, obj);
-	
-	return obj;
+		impl.device                = std::move(device);
+		impl.vkDescriptorSetLayout = create_vk_descriptor_set_layout(device_impl, info.flags, impl.bindings);
+		impl.hashValue             = hash_value;
+		impl.flags                 = info.flags;
+
+		return obj;
+	});
 }
 
 DescriptorSetLayout::~DescriptorSetLayout() VERA_NOEXCEPT
@@ -142,7 +149,7 @@ DescriptorSetLayout::~DescriptorSetLayout() VERA_NOEXCEPT
 	auto& impl        = getImpl(this);
 	auto& device_impl = getImpl(impl.device);
 
-	device_impl.unregisterCachedObject<DescriptorSetLayout>(impl.hashValue);
+	device_impl.unregisterCachedObject<DescriptorSetLayout>(impl.hashValue, this);
 	device_impl.vkDevice.destroy(impl.vkDescriptorSetLayout);
 
 	destroyObjectImpl(this);
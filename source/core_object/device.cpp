@@ -1,6 +1,7 @@
 #include "../../include/vera/core/device.h"
 #include "../impl/context_impl.h"
 #include "../impl/device_impl.h"
+#include "../impl/device_memory_impl.h"
 #include "../impl/command_buffer_impl.h"
 
 #include "../../include/vera/core/context.h"
@@ -17,6 +18,7 @@
 #include "../../include/vera/core/pipeline_layout.h"
 #include "../../include/vera/core/descriptor_set_layout.h"
 #include "../../include/vera/util/static_vector.h"
+#include <algorithm>
 #include <fstream>
 
 #define MAX_EXTENSION_COUNT 128
@@ -66,6 +68,15 @@ static MemoryPropertyFlags to_memory_property_flags(vk::MemoryPropertyFlags flag
 	return result;
 }
 
+static bool has_device_extension(vk::PhysicalDevice physical_device, std::string_view name)
+{
+	for (const auto& prop : physical_device.enumerateDeviceExtensionProperties())
+		if (name == prop.extensionName.data())
+			return true;
+
+	return false;
+}
+
 static void get_device_features(vk::PhysicalDevice physical_device, void* chain)
 {
 	vk::PhysicalDeviceFeatures2 device_features2;
@@ -217,10 +228,25 @@ obj<Device> Device::create(obj<Context> context, const DeviceCreateInfo& info)
 		!descriptor_indexing.shaderSampledImageArrayNonUniformIndexing)
 		throw Exception("descriptor indexing feature is not supported");
 
+	auto supported_features = physical_device.getFeatures();
+
 	vk::PhysicalDeviceFeatures device_features;
 	device_features.geometryShader           = true;
 	device_features.fragmentStoresAndAtomics = true;
 
+	if (supported_features.multiDrawIndirect) {
+		device_features.multiDrawIndirect = true;
+		ENABLE_FEATURE(DeviceFeatureType::MultiDrawIndirect);
+	}
+	if (supported_features.drawIndirectFirstInstance) {
+		device_features.drawIndirectFirstInstance = true;
+		ENABLE_FEATURE(DeviceFeatureType::DrawIndirectFirstInstance);
+	}
+	if (has_device_extension(physical_device, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME)) {
+		device_extensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+		ENABLE_FEATURE(DeviceFeatureType::DrawIndirectCount);
+	}
+
 	// Get physical device properties
 	vk::PhysicalDeviceProperties2 device_props;
 	device_props.pNext = &impl.vkDescriptorIndexingProperties;
@@ -253,6 +279,7 @@ obj<Device> Device::create(obj<Context> context, const DeviceCreateInfo& info)
 	impl.computeQueueFamilyIndex  = compute_family;
 	impl.transferQueueFamilyIndex = transfer_family;
 	impl.pipelineCacheFilePath    = info.pipelineCacheFilePath;
+	impl.memoryBlockSize          = info.memoryBlockSize;
 	impl.defaultSampler           = Sampler::create(obj);
 
 	if (info.enablePipelineCache) {
@@ -289,6 +316,24 @@ obj<Device> Device::create(obj<Context> context, const DeviceCreateInfo& info)
 		prop.propertyFlags = to_memory_property_flags(flags);
 	}
 
+	impl.memoryBlockPools.resize(impl.memoryTypes.size() * 2);
+	impl.commandPoolManager = std::make_unique<CommandPoolManager>(obj);
+	impl.stagingUploader    = std::make_unique<StagingUploader>(obj, info.stagingRingSize);
+	impl.pipelineCompiler   = std::make_unique<PipelineCompiler>(info.pipelineCompileThreadCount);
+
+	if (!info.pipelineIndexFilePath.empty()) {
+		impl.pipelineIndex = std::make_unique<PipelineIndex>(obj, info.pipelineIndexFilePath);
+		impl.pipelineIndex->load();
+
+		if (info.precompilePipelines)
+			impl.pipelineIndex->startPrecompile();
+	}
+
+	if (!info.reflectionCacheFilePath.empty()) {
+		impl.reflectionCache = std::make_unique<ReflectionCache>(info.reflectionCacheFilePath);
+		impl.reflectionCache->load();
+	}
+
 	return obj;
 }
 
@@ -297,6 +342,9 @@ Device::~Device() VERA_NOEXCEPT
 	auto& impl     = getImpl(this);
 	auto& ctx_impl = getImpl(impl.context);
 
+	impl.stagingUploader.reset();
+	impl.pipelineCompiler.reset();
+
 	VERA_ASSERT_MSG(impl.shaderCache.empty(), "shader cache is not empty");
 	VERA_ASSERT_MSG(impl.shaderReflectionCache.empty(), "shader reflection cache is not empty");
 	VERA_ASSERT_MSG(impl.programReflectionCache.empty(), "program reflection cache is not empty");
@@ -304,6 +352,19 @@ Device::~Device() VERA_NOEXCEPT
 	VERA_ASSERT_MSG(impl.pipelineLayoutCache.empty(), "pipeline layout cache is not empty");
 	VERA_ASSERT_MSG(impl.pipelineCache.empty(), "pipeline cache is not empty");
 	VERA_ASSERT_MSG(impl.samplerCache.empty(), "sampler cache is not empty");
+	VERA_ASSERT_MSG(std::all_of(VERA_SPAN(impl.memoryBlockPools), [](const auto& pool) { return pool.empty(); }),
+		"device memory blocks are still in use");
+
+	if (impl.pipelineIndex) {
+		impl.pipelineIndex->stopPrecompile();
+		impl.pipelineIndex->save();
+		impl.pipelineIndex.reset();
+	}
+
+	if (impl.reflectionCache) {
+		impl.reflectionCache->save();
+		impl.reflectionCache.reset();
+	}
 
 	if (impl.vkPipelineCache && !impl.pipelineCacheFilePath.empty()) {
 		std::ofstream file(impl.pipelineCacheFilePath.data(), std::ios::binary);
@@ -315,6 +376,8 @@ Device::~Device() VERA_NOEXCEPT
 
 	impl.vkDevice.waitIdle();
 
+	impl.commandPoolManager.reset();
+
 	impl.vkDevice.destroy(impl.vkPipelineCache);
 	impl.vkDevice.destroy();
 
@@ -356,6 +419,57 @@ array_view<DeviceMemoryType> Device::enumerateMemoryTypes() const
 	return getImpl(this).memoryTypes;
 }
 
+DeviceMemoryStatistics Device::getMemoryStatistics() const
+{
+	auto&                  impl   = getImpl(this);
+	DeviceMemoryStatistics result = {};
+	size_t                 free_bytes;
+
+	for (uint32_t i = 0; i < impl.memoryTypes.size(); ++i) {
+		auto stats = getMemoryStatistics(i);
+
+		result.blockCount       += stats.blockCount;
+		result.allocationCount  += stats.allocationCount;
+		result.freeRangeCount   += stats.freeRangeCount;
+		result.blockBytes       += stats.blockBytes;
+		result.allocationBytes  += stats.allocationBytes;
+		result.largestFreeRange  = std::max(result.largestFreeRange, stats.largestFreeRange);
+	}
+
+	free_bytes           = result.blockBytes - result.allocationBytes;
+	result.fragmentation = free_bytes ? 1.f - static_cast<float>(result.largestFreeRange) / free_bytes : 0.f;
+
+	return result;
+}
+
+DeviceMemoryStatistics Device::getMemoryStatistics(uint32_t memory_type_index) const
+{
+	auto&                  impl   = getImpl(this);
+	DeviceMemoryStatistics result = {};
+	size_t                 free_bytes;
+
+	if (impl.memoryTypes.size() <= memory_type_index)
+		throw Exception("invalid memory type index");
+
+	for (uint32_t i = 0; i < 2; ++i) {
+		for (const auto& block : impl.memoryBlockPools[memory_type_index * 2 + i]) {
+			auto stats = getImpl(block).allocator->getStatistics();
+
+			result.blockCount       += 1;
+			result.allocationCount  += stats.allocationCount;
+			result.freeRangeCount   += stats.freeRangeCount;
+			result.blockBytes       += stats.totalSize;
+			result.allocationBytes  += stats.usedSize;
+			result.largestFreeRange  = std::max(result.largestFreeRange, stats.largestFreeRange);
+		}
+	}
+
+	free_bytes           = result.blockBytes - result.allocationBytes;
+	result.fragmentation = free_bytes ? 1.f - static_cast<float>(result.largestFreeRange) / free_bytes : 0.f;
+
+	return result;
+}
+
 DeviceFaultInfo Device::getDeviceFaultInfo() const
 {
 	auto& impl     = getImpl(this);
@@ -396,9 +510,17 @@ DeviceFaultInfo Device::getDeviceFaultInfo() const
 	return result;
 }
 
+CommandSync Device::flushUploads()
+{
+	return getImpl(this).stagingUploader->flush();
+}
+
 void Device::waitIdle() const
 {
-	getImpl(this).vkDevice.waitIdle();
+	auto& impl = getImpl(this);
+
+	impl.stagingUploader->waitIdle();
+	impl.vkDevice.waitIdle();
 }
 
 bool DeviceImpl::isFeatureEnabled(DeviceFeatureType feature) const VERA_NOEXCEPT
@@ -415,60 +537,4 @@ uint32_t DeviceImpl::findMemoryTypeIndex(MemoryPropertyFlags flags, std::bitset<
 	VERA_ERROR_MSG("failed to find memory type index");
 }
 
-template<>
-obj<Shader> DeviceImpl::findCachedObject<Shader>(hash_t hash_value)
-{
-	if (auto it = shaderCache.find(hash_value); it != shaderCache.end())
-		return unsafe_obj_cast<Shader>(it->second);
-	return {};
-}
-
-template<>
-obj<ShaderReflection> DeviceImpl::findCachedObject<ShaderReflection>(hash_t hash_value)
-{
-	if (auto it = shaderReflectionCache.find(hash_value); it != shaderReflectionCache.end())
-		return unsafe_obj_cast<ShaderReflection>(it->second);
-	return {};
-}
-
-template<>
-obj<ProgramReflection> DeviceImpl::findCachedObject<ProgramReflection>(hash_t hash_value)
-{
-	if (auto it = programReflectionCache.find(hash_value); it != programReflectionCache.end())
-		return unsafe_obj_cast<ProgramReflection>(it->second);
-	return {};
-}
-
-template<>
-obj<DescriptorSetLayout> DeviceImpl::findCachedObject<DescriptorSetLayout>(hash_t hash_value)
-{
-	if (auto it = descriptorSetLayoutCache.find(hash_value); it != descriptorSetLayoutCache.end())
-		return unsafe_obj_cast<DescriptorSetLayout>(it->second);
-	return {};
-}
-
-template<>
-obj<PipelineLayout> DeviceImpl::findCachedObject<PipelineLayout>(hash_t hash_value)
-{
-	if (auto it = pipelineLayoutCache.find(hash_value); it != pipelineLayoutCache.end())
-		return unsafe_obj_cast<PipelineLayout>(it->second);
-	return {};
-}
-
-template<>
-obj<Pipeline> DeviceImpl::findCachedObject<Pipeline>(hash_t hash_value)
-{
-	if (auto it = pipelineCache.find(hash_value); it != pipelineCache.end())
-		return unsafe_obj_cast<Pipeline>(it->second);
-	return {};
-}
-
-template<>
-obj<Sampler> DeviceImpl::findCachedObject<Sampler>(hash_t hash_value)
-{
-	if (auto it = samplerCache.find(hash_value); it != samplerCache.end())
-		return unsafe_obj_cast<Sampler>(it->second);
-	return {};
-}
-
 VERA_NAMESPACE_END
@@ -7,9 +7,97 @@
 #include "../../include/vera/core/device.h"
 #include "../../include/vera/core/buffer.h"
 #include "../../include/vera/core/texture.h"
+#include <algorithm>
 
 VERA_NAMESPACE_BEGIN
 
+static obj<DeviceMemory> create_memory_block(obj<Device> device, uint32_t type_idx, uint32_t pool_idx)
+{
+	auto& device_impl = CoreObject::getImpl(device);
+
+	DeviceMemoryCreateInfo info;
+	info.size           = device_impl.memoryBlockSize;
+	info.propertyFlags  = device_impl.memoryTypes[type_idx].propertyFlags;
+	info.memoryTypeMask = std::bitset<32>().set(type_idx);
+
+	auto  obj  = DeviceMemory::create(std::move(device), info);
+	auto& impl = CoreObject::getImpl(obj);
+
+	impl.allocator = std::make_unique<TLSFAllocator>(info.size);
+	impl.poolIndex = pool_idx;
+
+	device_impl.memoryBlockPools[pool_idx].push_back(obj);
+
+	return obj;
+}
+
+MemoryAllocation allocate_device_memory(
+	obj<Device>                   device,
+	const vk::MemoryRequirements& requirements,
+	MemoryPropertyFlags           flags,
+	MemoryResourceType            resource_type
+) {
+	auto&            device_impl = CoreObject::getImpl(device);
+	auto             type_idx    = device_impl.findMemoryTypeIndex(flags, requirements.memoryTypeBits);
+	auto             type_flags  = device_impl.memoryTypes[type_idx].propertyFlags;
+	size_t           alignment   = requirements.alignment;
+	MemoryAllocation result;
+	TLSFAllocation   allocation;
+
+	// resources too large to share a block are not worth suballocating
+	if (device_impl.memoryBlockSize / 2 < requirements.size) {
+		DeviceMemoryCreateInfo info;
+		info.size           = requirements.size;
+		info.propertyFlags  = flags;
+		info.memoryTypeMask = requirements.memoryTypeBits;
+
+		result.memory       = DeviceMemory::create(std::move(device), info);
+		result.offset       = 0;
+		result.allocationID = TLSFAllocator::INVALID_ID;
+
+		return result;
+	}
+
+	// neighbouring resources must not share a non-coherent atom, or flushing one clobbers the other
+	if (type_flags.has(MemoryPropertyFlagBits::HostVisible) && !type_flags.has(MemoryPropertyFlagBits::HostCoherent))
+		alignment = std::max<size_t>(alignment, device_impl.vkDeviceProperties.limits.nonCoherentAtomSize);
+
+	uint32_t pool_idx = type_idx * 2 + (resource_type == MemoryResourceType::Texture ? 1 : 0);
+
+	for (auto& block : device_impl.memoryBlockPools[pool_idx]) {
+		auto& block_impl = CoreObject::getImpl(block);
+
+		if (block_impl.allocator->allocate(requirements.size, alignment, allocation)) {
+			result.memory       = unsafe_obj_cast<DeviceMemory>(block);
+			result.offset       = allocation.offset;
+			result.allocationID = allocation.id;
+
+			return result;
+		}
+	}
+
+	auto  block      = create_memory_block(std::move(device), type_idx, pool_idx);
+	auto& block_impl = CoreObject::getImpl(block);
+
+	if (!block_impl.allocator->allocate(requirements.size, alignment, allocation))
+		throw Exception("failed to suballocate device memory");
+
+	result.memory       = std::move(block);
+	result.offset       = allocation.offset;
+	result.allocationID = allocation.id;
+
+	return result;
+}
+
+void free_device_memory(DeviceMemoryImpl& impl, uint32_t allocation_id) VERA_NOEXCEPT
+{
+	if (allocation_id == TLSFAllocator::INVALID_ID) return;
+
+	VERA_ASSERT_MSG(impl.allocator, "attempt to free suballocation from dedicated memory");
+
+	impl.allocator->free(allocation_id);
+}
+
 const vk::DeviceMemory& get_vk_device_memory(cref<DeviceMemory> device_memory) VERA_NOEXCEPT
 {
 	return CoreObject::getImpl(device_memory).vkMemory;
@@ -47,6 +135,17 @@ DeviceMemory::~DeviceMemory() VERA_NOEXCEPT
 	auto& impl        = getImpl(this);
 	auto& device_impl = getImpl(impl.device);
 
+	if (impl.allocator) {
+		auto& pool = device_impl.memoryBlockPools[impl.poolIndex];
+		auto  iter = std::find_if(VERA_SPAN(pool),
+			[this](const auto& block) {
+				return block.get() == this;
+			});
+
+		VERA_ASSERT(iter != pool.end());
+		pool.erase(iter);
+	}
+
 	device_impl.vkDevice.freeMemory(impl.vkMemory);
 
 	destroyObjectImpl(this);
@@ -57,6 +156,9 @@ void DeviceMemory::resize(size_t new_size, bool keep_contents)
 	auto& impl      = getImpl(this);
 	auto  vk_device = get_vk_device(impl.device);
 
+	if (impl.allocator)
+		throw Exception("cannot resize device memory shared by suballocated resources");
+
 	// TODO: implement DeviceMemory::resize() keep contents
 
 	vk_device.free(impl.vkMemory);
@@ -131,6 +233,24 @@ void DeviceMemory::bindTexture(obj<Texture> texture, size_t offset)
 	binding.resourcePtr  = texture.get();
 }
 
+void flush_device_memory(DeviceMemoryImpl& impl, size_t offset, size_t size)
+{
+	if (!impl.mapPtr || size == 0 || impl.propertyFlags.has(MemoryPropertyFlagBits::HostCoherent))
+		return;
+
+	auto&  device_impl = CoreObject::getImpl(impl.device);
+	size_t atom_size   = device_impl.vkDeviceProperties.limits.nonCoherentAtomSize;
+	size_t begin       = offset / atom_size * atom_size;
+	size_t end         = (offset + size + atom_size - 1) / atom_size * atom_size;
+
+	vk::MappedMemoryRange range;
+	range.memory = impl.vkMemory;
+	range.offset = begin;
+	range.size   = end < impl.allocated ? end - begin : VK_WHOLE_SIZE;
+
+	device_impl.vkDevice.flushMappedMemoryRanges(range);
+}
+
 void* DeviceMemory::map()
 {
 	auto& impl = getImpl(this);
@@ -150,7 +270,8 @@ void DeviceMemory::unmap()
 {
 	auto& impl = getImpl(this);
 
-	if (!impl.mapPtr) return;
+	// shared blocks stay persistently mapped, other resources may hold pointers into them
+	if (!impl.mapPtr || impl.allocator) return;
 
 	auto vk_device = get_vk_device(impl.device);
 
@@ -177,20 +298,19 @@ void DeviceMemory::flush()
 void DeviceMemory::upload(const void* data, size_t size, size_t offset)
 {
 	auto& impl = getImpl(this);
-	void* dst  = reinterpret_cast<uint8_t*>(map()) + offset;
 
 	if (impl.allocated < offset + size)
 		throw Exception("attempt to upload more data than allocated memory size");
 
-	auto  vk_device = get_vk_device(impl.device);
-	
-	vk::MappedMemoryRange range;
-	range.memory = impl.vkMemory;
-	range.offset = offset;
-	range.size   = size;
+	if (!impl.propertyFlags.has(MemoryPropertyFlagBits::HostVisible)) {
+		getImpl(impl.device).stagingUploader->uploadMemory(this, offset, data, size);
+		return;
+	}
+
+	void* dst = reinterpret_cast<uint8_t*>(map()) + offset;
 
 	std::memcpy(dst, data, size);
-	vk_device.flushMappedMemoryRanges(range);
+	flush_device_memory(impl, offset, size);
 }
 
 VERA_NAMESPACE_END
\ No newline at end of file
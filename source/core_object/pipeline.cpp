@@ -1,6 +1,9 @@
 #include "../../include/vera/core/pipeline.h"
 #include "../impl/device_impl.h"
+#include "../impl/descriptor_set_layout_impl.h"
 #include "../impl/pipeline_impl.h"
+#include "../impl/pipeline_index.h"
+#include "../impl/pipeline_layout_impl.h"
 #include "../impl/shader_impl.h"
 #include "../impl/shader_reflection_impl.h"
 
@@ -8,6 +11,7 @@
 #include "../../include/vera/core/pipeline_layout.h"
 #include "../../include/vera/core/texture.h"
 #include "../../include/vera/util/static_vector.h"
+#include <algorithm>
 
 #define MAX_SHADER_STAGE_COUNT 16
 
@@ -108,55 +112,53 @@ static obj<PipelineLayout> register_pipeline_layout(obj<Device> device, const Co
 }
 
 static void add_shader_stage(
-	PipelineImpl&                                                             impl,
-	static_vector<vk::PipelineShaderStageCreateInfo, MAX_SHADER_STAGE_COUNT>& shader_infos,
-	const obj<Shader>&                                                        shader,
-	ShaderStageFlagBits                                                       stage
+	PipelineRecipe&           recipe,
+	std::vector<obj<Shader>>& shaders,
+	const obj<Shader>&        shader,
+	ShaderStageFlagBits       stage
 ) {
 	VERA_ASSERT_MSG(shader, "shader is null");
 
-	auto& shader_impl = const_cast<ShaderImpl&>(CoreObject::getImpl(shader));
+	auto& shader_impl = CoreObject::getImpl(shader);
 
-	vk::PipelineShaderStageCreateInfo shader_info;
-	shader_info.stage               = to_vk_shader_stage_flag_bits(stage);
-	shader_info.module              = shader_impl.vkShaderModule;
-	shader_info.pName               = shader_impl.entryPointName.data();
-	shader_info.pSpecializationInfo = nullptr;
+	auto& stage_recipe = recipe.stages.emplace_back();
+	stage_recipe.stage      = stage;
+	stage_recipe.codeKey    = shader_impl.codeKey;
+	stage_recipe.entryPoint = shader_impl.entryPointName;
 
-	shader_infos.push_back(shader_info);
-	impl.shaders.push_back(shader);
+	shaders.push_back(shader);
 }
 
 static void fill_shader_info(
-	PipelineImpl&                                                             impl,
-	static_vector<vk::PipelineShaderStageCreateInfo, MAX_SHADER_STAGE_COUNT>& shader_infos,
-	const GraphicsPipelineCreateInfo&                                         info
+	PipelineRecipe&                   recipe,
+	std::vector<obj<Shader>>&         shaders,
+	const GraphicsPipelineCreateInfo& info
 ) {
-	add_shader_stage(impl, shader_infos, info.vertexShader, ShaderStageFlagBits::Vertex);
-	add_shader_stage(impl, shader_infos, info.fragmentShader, ShaderStageFlagBits::Fragment);
+	add_shader_stage(recipe, shaders, info.vertexShader, ShaderStageFlagBits::Vertex);
+	add_shader_stage(recipe, shaders, info.fragmentShader, ShaderStageFlagBits::Fragment);
 
 	if (info.tessellationControlShader)
-		add_shader_stage(impl, shader_infos, info.tessellationControlShader,
+		add_shader_stage(recipe, shaders, info.tessellationControlShader,
 			ShaderStageFlagBits::TessellationControl);
 
 	if (info.tessellationEvaluationShader)
-		add_shader_stage(impl, shader_infos, info.tessellationEvaluationShader,
+		add_shader_stage(recipe, shaders, info.tessellationEvaluationShader,
 			ShaderStageFlagBits::TessellationEvaluation);
 
 	if (info.geometryShader)
-		add_shader_stage(impl, shader_infos, info.geometryShader, ShaderStageFlagBits::Geometry);
+		add_shader_stage(recipe, shaders, info.geometryShader, ShaderStageFlagBits::Geometry);
 }
 
 static void fill_shader_info(
-	PipelineImpl&                                                             impl,
-	static_vector<vk::PipelineShaderStageCreateInfo, MAX_SHADER_STAGE_COUNT>& shader_infos,
-	const MeshPipelineCreateInfo&                                             info
+	PipelineRecipe&               recipe,
+	std::vector<obj<Shader>>&     shaders,
+	const MeshPipelineCreateInfo& info
 ) {
 	if (info.taskShader)
-		add_shader_stage(impl, shader_infos, info.taskShader, ShaderStageFlagBits::Task);
+		add_shader_stage(recipe, shaders, info.taskShader, ShaderStageFlagBits::Task);
 
-	add_shader_stage(impl, shader_infos, info.meshShader, ShaderStageFlagBits::Mesh);
-	add_shader_stage(impl, shader_infos, info.fragmentShader, ShaderStageFlagBits::Fragment);
+	add_shader_stage(recipe, shaders, info.meshShader, ShaderStageFlagBits::Mesh);
+	add_shader_stage(recipe, shaders, info.fragmentShader, ShaderStageFlagBits::Fragment);
 }
 
 static vk::Format get_vertex_format(VertexFormat format, uint32_t& attr_count)
@@ -324,349 +326,380 @@ static void fill_color_blend_state_info(
 	cb_info.blendConstants[3] = info.blendConstants[3];
 }
 
-static void fill_dynamic_states(static_vector<vk::DynamicState, 64>& states, const GraphicsPipelineCreateInfo& info)
+static void fill_layout_recipe(PipelineRecipe& recipe, const obj<PipelineLayout>& pipeline_layout)
 {
-	states = {
-		// viewport
-		vk::DynamicState::eViewport,
-		vk::DynamicState::eScissor
-	};
-
-	for (const auto ds : info.dynamicStates)
-		states.push_back(to_vk_dynamic_state(ds));
-
-	//if (!info.primitiveInfo) {
-	//	states.push_back(vk::DynamicState::ePrimitiveRestartEnable);
-	//	states.push_back(vk::DynamicState::ePrimitiveTopology);
-	//}
-
-	//if (!info.rasterizationInfo) {
-	//	states.push_back(vk::DynamicState::eDepthClampEnableEXT);
-	//	states.push_back(vk::DynamicState::eRasterizerDiscardEnable);
-	//	states.push_back(vk::DynamicState::ePolygonModeEXT);
-	//	states.push_back(vk::DynamicState::eCullMode);
-	//	states.push_back(vk::DynamicState::eFrontFace);
-	//	states.push_back(vk::DynamicState::eDepthBiasEnable);
-	//	states.push_back(vk::DynamicState::eDepthBias);
-	//	states.push_back(vk::DynamicState::eLineWidth);
-	//}
-
-	//if (!info.tessellationPatchControlPoints)
-	//	states.push_back(vk::DynamicState::ePatchControlPointsEXT);
-
-	//if (!info.depthStencilInfo) {
-	//	states.push_back(vk::DynamicState::eLogicOpEnableEXT);
-	//	states.push_back(vk::DynamicState::eLogicOpEXT);
-	//	states.push_back(vk::DynamicState::eColorBlendEnableEXT);
-	//	states.push_back(vk::DynamicState::eColorBlendEquationEXT);
-	//	states.push_back(vk::DynamicState::eColorWriteMaskEXT);
-	//	states.push_back(vk::DynamicState::eBlendConstants);
-	//}
-
-	//if (!info.colorBlendInfo) {
-	//	states.push_back(vk::DynamicState::eLogicOpEnableEXT);
-	//	states.push_back(vk::DynamicState::eLogicOpEXT);
-	//	states.push_back(vk::DynamicState::eColorBlendEnableEXT);
-	//	states.push_back(vk::DynamicState::eColorBlendEquationEXT);
-	//	states.push_back(vk::DynamicState::eColorWriteMaskEXT);
-	//	states.push_back(vk::DynamicState::eBlendConstants);
-	//}
-}
-
-static void fill_dynamic_states(static_vector<vk::DynamicState, 64>& states, const MeshPipelineCreateInfo& info)
-{
-	states = {
-		// viewport
-		vk::DynamicState::eViewport,
-		vk::DynamicState::eScissor
-	};
+	auto& layout_impl = CoreObject::getImpl(pipeline_layout);
 
-	for (const auto ds : info.dynamicStates)
-		states.push_back(to_vk_dynamic_state(ds));
-
-	//if (!info.rasterizationInfo) {
-	//	states.push_back(vk::DynamicState::eDepthClampEnableEXT);
-	//	states.push_back(vk::DynamicState::eRasterizerDiscardEnable);
-	//	states.push_back(vk::DynamicState::ePolygonModeEXT);
-	//	states.push_back(vk::DynamicState::eCullMode);
-	//	states.push_back(vk::DynamicState::eFrontFace);
-	//	states.push_back(vk::DynamicState::eDepthBiasEnable);
-	//	states.push_back(vk::DynamicState::eDepthBias);
-	//	states.push_back(vk::DynamicState::eLineWidth);
-	//}
-
-	//if (!info.depthStencilInfo) {
-	//	states.push_back(vk::DynamicState::eLogicOpEnableEXT);
-	//	states.push_back(vk::DynamicState::eLogicOpEXT);
-	//	states.push_back(vk::DynamicState::eColorBlendEnableEXT);
-	//	states.push_back(vk::DynamicState::eColorBlendEquationEXT);
-	//	states.push_back(vk::DynamicState::eColorWriteMaskEXT);
-	//	states.push_back(vk::DynamicState::eBlendConstants);
-	//}
-
-	//if (!info.colorBlendInfo) {
-	//	states.push_back(vk::DynamicState::eLogicOpEnableEXT);
-	//	states.push_back(vk::DynamicState::eLogicOpEXT);
-	//	states.push_back(vk::DynamicState::eColorBlendEnableEXT);
-	//	states.push_back(vk::DynamicState::eColorBlendEquationEXT);
-	//	states.push_back(vk::DynamicState::eColorWriteMaskEXT);
-	//	states.push_back(vk::DynamicState::eBlendConstants);
-	//}
-}
-
-static hash_t hash_pipeline_info(const GraphicsPipelineCreateInfo& info)
-{
-	hash_t seed = 0;
+	for (const auto& set_layout : layout_impl.descriptorSetLayouts) {
+		auto& set_layout_impl = CoreObject::getImpl(set_layout);
+		auto& set_recipe      = recipe.setLayouts.emplace_back();
 
-	hash_combine(seed, info.vertexShader->hash());
-	hash_combine(seed, info.tessellationControlShader ? info.tessellationControlShader->hash() : 0);
-	hash_combine(seed, info.tessellationEvaluationShader ? info.tessellationEvaluationShader->hash() : 0);
-	hash_combine(seed, info.geometryShader ? info.geometryShader->hash() : 0);
-	hash_combine(seed, info.fragmentShader->hash());
+		set_recipe.flags    = set_layout_impl.flags;
+		set_recipe.bindings = set_layout_impl.bindings;
+	}
 
-	return seed;
+	recipe.pushConstantRanges = layout_impl.pushConstantRanges;
 }
 
-static hash_t hash_pipeline_info(const MeshPipelineCreateInfo& info)
-{
-	hash_t seed = 1;
-
-	hash_combine(seed, info.taskShader ? info.taskShader->hash() : 0);
-	hash_combine(seed, info.meshShader->hash());
-	hash_combine(seed, info.fragmentShader->hash());
+static void fill_vertex_binding_recipe(
+	PipelineRecipe&              recipe,
+	const VertexInputDescriptor& desc,
+	bool                         per_instance
+) {
+	auto& binding = recipe.vertexBindings.emplace_back();
+	binding.binding     = static_cast<uint32_t>(recipe.vertexBindings.size() - 1);
+	binding.stride      = desc.vertexSize();
+	binding.perInstance = per_instance;
+	binding.attributes.assign(desc.attributeData(), desc.attributeData() + desc.attributeSize());
+}
 
-	return seed;
+static void fill_color_format_recipe(
+	PipelineRecipe&            recipe,
+	const DeviceImpl&          device_impl,
+	const std::vector<Format>& formats
+) {
+	for (auto format : formats)
+		recipe.colorFormats.push_back(format == Format::Unknown ? device_impl.colorFormat : format);
 }
 
-static hash_t hash_pipeline_info(const ComputePipelineCreateInfo& info)
+static void fill_dynamic_state_recipe(PipelineRecipe& recipe, const std::vector<DynamicState>& states)
 {
-	hash_t seed = 2;
-	
-	hash_combine(seed, info.computeShader->hash());
+	// neither order nor repetition changes the pipeline, so they must not change the key
+	recipe.dynamicStates = states;
 
-	return seed;
+	std::sort(VERA_SPAN(recipe.dynamicStates));
+	recipe.dynamicStates.erase(
+		std::unique(VERA_SPAN(recipe.dynamicStates)),
+		recipe.dynamicStates.end());
 }
 
-const vk::Pipeline& get_vk_pipeline(cref<Pipeline> pipeline) VERA_NOEXCEPT
-{
-	return CoreObject::getImpl(pipeline).vkPipeline;
-}
+static PipelineRecipe make_pipeline_recipe(
+	const DeviceImpl&                 device_impl,
+	const GraphicsPipelineCreateInfo& info,
+	const obj<PipelineLayout>&        pipeline_layout,
+	std::vector<obj<Shader>>&         shaders
+) {
+	PipelineRecipe recipe;
+	recipe.bindPoint      = PipelineBindPoint::Graphics;
+	recipe.hasVertexInput = true;
 
-vk::Pipeline& get_vk_pipeline(ref<Pipeline> pipeline) VERA_NOEXCEPT
-{
-	return CoreObject::getImpl(pipeline).vkPipeline;
-}
+	fill_shader_info(recipe, shaders, info);
+	fill_layout_recipe(recipe, pipeline_layout);
 
-obj<Pipeline> Pipeline::create(obj<Device> device, const GraphicsPipelineCreateInfo& info)
-{
-	if (!info.vertexShader)
-		throw Exception("Graphics pipeline must have a vertex shader");
-	if (!info.fragmentShader)
-		throw Exception("Graphics pipeline must have a fragment shader");
+	if (info.vertexInputInfo.has_value()) {
+		auto& vertex_info = info.vertexInputInfo.value();
 
-	auto&  device_impl = getImpl(device);
-	hash_t hash_value  = hash_pipeline_info(info);
+		if (vertex_info.vertexInputDescriptor.empty())
+			throw Exception("vertex input attribute cannot be empty");
 
-	if (auto cached_obj = device_impl.findCachedObject<Pipeline>(hash_value))
-		return cached_obj;
+		fill_vertex_binding_recipe(recipe, vertex_info.vertexInputDescriptor, false);
 
-	// create pipline layout first to check shader stages
-	auto pipeline_layout = register_pipeline_layout(device, info);
+		if (!vertex_info.instanceInputDescriptor.empty())
+			fill_vertex_binding_recipe(recipe, vertex_info.instanceInputDescriptor, true);
+	}
 
-	auto  obj  = createNewCoreObject<Pipeline>();
-	auto& impl = getImpl(obj);
+	recipe.primitive          = info.primitiveInfo.value_or(PrimitiveInfo{});
+	recipe.patchControlPoints = info.tessellationPatchControlPoints.value_or(0);
+	recipe.rasterization      = info.rasterizationInfo.value_or(RasterizationInfo{});
+	recipe.depthStencil       = info.depthStencilInfo.value_or(DepthStencilInfo{});
+	recipe.colorBlend         = info.colorBlendInfo.value_or(ColorBlendInfo{});
 
-	static_vector<vk::PipelineShaderStageCreateInfo, MAX_SHADER_STAGE_COUNT> shader_infos;
-	fill_shader_info(impl, shader_infos, info);
+	fill_color_format_recipe(recipe, device_impl, info.colorAttachmentFormats);
+	fill_dynamic_state_recipe(recipe, info.dynamicStates);
 
-	std::vector<vk::VertexInputAttributeDescription> vertex_attributes;
-	vk::VertexInputBindingDescription                vertex_binding_descs[2];
-	uint32_t                                         vertex_binding_desc_count = 0;
-	uint32_t                                         vertex_location           = 0;
+	return recipe;
+}
 
-	if (info.vertexInputInfo.has_value()) {
-		auto& vertex_info = info.vertexInputInfo.value();
+static PipelineRecipe make_pipeline_recipe(
+	const DeviceImpl&             device_impl,
+	const MeshPipelineCreateInfo& info,
+	const obj<PipelineLayout>&    pipeline_layout,
+	std::vector<obj<Shader>>&     shaders
+) {
+	PipelineRecipe recipe;
+	recipe.bindPoint      = PipelineBindPoint::Graphics;
+	recipe.hasVertexInput = false;
 
-		if (!vertex_info.vertexInputDescriptor.empty()) {
-			auto& desc    = vertex_info.vertexInputDescriptor;
-			auto& binding = vertex_binding_descs[vertex_binding_desc_count++];
-			
-			fill_vertex_input_attributes(
-				vertex_attributes,
-				0,
-				desc.attributeSize(),
-				desc.attributeData(),
-				vertex_location);
-
-			binding.binding   = 0;
-			binding.stride    = desc.vertexSize();
-			binding.inputRate = vk::VertexInputRate::eVertex;
-		} else {
-			throw Exception("vertex input attribute cannot be empty");
-		}
+	fill_shader_info(recipe, shaders, info);
+	fill_layout_recipe(recipe, pipeline_layout);
 
-		if (!vertex_info.instanceInputDescriptor.empty()) {
-			auto& desc    = vertex_info.vertexInputDescriptor;
-			auto& binding = vertex_binding_descs[vertex_binding_desc_count++];
+	recipe.rasterization = info.rasterizationInfo.value_or(RasterizationInfo{});
+	recipe.depthStencil  = info.depthStencilInfo.value_or(DepthStencilInfo{});
+	recipe.colorBlend    = info.colorBlendInfo.value_or(ColorBlendInfo{});
 
-			fill_vertex_input_attributes(
-				vertex_attributes,
-				1,
-				desc.attributeSize(),
-				desc.attributeData(),
-				vertex_location);
+	fill_color_format_recipe(recipe, device_impl, info.colorAttachmentFormats);
+	fill_dynamic_state_recipe(recipe, info.dynamicStates);
 
-			binding.binding   = 1;
-			binding.stride    = desc.vertexSize();
-			binding.inputRate = vk::VertexInputRate::eInstance;
-		}
-	}
+	return recipe;
+}
 
-	vk::PipelineVertexInputStateCreateInfo vi_info;
-	vi_info.vertexBindingDescriptionCount   = vertex_binding_desc_count;
-	vi_info.pVertexBindingDescriptions      = vertex_binding_descs;
-	vi_info.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertex_attributes.size());
-	vi_info.pVertexAttributeDescriptions    = vertex_attributes.data();
+static PipelineRecipe make_pipeline_recipe(
+	const DeviceImpl&                device_impl,
+	const ComputePipelineCreateInfo& info,
+	const obj<PipelineLayout>&       pipeline_layout,
+	std::vector<obj<Shader>>&        shaders
+) {
+	PipelineRecipe recipe;
+	recipe.bindPoint = PipelineBindPoint::Compute;
 
-	vk::PipelineInputAssemblyStateCreateInfo ia_info;
-	if (info.primitiveInfo) {
-		fill_primitive_state_info(ia_info, *info.primitiveInfo);
-	} else {
-		fill_primitive_state_info(ia_info, PrimitiveInfo{});
-	}
+	add_shader_stage(recipe, shaders, info.computeShader, ShaderStageFlagBits::Compute);
+	fill_layout_recipe(recipe, pipeline_layout);
 
-	vk::PipelineTessellationStateCreateInfo ts_info;
-	if (info.tessellationPatchControlPoints) {
-		fill_tessellation_state_info(ts_info, *info.tessellationPatchControlPoints);
-	} else {
-		fill_tessellation_state_info(ts_info, 0);
-	}
+	return recipe;
+}
 
-	vk::PipelineRasterizationStateCreateInfo rs_info;
-	if (info.rasterizationInfo) {
-		fill_rasterizer_state_info(rs_info, *info.rasterizationInfo);
-	} else {
-		fill_rasterizer_state_info(rs_info, RasterizationInfo{});
-	}
+static hash128_t hash_pipeline_recipe(const PipelineRecipe& recipe)
+{
+	auto bytes = recipe.serialize();
 
-	vk::PipelineMultisampleStateCreateInfo ms_info;
-	ms_info.rasterizationSamples  = vk::SampleCountFlagBits::e1;
-	ms_info.sampleShadingEnable   = false;
-	ms_info.minSampleShading      = 1.f;
-	ms_info.pSampleMask           = nullptr;
-	ms_info.alphaToCoverageEnable = false;
-	ms_info.alphaToOneEnable      = false;
+	return hash_bytes_128(bytes.data(), bytes.size());
+}
 
-	vk::PipelineDepthStencilStateCreateInfo ds_info;
-	if (info.depthStencilInfo) {
-		fill_depth_stencil_state_info(ds_info, *info.depthStencilInfo);
-	} else {
-		fill_depth_stencil_state_info(ds_info, DepthStencilInfo{});
-	}
+// pipelineCacheMutex must be held, entries of pipelines whose destructor is waiting for the lock are skipped.
+// cacheable is cleared when a live pipeline of another recipe shares the low half of the key.
+static obj<Pipeline> find_cached_pipeline(DeviceImpl& device_impl, const hash128_t& pipeline_key, bool& cacheable)
+{
+	cacheable = true;
 
-	vk::PipelineColorBlendStateCreateInfo cb_info;
-	if (info.colorBlendInfo) {
-		fill_color_blend_state_info(cb_info, *info.colorBlendInfo);
-	} else {
-		fill_color_blend_state_info(cb_info, ColorBlendInfo{});
-	}
+	auto iter = device_impl.pipelineCache.find(pipeline_key.low);
 
-	static_vector<vk::DynamicState, 64> dynamic_states;
-	fill_dynamic_states(dynamic_states, info);
+	if (iter == device_impl.pipelineCache.end())
+		return {};
 
-	vk::PipelineDynamicStateCreateInfo dynamic_info;
-	dynamic_info.dynamicStateCount = static_cast<uint32_t>(dynamic_states.size());
-	dynamic_info.pDynamicStates    = dynamic_states.data();
+	auto cached_obj = try_obj_cast<Pipeline>(iter->second);
 
-	static_vector<vk::Format, 32> vk_color_formats;
-	for (const auto& format : info.colorAttachmentFormats) {
-		vk_color_formats.push_back(format == Format::Unknown ?
-								   to_vk_format(device_impl.colorFormat) :
-								   to_vk_format(format));
+	if (cached_obj && CoreObject::getImpl(cached_obj).pipelineKey != pipeline_key) {
+		cacheable = false;
+		return {};
 	}
 
-	vk::PipelineRenderingCreateInfoKHR rendering_info;
-	rendering_info.colorAttachmentCount    = static_cast<uint32_t>(vk_color_formats.size());
-	rendering_info.pColorAttachmentFormats = vk_color_formats.data();
+	return cached_obj;
+}
 
-	if (info.depthStencilInfo) {
-		rendering_info.depthAttachmentFormat   =
-			to_vk_format(static_cast<Format>(info.depthStencilInfo->depthFormat));
-		rendering_info.stencilAttachmentFormat =
-			to_vk_format(static_cast<Format>(info.depthStencilInfo->stencilFormat));
-	} else {
-		rendering_info.depthAttachmentFormat   = vk::Format::eUndefined; 
-		rendering_info.stencilAttachmentFormat = vk::Format::eUndefined;
-	}
+// pipelineCacheMutex must be held and find_cached_pipeline must have missed, so any entry left is a dying one
+static void register_cached_pipeline(DeviceImpl& device_impl, ref<Pipeline> pipeline)
+{
+	auto& impl = CoreObject::getImpl(pipeline);
 
-	vk::GraphicsPipelineCreateInfo pipeline_info;
-	pipeline_info.stageCount          = static_cast<uint32_t>(shader_infos.size());
-	pipeline_info.pStages             = shader_infos.data();
-	pipeline_info.pVertexInputState   = &vi_info;
-	pipeline_info.pInputAssemblyState = &ia_info;
-	pipeline_info.pTessellationState  = &ts_info;
-	pipeline_info.pViewportState      = get_default_viewport_state_info();
-	pipeline_info.pRasterizationState = &rs_info;
-	pipeline_info.pMultisampleState   = &ms_info;
-	pipeline_info.pDepthStencilState  = &ds_info;
-	pipeline_info.pColorBlendState    = &cb_info;
-	pipeline_info.pDynamicState       = &dynamic_info;
-	pipeline_info.layout              = get_vk_pipeline_layout(pipeline_layout);
-	pipeline_info.renderPass          = nullptr;
-	pipeline_info.subpass             = 0;
-	pipeline_info.basePipelineHandle  = nullptr;
-	pipeline_info.basePipelineIndex   = 0;
-	pipeline_info.pNext               = &rendering_info;
+	device_impl.pipelineCache.insert_or_assign(impl.hashValue, pipeline);
+}
 
-	auto result = device_impl.vkDevice.createGraphicsPipeline(device_impl.vkPipelineCache, pipeline_info);
+static void unregister_cached_pipeline(DeviceImpl& device_impl, const Pipeline* pipeline, hash_t hash_value)
+{
+	std::lock_guard<std::mutex> lock(device_impl.pipelineCacheMutex);
 
-	if (result.result != vk::Result::eSuccess)
-		throw Exception("failed to create graphics pipeline");
+	// the entry may already belong to a pipeline created while this one was being destroyed
+	if (auto iter = device_impl.pipelineCache.find(hash_value);
+		iter != device_impl.pipelineCache.end() && iter->second.get() == pipeline)
+		device_impl.pipelineCache.erase(iter);
+}
 
-	impl.device            = std::move(device);
-	impl.pipelineLayout    = std::move(pipeline_layout);
-	impl.vkPipeline        = result.value;
-	impl.pipelineBindPoint = PipelineBindPoint::Graphics;
-	impl.hashValue         = hash_value;
+// takes the pipeline from the background precompile if it got there first, compiles it otherwise
+static vk::Pipeline acquire_vk_pipeline(
+	DeviceImpl&                     device_impl,
+	const PipelineRecipe&           recipe,
+	const hash128_t&                pipeline_key,
+	const std::vector<obj<Shader>>& shaders,
+	const obj<PipelineLayout>&      pipeline_layout
+) {
+	static_vector<vk::ShaderModule, MAX_SHADER_STAGE_COUNT> modules;
 
-	device_impl.registerCachedObject<Pipeline>(impl.hashValue, obj);
+	if (device_impl.pipelineIndex)
+		if (auto pipeline = device_impl.pipelineIndex->claim(pipeline_key))
+			return pipeline;
 
-	return obj;
+	for (const auto& shader : shaders)
+		modules.push_back(CoreObject::getImpl(shader).vkShaderModule);
+
+	auto pipeline = create_vk_pipeline(
+		device_impl,
+		recipe,
+		array_view<vk::ShaderModule>(modules.data(), modules.size()),
+		get_vk_pipeline_layout(pipeline_layout));
+
+	if (device_impl.pipelineIndex)
+		device_impl.pipelineIndex->record(pipeline_key, recipe, shaders);
+
+	return pipeline;
 }
 
-obj<Pipeline> Pipeline::create(obj<Device> device, const MeshPipelineCreateInfo& info)
+static void compile_pipeline(DeviceImpl& device_impl, PipelineImpl& impl, const PipelineRecipe& recipe) VERA_NOEXCEPT
+{
+	try {
+		impl.vkPipeline = acquire_vk_pipeline(
+			device_impl,
+			recipe,
+			impl.pipelineKey,
+			impl.shaders,
+			impl.pipelineLayout);
+	} catch (...) {
+		impl.compileError = std::current_exception();
+	}
+
+	device_impl.pipelineCompiler->signal(impl.ready);
+}
+
+static void check_pipeline_info(const DeviceImpl& device_impl, const GraphicsPipelineCreateInfo& info)
+{
+	if (!info.vertexShader)
+		throw Exception("Graphics pipeline must have a vertex shader");
+	if (!info.fragmentShader)
+		throw Exception("Graphics pipeline must have a fragment shader");
+}
+
+static void check_pipeline_info(const DeviceImpl& device_impl, const MeshPipelineCreateInfo& info)
 {
 	if (!info.meshShader)
 		throw Exception("Mesh pipeline must have a mesh shader");
 	if (!info.fragmentShader)
 		throw Exception("Mesh pipeline must have a fragment shader");
 
-	auto&  device_impl = getImpl(device);
-	size_t hash_value  = hash_pipeline_info(info);
-
-	if (auto cached_obj = device_impl.findCachedObject<Pipeline>(hash_value))
-		return cached_obj;
-
 	if (info.taskShader && !device_impl.isFeatureEnabled(DeviceFeatureType::TaskShader))
 		throw Exception("task shader feature is not enabled on device");
 	if (!device_impl.isFeatureEnabled(DeviceFeatureType::MeshShader))
 		throw Exception("mesh shader feature is not enabled on device");
+}
+
+static void check_pipeline_info(const DeviceImpl& device_impl, const ComputePipelineCreateInfo& info)
+{
+	if (!info.computeShader)
+		throw Exception("Compute pipeline must have a compute shader");
+}
 
+// new_object wraps createNewCoreObject, which is only reachable from Pipeline members
+template <class CreateInfo, class NewObjectFunc>
+static obj<Pipeline> create_pipeline(
+	obj<Device>       device,
+	const CreateInfo& info,
+	obj<Pipeline>     fallback,
+	bool              async,
+	NewObjectFunc&&   new_object
+) {
+	auto& device_impl = CoreObject::getImpl(device);
+
+	check_pipeline_info(device_impl, info);
+
+	// create pipline layout first to check shader stages, the layout is also part of the key
 	auto pipeline_layout = register_pipeline_layout(device, info);
 
-	auto  obj  = createNewCoreObject<Pipeline>();
-	auto& impl = getImpl(obj);
+	std::vector<obj<Shader>> shaders;
+	PipelineRecipe           recipe       = make_pipeline_recipe(device_impl, info, pipeline_layout, shaders);
+	hash128_t                pipeline_key = hash_pipeline_recipe(recipe);
 
-	static_vector<vk::PipelineShaderStageCreateInfo, MAX_SHADER_STAGE_COUNT> shader_infos;
-	fill_shader_info(impl, shader_infos, info);
+	std::unique_lock<std::mutex> lock(device_impl.pipelineCacheMutex);
+	bool                         cacheable;
 
-	vk::PipelineRasterizationStateCreateInfo rs_info;
-	if (info.rasterizationInfo) {
-		fill_rasterizer_state_info(rs_info, *info.rasterizationInfo);
+	// a pipeline requested before is never compiled twice, even if it is still compiling
+	if (auto cached_obj = find_cached_pipeline(device_impl, pipeline_key, cacheable)) {
+		lock.unlock();
+
+		if (!async)
+			cached_obj->waitReady();
+
+		return cached_obj;
+	}
+
+	auto  obj  = new_object();
+	auto& impl = CoreObject::getImpl(obj);
+
+	impl.device            = std::move(device);
+	impl.pipelineLayout    = std::move(pipeline_layout);
+	impl.shaders           = std::move(shaders);
+	impl.fallback          = std::move(fallback);
+	impl.pipelineBindPoint = recipe.bindPoint;
+	impl.pipelineKey       = pipeline_key;
+	impl.hashValue         = pipeline_key.low;
+
+	// a recipe sharing the low half of the key with a cached pipeline is created outside of the
+	// cache, unregistering the hash value in the destructor does not find this object
+	if (cacheable)
+		register_cached_pipeline(device_impl, obj);
+	lock.unlock();
+
+	if (async) {
+		device_impl.pipelineCompiler->enqueue(
+			[&device_impl, &impl, recipe = std::move(recipe)] {
+				compile_pipeline(device_impl, impl, recipe);
+			});
 	} else {
-		fill_rasterizer_state_info(rs_info, RasterizationInfo{});
+		compile_pipeline(device_impl, impl, recipe);
+		obj->waitReady();
+	}
+
+	return obj;
+}
+
+vk::Pipeline create_vk_pipeline(
+	const DeviceImpl&            device_impl,
+	const PipelineRecipe&        recipe,
+	array_view<vk::ShaderModule> modules,
+	vk::PipelineLayout           layout
+) {
+	VERA_ASSERT_MSG(modules.size() == recipe.stages.size(), "shader module count mismatch");
+
+	static_vector<vk::PipelineShaderStageCreateInfo, MAX_SHADER_STAGE_COUNT> shader_infos;
+
+	for (size_t i = 0; i < recipe.stages.size(); ++i) {
+		auto& stage = recipe.stages[i];
+
+		vk::PipelineShaderStageCreateInfo shader_info;
+		shader_info.stage               = to_vk_shader_stage_flag_bits(stage.stage);
+		shader_info.module              = modules[i];
+		shader_info.pName               = stage.entryPoint.c_str();
+		shader_info.pSpecializationInfo = nullptr;
+
+		shader_infos.push_back(shader_info);
+	}
+
+	if (recipe.bindPoint == PipelineBindPoint::Compute) {
+		vk::ComputePipelineCreateInfo pipeline_info;
+		pipeline_info.stage  = shader_infos.front();
+		pipeline_info.layout = layout;
+
+		auto result = device_impl.vkDevice.createComputePipeline(device_impl.vkPipelineCache, pipeline_info);
+
+		if (result.result != vk::Result::eSuccess)
+			throw Exception("failed to create compute pipeline");
+
+		return result.value;
+	}
+
+	std::vector<vk::VertexInputAttributeDescription> vertex_attributes;
+	std::vector<vk::VertexInputBindingDescription>   vertex_binding_descs;
+	uint32_t                                         vertex_location = 0;
+
+	for (const auto& binding_recipe : recipe.vertexBindings) {
+		auto& binding = vertex_binding_descs.emplace_back();
+
+		fill_vertex_input_attributes(
+			vertex_attributes,
+			binding_recipe.binding,
+			static_cast<uint32_t>(binding_recipe.attributes.size()),
+			binding_recipe.attributes.data(),
+			vertex_location);
+
+		binding.binding   = binding_recipe.binding;
+		binding.stride    = binding_recipe.stride;
+		binding.inputRate = binding_recipe.perInstance ?
+			vk::VertexInputRate::eInstance :
+			vk::VertexInputRate::eVertex;
 	}
 
+	vk::PipelineVertexInputStateCreateInfo vi_info;
+	vi_info.vertexBindingDescriptionCount   = static_cast<uint32_t>(vertex_binding_descs.size());
+	vi_info.pVertexBindingDescriptions      = vertex_binding_descs.data();
+	vi_info.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertex_attributes.size());
+	vi_info.pVertexAttributeDescriptions    = vertex_attributes.data();
+
+	vk::PipelineInputAssemblyStateCreateInfo ia_info;
+	fill_primitive_state_info(ia_info, recipe.primitive);
+
+	vk::PipelineTessellationStateCreateInfo ts_info;
+	fill_tessellation_state_info(ts_info, recipe.patchControlPoints);
+
+	vk::PipelineRasterizationStateCreateInfo rs_info;
+	fill_rasterizer_state_info(rs_info, recipe.rasterization);
+
 	vk::PipelineMultisampleStateCreateInfo ms_info;
 	ms_info.rasterizationSamples  = vk::SampleCountFlagBits::e1;
 	ms_info.sampleShadingEnable   = false;
@@ -676,57 +709,49 @@ obj<Pipeline> Pipeline::create(obj<Device> device, const MeshPipelineCreateInfo&
 	ms_info.alphaToOneEnable      = false;
 
 	vk::PipelineDepthStencilStateCreateInfo ds_info;
-	if (info.depthStencilInfo) {
-		fill_depth_stencil_state_info(ds_info, *info.depthStencilInfo);
-	} else {
-		fill_depth_stencil_state_info(ds_info, DepthStencilInfo{});
-	}
+	fill_depth_stencil_state_info(ds_info, recipe.depthStencil);
 
 	vk::PipelineColorBlendStateCreateInfo cb_info;
-	if (info.colorBlendInfo) {
-		fill_color_blend_state_info(cb_info, *info.colorBlendInfo);
-	} else {
-		fill_color_blend_state_info(cb_info, ColorBlendInfo{});
-	}
+	fill_color_blend_state_info(cb_info, recipe.colorBlend);
+
+	static_vector<vk::DynamicState, 64> dynamic_states = {
+		// viewport
+		vk::DynamicState::eViewport,
+		vk::DynamicState::eScissor
+	};
 
-	static_vector<vk::DynamicState, 64> dynamic_states;
-	fill_dynamic_states(dynamic_states, info);
+	for (const auto ds : recipe.dynamicStates)
+		dynamic_states.push_back(to_vk_dynamic_state(ds));
 
 	vk::PipelineDynamicStateCreateInfo dynamic_info;
 	dynamic_info.dynamicStateCount = static_cast<uint32_t>(dynamic_states.size());
 	dynamic_info.pDynamicStates    = dynamic_states.data();
 
 	static_vector<vk::Format, 32> vk_color_formats;
-	for (const auto& format : info.colorAttachmentFormats) {
-		vk_color_formats.push_back(format == Format::Unknown ?
-								   to_vk_format(device_impl.colorFormat) :
-								   to_vk_format(format));
-	}
+	for (const auto& format : recipe.colorFormats)
+		vk_color_formats.push_back(to_vk_format(format));
 
 	vk::PipelineRenderingCreateInfoKHR rendering_info;
 	rendering_info.colorAttachmentCount    = static_cast<uint32_t>(vk_color_formats.size());
 	rendering_info.pColorAttachmentFormats = vk_color_formats.data();
-
-	if (info.depthStencilInfo) {
-		rendering_info.depthAttachmentFormat   =
-			to_vk_format(static_cast<Format>(info.depthStencilInfo->depthFormat));
-		rendering_info.stencilAttachmentFormat =
-			to_vk_format(static_cast<Format>(info.depthStencilInfo->stencilFormat));
-	} else {
-		rendering_info.depthAttachmentFormat   = vk::Format::eUndefined; 
-		rendering_info.stencilAttachmentFormat = vk::Format::eUndefined;
-	}
+	rendering_info.depthAttachmentFormat   =
+		to_vk_format(static_cast<Format>(recipe.depthStencil.depthFormat));
+	rendering_info.stencilAttachmentFormat =
+		to_vk_format(static_cast<Format>(recipe.depthStencil.stencilFormat));
 
 	vk::GraphicsPipelineCreateInfo pipeline_info;
 	pipeline_info.stageCount          = static_cast<uint32_t>(shader_infos.size());
 	pipeline_info.pStages             = shader_infos.data();
+	pipeline_info.pVertexInputState   = recipe.hasVertexInput ? &vi_info : nullptr;
+	pipeline_info.pInputAssemblyState = recipe.hasVertexInput ? &ia_info : nullptr;
+	pipeline_info.pTessellationState  = recipe.hasVertexInput ? &ts_info : nullptr;
 	pipeline_info.pViewportState      = get_default_viewport_state_info();
 	pipeline_info.pRasterizationState = &rs_info;
 	pipeline_info.pMultisampleState   = &ms_info;
 	pipeline_info.pDepthStencilState  = &ds_info;
 	pipeline_info.pColorBlendState    = &cb_info;
 	pipeline_info.pDynamicState       = &dynamic_info;
-	pipeline_info.layout              = get_vk_pipeline_layout(pipeline_layout);
+	pipeline_info.layout              = layout;
 	pipeline_info.renderPass          = nullptr;
 	pipeline_info.subpass             = 0;
 	pipeline_info.basePipelineHandle  = nullptr;
@@ -738,59 +763,53 @@ obj<Pipeline> Pipeline::create(obj<Device> device, const MeshPipelineCreateInfo&
 	if (result.result != vk::Result::eSuccess)
 		throw Exception("failed to create graphics pipeline");
 
-	impl.device            = std::move(device);
-	impl.pipelineLayout    = std::move(pipeline_layout);
-	impl.vkPipeline        = result.value;
-	impl.pipelineBindPoint = PipelineBindPoint::Graphics;
-	impl.hashValue         = hash_value;
-
-	device_impl.registerCachedObject<Pipeline>(impl.hashValue, obj);
-
-	return obj;
+	return result.value;
 }
 
-obj<Pipeline> Pipeline::create(obj<Device> device, const ComputePipelineCreateInfo& info)
+const vk::Pipeline& get_vk_pipeline(cref<Pipeline> pipeline) VERA_NOEXCEPT
 {
-	if (!info.computeShader)
-		throw Exception("Compute pipeline must have a compute shader");
-
-	auto&  device_impl = getImpl(device);
-	size_t hash_value  = hash_pipeline_info(info);
-
-	if (auto cached_obj = device_impl.findCachedObject<Pipeline>(hash_value))
-		return cached_obj;
-
-	// create pipline layout first to check shader stages
-	auto pipeline_layout = register_pipeline_layout(device, info);
-	
-	auto  obj         = createNewCoreObject<Pipeline>();
-	auto& impl        = getImpl(obj);
-	auto& shader_impl = getImpl(info.computeShader);
-	// auto* root_node   = get_reflection_root_node(shader_impl.shaderReflection);
+	return CoreObject::getImpl(pipeline).vkPipeline;
+}
 
-	VERA_NOT_IMPLEMENTED;
+vk::Pipeline& get_vk_pipeline(ref<Pipeline> pipeline) VERA_NOEXCEPT
+{
+	return CoreObject::getImpl(pipeline).vkPipeline;
+}
 
-	vk::ComputePipelineCreateInfo pipeline_info;
-	pipeline_info.stage.stage  = vk::ShaderStageFlagBits::eCompute;
-	pipeline_info.stage.module = shader_impl.vkShaderModule;
-	pipeline_info.stage.pName  = "main"; //root_node->getEntryPointName(ShaderStageFlagBits::Compute);
-	pipeline_info.layout       = get_vk_pipeline_layout(pipeline_layout);
+obj<Pipeline> Pipeline::create(obj<Device> device, const GraphicsPipelineCreateInfo& info)
+{
+	return create_pipeline(std::move(device), info, {}, false,
+		[] { return createNewCoreObject<Pipeline>(); });
+}
 
-	auto result = device_impl.vkDevice.createComputePipeline(device_impl.vkPipelineCache, pipeline_info);
+obj<Pipeline> Pipeline::create(obj<Device> device, const MeshPipelineCreateInfo& info)
+{
+	return create_pipeline(std::move(device), info, {}, false,
+		[] { return createNewCoreObject<Pipeline>(); });
+}
 
-	if (result.result != vk::Result::eSuccess)
-		throw Exception("failed to create compute pipeline");
+obj<Pipeline> Pipeline::create(obj<Device> device, const ComputePipelineCreateInfo& info)
+{
+	return create_pipeline(std::move(device), info, {}, false,
+		[] { return createNewCoreObject<Pipeline>(); });
+}
 
-	impl.device            = std::move(device);
-	impl.pipelineLayout    = std::move(pipeline_layout);
-	impl.vkPipeline        = result.value;
-	impl.shaders           = { info.computeShader };
-	impl.pipelineBindPoint = PipelineBindPoint::Compute;
-	impl.hashValue         = hash_value;
+obj<Pipeline> Pipeline::createAsync(obj<Device> device, const GraphicsPipelineCreateInfo& info, obj<Pipeline> fallback)
+{
+	return create_pipeline(std::move(device), info, std::move(fallback), true,
+		[] { return createNewCoreObject<Pipeline>(); });
+}
 
-	device_impl.registerCachedObject<Pipeline>(impl.hashValue, obj);
+obj<Pipeline> Pipeline::createAsync(obj<Device> device, const MeshPipelineCreateInfo& info, obj<Pipeline> fallback)
+{
+	return create_pipeline(std::move(device), info, std::move(fallback), true,
+		[] { return createNewCoreObject<Pipeline>(); });
+}
 
-	return obj;
+obj<Pipeline> Pipeline::createAsync(obj<Device> device, const ComputePipelineCreateInfo& info, obj<Pipeline> fallback)
+{
+	return create_pipeline(std::move(device), info, std::move(fallback), true,
+		[] { return createNewCoreObject<Pipeline>(); });
 }
 
 Pipeline::~Pipeline() VERA_NOEXCEPT
@@ -798,7 +817,11 @@ Pipeline::~Pipeline() VERA_NOEXCEPT
 	auto& impl        = getImpl(this);
 	auto& device_impl = getImpl(impl.device);
 
-	device_impl.unregisterCachedObject<Pipeline>(impl.hashValue);
+	// a queued compile writes into impl, so it has to finish before impl goes away
+	if (!impl.ready.load(std::memory_order_acquire))
+		device_impl.pipelineCompiler->wait(impl.ready);
+
+	unregister_cached_pipeline(device_impl, this, impl.hashValue);
 	device_impl.vkDevice.destroy(impl.vkPipeline);
 
 	destroyObjectImpl(this);
@@ -809,6 +832,29 @@ obj<Device> Pipeline::getDevice() const VERA_NOEXCEPT
 	return getImpl(this).device;
 }
 
+obj<Pipeline> Pipeline::getFallback() const VERA_NOEXCEPT
+{
+	return getImpl(this).fallback;
+}
+
+bool Pipeline::isReady() const VERA_NOEXCEPT
+{
+	auto& impl = getImpl(this);
+
+	return impl.ready.load(std::memory_order_acquire) && !impl.compileError;
+}
+
+void Pipeline::waitReady() const
+{
+	auto& impl = getImpl(this);
+
+	if (!impl.ready.load(std::memory_order_acquire))
+		getImpl(impl.device).pipelineCompiler->wait(impl.ready);
+
+	if (impl.compileError)
+		std::rethrow_exception(impl.compileError);
+}
+
 obj<PipelineLayout> Pipeline::getPipelineLayout() const VERA_NOEXCEPT
 {
 	return getImpl(this).pipelineLayout;
@@ -249,79 +249,77 @@ obj<PipelineLayout> PipelineLayout::create(obj<Device> device, array_view<cref<S
 	auto&  device_impl = getImpl(device);
 	hash_t hash_value  = hash_shader_reflections(shader_reflections);
 
-	if (auto cached_obj = device_impl.findCachedObject<PipelineLayout>(hash_value))
-		return cached_obj;
+	return device_impl.acquireCachedObject<PipelineLayout>(hash_value, [&]() {
+		auto  obj  = createNewCoreObject<PipelineLayout>();
+		auto& impl = getImpl(obj);
 
-	auto  obj  = createNewCoreObject<PipelineLayout>();
-	auto& impl = getImpl(obj);
+		uint32_t set_count = 0;
+		for (auto reflection : shader_reflections)
+			if (auto bindings = reflection->enumerateDescriptorBindings(); !bindings.empty())
+				set_count = std::max(set_count, bindings.back()->set + 1);
 
-	uint32_t set_count = 0;
-	for (auto reflection : shader_reflections)
-		if (auto bindings = reflection->enumerateDescriptorBindings(); !bindings.empty())
-			set_count = std::max(set_count, bindings.back()->set + 1);
+		DescriptorSetLayoutCreateInfo layout_info;
 
-	DescriptorSetLayoutCreateInfo layout_info;
+		for (uint32_t set_id = 0; set_id < set_count; ++set_id) {
+			for (auto reflection : shader_reflections)
+				for (const auto* desc_binding : reflection->enumerateDescriptorBindings(set_id))
+					insert_descriptor_binding_info(layout_info, desc_binding);
 
-	for (uint32_t set_id = 0; set_id < set_count; ++set_id) {
-		for (auto reflection : shader_reflections)
-			for (const auto* desc_binding : reflection->enumerateDescriptorBindings(set_id))
-				insert_descriptor_binding_info(layout_info, desc_binding);
+			impl.descriptorSetLayouts.push_back(
+				DescriptorSetLayout::create(device, layout_info));
 
-		impl.descriptorSetLayouts.push_back(
-			DescriptorSetLayout::create(device, layout_info));
-
-		layout_info.flags = {};
-		layout_info.bindings.clear();
-	}
+			layout_info.flags = {};
+			layout_info.bindings.clear();
+		}
 
-	for (auto reflection : shader_reflections) {
-		if (const auto* pc_block = reflection->getPushConstantBlock()) {
-			auto& pc_range = impl.pushConstantRanges.emplace_back();
-			pc_range.offset     = pc_block->offset;
-			pc_range.size       = pc_block->size;
-			pc_range.stageFlags = pc_block->stageFlags;
+		for (auto reflection : shader_reflections) {
+			if (const auto* pc_block = reflection->getPushConstantBlock()) {
+				auto& pc_range = impl.pushConstantRanges.emplace_back();
+				pc_range.offset     = pc_block->offset;
+				pc_range.size       = pc_block->size;
+				pc_range.stageFlags = pc_block->stageFlags;
+			}
 		}
-	}
 
-	if (!impl.pushConstantRanges.empty()) {
-		std::sort(VERA_SPAN(impl.pushConstantRanges), sort_by_offset);
-
-		// Merge overlapping push constant ranges inplace
-		auto src_it = impl.pushConstantRanges.begin();
-		auto dst_it = impl.pushConstantRanges.begin();
-
-		while (src_it != impl.pushConstantRanges.end()) {
-			auto& dst_range = *dst_it;
-			auto& src_range = *src_it;
-
-			if (dst_it != src_it && src_range.offset < dst_range.offset + dst_range.size) {
-				auto end_offset = std::max(
-					dst_range.offset + dst_range.size,
-					src_range.offset + src_range.size);
-
-				dst_range.size        = end_offset - dst_range.offset;
-				dst_range.stageFlags |= src_range.stageFlags;
-			} else {
-				if (dst_it != src_it)
-					*(++dst_it) = src_range;
-				else
-					++dst_it;
+		if (!impl.pushConstantRanges.empty()) {
+			std::sort(VERA_SPAN(impl.pushConstantRanges), sort_by_offset);
+
+			// Merge overlapping push constant ranges inplace
+			auto src_it = impl.pushConstantRanges.begin();
+			auto dst_it = impl.pushConstantRanges.begin();
+
+			while (src_it != impl.pushConstantRanges.end()) {
+				auto& dst_range = *dst_it;
+				auto& src_range = *src_it;
+
+				if (dst_it != src_it && src_range.offset < dst_range.offset + dst_range.size) {
+					auto end_offset = std::max(
+						dst_range.offset + dst_range.size,
+						src_range.offset + src_range.size);
+
+					dst_range.size        = end_offset - dst_range.offset;
+					dst_range.stageFlags |= src_range.stageFlags;
+				} else {
+					if (dst_it != src_it)
+						*(++dst_it) = src_range;
+					else
+						++dst_it;
+				}
+				++src_it;
 			}
-			++src_it;
 		}
-	}
 
-	impl.device                 = std::move(device);
-	impl.hashValue              = hash_pipeline_layout(impl.descriptorSetLayouts, impl.pushConstantRanges);
-	impl.hashValueByReflections = hash_value;
-	impl.hashValueByShaders     = 0;
+		impl.device                 = std::move(device);
+		impl.hashValue              = hash_pipeline_layout(impl.descriptorSetLayouts, impl.pushConstantRanges);
+		impl.hashValueByReflections = hash_value;
+		impl.hashValueByShaders     = 0;
 
-	create_pipeline_layout(device_impl, impl);
+		create_pipeline_layout(device_impl, impl);
 
-	device_impl.registerCachedObject<PipelineLayout>(impl.hashValue, obj);
-	device_impl.registerCachedObject<PipelineLayout>(impl.hashValueByReflections, obj);
+		device_impl.registerCachedObject<PipelineLayout>(impl.hashValue, obj);
 
-	return obj;
+		return obj;
+	});
 }
 
 obj<PipelineLayout> PipelineLayout::create(obj<Device> device, const PipelineLayoutCreateInfo& info)
@@ -334,25 +332,22 @@ obj<PipelineLayout> PipelineLayout::create(obj<Device> device, const PipelineLay
 	auto&  device_impl = getImpl(device);
 	hash_t hash_value  = hash_pipeline_layout(info.descriptorSetLayouts, info.pushConstantRanges);
 
-	if (auto cached_obj = device_impl.findCachedObject<PipelineLayout>(hash_value))
-		return cached_obj;
+	return device_impl.acquireCachedObject<PipelineLayout>(hash_value, [&]() {
+		auto  obj  = createNewCoreObject<PipelineLayout>();
+		auto& impl = getImpl(obj);
 
-	auto  obj  = createNewCoreObject<PipelineLayout>();
-	auto& impl = getImpl(obj);
-
-	impl.descriptorSetLayouts.assign(info.descriptorSetLayouts.begin(), info.descriptorSetLayouts.end());
-	impl.pushConstantRanges.assign(info.pushConstantRanges.begin(), info.pushConstantRanges.end());
+		impl.descriptorSetLayouts.assign(info.descriptorSetLayouts.begin(), info.descriptorSetLayouts.end());
+		impl.pushConstantRanges.assign(info.pushConstantRanges.begin(), info.pushConstantRanges.end());
 
-	impl.device                 = std::move(device);
-	impl.hashValue              = hash_value;
-	impl.hashValueByReflections = 0;
-	impl.hashValueByShaders     = 0;
+		impl.device                 = std::move(device);
+		impl.hashValue              = hash_value;
+		impl.hashValueByReflections = 0;
+		impl.hashValueByShaders     = 0;
 
-	create_pipeline_layout(device_impl, impl);
-	
-	device_impl.registerCachedObject<PipelineLayout>(impl.hashValue, obj);
+		create_pipeline_layout(device_impl, impl);
 
-	return obj;
+		return obj;
+	});
 }
 
 //obj<PipelineLayout> PipelineLayout::create(
@@ -394,11 +389,11 @@ PipelineLayout::~PipelineLayout() VERA_NOEXCEPT
 	auto& impl        = getImpl(this);
 	auto& device_impl = getImpl(impl.device);
 
-	device_impl.unregisterCachedObject<PipelineLayout>(impl.hashValue);
+	device_impl.unregisterCachedObject<PipelineLayout>(impl.hashValue, this);
 	if (impl.hashValueByShaders)
-		device_impl.unregisterCachedObject<PipelineLayout>(impl.hashValueByShaders);
+		device_impl.unregisterCachedObject<PipelineLayout>(impl.hashValueByShaders, this);
 	if (impl.hashValueByReflections)
-		device_impl.unregisterCachedObject<PipelineLayout>(impl.hashValueByReflections);
+		device_impl.unregisterCachedObject<PipelineLayout>(impl.hashValueByReflections, this);
 
 	device_impl.vkDevice.destroy(impl.vkPipelineLayout);
 
@@ -79,12 +79,26 @@ static std::string_view copy_string(
 static hash_t hash_shader_reflections(
 	array_view<obj<ShaderReflection>> shader_reflections
 ) {
-	hash_t seed = 0;
+	static_vector<hash128_t, MAX_SHADER_STAGE_COUNT> code_keys;
 
 	for (const auto& shader_reflection : shader_reflections)
-		hash_combine(seed, shader_reflection->hash());
+		code_keys.push_back(CoreObject::getImpl(shader_reflection).codeKey);
 
-	return seed;
+	return hash_bytes_128(code_keys.data(), code_keys.size() * sizeof(hash128_t)).low;
+}
+
+static bool has_same_reflections(
+	const ProgramReflectionImpl&      impl,
+	array_view<obj<ShaderReflection>> shader_reflections
+) {
+	if (impl.shaderReflections.size() != shader_reflections.size())
+		return false;
+
+	for (size_t i = 0; i < shader_reflections.size(); ++i)
+		if (impl.shaderReflections[i] != shader_reflections[i])
+			return false;
+
+	return true;
 }
 
 obj<ProgramReflection> ProgramReflection::create(obj<Device> device, obj<Pipeline> pipeline)
@@ -104,46 +118,51 @@ obj<ProgramReflection> ProgramReflection::create(
 	auto& device_impl = getImpl(device);
 	auto  hash_value  = hash_shader_reflections(shader_reflections);
 
-	if (auto cached_obj = device_impl.findCachedObject<ProgramReflection>(hash_value))
-		return cached_obj;
-
-	auto  obj  = createNewCoreObject<ProgramReflection>();
-	auto& impl = getImpl(obj);
+	auto create_program = [&]() {
+		auto  obj  = createNewCoreObject<ProgramReflection>();
+		auto& impl = getImpl(obj);
 
-	PerStageReflectionRootNodeArray root_nodes;
-	ShaderStageFlags                stage_flags;
+		PerStageReflectionRootNodeArray root_nodes;
+		ShaderStageFlags                stage_flags;
 
-	auto*    entry_points     = allocate<ReflectionEntryPoint>(impl, shader_reflections.size());
-	uint32_t entry_point_idx  = 0;
-	auto     reflection_crefs = array_view(
-		reinterpret_cast<const cref<ShaderReflection>*>(shader_reflections.data()),
-		shader_reflections.size());
+		auto*    entry_points     = allocate<ReflectionEntryPoint>(impl, shader_reflections.size());
+		uint32_t entry_point_idx  = 0;
+		auto     reflection_crefs = array_view(
+			reinterpret_cast<const cref<ShaderReflection>*>(shader_reflections.data()),
+			shader_reflections.size());
 
-	for (auto& shader_reflections : shader_reflections) {
-		const auto& refl_impl = getImpl(shader_reflections);
+		for (auto& shader_reflections : shader_reflections) {
+			const auto& refl_impl = getImpl(shader_reflections);
 
-		if (stage_flags.has(refl_impl.stageFlags))
-			throw Exception("duplicate shader stage in program reflection");
-		stage_flags |= refl_impl.stageFlags;
+			if (stage_flags.has(refl_impl.stageFlags))
+				throw Exception("duplicate shader stage in program reflection");
+			stage_flags |= refl_impl.stageFlags;
 
-		root_nodes.push_back(refl_impl.rootNode);
-		entry_points[entry_point_idx].stageFlags = refl_impl.stageFlags;
-		entry_points[entry_point_idx].name       = copy_string(impl, refl_impl.entryPointName.data());
-		entry_point_idx++;
-	}
+			root_nodes.push_back(refl_impl.rootNode);
+			entry_points[entry_point_idx].stageFlags = refl_impl.stageFlags;
+			entry_points[entry_point_idx].name       = copy_string(impl, refl_impl.entryPointName.data());
+			entry_point_idx++;
+		}
 	
-	impl.device            = std::move(device);
-	impl.pipelineLayout    = PipelineLayout::create(impl.device, reflection_crefs);
-	impl.shaderReflections.assign(VERA_SPAN(shader_reflections));
-	impl.shaderStageFlags  = stage_flags;
-	impl.pipelineBindPoint = get_pipeline_bind_point(stage_flags);
-	impl.entryPoints       = array_view{ entry_points, entry_point_idx };
-	impl.rootNode          = ReflectionRootNode::merge(root_nodes, &impl.memory);
-	impl.hashValue         = hash_value;
+		impl.device            = device;
+		impl.pipelineLayout    = PipelineLayout::create(impl.device, reflection_crefs);
+		impl.shaderReflections.assign(VERA_SPAN(shader_reflections));
+		impl.shaderStageFlags  = stage_flags;
+		impl.pipelineBindPoint = get_pipeline_bind_point(stage_flags);
+		impl.entryPoints       = array_view{ entry_points, entry_point_idx };
+		impl.rootNode          = ReflectionRootNode::merge(root_nodes, &impl.memory);
+		impl.hashValue         = hash_value;
+
+		return obj;
+	};
+
+	auto program = device_impl.acquireCachedObject<ProgramReflection>(hash_value, create_program);
 
-	device_impl.registerCachedObject<ProgramReflection>(hash_value, obj);
+	// another set of shaders with the same hash value keeps the cache entry
+	if (!has_same_reflections(getImpl(program), shader_reflections))
+		return create_program();
 
-	return obj;
+	return program;
 }
 
 ProgramReflection::~ProgramReflection() VERA_NOEXCEPT
@@ -151,7 +170,7 @@ ProgramReflection::~ProgramReflection() VERA_NOEXCEPT
 	auto& impl        = getImpl(this);
 	auto& device_impl = getImpl(impl.device);
 
-	device_impl.unregisterCachedObject<ProgramReflection>(impl.hashValue);
+	device_impl.unregisterCachedObject<ProgramReflection>(impl.hashValue, this);
 
 	destroyObjectImpl(this);
 }
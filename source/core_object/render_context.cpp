@@ -20,21 +20,30 @@ VERA_NAMESPACE_BEGIN
 static void append_render_frame(RenderContextImpl& impl, uint32_t at, uint64_t id)
 {
 	auto& render_frame = *impl.renderFrames.emplace(impl.renderFrames.cbegin() + at);
+	auto& device_impl  = CoreObject::getImpl(impl.device);
 
 	render_frame.commandBuffer = CommandBuffer::create(impl.device);
 	render_frame.sync          = {};
 	render_frame.frameID       = id;
 	render_frame.framebuffers  = {};
+	render_frame.poolFrameKey  = device_impl.commandPoolManager->beginFrame();
 
 	render_frame.commandBuffer->begin();
 }
 
 static void reset_render_frame(RenderContextImpl& impl, RenderContextFrame& render_frame, uint64_t id)
 {
+	auto& device_impl = CoreObject::getImpl(impl.device);
+
+	// frames appended ahead of their first use still hold the key they were created with
+	if (render_frame.poolFrameKey != 0)
+		device_impl.commandPoolManager->retireFrame(render_frame.poolFrameKey, {});
+
 	render_frame.commandBuffer->reset();
 	render_frame.framebuffers.clear();
-	render_frame.sync    = {};
-	render_frame.frameID = id;
+	render_frame.sync         = {};
+	render_frame.frameID      = id;
+	render_frame.poolFrameKey = device_impl.commandPoolManager->beginFrame();
 
 	render_frame.commandBuffer->begin();
 }
@@ -49,6 +58,10 @@ static void render_context_next_frame(RenderContextImpl& impl)
 	curr_frame.sync = curr_frame.commandBuffer->getSync();
 	impl.currentFrameID++;
 
+	// secondary command buffers of the frame are recycled once its primary completes
+	CoreObject::getImpl(impl.device).commandPoolManager->retireFrame(curr_frame.poolFrameKey, curr_frame.sync);
+	curr_frame.poolFrameKey = 0;
+
 	if (next_idx != impl.frameIndex && (next_sync.empty() || next_sync.isComplete())) {
 		reset_render_frame(impl, next_frame, impl.currentFrameID);
 		impl.frameIndex = next_idx;
@@ -68,6 +81,40 @@ static RenderContextFrame& get_current_frame(RenderContextImpl& impl)
 	return impl.renderFrames[impl.frameIndex];
 }
 
+static void track_frame_buffers(RenderContextImpl& impl, const RenderingInfo& info)
+{
+	auto& render_frame = get_current_frame(impl);
+	auto& cmd          = render_frame.commandBuffer;
+
+	// TODO: verify image layout transition
+	for (auto& color : info.colorAttachments) {
+		auto& texture_impl = CoreObject::getImpl(color.texture);
+
+		// Identify swapchain image and save for future use
+		if (texture_impl.textureUsage.has(TextureUsageFlagBits::FrameBuffer)) {
+			// TODO: optimize
+			if (std::none_of(VERA_SPAN(render_frame.framebuffers),
+				[=](const auto& elem) {
+					return elem == texture_impl.frameBuffer;
+				})) {
+				auto& framebuffer_impl = CoreObject::getImpl(texture_impl.frameBuffer);
+				
+				render_frame.framebuffers.push_back(texture_impl.frameBuffer);
+				framebuffer_impl.commandSync = render_frame.commandBuffer->getSync();
+
+				cmd->transitionImageLayout(
+					color.texture,
+					vr::PipelineStageFlagBits::ColorAttachmentOutput,
+					vr::PipelineStageFlagBits::ColorAttachmentOutput,
+					vr::AccessFlagBits{},
+					vr::AccessFlagBits::ColorAttachmentWrite,
+					vr::TextureLayout::Undefined,
+					vr::TextureLayout::ColorAttachmentOptimal);
+			}
+		}
+	}
+}
+
 obj<RenderContext> RenderContext::create(obj<Device> device, const RenderContextCreateInfo& info)
 {
 	auto  obj  = createNewCoreObject<RenderContext>();
@@ -86,7 +133,13 @@ obj<RenderContext> RenderContext::create(obj<Device> device, const RenderContext
 
 RenderContext::~RenderContext() VERA_NOEXCEPT
 {
-	auto& impl = getImpl(this);
+	auto& impl        = getImpl(this);
+	auto& device_impl = getImpl(impl.device);
+
+	// frames still holding a key were never submitted, the one being recorded or unused ones
+	for (auto& render_frame : impl.renderFrames)
+		if (render_frame.poolFrameKey != 0)
+			device_impl.commandPoolManager->retireFrame(render_frame.poolFrameKey, {});
 
 	destroyObjectImpl(this);
 }
@@ -162,35 +215,7 @@ void RenderContext::draw(const GraphicsState& states, uint32_t vtx_count, uint32
 	auto& impl = getImpl(this);
 	auto& cmd  = get_current_frame(impl).commandBuffer;
 
-	// TODO: verify image layout transition
-	for (auto& color : states.getRenderingInfo().colorAttachments) {
-		auto& texture_impl = getImpl(color.texture);
-
-		// Identify swapchain image and save for future use
-		if (texture_impl.textureUsage.has(TextureUsageFlagBits::FrameBuffer)) {
-			auto& render_frame = impl.renderFrames[impl.frameIndex];
-
-			// TODO: optimize
-			if (std::none_of(VERA_SPAN(render_frame.framebuffers),
-				[=](const auto& elem) {
-					return elem == texture_impl.frameBuffer;
-				})) {
-				auto& framebuffer_impl = getImpl(texture_impl.frameBuffer);
-				
-				render_frame.framebuffers.push_back(texture_impl.frameBuffer);
-				framebuffer_impl.commandSync = render_frame.commandBuffer->getSync();
-
-				cmd->transitionImageLayout(
-					color.texture,
-					vr::PipelineStageFlagBits::ColorAttachmentOutput,
-					vr::PipelineStageFlagBits::ColorAttachmentOutput,
-					vr::AccessFlagBits{},
-					vr::AccessFlagBits::ColorAttachmentWrite,
-					vr::TextureLayout::Undefined,
-					vr::TextureLayout::ColorAttachmentOptimal);
-			}
-		}
-	}
+	track_frame_buffers(impl, states.getRenderingInfo());
 
 	cmd->bindGraphicsState(states);
 
@@ -206,35 +231,7 @@ void RenderContext::draw(
 	auto& impl = getImpl(this);
 	auto& cmd  = get_current_frame(impl).commandBuffer;
 
-	// TODO: verify image layout transition
-	for (auto& color : states.getRenderingInfo().colorAttachments) {
-		auto& texture_impl = getImpl(color.texture);
-
-		// Identify swapchain image and save for future use
-		if (texture_impl.textureUsage.has(TextureUsageFlagBits::FrameBuffer)) {
-			auto& render_frame = impl.renderFrames[impl.frameIndex];
-
-			// TODO: optimize
-			if (std::none_of(VERA_SPAN(render_frame.framebuffers),
-				[=](const auto& elem) {
-					return elem == texture_impl.frameBuffer;
-				})) {
-				auto& framebuffer_impl = getImpl(texture_impl.frameBuffer);
-				
-				render_frame.framebuffers.push_back(texture_impl.frameBuffer);
-				framebuffer_impl.commandSync = render_frame.commandBuffer->getSync();
-
-				cmd->transitionImageLayout(
-					color.texture,
-					vr::PipelineStageFlagBits::ColorAttachmentOutput,
-					vr::PipelineStageFlagBits::ColorAttachmentOutput,
-					vr::AccessFlagBits{},
-					vr::AccessFlagBits::ColorAttachmentWrite,
-					vr::TextureLayout::Undefined,
-					vr::TextureLayout::ColorAttachmentOptimal);
-			}
-		}
-	}
+	track_frame_buffers(impl, states.getRenderingInfo());
 
 	cmd->bindGraphicsState(states);
 	cmd->bindShaderParameter(param);
@@ -252,40 +249,47 @@ void RenderContext::drawIndexed(
 	auto& impl = getImpl(this);
 	auto& cmd  = get_current_frame(impl).commandBuffer;
 
-	// TODO: verify image layout transition
-	for (auto& color : states.getRenderingInfo().colorAttachments) {
-		auto& texture_impl = getImpl(color.texture);
+	track_frame_buffers(impl, states.getRenderingInfo());
 
-		// Identify swapchain image and save for future use
-		if (texture_impl.textureUsage.has(TextureUsageFlagBits::FrameBuffer)) {
-			auto& render_frame = impl.renderFrames[impl.frameIndex];
+	cmd->bindGraphicsState(states);
+	cmd->bindShaderParameter(param);
 
-			// TODO: optimize
-			if (std::none_of(VERA_SPAN(render_frame.framebuffers),
-				[=](const auto& elem) {
-					return elem == texture_impl.frameBuffer;
-				})) {
-				auto& framebuffer_impl = getImpl(texture_impl.frameBuffer);
-				
-				render_frame.framebuffers.push_back(texture_impl.frameBuffer);
-				framebuffer_impl.commandSync = render_frame.commandBuffer->getSync();
+	cmd->drawIndexed(idx_count, 1, idx_off, vtx_off, 0);
+}
 
-				cmd->transitionImageLayout(
-					color.texture,
-					vr::PipelineStageFlagBits::ColorAttachmentOutput,
-					vr::PipelineStageFlagBits::ColorAttachmentOutput,
-					vr::AccessFlagBits{},
-					vr::AccessFlagBits::ColorAttachmentWrite,
-					vr::TextureLayout::Undefined,
-					vr::TextureLayout::ColorAttachmentOptimal);
-			}
-		}
-	}
+void RenderContext::drawIndexedIndirect(
+	const GraphicsState& states,
+	obj<ShaderParameter> param,
+	cref<Buffer>         buffer,
+	size_t               offset,
+	uint32_t             draw_count
+) {
+	auto& impl = getImpl(this);
+	auto& cmd  = get_current_frame(impl).commandBuffer;
+
+	track_frame_buffers(impl, states.getRenderingInfo());
 
 	cmd->bindGraphicsState(states);
 	cmd->bindShaderParameter(param);
 
-	cmd->drawIndexed(idx_count, 1, idx_off, vtx_off, 0);
+	cmd->drawIndexedIndirect(buffer, offset, draw_count);
+}
+
+void RenderContext::executeCommands(const RenderingInfo& info, array_view<obj<CommandBuffer>> cmd_buffers)
+{
+	auto& impl     = getImpl(this);
+	auto& cmd      = get_current_frame(impl).commandBuffer;
+	auto& cmd_impl = getImpl(cmd);
+
+	if (!cmd_impl.currentRenderingInfo.colorAttachments.empty())
+		cmd->endRendering();
+
+	track_frame_buffers(impl, info);
+
+	// a render pass instance holding secondary command buffers cannot record draws inline
+	cmd->beginRendering(info, RenderingContents::SecondaryCommandBuffers);
+	cmd->executeCommands(cmd_buffers);
+	cmd->endRendering();
 }
 
 void RenderContext::submit(const SubmitInfo& info)
@@ -59,51 +59,48 @@ obj<Sampler> Sampler::create(obj<Device> device, const SamplerCreateInfo& info)
 	auto&  device_impl = getImpl(device);
 	size_t hash_value  = hash_sampler(info);
 
-	if (auto cached_obj = device_impl.findCachedObject<Sampler>(hash_value))
-		return cached_obj;
-
-	auto   obj         = createNewCoreObject<Sampler>();
-	auto&  impl        = getImpl(obj);
-	bool   need_border = false;
-
-	vk::SamplerCreateInfo sampler_info;
-	sampler_info.magFilter               = to_vk_filter(info.magFilter);
-	sampler_info.minFilter               = to_vk_filter(info.minFilter);
-	sampler_info.mipmapMode              = to_vk_sampler_mipmap_mode(info.mipmapMode);
-	sampler_info.addressModeU            = to_vk_sampler_address_mode(info.addressModeU);
-	sampler_info.addressModeV            = to_vk_sampler_address_mode(info.addressModeV);
-	sampler_info.addressModeW            = to_vk_sampler_address_mode(info.addressModeW);
-	sampler_info.mipLodBias              = info.mipLodBias;
-	sampler_info.anisotropyEnable        = info.anisotropyEnable;
-	sampler_info.maxAnisotropy           = info.maxAnisotropy;
-	sampler_info.compareEnable           = info.compareEnable;
-	sampler_info.compareOp               = to_vk_compare_op(info.compareOp);
-	sampler_info.minLod                  = info.minLod;
-	sampler_info.maxLod                  = info.maxLod;
-	sampler_info.borderColor             = get_border_color(info.borderColor, need_border);
-	sampler_info.unnormalizedCoordinates = info.unnormalizedCoordinates;
-
-	vk::SamplerCustomBorderColorCreateInfoEXT border_info;
-	if (need_border) {
-		sampler_info.pNext = &border_info;
-
-		border_info.customBorderColor.float32 = std::array<float, 4>{
-			info.borderColor.r / 255.f,
-			info.borderColor.g / 255.f,
-			info.borderColor.b / 255.f,
-			info.borderColor.a / 255.f
-		};
-		border_info.format = vk::Format::eR8G8B8A8Unorm;
-	}
-
-	impl.device    = std::move(device);
-	impl.vkSampler = device_impl.vkDevice.createSampler(sampler_info);
-	impl.hashValue = hash_value;
-	impl.info      = info;
-
-	device_impl.registerCachedObject<Sampler>(impl.hashValue, obj);
-	
-	return obj;
+	return device_impl.acquireCachedObject<Sampler>(hash_value, [&]() {
+		auto   obj         = createNewCoreObject<Sampler>();
+		auto&  impl        = getImpl(obj);
+		bool   need_border = false;
+
+		vk::SamplerCreateInfo sampler_info;
+		sampler_info.magFilter               = to_vk_filter(info.magFilter);
+		sampler_info.minFilter               = to_vk_filter(info.minFilter);
+		sampler_info.mipmapMode              = to_vk_sampler_mipmap_mode(info.mipmapMode);
+		sampler_info.addressModeU            = to_vk_sampler_address_mode(info.addressModeU);
+		sampler_info.addressModeV            = to_vk_sampler_address_mode(info.addressModeV);
+		sampler_info.addressModeW            = to_vk_sampler_address_mode(info.addressModeW);
+		sampler_info.mipLodBias              = info.mipLodBias;
+		sampler_info.anisotropyEnable        = info.anisotropyEnable;
+		sampler_info.maxAnisotropy           = info.maxAnisotropy;
+		sampler_info.compareEnable           = info.compareEnable;
+		sampler_info.compareOp               = to_vk_compare_op(info.compareOp);
+		sampler_info.minLod                  = info.minLod;
+		sampler_info.maxLod                  = info.maxLod;
+		sampler_info.borderColor             = get_border_color(info.borderColor, need_border);
+		sampler_info.unnormalizedCoordinates = info.unnormalizedCoordinates;
+
+		vk::SamplerCustomBorderColorCreateInfoEXT border_info;
+		if (need_border) {
+			sampler_info.pNext = &border_info;
+
+			border_info.customBorderColor.float32 = std::array<float, 4>{
+				info.borderColor.r / 255.f,
+				info.borderColor.g / 255.f,
+				info.borderColor.b / 255.f,
+				info.borderColor.a / 255.f
+			};
+			border_info.format = vk::Format::eR8G8B8A8Unorm;
+		}
+
+		impl.device    = std::move(device);
+		impl.vkSampler = device_impl.vkDevice.createSampler(sampler_info);
+		impl.hashValue = hash_value;
+		impl.info      = info;
+
+		return obj;
+	});
 }
 
 Sampler::~Sampler() VERA_NOEXCEPT
@@ -111,7 +108,7 @@ Sampler::~Sampler() VERA_NOEXCEPT
 	auto& impl        = getImpl(this);
 	auto& device_impl = getImpl(impl.device);
 	
-	device_impl.unregisterCachedObject<Sampler>(impl.hashValue);
+	device_impl.unregisterCachedObject<Sampler>(impl.hashValue, this);
 	device_impl.vkDevice.destroy(impl.vkSampler);
 	
 	destroyObjectImpl(this);
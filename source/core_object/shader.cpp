@@ -7,126 +7,49 @@
 #include "../../include/vera/core/pipeline_layout.h"
 #include "../../include/vera/core/descriptor_set_layout.h"
 #include "../../include/vera/util/hash.h"
-#include "../spirv/spirv_reflect.h"
-#include <spirv_cross/spirv_cross.hpp>
+#include "../util/parallel_for.h"
+#include <exception>
+#include <cstring>
 #include <fstream>
 #include <chrono>
 
-VERA_NAMESPACE_BEGIN
-
-struct EntryPoint
-{
-	ShaderStageFlags stageFlag;
-	std::string_view name;
-};
-
-static ShaderStageFlags get_shader_stage_flag(spv::ExecutionModel exec_model)
-{
-	switch (exec_model) {
-	case spv::ExecutionModelVertex:
-		return ShaderStageFlagBits::Vertex;
-	case spv::ExecutionModelTessellationControl:
-		return ShaderStageFlagBits::TessellationControl;
-	case spv::ExecutionModelTessellationEvaluation:
-		return ShaderStageFlagBits::TessellationEvaluation;
-	case spv::ExecutionModelGeometry:
-		return ShaderStageFlagBits::Geometry;
-	case spv::ExecutionModelFragment:
-		return ShaderStageFlagBits::Fragment;
-	case spv::ExecutionModelGLCompute:
-		return ShaderStageFlagBits::Compute;
-	case spv::ExecutionModelTaskNV:
-	case spv::ExecutionModelTaskEXT:
-		return ShaderStageFlagBits::Task;
-	case spv::ExecutionModelMeshNV:
-	case spv::ExecutionModelMeshEXT:
-		return ShaderStageFlagBits::Mesh;
-	case spv::ExecutionModelRayGenerationKHR:
-		return ShaderStageFlagBits::RayGen;
-	case spv::ExecutionModelIntersectionKHR:
-		return ShaderStageFlagBits::Intersection;
-	case spv::ExecutionModelAnyHitKHR:
-		return ShaderStageFlagBits::AnyHit;
-	case spv::ExecutionModelClosestHitKHR:
-		return ShaderStageFlagBits::ClosestHit;
-	case spv::ExecutionModelMissKHR:
-		return ShaderStageFlagBits::Miss;
-	case spv::ExecutionModelCallableKHR:
-		return ShaderStageFlagBits::Callable;
-	default:
-		throw Exception("unsupported shader execution model");
-	}
-}
-
-static EntryPoint parse_entry_point(array_view<uint32_t> spirv_code)
-{
-	EntryPoint result;
-
-	if (spirv_code[0] != spv::MagicNumber)
-		throw Exception("invalid SPIR-V magic number");
-
-	uint32_t word_count = static_cast<uint32_t>(spirv_code.size());
-	uint32_t word_idx   = 5; // Skip header
+#define SHADERS_PER_TASK 4
 
-	while (word_idx < word_count) {
-		const uint32_t* inst = &spirv_code[word_idx];
-		uint32_t        len  = (*inst) >> 16;
-		spv::Op         op   = static_cast<spv::Op>((*inst) & 0xFFFF);
-
-		if (op == spv::OpEntryPoint) {
-			auto        exec_model       = static_cast<spv::ExecutionModel>(inst[1]);
-			const auto* entry_point_name = reinterpret_cast<const char*>(&inst[3]);
-
-			if (entry_point_name == nullptr)
-				throw Exception("failed to find entry point name in SPIR-V code");
-
-			result.stageFlag = get_shader_stage_flag(exec_model);
-			result.name      = std::string_view(entry_point_name);
-
-			return result;
-		}
-
-		if (len == 0)
-			throw Exception("invalid SPIR-V instruction length");
-
-		word_idx += len;
-	}
-
-	throw Exception("failed to find entry point in SPIR-V code");
-}
+VERA_NAMESPACE_BEGIN
 
 static void create_shader_impl(
 	obj<Device>           device,
 	DeviceImpl&           device_impl,
 	ShaderImpl&           impl,
+	obj<ShaderReflection> reflection,
 	std::vector<uint32_t> spirv_code,
-	hash_t                hash_value
+	const hash128_t&      code_key
 ) {
-	EntryPoint entry_point = parse_entry_point(spirv_code);
-
 	vk::ShaderModuleCreateInfo shader_info;
 	shader_info.codeSize = spirv_code.size() * sizeof(uint32_t);
 	shader_info.pCode    = spirv_code.data();
 
-	spv_reflect::ShaderModule spv_module(shader_info.codeSize, shader_info.pCode);
-
 	impl.device           = std::move(device);
 	impl.vkShaderModule   = device_impl.vkDevice.createShaderModule(shader_info);
-	impl.shaderReflection = ShaderReflection::create(impl.device, spirv_code);
+	impl.shaderReflection = std::move(reflection);
 	impl.spirvCode        = std::move(spirv_code);
-	impl.entryPointName   = entry_point.name;
-	impl.stageFlags       = entry_point.stageFlag;
-	impl.hashValue        = hash_value;
+	impl.entryPointName   = impl.shaderReflection->getEntryPointName();
+	impl.stageFlags       = impl.shaderReflection->getStageFlags();
+	impl.hashValue        = code_key.low;
+	impl.codeKey          = code_key;
 }
 
-static size_t hash_shader_code(array_view<uint32_t> spirv_code)
+static hash128_t hash_shader_code(array_view<uint32_t> spirv_code)
 {
-	size_t seed = 0;
-
-	for (uint32_t word : spirv_code)
-		hash_combine(seed, word);
+	return hash_bytes_128(spirv_code.data(), spirv_code.size() * sizeof(uint32_t));
+}
 
-	return seed;
+static bool is_same_code(const ShaderImpl& impl, const hash128_t& code_key, array_view<uint32_t> spirv_code)
+{
+	return
+		impl.codeKey == code_key &&
+		impl.spirvCode.size() == spirv_code.size() &&
+		memcmp(impl.spirvCode.data(), spirv_code.data(), spirv_code.size() * sizeof(uint32_t)) == 0;
 }
 
 const vk::ShaderModule& get_vk_shader_module(cref<Shader> shader) VERA_NOEXCEPT
@@ -162,48 +85,107 @@ obj<Shader> Shader::create(obj<Device> device, std::string_view path)
 
 obj<Shader> Shader::create(obj<Device> device, std::vector<uint32_t>&& spirv_code)
 {
-	auto&  device_impl = getImpl(device);
-	size_t hash_value  = hash_shader_code(spirv_code);
+	auto&     device_impl = getImpl(device);
+	hash128_t code_key    = hash_shader_code(spirv_code);
+	bool      created     = false;
+
+	auto shader = device_impl.acquireCachedObject<Shader>(code_key.low, [&]() {
+		auto  obj        = createNewCoreObject<Shader>();
+		auto& impl       = getImpl(obj);
+		auto  reflection = ShaderReflection::create(device, spirv_code, code_key);
+
+		create_shader_impl(
+			device,
+			device_impl,
+			impl,
+			std::move(reflection),
+			std::move(spirv_code),
+			code_key);
+
+		created = true;
+		return obj;
+	});
+
+	// code sharing the low half of the key with a cached shader is created outside of the cache
+	if (!created && !is_same_code(getImpl(shader), code_key, spirv_code))
+		return createUncached(std::move(device), std::move(spirv_code), code_key);
+
+	return shader;
+}
 
-	if (auto cached_obj = device_impl.findCachedObject<Shader>(hash_value))
-		return cached_obj;
+obj<Shader> Shader::create(obj<Device> device, array_view<uint32_t> spirv_code)
+{
+	auto&     device_impl = getImpl(device);
+	hash128_t code_key    = hash_shader_code(spirv_code);
+
+	auto shader = device_impl.acquireCachedObject<Shader>(code_key.low, [&]() {
+		auto  obj        = createNewCoreObject<Shader>();
+		auto& impl       = getImpl(obj);
+		auto  reflection = ShaderReflection::create(device, spirv_code, code_key);
+
+		create_shader_impl(
+			device,
+			device_impl,
+			impl,
+			std::move(reflection),
+			std::vector<uint32_t>(spirv_code.begin(), spirv_code.end()),
+			code_key);
+
+		return obj;
+	});
+
+	if (!is_same_code(getImpl(shader), code_key, spirv_code))
+		return createUncached(
+			std::move(device),
+			std::vector<uint32_t>(spirv_code.begin(), spirv_code.end()),
+			code_key);
+
+	return shader;
+}
 
-	auto  obj  = createNewCoreObject<Shader>();
-	auto& impl = getImpl(obj);
+obj<Shader> Shader::createUncached(obj<Device> device, std::vector<uint32_t>&& spirv_code, const hash128_t& code_key)
+{
+	auto& device_impl = getImpl(device);
+	auto  obj         = createNewCoreObject<Shader>();
+	auto& impl        = getImpl(obj);
+	auto  reflection  = ShaderReflection::create(device, spirv_code, code_key);
 
+	// never registered, unregistering the hash value in the destructor does not find this object
 	create_shader_impl(
 		std::move(device),
 		device_impl,
 		impl,
+		std::move(reflection),
 		std::move(spirv_code),
-		hash_value);
+		code_key);
 
-	device_impl.registerCachedObject<Shader>(hash_value, obj);
-	
 	return obj;
 }
 
-obj<Shader> Shader::create(obj<Device> device, array_view<uint32_t> spirv_code)
+std::vector<obj<Shader>> Shader::createMany(obj<Device> device, array_view<std::string_view> paths)
 {
-	auto&  device_impl = getImpl(device);
-	size_t hash_value  = hash_shader_code(spirv_code);
-
-	if (auto cached_obj = device_impl.findCachedObject<Shader>(hash_value))
-		return cached_obj;
+	std::vector<obj<Shader>> result(paths.size());
+	std::exception_ptr       error;
+	std::mutex               error_mutex;
+
+	// shaders requested twice are created once, the device caches wait for the first request
+	parallel_for(static_cast<uint32_t>(paths.size()), SHADERS_PER_TASK, [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; ++i) {
+			try {
+				result[i] = create(device, paths[i]);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(error_mutex);
+				if (!error)
+					error = std::current_exception();
+				return;
+			}
+		}
+	});
 
-	auto  obj  = createNewCoreObject<Shader>();
-	auto& impl = getImpl(obj);
+	if (error)
+		std::rethrow_exception(error);
 
-	create_shader_impl(
-		std::move(device),
-		device_impl,
-		impl,
-		std::vector<uint32_t>(spirv_code.begin(), spirv_code.end()),
-		hash_value);
-
-	device_impl.registerCachedObject<Shader>(hash_value, obj);
-	
-	return obj;
+	return result;
 }
 
 Shader::~Shader() VERA_NOEXCEPT
@@ -211,7 +193,7 @@ Shader::~Shader() VERA_NOEXCEPT
 	auto& impl        = getImpl(this);
 	auto& device_impl = getImpl(impl.device);
 
-	device_impl.unregisterCachedObject<Shader>(impl.hashValue);
+	device_impl.unregisterCachedObject<Shader>(impl.hashValue, this);
 	device_impl.vkDevice.destroy(impl.vkShaderModule);
 
 	destroyObjectImpl(this);
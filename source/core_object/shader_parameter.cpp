@@ -276,40 +276,89 @@ void ShaderParameterImpl::bind(cref<CommandBuffer> cmd_buffer)
 		recreatePipelineLayout();
 
 	auto& cmd_impl           = CoreObject::getImpl(cmd_buffer);
-	auto  vk_device          = get_vk_device(cmd_impl.device);
+	auto& bound_state        = cmd_impl.boundState;
+	auto& stats              = cmd_impl.bindStatistics;
 	auto  vk_cmd_buffer      = cmd_impl.vkCommandBuffer;
 	auto  pc_ranges          = pipelineLayout->getPushConstantRanges();
 	auto  vk_pipeline_layout = get_vk_pipeline_layout(pipelineLayout);
+	auto  vk_bind_point      = to_vk_pipeline_bind_point(programReflection->getPipelineBindPoint());
+	auto  set_count          = static_cast<uint32_t>(setStates.size());
 	bool  has_dirty          = false;
 
-	for (auto& set_state : setStates) {
+	if (bound_state.bindPoint != vk_bind_point || bound_state.pipelineLayout != vk_pipeline_layout)
+		bound_state.reset(vk_bind_point, vk_pipeline_layout);
+
+	if (bound_state.descriptorSets.size() < set_count)
+		bound_state.descriptorSets.resize(set_count);
+
+	small_vector<vk::DescriptorSet, 8> vk_desc_sets(set_count);
+
+	for (uint32_t set = 0; set < set_count; ++set) {
+		auto& set_state = setStates[set];
+
 		if (set_state.dirty) {
 			updateDescriptorSet(set_state);
 			has_dirty = true;
 		}
 
-		uint32_t curr_idx = set_state.currentSetIdx;
-		auto&    curr_set = set_state.descriptorSets[curr_idx];
+		vk_desc_sets[set] = set_state.descriptorSets[set_state.currentSetIdx].descriptorSet;
+	}
+
+	// one bind per contiguous run of sets that differ from what the command buffer holds
+	for (uint32_t first = 0; first < set_count;) {
+		if (vk_desc_sets[first] == bound_state.descriptorSets[first]) {
+			stats.descriptorSetsSkipped++;
+			first++;
+			continue;
+		}
+
+		uint32_t last = first + 1;
+		while (last < set_count && vk_desc_sets[last] != bound_state.descriptorSets[last])
+			last++;
 
 		vk_cmd_buffer.bindDescriptorSets(
-			to_vk_pipeline_bind_point(programReflection->getPipelineBindPoint()),
+			vk_bind_point,
 			vk_pipeline_layout,
-			0,
-			1,
-			&curr_set.descriptorSet,
+			first,
+			last - first,
+			&vk_desc_sets[first],
 			0,
 			nullptr);
+
+		std::copy(
+			vk_desc_sets.begin() + first,
+			vk_desc_sets.begin() + last,
+			bound_state.descriptorSets.begin() + first);
+
+		stats.descriptorSetBinds++;
+		stats.descriptorSetsBound += last - first;
+		first                      = last;
 	}
 
+	const auto& pc_block = pushConstantStorage.block;
+	auto&       pc_bound = bound_state.pushConstants;
+	bool        pc_known = pc_bound.size() == pc_block.size();
+
 	for (const auto& pc_range : pc_ranges) {
+		const auto* pc_data = pc_block.data() + pc_range.offset;
+
+		if (pc_known && !memcmp(pc_bound.data() + pc_range.offset, pc_data, pc_range.size)) {
+			stats.pushConstantRangesSkipped++;
+			continue;
+		}
+
 		vk_cmd_buffer.pushConstants(
 			vk_pipeline_layout,
 			to_vk_shader_stage_flags(pc_range.stageFlags),
 			pc_range.offset,
 			pc_range.size,
-			pushConstantStorage.block.data() + pc_range.offset);
+			pc_data);
+
+		stats.pushConstantRanges++;
 	}
 
+	pc_bound.assign(VERA_SPAN(pc_block));
+
 	if (has_dirty) {
 		for (auto& set_state : setStates) {
 			auto& curr_set = set_state.descriptorSets[set_state.currentSetIdx];
@@ -2,453 +2,351 @@
 #include "../impl/device_impl.h"
 #include "../impl/shader_impl.h"
 #include "../impl/shader_reflection_impl.h"
+#include "../impl/byte_stream.h"
 
-#include "../../include/vera/core/logger.h"
 #include "../../include/vera/core/shader.h"
-#include "../../include/vera/util/static_vector.h"
-#include "../../include/vera/util/stopwatch.h"
-#include "../spirv/spirv_reflect.h"
+#include "../../include/vera/util/hash.h"
+#include "../spirv/spirv_parser.h"
+#include <algorithm>
 
-#define MAX_SHADER_STAGE_COUNT 16
+#define SHADER_REFLECTION_VERSION 1
+#define SPIRV_DATA_ALIGNMENT      16
 
 VERA_NAMESPACE_BEGIN
 
-static ShaderStageFlagBits to_shader_stage(SpvReflectShaderStageFlagBits stage)
+static ShaderStageFlagBits to_shader_stage(spv::ExecutionModel exec_model)
 {
-	switch (stage) {
-	case SPV_REFLECT_SHADER_STAGE_VERTEX_BIT:
+	switch (exec_model) {
+	case spv::ExecutionModelVertex:
 		return ShaderStageFlagBits::Vertex;
-	case SPV_REFLECT_SHADER_STAGE_TESSELLATION_CONTROL_BIT:
+	case spv::ExecutionModelTessellationControl:
 		return ShaderStageFlagBits::TessellationControl;
-	case SPV_REFLECT_SHADER_STAGE_TESSELLATION_EVALUATION_BIT:
+	case spv::ExecutionModelTessellationEvaluation:
 		return ShaderStageFlagBits::TessellationEvaluation;
-	case SPV_REFLECT_SHADER_STAGE_GEOMETRY_BIT:
+	case spv::ExecutionModelGeometry:
 		return ShaderStageFlagBits::Geometry;
-	case SPV_REFLECT_SHADER_STAGE_FRAGMENT_BIT:
+	case spv::ExecutionModelFragment:
 		return ShaderStageFlagBits::Fragment;
-	case SPV_REFLECT_SHADER_STAGE_COMPUTE_BIT:
+	case spv::ExecutionModelGLCompute:
 		return ShaderStageFlagBits::Compute;
-	case SPV_REFLECT_SHADER_STAGE_TASK_BIT_EXT:
+	case spv::ExecutionModelTaskNV:
+	case spv::ExecutionModelTaskEXT:
 		return ShaderStageFlagBits::Task;
-	case SPV_REFLECT_SHADER_STAGE_MESH_BIT_EXT:
+	case spv::ExecutionModelMeshNV:
+	case spv::ExecutionModelMeshEXT:
 		return ShaderStageFlagBits::Mesh;
-	case SPV_REFLECT_SHADER_STAGE_RAYGEN_BIT_KHR:
+	case spv::ExecutionModelRayGenerationKHR:
 		return ShaderStageFlagBits::RayGen;
-	case SPV_REFLECT_SHADER_STAGE_ANY_HIT_BIT_KHR:
+	case spv::ExecutionModelIntersectionKHR:
+		return ShaderStageFlagBits::Intersection;
+	case spv::ExecutionModelAnyHitKHR:
 		return ShaderStageFlagBits::AnyHit;
-	case SPV_REFLECT_SHADER_STAGE_CLOSEST_HIT_BIT_KHR:
+	case spv::ExecutionModelClosestHitKHR:
 		return ShaderStageFlagBits::ClosestHit;
-	case SPV_REFLECT_SHADER_STAGE_MISS_BIT_KHR:
+	case spv::ExecutionModelMissKHR:
 		return ShaderStageFlagBits::Miss;
-	case SPV_REFLECT_SHADER_STAGE_INTERSECTION_BIT_KHR:
-		return ShaderStageFlagBits::Intersection;
-	case SPV_REFLECT_SHADER_STAGE_CALLABLE_BIT_KHR:
+	case spv::ExecutionModelCallableKHR:
 		return ShaderStageFlagBits::Callable;
 	}
 
-	VERA_ERROR_MSG("invalid shader stage");
+	throw Exception("unsupported shader execution model");
 }
 
-static ReflectionDecorationFlags to_decoration_flags(SpvReflectDecorationFlags flags)
+static ReflectionDecorationFlags to_decoration_flags(const spv_decoration& deco)
 {
 	ReflectionDecorationFlags result;
 
-	if (flags & SPV_REFLECT_DECORATION_BLOCK)
+	if (deco.has(spv::DecorationBlock))
 		result |= ReflectionDecorationFlagBits::Block;
-	if (flags & SPV_REFLECT_DECORATION_BUFFER_BLOCK)
+	if (deco.has(spv::DecorationBufferBlock))
 		result |= ReflectionDecorationFlagBits::BufferBlock;
-	if (flags & SPV_REFLECT_DECORATION_ROW_MAJOR)
+	if (deco.has(spv::DecorationRowMajor))
 		result |= ReflectionDecorationFlagBits::RowMajor;
-	if (flags & SPV_REFLECT_DECORATION_COLUMN_MAJOR)
+	if (deco.has(spv::DecorationColMajor))
 		result |= ReflectionDecorationFlagBits::ColMajor;
-	if (flags & SPV_REFLECT_DECORATION_BUILT_IN)
+	if (deco.has(spv::DecorationBuiltIn))
 		result |= ReflectionDecorationFlagBits::BuiltIn;
-	if (flags & SPV_REFLECT_DECORATION_NOPERSPECTIVE)
+	if (deco.has(spv::DecorationNoPerspective))
 		result |= ReflectionDecorationFlagBits::NoPerspective;
-	if (flags & SPV_REFLECT_DECORATION_FLAT)
+	if (deco.has(spv::DecorationFlat))
 		result |= ReflectionDecorationFlagBits::Flat;
-	if (flags & SPV_REFLECT_DECORATION_NON_WRITABLE)
+	if (deco.has(spv::DecorationNonWritable))
 		result |= ReflectionDecorationFlagBits::NonWritable;
-	if (flags & SPV_REFLECT_DECORATION_RELAXED_PRECISION)
+	if (deco.has(spv::DecorationRelaxedPrecision))
 		result |= ReflectionDecorationFlagBits::RelaxedPrecision;
-	if (flags & SPV_REFLECT_DECORATION_NON_READABLE)
+	if (deco.has(spv::DecorationNonReadable))
 		result |= ReflectionDecorationFlagBits::NonReadable;
-	if (flags & SPV_REFLECT_DECORATION_PATCH)
+	if (deco.has(spv::DecorationPatch))
 		result |= ReflectionDecorationFlagBits::Patch;
-	if (flags & SPV_REFLECT_DECORATION_PER_VERTEX)
+	if (deco.has(spv::DecorationPerVertexKHR))
 		result |= ReflectionDecorationFlagBits::PerVertex;
-	if (flags & SPV_REFLECT_DECORATION_PER_TASK)
+	if (deco.has(spv::DecorationPerTaskNV))
 		result |= ReflectionDecorationFlagBits::PerTask;
-	if (flags & SPV_REFLECT_DECORATION_WEIGHT_TEXTURE)
-		throw Exception("SPV_REFLECT_DECORATION_WEIGHT_TEXTURE is not supported");
-	if (flags & SPV_REFLECT_DECORATION_BLOCK_MATCH_TEXTURE)
-		throw Exception("SPV_REFLECT_DECORATION_BLOCK_MATCH_TEXTURE is not supported");
+	if (deco.has(spv::DecorationWeightTextureQCOM))
+		throw Exception("WeightTextureQCOM decoration is not supported");
+	if (deco.has(spv::DecorationBlockMatchTextureQCOM))
+		throw Exception("BlockMatchTextureQCOM decoration is not supported");
 
 	return result;
 }
 
-static ReflectionBuiltIn to_builtin(int builtin)
+static ReflectionBuiltIn to_builtin(const spv_decoration& deco)
 {
-	if (builtin >= 0 && builtin < static_cast<int>(ReflectionBuiltIn::InstanceIndex))
-		return static_cast<ReflectionBuiltIn>(builtin + 1);
+	if (!deco.has(spv::DecorationBuiltIn))
+		return ReflectionBuiltIn::Unknown;
+
+	switch (deco.get_value<spv::BuiltIn>(spv::DecorationBuiltIn)) {
+	case spv::BuiltInPosition:                  return ReflectionBuiltIn::Position;
+	case spv::BuiltInPointSize:                 return ReflectionBuiltIn::PointSize;
+	case spv::BuiltInClipDistance:              return ReflectionBuiltIn::ClipDistance;
+	case spv::BuiltInCullDistance:              return ReflectionBuiltIn::CullDistance;
+	case spv::BuiltInVertexId:                  return ReflectionBuiltIn::VertexId;
+	case spv::BuiltInInstanceId:                return ReflectionBuiltIn::InstanceId;
+	case spv::BuiltInPrimitiveId:               return ReflectionBuiltIn::PrimitiveId;
+	case spv::BuiltInInvocationId:              return ReflectionBuiltIn::InvocationId;
+	case spv::BuiltInLayer:                     return ReflectionBuiltIn::Layer;
+	case spv::BuiltInViewportIndex:             return ReflectionBuiltIn::ViewportIndex;
+	case spv::BuiltInTessLevelOuter:            return ReflectionBuiltIn::TessLevelOuter;
+	case spv::BuiltInTessLevelInner:            return ReflectionBuiltIn::TessLevelInner;
+	case spv::BuiltInTessCoord:                 return ReflectionBuiltIn::TessCoord;
+	case spv::BuiltInPatchVertices:             return ReflectionBuiltIn::PatchVertices;
+	case spv::BuiltInFragCoord:                 return ReflectionBuiltIn::FragCoord;
+	case spv::BuiltInPointCoord:                return ReflectionBuiltIn::PointCoord;
+	case spv::BuiltInFrontFacing:               return ReflectionBuiltIn::FrontFacing;
+	case spv::BuiltInSampleId:                  return ReflectionBuiltIn::SampleId;
+	case spv::BuiltInSamplePosition:            return ReflectionBuiltIn::SamplePosition;
+	case spv::BuiltInSampleMask:                return ReflectionBuiltIn::SampleMask;
+	case spv::BuiltInFragDepth:                 return ReflectionBuiltIn::FragDepth;
+	case spv::BuiltInHelperInvocation:          return ReflectionBuiltIn::HelperInvocation;
+	case spv::BuiltInNumWorkgroups:             return ReflectionBuiltIn::NumWorkgroups;
+	case spv::BuiltInWorkgroupSize:             return ReflectionBuiltIn::WorkgroupSize;
+	case spv::BuiltInWorkgroupId:               return ReflectionBuiltIn::WorkgroupId;
+	case spv::BuiltInLocalInvocationId:         return ReflectionBuiltIn::LocalInvocationId;
+	case spv::BuiltInGlobalInvocationId:        return ReflectionBuiltIn::GlobalInvocationId;
+	case spv::BuiltInLocalInvocationIndex:      return ReflectionBuiltIn::LocalInvocationIndex;
+	case spv::BuiltInWorkDim:                   return ReflectionBuiltIn::WorkDim;
+	case spv::BuiltInGlobalSize:                return ReflectionBuiltIn::GlobalSize;
+	case spv::BuiltInEnqueuedWorkgroupSize:     return ReflectionBuiltIn::EnqueuedWorkgroupSize;
+	case spv::BuiltInGlobalOffset:              return ReflectionBuiltIn::GlobalOffset;
+	case spv::BuiltInGlobalLinearId:            return ReflectionBuiltIn::GlobalLinearId;
+	case spv::BuiltInSubgroupSize:              return ReflectionBuiltIn::SubgroupSize;
+	case spv::BuiltInSubgroupMaxSize:           return ReflectionBuiltIn::SubgroupMaxSize;
+	case spv::BuiltInNumSubgroups:              return ReflectionBuiltIn::NumSubgroups;
+	case spv::BuiltInNumEnqueuedSubgroups:      return ReflectionBuiltIn::NumEnqueuedSubgroups;
+	case spv::BuiltInSubgroupId:                return ReflectionBuiltIn::SubgroupId;
+	case spv::BuiltInSubgroupLocalInvocationId: return ReflectionBuiltIn::SubgroupLocalInvocationId;
+	case spv::BuiltInVertexIndex:               return ReflectionBuiltIn::VertexIndex;
+	case spv::BuiltInInstanceIndex:             return ReflectionBuiltIn::InstanceIndex;
+	}
+
 	return ReflectionBuiltIn::Unknown;
 }
 
-static Format to_format(SpvReflectFormat format)
-{
-	switch (format) {
-	case SPV_REFLECT_FORMAT_R16_UINT:            return Format::R16Uint;
-	case SPV_REFLECT_FORMAT_R16_SINT:            return Format::R16Sint;
-	case SPV_REFLECT_FORMAT_R16_SFLOAT:          return Format::R16Float;
-	case SPV_REFLECT_FORMAT_R16G16_UINT:         return Format::RG16Uint;
-	case SPV_REFLECT_FORMAT_R16G16_SINT:         return Format::RG16Sint;
-	case SPV_REFLECT_FORMAT_R16G16_SFLOAT:       return Format::RG16Float;
-	case SPV_REFLECT_FORMAT_R16G16B16_UINT:      return Format::RGB16Uint;
-	case SPV_REFLECT_FORMAT_R16G16B16_SINT:      return Format::RGB16Sint;
-	case SPV_REFLECT_FORMAT_R16G16B16_SFLOAT:    return Format::RGB16Float;
-	case SPV_REFLECT_FORMAT_R16G16B16A16_UINT:   return Format::RGBA16Uint;
-	case SPV_REFLECT_FORMAT_R16G16B16A16_SINT:   return Format::RGBA16Sint;
-	case SPV_REFLECT_FORMAT_R16G16B16A16_SFLOAT: return Format::RGBA16Float;
-	case SPV_REFLECT_FORMAT_R32_UINT:            return Format::R32Uint;
-	case SPV_REFLECT_FORMAT_R32_SINT:            return Format::R32Sint;
-	case SPV_REFLECT_FORMAT_R32_SFLOAT:          return Format::R32Float;
-	case SPV_REFLECT_FORMAT_R32G32_UINT:         return Format::RG32Uint;
-	case SPV_REFLECT_FORMAT_R32G32_SINT:         return Format::RG32Sint;
-	case SPV_REFLECT_FORMAT_R32G32_SFLOAT:       return Format::RG32Float;
-	case SPV_REFLECT_FORMAT_R32G32B32_UINT:      return Format::RGB32Uint;
-	case SPV_REFLECT_FORMAT_R32G32B32_SINT:      return Format::RGB32Sint;
-	case SPV_REFLECT_FORMAT_R32G32B32_SFLOAT:    return Format::RGB32Float;
-	case SPV_REFLECT_FORMAT_R32G32B32A32_UINT:   return Format::RGBA32Uint;
-	case SPV_REFLECT_FORMAT_R32G32B32A32_SINT:   return Format::RGBA32Sint;
-	case SPV_REFLECT_FORMAT_R32G32B32A32_SFLOAT: return Format::RGBA32Float;
-	case SPV_REFLECT_FORMAT_R64_UINT:            return Format::R64Uint;
-	case SPV_REFLECT_FORMAT_R64_SINT:            return Format::R64Sint;
-	case SPV_REFLECT_FORMAT_R64_SFLOAT:          return Format::R64Float;
-	case SPV_REFLECT_FORMAT_R64G64_UINT:         return Format::RG64Uint;
-	case SPV_REFLECT_FORMAT_R64G64_SINT:         return Format::RG64Sint;
-	case SPV_REFLECT_FORMAT_R64G64_SFLOAT:       return Format::RG64Float;
-	case SPV_REFLECT_FORMAT_R64G64B64_UINT:      return Format::RGB64Uint;
-	case SPV_REFLECT_FORMAT_R64G64B64_SINT:      return Format::RGB64Sint;
-	case SPV_REFLECT_FORMAT_R64G64B64_SFLOAT:    return Format::RGB64Float;
-	case SPV_REFLECT_FORMAT_R64G64B64A64_UINT:   return Format::RGBA64Uint;
-	case SPV_REFLECT_FORMAT_R64G64B64A64_SINT:   return Format::RGBA64Sint;
-	case SPV_REFLECT_FORMAT_R64G64B64A64_SFLOAT: return Format::RGBA64Float;
-	}
+static SpvBasicType get_scalar_type(SpvBasicType type)
+{
+	return static_cast<SpvBasicType>(static_cast<uint32_t>(type) & 0xFF);
+}
 
-	return Format::Unknown;
+// 0 for scalars
+static uint32_t get_row_count(SpvBasicType type)
+{
+	return (static_cast<uint32_t>(type) >> 16) & 0xFF;
 }
 
-static DescriptorType to_descriptor_type(SpvReflectDescriptorType type)
+// 0 for scalars, 1 for vectors
+static uint32_t get_column_count(SpvBasicType type)
 {
-	switch (type) {
-	case SPV_REFLECT_DESCRIPTOR_TYPE_SAMPLER:
-		return DescriptorType::Sampler;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
-		return DescriptorType::CombinedTextureSampler;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
-		return DescriptorType::SampledTexture;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_IMAGE:
-		return DescriptorType::StorageTexture;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
-		return DescriptorType::UniformTexelBuffer;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
-		return DescriptorType::StorageTexelBuffer;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
-		return DescriptorType::UniformBuffer;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER:
-		return DescriptorType::StorageBuffer;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
-		return DescriptorType::UniformBufferDynamic;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
-		return DescriptorType::StorageBufferDynamic;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
-		return DescriptorType::InputAttachment;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
-		return DescriptorType::AccelerationStructure;
-	}
-	
-	VERA_ERROR_MSG("invalid descriptor type");
+	return (static_cast<uint32_t>(type) >> 8) & 0xFF;
 }
 
-static const ReflectionSpecConstant* find_spec_constant(
-	array_view<ReflectionSpecConstant> spec_constants,
-	uint32_t                           constant_id
-) {
-	for (const auto& spec_const : spec_constants)
-		if (spec_const.constantId == constant_id)
-			return &spec_const;
-	return nullptr;
+static ReflectionPrimitiveType offset_primitive_type(ReflectionPrimitiveType base, uint32_t offset)
+{
+	return static_cast<ReflectionPrimitiveType>(static_cast<uint32_t>(base) + offset);
 }
 
-static ReflectionPrimitiveType reflect_matrix_type(const SpvReflectBlockVariable& block)
-{
-	if (block.decoration_flags & SPV_REFLECT_DECORATION_ROW_MAJOR) {
-		switch (block.numeric.scalar.width) {
-		case 32:
-			switch (block.numeric.matrix.row_count) {
-			case 2:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::RFloat2x2;
-				case 3: return ReflectionPrimitiveType::RFloat2x3;
-				case 4: return ReflectionPrimitiveType::RFloat2x4;
-				}
-				break;
-			case 3:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::RFloat3x2;
-				case 3: return ReflectionPrimitiveType::RFloat3x3;
-				case 4: return ReflectionPrimitiveType::RFloat3x4;
-				}
-				break;
-			case 4:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::RFloat4x2;
-				case 3: return ReflectionPrimitiveType::RFloat4x3;
-				case 4: return ReflectionPrimitiveType::RFloat4x4;
-				}
-				break;
-			};
-			break;
-		case 64:
-			switch (block.numeric.matrix.row_count) {
-			case 2:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::RDouble2x2;
-				case 3: return ReflectionPrimitiveType::RDouble2x3;
-				case 4: return ReflectionPrimitiveType::RDouble2x4;
-				}
-				break;
-			case 3:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::RDouble3x2;
-				case 3: return ReflectionPrimitiveType::RDouble3x3;
-				case 4: return ReflectionPrimitiveType::RDouble3x4;
-				}
-				break;
-			case 4:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::RDouble4x2;
-				case 3: return ReflectionPrimitiveType::RDouble4x3;
-				case 4: return ReflectionPrimitiveType::RDouble4x4;
-				}
-				break;
-			};
-			break;
-		}
-	} else if (block.decoration_flags & SPV_REFLECT_DECORATION_COLUMN_MAJOR) {
-		switch (block.numeric.scalar.width) {
-		case 32:
-			switch (block.numeric.matrix.row_count) {
-			case 2:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::CFloat2x2;
-				case 3: return ReflectionPrimitiveType::CFloat2x3;
-				case 4: return ReflectionPrimitiveType::CFloat2x4;
-				}
-				break;
-			case 3:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::CFloat3x2;
-				case 3: return ReflectionPrimitiveType::CFloat3x3;
-				case 4: return ReflectionPrimitiveType::CFloat3x4;
-				}
-				break;
-			case 4:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::CFloat4x2;
-				case 3: return ReflectionPrimitiveType::CFloat4x3;
-				case 4: return ReflectionPrimitiveType::CFloat4x4;
-				}
-				break;
-			};
-			break;
-		case 64:
-			switch (block.numeric.matrix.row_count) {
-			case 2:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::CDouble2x2;
-				case 3: return ReflectionPrimitiveType::CDouble2x3;
-				case 4: return ReflectionPrimitiveType::CDouble2x4;
-				}
-				break;
-			case 3:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::CDouble3x2;
-				case 3: return ReflectionPrimitiveType::CDouble3x3;
-				case 4: return ReflectionPrimitiveType::CDouble3x4;
-				}
-				break;
-			case 4:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::CDouble4x2;
-				case 3: return ReflectionPrimitiveType::CDouble4x3;
-				case 4: return ReflectionPrimitiveType::CDouble4x4;
-				}
-				break;
-			};
-			break;
+static ReflectionPrimitiveType to_primitive_type(SpvBasicType type, bool row_major)
+{
+	SpvBasicType scalar_type = get_scalar_type(type);
+	uint32_t     row_count   = get_row_count(type);
+	uint32_t     col_count   = get_column_count(type);
+
+	if (row_count == 0) {
+		switch (scalar_type) {
+		case SpvBasicType::Bool:    return ReflectionPrimitiveType::Bool;
+		case SpvBasicType::Int8:    return ReflectionPrimitiveType::Char;
+		case SpvBasicType::UInt8:   return ReflectionPrimitiveType::UChar;
+		case SpvBasicType::Int16:   return ReflectionPrimitiveType::Short;
+		case SpvBasicType::UInt16:  return ReflectionPrimitiveType::UShort;
+		case SpvBasicType::Int32:   return ReflectionPrimitiveType::Int;
+		case SpvBasicType::UInt32:  return ReflectionPrimitiveType::UInt;
+		case SpvBasicType::Int64:   return ReflectionPrimitiveType::Long;
+		case SpvBasicType::UInt64:  return ReflectionPrimitiveType::ULong;
+		case SpvBasicType::Float32: return ReflectionPrimitiveType::Float;
+		case SpvBasicType::Float64: return ReflectionPrimitiveType::Double;
 		}
+
+		return ReflectionPrimitiveType::Unknown;
 	}
 
-	return ReflectionPrimitiveType::Unknown;
-}
+	// vector and matrix types of each scalar type are declared in order of their extent
+	if (col_count == 1) {
+		switch (scalar_type) {
+		case SpvBasicType::Bool:    return offset_primitive_type(ReflectionPrimitiveType::Bool2, row_count - 2);
+		case SpvBasicType::Int8:    return offset_primitive_type(ReflectionPrimitiveType::Char2, row_count - 2);
+		case SpvBasicType::UInt8:   return offset_primitive_type(ReflectionPrimitiveType::UChar2, row_count - 2);
+		case SpvBasicType::Int16:   return offset_primitive_type(ReflectionPrimitiveType::Short2, row_count - 2);
+		case SpvBasicType::UInt16:  return offset_primitive_type(ReflectionPrimitiveType::UShort2, row_count - 2);
+		case SpvBasicType::Int32:   return offset_primitive_type(ReflectionPrimitiveType::Int2, row_count - 2);
+		case SpvBasicType::UInt32:  return offset_primitive_type(ReflectionPrimitiveType::UInt2, row_count - 2);
+		case SpvBasicType::Int64:   return offset_primitive_type(ReflectionPrimitiveType::Long2, row_count - 2);
+		case SpvBasicType::UInt64:  return offset_primitive_type(ReflectionPrimitiveType::ULong2, row_count - 2);
+		case SpvBasicType::Float32: return offset_primitive_type(ReflectionPrimitiveType::Float2, row_count - 2);
+		case SpvBasicType::Float64: return offset_primitive_type(ReflectionPrimitiveType::Double2, row_count - 2);
+		}
 
-static ReflectionPrimitiveType reflect_vector_type(const SpvReflectBlockVariable& block)
-{
-	auto type_flags = block.type_description->type_flags;
+		return ReflectionPrimitiveType::Unknown;
+	}
 
-	if (type_flags & SpvReflectTypeFlagBits::SPV_REFLECT_TYPE_FLAG_FLOAT) {
-		switch (block.numeric.scalar.width) {
-		case 32:
-			switch (block.numeric.vector.component_count) {
-			case 2: return ReflectionPrimitiveType::Float2;
-			case 3: return ReflectionPrimitiveType::Float3;
-			case 4: return ReflectionPrimitiveType::Float4;
-			}
-			break;
-		case 64:
-			switch (block.numeric.vector.component_count) {
-			case 2: return ReflectionPrimitiveType::Double2;
-			case 3: return ReflectionPrimitiveType::Double3;
-			case 4: return ReflectionPrimitiveType::Double4;
-			}
-			break;
-		}
-	} else if (type_flags & SpvReflectTypeFlagBits::SPV_REFLECT_TYPE_FLAG_INT) {
-		if (block.numeric.scalar.signedness) {
-			switch (block.numeric.scalar.width) {
-			case 8:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::Char2;
-				case 3: return ReflectionPrimitiveType::Char3;
-				case 4: return ReflectionPrimitiveType::Char4;
-				}
-				break;
-			case 16:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::Short2;
-				case 3: return ReflectionPrimitiveType::Short3;
-				case 4: return ReflectionPrimitiveType::Short4;
-				}
-				break;
-			case 32:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::Int2;
-				case 3: return ReflectionPrimitiveType::Int3;
-				case 4: return ReflectionPrimitiveType::Int4;
-				}
-				break;
-			case 64:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::Long2;
-				case 3: return ReflectionPrimitiveType::Long3;
-				case 4: return ReflectionPrimitiveType::Long4;
-				}
-				break;
-			}
-		} else {
-			switch (block.numeric.scalar.width) {
-			case 8:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::UChar2;
-				case 3: return ReflectionPrimitiveType::UChar3;
-				case 4: return ReflectionPrimitiveType::UChar4;
-				}
-				break;
-			case 16:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::UShort2;
-				case 3: return ReflectionPrimitiveType::UShort3;
-				case 4: return ReflectionPrimitiveType::UShort4;
-				}
-				break;
-			case 32:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::UInt2;
-				case 3: return ReflectionPrimitiveType::UInt3;
-				case 4: return ReflectionPrimitiveType::UInt4;
-				}
-				break;
-			case 64:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::ULong2;
-				case 3: return ReflectionPrimitiveType::ULong3;
-				case 4: return ReflectionPrimitiveType::ULong4;
-				}
-				break;
-			}
-		}
-	} else if (type_flags & SpvReflectTypeFlagBits::SPV_REFLECT_TYPE_FLAG_BOOL) {
-		switch (block.numeric.scalar.width) {
-		case 2: return ReflectionPrimitiveType::Bool2;
-		case 3: return ReflectionPrimitiveType::Bool3;
-		case 4: return ReflectionPrimitiveType::Bool4;
-		}
+	uint32_t matrix_offset = (row_count - 2) * 3 + (col_count - 2);
+
+	switch (scalar_type) {
+	case SpvBasicType::Float32:
+		return offset_primitive_type(
+			row_major ? ReflectionPrimitiveType::RFloat2x2 : ReflectionPrimitiveType::CFloat2x2,
+			matrix_offset);
+	case SpvBasicType::Float64:
+		return offset_primitive_type(
+			row_major ? ReflectionPrimitiveType::RDouble2x2 : ReflectionPrimitiveType::CDouble2x2,
+			matrix_offset);
 	}
 
 	return ReflectionPrimitiveType::Unknown;
 }
 
-static ReflectionPrimitiveType reflect_float_type(const SpvReflectBlockVariable& block)
+static Format to_format(SpvBasicType type)
 {
-	switch (block.numeric.scalar.width) {
-	case 32: return ReflectionPrimitiveType::Float;
-	case 64: return ReflectionPrimitiveType::Double;
+	static const Format uint16_formats[]  = { Format::R16Uint, Format::RG16Uint, Format::RGB16Uint, Format::RGBA16Uint };
+	static const Format int16_formats[]   = { Format::R16Sint, Format::RG16Sint, Format::RGB16Sint, Format::RGBA16Sint };
+	static const Format float16_formats[] = { Format::R16Float, Format::RG16Float, Format::RGB16Float, Format::RGBA16Float };
+	static const Format uint32_formats[]  = { Format::R32Uint, Format::RG32Uint, Format::RGB32Uint, Format::RGBA32Uint };
+	static const Format int32_formats[]   = { Format::R32Sint, Format::RG32Sint, Format::RGB32Sint, Format::RGBA32Sint };
+	static const Format float32_formats[] = { Format::R32Float, Format::RG32Float, Format::RGB32Float, Format::RGBA32Float };
+	static const Format uint64_formats[]  = { Format::R64Uint, Format::RG64Uint, Format::RGB64Uint, Format::RGBA64Uint };
+	static const Format int64_formats[]   = { Format::R64Sint, Format::RG64Sint, Format::RGB64Sint, Format::RGBA64Sint };
+	static const Format float64_formats[] = { Format::R64Float, Format::RG64Float, Format::RGB64Float, Format::RGBA64Float };
+
+	uint32_t comp_idx = std::max(get_row_count(type), 1u) - 1;
+
+	if (get_column_count(type) > 1 || comp_idx > 3)
+		return Format::Unknown;
+
+	switch (get_scalar_type(type)) {
+	case SpvBasicType::UInt16:  return uint16_formats[comp_idx];
+	case SpvBasicType::Int16:   return int16_formats[comp_idx];
+	case SpvBasicType::Float16: return float16_formats[comp_idx];
+	case SpvBasicType::UInt32:  return uint32_formats[comp_idx];
+	case SpvBasicType::Int32:   return int32_formats[comp_idx];
+	case SpvBasicType::Float32: return float32_formats[comp_idx];
+	case SpvBasicType::UInt64:  return uint64_formats[comp_idx];
+	case SpvBasicType::Int64:   return int64_formats[comp_idx];
+	case SpvBasicType::Float64: return float64_formats[comp_idx];
 	}
 
-	return ReflectionPrimitiveType::Unknown;
+	return Format::Unknown;
 }
 
-static ReflectionPrimitiveType reflect_int_type(const SpvReflectBlockVariable& block)
+static uint32_t get_scalar_size(SpvBasicType type)
 {
-	if (block.numeric.scalar.signedness) {
-		switch (block.numeric.scalar.width) {
-		case 8:  return ReflectionPrimitiveType::Char;
-		case 16: return ReflectionPrimitiveType::Short;
-		case 32: return ReflectionPrimitiveType::Int;
-		case 64: return ReflectionPrimitiveType::Long;
-		}
-	} else {
-		switch (block.numeric.scalar.width) {
-		case 8:  return ReflectionPrimitiveType::UChar;
-		case 16: return ReflectionPrimitiveType::UShort;
-		case 32: return ReflectionPrimitiveType::UInt;
-		case 64: return ReflectionPrimitiveType::ULong;
-		}
+	switch (get_scalar_type(type)) {
+	case SpvBasicType::Int8:
+	case SpvBasicType::UInt8:
+	case SpvBasicType::Float8E4M3:
+	case SpvBasicType::Float8E5M2:
+		return 1;
+	case SpvBasicType::Int16:
+	case SpvBasicType::UInt16:
+	case SpvBasicType::Float16:
+		return 2;
+	case SpvBasicType::Bool: // booleans in blocks are 32 bit
+	case SpvBasicType::Int32:
+	case SpvBasicType::UInt32:
+	case SpvBasicType::Float32:
+		return 4;
+	case SpvBasicType::Int64:
+	case SpvBasicType::UInt64:
+	case SpvBasicType::Float64:
+		return 8;
 	}
 
-	return ReflectionPrimitiveType::Unknown;
+	return 0;
 }
 
-static ReflectionPrimitiveType parse_primitive_type(const SpvReflectBlockVariable& block)
+static uint32_t get_basic_type_size(SpvBasicType type, const spv_decoration& deco)
 {
-	auto type_flags = block.type_description->type_flags;
+	uint32_t scalar_size = get_scalar_size(type);
+	uint32_t row_count   = get_row_count(type);
+	uint32_t col_count   = get_column_count(type);
 
-	if (type_flags& SPV_REFLECT_TYPE_FLAG_MATRIX)
-		return reflect_matrix_type(block);
-	else if (type_flags & SPV_REFLECT_TYPE_FLAG_VECTOR)
-		return reflect_vector_type(block);
-	else if (type_flags & SPV_REFLECT_TYPE_FLAG_FLOAT)
-		return reflect_float_type(block);
-	else if (type_flags & SPV_REFLECT_TYPE_FLAG_INT)
-		return reflect_int_type(block);
-	else if (type_flags & SPV_REFLECT_TYPE_FLAG_BOOL)
-		return ReflectionPrimitiveType::Bool;
+	if (col_count > 1) {
+		uint32_t matrix_stride = deco.has(spv::DecorationMatrixStride) ?
+			deco.get_value<uint32_t>(spv::DecorationMatrixStride) :
+			row_count * scalar_size;
 
-	return ReflectionPrimitiveType::Unknown;
+		return deco.has(spv::DecorationRowMajor) ? row_count * matrix_stride : col_count * matrix_stride;
+	}
+
+	return std::max(row_count, 1u) * scalar_size;
 }
 
-static ReflectionInterfaceIO to_interface_io(SpvStorageClass storage_class)
+static ReflectionInterfaceIO to_interface_io(spv::StorageClass storage_class)
 {
 	switch (storage_class) {
-	case 1: // SpvStorageClassInput
+	case spv::StorageClassInput:
 		return ReflectionInterfaceIO::Input;
-	case 3: // SpvStorageClassOutput
+	case spv::StorageClassOutput:
 		return ReflectionInterfaceIO::Output;
 	}
 	return ReflectionInterfaceIO::Unknown;
 }
 
+static DescriptorType get_descriptor_type(
+	const SpvParser&  parser,
+	const SpvNode*    type_node,
+	spv::StorageClass storage_class
+) {
+	if (type_node->op == spv::OpTypeSampledImage) {
+		const auto* image_node = parser.findNode<SpvImageTypeNode>(type_node->as<SpvSampledImageTypeNode>()->imageTypeId);
+
+		if (image_node && image_node->op == spv::OpTypeImage && image_node->dim == spv::DimBuffer)
+			return DescriptorType::UniformTexelBuffer;
+
+		return DescriptorType::CombinedTextureSampler;
+	}
+
+	switch (type_node->op) {
+	case spv::OpTypeSampler:
+		return DescriptorType::Sampler;
+	case spv::OpTypeImage: {
+		const auto* image_node = type_node->as<SpvImageTypeNode>();
+
+		if (image_node->dim == spv::DimBuffer)
+			return image_node->sampled == 2 ? DescriptorType::StorageTexelBuffer : DescriptorType::UniformTexelBuffer;
+		if (image_node->dim == spv::DimSubpassData)
+			return DescriptorType::InputAttachment;
+
+		return image_node->sampled == 2 ? DescriptorType::StorageTexture : DescriptorType::SampledTexture;
+	}
+	case spv::OpTypeAccelerationStructureKHR:
+		return DescriptorType::AccelerationStructure;
+	case spv::OpTypeStruct:
+		if (storage_class == spv::StorageClassStorageBuffer || type_node->meta->decoration.has(spv::DecorationBufferBlock))
+			return DescriptorType::StorageBuffer;
+		return DescriptorType::UniformBuffer;
+	}
+
+	throw Exception("unsupported descriptor type of SPIR-V type {}", type_node->id);
+}
+
 template <class T>
 static T* allocate(
 	ShaderReflectionImpl& impl,
@@ -461,357 +359,829 @@ static T* allocate(
 
 static std::string_view copy_string(
 	ShaderReflectionImpl& impl,
-	const char*           str
+	std::string_view      str
 ) {
-	if (!str)
+	if (str.empty())
 		return std::string_view();
 
-	if (size_t len = strlen(str); len > 0) {
-		auto* ptr = reinterpret_cast<char*>(impl.memory.allocate(len + 1, alignof(char)));
-		memcpy(ptr, str, len);
-		ptr[len] = '\0';
+	auto* ptr = reinterpret_cast<char*>(impl.memory.allocate(str.size() + 1, alignof(char)));
+	memcpy(ptr, str.data(), str.size());
+	ptr[str.size()] = '\0';
 
-		return std::string_view(ptr, len);
-	}
+	return std::string_view(ptr, str.size());
+}
 
-	return std::string_view();
+static uint32_t get_decoration_value(const spv_decoration& deco, spv::Decoration decoration, uint32_t default_value)
+{
+	return deco.has(decoration) ? deco.get_value<uint32_t>(decoration) : default_value;
 }
 
-static Version get_spirv_version(array_view<uint32_t> spirv_code)
+static const SpvNode* find_type(const SpvParser& parser, spv::Id type_id)
 {
-	if (spirv_code.size() < 5)
-		return Version(0, 0, 0);
-	
-	return Version(
-		(spirv_code[1] >> 16) & 0xFF,
-		(spirv_code[1] >> 8) & 0xFF,
-		0);
+	const auto* node = parser.findNode<SpvNode>(type_id);
+
+	if (node == nullptr)
+		throw Exception("SPIR-V type {} is not defined", type_id);
+
+	return node;
 }
 
-static ReflectionArrayTraits create_array_traits(
-	ShaderReflectionImpl&        impl,
-	const SpvReflectArrayTraits& traits
-) {
-	auto* new_dims        = allocate<uint32_t>(impl, traits.dims_count);
-	auto* new_spec_consts = reinterpret_cast<const ReflectionSpecConstant**>(nullptr);
-	auto* new_is_runtimes = reinterpret_cast<bool*>(nullptr);
-	bool  has_spec_consts = false;
-	bool  has_runtime     = false;
+static const SpvNode* find_pointee_type(const SpvParser& parser, spv::Id pointer_type_id)
+{
+	const auto* node = find_type(parser, pointer_type_id);
 
-	for (uint32_t i = 0; i < traits.dims_count; ++i) {
-		new_dims[i] = traits.dims[i];
-		has_spec_consts |= traits.spec_constant_op_ids[i] != UINT32_MAX;
-		has_runtime     |= traits.dims[i] == 0;
-	}
+	if (node->op != spv::OpTypePointer)
+		throw Exception("SPIR-V type {} is not a pointer type", pointer_type_id);
 
-	if (has_spec_consts) {
-		new_spec_consts = allocate<const ReflectionSpecConstant*>(impl, traits.dims_count);
+	return find_type(parser, node->as<SpvPointerTypeNode>()->typeId);
+}
 
-		for (uint32_t i = 0; i < traits.dims_count; ++i) {
-			new_spec_consts[i] = nullptr;
-			if (traits.spec_constant_op_ids[i] != UINT32_MAX)
-				new_spec_consts[i] = find_spec_constant(
-					impl.specConstants,
-					traits.spec_constant_op_ids[i]);
-		}
-	}
+static bool is_array_type(const SpvNode* type_node)
+{
+	return type_node->op == spv::OpTypeArray || type_node->op == spv::OpTypeRuntimeArray;
+}
 
-	if (has_runtime) {
-		new_is_runtimes = allocate<bool>(impl, traits.dims_count);
-		for (uint32_t i = 0; i < traits.dims_count; ++i)
-			new_is_runtimes[i] = traits.dims[i] == 0;
-	}
+static const ReflectionSpecConstant* find_spec_constant(
+	array_view<ReflectionSpecConstant> spec_constants,
+	uint32_t                           constant_id
+) {
+	for (const auto& spec_const : spec_constants)
+		if (spec_const.constantId == constant_id)
+			return &spec_const;
+	return nullptr;
+}
 
-	return ReflectionArrayTraits(
-		traits.dims_count,
-		traits.stride,
-		new_dims
-	);
+static const ReflectionSpecConstant* find_spec_constant(
+	const ShaderReflectionImpl& impl,
+	const SpvParser&            parser,
+	spv::Id                     length_id
+) {
+	const auto* const_node = parser.findNode<SpvConstantNode>(length_id);
+
+	if (!const_node || const_node->op != spv::OpSpecConstant || !const_node->meta->decoration.has(spv::DecorationSpecId))
+		return nullptr;
+
+	return find_spec_constant(impl.specConstants, const_node->meta->decoration.get_value<uint32_t>(spv::DecorationSpecId));
 }
 
+// strips the arrays off type_node, dims of a binding count descriptors so their stride is one
 static ReflectionArrayTraits create_array_traits(
-	ShaderReflectionImpl&               impl,
-	const SpvReflectBindingArrayTraits& traits
+	ShaderReflectionImpl& impl,
+	const SpvParser&      parser,
+	const SpvNode*&       type_node,
+	bool                  is_binding
 ) {
-	auto* new_dims        = allocate<uint32_t>(impl, traits.dims_count);
-	auto* new_is_runtimes = reinterpret_cast<bool*>(nullptr);
-	bool  has_runtime     = false;
+	uint32_t dim_count = 0;
 
-	for (uint32_t i = 0; i < traits.dims_count; ++i) {
-		new_dims[i] = traits.dims[i];
-		has_runtime     |= traits.dims[i] == 0;
-	}
+	for (const auto* node = type_node; is_array_type(node); node = find_type(parser, node->as<SpvArrayTypeNode>()->elementTypeId))
+		dim_count++;
+
+	if (dim_count == 0)
+		return ReflectionArrayTraits();
+
+	auto*    new_dims        = allocate<uint32_t>(impl, dim_count);
+	auto*    new_spec_consts = allocate<const ReflectionSpecConstant*>(impl, dim_count);
+	auto*    new_is_runtimes = allocate<bool>(impl, dim_count);
+	uint32_t stride          = is_binding ? 1 : 0;
+	bool     has_spec_consts = false;
+	bool     has_runtime     = false;
+
+	for (uint32_t i = 0; i < dim_count; ++i) {
+		const auto* array_node = type_node->as<SpvArrayTypeNode>();
+		const auto& deco       = array_node->meta->decoration;
+
+		new_dims[i]        = array_node->lengthValue;
+		new_spec_consts[i] = find_spec_constant(impl, parser, array_node->lengthId);
+		new_is_runtimes[i] = array_node->op == spv::OpTypeRuntimeArray;
+		has_spec_consts   |= new_spec_consts[i] != nullptr;
+		has_runtime       |= new_is_runtimes[i];
 
-	if (has_runtime) {
-		new_is_runtimes = allocate<bool>(impl, traits.dims_count);
-		for (uint32_t i = 0; i < traits.dims_count; ++i)
-			new_is_runtimes[i] = traits.dims[i] == 0;
+		// the innermost stride is the one of the element
+		if (!is_binding && deco.has(spv::DecorationArrayStride))
+			stride = deco.get_value<uint32_t>(spv::DecorationArrayStride);
+
+		type_node = find_type(parser, array_node->elementTypeId);
 	}
 
 	return ReflectionArrayTraits(
-		traits.dims_count,
-		1,
+		dim_count,
+		stride,
 		new_dims,
-		nullptr,
-		new_is_runtimes
+		has_spec_consts ? new_spec_consts : nullptr,
+		has_runtime ? new_is_runtimes : nullptr
 	);
 }
 
+static uint32_t get_array_size(const ReflectionArrayTraits& traits)
+{
+	uint32_t result = traits.stride();
+
+	for (uint32_t i = 0; i < traits.dims(); ++i)
+		result *= traits[i];
+
+	return result;
+}
+
 static ReflectionInterfaceVariable* create_interface_variable(
-	ShaderReflectionImpl&              impl,
-	const SpvReflectInterfaceVariable& var
+	ShaderReflectionImpl&  impl,
+	const SpvParser&       parser,
+	spv::Id                type_id,
+	std::string_view       name,
+	const spv_decoration&  deco,
+	ReflectionInterfaceIO  io
 ) {
+	const auto* type_node = find_type(parser, type_id);
+
 	auto* new_var = allocate<ReflectionInterfaceVariable>(impl);
 	new_var->stageFlags      = impl.stageFlags;
-	new_var->name            = copy_string(impl, var.name);
-	new_var->location        = var.location;
-	new_var->component       = var.component;
-	new_var->io              = to_interface_io(var.storage_class);
-	new_var->semantic        = copy_string(impl, var.semantic);
-	new_var->decorationFlags = to_decoration_flags(var.decoration_flags);
-	new_var->builtIn         = to_builtin(var.built_in);
-	new_var->format          = to_format(var.format);
-	new_var->arrayTraits     = create_array_traits(impl, var.array);
-
-	if (var.member_count > 0) {
-		auto* member_vars = allocate<const ReflectionInterfaceVariable*>(impl, var.member_count);
-		for (uint32_t i = 0; i < var.member_count; ++i)
-			member_vars[i] = create_interface_variable(impl, var.members[i]);
-		new_var->members = array_view<const ReflectionInterfaceVariable*>(member_vars, var.member_count);
+	new_var->name            = copy_string(impl, name);
+	new_var->location        = get_decoration_value(deco, spv::DecorationLocation, UINT32_MAX);
+	new_var->component       = get_decoration_value(deco, spv::DecorationComponent, UINT32_MAX);
+	new_var->io              = io;
+	new_var->semantic        = deco.has(spv::DecorationUserSemantic) ?
+		copy_string(impl, deco.get_value<std::string_view>(spv::DecorationUserSemantic)) : std::string_view();
+	new_var->decorationFlags = to_decoration_flags(deco);
+	new_var->builtIn         = to_builtin(deco);
+	new_var->arrayTraits     = create_array_traits(impl, parser, type_node, false);
+
+	if (type_node->op == spv::OpTypeStruct) {
+		const auto& members     = type_node->as<SpvStructTypeNode>()->members;
+		auto*       member_vars = allocate<const ReflectionInterfaceVariable*>(impl, members.size());
+
+		for (size_t i = 0; i < members.size(); ++i)
+			member_vars[i] = create_interface_variable(
+				impl,
+				parser,
+				members[i].id,
+				members[i].name,
+				members[i].decoration,
+				io);
+
+		new_var->members = array_view<const ReflectionInterfaceVariable*>(member_vars, members.size());
+	} else if (type_node->op != spv::OpTypePointer) {
+		auto basic_type = type_node->as<SpvBasicTypeNode>()->basicType;
+
+		new_var->primitiveType = to_primitive_type(basic_type, deco.has(spv::DecorationRowMajor));
+		new_var->format        = to_format(basic_type);
 	}
 
 	return new_var;
 }
 
+// Padded sizes reach up to the next member, the last member is padded to the block alignment.
+// Members of blocks ending in a runtime array are not padded.
+static void pad_block_members(ReflectionBlockVariable** members, size_t member_count, bool is_rta)
+{
+	for (size_t i = 0; i < member_count; ++i) {
+		auto*    member      = members[i];
+		uint32_t next_offset = UINT32_MAX;
+
+		for (size_t j = 0; j < member_count; ++j)
+			if (members[j]->offset > member->offset)
+				next_offset = std::min(next_offset, members[j]->offset);
+
+		if (next_offset != UINT32_MAX) {
+			member->paddedSize = next_offset - member->offset;
+		} else {
+			uint32_t end = member->offset + member->size;
+			member->paddedSize = (end + SPIRV_DATA_ALIGNMENT - 1) / SPIRV_DATA_ALIGNMENT * SPIRV_DATA_ALIGNMENT - member->offset;
+		}
+
+		if (member->size > member->paddedSize)
+			member->size = member->paddedSize;
+		if (is_rta)
+			member->paddedSize = member->size;
+	}
+}
+
 static ReflectionBlockVariable* create_block_variable(
-	ShaderReflectionImpl&          impl,
-	const SpvReflectBlockVariable& var
+	ShaderReflectionImpl&  impl,
+	const SpvParser&       parser,
+	spv::Id                type_id,
+	std::string_view       name,
+	const spv_decoration&  deco,
+	uint32_t               parent_offset,
+	bool                   is_parent_aos,
+	bool                   is_rta);
+
+// members of struct_node become members of var, returns the size of the struct
+static uint32_t create_block_members(
+	ShaderReflectionImpl&    impl,
+	const SpvParser&         parser,
+	const SpvStructTypeNode* struct_node,
+	ReflectionBlockVariable* var,
+	bool                     is_aos,
+	bool                     is_rta
 ) {
-	if (var.type_description == nullptr)
-		return nullptr;
+	const auto& members     = struct_node->members;
+	auto*       member_vars = allocate<ReflectionBlockVariable*>(impl, members.size());
+	uint32_t    struct_size = 0;
+
+	for (size_t i = 0; i < members.size(); ++i)
+		member_vars[i] = create_block_variable(
+			impl,
+			parser,
+			members[i].id,
+			members[i].name,
+			members[i].decoration,
+			var->absoluteOffset,
+			is_aos,
+			is_rta);
+
+	pad_block_members(member_vars, members.size(), is_rta);
+
+	for (size_t i = 0; i < members.size(); ++i)
+		struct_size = std::max(struct_size, member_vars[i]->offset + member_vars[i]->paddedSize);
+
+	var->members = array_view<const ReflectionBlockVariable*>(
+		const_cast<const ReflectionBlockVariable**>(member_vars),
+		members.size());
+
+	return struct_size;
+}
+
+static ReflectionBlockVariable* create_block_variable(
+	ShaderReflectionImpl&  impl,
+	const SpvParser&       parser,
+	spv::Id                type_id,
+	std::string_view       name,
+	const spv_decoration&  deco,
+	uint32_t               parent_offset,
+	bool                   is_parent_aos,
+	bool                   is_rta
+) {
+	const auto* type_node = find_type(parser, type_id);
+	uint32_t    offset    = get_decoration_value(deco, spv::DecorationOffset, 0);
 
 	auto* new_var = allocate<ReflectionBlockVariable>(impl);
 	new_var->stageFlags      = impl.stageFlags;
-	new_var->name            = copy_string(impl, var.name);
-	new_var->offset          = var.offset;
-	new_var->absoluteOffset  = var.absolute_offset;
-	new_var->size            = var.size;
-	new_var->paddedSize      = var.padded_size;
-	new_var->decorationFlags = to_decoration_flags(var.decoration_flags);
-	new_var->primitiveType   = parse_primitive_type(var);
-	new_var->arrayTraits     = create_array_traits(impl, var.array);
-
-	if (var.member_count > 0) {
-		auto* member_vars = allocate<const ReflectionBlockVariable*>(impl, var.member_count);
-		for (uint32_t i = 0; i < var.member_count; ++i)
-			member_vars[i] = create_block_variable(impl, var.members[i]);
-		new_var->members = array_view<const ReflectionBlockVariable*>(member_vars, var.member_count);
+	new_var->name            = copy_string(impl, name);
+	new_var->offset          = offset;
+	new_var->absoluteOffset  = is_parent_aos ? 0 : parent_offset + offset;
+	new_var->decorationFlags = to_decoration_flags(deco);
+	new_var->arrayTraits     = create_array_traits(impl, parser, type_node, false);
+
+	bool is_array   = !new_var->arrayTraits.empty();
+	bool is_runtime = is_array && new_var->arrayTraits.isDimRuntime(0);
+
+	if (type_node->op == spv::OpTypeStruct) {
+		uint32_t struct_size = create_block_members(
+			impl,
+			parser,
+			type_node->as<SpvStructTypeNode>(),
+			new_var,
+			is_parent_aos || is_array,
+			is_rta || is_runtime);
+
+		new_var->size = is_array && !is_runtime ? get_array_size(new_var->arrayTraits) : struct_size;
+	} else if (type_node->op == spv::OpTypePointer) {
+		new_var->size = sizeof(uint64_t); // buffer reference
+	} else {
+		auto basic_type = type_node->as<SpvBasicTypeNode>()->basicType;
+
+		new_var->primitiveType = to_primitive_type(basic_type, deco.has(spv::DecorationRowMajor));
+		new_var->size          = is_array ? get_array_size(new_var->arrayTraits) : get_basic_type_size(basic_type, deco);
 	}
 
+	new_var->paddedSize = new_var->size;
+
+	return new_var;
+}
+
+// the variable of a uniform buffer, storage buffer or push constant block
+static ReflectionBlockVariable* create_root_block_variable(
+	ShaderReflectionImpl&    impl,
+	const SpvParser&         parser,
+	const SpvStructTypeNode* struct_node,
+	std::string_view         name,
+	bool                     is_rta
+) {
+	auto* new_var = allocate<ReflectionBlockVariable>(impl);
+	new_var->stageFlags      = impl.stageFlags;
+	new_var->name            = copy_string(impl, name);
+	new_var->offset          = 0;
+	new_var->absoluteOffset  = 0;
+	new_var->decorationFlags = to_decoration_flags(struct_node->meta->decoration);
+	new_var->size            = create_block_members(impl, parser, struct_node, new_var, false, is_rta);
+	new_var->paddedSize      = new_var->size;
+
 	return new_var;
 }
 
 static ReflectionDescriptorBinding* create_descriptor_binding(
-	ShaderReflectionImpl&               impl,
-	const SpvReflectDescriptorBinding&  binding
+	ShaderReflectionImpl&  impl,
+	const SpvParser&       parser,
+	const SpvVariableNode& var
 ) {
+	const auto* type_node = find_pointee_type(parser, var.typeId);
+	const auto& deco      = var.meta->decoration;
+
 	auto* new_binding = allocate<ReflectionDescriptorBinding>(impl);
 	new_binding->stageFlags           = impl.stageFlags;
-	new_binding->name                 = copy_string(impl, binding.name);
-	new_binding->set                  = binding.set;
-	new_binding->binding              = binding.binding;
-	new_binding->inputAttachmentIndex = binding.input_attachment_index;
-	new_binding->descriptorType       = to_descriptor_type(binding.descriptor_type);
-	new_binding->decorationFlags      = to_decoration_flags(binding.decoration_flags);
-	new_binding->arrayTraits          = create_array_traits(impl, binding.array);
-	new_binding->block                = create_block_variable(impl, binding.block);
-	new_binding->elementCount         = binding.count;
-	new_binding->accessed             = binding.accessed;
+	new_binding->set                  = get_decoration_value(deco, spv::DecorationDescriptorSet, 0);
+	new_binding->binding              = get_decoration_value(deco, spv::DecorationBinding, 0);
+	new_binding->inputAttachmentIndex = get_decoration_value(deco, spv::DecorationInputAttachmentIndex, 0);
+	new_binding->decorationFlags      = to_decoration_flags(deco);
+	new_binding->arrayTraits          = create_array_traits(impl, parser, type_node, true);
+	new_binding->descriptorType       = get_descriptor_type(parser, type_node, var.storageClass);
+	new_binding->name                 = copy_string(impl, var.meta->name.empty() ? type_node->meta->name : var.meta->name);
+	new_binding->elementCount         = new_binding->arrayTraits.empty() ? 1 : get_array_size(new_binding->arrayTraits);
+	new_binding->accessed             = var.accessed;
+
+	if (type_node->op == spv::OpTypeStruct) {
+		bool  is_storage = new_binding->descriptorType == DescriptorType::StorageBuffer;
+		auto* block_var  = create_root_block_variable(
+			impl,
+			parser,
+			type_node->as<SpvStructTypeNode>(),
+			new_binding->name,
+			is_storage);
+
+		// the size of a storage buffer is only known at bind time
+		if (is_storage) {
+			block_var->size       = 0;
+			block_var->paddedSize = 0;
+		}
+
+		new_binding->block = block_var;
+	}
 
 	return new_binding;
 }
 
-static void create_shader_reflection_impl(ShaderReflectionImpl& impl, const SpvReflectShaderModule& module)
+static ReflectionBlockVariable* create_push_constant_block(
+	ShaderReflectionImpl&  impl,
+	const SpvParser&       parser,
+	const SpvVariableNode& var
+) {
+	const auto* type_node = find_pointee_type(parser, var.typeId);
+
+	if (type_node->op != spv::OpTypeStruct)
+		throw Exception("push constant variable is not a block");
+
+	auto* block_var = create_root_block_variable(
+		impl,
+		parser,
+		type_node->as<SpvStructTypeNode>(),
+		var.meta->name,
+		true);
+
+	uint32_t min_offset = UINT32_MAX;
+
+	for (const auto* member : block_var->members)
+		min_offset = std::min(min_offset, member->offset);
+
+	block_var->offset = block_var->members.empty() ? 0 : min_offset;
+
+	return block_var;
+}
+
+// builds the lists derived from the reflected variables, shared by parsed and deserialized reflections
+static void finish_shader_reflection_impl(
+	ShaderReflectionImpl&         impl,
+	const ReflectionDescriptorBinding** bindings,
+	size_t                        binding_count
+) {
+	auto*    input_vars  = allocate<const ReflectionInterfaceVariable*>(impl, impl.interfaceVariables.size());
+	auto*    output_vars = allocate<const ReflectionInterfaceVariable*>(impl, impl.interfaceVariables.size());
+	uint32_t input_idx   = 0;
+	uint32_t output_idx  = 0;
+
+	for (const auto* var : impl.interfaceVariables) {
+		if (var->io == ReflectionInterfaceIO::Input) {
+			input_vars[input_idx++] = var;
+		} else if (var->io == ReflectionInterfaceIO::Output) {
+			output_vars[output_idx++] = var;
+		}
+	}
+
+	impl.inputVariables  = array_view(input_vars, input_idx);
+	impl.outputVariables = array_view(output_vars, output_idx);
+
+	std::sort(bindings, bindings + binding_count, [](const auto* lhs, const auto* rhs) {
+		return lhs->set != rhs->set ? lhs->set < rhs->set : lhs->binding < rhs->binding;
+	});
+
+	impl.descriptorBindings = array_view(bindings, binding_count);
+
+	uint32_t set_count = 0;
+
+	for (size_t i = 0; i < binding_count; ++i)
+		if (i == 0 || bindings[i]->set != bindings[i - 1]->set)
+			set_count++;
+
+	auto*    desc_sets = allocate<const ReflectionDescriptorSet*>(impl, set_count);
+	uint32_t set_idx   = 0;
+
+	for (size_t first = 0; first < binding_count;) {
+		size_t last = first + 1;
+
+		while (last < binding_count && bindings[last]->set == bindings[first]->set)
+			last++;
+
+		auto* desc_set = allocate<ReflectionDescriptorSet>(impl);
+		desc_set->stageFlags = impl.stageFlags;
+		desc_set->set        = bindings[first]->set;
+		desc_set->bindings   = array_view(bindings + first, last - first);
+
+		desc_sets[set_idx++] = desc_set;
+		first = last;
+	}
+
+	impl.descriptorSets = array_view(desc_sets, set_count);
+	impl.rootNode       = ReflectionRootNode::create(
+		impl.stageFlags,
+		impl.descriptorSets,
+		impl.pushConstantBlock,
+		&impl.memory);
+}
+
+static void create_shader_reflection_impl(ShaderReflectionImpl& impl, const SpvParser& parser)
 {
-	if (module.entry_point_count > 1)
+	if (parser.entryPoints.empty())
+		throw Exception("SPIR-V module has no entry point");
+	if (parser.entryPoints.size() > 1)
 		throw Exception("multiple entry points are not supported");
 
-	impl.stageFlags     = to_shader_stage(module.shader_stage);
-	impl.entryPointName = copy_string(impl, module.entry_point_name);
+	const auto* entry_point = parser.entryPoints[0];
+
+	impl.spirvVersion   = parser.version;
+	impl.stageFlags     = to_shader_stage(entry_point->executionModel);
+	impl.entryPointName = copy_string(impl, entry_point->entryPointName);
 	impl.localSize      = uint3(
-		module.entry_points[0].local_size.x,
-		module.entry_points[0].local_size.y,
-		module.entry_points[0].local_size.z);
-
-	if (module.spec_constant_count > 0) {
-		auto* spec_constants = allocate<ReflectionSpecConstant>(impl, module.spec_constant_count);
-		
-		for (uint32_t i = 0; i < module.spec_constant_count; ++i) {
-			auto& src = module.spec_constants[i];
-			auto& dst = spec_constants[i];
-
-			dst.name       = copy_string(impl, src.name);
-			dst.constantId = src.constant_id;
-		}
+		entry_point->localSize[0],
+		entry_point->localSize[1],
+		entry_point->localSize[2]);
+
+	uint32_t spec_const_count = 0;
+
+	for (const auto* const_node : parser.specConstants)
+		spec_const_count += const_node->meta->decoration.has(spv::DecorationSpecId);
+
+	auto*    spec_constants = allocate<ReflectionSpecConstant>(impl, spec_const_count);
+	uint32_t spec_const_idx = 0;
 
-		impl.specConstants = array_view(spec_constants, module.spec_constant_count);
+	for (const auto* const_node : parser.specConstants) {
+		if (!const_node->meta->decoration.has(spv::DecorationSpecId)) continue;
+
+		auto& dst = spec_constants[spec_const_idx++];
+		dst.name       = copy_string(impl, const_node->meta->name);
+		dst.constantId = const_node->meta->decoration.get_value<uint32_t>(spv::DecorationSpecId);
 	}
 
-	if (uint32_t var_count = module.interface_variable_count; var_count > 0) {
-		auto* interface_vars = allocate<const ReflectionInterfaceVariable*>(impl, var_count);
-		for (uint32_t i = 0; i < var_count; ++i)
-			interface_vars[i] = create_interface_variable(impl, module.interface_variables[i]);
-		impl.interfaceVariables = array_view(interface_vars, var_count);
-
-		auto*    input_vars  = allocate<const ReflectionInterfaceVariable*>(impl, var_count);
-		auto*    output_vars = allocate<const ReflectionInterfaceVariable*>(impl, var_count);
-		uint32_t input_idx   = 0;
-		uint32_t output_idx  = 0;
-
-		for (const auto& var : impl.interfaceVariables) {
-			if (var->io == ReflectionInterfaceIO::Input) {
-				input_vars[input_idx++] = var;
-			} else if (var->io == ReflectionInterfaceIO::Output) {
-				output_vars[output_idx++] = var;
-			}
-		}
+	impl.specConstants = array_view(spec_constants, spec_const_count);
+
+	auto*    interface_vars = allocate<const ReflectionInterfaceVariable*>(impl, entry_point->interfaceIds.size());
+	uint32_t interface_idx  = 0;
 
-		impl.inputVariables  = array_view(input_vars, input_idx);
-		impl.outputVariables = array_view(output_vars, output_idx);
+	for (spv::Id id : entry_point->interfaceIds) {
+		const auto* var = parser.findNode<SpvVariableNode>(id);
+
+		// since SPIR-V 1.4 every module scope variable a shader uses is listed
+		if (var == nullptr || var->op != spv::OpVariable || to_interface_io(var->storageClass) == ReflectionInterfaceIO::Unknown)
+			continue;
+
+		interface_vars[interface_idx++] = create_interface_variable(
+			impl,
+			parser,
+			find_type(parser, var->typeId)->as<SpvPointerTypeNode>()->typeId,
+			var->meta->name,
+			var->meta->decoration,
+			to_interface_io(var->storageClass));
 	}
 
-	if (uint32_t var_count = module.descriptor_binding_count; var_count > 0) {
-		auto* descriptor_bindings = allocate<const ReflectionDescriptorBinding*>(impl, var_count);
-		for (uint32_t i = 0; i < var_count; ++i)
-			descriptor_bindings[i] = create_descriptor_binding(impl, module.descriptor_bindings[i]);
-		impl.descriptorBindings = array_view(descriptor_bindings, var_count);
-
-		auto*    desc_sets = allocate<const ReflectionDescriptorSet*>(impl, module.descriptor_set_count);
-		uint32_t set_idx = 0;
-
-		for (const auto& src : array_view(module.descriptor_sets, module.descriptor_set_count)) {
-			auto*    bindings    = allocate<const ReflectionDescriptorBinding*>(impl, src.binding_count);
-			uint32_t binding_idx = 0;
-
-			for (auto* binding : impl.descriptorBindings) {
-				if (binding->set == src.set) {
-					bindings[binding_idx++] = binding;
-				} else if (binding->set > src.set) {
-					break; // early out
-				}
-			}
+	impl.interfaceVariables = array_view(interface_vars, interface_idx);
 
-			auto* desc_set = allocate<ReflectionDescriptorSet>(impl);
-			desc_set->stageFlags = impl.stageFlags;
-			desc_set->set        = src.set;
-			desc_set->bindings   = array_view(bindings, src.binding_count);
+	auto*    bindings          = allocate<const ReflectionDescriptorBinding*>(impl, parser.variables.size());
+	uint32_t binding_count     = 0;
+	impl.pushConstantBlock     = nullptr;
 
-			desc_sets[set_idx++] = desc_set;
+	for (const auto* var : parser.variables) {
+		switch (var->storageClass) {
+		case spv::StorageClassUniformConstant:
+		case spv::StorageClassUniform:
+		case spv::StorageClassStorageBuffer:
+			bindings[binding_count++] = create_descriptor_binding(impl, parser, *var);
+			break;
+		case spv::StorageClassPushConstant:
+			if (impl.pushConstantBlock)
+				throw Exception("multiple push constant blocks are not supported");
+			impl.pushConstantBlock = create_push_constant_block(impl, parser, *var);
+			break;
 		}
+	}
+
+	finish_shader_reflection_impl(impl, bindings, binding_count);
+}
+
+static void write_array_traits(
+	ByteWriter&                        writer,
+	array_view<ReflectionSpecConstant> spec_constants,
+	const ReflectionArrayTraits&       traits
+) {
+	writer.u32(traits.dims());
+	writer.u32(traits.stride());
+
+	for (uint32_t i = 0; i < traits.dims(); ++i) {
+		const auto* spec_const = traits.getDimSpecConstant(i);
 
-		impl.descriptorSets = array_view(desc_sets, module.descriptor_set_count);
+		writer.u32(traits[i]);
+		writer.u32(spec_const ? spec_const->constantId : UINT32_MAX);
+		writer.u8(traits.isDimRuntime(i));
 	}
+}
+
+static ReflectionArrayTraits read_array_traits(ShaderReflectionImpl& impl, ByteReader& reader)
+{
+	uint32_t dim_count = reader.count(9);
+	uint32_t stride    = reader.u32();
+
+	if (dim_count == 0)
+		return ReflectionArrayTraits();
+
+	auto* new_dims        = allocate<uint32_t>(impl, dim_count);
+	auto* new_spec_consts = allocate<const ReflectionSpecConstant*>(impl, dim_count);
+	auto* new_is_runtimes = allocate<bool>(impl, dim_count);
+	bool  has_spec_consts = false;
+	bool  has_runtime     = false;
+
+	for (uint32_t i = 0; i < dim_count; ++i) {
+		uint32_t constant_id = 0;
 
-	if (module.push_constant_block_count == 0) {
-		impl.pushConstantBlock = nullptr;
-	} else if (module.push_constant_block_count == 1) {
-		impl.pushConstantBlock = create_block_variable(impl, module.push_constant_blocks[0]);
-	} else if (module.push_constant_block_count > 1) {
-		throw Exception("multiple push constant blocks are not supported");
+		new_dims[i]        = reader.u32();
+		constant_id        = reader.u32();
+		new_spec_consts[i] = constant_id != UINT32_MAX ? find_spec_constant(impl.specConstants, constant_id) : nullptr;
+		new_is_runtimes[i] = reader.u8() != 0;
+		has_spec_consts   |= new_spec_consts[i] != nullptr;
+		has_runtime       |= new_is_runtimes[i];
 	}
+
+	return ReflectionArrayTraits(
+		dim_count,
+		stride,
+		new_dims,
+		has_spec_consts ? new_spec_consts : nullptr,
+		has_runtime ? new_is_runtimes : nullptr
+	);
 }
 
-static size_t hash_shader_code(array_view<uint32_t> spirv_code)
+static void write_interface_variable(
+	ByteWriter&                        writer,
+	array_view<ReflectionSpecConstant> spec_constants,
+	const ReflectionInterfaceVariable& var
+) {
+	writer.str(var.name);
+	writer.u32(var.location);
+	writer.u32(var.component);
+	writer.u32(static_cast<uint32_t>(var.io));
+	writer.str(var.semantic);
+	writer.u64(var.decorationFlags.mask());
+	writer.u32(static_cast<uint32_t>(var.builtIn));
+	writer.u32(static_cast<uint32_t>(var.primitiveType));
+	writer.u32(static_cast<uint32_t>(var.format));
+	write_array_traits(writer, spec_constants, var.arrayTraits);
+
+	writer.u32(static_cast<uint32_t>(var.members.size()));
+	for (const auto* member : var.members)
+		write_interface_variable(writer, spec_constants, *member);
+}
+
+static const ReflectionInterfaceVariable* read_interface_variable(ShaderReflectionImpl& impl, ByteReader& reader)
 {
-	size_t seed = 0;
+	auto* new_var = allocate<ReflectionInterfaceVariable>(impl);
+	new_var->stageFlags      = impl.stageFlags;
+	new_var->name            = copy_string(impl, reader.str());
+	new_var->location        = reader.u32();
+	new_var->component       = reader.u32();
+	new_var->io              = read_enum<ReflectionInterfaceIO>(reader);
+	new_var->semantic        = copy_string(impl, reader.str());
+	new_var->decorationFlags = ReflectionDecorationFlags(reader.u64());
+	new_var->builtIn         = read_enum<ReflectionBuiltIn>(reader);
+	new_var->primitiveType   = read_enum<ReflectionPrimitiveType>(reader);
+	new_var->format          = read_enum<Format>(reader);
+	new_var->arrayTraits     = read_array_traits(impl, reader);
+
+	uint32_t member_count = reader.count(48);
+	auto*    member_vars  = allocate<const ReflectionInterfaceVariable*>(impl, member_count);
 
-	for (uint32_t word : spirv_code)
-		hash_combine(seed, word);
+	for (uint32_t i = 0; i < member_count; ++i)
+		member_vars[i] = read_interface_variable(impl, reader);
 
-	return seed;
+	new_var->members = array_view(member_vars, member_count);
+
+	return new_var;
 }
 
-obj<ShaderReflection> ShaderReflection::create(obj<Device> device, cref<Shader> shader)
+static void write_block_variable(
+	ByteWriter&                        writer,
+	array_view<ReflectionSpecConstant> spec_constants,
+	const ReflectionBlockVariable&     var
+) {
+	writer.str(var.name);
+	writer.u32(var.offset);
+	writer.u32(var.absoluteOffset);
+	writer.u32(var.size);
+	writer.u32(var.paddedSize);
+	writer.u64(var.decorationFlags.mask());
+	writer.u32(static_cast<uint32_t>(var.primitiveType));
+	write_array_traits(writer, spec_constants, var.arrayTraits);
+
+	writer.u32(static_cast<uint32_t>(var.members.size()));
+	for (const auto* member : var.members)
+		write_block_variable(writer, spec_constants, *member);
+}
+
+static const ReflectionBlockVariable* read_block_variable(ShaderReflectionImpl& impl, ByteReader& reader)
 {
-	auto& device_impl = getImpl(device);
-	auto& shader_impl = getImpl(shader);
-	auto  hash_value  = shader_impl.hashValue;
+	auto* new_var = allocate<ReflectionBlockVariable>(impl);
+	new_var->stageFlags      = impl.stageFlags;
+	new_var->name            = copy_string(impl, reader.str());
+	new_var->offset          = reader.u32();
+	new_var->absoluteOffset  = reader.u32();
+	new_var->size            = reader.u32();
+	new_var->paddedSize      = reader.u32();
+	new_var->decorationFlags = ReflectionDecorationFlags(reader.u64());
+	new_var->primitiveType   = read_enum<ReflectionPrimitiveType>(reader);
+	new_var->arrayTraits     = read_array_traits(impl, reader);
 
-	// TODO: more specific exception
-	if (device != shader_impl.device)
-		throw Exception("device mismatch");
+	uint32_t member_count = reader.count(40);
+	auto*    member_vars  = allocate<const ReflectionBlockVariable*>(impl, member_count);
 
-	if (auto cached_obj = device_impl.findCachedObject<ShaderReflection>(hash_value))
-		return cached_obj;
+	for (uint32_t i = 0; i < member_count; ++i)
+		member_vars[i] = read_block_variable(impl, reader);
 
-	auto  obj  = createNewCoreObject<ShaderReflection>();
-	auto& impl = getImpl(obj);
+	new_var->members = array_view(member_vars, member_count);
 
-	StopWatch sw0, sw1;
+	return new_var;
+}
+
+// Everything but the lists finish_shader_reflection_impl derives. Strings are length prefixed
+// and trees are written depth first, a blob is only read back by the same version of this code.
+static std::vector<uint8_t> serialize_shader_reflection(const ShaderReflectionImpl& impl)
+{
+	ByteWriter writer;
+
+	writer.u32(SHADER_REFLECTION_VERSION);
+	writer.u32(impl.stageFlags.mask());
+	writer.u32(impl.spirvVersion.major);
+	writer.u32(impl.spirvVersion.minor);
+	writer.str(impl.entryPointName);
+	writer.u32(impl.localSize.x);
+	writer.u32(impl.localSize.y);
+	writer.u32(impl.localSize.z);
+
+	writer.u32(static_cast<uint32_t>(impl.specConstants.size()));
+	for (const auto& spec_const : impl.specConstants) {
+		writer.str(spec_const.name);
+		writer.u32(spec_const.constantId);
+	}
 
-	sw0.start();
-	spv_reflect::ShaderModule module(
-		shader_impl.spirvCode.size() * sizeof(uint32_t),
-		shader_impl.spirvCode.data(),
-		SPV_REFLECT_MODULE_FLAG_NO_COPY);
-	sw0.stop();
+	writer.u32(static_cast<uint32_t>(impl.interfaceVariables.size()));
+	for (const auto* var : impl.interfaceVariables)
+		write_interface_variable(writer, impl.specConstants, *var);
+
+	writer.u32(static_cast<uint32_t>(impl.descriptorBindings.size()));
+	for (const auto* binding : impl.descriptorBindings) {
+		writer.str(binding->name);
+		writer.u32(binding->set);
+		writer.u32(binding->binding);
+		writer.u32(binding->inputAttachmentIndex);
+		writer.u32(static_cast<uint32_t>(binding->descriptorType));
+		writer.u64(binding->decorationFlags.mask());
+		write_array_traits(writer, impl.specConstants, binding->arrayTraits);
+		writer.u32(binding->elementCount);
+		writer.u8(binding->accessed);
+		writer.u8(binding->block != nullptr);
+
+		if (binding->block)
+			write_block_variable(writer, impl.specConstants, *binding->block);
+	}
+
+	writer.u8(impl.pushConstantBlock != nullptr);
+	if (impl.pushConstantBlock)
+		write_block_variable(writer, impl.specConstants, *impl.pushConstantBlock);
 
-	impl.device       = std::move(device);
-	impl.spirvVersion = get_spirv_version(shader_impl.spirvCode);
-	impl.rootNode     = ReflectionRootNode::create(module, &impl.memory);
-	impl.hashValue    = hash_value;
+	return std::move(writer.data());
+}
 
-	sw1.start();
-	create_shader_reflection_impl(impl, module.GetShaderModule());
-	sw1.stop();
+static bool deserialize_shader_reflection(ShaderReflectionImpl& impl, array_view<uint8_t> bytes)
+{
+	ByteReader reader(bytes);
 
-	Logger::info(
-		"ShaderReflection created: SPIR-V parsing time = {} ms, reflection creation time = {} ms",
-		sw0.get_ms(),
-		sw1.get_ms());
+	if (reader.u32() != SHADER_REFLECTION_VERSION)
+		return false;
 
-	device_impl.registerCachedObject<ShaderReflection>(hash_value, obj);
+	impl.stageFlags     = read_flags<ShaderStageFlags>(reader);
+	impl.spirvVersion   = Version(reader.u32(), reader.u32(), 0);
+	impl.entryPointName = copy_string(impl, reader.str());
+	impl.localSize.x    = reader.u32();
+	impl.localSize.y    = reader.u32();
+	impl.localSize.z    = reader.u32();
 
-	return obj;
+	uint32_t spec_const_count = reader.count(8);
+	auto*    spec_constants   = allocate<ReflectionSpecConstant>(impl, spec_const_count);
+
+	for (uint32_t i = 0; i < spec_const_count; ++i) {
+		spec_constants[i].name       = copy_string(impl, reader.str());
+		spec_constants[i].constantId = reader.u32();
+	}
+
+	impl.specConstants = array_view(spec_constants, spec_const_count);
+
+	uint32_t var_count      = reader.count(48);
+	auto*    interface_vars = allocate<const ReflectionInterfaceVariable*>(impl, var_count);
+
+	for (uint32_t i = 0; i < var_count; ++i)
+		interface_vars[i] = read_interface_variable(impl, reader);
+
+	impl.interfaceVariables = array_view(interface_vars, var_count);
+
+	uint32_t binding_count = reader.count(38);
+	auto*    bindings      = allocate<const ReflectionDescriptorBinding*>(impl, binding_count);
+
+	for (uint32_t i = 0; i < binding_count; ++i) {
+		auto* new_binding = allocate<ReflectionDescriptorBinding>(impl);
+		new_binding->stageFlags           = impl.stageFlags;
+		new_binding->name                 = copy_string(impl, reader.str());
+		new_binding->set                  = reader.u32();
+		new_binding->binding              = reader.u32();
+		new_binding->inputAttachmentIndex = reader.u32();
+		new_binding->descriptorType       = read_enum<DescriptorType>(reader);
+		new_binding->decorationFlags      = ReflectionDecorationFlags(reader.u64());
+		new_binding->arrayTraits          = read_array_traits(impl, reader);
+		new_binding->elementCount         = reader.u32();
+		new_binding->accessed             = reader.u8() != 0;
+		new_binding->block                = reader.u8() ? read_block_variable(impl, reader) : nullptr;
+
+		bindings[i] = new_binding;
+	}
+
+	impl.pushConstantBlock = reader.u8() ? read_block_variable(impl, reader) : nullptr;
+
+	if (reader.failed() || !reader.atEnd())
+		return false;
+
+	finish_shader_reflection_impl(impl, bindings, binding_count);
+
+	return true;
+}
+
+static hash128_t hash_shader_code(array_view<uint32_t> spirv_code)
+{
+	return hash_bytes_128(spirv_code.data(), spirv_code.size() * sizeof(uint32_t));
+}
+
+obj<ShaderReflection> ShaderReflection::create(obj<Device> device, cref<Shader> shader)
+{
+	auto& shader_impl = getImpl(shader);
+
+	// TODO: more specific exception
+	if (device != shader_impl.device)
+		throw Exception("device mismatch");
+
+	return shader_impl.shaderReflection;
 }
 
 obj<ShaderReflection> ShaderReflection::create(obj<Device> device, array_view<uint32_t> spirv_code)
 {
-	auto&  device_impl = getImpl(device);
-	hash_t hash_value  = hash_shader_code(spirv_code);
+	return create(std::move(device), spirv_code, hash_shader_code(spirv_code));
+}
 
-	if (auto cached_obj = device_impl.findCachedObject<ShaderReflection>(hash_value))
-		return cached_obj;
+obj<ShaderReflection> ShaderReflection::create(obj<Device> device, array_view<uint32_t> spirv_code, const hash128_t& code_key)
+{
+	auto& device_impl = getImpl(device);
 
-	auto  obj  = createNewCoreObject<ShaderReflection>();
-	auto& impl = getImpl(obj);
+	auto create_reflection = [&]() {
+		auto  obj  = createNewCoreObject<ShaderReflection>();
+		auto& impl = getImpl(obj);
 
-	StopWatch sw0, sw1;
+		impl.device    = device;
+		impl.hashValue = code_key.low;
+		impl.codeKey   = code_key;
 
-	sw0.start();
-	spv_reflect::ShaderModule module(
-		spirv_code.size() * sizeof(uint32_t),
-		spirv_code.data(),
-		SPV_REFLECT_MODULE_FLAG_NO_COPY);
-	sw0.stop();
+		if (device_impl.reflectionCache) {
+			std::vector<uint8_t> bytes;
 
-	impl.device       = std::move(device);
-	impl.spirvVersion = get_spirv_version(spirv_code);
-	impl.rootNode     = ReflectionRootNode::create(module, &impl.memory);
-	impl.hashValue    = hash_value;
+			// a blob that fails to read only wastes some of the arena
+			if (!device_impl.reflectionCache->find(code_key, bytes) || !deserialize_shader_reflection(impl, bytes)) {
+				create_shader_reflection_impl(impl, SpvParser(spirv_code));
+				device_impl.reflectionCache->record(code_key, serialize_shader_reflection(impl));
+			}
+		} else {
+			create_shader_reflection_impl(impl, SpvParser(spirv_code));
+		}
 
-	sw1.start();
-	create_shader_reflection_impl(impl, module.GetShaderModule());
-	sw1.stop();
+		return obj;
+	};
 
-	Logger::info(
-		"ShaderReflection created: SPIR-V parsing time = {} ms, reflection creation time = {} ms",
-		sw0.get_ms(),
-		sw1.get_ms());
+	auto reflection = device_impl.acquireCachedObject<ShaderReflection>(code_key.low, create_reflection);
 
-	device_impl.registerCachedObject<ShaderReflection>(hash_value, obj);
+	// the cache is keyed by the low half of the code key, a reflection of other code sharing it
+	// keeps its entry and this one is created outside of the cache
+	if (getImpl(reflection).codeKey != code_key)
+		return create_reflection();
 
-	return obj;
+	return reflection;
 }
 
 ShaderReflection::~ShaderReflection() VERA_NOEXCEPT
@@ -819,7 +1189,7 @@ ShaderReflection::~ShaderReflection() VERA_NOEXCEPT
 	auto& impl        = getImpl(this);
 	auto& device_impl = getImpl(impl.device);
 
-	device_impl.unregisterCachedObject<ShaderReflection>(impl.hashValue);
+	device_impl.unregisterCachedObject<ShaderReflection>(impl.hashValue, this);
 
 	destroyObjectImpl(this);
 }
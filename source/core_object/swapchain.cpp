@@ -135,6 +135,7 @@ static void prepare_framebuffer(DeviceImpl& device_impl, SwapchainImpl& impl)
 		texture_impl.width        = impl.width;
 		texture_impl.height       = impl.height;
 		texture_impl.depth        = 1;
+		texture_impl.mipLevels    = 1;
 
 		// create image view
 		texture->getTextureView();
@@ -7,9 +7,8 @@
 #include "../../include/vera/core/device.h"
 #include "../../include/vera/core/device_memory.h"
 #include "../../include/vera/core/texture_view.h"
-#include "../../include/vera/core/buffer.h"
-#include "../../include/vera/core/command_buffer.h"
 #include "../../include/vera/graphics/image.h"
+#include "../../include/vera/graphics/mip_image.h"
 
 VERA_NAMESPACE_BEGIN
 
@@ -69,27 +68,6 @@ static uint32_t find_texture_bind_idx(DeviceMemoryImpl& impl, Texture* this_ptr)
 	return static_cast<uint32_t>(iter - impl.resourceBind.cbegin());
 }
 
-static void allocate_device_memory(
-	DeviceMemoryImpl&   impl,
-	obj<Device>         device,
-	vk::Image           image,
-	MemoryPropertyFlags flags
-) {
-	auto& device_impl    = CoreObject::getImpl(device);
-	auto  req            = device_impl.vkDevice.getImageMemoryRequirements(image);
-
-	vk::MemoryAllocateInfo info;
-	info.allocationSize  = req.size;
-	info.memoryTypeIndex = device_impl.findMemoryTypeIndex(flags, req.memoryTypeBits);
-
-	impl.device        = std::move(device);
-	impl.vkMemory      = device_impl.vkDevice.allocateMemory(info);
-	impl.propertyFlags = flags;
-	impl.allocated     = info.allocationSize;
-	impl.typeIndex     = info.memoryTypeIndex;
-	impl.mapPtr        = nullptr;
-}
-
 const vk::Image& get_vk_image(cref<Texture> texture) VERA_NOEXCEPT
 {
 	return CoreObject::getImpl(texture).vkImage;
@@ -150,16 +128,28 @@ obj<Texture> Texture::create(obj<Device> device, const Image & image)
 	return obj;
 }
 
+obj<Texture> Texture::create(obj<Device> device, const MipImage& image)
+{
+	auto obj = create(device, TextureCreateInfo{
+		.type       = TextureType::Texture2D,
+		.format     = image.format(),
+		.width      = image.width(),
+		.height     = image.height(),
+		.mipLevels  = image.levelCount(),
+	});
+
+	obj->upload(image);
+
+	return obj;
+}
+
 obj<Texture> Texture::create(obj<Device> device, const TextureCreateInfo& info)
 {
 	auto  obj         = createNewCoreObject<Texture>();
-	auto  memory_obj  = createNewCoreObject<DeviceMemory>();
 	auto& impl        = getImpl(obj);
-	auto& memory_impl = getImpl(memory_obj);
 	auto  vk_device   = get_vk_device(device);
 
 	impl.device        = std::move(device);
-	impl.deviceMemory  = std::move(memory_obj);
 	impl.textureFormat = info.format;
 	impl.textureUsage  = info.usage ? info.usage : get_image_usage_flags(info.format);
 	impl.textureAspect = TextureAspectFlagBits::Color;
@@ -167,6 +157,7 @@ obj<Texture> Texture::create(obj<Device> device, const TextureCreateInfo& info)
 	impl.width         = info.width;
 	impl.height        = info.height;
 	impl.depth         = info.depth;
+	impl.mipLevels     = info.mipLevels;
 
 	vk::ImageCreateInfo image_info;
 	image_info.imageType     = get_image_type(info);
@@ -183,21 +174,30 @@ obj<Texture> Texture::create(obj<Device> device, const TextureCreateInfo& info)
 
 	impl.vkImage = vk_device.createImage(image_info);
 
-	allocate_device_memory(
-		memory_impl,
+	auto req        = vk_device.getImageMemoryRequirements(impl.vkImage);
+	auto allocation = allocate_device_memory(
 		impl.device,
-		impl.vkImage,
-		MemoryPropertyFlagBits::DeviceLocal);
-
-	auto& binding = memory_impl.resourceBind.emplace_back();
-	binding.resourceType = MemoryResourceType::Texture;
-	binding.size         = memory_impl.allocated;
-	binding.offset       = 0;
-	binding.resourcePtr  = obj.get();
-
-	impl.size = memory_impl.allocated;
+		req,
+		MemoryPropertyFlagBits::DeviceLocal,
+		MemoryResourceType::Texture);
+
+	auto& memory_impl = getImpl(allocation.memory);
+
+	impl.deviceMemory = std::move(allocation.memory);
+	impl.memoryOffset = allocation.offset;
+	impl.allocationID = allocation.allocationID;
+	impl.size         = req.size;
+
+	// shared blocks are never resized, so only dedicated memory tracks its bindings
+	if (!memory_impl.allocator) {
+		auto& binding = memory_impl.resourceBind.emplace_back();
+		binding.resourceType = MemoryResourceType::Texture;
+		binding.size         = impl.size;
+		binding.offset       = impl.memoryOffset;
+		binding.resourcePtr  = obj.get();
+	}
 
-	vk_device.bindImageMemory(impl.vkImage, memory_impl.vkMemory, 0);
+	vk_device.bindImageMemory(impl.vkImage, memory_impl.vkMemory, impl.memoryOffset);
 
 	return obj;
 }
@@ -213,9 +213,13 @@ Texture::~Texture() VERA_NOEXCEPT
 
 	impl.textureView.reset();
 
-	auto idx = find_texture_bind_idx(memory_impl, this);
-	std::swap(memory_impl.resourceBind[idx], memory_impl.resourceBind.back());
-	memory_impl.resourceBind.pop_back();
+	if (memory_impl.allocator) {
+		free_device_memory(memory_impl, impl.allocationID);
+	} else {
+		auto idx = find_texture_bind_idx(memory_impl, this);
+		std::swap(memory_impl.resourceBind[idx], memory_impl.resourceBind.back());
+		memory_impl.resourceBind.pop_back();
+	}
 
 	vk_device.destroy(impl.vkImage);
 
@@ -224,46 +228,16 @@ Texture::~Texture() VERA_NOEXCEPT
 
 void Texture::upload(const Image& image)
 {
-	auto& impl           = getImpl(this);
-	auto  image_size     = image.size();
-	auto  staging_buffer = Buffer::createStaging(impl.device, image_size);
-	auto  command_buffer = CommandBuffer::create(impl.device);
-	auto  buffer_memory  = staging_buffer->getDeviceMemory();
-
-	auto* map = buffer_memory->map();
-	memcpy(map, image.data(), image_size);
-	buffer_memory->flush();
-
-	command_buffer->begin();
-	command_buffer->transitionImageLayout(
-		ref<Texture>(this),
-		vr::PipelineStageFlagBits::TopOfPipe,
-		vr::PipelineStageFlagBits::Transfer,
-		vr::AccessFlagBits{},
-		vr::AccessFlagBits::TransferWrite,
-		vr::TextureLayout::Undefined,
-		vr::TextureLayout::TransferDstOptimal);
-
-	command_buffer->copyBufferToTexture(
-		ref<Texture>(this),
-		staging_buffer,
-		0,
-		0,
-		0,
-		uint3(),
-		extent3d(impl.width, impl.height, impl.depth));
-
-	command_buffer->transitionImageLayout(
-		ref<Texture>(this),
-		vr::PipelineStageFlagBits::Transfer,
-		vr::PipelineStageFlagBits::FragmentShader,
-		vr::AccessFlagBits::TransferWrite,
-		vr::AccessFlagBits::ShaderRead,
-		vr::TextureLayout::TransferDstOptimal,
-		vr::TextureLayout::ShaderReadOnlyOptimal);
-	command_buffer->end();
-
-	command_buffer->submit().wait();
+	auto& impl = getImpl(this);
+
+	getImpl(impl.device).stagingUploader->uploadTexture(this, image.data(), image.size());
+}
+
+void Texture::upload(const MipImage& image)
+{
+	auto& impl = getImpl(this);
+
+	getImpl(impl.device).stagingUploader->uploadTexture(this, image.data(), image.size(), image.levelOffsets());
 }
 
 obj<Device> Texture::getDevice()
@@ -295,7 +269,7 @@ ref<TextureView> Texture::getTextureView()
 		view_info.components.a                    = vk::ComponentSwizzle::eIdentity;
 		view_info.subresourceRange.aspectMask     = to_vk_image_aspect_flags(impl.textureAspect);
 		view_info.subresourceRange.baseMipLevel   = 0;
-		view_info.subresourceRange.levelCount     = 1;
+		view_info.subresourceRange.levelCount     = impl.mipLevels;
 		view_info.subresourceRange.baseArrayLayer = 0;
 		view_info.subresourceRange.layerCount     = 1;
 
@@ -337,6 +311,11 @@ uint32_t Texture::depth() const
 	return getImpl(this).depth;
 }
 
+uint32_t Texture::mipLevels() const
+{
+	return getImpl(this).mipLevels;
+}
+
 extent3d Texture::extent() const
 {
 	auto& impl = getImpl(this);
@@ -428,4 +428,104 @@ bool format_has_alpha(Format format)
 	return false;
 }
 
+bool format_is_srgb(Format format)
+{
+	switch (format) {
+	case Format::R8Srgb:
+	case Format::RG8Srgb:
+	case Format::RGB8Srgb:
+	case Format::BGR8Srgb:
+	case Format::RGBA8Srgb:
+	case Format::BGRA8Srgb:
+	case Format::ABGR8SrgbPack32:
+		return true;
+	}
+
+	return false;
+}
+
+bool format_is_unorm(Format format)
+{
+	switch (format) {
+	case Format::R8Unorm:
+	case Format::R8Srgb:
+	case Format::R16Unorm:
+	case Format::RG8Unorm:
+	case Format::RG8Srgb:
+	case Format::RG16Unorm:
+	case Format::RGB8Unorm:
+	case Format::RGB8Srgb:
+	case Format::BGR8Unorm:
+	case Format::BGR8Srgb:
+	case Format::RGB16Unorm:
+	case Format::RGBA8Unorm:
+	case Format::RGBA8Srgb:
+	case Format::BGRA8Unorm:
+	case Format::BGRA8Srgb:
+	case Format::RGBA16Unorm:
+	case Format::RG4UnormPack8:
+	case Format::RGBA4UnormPack16:
+	case Format::BGRA4UnormPack16:
+	case Format::R5G6B5UnormPack16:
+	case Format::B5G6R5UnormPack16:
+	case Format::R5G5B5A1UnormPack16:
+	case Format::B5G5R5A1UnormPack16:
+	case Format::A1R5G5B5UnormPack16:
+	case Format::A4R4G4B4UnormPack16:
+	case Format::A4B4G4R4UnormPack16:
+	case Format::A1B5G5R5UnormPack16:
+	case Format::ABGR8UnormPack32:
+	case Format::ABGR8SrgbPack32:
+	case Format::A2RGB10UnormPack32:
+	case Format::A2BGR10UnormPack32:
+	case Format::A8Unorm:
+		return true;
+	}
+
+	return false;
+}
+
+bool format_is_snorm(Format format)
+{
+	switch (format) {
+	case Format::R8Snorm:
+	case Format::R16Snorm:
+	case Format::RG8Snorm:
+	case Format::RG16Snorm:
+	case Format::RGB8Snorm:
+	case Format::BGR8Snorm:
+	case Format::RGB16Snorm:
+	case Format::RGBA8Snorm:
+	case Format::BGRA8Snorm:
+	case Format::RGBA16Snorm:
+	case Format::ABGR8SnormPack32:
+	case Format::A2RGB10SnormPack32:
+	case Format::A2BGR10SnormPack32:
+		return true;
+	}
+
+	return false;
+}
+
+bool format_is_float(Format format)
+{
+	switch (format) {
+	case Format::R16Float:
+	case Format::R32Float:
+	case Format::R64Float:
+	case Format::RG16Float:
+	case Format::RG32Float:
+	case Format::RG64Float:
+	case Format::RGB16Float:
+	case Format::RGB32Float:
+	case Format::RGB64Float:
+	case Format::RGBA16Float:
+	case Format::RGBA32Float:
+	case Format::RGBA64Float:
+		return true;
+	}
+
+	return false;
+}
+
 VERA_NAMESPACE_END
\ No newline at end of file
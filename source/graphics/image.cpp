@@ -54,6 +54,7 @@ static void free_impl(void* ptr)
 #include "../../include/vera/core/exception.h"
 #include "../../include/vera/core/assertion.h"
 #include "../../include/vera/graphics/format_traits.h"
+#include "../../include/vera/graphics/image_stream.h"
 #include <stb_image.h>
 #include <stb_image_write.h>
 #include <fstream>
@@ -134,13 +135,12 @@ Image Image::loadFromFile(std::string_view path)
 
 Image Image::loadFromFile(uint32_t width, uint32_t height, Format format, std::string_view path)
 {
-	// TODO: implement
-	return Image();
+	return ImageReader(path, width, height, format).read();
 }
 
 Image Image::loadFromMemory(uint32_t width, uint32_t height, Format format, void* ptr, size_t size)
 {
-	VERA_ASSERT(width * height * get_format_size(format) <= size);
+	VERA_ASSERT(static_cast<size_t>(width) * height * get_format_size(format) <= size);
 
 	Image result;
 	result.m_width     = width;
@@ -166,25 +166,45 @@ Image::Image(uint32_t width, uint32_t height, Format format) :
 	m_width(width),
 	m_height(height),
 	m_format(format),
-	m_allocated(width* height* get_format_size(format)),
+	m_allocated(static_cast<size_t>(width) * height * get_format_size(format)),
 	m_ptr(malloc_impl(m_allocated)) {}
 
 Image::Image(uint32_t width, uint32_t height, Format format, const void* ptr) :
 	m_width(width),
 	m_height(height),
 	m_format(format),
-	m_allocated(width* height* get_format_size(format)),
+	m_allocated(static_cast<size_t>(width) * height * get_format_size(format)),
 	m_ptr(malloc_impl(m_allocated))
 {
 	memcpy(m_ptr, ptr, m_allocated);
 }
 
+Image::Image(ConstImageView view) :
+	Image()
+{
+	if (view.empty()) return;
+
+	const size_t row_size = view.rowSize();
+
+	m_width     = view.width();
+	m_height    = view.height();
+	m_format    = view.format();
+	m_allocated = row_size * m_height;
+	m_ptr       = malloc_impl(m_allocated);
+
+	auto* dst = reinterpret_cast<uint8_t*>(m_ptr);
+
+	if (view.isContiguous()) {
+		memcpy(dst, view.data(), m_allocated);
+		return;
+	}
+
+	for (uint32_t y = 0; y < m_height; ++y)
+		memcpy(dst + row_size * y, view.row(y), row_size);
+}
+
 Image::Image(const Image& rhs) :
-	m_width(0),
-	m_height(0),
-	m_format(Format::Unknown),
-	m_allocated(0),
-	m_ptr(nullptr) {}
+	Image(rhs.view()) {}
 
 Image::Image(Image&& rhs) noexcept :
 	m_width(std::exchange(rhs.m_width, 0)),
@@ -239,9 +259,24 @@ void Image::clear()
 	free_impl(std::exchange(m_ptr, nullptr));
 }
 
+void Image::resize(uint32_t width, uint32_t height, Format format)
+{
+	auto new_size = static_cast<size_t>(width) * height * get_format_size(format);
+
+	m_width  = width;
+	m_height = height;
+	m_format = format;
+
+	if (m_allocated < new_size) {
+		free_impl(m_ptr);
+		m_ptr       = malloc_impl(new_size);
+		m_allocated = new_size;
+	}
+}
+
 size_t Image::size() const
 {
-	return m_width * m_height * get_format_size(m_format);
+	return static_cast<size_t>(m_width) * m_height * get_format_size(m_format);
 }
 
 size_t Image::capacity() const
@@ -274,6 +309,26 @@ const void* Image::data() const
 	return m_ptr;
 }
 
+ImageView Image::view()
+{
+	return ImageView(m_ptr, m_width, m_height, m_format);
+}
+
+ConstImageView Image::view() const
+{
+	return ConstImageView(m_ptr, m_width, m_height, m_format);
+}
+
+ImageView Image::view(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+	return view().subview(x, y, width, height);
+}
+
+ConstImageView Image::view(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const
+{
+	return view().subview(x, y, width, height);
+}
+
 void Image::saveToFile(std::string_view path)
 {
 	if (!m_ptr)
@@ -283,13 +338,13 @@ void Image::saveToFile(std::string_view path)
 	auto extension = file_path.extension().generic_string();
 	int  comp      = get_format_component_count(m_format);
 
-	if (extension == "png") {
+	if (extension == ".png") {
 		if (!stbi_write_png(path.data(), m_width, m_height, comp, m_ptr, 0))
 			throw Exception("failed to save image at " + std::string(path));
-	} else if (extension == "jpg") {
+	} else if (extension == ".jpg") {
 		if (!stbi_write_jpg(path.data(), m_width, m_height, comp, m_ptr, 0))
 			throw Exception("failed to save image at " + std::string(path));
-	} else if (extension == "bmp") {
+	} else if (extension == ".bmp") {
 		if (!stbi_write_bmp(path.data(), m_width, m_height, comp, m_ptr))
 			throw Exception("failed to save image at " + std::string(path));
 	} else
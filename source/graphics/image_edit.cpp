@@ -1,6 +1,7 @@
 #include "../../include/vera/graphics/image_edit.h"
 
-#include "pixel.h"
+#include "sampler_kernel.h"
+#include "../util/parallel_for.h"
 #include "../../include/vera/core/exception.h"
 #include "../../include/vera/core/assertion.h"
 #include "../../include/vera/graphics/format_traits.h"
@@ -8,263 +9,842 @@
 #include "../../include/vera/math/math_util.h"
 #include "../../include/vera/math/vector_math.h"
 #include <algorithm>
-
-#define ASSIGN1BYTES(lhs, rhs)  *reinterpret_cast<uint8_t*>(dst) = *reinterpret_cast<const uint8_t*>(src);
-#define ASSIGN2BYTES(lhs, rhs)  *reinterpret_cast<uint16_t*>(dst) = *reinterpret_cast<const uint16_t*>(src);
-#define ASSIGN3BYTES(lhs, rhs)  *reinterpret_cast<uchar3*>(dst) = *reinterpret_cast<const uchar3*>(src);
-#define ASSIGN4BYTES(lhs, rhs)  *reinterpret_cast<uint32_t*>(dst) = *reinterpret_cast<const uint32_t*>(src);
-#define ASSIGN5BYTES(lhs, rhs)  *reinterpret_cast<storage5*>(dst) = *reinterpret_cast<const storage5*>(src);
-#define ASSIGN6BYTES(lhs, rhs)  *reinterpret_cast<ushort3*>(dst) = *reinterpret_cast<const ushort3*>(src);
-#define ASSIGN8BYTES(lhs, rhs)  *reinterpret_cast<uint64_t*>(dst) = *reinterpret_cast<const uint64_t*>(src);
-#define ASSIGN12BYTES(lhs, rhs) *reinterpret_cast<uint3*>(dst) = *reinterpret_cast<const uint3*>(src);
-#define ASSIGN16BYTES(lhs, rhs) *reinterpret_cast<ulong2*>(dst) = *reinterpret_cast<const ulong2*>(src);
-#define ASSIGN24BYTES(lhs, rhs) *reinterpret_cast<ulong3*>(dst) = *reinterpret_cast<const ulong3*>(src);
-#define ASSIGN32BYTES(lhs, rhs) *reinterpret_cast<ulong4*>(dst) = *reinterpret_cast<const ulong4*>(src);
-
-#define SWAP1BYTES(lhs, rhs) std::swap(*reinterpret_cast<uint8_t*>(lhs), *reinterpret_cast<uint8_t*>(rhs));
-#define SWAP2BYTES(lhs, rhs) std::swap(*reinterpret_cast<uint16_t*>(lhs), *reinterpret_cast<uint16_t*>(rhs));
-#define SWAP3BYTES(lhs, rhs) std::swap(*reinterpret_cast<uchar3*>(lhs), *reinterpret_cast<uchar3*>(rhs));
-#define SWAP4BYTES(lhs, rhs) std::swap(*reinterpret_cast<uint32_t*>(lhs), *reinterpret_cast<uint32_t*>(rhs));
-#define SWAP5BYTES(lhs, rhs) std::swap(*reinterpret_cast<storage5*>(lhs), *reinterpret_cast<storage5*>(rhs));
-#define SWAP6BYTES(lhs, rhs) std::swap(*reinterpret_cast<ushort3*>(lhs), *reinterpret_cast<ushort3*>(rhs));
-#define SWAP8BYTES(lhs, rhs) std::swap(*reinterpret_cast<uint64_t*>(lhs), *reinterpret_cast<uint64_t*>(rhs));
-#define SWAP12BYTES(lhs, rhs) std::swap(*reinterpret_cast<uint3*>(lhs), *reinterpret_cast<uint3*>(rhs));
-#define SWAP16BYTES(lhs, rhs) std::swap(*reinterpret_cast<ulong2*>(lhs), *reinterpret_cast<ulong2*>(rhs));
-#define SWAP24BYTES(lhs, rhs) std::swap(*reinterpret_cast<ulong3*>(lhs), *reinterpret_cast<ulong3*>(rhs));
-#define SWAP32BYTES(lhs, rhs) std::swap(*reinterpret_cast<ulong4*>(lhs), *reinterpret_cast<ulong4*>(rhs));
+#include <type_traits>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define VERA_IMAGE_EDIT_X64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#ifdef VERA_IMAGE_EDIT_X64
+#if defined(_MSC_VER) && !defined(__clang__)
+#define VERA_TARGET_AVX2
+#else
+#define VERA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
 
 VERA_NAMESPACE_BEGIN
 
-struct storage5
+// Every transpose kernel moves a square block of this many pixels, partial blocks on the image
+// border are copied one pixel at a time.
+static constexpr uint32_t TRANSPOSE_BLOCK_SIZE = 8;
+
+// Blocks are visited in tiles of about this many bytes per row so that the source rows and the
+// destination rows touched by one tile stay resident in L1 while it is being transposed.
+static constexpr uint32_t TRANSPOSE_TILE_BYTES = 256;
+
+// Writes the transpose of a TRANSPOSE_BLOCK_SIZE square block, strides may be negative
+typedef void (*TransposeBlockFunc)(uint8_t* dst, ptrdiff_t dst_stride, const uint8_t* src, ptrdiff_t src_stride);
+
+// Writes count pixels of src to dst in reverse order, dst and src must not overlap
+typedef void (*ReverseRowFunc)(uint8_t* dst, const uint8_t* src, uint32_t count);
+
+struct PixelKernels
 {
-	void operator=(const storage5& rhs)
-	{
-		*reinterpret_cast<uint32_t*>(data) = *reinterpret_cast<const uint32_t*>(rhs.data);
-		data[4] = rhs.data[4];
+	TransposeBlockFunc transposeBlock;
+	ReverseRowFunc     reverseRow;
+};
+
+template <size_t PixelSize>
+static void transpose_block_scalar(uint8_t* dst, ptrdiff_t dst_stride, const uint8_t* src, ptrdiff_t src_stride)
+{
+	for (uint32_t i = 0; i < TRANSPOSE_BLOCK_SIZE; ++i) {
+		const uint8_t* src_row = src + src_stride * i;
+
+		for (uint32_t j = 0; j < TRANSPOSE_BLOCK_SIZE; ++j)
+			memcpy(dst + dst_stride * j + PixelSize * i, src_row + PixelSize * j, PixelSize);
 	}
+}
 
-	uint8_t data[5];
-};
+template <size_t PixelSize>
+static void reverse_row_scalar(uint8_t* dst, const uint8_t* src, uint32_t count)
+{
+	const uint8_t* src_end = src + PixelSize * count;
+
+	for (uint32_t i = 0; i < count; ++i)
+		memcpy(dst + PixelSize * i, src_end - PixelSize * (i + 1), PixelSize);
+}
+
+#ifdef VERA_IMAGE_EDIT_X64
 
-static void memswap(void* ptr0, void* ptr1, size_t size)
+// VERA_DISABLE_AVX2 set to anything but 0 picks the SSE2 kernels, so tests can check them on any machine
+static bool is_avx2_disabled()
 {
-	auto* pch0 = reinterpret_cast<uint8_t*>(ptr0);
-	auto* pch1 = reinterpret_cast<uint8_t*>(ptr1);
-	
-	// go slow way
-	if ((intptr_t)pch0 % sizeof(size_t) != (intptr_t)pch1 % sizeof(size_t)) {
-		for (size_t i = 0; i < size; ++i)
-			std::swap(pch0[i], pch1[i]);
-		return;
+#ifdef _MSC_VER
+	char*  value  = nullptr;
+	size_t length = 0;
+
+	if (_dupenv_s(&value, &length, "VERA_DISABLE_AVX2") != 0 || !value)
+		return false;
+
+	bool result = value[0] != '\0' && value[0] != '0';
+	free(value);
+
+	return result;
+#else
+	const char* value = getenv("VERA_DISABLE_AVX2");
+
+	return value && value[0] != '\0' && value[0] != '0';
+#endif
+}
+
+static bool cpu_supports_avx2()
+{
+	if (is_avx2_disabled()) return false;
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+
+	__cpuid(info, 0);
+	if (info[0] < 7) return false;
+
+	// avx needs both cpu support and the os saving ymm registers on context switches
+	__cpuid(info, 1);
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) return false;
+	if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+////////// SSE2 kernels ///////////////////////////////////////////////////////////////////////////
+
+static void transpose_block_sse2_1(uint8_t* dst, ptrdiff_t dst_stride, const uint8_t* src, ptrdiff_t src_stride)
+{
+	__m128i a0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+	__m128i a1 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + src_stride));
+	__m128i a2 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + src_stride * 2));
+	__m128i a3 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + src_stride * 3));
+	__m128i a4 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + src_stride * 4));
+	__m128i a5 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + src_stride * 5));
+	__m128i a6 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + src_stride * 6));
+	__m128i a7 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + src_stride * 7));
+
+	__m128i t0 = _mm_unpacklo_epi8(a0, a1);
+	__m128i t1 = _mm_unpacklo_epi8(a2, a3);
+	__m128i t2 = _mm_unpacklo_epi8(a4, a5);
+	__m128i t3 = _mm_unpacklo_epi8(a6, a7);
+
+	__m128i u0 = _mm_unpacklo_epi16(t0, t1);
+	__m128i u1 = _mm_unpackhi_epi16(t0, t1);
+	__m128i u2 = _mm_unpacklo_epi16(t2, t3);
+	__m128i u3 = _mm_unpackhi_epi16(t2, t3);
+
+	__m128i v0 = _mm_unpacklo_epi32(u0, u2);
+	__m128i v1 = _mm_unpackhi_epi32(u0, u2);
+	__m128i v2 = _mm_unpacklo_epi32(u1, u3);
+	__m128i v3 = _mm_unpackhi_epi32(u1, u3);
+
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), v0);
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + dst_stride), _mm_unpackhi_epi64(v0, v0));
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + dst_stride * 2), v1);
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + dst_stride * 3), _mm_unpackhi_epi64(v1, v1));
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + dst_stride * 4), v2);
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + dst_stride * 5), _mm_unpackhi_epi64(v2, v2));
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + dst_stride * 6), v3);
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + dst_stride * 7), _mm_unpackhi_epi64(v3, v3));
+}
+
+static void transpose_block_sse2_2(uint8_t* dst, ptrdiff_t dst_stride, const uint8_t* src, ptrdiff_t src_stride)
+{
+	__m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+	__m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + src_stride));
+	__m128i a2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + src_stride * 2));
+	__m128i a3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + src_stride * 3));
+	__m128i a4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + src_stride * 4));
+	__m128i a5 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + src_stride * 5));
+	__m128i a6 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + src_stride * 6));
+	__m128i a7 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + src_stride * 7));
+
+	__m128i t0 = _mm_unpacklo_epi16(a0, a1);
+	__m128i t1 = _mm_unpackhi_epi16(a0, a1);
+	__m128i t2 = _mm_unpacklo_epi16(a2, a3);
+	__m128i t3 = _mm_unpackhi_epi16(a2, a3);
+	__m128i t4 = _mm_unpacklo_epi16(a4, a5);
+	__m128i t5 = _mm_unpackhi_epi16(a4, a5);
+	__m128i t6 = _mm_unpacklo_epi16(a6, a7);
+	__m128i t7 = _mm_unpackhi_epi16(a6, a7);
+
+	__m128i u0 = _mm_unpacklo_epi32(t0, t2);
+	__m128i u1 = _mm_unpackhi_epi32(t0, t2);
+	__m128i u2 = _mm_unpacklo_epi32(t1, t3);
+	__m128i u3 = _mm_unpackhi_epi32(t1, t3);
+	__m128i u4 = _mm_unpacklo_epi32(t4, t6);
+	__m128i u5 = _mm_unpackhi_epi32(t4, t6);
+	__m128i u6 = _mm_unpacklo_epi32(t5, t7);
+	__m128i u7 = _mm_unpackhi_epi32(t5, t7);
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi64(u0, u4));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dst_stride), _mm_unpackhi_epi64(u0, u4));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dst_stride * 2), _mm_unpacklo_epi64(u1, u5));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dst_stride * 3), _mm_unpackhi_epi64(u1, u5));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dst_stride * 4), _mm_unpacklo_epi64(u2, u6));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dst_stride * 5), _mm_unpackhi_epi64(u2, u6));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dst_stride * 6), _mm_unpacklo_epi64(u3, u7));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dst_stride * 7), _mm_unpackhi_epi64(u3, u7));
+}
+
+static VERA_FORCEINLINE void transpose_4x4_sse2_4(uint8_t* dst, ptrdiff_t dst_stride, const uint8_t* src, ptrdiff_t src_stride)
+{
+	__m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+	__m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + src_stride));
+	__m128i a2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + src_stride * 2));
+	__m128i a3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + src_stride * 3));
+
+	__m128i t0 = _mm_unpacklo_epi32(a0, a1);
+	__m128i t1 = _mm_unpackhi_epi32(a0, a1);
+	__m128i t2 = _mm_unpacklo_epi32(a2, a3);
+	__m128i t3 = _mm_unpackhi_epi32(a2, a3);
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi64(t0, t2));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dst_stride), _mm_unpackhi_epi64(t0, t2));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dst_stride * 2), _mm_unpacklo_epi64(t1, t3));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dst_stride * 3), _mm_unpackhi_epi64(t1, t3));
+}
+
+static void transpose_block_sse2_4(uint8_t* dst, ptrdiff_t dst_stride, const uint8_t* src, ptrdiff_t src_stride)
+{
+	for (uint32_t i = 0; i < TRANSPOSE_BLOCK_SIZE; i += 4)
+		for (uint32_t j = 0; j < TRANSPOSE_BLOCK_SIZE; j += 4)
+			transpose_4x4_sse2_4(dst + dst_stride * j + 4 * i, dst_stride, src + src_stride * i + 4 * j, src_stride);
+}
+
+static VERA_FORCEINLINE void transpose_2x2_sse2_8(uint8_t* dst, ptrdiff_t dst_stride, const uint8_t* src, ptrdiff_t src_stride)
+{
+	__m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+	__m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + src_stride));
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi64(a0, a1));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dst_stride), _mm_unpackhi_epi64(a0, a1));
+}
+
+static void transpose_block_sse2_8(uint8_t* dst, ptrdiff_t dst_stride, const uint8_t* src, ptrdiff_t src_stride)
+{
+	for (uint32_t i = 0; i < TRANSPOSE_BLOCK_SIZE; i += 2)
+		for (uint32_t j = 0; j < TRANSPOSE_BLOCK_SIZE; j += 2)
+			transpose_2x2_sse2_8(dst + dst_stride * j + 8 * i, dst_stride, src + src_stride * i + 8 * j, src_stride);
+}
+
+static void transpose_block_sse2_16(uint8_t* dst, ptrdiff_t dst_stride, const uint8_t* src, ptrdiff_t src_stride)
+{
+	// a pixel fills a whole register, the block only needs moving
+	for (uint32_t i = 0; i < TRANSPOSE_BLOCK_SIZE; ++i) {
+		const uint8_t* src_row = src + src_stride * i;
+
+		for (uint32_t j = 0; j < TRANSPOSE_BLOCK_SIZE; ++j) {
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_row + 16 * j));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dst_stride * j + 16 * i), a);
+		}
 	}
+}
 
-	for (;(intptr_t)pch0 % sizeof(size_t) != 0; --size)
-		std::iter_swap(pch0++, pch1++);
+static void reverse_row_sse2_1(uint8_t* dst, const uint8_t* src, uint32_t count)
+{
+	uint32_t i = 0;
+
+	for (; i + 16 <= count; i += 16) {
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + count - i - 16));
+		a = _mm_shuffle_epi32(a, _MM_SHUFFLE(0, 1, 2, 3));
+		a = _mm_shufflelo_epi16(a, _MM_SHUFFLE(2, 3, 0, 1));
+		a = _mm_shufflehi_epi16(a, _MM_SHUFFLE(2, 3, 0, 1));
+		a = _mm_or_si128(_mm_slli_epi16(a, 8), _mm_srli_epi16(a, 8));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), a);
+	}
 
-	while (sizeof(size_t) <= size) {
-		std::iter_swap(
-			reinterpret_cast<size_t*>(pch0),
-			reinterpret_cast<size_t*>(pch1));
-		pch0 += 8;
-		pch1 += 8;
-		size -= 8;
+	for (; i < count; ++i)
+		dst[i] = src[count - i - 1];
+}
+
+static void reverse_row_sse2_2(uint8_t* dst, const uint8_t* src, uint32_t count)
+{
+	uint32_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * (count - i - 8)));
+		a = _mm_shuffle_epi32(a, _MM_SHUFFLE(0, 1, 2, 3));
+		a = _mm_shufflelo_epi16(a, _MM_SHUFFLE(2, 3, 0, 1));
+		a = _mm_shufflehi_epi16(a, _MM_SHUFFLE(2, 3, 0, 1));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i), a);
 	}
 
-	for (;0 < size; --size)
-		std::iter_swap(pch0++, pch1++);
+	reverse_row_scalar<2>(dst + 2 * i, src, count - i);
 }
 
-Image ImageEdit::flip(const Image& image, bool horizontal, bool vertical)
+static void reverse_row_sse2_4(uint8_t* dst, const uint8_t* src, uint32_t count)
+{
+	uint32_t i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * (count - i - 4)));
+		a = _mm_shuffle_epi32(a, _MM_SHUFFLE(0, 1, 2, 3));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), a);
+	}
+
+	reverse_row_scalar<4>(dst + 4 * i, src, count - i);
+}
+
+static void reverse_row_sse2_8(uint8_t* dst, const uint8_t* src, uint32_t count)
+{
+	uint32_t i = 0;
+
+	for (; i + 2 <= count; i += 2) {
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 8 * (count - i - 2)));
+		a = _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 8 * i), a);
+	}
+
+	reverse_row_scalar<8>(dst + 8 * i, src, count - i);
+}
+
+////////// AVX2 kernels ///////////////////////////////////////////////////////////////////////////
+
+VERA_TARGET_AVX2
+static void transpose_block_avx2_4(uint8_t* dst, ptrdiff_t dst_stride, const uint8_t* src, ptrdiff_t src_stride)
+{
+	__m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+	__m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + src_stride));
+	__m256i a2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + src_stride * 2));
+	__m256i a3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + src_stride * 3));
+	__m256i a4 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + src_stride * 4));
+	__m256i a5 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + src_stride * 5));
+	__m256i a6 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + src_stride * 6));
+	__m256i a7 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + src_stride * 7));
+
+	__m256i t0 = _mm256_unpacklo_epi32(a0, a1);
+	__m256i t1 = _mm256_unpackhi_epi32(a0, a1);
+	__m256i t2 = _mm256_unpacklo_epi32(a2, a3);
+	__m256i t3 = _mm256_unpackhi_epi32(a2, a3);
+	__m256i t4 = _mm256_unpacklo_epi32(a4, a5);
+	__m256i t5 = _mm256_unpackhi_epi32(a4, a5);
+	__m256i t6 = _mm256_unpacklo_epi32(a6, a7);
+	__m256i t7 = _mm256_unpackhi_epi32(a6, a7);
+
+	// each 128-bit lane now holds a 4x4 quarter of the result
+	__m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+	__m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+	__m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+	__m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+	__m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+	__m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+	__m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+	__m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_permute2x128_si256(u0, u4, 0x20));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + dst_stride), _mm256_permute2x128_si256(u1, u5, 0x20));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + dst_stride * 2), _mm256_permute2x128_si256(u2, u6, 0x20));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + dst_stride * 3), _mm256_permute2x128_si256(u3, u7, 0x20));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + dst_stride * 4), _mm256_permute2x128_si256(u0, u4, 0x31));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + dst_stride * 5), _mm256_permute2x128_si256(u1, u5, 0x31));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + dst_stride * 6), _mm256_permute2x128_si256(u2, u6, 0x31));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + dst_stride * 7), _mm256_permute2x128_si256(u3, u7, 0x31));
+}
+
+VERA_TARGET_AVX2
+static VERA_FORCEINLINE void transpose_4x4_avx2_8(uint8_t* dst, ptrdiff_t dst_stride, const uint8_t* src, ptrdiff_t src_stride)
+{
+	__m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+	__m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + src_stride));
+	__m256i a2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + src_stride * 2));
+	__m256i a3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + src_stride * 3));
+
+	__m256i t0 = _mm256_unpacklo_epi64(a0, a1);
+	__m256i t1 = _mm256_unpackhi_epi64(a0, a1);
+	__m256i t2 = _mm256_unpacklo_epi64(a2, a3);
+	__m256i t3 = _mm256_unpackhi_epi64(a2, a3);
+
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_permute2x128_si256(t0, t2, 0x20));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + dst_stride), _mm256_permute2x128_si256(t1, t3, 0x20));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + dst_stride * 2), _mm256_permute2x128_si256(t0, t2, 0x31));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + dst_stride * 3), _mm256_permute2x128_si256(t1, t3, 0x31));
+}
+
+VERA_TARGET_AVX2
+static void transpose_block_avx2_8(uint8_t* dst, ptrdiff_t dst_stride, const uint8_t* src, ptrdiff_t src_stride)
+{
+	for (uint32_t i = 0; i < TRANSPOSE_BLOCK_SIZE; i += 4)
+		for (uint32_t j = 0; j < TRANSPOSE_BLOCK_SIZE; j += 4)
+			transpose_4x4_avx2_8(dst + dst_stride * j + 8 * i, dst_stride, src + src_stride * i + 8 * j, src_stride);
+}
+
+VERA_TARGET_AVX2
+static void reverse_row_avx2_1(uint8_t* dst, const uint8_t* src, uint32_t count)
+{
+	const __m256i mask = _mm256_setr_epi8(
+		15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+		15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+	uint32_t i = 0;
+
+	for (; i + 32 <= count; i += 32) {
+		__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + count - i - 32));
+		a = _mm256_shuffle_epi8(a, mask);
+		a = _mm256_permute4x64_epi64(a, _MM_SHUFFLE(1, 0, 3, 2));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), a);
+	}
+
+	reverse_row_sse2_1(dst + i, src, count - i);
+}
+
+VERA_TARGET_AVX2
+static void reverse_row_avx2_2(uint8_t* dst, const uint8_t* src, uint32_t count)
+{
+	const __m256i mask = _mm256_setr_epi8(
+		14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+		14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+
+	uint32_t i = 0;
+
+	for (; i + 16 <= count; i += 16) {
+		__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * (count - i - 16)));
+		a = _mm256_shuffle_epi8(a, mask);
+		a = _mm256_permute4x64_epi64(a, _MM_SHUFFLE(1, 0, 3, 2));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i), a);
+	}
+
+	reverse_row_sse2_2(dst + 2 * i, src, count - i);
+}
+
+VERA_TARGET_AVX2
+static void reverse_row_avx2_4(uint8_t* dst, const uint8_t* src, uint32_t count)
 {
-////////// define some macros /////////////////////////////////////////////////////////////////////
+	const __m256i index = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
 
-#define FOR_EACH_PIXEL0(pixel_size, content) \
-	for (uint32_t i = 0; i < n; ++i) { \
-		auto*       dst = dst_ptr + size - pixel_size * (i + 1) ; \
-		const auto* src = src_ptr + pixel_size * i; \
-		content \
+	uint32_t i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * (count - i - 8)));
+		a = _mm256_permutevar8x32_epi32(a, index);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), a);
 	}
 
-#define FOR_EACH_PIXEL1(pixel_size, content) \
-	for (uint32_t y = 0; y < height; ++y) { \
-		for (uint32_t x = 0; x < width; ++x) { \
-			auto*       dst = dst_ptr + pixel_size * (width * y + (width - x - 1)); \
-			const auto* src = src_ptr + (pixel_size) * (width * y + x); \
-			content \
-		} \
+	reverse_row_sse2_4(dst + 4 * i, src, count - i);
+}
+
+VERA_TARGET_AVX2
+static void reverse_row_avx2_8(uint8_t* dst, const uint8_t* src, uint32_t count)
+{
+	uint32_t i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 8 * (count - i - 4)));
+		a = _mm256_permute4x64_epi64(a, _MM_SHUFFLE(0, 1, 2, 3));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 8 * i), a);
 	}
 
+	reverse_row_sse2_8(dst + 8 * i, src, count - i);
+}
+
+#endif // VERA_IMAGE_EDIT_X64
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-	if (!horizontal && !vertical)
-		return image;
+static PixelKernels get_scalar_kernels(uint32_t pixel_size)
+{
+	switch (pixel_size) {
+	case 1:  return { transpose_block_scalar<1>,  reverse_row_scalar<1> };
+	case 2:  return { transpose_block_scalar<2>,  reverse_row_scalar<2> };
+	case 3:  return { transpose_block_scalar<3>,  reverse_row_scalar<3> };
+	case 4:  return { transpose_block_scalar<4>,  reverse_row_scalar<4> };
+	case 5:  return { transpose_block_scalar<5>,  reverse_row_scalar<5> };
+	case 6:  return { transpose_block_scalar<6>,  reverse_row_scalar<6> };
+	case 8:  return { transpose_block_scalar<8>,  reverse_row_scalar<8> };
+	case 12: return { transpose_block_scalar<12>, reverse_row_scalar<12> };
+	case 16: return { transpose_block_scalar<16>, reverse_row_scalar<16> };
+	case 24: return { transpose_block_scalar<24>, reverse_row_scalar<24> };
+	case 32: return { transpose_block_scalar<32>, reverse_row_scalar<32> };
+	}
 
-	const auto format     = image.format();
-	const auto width      = image.width();
-	const auto height     = image.height();
-	const auto pixel_size = get_format_size(format);
-	const auto row_bytes  = width * pixel_size;
+	throw Exception("invalid pixel size {}", pixel_size);
+}
 
-	Image result(width, height, format);
+static PixelKernels get_pixel_kernels(uint32_t pixel_size)
+{
+	PixelKernels kernels = get_scalar_kernels(pixel_size);
 
-	const auto* src_ptr = reinterpret_cast<const uint8_t*>(image.data());
-	auto*       dst_ptr = reinterpret_cast<uint8_t*>(result.data());
-
-	if (horizontal && vertical) {
-		uint32_t size = height * row_bytes;
-		uint32_t n    = width * height;
-
-		switch (pixel_size) {
-		case 1:  FOR_EACH_PIXEL0(1,  ASSIGN1BYTES(dst, src))  break;
-		case 2:  FOR_EACH_PIXEL0(2,  ASSIGN2BYTES(dst, src))  break;
-		case 3:  FOR_EACH_PIXEL0(3,  ASSIGN3BYTES(dst, src))  break;
-		case 4:  FOR_EACH_PIXEL0(4,  ASSIGN4BYTES(dst, src))  break;
-		case 5:  FOR_EACH_PIXEL0(5,  ASSIGN5BYTES(dst, src))  break;
-		case 6:  FOR_EACH_PIXEL0(6,  ASSIGN6BYTES(dst, src))  break;
-		case 8:  FOR_EACH_PIXEL0(8,  ASSIGN8BYTES(dst, src))  break;
-		case 12: FOR_EACH_PIXEL0(12, ASSIGN12BYTES(dst, src)) break;
-		case 16: FOR_EACH_PIXEL0(16, ASSIGN16BYTES(dst, src)) break;
-		case 24: FOR_EACH_PIXEL0(24, ASSIGN24BYTES(dst, src)) break;
-		case 32: FOR_EACH_PIXEL0(32, ASSIGN32BYTES(dst, src)) break;
-		default: VERA_ASSERT_MSG(false, "invalid pixel size");
-		}
+#ifdef VERA_IMAGE_EDIT_X64
+	static const bool has_avx2 = cpu_supports_avx2();
 
-	} else if (!horizontal && vertical) {
-		for (uint32_t y = 0; y < height; ++y) {
-			memcpy(
-				dst_ptr + row_bytes * (height - y - 1),
-				src_ptr + row_bytes * y,
-				row_bytes);
-		}
-	} else if (horizontal && !vertical) {
-		switch (pixel_size) {
-		case 1:  FOR_EACH_PIXEL1(1,  ASSIGN1BYTES(dst, src))  break;
-		case 2:  FOR_EACH_PIXEL1(2,  ASSIGN2BYTES(dst, src))  break;
-		case 3:  FOR_EACH_PIXEL1(3,  ASSIGN3BYTES(dst, src))  break;
-		case 4:  FOR_EACH_PIXEL1(4,  ASSIGN4BYTES(dst, src))  break;
-		case 5:  FOR_EACH_PIXEL1(5,  ASSIGN5BYTES(dst, src))  break;
-		case 6:  FOR_EACH_PIXEL1(6,  ASSIGN6BYTES(dst, src))  break;
-		case 8:  FOR_EACH_PIXEL1(8,  ASSIGN8BYTES(dst, src))  break;
-		case 12: FOR_EACH_PIXEL1(12, ASSIGN12BYTES(dst, src)) break;
-		case 16: FOR_EACH_PIXEL1(16, ASSIGN16BYTES(dst, src)) break;
-		case 24: FOR_EACH_PIXEL1(24, ASSIGN24BYTES(dst, src)) break;
-		case 32: FOR_EACH_PIXEL1(32, ASSIGN32BYTES(dst, src)) break;
-		default: VERA_ASSERT_MSG(false, "invalid pixel size");
+	switch (pixel_size) {
+	case 1:
+		kernels.transposeBlock = transpose_block_sse2_1;
+		kernels.reverseRow     = has_avx2 ? reverse_row_avx2_1 : reverse_row_sse2_1;
+		break;
+	case 2:
+		kernels.transposeBlock = transpose_block_sse2_2;
+		kernels.reverseRow     = has_avx2 ? reverse_row_avx2_2 : reverse_row_sse2_2;
+		break;
+	case 4:
+		kernels.transposeBlock = has_avx2 ? transpose_block_avx2_4 : transpose_block_sse2_4;
+		kernels.reverseRow     = has_avx2 ? reverse_row_avx2_4 : reverse_row_sse2_4;
+		break;
+	case 8:
+		kernels.transposeBlock = has_avx2 ? transpose_block_avx2_8 : transpose_block_sse2_8;
+		kernels.reverseRow     = has_avx2 ? reverse_row_avx2_8 : reverse_row_sse2_8;
+		break;
+	case 16:
+		kernels.transposeBlock = transpose_block_sse2_16;
+		break;
+	}
+#endif
+
+	return kernels;
+}
+
+// Writes dst(c, r) = src(r, c) for a rows x cols source, both row pointers may walk backwards so
+// that a flip can be folded into the strides. The image is visited tile by tile and each tile
+// block by block, leftover rows and columns on the border are copied pixel by pixel.
+static void transpose_image(
+	uint8_t*            dst,
+	ptrdiff_t           dst_stride,
+	const uint8_t*      src,
+	ptrdiff_t           src_stride,
+	uint32_t            rows,
+	uint32_t            cols,
+	uint32_t            pixel_size,
+	const PixelKernels& kernels)
+{
+	const uint32_t block     = TRANSPOSE_BLOCK_SIZE;
+	const uint32_t tile      = std::max(block, std::min(64u, TRANSPOSE_TILE_BYTES / pixel_size) / block * block);
+	const uint32_t full_rows = rows - rows % block;
+	const uint32_t full_cols = cols - cols % block;
+
+	for (uint32_t tile_r = 0; tile_r < full_rows; tile_r += tile) {
+		const uint32_t end_r = std::min(tile_r + tile, full_rows);
+
+		for (uint32_t tile_c = 0; tile_c < full_cols; tile_c += tile) {
+			const uint32_t end_c = std::min(tile_c + tile, full_cols);
+
+			for (uint32_t r = tile_r; r < end_r; r += block) {
+				const uint8_t* src_row = src + src_stride * r;
+				uint8_t*       dst_col = dst + static_cast<size_t>(pixel_size) * r;
+
+				for (uint32_t c = tile_c; c < end_c; c += block)
+					kernels.transposeBlock(
+						dst_col + dst_stride * c,
+						dst_stride,
+						src_row + static_cast<size_t>(pixel_size) * c,
+						src_stride);
+			}
 		}
 	}
 
-	return result;
+	for (uint32_t r = 0; r < rows; ++r) {
+		const uint8_t* src_row = src + src_stride * r;
+		uint8_t*       dst_col = dst + static_cast<size_t>(pixel_size) * r;
+		uint32_t       c       = r < full_rows ? full_cols : 0;
 
-#undef FOR_EACH_PIXEL0
-#undef FOR_EACH_PIXEL1
+		for (; c < cols; ++c)
+			memcpy(dst_col + dst_stride * c, src_row + static_cast<size_t>(pixel_size) * c, pixel_size);
+	}
 }
 
-Image ImageEdit::flip(const Image& image, ImageFlipFlags flags)
+////////// blit kernels ///////////////////////////////////////////////////////////////////////////
+
+// Rows are handed to worker threads in slices of at least this many destination pixels
+static constexpr uint32_t BLIT_PIXELS_PER_TASK = 16384;
+
+struct BlitContext
 {
-	return ImageEdit::flip(
-		image,
-		flags.has(ImageFlipFlagBits::Horizontal),
-		flags.has(ImageFlipFlagBits::Vertical));
+	const void*   srcPtr;
+	uint32_t      srcWidth;
+	uint32_t      srcHeight;
+	void*         dstPtr;
+	uint32_t      dstWidth;
+	uint32_t      dstHeight;
+	Format        format;
+	float4        borderColor;
+	bool          unnormalized;
+	bool          separable;
+	const float2* columnTop;
+	const float2* columnBottom;
+};
+
+typedef void (*BlitRowsFunc)(const BlitContext& ctx, uint32_t begin_y, uint32_t end_y);
+
+// True when u only varies along the destination rows and v only along the columns, the edge
+// differences are then exactly zero so the shared coordinates match the per pixel ones bit for bit
+static bool is_axis_aligned(const ImageBlitInfo& info)
+{
+	const float coords[] = {
+		info.uv0.x, info.uv0.y, info.uv1.x, info.uv1.y,
+		info.uv2.x, info.uv2.y, info.uv3.x, info.uv3.y
+	};
+
+	for (float coord : coords)
+		if (!std::isfinite(coord))
+			return false;
+
+	return
+		info.uv0.x == info.uv3.x && info.uv1.x == info.uv2.x &&
+		info.uv0.y == info.uv1.y && info.uv3.y == info.uv2.y;
 }
 
-Image ImageEdit::rotate(const Image& image, Rotation rot)
+#ifdef VERA_IMAGE_EDIT_X64
+
+static VERA_FORCEINLINE __m128 load_rgba8_sse2(const uint8_t* ptr, uint32_t width, uint32_t x, uint32_t y)
 {
-	switch (rot) {
-	case Rotation::_90Deg:  return ImageEdit::rotateCW(image);
-	case Rotation::_180Deg: return ImageEdit::flip(image, true, true);
-	case Rotation::_270Deg: return ImageEdit::rotateCCW(image);
-	default:                return image;
+	const __m128i zero = _mm_setzero_si128();
+
+	int32_t pixel;
+	memcpy(&pixel, ptr + 4 * (static_cast<size_t>(width) * y + x), 4);
+
+	__m128i a = _mm_cvtsi32_si128(pixel);
+	a = _mm_unpacklo_epi8(a, zero);
+	a = _mm_unpacklo_epi16(a, zero);
+
+	return _mm_div_ps(_mm_cvtepi32_ps(a), _mm_set1_ps(max_value_v<uint8_t>));
+}
+
+// Same arithmetic as filter_linear with the rgba8 codec, carried out on all four channels at once
+static VERA_FORCEINLINE void blit_linear_rgba8_sse2(
+	uint8_t*            dst,
+	const uint8_t*      src,
+	uint32_t            src_width,
+	const LinearTexels& tu,
+	const LinearTexels& tv)
+{
+	__m128 color = _mm_mul_ps(_mm_set1_ps(tu.t0 * tv.t0), load_rgba8_sse2(src, src_width, tu.i0, tv.i0));
+	color = _mm_add_ps(color, _mm_mul_ps(_mm_set1_ps(tu.t1 * tv.t0), load_rgba8_sse2(src, src_width, tu.i1, tv.i0)));
+	color = _mm_add_ps(color, _mm_mul_ps(_mm_set1_ps(tu.t1 * tv.t1), load_rgba8_sse2(src, src_width, tu.i1, tv.i1)));
+	color = _mm_add_ps(color, _mm_mul_ps(_mm_set1_ps(tu.t0 * tv.t1), load_rgba8_sse2(src, src_width, tu.i0, tv.i1)));
+
+	__m128i a = _mm_cvttps_epi32(_mm_mul_ps(color, _mm_set1_ps(max_value_v<uint8_t> + 0.99f)));
+	a = _mm_packs_epi32(a, a);
+	a = _mm_packus_epi16(a, a);
+
+	int32_t pixel = _mm_cvtsi128_si32(a);
+	memcpy(dst, &pixel, 4);
+}
+
+#endif // VERA_IMAGE_EDIT_X64
+
+// A sample coordinate resolved along one axis of the source image
+struct BlitAxis
+{
+	bool         inside;
+	uint32_t     nearest;
+	LinearTexels linear;
+};
+
+template <ImageSamplerFilter Filter, ImageSamplerAddressMode Mode>
+static VERA_FORCEINLINE BlitAxis resolve_blit_axis(float x, float size)
+{
+	BlitAxis axis;
+	axis.inside = resolve_address<Mode>(x, size);
+
+	if (axis.inside) {
+		if constexpr (Filter == ImageSamplerFilter::Nearest)
+			axis.nearest = nearest_texel(x, size);
+		else
+			axis.linear = linear_texels(x, size);
 	}
+
+	return axis;
 }
 
-Image ImageEdit::rotateCW(const Image& image)
+template <class Codec, ImageSamplerFilter Filter>
+static VERA_FORCEINLINE void blit_pixel(const BlitContext& ctx, uint32_t x, uint32_t y, const BlitAxis& au, const BlitAxis& av)
 {
-////////// define some macros /////////////////////////////////////////////////////////////////////
+	if (!au.inside || !av.inside) {
+		Codec::store(ctx.dstPtr, ctx.dstWidth, x, y, ctx.format, ctx.borderColor);
+		return;
+	}
 
-#define FOR_EACH_PIXEL(pixel_size, content) \
-	for (uint32_t y = 0; y < height; ++y) { \
-		for (uint32_t x = 0; x < width; ++x) { \
-			auto*       dst = dst_ptr + pixel_size * (height * x + (width - y - 1)); \
-			const auto* src = src_ptr + pixel_size * (width * y + x); \
-			content \
-		}\
+	if constexpr (Filter == ImageSamplerFilter::Nearest) {
+		if constexpr (Codec::Lossless) {
+			using Texel = typename Codec::Texel;
+			fetch_pixel<Texel>(ctx.dstPtr, ctx.dstWidth, x, y) = fetch_pixel<Texel>(ctx.srcPtr, ctx.srcWidth, au.nearest, av.nearest);
+		} else {
+			float4 color = Codec::load(ctx.srcPtr, ctx.srcWidth, au.nearest, av.nearest, ctx.format);
+			Codec::store(ctx.dstPtr, ctx.dstWidth, x, y, ctx.format, color);
+		}
+	} else {
+#ifdef VERA_IMAGE_EDIT_X64
+		if constexpr (std::is_same_v<Codec, PixelCodec<Format::RGBA8Unorm>>) {
+			blit_linear_rgba8_sse2(
+				reinterpret_cast<uint8_t*>(ctx.dstPtr) + 4 * (static_cast<size_t>(ctx.dstWidth) * y + x),
+				reinterpret_cast<const uint8_t*>(ctx.srcPtr),
+				ctx.srcWidth,
+				au.linear,
+				av.linear);
+			return;
+		}
+#endif
+		float4 color = filter_linear<Codec>(ctx.srcPtr, ctx.srcWidth, ctx.format, au.linear, av.linear);
+		Codec::store(ctx.dstPtr, ctx.dstWidth, x, y, ctx.format, color);
 	}
+}
 
-///////////////////////////////////////////////////////////////////////////////////////////////////
+// Computes every pixel the same way ImageSampler::sample followed by a store would. When u only
+// depends on the column and v only on the row, which is the case for any axis aligned quad, the
+// coordinates are resolved once per column and once per row instead of once per pixel.
+template <class Codec, ImageSamplerFilter Filter, ImageSamplerAddressMode ModeU, ImageSamplerAddressMode ModeV>
+static void blit_rows(const BlitContext& ctx, uint32_t begin_y, uint32_t end_y)
+{
+	const float src_width  = static_cast<float>(ctx.srcWidth);
+	const float src_height = static_cast<float>(ctx.srcHeight);
+
+	if (ctx.separable) {
+		std::vector<BlitAxis> columns(ctx.dstWidth);
 
-	const auto format     = image.format();
-	const auto width      = image.width();
-	const auto height     = image.height();
-	const auto pixel_size = get_format_size(format);
+		for (uint32_t x = 0; x < ctx.dstWidth; ++x) {
+			float u = lerp(ctx.columnTop[x], ctx.columnBottom[x], 0.f).x;
+			if (!ctx.unnormalized) u *= ctx.srcWidth;
+			columns[x] = resolve_blit_axis<Filter, ModeU>(u, src_width);
+		}
 
-	Image result(height, width, format);
+		for (uint32_t y = begin_y; y < end_y; ++y) {
+			const float ty = static_cast<float>(y) / ctx.dstHeight;
 
-	const auto* src_ptr = reinterpret_cast<const uint8_t*>(image.data());
-	auto*       dst_ptr = reinterpret_cast<uint8_t*>(result.data());
+			float v = lerp(ctx.columnTop[0], ctx.columnBottom[0], ty).y;
+			if (!ctx.unnormalized) v *= ctx.srcHeight;
+			BlitAxis row = resolve_blit_axis<Filter, ModeV>(v, src_height);
 
-	switch (pixel_size) {
-	case 1:  FOR_EACH_PIXEL(1,  ASSIGN1BYTES(dst, src))  break;
-	case 2:  FOR_EACH_PIXEL(2,  ASSIGN2BYTES(dst, src))  break;
-	case 3:  FOR_EACH_PIXEL(3,  ASSIGN3BYTES(dst, src))  break;
-	case 4:  FOR_EACH_PIXEL(4,  ASSIGN4BYTES(dst, src))  break;
-	case 5:  FOR_EACH_PIXEL(5,  ASSIGN5BYTES(dst, src))  break;
-	case 6:  FOR_EACH_PIXEL(6,  ASSIGN6BYTES(dst, src))  break;
-	case 8:  FOR_EACH_PIXEL(8,  ASSIGN8BYTES(dst, src))  break;
-	case 12: FOR_EACH_PIXEL(12, ASSIGN12BYTES(dst, src)) break;
-	case 16: FOR_EACH_PIXEL(16, ASSIGN16BYTES(dst, src)) break;
-	case 24: FOR_EACH_PIXEL(24, ASSIGN24BYTES(dst, src)) break;
-	case 32: FOR_EACH_PIXEL(32, ASSIGN32BYTES(dst, src)) break;
-	default: VERA_ASSERT_MSG(false, "invalid pixel size");
+			for (uint32_t x = 0; x < ctx.dstWidth; ++x)
+				blit_pixel<Codec, Filter>(ctx, x, y, columns[x], row);
+		}
+
+		return;
 	}
 
-	return result;
+	for (uint32_t y = begin_y; y < end_y; ++y) {
+		const float ty = static_cast<float>(y) / ctx.dstHeight;
+
+		for (uint32_t x = 0; x < ctx.dstWidth; ++x) {
+			float2 p = lerp(ctx.columnTop[x], ctx.columnBottom[x], ty);
+			float  u = p.x;
+			float  v = p.y;
+
+			if (!ctx.unnormalized) {
+				u *= ctx.srcWidth;
+				v *= ctx.srcHeight;
+			}
+
+			blit_pixel<Codec, Filter>(
+				ctx,
+				x,
+				y,
+				resolve_blit_axis<Filter, ModeU>(u, src_width),
+				resolve_blit_axis<Filter, ModeV>(v, src_height));
+		}
+	}
+}
+
+template <class Codec, ImageSamplerFilter Filter, ImageSamplerAddressMode ModeU>
+static BlitRowsFunc select_blit_rows(ImageSamplerAddressMode mode_v)
+{
+	switch (mode_v) {
+	case ImageSamplerAddressMode::Repeat:            return blit_rows<Codec, Filter, ModeU, ImageSamplerAddressMode::Repeat>;
+	case ImageSamplerAddressMode::MirroredRepeat:    return blit_rows<Codec, Filter, ModeU, ImageSamplerAddressMode::MirroredRepeat>;
+	case ImageSamplerAddressMode::ClampToEdge:       return blit_rows<Codec, Filter, ModeU, ImageSamplerAddressMode::ClampToEdge>;
+	case ImageSamplerAddressMode::ClampToBorder:     return blit_rows<Codec, Filter, ModeU, ImageSamplerAddressMode::ClampToBorder>;
+	case ImageSamplerAddressMode::MirrorClampToEdge: return blit_rows<Codec, Filter, ModeU, ImageSamplerAddressMode::MirrorClampToEdge>;
+	}
 
-#undef FOR_EACH_PIXEL
+	throw Exception("unsupported address mode");
 }
 
-Image ImageEdit::rotateCCW(const Image& image)
+template <class Codec, ImageSamplerFilter Filter>
+static BlitRowsFunc select_blit_rows(ImageSamplerAddressMode mode_u, ImageSamplerAddressMode mode_v)
 {
-////////// define some macros /////////////////////////////////////////////////////////////////////
+	switch (mode_u) {
+	case ImageSamplerAddressMode::Repeat:            return select_blit_rows<Codec, Filter, ImageSamplerAddressMode::Repeat>(mode_v);
+	case ImageSamplerAddressMode::MirroredRepeat:    return select_blit_rows<Codec, Filter, ImageSamplerAddressMode::MirroredRepeat>(mode_v);
+	case ImageSamplerAddressMode::ClampToEdge:       return select_blit_rows<Codec, Filter, ImageSamplerAddressMode::ClampToEdge>(mode_v);
+	case ImageSamplerAddressMode::ClampToBorder:     return select_blit_rows<Codec, Filter, ImageSamplerAddressMode::ClampToBorder>(mode_v);
+	case ImageSamplerAddressMode::MirrorClampToEdge: return select_blit_rows<Codec, Filter, ImageSamplerAddressMode::MirrorClampToEdge>(mode_v);
+	}
 
-#define FOR_EACH_PIXEL(pixel_size, content) \
-	for (uint32_t y = 0; y < height; ++y) { \
-		for (uint32_t x = 0; x < width; ++x) { \
-			auto*       dst = dst_ptr + pixel_size * (height * (width - x - 1) + y); \
-			const auto* src = src_ptr + pixel_size * (width * y + x); \
-			content \
-		}\
+	throw Exception("unsupported address mode");
+}
+
+template <class Codec>
+static BlitRowsFunc select_blit_rows(ImageSamplerFilter filter, ImageSamplerAddressMode mode_u, ImageSamplerAddressMode mode_v)
+{
+	switch (filter) {
+	case ImageSamplerFilter::Nearest: return select_blit_rows<Codec, ImageSamplerFilter::Nearest>(mode_u, mode_v);
+	case ImageSamplerFilter::Linear:  return select_blit_rows<Codec, ImageSamplerFilter::Linear>(mode_u, mode_v);
 	}
 
-///////////////////////////////////////////////////////////////////////////////////////////////////
+	throw Exception("unsupported sampler filter");
+}
 
-	const auto format     = image.format();
-	const auto width      = image.width();
-	const auto height     = image.height();
-	const auto pixel_size = get_format_size(format);
+static BlitRowsFunc select_blit_rows(
+	Format                  format,
+	ImageSamplerFilter      filter,
+	ImageSamplerAddressMode mode_u,
+	ImageSamplerAddressMode mode_v)
+{
+	switch (format) {
+	case Format::R8Unorm:     return select_blit_rows<PixelCodec<Format::R8Unorm>>(filter, mode_u, mode_v);
+	case Format::RG8Unorm:    return select_blit_rows<PixelCodec<Format::RG8Unorm>>(filter, mode_u, mode_v);
+	case Format::RGBA8Unorm:  return select_blit_rows<PixelCodec<Format::RGBA8Unorm>>(filter, mode_u, mode_v);
+	case Format::BGRA8Unorm:  return select_blit_rows<PixelCodec<Format::BGRA8Unorm>>(filter, mode_u, mode_v);
+	case Format::R16Unorm:    return select_blit_rows<PixelCodec<Format::R16Unorm>>(filter, mode_u, mode_v);
+	case Format::RGBA16Unorm: return select_blit_rows<PixelCodec<Format::RGBA16Unorm>>(filter, mode_u, mode_v);
+	case Format::R32Float:    return select_blit_rows<PixelCodec<Format::R32Float>>(filter, mode_u, mode_v);
+	case Format::RGBA32Float: return select_blit_rows<PixelCodec<Format::RGBA32Float>>(filter, mode_u, mode_v);
+	default:                  return select_blit_rows<PixelCodec<Format::Unknown>>(filter, mode_u, mode_v);
+	}
+}
+
+Image ImageEdit::flip(const Image& image, bool horizontal, bool vertical)
+{
+	if (!horizontal && !vertical)
+		return image;
 
-	Image result(height, width, format);
+	Image result(image.width(), image.height(), image.format());
 
-	const auto* src_ptr = reinterpret_cast<const uint8_t*>(image.data());
-	auto*       dst_ptr = reinterpret_cast<uint8_t*>(result.data());
+	ImageEdit::flip(result.view(), image.view(), horizontal, vertical);
 
-	switch (pixel_size) {
-	case 1:  FOR_EACH_PIXEL(1,  ASSIGN1BYTES(dst, src))  break;
-	case 2:  FOR_EACH_PIXEL(2,  ASSIGN2BYTES(dst, src))  break;
-	case 3:  FOR_EACH_PIXEL(3,  ASSIGN3BYTES(dst, src))  break;
-	case 4:  FOR_EACH_PIXEL(4,  ASSIGN4BYTES(dst, src))  break;
-	case 5:  FOR_EACH_PIXEL(5,  ASSIGN5BYTES(dst, src))  break;
-	case 6:  FOR_EACH_PIXEL(6,  ASSIGN6BYTES(dst, src))  break;
-	case 8:  FOR_EACH_PIXEL(8,  ASSIGN8BYTES(dst, src))  break;
-	case 12: FOR_EACH_PIXEL(12, ASSIGN12BYTES(dst, src)) break;
-	case 16: FOR_EACH_PIXEL(16, ASSIGN16BYTES(dst, src)) break;
-	case 24: FOR_EACH_PIXEL(24, ASSIGN24BYTES(dst, src)) break;
-	case 32: FOR_EACH_PIXEL(32, ASSIGN32BYTES(dst, src)) break;
-	default: VERA_ASSERT_MSG(false, "invalid pixel size");
+	return result;
+}
+
+Image ImageEdit::flip(const Image& image, ImageFlipFlags flags)
+{
+	return ImageEdit::flip(
+		image,
+		flags.has(ImageFlipFlagBits::Horizontal),
+		flags.has(ImageFlipFlagBits::Vertical));
+}
+
+Image ImageEdit::rotate(const Image& image, Rotation rot)
+{
+	switch (rot) {
+	case Rotation::_90Deg:  return ImageEdit::rotateCW(image);
+	case Rotation::_180Deg: return ImageEdit::flip(image, true, true);
+	case Rotation::_270Deg: return ImageEdit::rotateCCW(image);
+	default:                return image;
 	}
+}
+
+Image ImageEdit::rotateCW(const Image& image)
+{
+	Image result(image.height(), image.width(), image.format());
+
+	ImageEdit::rotateCW(result.view(), image.view());
 
 	return result;
+}
 
-#undef FOR_EACH_PIXEL
+Image ImageEdit::rotateCCW(const Image& image)
+{
+	Image result(image.height(), image.width(), image.format());
+
+	ImageEdit::rotateCCW(result.view(), image.view());
+
+	return result;
 }
 
 Image ImageEdit::blit(const Image& image, const ImageSampler& sampler, const ImageBlitInfo& info)
@@ -272,29 +852,46 @@ Image ImageEdit::blit(const Image& image, const ImageSampler& sampler, const Ima
 	uint32_t dst_width  = info.dstWidth;
 	uint32_t dst_height = info.dstHeight;
 	Format   format     = image.format();
-	float2   uv0        = info.uv0;
-	float2   uv1        = info.uv1;
-	float2   uv2        = info.uv2;
-	float2   uv3        = info.uv3;
 
 	Image result(dst_width, dst_height, format);
 
-	void* ptr = result.data();
-
-	for (uint32_t x = 0; x < dst_width; ++x) {
-		for (uint32_t y = 0; y < dst_height; ++y) {
-			float  tx = static_cast<float>(x) / dst_width;
-			float  ty = static_cast<float>(y) / dst_height;
-			float2 p0 = lerp(uv0, uv1, tx);
-			float2 p1 = lerp(uv3, uv2, tx);
-			float2 p  = lerp(p0, p1, ty);
+	if (dst_width == 0 || dst_height == 0) return result;
 
-			float4 color = sampler.sample(image, p.x, p.y);
+	// the top and bottom edge points only depend on the column, they are shared by every row
+	std::vector<float2> column_top(dst_width);
+	std::vector<float2> column_bottom(dst_width);
 
-			store_components(ptr, dst_width, x, y, format, color);
-		}
+	for (uint32_t x = 0; x < dst_width; ++x) {
+		float tx = static_cast<float>(x) / dst_width;
+		column_top[x]    = lerp(info.uv0, info.uv1, tx);
+		column_bottom[x] = lerp(info.uv3, info.uv2, tx);
 	}
 
+	BlitContext ctx;
+	ctx.srcPtr       = image.data();
+	ctx.srcWidth     = image.width();
+	ctx.srcHeight    = image.height();
+	ctx.dstPtr       = result.data();
+	ctx.dstWidth     = dst_width;
+	ctx.dstHeight    = dst_height;
+	ctx.format       = format;
+	ctx.borderColor  = sampler.getBorderColor();
+	ctx.unnormalized = sampler.isUnnormalized();
+	ctx.separable    = is_axis_aligned(info);
+	ctx.columnTop    = column_top.data();
+	ctx.columnBottom = column_bottom.data();
+
+	BlitRowsFunc blit_rows = select_blit_rows(
+		format,
+		sampler.getFilter(),
+		sampler.getAddressModeU(),
+		sampler.getAddressModeV());
+
+	parallel_for(dst_height, std::max(1u, BLIT_PIXELS_PER_TASK / dst_width),
+		[&](uint32_t begin_y, uint32_t end_y) {
+			blit_rows(ctx, begin_y, end_y);
+		});
+
 	return result;
 }
 
@@ -332,26 +929,6 @@ Image ImageEdit::createMask(const Image& image, uint32_t at_x, uint32_t at_y, fl
 
 void ImageEdit::flip(Image& result, const Image& image, bool horizontal, bool vertical)
 {
-////////// define some macros /////////////////////////////////////////////////////////////////////
-
-#define FOR_EACH_PIXEL0(pixel_size, content) \
-	for (uint32_t i = 0; i < n; ++i) { \
-		uint8_t* ptr0 = ptr + pixel_size * i; \
-		uint8_t* ptr1 = ptr + size - pixel_size * (i + 1); \
-		content \
-	}
-
-#define FOR_EACH_PIXEL1(pixel_size, content) \
-	for (uint32_t y = 0; y < height; ++y) { \
-		for (uint32_t x = 0; x < n; ++x) { \
-			uint8_t* ptr0 = ptr + pixel_size * (width * y + x); \
-			uint8_t* ptr1 = ptr + pixel_size * (width * y + width - x - 1); \
-			content \
-		} \
-	}
-
-///////////////////////////////////////////////////////////////////////////////////////////////////
-
 	if (!horizontal && !vertical) {
 		result = image;
 		return;
@@ -362,57 +939,7 @@ void ImageEdit::flip(Image& result, const Image& image, bool horizontal, bool ve
 		return;
 	}
 
-	const Format   format     = image.format();
-	const uint32_t width      = image.width();
-	const uint32_t height     = image.height();
-	const uint32_t pixel_size = get_format_size(format);
-	const uint32_t row_bytes  = width * pixel_size;
-	uint8_t*       ptr        = reinterpret_cast<uint8_t*>(result.data());
-
-	if (horizontal && vertical) {
-		uint32_t size = height * row_bytes;
-		uint32_t n    = width * height / 2;
-
-		switch (pixel_size) {
-		case 1:  FOR_EACH_PIXEL0(1,  SWAP1BYTES(ptr0, ptr1))  break;
-		case 2:  FOR_EACH_PIXEL0(2,  SWAP2BYTES(ptr0, ptr1))  break;
-		case 3:  FOR_EACH_PIXEL0(3,  SWAP3BYTES(ptr0, ptr1))  break;
-		case 4:  FOR_EACH_PIXEL0(4,  SWAP4BYTES(ptr0, ptr1))  break;
-		case 5:  FOR_EACH_PIXEL0(5,  SWAP5BYTES(ptr0, ptr1))  break;
-		case 6:  FOR_EACH_PIXEL0(6,  SWAP6BYTES(ptr0, ptr1))  break;
-		case 8:  FOR_EACH_PIXEL0(8,  SWAP8BYTES(ptr0, ptr1))  break;
-		case 12: FOR_EACH_PIXEL0(12, SWAP12BYTES(ptr0, ptr1)) break;
-		case 16: FOR_EACH_PIXEL0(16, SWAP16BYTES(ptr0, ptr1)) break;
-		case 24: FOR_EACH_PIXEL0(24, SWAP24BYTES(ptr0, ptr1)) break;
-		case 32: FOR_EACH_PIXEL0(32, SWAP32BYTES(ptr0, ptr1)) break;
-		default: VERA_ASSERT_MSG(false, "invalid pixel size");
-		}
-	} else if (!horizontal && vertical) {
-		uint32_t mid_height = height / 2;
-
-		for (uint32_t y = 0; y < mid_height; ++y)
-			memswap(ptr + row_bytes * y, ptr + row_bytes * (height - y - 1), row_bytes);
-	} else if (horizontal && !vertical) {
-		uint32_t n = width / 2;
-
-		switch (pixel_size) {
-		case 1:  FOR_EACH_PIXEL1(1,  SWAP1BYTES(ptr0, ptr1))  break;
-		case 2:  FOR_EACH_PIXEL1(2,  SWAP2BYTES(ptr0, ptr1))  break;
-		case 3:  FOR_EACH_PIXEL1(3,  SWAP3BYTES(ptr0, ptr1))  break;
-		case 4:  FOR_EACH_PIXEL1(4,  SWAP4BYTES(ptr0, ptr1))  break;
-		case 5:  FOR_EACH_PIXEL1(5,  SWAP5BYTES(ptr0, ptr1))  break;
-		case 6:  FOR_EACH_PIXEL1(6,  SWAP6BYTES(ptr0, ptr1))  break;
-		case 8:  FOR_EACH_PIXEL1(8,  SWAP8BYTES(ptr0, ptr1))  break;
-		case 12: FOR_EACH_PIXEL1(12, SWAP12BYTES(ptr0, ptr1)) break;
-		case 16: FOR_EACH_PIXEL1(16, SWAP16BYTES(ptr0, ptr1)) break;
-		case 24: FOR_EACH_PIXEL1(24, SWAP24BYTES(ptr0, ptr1)) break;
-		case 32: FOR_EACH_PIXEL1(32, SWAP32BYTES(ptr0, ptr1)) break;
-		default: VERA_ASSERT_MSG(false, "invalid pixel size");
-		}
-	}
-
-#undef FOR_EACH_PIXEL0
-#undef FOR_EACH_PIXEL1
+	ImageEdit::flip(result.view(), result.view(), horizontal, vertical);
 }
 
 void ImageEdit::flip(Image& result, const Image& image, ImageFlipFlags flags)
@@ -444,4 +971,153 @@ void ImageEdit::rotateCCW(Image& result, const Image& image)
 	result = ImageEdit::rotateCCW(image);
 }
 
+void ImageEdit::copy(ImageView dst, ConstImageView src)
+{
+	VERA_ASSERT_MSG(dst.format() == src.format(), "image views must have the same format");
+	VERA_ASSERT_MSG(dst.width() == src.width() && dst.height() == src.height(), "image views must have the same extent");
+
+	const size_t row_size = src.rowSize();
+
+	if (dst.isContiguous() && src.isContiguous()) {
+		memcpy(dst.data(), src.data(), row_size * src.height());
+		return;
+	}
+
+	for (uint32_t y = 0; y < src.height(); ++y)
+		memcpy(dst.row(y), src.row(y), row_size);
+}
+
+void ImageEdit::flip(ImageView dst, ConstImageView src, bool horizontal, bool vertical)
+{
+	VERA_ASSERT_MSG(dst.format() == src.format(), "image views must have the same format");
+	VERA_ASSERT_MSG(dst.width() == src.width() && dst.height() == src.height(), "image views must have the same extent");
+
+	const uint32_t width    = src.width();
+	const uint32_t height   = src.height();
+	const size_t   row_size = src.rowSize();
+
+	if (!horizontal && !vertical) {
+		if (dst.data() != src.data())
+			ImageEdit::copy(dst, src);
+		return;
+	}
+
+	if (dst.data() != src.data()) {
+		if (!horizontal) {
+			for (uint32_t y = 0; y < height; ++y)
+				memcpy(dst.row(height - y - 1), src.row(y), row_size);
+			return;
+		}
+
+		const auto reverse_row = get_pixel_kernels(src.pixelSize()).reverseRow;
+
+		for (uint32_t y = 0; y < height; ++y)
+			reverse_row(dst.row(vertical ? height - y - 1 : y), src.row(y), width);
+
+		return;
+	}
+
+	VERA_ASSERT_MSG(dst.rowPitch() == src.rowPitch(), "image views flipped in place must have the same pitch");
+
+	// rows are staged through a scratch row since the kernels never work in place
+	std::vector<uint8_t> row(row_size);
+
+	if (!horizontal) {
+		for (uint32_t y = 0; y < height / 2; ++y) {
+			uint8_t* top    = dst.row(y);
+			uint8_t* bottom = dst.row(height - y - 1);
+
+			memcpy(row.data(), top, row_size);
+			memcpy(top, bottom, row_size);
+			memcpy(bottom, row.data(), row_size);
+		}
+		return;
+	}
+
+	const auto reverse_row = get_pixel_kernels(src.pixelSize()).reverseRow;
+
+	if (!vertical) {
+		for (uint32_t y = 0; y < height; ++y) {
+			uint8_t* line = dst.row(y);
+
+			memcpy(row.data(), line, row_size);
+			reverse_row(line, row.data(), width);
+		}
+		return;
+	}
+
+	for (uint32_t y = 0; y < height / 2; ++y) {
+		uint8_t* top    = dst.row(y);
+		uint8_t* bottom = dst.row(height - y - 1);
+
+		memcpy(row.data(), top, row_size);
+		reverse_row(top, bottom, width);
+		reverse_row(bottom, row.data(), width);
+	}
+
+	if (height % 2) {
+		uint8_t* line = dst.row(height / 2);
+
+		memcpy(row.data(), line, row_size);
+		reverse_row(line, row.data(), width);
+	}
+}
+
+void ImageEdit::flip(ImageView dst, ConstImageView src, ImageFlipFlags flags)
+{
+	ImageEdit::flip(
+		dst,
+		src,
+		flags.has(ImageFlipFlagBits::Horizontal),
+		flags.has(ImageFlipFlagBits::Vertical));
+}
+
+void ImageEdit::rotate(ImageView dst, ConstImageView src, Rotation rot)
+{
+	switch (rot) {
+	case Rotation::_90Deg:  ImageEdit::rotateCW(dst, src); break;
+	case Rotation::_180Deg: ImageEdit::flip(dst, src, true, true); break;
+	case Rotation::_270Deg: ImageEdit::rotateCCW(dst, src); break;
+	default:                ImageEdit::copy(dst, src); break;
+	}
+}
+
+void ImageEdit::rotateCW(ImageView dst, ConstImageView src)
+{
+	VERA_ASSERT_MSG(dst.format() == src.format(), "image views must have the same format");
+	VERA_ASSERT_MSG(dst.width() == src.height() && dst.height() == src.width(), "rotated view must have the transposed extent");
+
+	if (src.empty()) return;
+
+	// rotating clockwise is transposing the image read from the bottom row up
+	transpose_image(
+		dst.row(0),
+		dst.rowPitch(),
+		src.row(src.height() - 1),
+		-src.rowPitch(),
+		src.height(),
+		src.width(),
+		src.pixelSize(),
+		get_pixel_kernels(src.pixelSize()));
+}
+
+void ImageEdit::rotateCCW(ImageView dst, ConstImageView src)
+{
+	VERA_ASSERT_MSG(dst.format() == src.format(), "image views must have the same format");
+	VERA_ASSERT_MSG(dst.width() == src.height() && dst.height() == src.width(), "rotated view must have the transposed extent");
+
+	if (src.empty()) return;
+
+	// rotating counter clockwise is transposing the image and writing it from the bottom row up
+	transpose_image(
+		dst.row(dst.height() - 1),
+		-dst.rowPitch(),
+		src.row(0),
+		src.rowPitch(),
+		src.height(),
+		src.width(),
+		src.pixelSize(),
+		get_pixel_kernels(src.pixelSize()));
+}
+
 VERA_NAMESPACE_END
@@ -0,0 +1,543 @@
+#include "../../include/vera/graphics/image_stream.h"
+
+#include "../../include/vera/core/exception.h"
+#include "../../include/vera/graphics/format_traits.h"
+#include "../../include/vera/graphics/image_edit.h"
+#include <stb_image.h>
+#include <filesystem>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <utility>
+
+#define BITMAP_FILE_HEADER_SIZE 14
+#define BITMAP_INFO_HEADER_SIZE 40
+#define BITMAP_V4_HEADER_SIZE   108
+#define BITMAP_PALETTE_SIZE     1024
+#define BITMAP_PIXELS_PER_METER 2835 // 72 dpi
+#define BITMAP_BI_RGB           0
+#define BITMAP_BI_BITFIELDS     3
+#define BITMAP_LCS_SRGB         0x73524742 // 'sRGB'
+
+VERA_NAMESPACE_BEGIN
+
+static uint16_t read_u16(const uint8_t* ptr)
+{
+	return static_cast<uint16_t>(ptr[0] | (ptr[1] << 8));
+}
+
+static uint32_t read_u32(const uint8_t* ptr)
+{
+	return
+		static_cast<uint32_t>(ptr[0]) |
+		(static_cast<uint32_t>(ptr[1]) << 8) |
+		(static_cast<uint32_t>(ptr[2]) << 16) |
+		(static_cast<uint32_t>(ptr[3]) << 24);
+}
+
+static uint8_t* write_u16(uint8_t* ptr, uint16_t value)
+{
+	ptr[0] = static_cast<uint8_t>(value);
+	ptr[1] = static_cast<uint8_t>(value >> 8);
+	return ptr + 2;
+}
+
+static uint8_t* write_u32(uint8_t* ptr, uint32_t value)
+{
+	ptr[0] = static_cast<uint8_t>(value);
+	ptr[1] = static_cast<uint8_t>(value >> 8);
+	ptr[2] = static_cast<uint8_t>(value >> 16);
+	ptr[3] = static_cast<uint8_t>(value >> 24);
+	return ptr + 4;
+}
+
+static size_t get_bitmap_row_pitch(uint32_t width, uint32_t bit_count)
+{
+	return (static_cast<size_t>(width) * bit_count + 31) / 32 * 4;
+}
+
+// True when the V4 or V5 header of a 32 bit bitmap declares its bytes as blue, green, red and alpha
+static bool has_bgra_masks(const uint8_t* info, uint32_t info_size, uint32_t compression)
+{
+	return
+		info_size >= BITMAP_V4_HEADER_SIZE &&
+		compression == BITMAP_BI_BITFIELDS &&
+		read_u32(info + 40) == 0x00ff0000 &&
+		read_u32(info + 44) == 0x0000ff00 &&
+		read_u32(info + 48) == 0x000000ff &&
+		read_u32(info + 52) == 0xff000000;
+}
+
+// Maps uncompressed 24 bit bitmaps, 32 bit bitmaps with an alpha mask and 8 bit bitmaps with a gray
+// palette, the formats whose rows can be read as they are stored. Others are left to stb_image, which
+// also takes 32 bit bitmaps without an alpha mask, their fourth byte is usually 0 rather than alpha.
+static bool map_bitmap(const MappedFile& file, ConstImageView& out_view)
+{
+	const uint8_t* ptr  = file.data();
+	const size_t   size = file.size();
+
+	if (size < BITMAP_FILE_HEADER_SIZE + BITMAP_INFO_HEADER_SIZE || ptr[0] != 'B' || ptr[1] != 'M')
+		return false;
+
+	const uint8_t* info         = ptr + BITMAP_FILE_HEADER_SIZE;
+	const uint32_t pixel_offset = read_u32(ptr + 10);
+	const uint32_t info_size    = read_u32(info);
+	const int32_t  width        = static_cast<int32_t>(read_u32(info + 4));
+	const int32_t  height       = static_cast<int32_t>(read_u32(info + 8));
+	const uint16_t bit_count    = read_u16(info + 14);
+	const uint32_t compression  = read_u32(info + 16);
+	const uint32_t color_count  = read_u32(info + 32);
+
+	if (info_size < BITMAP_INFO_HEADER_SIZE || info_size > size - BITMAP_FILE_HEADER_SIZE)
+		return false;
+	if (width <= 0 || height == 0 || height == INT32_MIN)
+		return false;
+
+	Format format;
+
+	switch (bit_count) {
+	case 24: {
+		if (compression != BITMAP_BI_RGB)
+			return false;
+
+		format = Format::BGR8Unorm;
+	} break;
+	case 32: {
+		if (!has_bgra_masks(info, info_size, compression))
+			return false;
+
+		format = Format::BGRA8Unorm;
+	} break;
+	case 8: {
+		const uint8_t* palette       = info + info_size;
+		const uint32_t palette_count = color_count ? color_count : 256;
+
+		if (compression != BITMAP_BI_RGB || palette_count != 256)
+			return false;
+		if (size - BITMAP_FILE_HEADER_SIZE - info_size < BITMAP_PALETTE_SIZE)
+			return false;
+
+		for (uint32_t i = 0; i < 256; ++i)
+			if (palette[4 * i] != i || palette[4 * i + 1] != i || palette[4 * i + 2] != i)
+				return false;
+
+		format = Format::R8Unorm;
+	} break;
+	default:
+		return false;
+	}
+
+	const uint32_t row_count = static_cast<uint32_t>(height < 0 ? -height : height);
+	const size_t   row_pitch = get_bitmap_row_pitch(width, bit_count);
+
+	if (pixel_offset > size || (size - pixel_offset) / row_pitch < row_count)
+		return false;
+
+	// rows are stored bottom up unless the height is negative
+	if (height < 0)
+		out_view = ConstImageView(ptr + pixel_offset, width, row_count, format, row_pitch);
+	else
+		out_view = ConstImageView(
+			ptr + pixel_offset + row_pitch * (row_count - 1),
+			width,
+			row_count,
+			format,
+			-static_cast<ptrdiff_t>(row_pitch));
+
+	return true;
+}
+
+static Format get_decoded_format(int comp, bool is_16_bit, bool is_hdr)
+{
+	static const Format formats_8[]  = { Format::R8Unorm, Format::RG8Unorm, Format::RGB8Unorm, Format::RGBA8Unorm };
+	static const Format formats_16[] = { Format::R16Unorm, Format::RG16Unorm, Format::RGB16Unorm, Format::RGBA16Unorm };
+	static const Format formats_32[] = { Format::R32Float, Format::RG32Float, Format::RGB32Float, Format::RGBA32Float };
+
+	if (is_hdr) return formats_32[comp - 1];
+	if (is_16_bit) return formats_16[comp - 1];
+	return formats_8[comp - 1];
+}
+
+ImageReader::ImageReader() VERA_NOEXCEPT :
+	m_decoded(nullptr) {}
+
+ImageReader::ImageReader(std::string_view path) :
+	ImageReader()
+{
+	open(path);
+}
+
+ImageReader::ImageReader(std::string_view path, uint32_t width, uint32_t height, Format format, size_t offset) :
+	ImageReader()
+{
+	openRaw(path, width, height, format, offset);
+}
+
+ImageReader::ImageReader(ImageReader&& rhs) VERA_NOEXCEPT :
+	m_file(std::move(rhs.m_file)),
+	m_decoded(std::exchange(rhs.m_decoded, nullptr)),
+	m_view(std::exchange(rhs.m_view, {})) {}
+
+ImageReader::~ImageReader() VERA_NOEXCEPT
+{
+	close();
+}
+
+ImageReader& ImageReader::operator=(ImageReader&& rhs) VERA_NOEXCEPT
+{
+	if (this != &rhs) {
+		close();
+
+		m_file    = std::move(rhs.m_file);
+		m_decoded = std::exchange(rhs.m_decoded, nullptr);
+		m_view    = std::exchange(rhs.m_view, {});
+	}
+
+	return *this;
+}
+
+void ImageReader::open(std::string_view path)
+{
+	close();
+
+	auto extension = std::filesystem::path(path).extension().generic_string();
+
+	m_file.open(path);
+
+	if (extension == ".bmp" && map_bitmap(m_file, m_view))
+		return;
+
+	if (m_file.size() > INT_MAX) {
+		m_file.close();
+		throw Exception("image at {} is too large to decode", path);
+	}
+
+	const auto* ptr       = m_file.data();
+	const int   size      = static_cast<int>(m_file.size());
+	const bool  is_hdr    = stbi_is_hdr_from_memory(ptr, size);
+	const bool  is_16_bit = !is_hdr && stbi_is_16_bit_from_memory(ptr, size);
+	int         width, height, comp;
+
+	if (is_hdr)
+		m_decoded = stbi_loadf_from_memory(ptr, size, &width, &height, &comp, 0);
+	else if (is_16_bit)
+		m_decoded = stbi_load_16_from_memory(ptr, size, &width, &height, &comp, 0);
+	else
+		m_decoded = stbi_load_from_memory(ptr, size, &width, &height, &comp, 0);
+
+	m_file.close();
+
+	if (!m_decoded)
+		throw Exception("unable to load image at {}", path);
+
+	m_view = ConstImageView(m_decoded, width, height, get_decoded_format(comp, is_16_bit, is_hdr));
+}
+
+bool ImageReader::readHeader(std::string_view path, uint32_t& out_width, uint32_t& out_height, Format& out_format)
+{
+	auto extension = std::filesystem::path(path).extension().generic_string();
+
+	MappedFile     file(path);
+	ConstImageView view;
+
+	if (extension == ".bmp" && map_bitmap(file, view)) {
+		out_width  = view.width();
+		out_height = view.height();
+		out_format = view.format();
+		return false;
+	}
+
+	if (file.size() > INT_MAX)
+		throw Exception("image at {} is too large to decode", path);
+
+	const auto* ptr       = file.data();
+	const int   size      = static_cast<int>(file.size());
+	const bool  is_hdr    = stbi_is_hdr_from_memory(ptr, size);
+	const bool  is_16_bit = !is_hdr && stbi_is_16_bit_from_memory(ptr, size);
+	int         width, height, comp;
+
+	if (!stbi_info_from_memory(ptr, size, &width, &height, &comp))
+		throw Exception("unable to load image at {}", path);
+
+	out_width  = static_cast<uint32_t>(width);
+	out_height = static_cast<uint32_t>(height);
+	out_format = get_decoded_format(comp, is_16_bit, is_hdr);
+
+	return true;
+}
+
+void ImageReader::openRaw(std::string_view path, uint32_t width, uint32_t height, Format format, size_t offset)
+{
+	close();
+
+	m_file.open(path);
+
+	const size_t row_size = static_cast<size_t>(width) * get_format_size(format);
+
+	if (offset > m_file.size() || (row_size && (m_file.size() - offset) / row_size < height)) {
+		m_file.close();
+		throw Exception("raw image at {} is smaller than {}x{} pixels", path, width, height);
+	}
+
+	m_view = ConstImageView(m_file.data() + offset, width, height, format);
+}
+
+void ImageReader::close() VERA_NOEXCEPT
+{
+	if (m_decoded) {
+		stbi_image_free(m_decoded);
+		m_decoded = nullptr;
+	}
+
+	m_file.close();
+	m_view = {};
+}
+
+bool ImageReader::isOpen() const VERA_NOEXCEPT
+{
+	return m_view.format() != Format::Unknown;
+}
+
+bool ImageReader::isMapped() const VERA_NOEXCEPT
+{
+	return !m_file.empty();
+}
+
+uint32_t ImageReader::width() const VERA_NOEXCEPT
+{
+	return m_view.width();
+}
+
+uint32_t ImageReader::height() const VERA_NOEXCEPT
+{
+	return m_view.height();
+}
+
+Format ImageReader::format() const VERA_NOEXCEPT
+{
+	return m_view.format();
+}
+
+ConstImageView ImageReader::view() const VERA_NOEXCEPT
+{
+	return m_view;
+}
+
+void ImageReader::read(ImageView dst, uint32_t x, uint32_t y) const
+{
+	if (dst.format() != m_view.format())
+		throw Exception("image reader does not convert pixel formats");
+
+	ImageEdit::copy(dst, m_view.subview(x, y, dst.width(), dst.height()));
+}
+
+Image ImageReader::read(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const
+{
+	return Image(m_view.subview(x, y, width, height));
+}
+
+Image ImageReader::read() const
+{
+	return Image(m_view);
+}
+
+void ImageReader::readBands(
+	uint32_t                 x,
+	uint32_t                 y,
+	uint32_t                 width,
+	uint32_t                 height,
+	uint32_t                 band_height,
+	const ImageBandCallback& callback) const
+{
+	const ConstImageView region = m_view.subview(x, y, width, height);
+
+	band_height = std::max(band_height, 1u);
+
+	for (uint32_t band_y = 0; band_y < height; band_y += band_height)
+		callback(region.subview(0, band_y, width, std::min(band_height, height - band_y)), band_y);
+}
+
+ImageWriter::ImageWriter() VERA_NOEXCEPT :
+	m_width(0),
+	m_height(0),
+	m_format(Format::Unknown),
+	m_row_count(0),
+	m_bitmap(false) {}
+
+ImageWriter::ImageWriter(std::string_view path, uint32_t width, uint32_t height, Format format) :
+	ImageWriter()
+{
+	open(path, width, height, format);
+}
+
+ImageWriter::~ImageWriter()
+{
+	// an unfinished file is left as it is, close reports it
+	if (m_stream.is_open())
+		m_stream.close();
+}
+
+void ImageWriter::open(std::string_view path, uint32_t width, uint32_t height, Format format)
+{
+	auto extension = std::filesystem::path(path).extension().generic_string();
+
+	if (m_stream.is_open())
+		m_stream.close();
+
+	if (extension != ".bmp" && extension != ".raw")
+		throw Exception("image writer only streams .bmp and .raw files");
+
+	m_width     = width;
+	m_height    = height;
+	m_format    = format;
+	m_row_count = 0;
+	m_bitmap    = extension == ".bmp";
+
+	uint32_t bit_count = 0;
+
+	if (m_bitmap) {
+		switch (format) {
+		case Format::R8Unorm:
+			bit_count = 8;
+			break;
+		case Format::RGB8Unorm:
+		case Format::RGB8Srgb:
+		case Format::BGR8Unorm:
+		case Format::BGR8Srgb:
+			bit_count = 24;
+			break;
+		case Format::RGBA8Unorm:
+		case Format::RGBA8Srgb:
+		case Format::BGRA8Unorm:
+		case Format::BGRA8Srgb:
+			bit_count = 32;
+			break;
+		default:
+			throw Exception("bitmaps cannot store the pixel format of the image");
+		}
+
+		if (width > INT32_MAX || height > INT32_MAX)
+			throw Exception("image is too large for a bitmap");
+	}
+
+	m_stream.open(std::string(path), std::ios::binary | std::ios::trunc);
+
+	if (!m_stream)
+		throw Exception("unable to open image at {}", path);
+
+	if (!m_bitmap) return;
+
+	// 32 bit rows get a V4 header with an alpha mask, so readers take the fourth byte as alpha
+	const size_t   row_pitch    = get_bitmap_row_pitch(width, bit_count);
+	const uint32_t info_size    = bit_count == 32 ? BITMAP_V4_HEADER_SIZE : BITMAP_INFO_HEADER_SIZE;
+	const uint32_t palette_size = bit_count == 8 ? BITMAP_PALETTE_SIZE : 0;
+	const uint32_t pixel_offset = BITMAP_FILE_HEADER_SIZE + info_size + palette_size;
+	const uint64_t image_size   = static_cast<uint64_t>(row_pitch) * height;
+
+	uint8_t  header[BITMAP_FILE_HEADER_SIZE + BITMAP_V4_HEADER_SIZE + BITMAP_PALETTE_SIZE] = {};
+	uint8_t* ptr = header;
+
+	// sizes past 4GB cannot be stored, readers take them from the dimensions
+	*ptr++ = 'B';
+	*ptr++ = 'M';
+	ptr = write_u32(ptr, static_cast<uint32_t>(std::min<uint64_t>(pixel_offset + image_size, UINT32_MAX)));
+	ptr = write_u32(ptr, 0);
+	ptr = write_u32(ptr, pixel_offset);
+
+	// a negative height stores the rows top down so they can be written as they come
+	ptr = write_u32(ptr, info_size);
+	ptr = write_u32(ptr, width);
+	ptr = write_u32(ptr, static_cast<uint32_t>(-static_cast<int32_t>(height)));
+	ptr = write_u16(ptr, 1);
+	ptr = write_u16(ptr, static_cast<uint16_t>(bit_count));
+	ptr = write_u32(ptr, bit_count == 32 ? BITMAP_BI_BITFIELDS : BITMAP_BI_RGB);
+	ptr = write_u32(ptr, static_cast<uint32_t>(std::min<uint64_t>(image_size, UINT32_MAX)));
+	ptr = write_u32(ptr, BITMAP_PIXELS_PER_METER);
+	ptr = write_u32(ptr, BITMAP_PIXELS_PER_METER);
+	ptr = write_u32(ptr, palette_size ? 256 : 0);
+	ptr = write_u32(ptr, 0);
+
+	if (bit_count == 32) {
+		ptr = write_u32(ptr, 0x00ff0000);
+		ptr = write_u32(ptr, 0x0000ff00);
+		ptr = write_u32(ptr, 0x000000ff);
+		ptr = write_u32(ptr, 0xff000000);
+		ptr = write_u32(ptr, BITMAP_LCS_SRGB);
+		ptr += BITMAP_V4_HEADER_SIZE - BITMAP_INFO_HEADER_SIZE - 20; // endpoints and gamma unused
+	}
+
+	for (uint32_t i = 0; i < palette_size / 4; ++i) {
+		*ptr++ = static_cast<uint8_t>(i);
+		*ptr++ = static_cast<uint8_t>(i);
+		*ptr++ = static_cast<uint8_t>(i);
+		*ptr++ = 0;
+	}
+
+	m_stream.write(reinterpret_cast<const char*>(header), pixel_offset);
+	m_row.assign(row_pitch, 0);
+}
+
+void ImageWriter::close()
+{
+	if (!m_stream.is_open()) return;
+
+	m_stream.close();
+
+	if (m_row_count < m_height)
+		throw Exception("image writer closed after {} of {} rows", m_row_count, m_height);
+}
+
+void ImageWriter::write(ConstImageView band)
+{
+	if (!m_stream.is_open())
+		throw Exception("image writer is not open");
+	if (band.width() != m_width || band.format() != m_format)
+		throw Exception("band does not match the width and format of the image");
+	if (band.height() > m_height - m_row_count)
+		throw Exception("band runs past the bottom of the image");
+
+	const size_t row_size = band.rowSize();
+	const bool   swizzle  =
+		m_format == Format::RGB8Unorm ||
+		m_format == Format::RGB8Srgb ||
+		m_format == Format::RGBA8Unorm ||
+		m_format == Format::RGBA8Srgb;
+
+	for (uint32_t y = 0; y < band.height(); ++y) {
+		const uint8_t* row = band.row(y);
+
+		if (!m_bitmap) {
+			m_stream.write(reinterpret_cast<const char*>(row), row_size);
+			continue;
+		}
+
+		memcpy(m_row.data(), row, row_size);
+
+		// bitmaps store blue first
+		if (swizzle) {
+			const uint32_t pixel_size = band.pixelSize();
+
+			for (size_t i = 0; i < row_size; i += pixel_size)
+				std::swap(m_row[i], m_row[i + 2]);
+		}
+
+		m_stream.write(reinterpret_cast<const char*>(m_row.data()), m_row.size());
+	}
+
+	if (!m_stream)
+		throw Exception("failed to write image rows");
+
+	m_row_count += band.height();
+}
+
+bool ImageWriter::isOpen() const VERA_NOEXCEPT
+{
+	return m_stream.is_open();
+}
+
+uint32_t ImageWriter::getWrittenRowCount() const VERA_NOEXCEPT
+{
+	return m_row_count;
+}
+
+VERA_NAMESPACE_END
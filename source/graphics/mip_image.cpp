@@ -0,0 +1,685 @@
+#include "../../include/vera/graphics/mip_image.h"
+
+#include "../../include/vera/core/exception.h"
+#include "../../include/vera/graphics/format_traits.h"
+#include "../util/parallel_for.h"
+#include "pixel.h"
+#include <algorithm>
+#include <numbers>
+#include <numeric>
+#include <cstring>
+#include <cmath>
+#include <bit>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define VERA_MIP_IMAGE_X64
+#include <immintrin.h>
+#endif
+
+VERA_NAMESPACE_BEGIN
+
+static constexpr uint32_t MIP_PIXELS_PER_TASK      = 16384;
+static constexpr float    KAISER_RADIUS            = 3.f;
+static constexpr float    KAISER_ALPHA             = 4.f;
+static constexpr float    LANCZOS_RADIUS           = 3.f;
+static constexpr float    MAX_ALPHA_SCALE          = 4.f;
+static constexpr uint32_t ALPHA_SCALE_SEARCH_STEPS = 10;
+
+typedef void (*DecodeRowFunc)(const void* ptr, uint32_t width, uint32_t y, Format format, float4* out);
+typedef void (*EncodeRowFunc)(void* ptr, uint32_t width, uint32_t y, Format format, const float4* in);
+
+struct MipCodec
+{
+	DecodeRowFunc decodeRow;
+	EncodeRowFunc encodeRow;
+};
+
+// Weights of one axis of a level, destination texel i reads tapCount consecutive source texels
+// starting at first[i]. Taps falling outside of the image are folded onto the edge texel.
+struct FilterTaps
+{
+	std::vector<uint32_t> first;
+	std::vector<float>    weights;
+	uint32_t              tapCount;
+};
+
+struct MipContext
+{
+	MipCodec  codec;
+	Format    format;    // format handed to the codec, the srgb twin of flagged unorm formats
+	bool      linearize; // flagged unorm format without an srgb twin, converted around the filter
+	float     minValue;
+	float     maxValue;
+};
+
+struct MipLevelView
+{
+	uint8_t* ptr;
+	uint32_t width;
+	uint32_t height;
+};
+
+template <Format F>
+static void decode_row(const void* ptr, uint32_t width, uint32_t y, Format format, float4* out)
+{
+	for (uint32_t x = 0; x < width; ++x)
+		out[x] = PixelCodec<F>::load(ptr, width, x, y, format);
+}
+
+template <Format F>
+static void encode_row(void* ptr, uint32_t width, uint32_t y, Format format, const float4* in)
+{
+	for (uint32_t x = 0; x < width; ++x)
+		PixelCodec<F>::store(ptr, width, x, y, format, in[x]);
+}
+
+template <Format F>
+static MipCodec make_mip_codec()
+{
+	return { decode_row<F>, encode_row<F> };
+}
+
+static MipCodec get_mip_codec(Format format)
+{
+	switch (format) {
+	case Format::R8Unorm:     return make_mip_codec<Format::R8Unorm>();
+	case Format::RG8Unorm:    return make_mip_codec<Format::RG8Unorm>();
+	case Format::RGBA8Unorm:  return make_mip_codec<Format::RGBA8Unorm>();
+	case Format::BGRA8Unorm:  return make_mip_codec<Format::BGRA8Unorm>();
+	case Format::RGBA8Srgb:   return make_mip_codec<Format::RGBA8Srgb>();
+	case Format::BGRA8Srgb:   return make_mip_codec<Format::BGRA8Srgb>();
+	case Format::R16Unorm:    return make_mip_codec<Format::R16Unorm>();
+	case Format::RGBA16Unorm: return make_mip_codec<Format::RGBA16Unorm>();
+	case Format::RGBA16Float: return make_mip_codec<Format::RGBA16Float>();
+	case Format::R32Float:    return make_mip_codec<Format::R32Float>();
+	case Format::RGBA32Float: return make_mip_codec<Format::RGBA32Float>();
+	}
+
+	return make_mip_codec<Format::Unknown>();
+}
+
+// srgb formats share the layout of their unorm counterpart, so data flagged as srgb is simply
+// decoded and encoded as the srgb format
+static Format get_srgb_format(Format format)
+{
+	switch (format) {
+	case Format::R8Unorm:          return Format::R8Srgb;
+	case Format::RG8Unorm:         return Format::RG8Srgb;
+	case Format::RGB8Unorm:        return Format::RGB8Srgb;
+	case Format::BGR8Unorm:        return Format::BGR8Srgb;
+	case Format::RGBA8Unorm:       return Format::RGBA8Srgb;
+	case Format::BGRA8Unorm:       return Format::BGRA8Srgb;
+	case Format::ABGR8UnormPack32: return Format::ABGR8SrgbPack32;
+	}
+
+	return Format::Unknown;
+}
+
+static float sinc(float x)
+{
+	if (std::abs(x) < 1e-6f)
+		return 1.f;
+
+	x *= std::numbers::pi_v<float>;
+	return std::sin(x) / x;
+}
+
+// power series of the modified bessel function, converges in a few terms for the kaiser alpha
+static float bessel_i0(float x)
+{
+	float sum     = 1.f;
+	float term    = 1.f;
+	float half_sq = x * x * 0.25f;
+
+	for (uint32_t k = 1; k < 32 && sum * 1e-7f < term; ++k) {
+		term *= half_sq / static_cast<float>(k * k);
+		sum  += term;
+	}
+
+	return sum;
+}
+
+static float kaiser_kernel(float x)
+{
+	float t = x / KAISER_RADIUS;
+
+	if (1.f <= t * t)
+		return 0.f;
+
+	return sinc(x) * bessel_i0(KAISER_ALPHA * std::sqrt(1.f - t * t)) / bessel_i0(KAISER_ALPHA);
+}
+
+static float lanczos_kernel(float x)
+{
+	if (LANCZOS_RADIUS <= std::abs(x))
+		return 0.f;
+
+	return sinc(x) * sinc(x / LANCZOS_RADIUS);
+}
+
+static FilterTaps make_filter_taps(uint32_t src_size, uint32_t dst_size, MipFilter filter)
+{
+	struct Tap
+	{
+		uint32_t index;
+		float    weight;
+	};
+
+	const float scale = static_cast<float>(src_size) / static_cast<float>(dst_size);
+	const int   last  = static_cast<int>(src_size) - 1;
+
+	std::vector<std::vector<Tap>> texel_taps(dst_size);
+	FilterTaps                    result;
+
+	result.tapCount = 1;
+
+	for (uint32_t i = 0; i < dst_size; ++i) {
+		auto& taps = texel_taps[i];
+
+		auto add_tap = [&](int j, float weight) {
+			taps.push_back({ static_cast<uint32_t>(std::clamp(j, 0, last)), weight });
+		};
+
+		if (filter == MipFilter::Box) {
+			// area of every source texel covered by the destination texel
+			float begin = i * scale;
+			float end   = begin + scale;
+
+			for (int j = static_cast<int>(begin); static_cast<float>(j) < end; ++j) {
+				float weight = std::min(end, j + 1.f) - std::max(begin, static_cast<float>(j));
+				if (0.f < weight)
+					add_tap(j, weight);
+			}
+		} else {
+			float radius = (filter == MipFilter::Kaiser ? KAISER_RADIUS : LANCZOS_RADIUS) * scale;
+			float center = (i + 0.5f) * scale;
+			int   begin  = static_cast<int>(std::floor(center - radius));
+			int   end    = static_cast<int>(std::ceil(center + radius));
+
+			for (int j = begin; j <= end; ++j) {
+				float x      = (j + 0.5f - center) / scale;
+				float weight = filter == MipFilter::Kaiser ? kaiser_kernel(x) : lanczos_kernel(x);
+				if (weight != 0.f)
+					add_tap(j, weight);
+			}
+		}
+
+		auto [min_tap, max_tap] = std::minmax_element(VERA_SPAN(taps),
+			[](const Tap& lhs, const Tap& rhs) {
+				return lhs.index < rhs.index;
+			});
+
+		result.tapCount = std::max(result.tapCount, max_tap->index - min_tap->index + 1);
+	}
+
+	result.first.resize(dst_size);
+	result.weights.assign(static_cast<size_t>(dst_size) * result.tapCount, 0.f);
+
+	for (uint32_t i = 0; i < dst_size; ++i) {
+		auto& taps    = texel_taps[i];
+		auto  first   = std::min_element(VERA_SPAN(taps),
+			[](const Tap& lhs, const Tap& rhs) {
+				return lhs.index < rhs.index;
+			})->index;
+		auto* weights = &result.weights[static_cast<size_t>(i) * result.tapCount];
+		float sum     = 0.f;
+
+		// the window is shifted back at the far edge so it never reads past the last texel
+		first = std::min(first, src_size - result.tapCount);
+
+		for (const auto& tap : taps) {
+			weights[tap.index - first] += tap.weight;
+			sum                        += tap.weight;
+		}
+
+		for (uint32_t k = 0; k < result.tapCount; ++k)
+			weights[k] /= sum;
+
+		result.first[i] = first;
+	}
+
+	return result;
+}
+
+static void filter_row(const FilterTaps& taps, const float4* src, float4* dst, uint32_t dst_width)
+{
+	const uint32_t tap_count = taps.tapCount;
+
+	for (uint32_t x = 0; x < dst_width; ++x) {
+		const float4* texels  = src + taps.first[x];
+		const float*  weights = &taps.weights[static_cast<size_t>(x) * tap_count];
+
+#ifdef VERA_MIP_IMAGE_X64
+		__m128 sum = _mm_mul_ps(_mm_loadu_ps(reinterpret_cast<const float*>(texels)), _mm_set1_ps(weights[0]));
+
+		for (uint32_t k = 1; k < tap_count; ++k) {
+			__m128 texel = _mm_loadu_ps(reinterpret_cast<const float*>(texels + k));
+			sum = _mm_add_ps(sum, _mm_mul_ps(texel, _mm_set1_ps(weights[k])));
+		}
+
+		_mm_storeu_ps(reinterpret_cast<float*>(dst + x), sum);
+#else
+		float4 sum = texels[0] * weights[0];
+
+		for (uint32_t k = 1; k < tap_count; ++k)
+			sum += texels[k] * weights[k];
+
+		dst[x] = sum;
+#endif
+	}
+}
+
+// dst = src * weight when first is set, dst += src * weight otherwise
+static void accumulate_row(float4* dst, const float4* src, float weight, uint32_t count, bool first)
+{
+#ifdef VERA_MIP_IMAGE_X64
+	const __m128 w = _mm_set1_ps(weight);
+
+	for (uint32_t x = 0; x < count; ++x) {
+		__m128 value = _mm_mul_ps(_mm_loadu_ps(reinterpret_cast<const float*>(src + x)), w);
+
+		if (!first)
+			value = _mm_add_ps(value, _mm_loadu_ps(reinterpret_cast<const float*>(dst + x)));
+
+		_mm_storeu_ps(reinterpret_cast<float*>(dst + x), value);
+	}
+#else
+	for (uint32_t x = 0; x < count; ++x)
+		dst[x] = first ? src[x] * weight : dst[x] + src[x] * weight;
+#endif
+}
+
+static void decode_level_row(const MipContext& ctx, const MipLevelView& level, uint32_t y, float4* out)
+{
+	ctx.codec.decodeRow(level.ptr, level.width, y, ctx.format, out);
+
+	if (ctx.linearize)
+		for (uint32_t x = 0; x < level.width; ++x) {
+			out[x].x = srgb_to_linear(out[x].x);
+			out[x].y = srgb_to_linear(out[x].y);
+			out[x].z = srgb_to_linear(out[x].z);
+		}
+}
+
+static void encode_level_row(const MipContext& ctx, const MipLevelView& level, uint32_t y, float4* in)
+{
+	for (uint32_t x = 0; x < level.width; ++x) {
+		auto& value = in[x];
+
+		value.x = std::clamp(value.x, ctx.minValue, ctx.maxValue);
+		value.y = std::clamp(value.y, ctx.minValue, ctx.maxValue);
+		value.z = std::clamp(value.z, ctx.minValue, ctx.maxValue);
+		value.w = std::clamp(value.w, ctx.minValue, ctx.maxValue);
+
+		if (ctx.linearize) {
+			value.x = linear_to_srgb(value.x);
+			value.y = linear_to_srgb(value.y);
+			value.z = linear_to_srgb(value.z);
+		}
+	}
+
+	ctx.codec.encodeRow(level.ptr, level.width, y, ctx.format, in);
+}
+
+// Rows of the destination are produced in order, the horizontally filtered source rows they
+// read are kept in a ring as consecutive destination rows share most of their taps.
+static void downsample_rows(
+	const MipContext&   ctx,
+	const MipLevelView& src,
+	const MipLevelView& dst,
+	const FilterTaps&   taps_x,
+	const FilterTaps&   taps_y,
+	uint32_t            begin_y,
+	uint32_t            end_y)
+{
+	const uint32_t ring_size = taps_y.tapCount;
+
+	std::vector<float4> source_row(src.width);
+	std::vector<float4> ring(static_cast<size_t>(ring_size) * dst.width);
+	std::vector<float4> result_row(dst.width);
+	uint32_t            next_row = 0;
+
+	for (uint32_t y = begin_y; y < end_y; ++y) {
+		const uint32_t first   = taps_y.first[y];
+		const float*   weights = &taps_y.weights[static_cast<size_t>(y) * ring_size];
+
+		for (next_row = std::max(next_row, first); next_row < first + ring_size; ++next_row) {
+			decode_level_row(ctx, src, next_row, source_row.data());
+			filter_row(taps_x, source_row.data(), &ring[static_cast<size_t>(next_row % ring_size) * dst.width], dst.width);
+		}
+
+		for (uint32_t k = 0; k < ring_size; ++k) {
+			const float4* row = &ring[static_cast<size_t>((first + k) % ring_size) * dst.width];
+			accumulate_row(result_row.data(), row, weights[k], dst.width, k == 0);
+		}
+
+		encode_level_row(ctx, dst, y, result_row.data());
+	}
+}
+
+static void decode_alpha(const MipContext& ctx, const MipLevelView& level, std::vector<float>& alpha)
+{
+	alpha.resize(static_cast<size_t>(level.width) * level.height);
+
+	parallel_for(level.height, std::max(1u, MIP_PIXELS_PER_TASK / level.width),
+		[&](uint32_t begin_y, uint32_t end_y) {
+			std::vector<float4> row(level.width);
+
+			for (uint32_t y = begin_y; y < end_y; ++y) {
+				ctx.codec.decodeRow(level.ptr, level.width, y, ctx.format, row.data());
+
+				for (uint32_t x = 0; x < level.width; ++x)
+					alpha[static_cast<size_t>(y) * level.width + x] = row[x].w;
+			}
+		});
+}
+
+static float compute_alpha_coverage(const std::vector<float>& alpha, float cutoff, float scale)
+{
+	size_t covered = 0;
+
+	for (float value : alpha)
+		covered += cutoff < value * scale;
+
+	return static_cast<float>(covered) / static_cast<float>(alpha.size());
+}
+
+// Alpha tested edges erode as levels get smaller, so the alpha of a level is scaled until the
+// fraction of texels passing the cutoff matches the one of the first level.
+static void preserve_alpha_coverage(
+	const MipContext&   ctx,
+	const MipLevelView& level,
+	std::vector<float>& alpha,
+	float               cutoff,
+	float               coverage)
+{
+	decode_alpha(ctx, level, alpha);
+
+	float min_scale = 0.f;
+	float max_scale = MAX_ALPHA_SCALE;
+	float scale     = 1.f;
+
+	for (uint32_t step = 0; step < ALPHA_SCALE_SEARCH_STEPS; ++step) {
+		float level_coverage = compute_alpha_coverage(alpha, cutoff, scale);
+
+		if (level_coverage < coverage)
+			min_scale = scale;
+		else if (coverage < level_coverage)
+			max_scale = scale;
+		else
+			break;
+
+		scale = (min_scale + max_scale) * 0.5f;
+	}
+
+	if (scale == 1.f)
+		return;
+
+	parallel_for(level.height, std::max(1u, MIP_PIXELS_PER_TASK / level.width),
+		[&](uint32_t begin_y, uint32_t end_y) {
+			std::vector<float4> row(level.width);
+
+			for (uint32_t y = begin_y; y < end_y; ++y) {
+				ctx.codec.decodeRow(level.ptr, level.width, y, ctx.format, row.data());
+
+				for (uint32_t x = 0; x < level.width; ++x)
+					row[x].w = std::min(row[x].w * scale, 1.f);
+
+				ctx.codec.encodeRow(level.ptr, level.width, y, ctx.format, row.data());
+			}
+		});
+}
+
+MipImage MipImage::generate(const Image& image, const MipGenerateInfo& info)
+{
+	MipImage result;
+	generate(result, image, info);
+	return result;
+}
+
+void MipImage::generate(MipImage& result, const Image& image, const MipGenerateInfo& info)
+{
+	const auto format = image.format();
+	const auto width  = image.width();
+	const auto height = image.height();
+
+	if (format_is_depth_stencil(format))
+		throw Exception("cannot generate mipmaps of depth stencil format");
+
+	if (image.empty()) {
+		result.clear();
+		return;
+	}
+
+	const auto max_levels  = getMaxLevelCount(width, height);
+	const auto level_count = info.levelCount ? std::min(info.levelCount, max_levels) : max_levels;
+	const auto srgb_format = info.srgb ? get_srgb_format(format) : Format::Unknown;
+	const bool is_integer  = !format_is_unorm(format) && !format_is_snorm(format) && !format_is_float(format);
+
+	MipImage   chain(width, height, format, level_count);
+	MipContext ctx;
+
+	ctx.format    = srgb_format != Format::Unknown ? srgb_format : format;
+	ctx.codec     = get_mip_codec(ctx.format);
+	ctx.linearize = info.srgb && srgb_format == Format::Unknown && format_is_unorm(format) && !format_is_srgb(format);
+	ctx.minValue  = format_is_unorm(format) ? 0.f : (format_is_snorm(format) ? -1.f : -INFINITY);
+	ctx.maxValue  = format_is_unorm(format) || format_is_snorm(format) ? 1.f : INFINITY;
+
+	// windowed sinc filters ring past the source values, which integer texels cannot represent
+	const auto filter = is_integer ? MipFilter::Box : info.filter;
+
+	memcpy(chain.levelData(0), image.data(), chain.levelSize(0));
+
+	const bool preserve_coverage = 0.f < info.alphaCutoff && format_has_alpha(format);
+
+	std::vector<float> alpha;
+	float              coverage = 0.f;
+
+	if (preserve_coverage) {
+		MipLevelView base = { static_cast<uint8_t*>(chain.levelData(0)), width, height };
+
+		decode_alpha(ctx, base, alpha);
+		coverage = compute_alpha_coverage(alpha, info.alphaCutoff, 1.f);
+	}
+
+	for (uint32_t level = 1; level < level_count; ++level) {
+		MipLevelView src = {
+			static_cast<uint8_t*>(chain.levelData(level - 1)),
+			chain.width(level - 1),
+			chain.height(level - 1)
+		};
+		MipLevelView dst = {
+			static_cast<uint8_t*>(chain.levelData(level)),
+			chain.width(level),
+			chain.height(level)
+		};
+
+		auto taps_x = make_filter_taps(src.width, dst.width, filter);
+		auto taps_y = make_filter_taps(src.height, dst.height, filter);
+
+		parallel_for(dst.height, std::max(1u, MIP_PIXELS_PER_TASK / dst.width),
+			[&](uint32_t begin_y, uint32_t end_y) {
+				downsample_rows(ctx, src, dst, taps_x, taps_y, begin_y, end_y);
+			});
+	}
+
+	// levels are scaled once the chain is built, so each level is filtered from unscaled alpha
+	// and the scales do not compound down the chain
+	if (preserve_coverage) {
+		for (uint32_t level = 1; level < level_count; ++level) {
+			MipLevelView dst = {
+				static_cast<uint8_t*>(chain.levelData(level)),
+				chain.width(level),
+				chain.height(level)
+			};
+
+			preserve_alpha_coverage(ctx, dst, alpha, info.alphaCutoff, coverage);
+		}
+	}
+
+	result.swap(chain);
+}
+
+uint32_t MipImage::getMaxLevelCount(uint32_t width, uint32_t height)
+{
+	return static_cast<uint32_t>(std::bit_width(std::max(width, height)));
+}
+
+MipImage::MipImage() :
+	m_width(0),
+	m_height(0),
+	m_format(Format::Unknown),
+	m_size(0) {}
+
+MipImage::MipImage(uint32_t width, uint32_t height, Format format, uint32_t level_count) :
+	m_width(width),
+	m_height(height),
+	m_format(format),
+	m_size(0)
+{
+	const size_t pixel_size = get_format_size(format);
+	const size_t alignment  = std::lcm<size_t>(pixel_size, 4);
+	const auto   max_levels = getMaxLevelCount(width, height);
+
+	level_count = level_count ? std::min(level_count, max_levels) : max_levels;
+
+	size_t offset = 0;
+
+	m_offsets.reserve(level_count);
+
+	for (uint32_t level = 0; level < level_count; ++level) {
+		offset = (offset + alignment - 1) / alignment * alignment;
+		m_offsets.push_back(offset);
+		offset += static_cast<size_t>(this->width(level)) * this->height(level) * pixel_size;
+	}
+
+	m_storage.reset(new uint8_t[offset]);
+	m_size = offset;
+}
+
+MipImage::MipImage(const MipImage& rhs) :
+	m_width(rhs.m_width),
+	m_height(rhs.m_height),
+	m_format(rhs.m_format),
+	m_offsets(rhs.m_offsets),
+	m_storage(rhs.m_size ? new uint8_t[rhs.m_size] : nullptr),
+	m_size(rhs.m_size)
+{
+	if (m_size)
+		memcpy(m_storage.get(), rhs.m_storage.get(), m_size);
+}
+
+MipImage::MipImage(MipImage&& rhs) noexcept :
+	MipImage()
+{
+	swap(rhs);
+}
+
+MipImage& MipImage::operator=(const MipImage& rhs)
+{
+	if (this != &rhs) {
+		MipImage copy(rhs);
+		swap(copy);
+	}
+
+	return *this;
+}
+
+MipImage& MipImage::operator=(MipImage&& rhs) noexcept
+{
+	swap(rhs);
+	return *this;
+}
+
+void MipImage::clear()
+{
+	m_width  = 0;
+	m_height = 0;
+	m_format = Format::Unknown;
+	m_offsets.clear();
+	m_storage.reset();
+	m_size   = 0;
+}
+
+size_t MipImage::size() const
+{
+	return m_size;
+}
+
+uint32_t MipImage::levelCount() const
+{
+	return static_cast<uint32_t>(m_offsets.size());
+}
+
+uint32_t MipImage::width(uint32_t level) const
+{
+	return std::max(1u, m_width >> level);
+}
+
+uint32_t MipImage::height(uint32_t level) const
+{
+	return std::max(1u, m_height >> level);
+}
+
+Format MipImage::format() const
+{
+	return m_format;
+}
+
+void* MipImage::data()
+{
+	return m_storage.get();
+}
+
+const void* MipImage::data() const
+{
+	return m_storage.get();
+}
+
+size_t MipImage::levelOffset(uint32_t level) const
+{
+	VERA_ASSERT(level < m_offsets.size());
+	return m_offsets[level];
+}
+
+size_t MipImage::levelSize(uint32_t level) const
+{
+	return static_cast<size_t>(width(level)) * height(level) * get_format_size(m_format);
+}
+
+void* MipImage::levelData(uint32_t level)
+{
+	return m_storage.get() + levelOffset(level);
+}
+
+const void* MipImage::levelData(uint32_t level) const
+{
+	return m_storage.get() + levelOffset(level);
+}
+
+Image MipImage::level(uint32_t level) const
+{
+	return Image(width(level), height(level), m_format, levelData(level));
+}
+
+const std::vector<size_t>& MipImage::levelOffsets() const
+{
+	return m_offsets;
+}
+
+bool MipImage::empty() const
+{
+	return m_offsets.empty();
+}
+
+void MipImage::swap(MipImage& rhs) noexcept
+{
+	std::swap(m_width, rhs.m_width);
+	std::swap(m_height, rhs.m_height);
+	std::swap(m_format, rhs.m_format);
+	std::swap(m_size, rhs.m_size);
+	m_offsets.swap(rhs.m_offsets);
+	m_storage.swap(rhs.m_storage);
+}
+
+VERA_NAMESPACE_END
@@ -1,87 +1,353 @@
 #include "../../include/vera/graphics/model_loader.h"
 
 #include "../../include/vera/core/exception.h"
+#include "../../include/vera/util/mapped_file.h"
 #include <filesystem>
-#include <fstream>
-#include <sstream>
-
-#ifndef _MSC_VER
-#define sscanf_s sscanf
-#endif
+#include <exception>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <thread>
 
 VERA_NAMESPACE_BEGIN
 
-static std::string read_str_data(std::string_view path, std::ios_base::openmode mode = {})
+static constexpr size_t  OBJ_MIN_CHUNK_SIZE = VERA_MIB(4);
+static constexpr int32_t OBJ_NO_INDEX       = INT32_MIN;
+
+// indices into the position, uv and normal lists, OBJ_NO_INDEX when the attribute is absent
+struct ObjCorner
 {
-	std::ifstream file(path.data(), mode | std::ios_base::ate);
-	std::string   result;
+	int32_t position;
+	int32_t uv;
+	int32_t normal;
+};
 
-	if (!file.is_open())
-		throw Exception("failed to open model file named " + std::string(path));
+// Slice of the file parsed by one thread. Negative face indices are relative to the attributes
+// defined so far, which a chunk only knows locally, so they are recorded as fixups and rebased
+// once the attribute counts of the preceding chunks are known.
+struct ObjChunk
+{
+	std::string_view       text;
+	std::vector<float3>    positions;
+	std::vector<float2>    uvs;
+	std::vector<float3>    normals;
+	std::vector<ObjCorner> corners;        // three per triangle
+	std::vector<uint32_t>  relativeFixups; // corner * 3 + attribute
+	std::exception_ptr     error;
+};
+
+static const char* skip_spaces(const char* ptr, const char* end)
+{
+	while (ptr < end && (*ptr == ' ' || *ptr == '\t'))
+		++ptr;
+	return ptr;
+}
+
+static bool is_line_end(const char* ptr, const char* end)
+{
+	return ptr == end || *ptr == '#';
+}
+
+static const char* parse_float(const char* ptr, const char* end, float& out)
+{
+	ptr = skip_spaces(ptr, end);
+
+	if (ptr < end && *ptr == '+')
+		++ptr;
+
+	auto [next, ec] = std::from_chars(ptr, end, out);
+	if (ec != std::errc())
+		throw Exception("invalid number in obj file");
+
+	return next;
+}
+
+static const char* parse_optional_float(const char* ptr, const char* end, float& out)
+{
+	ptr = skip_spaces(ptr, end);
+
+	if (is_line_end(ptr, end)) {
+		out = 0.f;
+		return ptr;
+	}
+
+	return parse_float(ptr, end, out);
+}
+
+static const char* parse_index(const char* ptr, const char* end, size_t local_count, int32_t& out, bool& relative)
+{
+	int32_t value;
+
+	auto [next, ec] = std::from_chars(ptr, end, value);
+	if (ec != std::errc() || value == 0)
+		throw Exception("invalid face index in obj file");
+
+	if (value > 0) {
+		out      = value - 1;
+		relative = false;
+	} else {
+		out      = static_cast<int32_t>(local_count) + value;
+		relative = true;
+	}
+
+	return next;
+}
+
+static void parse_obj_face(ObjChunk& chunk, const char* ptr, const char* end, std::vector<ObjCorner>& polygon, std::vector<uint8_t>& polygon_relative)
+{
+	polygon.clear();
+	polygon_relative.clear();
+
+	while (true) {
+		ptr = skip_spaces(ptr, end);
+		if (is_line_end(ptr, end)) break;
+
+		ObjCorner corner   = { OBJ_NO_INDEX, OBJ_NO_INDEX, OBJ_NO_INDEX };
+		uint8_t   relative = 0;
+		bool      is_rel;
+
+		ptr = parse_index(ptr, end, chunk.positions.size(), corner.position, is_rel);
+		relative |= is_rel ? 0b001 : 0;
+
+		if (ptr < end && *ptr == '/') {
+			if (++ptr < end && *ptr != '/') {
+				ptr = parse_index(ptr, end, chunk.uvs.size(), corner.uv, is_rel);
+				relative |= is_rel ? 0b010 : 0;
+			}
+
+			if (ptr < end && *ptr == '/') {
+				ptr = parse_index(ptr + 1, end, chunk.normals.size(), corner.normal, is_rel);
+				relative |= is_rel ? 0b100 : 0;
+			}
+		}
+
+		polygon.push_back(corner);
+		polygon_relative.push_back(relative);
+	}
+
+	if (polygon.size() < 3)
+		throw Exception("obj face has less than three vertices");
+
+	auto push_corner = [&](size_t i) {
+		auto corner_idx = static_cast<uint32_t>(chunk.corners.size());
+
+		for (uint32_t attr = 0; attr < 3; ++attr)
+			if (polygon_relative[i] & (1 << attr))
+				chunk.relativeFixups.push_back(corner_idx * 3 + attr);
+
+		chunk.corners.push_back(polygon[i]);
+	};
+
+	// quads and n-gons are fanned around their first corner
+	for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+		push_corner(0);
+		push_corner(i);
+		push_corner(i + 1);
+	}
+}
+
+static void parse_obj_chunk(ObjChunk& chunk)
+{
+	std::vector<ObjCorner> polygon;
+	std::vector<uint8_t>   polygon_relative;
+
+	const char* ptr = chunk.text.data();
+	const char* end = ptr + chunk.text.size();
+
+	while (ptr < end) {
+		const char* line_end = static_cast<const char*>(memchr(ptr, '\n', end - ptr));
+		const char* next     = line_end ? line_end + 1 : end;
+
+		if (!line_end)
+			line_end = end;
+		if (line_end > ptr && line_end[-1] == '\r')
+			--line_end;
+
+		ptr = skip_spaces(ptr, line_end);
+
+		if (line_end - ptr >= 2) {
+			if (ptr[0] == 'v' && (ptr[1] == ' ' || ptr[1] == '\t')) {
+				float x, y, z;
+				ptr = parse_float(ptr + 1, line_end, x);
+				ptr = parse_float(ptr, line_end, y);
+				ptr = parse_float(ptr, line_end, z);
+				chunk.positions.emplace_back(x, z, y);
+			} else if (ptr[0] == 'v' && ptr[1] == 't') {
+				float u, v;
+				ptr = parse_float(ptr + 2, line_end, u);
+				ptr = parse_optional_float(ptr, line_end, v);
+				chunk.uvs.emplace_back(u, 1.f - v);
+			} else if (ptr[0] == 'v' && ptr[1] == 'n') {
+				float x, y, z;
+				ptr = parse_float(ptr + 2, line_end, x);
+				ptr = parse_float(ptr, line_end, y);
+				ptr = parse_float(ptr, line_end, z);
+				chunk.normals.emplace_back(x, z, y);
+			} else if (ptr[0] == 'f' && (ptr[1] == ' ' || ptr[1] == '\t')) {
+				parse_obj_face(chunk, ptr + 1, line_end, polygon, polygon_relative);
+			}
+		}
+
+		ptr = next;
+	}
+}
+
+static std::vector<ObjChunk> split_obj_chunks(std::string_view text)
+{
+	size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+	size_t chunk_count  = std::clamp<size_t>(text.size() / OBJ_MIN_CHUNK_SIZE, 1, thread_count);
+
+	std::vector<ObjChunk> chunks(chunk_count);
+
+	size_t first = 0;
+	for (size_t i = 0; i < chunk_count; ++i) {
+		size_t last = text.size() * (i + 1) / chunk_count;
+
+		// chunks always end on a line break so no line is split between two threads
+		if (last < text.size()) {
+			last = text.find('\n', std::max(last, first));
+			last = last == std::string_view::npos ? text.size() : last + 1;
+		}
+
+		chunks[i].text = text.substr(first, last - first);
+		first          = last;
+	}
+
+	return chunks;
+}
+
+static void parse_obj_chunks(std::vector<ObjChunk>& chunks)
+{
+	std::vector<std::thread> workers;
+	workers.reserve(chunks.size() - 1);
+
+	auto parse = [](ObjChunk& chunk) {
+		try {
+			parse_obj_chunk(chunk);
+		} catch (...) {
+			chunk.error = std::current_exception();
+		}
+	};
 
-	result.resize(file.tellg());
-	file.seekg(0, std::ios_base::beg);
+	for (size_t i = 1; i < chunks.size(); ++i)
+		workers.emplace_back(parse, std::ref(chunks[i]));
 
-	file.read(result.data(), result.size());
+	parse(chunks.front());
 
-	return result;
+	for (auto& worker : workers)
+		worker.join();
+
+	for (auto& chunk : chunks)
+		if (chunk.error)
+			std::rethrow_exception(chunk.error);
 }
 
 static void load_obj(
-	std::string_view     path,
-	std::vector<float3>& out_vertices,
-	std::vector<float3>& out_normals,
-	std::vector<float2>& out_uvs
+	std::string_view       path,
+	std::vector<float3>&   out_vertices,
+	std::vector<float3>&   out_normals,
+	std::vector<float2>&   out_uvs,
+	std::vector<uint32_t>& out_indices
 ) {
-	std::ifstream file(path.data());
+	MappedFile file;
 
-	if (!file.is_open())
+	try {
+		file.open(path);
+	} catch (const Exception&) {
 		throw Exception("failed to open model file named " + std::string(path));
+	}
 
-	std::vector<float3> vertices;
-	std::vector<float3> normals;
+	auto chunks = split_obj_chunks(file.text());
+	parse_obj_chunks(chunks);
+
+	std::vector<float3> positions;
 	std::vector<float2> uvs;
+	std::vector<float3> normals;
+	size_t              corner_count = 0;
+
+	for (const auto& chunk : chunks) {
+		positions.insert(positions.end(), VERA_SPAN(chunk.positions));
+		uvs.insert(uvs.end(), VERA_SPAN(chunk.uvs));
+		normals.insert(normals.end(), VERA_SPAN(chunk.normals));
+		corner_count += chunk.corners.size();
+	}
+
+	if (positions.size() > INT32_MAX || uvs.size() > INT32_MAX || normals.size() > INT32_MAX)
+		throw Exception("obj file has too many attributes");
+
+	auto base_vertex = static_cast<uint32_t>(out_vertices.size());
+	bool has_uvs     = !uvs.empty() || !out_uvs.empty();
+	bool has_normals = !normals.empty() || !out_normals.empty();
+
+	// attribute streams are either empty or as long as the vertex stream
+	if (has_uvs) out_uvs.resize(base_vertex);
+	if (has_normals) out_normals.resize(base_vertex);
+
+	out_indices.reserve(out_indices.size() + corner_count);
+
+	// Identical position/uv/normal tuples are welded into one vertex. Tuples sharing a position are
+	// chained from a head slot indexed by the position, so the position index itself is the hash
+	// and a lookup only compares against the few uv/normal variants of that position.
+	struct WeldNode
+	{
+		int32_t  uv;
+		int32_t  normal;
+		uint32_t next;
+	};
 
-	std::string line;
-	std::string line_header;
-	while (std::getline(file, line)) {
-		std::istringstream ss(line);
-		ss >> line_header;
-
-		if (line_header == "v") {
-			auto& v = vertices.emplace_back();
-			ss >> v.x >> v.z >> v.y;
-		} else if (line_header == "vt") {
-			auto& uv = uvs.emplace_back();
-			ss >> uv.x >> uv.y;
-			uv.y = 1.f - uv.y;
-		} else if (line_header == "vn") {
-			auto& n = normals.emplace_back();
-			ss >> n.x >> n.z >> n.y;
-		} else if (line_header == "f") {
-			int v0_idx, v1_idx, v2_idx;
-			int n0_idx, n1_idx, n2_idx;
-			int uv0_idx, uv1_idx, uv2_idx;
-
-			if (sscanf_s(line.c_str(),
-				"f %d/%d/%d %d/%d/%d %d/%d/%d", 
-					&v0_idx, &uv0_idx, &n0_idx,
-					&v1_idx, &uv1_idx, &n1_idx,
-					&v2_idx, &uv2_idx, &n2_idx) != 9) 
-				throw Exception("invalid file format");
-
-			out_vertices.push_back(vertices[v0_idx - 1]);
-			out_vertices.push_back(vertices[v1_idx - 1]);
-			out_vertices.push_back(vertices[v2_idx - 1]);
-			out_normals.push_back(normals[n0_idx - 1]);
-			out_normals.push_back(normals[n1_idx - 1]);
-			out_normals.push_back(normals[n2_idx - 1]);
-			out_uvs.push_back(uvs[uv0_idx - 1]);
-			out_uvs.push_back(uvs[uv1_idx - 1]);
-			out_uvs.push_back(uvs[uv2_idx - 1]);
-		} else {
-			continue;
+	std::vector<uint32_t> heads(positions.size(), UINT32_MAX);
+	std::vector<WeldNode> nodes;
+
+	static constexpr int32_t ObjCorner::* corner_attrs[3] = {
+		&ObjCorner::position,
+		&ObjCorner::uv,
+		&ObjCorner::normal
+	};
+
+	int32_t attr_bases[3] = {};
+
+	for (auto& chunk : chunks) {
+		for (uint32_t fixup : chunk.relativeFixups)
+			chunk.corners[fixup / 3].*corner_attrs[fixup % 3] += attr_bases[fixup % 3];
+
+		for (const auto& corner : chunk.corners) {
+			if (corner.position < 0 || positions.size() <= static_cast<size_t>(corner.position))
+				throw Exception("obj face references an undefined vertex position");
+			if (corner.uv != OBJ_NO_INDEX && (corner.uv < 0 || uvs.size() <= static_cast<size_t>(corner.uv)))
+				throw Exception("obj face references an undefined texture coordinate");
+			if (corner.normal != OBJ_NO_INDEX && (corner.normal < 0 || normals.size() <= static_cast<size_t>(corner.normal)))
+				throw Exception("obj face references an undefined normal");
+
+			uint32_t vertex = heads[corner.position];
+
+			while (vertex != UINT32_MAX) {
+				const auto& node = nodes[vertex];
+				if (node.uv == corner.uv && node.normal == corner.normal) break;
+				vertex = node.next;
+			}
+
+			if (vertex == UINT32_MAX) {
+				vertex = static_cast<uint32_t>(nodes.size());
+
+				nodes.push_back({ corner.uv, corner.normal, heads[corner.position] });
+				heads[corner.position] = vertex;
+
+				out_vertices.push_back(positions[corner.position]);
+				if (has_uvs)
+					out_uvs.push_back(corner.uv != OBJ_NO_INDEX ? uvs[corner.uv] : float2{});
+				if (has_normals)
+					out_normals.push_back(corner.normal != OBJ_NO_INDEX ? normals[corner.normal] : float3{});
+			}
+
+			out_indices.push_back(base_vertex + vertex);
 		}
+
+		attr_bases[0] += static_cast<int32_t>(chunk.positions.size());
+		attr_bases[1] += static_cast<int32_t>(chunk.uvs.size());
+		attr_bases[2] += static_cast<int32_t>(chunk.normals.size());
+
+		// release every chunk as soon as it is welded, large scans would otherwise hold all corners twice
+		chunk = {};
 	}
 }
 
@@ -104,7 +370,8 @@ void ModelLoader::load(std::string_view path)
 			path,
 			vertices,
 			normals,
-			uvs);
+			uvs,
+			indices);
 	} else {
 		throw Exception("unsupported file extension " + std::string(ext.generic_string()));
 	}
@@ -115,11 +382,12 @@ void ModelLoader::clear()
 	vertices.clear();
 	normals.clear();
 	uvs.clear();
+	indices.clear();
 }
 
 bool ModelLoader::empty() const
 {
-	return vertices.empty() && normals.empty() && uvs.empty();
+	return vertices.empty() && normals.empty() && uvs.empty() && indices.empty();
 }
 
-VERA_NAMESPACE_END
\ No newline at end of file
+VERA_NAMESPACE_END
@@ -2,6 +2,9 @@
 
 #include "../../include/vera/core/assertion.h"
 #include "../../include/vera/math/vector_types.h"
+#include <array>
+#include <bit>
+#include <cmath>
 
 #define NOALPHA 1.f
 
@@ -12,6 +15,8 @@
 #define UINT2F(x) static_cast<float>(x)
 #define SINT2F(x) static_cast<float>(x)
 #define DOUBLE2F(x) static_cast<float>(x)
+#define SRGB2F(x) srgb8_to_linear(x)
+#define HALF2F(x) half_to_float(x)
 
 #define F2UNORM(type, x) (static_cast<type>((x) * (max_value_v<type> + 0.99f)))
 #define F2SNORM(type, x) (static_cast<type>((x) * (0.f < (x) ? (max_value_v<type> + 0.99f) : (min_value_v<type> + 0.99f))))
@@ -20,6 +25,8 @@
 #define F2UINT(type, x) static_cast<type>(x)
 #define F2SINT(type, x) static_cast<type>(x)
 #define F2DOUBLE(x) static_cast<double>(x)
+#define F2SRGB(x) linear_to_srgb8(x)
+#define F2HALF(x) float_to_half(x)
 
 #define SINT10(x) static_cast<int16_t>(((x) ^ 0x0200) - 0x0200)
 
@@ -43,6 +50,112 @@ template <> static constexpr float max_value_v<int32_t>  = 2147483647.f;
 template <> static constexpr float max_value_v<uint64_t> = 18446744073709551615.f;
 template <> static constexpr float max_value_v<int64_t>  = 9223372036854775807.f;
 
+static float srgb_to_linear(float c)
+{
+	return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static float linear_to_srgb(float c)
+{
+	return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.f / 2.4f) - 0.055f;
+}
+
+static std::array<float, 256> make_srgb8_decode_table()
+{
+	std::array<float, 256> result;
+	for (uint32_t i = 0; i < 256; ++i)
+		result[i] = srgb_to_linear(i / 255.f);
+	return result;
+}
+
+static constexpr uint32_t SRGB8_ENCODE_BUCKETS = 4096;
+
+// linear value where each encoded step begins, rounding like F2UNORM(uint8_t, linear_to_srgb(c)),
+// the last entry stops the search past 255
+static std::array<float, 257> make_srgb8_encode_table()
+{
+	std::array<float, 257> result;
+	result[0]   = 0.f;
+	result[256] = INFINITY;
+	for (uint32_t i = 1; i < 256; ++i)
+		result[i] = srgb_to_linear(i / (max_value_v<uint8_t> + 0.99f));
+	return result;
+}
+
+// first guess of the encoded value for each bucket of the linear range, taken half a bucket
+// early so at most two steps are left to the exact value
+static std::array<uint8_t, SRGB8_ENCODE_BUCKETS> make_srgb8_bucket_table(const std::array<float, 257>& steps)
+{
+	std::array<uint8_t, SRGB8_ENCODE_BUCKETS> result;
+	for (uint32_t i = 0; i < SRGB8_ENCODE_BUCKETS; ++i) {
+		float    start = (i - 0.5f) / (SRGB8_ENCODE_BUCKETS - 1);
+		uint32_t value = 0;
+		while (steps[value + 1] < start)
+			++value;
+		result[i] = static_cast<uint8_t>(value);
+	}
+	return result;
+}
+
+// srgb formats are 8 bit per channel, so both directions go through a table instead of pow
+static const std::array<float, 256>                   srgb8_decode_table = make_srgb8_decode_table();
+static const std::array<float, 257>                   srgb8_encode_table = make_srgb8_encode_table();
+static const std::array<uint8_t, SRGB8_ENCODE_BUCKETS> srgb8_bucket_table = make_srgb8_bucket_table(srgb8_encode_table);
+
+static VERA_FORCEINLINE float srgb8_to_linear(uint8_t c)
+{
+	return srgb8_decode_table[c];
+}
+
+static VERA_FORCEINLINE uint8_t linear_to_srgb8(float c)
+{
+	c = 0.f < c ? std::min(c, 1.f) : 0.f;
+
+	uint32_t i = srgb8_bucket_table[static_cast<uint32_t>(c * (SRGB8_ENCODE_BUCKETS - 1))];
+
+	i += srgb8_encode_table[i + 1] <= c;
+	i += srgb8_encode_table[i + 1] <= c;
+
+	return static_cast<uint8_t>(i);
+}
+
+static VERA_FORCEINLINE float half_to_float(uint16_t h)
+{
+	constexpr uint32_t shifted_exponent = 0x7c00 << 13;
+
+	uint32_t bits     = static_cast<uint32_t>(h & 0x7fff) << 13;
+	uint32_t exponent = bits & shifted_exponent;
+
+	bits += (127 - 15) << 23;
+
+	if (exponent == shifted_exponent) {
+		bits += (128 - 16) << 23; // inf and nan
+	} else if (exponent == 0) {
+		bits += 1 << 23;          // denormals are renormalized by the float unit
+		bits  = std::bit_cast<uint32_t>(std::bit_cast<float>(bits) - std::bit_cast<float>(113u << 23));
+	}
+
+	return std::bit_cast<float>(bits | static_cast<uint32_t>(h & 0x8000) << 16);
+}
+
+// rounds to nearest even, overflow saturates to infinity and nan stays nan
+static VERA_FORCEINLINE uint16_t float_to_half(float f)
+{
+	uint32_t bits = std::bit_cast<uint32_t>(f);
+	uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+	uint32_t abs  = bits & 0x7fffffff;
+
+	if (abs >= 0x7f800000)
+		return sign | (abs > 0x7f800000 ? 0x7e00 : 0x7c00);
+	if (abs >= 0x477ff000)
+		return sign | 0x7c00;
+	if (abs < 0x38800000)
+		return sign | static_cast<uint16_t>(std::nearbyint(std::bit_cast<float>(abs) * 16777216.f));
+
+	abs += 0xc8000fff + ((abs >> 13) & 1);
+	return sign | static_cast<uint16_t>(abs >> 13);
+}
+
 template <class T>
 static const T& fetch_pixel(const void* ptr, uint32_t i)
 {
@@ -94,9 +207,10 @@ static float4 fetch_components(const void* ptr, uint32_t width, uint32_t x, uint
 		auto pixel = fetch_pixel<int8_t>(ptr, width, x, y);
 		return { SINT2F(pixel), 0.f, 0.f, NOALPHA };
 	}
-	//case Format::R8Srgb: {
-	// 
-	//}
+	case Format::R8Srgb: {
+		auto pixel = fetch_pixel<uint8_t>(ptr, width, x, y);
+		return { SRGB2F(pixel), 0.f, 0.f, NOALPHA };
+	}
 	case Format::R16Unorm: {
 		auto pixel = fetch_pixel<uint16_t>(ptr, width, x, y);
 		return { UNORM2F(pixel), 0.f, 0.f, NOALPHA};
@@ -121,9 +235,10 @@ static float4 fetch_components(const void* ptr, uint32_t width, uint32_t x, uint
 		auto pixel = fetch_pixel<int16_t>(ptr, width, x, y);
 		return { SINT2F(pixel), 0.f, 0.f, NOALPHA };
 	}
-	//case Format::R16Float: {
-	//
-	//}
+	case Format::R16Float: {
+		auto pixel = fetch_pixel<uint16_t>(ptr, width, x, y);
+		return { HALF2F(pixel), 0.f, 0.f, NOALPHA };
+	}
 	case Format::R32Uint: {
 		auto pixel = fetch_pixel<uint32_t>(ptr, width, x, y);
 		return { UINT2F(pixel), 0.f, 0.f, NOALPHA };
@@ -172,9 +287,10 @@ static float4 fetch_components(const void* ptr, uint32_t width, uint32_t x, uint
 		auto pixel = fetch_pixel<char2>(ptr, width, x, y);
 		return { SINT2F(pixel.x), SINT2F(pixel.y), 0.f, NOALPHA };
 	}
-	//case Format::RG8Srgb: {
-	//
-	//}
+	case Format::RG8Srgb: {
+		auto pixel = fetch_pixel<uchar2>(ptr, width, x, y);
+		return { SRGB2F(pixel.x), SRGB2F(pixel.y), 0.f, NOALPHA };
+	}
 	case Format::RG16Unorm: {
 		auto pixel = fetch_pixel<ushort2>(ptr, width, x, y);
 		return { UNORM2F(pixel.x), UNORM2F(pixel.y), 0.f, NOALPHA };
@@ -199,9 +315,10 @@ static float4 fetch_components(const void* ptr, uint32_t width, uint32_t x, uint
 		auto pixel = fetch_pixel<short2>(ptr, width, x, y);
 		return { SINT2F(pixel.x), SINT2F(pixel.y), 0.f, NOALPHA };
 	}
-	//case Format::RG16Float: {
-	//
-	//}
+	case Format::RG16Float: {
+		auto pixel = fetch_pixel<ushort2>(ptr, width, x, y);
+		return { HALF2F(pixel.x), HALF2F(pixel.y), 0.f, NOALPHA };
+	}
 	case Format::RG32Uint: {
 		auto pixel = fetch_pixel<uint2>(ptr, width, x, y);
 		return { UINT2F(pixel.x), UINT2F(pixel.y), 0.f, NOALPHA };
@@ -250,9 +367,10 @@ static float4 fetch_components(const void* ptr, uint32_t width, uint32_t x, uint
 		auto pixel = fetch_pixel<char3>(ptr, width, x, y);
 		return { SINT2F(pixel.x), SINT2F(pixel.y), SINT2F(pixel.z), NOALPHA };
 	}
-	//case Format::RGB8Srgb: {
-	//
-	//}
+	case Format::RGB8Srgb: {
+		auto pixel = fetch_pixel<uchar3>(ptr, width, x, y);
+		return { SRGB2F(pixel.x), SRGB2F(pixel.y), SRGB2F(pixel.z), NOALPHA };
+	}
 	case Format::BGR8Unorm: {
 		auto pixel = fetch_pixel<uchar3>(ptr, width, x, y);
 		return { UNORM2F(pixel.z), UNORM2F(pixel.y), UNORM2F(pixel.x), NOALPHA };
@@ -277,9 +395,10 @@ static float4 fetch_components(const void* ptr, uint32_t width, uint32_t x, uint
 		auto pixel = fetch_pixel<char3>(ptr, width, x, y);
 		return { SINT2F(pixel.z), SINT2F(pixel.y), SINT2F(pixel.x), NOALPHA };
 	}
-	//case Format::BGR8Srgb: {
-	//
-	//}
+	case Format::BGR8Srgb: {
+		auto pixel = fetch_pixel<uchar3>(ptr, width, x, y);
+		return { SRGB2F(pixel.z), SRGB2F(pixel.y), SRGB2F(pixel.x), NOALPHA };
+	}
 	case Format::RGB16Unorm: {
 		auto pixel = fetch_pixel<ushort3>(ptr, width, x, y);
 		return { UNORM2F(pixel.x), UNORM2F(pixel.y), UNORM2F(pixel.z), NOALPHA };
@@ -304,9 +423,10 @@ static float4 fetch_components(const void* ptr, uint32_t width, uint32_t x, uint
 		auto pixel = fetch_pixel<short3>(ptr, width, x, y);
 		return { SINT2F(pixel.x), SINT2F(pixel.y), SINT2F(pixel.z), NOALPHA };
 	}
-	//case Format::RGB16Float: {
-	//
-	//}
+	case Format::RGB16Float: {
+		auto pixel = fetch_pixel<ushort3>(ptr, width, x, y);
+		return { HALF2F(pixel.x), HALF2F(pixel.y), HALF2F(pixel.z), NOALPHA };
+	}
 	case Format::RGB32Uint: {
 		auto pixel = fetch_pixel<uint3>(ptr, width, x, y);
 		return { UINT2F(pixel.x), UINT2F(pixel.y), UINT2F(pixel.z), NOALPHA };
@@ -355,9 +475,10 @@ static float4 fetch_components(const void* ptr, uint32_t width, uint32_t x, uint
 		auto pixel = fetch_pixel<char4>(ptr, width, x, y);
 		return { SINT2F(pixel.x), SINT2F(pixel.y), SINT2F(pixel.z), SINT2F(pixel.w) };
 	}
-	//case Format::RGBA8Srgb: {
-	//
-	//}
+	case Format::RGBA8Srgb: {
+		auto pixel = fetch_pixel<uchar4>(ptr, width, x, y);
+		return { SRGB2F(pixel.x), SRGB2F(pixel.y), SRGB2F(pixel.z), UNORM2F(pixel.w) };
+	}
 	case Format::BGRA8Unorm: {
 		auto pixel = fetch_pixel<uchar4>(ptr, width, x, y);
 		return { UNORM2F(pixel.z), UNORM2F(pixel.y), UNORM2F(pixel.x), UNORM2F(pixel.w) };
@@ -382,9 +503,10 @@ static float4 fetch_components(const void* ptr, uint32_t width, uint32_t x, uint
 		auto pixel = fetch_pixel<char4>(ptr, width, x, y);
 		return { SINT2F(pixel.z), SINT2F(pixel.y), SINT2F(pixel.x), SINT2F(pixel.w) };
 	}
-	//case Format::BGRA8Srgb: {
-	//
-	//}
+	case Format::BGRA8Srgb: {
+		auto pixel = fetch_pixel<uchar4>(ptr, width, x, y);
+		return { SRGB2F(pixel.z), SRGB2F(pixel.y), SRGB2F(pixel.x), UNORM2F(pixel.w) };
+	}
 	case Format::RGBA16Unorm: {
 		auto pixel = fetch_pixel<ushort4>(ptr, width, x, y);
 		return { UNORM2F(pixel.x), UNORM2F(pixel.y), UNORM2F(pixel.z), UNORM2F(pixel.w) };
@@ -409,9 +531,10 @@ static float4 fetch_components(const void* ptr, uint32_t width, uint32_t x, uint
 		auto pixel = fetch_pixel<short4>(ptr, width, x, y);
 		return { SINT2F(pixel.x), SINT2F(pixel.y), SINT2F(pixel.z), SINT2F(pixel.w) };
 	}
-	//case Format::RGBA16Float: {
-	//
-	//}
+	case Format::RGBA16Float: {
+		auto pixel = fetch_pixel<ushort4>(ptr, width, x, y);
+		return { HALF2F(pixel.x), HALF2F(pixel.y), HALF2F(pixel.z), HALF2F(pixel.w) };
+	}
 	case Format::RGBA32Uint: {
 		auto pixel = fetch_pixel<uint4>(ptr, width, x, y);
 		return { UINT2F(pixel.x), UINT2F(pixel.y), UINT2F(pixel.z), UINT2F(pixel.w) };
@@ -589,9 +712,15 @@ static float4 fetch_components(const void* ptr, uint32_t width, uint32_t x, uint
 			SINT2F(static_cast<int8_t>(pixel & 0xff000000 >> 24))
 		};
 	}
-	//case Format::ABGR8SrgbPack32: {
-	//
-	//}
+	case Format::ABGR8SrgbPack32: {
+		auto pixel = fetch_pixel<uint32_t>(ptr, width, x, y);
+		return {
+			SRGB2F(static_cast<uint8_t>(pixel >> 0)),
+			SRGB2F(static_cast<uint8_t>(pixel >> 8)),
+			SRGB2F(static_cast<uint8_t>(pixel >> 16)),
+			UNORM2F(static_cast<uint8_t>(pixel >> 24))
+		};
+	}
 	case Format::A2RGB10UnormPack32: {
 		auto pixel = fetch_pixel<uint32_t>(ptr, width, x, y);
 		return {
@@ -731,9 +860,9 @@ static void store_components(void* ptr, uint32_t width, uint32_t x, uint32_t y,
 	case Format::R8Sint: {
 		fetch_pixel<int8_t>(ptr, width, x, y) = F2SINT(int8_t, value.x);
 	} return;
-	//case Format::R8Srgb: {
-	// 
-	//} return;
+	case Format::R8Srgb: {
+		fetch_pixel<uint8_t>(ptr, width, x, y) = F2SRGB(value.x);
+	} return;
 	case Format::R16Unorm: {
 		fetch_pixel<uint16_t>(ptr, width, x, y) = F2UNORM(uint16_t, value.x);
 	} return;
@@ -752,9 +881,9 @@ static void store_components(void* ptr, uint32_t width, uint32_t x, uint32_t y,
 	case Format::R16Sint: {
 		fetch_pixel<int16_t>(ptr, width, x, y) = F2SINT(int16_t, value.x);
 	} return;
-	//case Format::R16Float: {
-	//
-	//} return;
+	case Format::R16Float: {
+		fetch_pixel<uint16_t>(ptr, width, x, y) = F2HALF(value.x);
+	} return;
 	case Format::R32Uint: {
 		fetch_pixel<uint32_t>(ptr, width, x, y) = F2UINT(uint32_t, value.x);
 	} return;
@@ -803,9 +932,11 @@ static void store_components(void* ptr, uint32_t width, uint32_t x, uint32_t y,
 		pixel.x = F2SINT(int8_t, value.x);
 		pixel.y = F2SINT(int8_t, value.y);
 	} return;
-	//case Format::RG8Srgb: {
-	//
-	//} return;
+	case Format::RG8Srgb: {
+		auto& pixel = fetch_pixel<uchar2>(ptr, width, x, y);
+		pixel.x = F2SRGB(value.x);
+		pixel.y = F2SRGB(value.y);
+	} return;
 	case Format::RG16Unorm: {
 		auto& pixel = fetch_pixel<ushort2>(ptr, width, x, y);
 		pixel.x = F2UNORM(uint16_t, value.x);
@@ -836,9 +967,11 @@ static void store_components(void* ptr, uint32_t width, uint32_t x, uint32_t y,
 		pixel.x = F2SINT(int16_t, value.x);
 		pixel.y = F2SINT(int16_t, value.y);
 	} return;
-	//case Format::RG16Float: {
-	//
-	//} return;
+	case Format::RG16Float: {
+		auto& pixel = fetch_pixel<ushort2>(ptr, width, x, y);
+		pixel.x = F2HALF(value.x);
+		pixel.y = F2HALF(value.y);
+	} return;
 	case Format::RG32Uint: {
 		auto& pixel = fetch_pixel<uint2>(ptr, width, x, y);
 		pixel.x = F2UINT(uint32_t, value.x);
@@ -905,9 +1038,12 @@ static void store_components(void* ptr, uint32_t width, uint32_t x, uint32_t y,
 		pixel.y = F2SINT(int8_t, value.y);
 		pixel.z = F2SINT(int8_t, value.z);
 	} return;
-	//case Format::RGB8Srgb: {
-	//
-	//} return;
+	case Format::RGB8Srgb: {
+		auto& pixel = fetch_pixel<uchar3>(ptr, width, x, y);
+		pixel.x = F2SRGB(value.x);
+		pixel.y = F2SRGB(value.y);
+		pixel.z = F2SRGB(value.z);
+	} return;
 	case Format::BGR8Unorm: {
 		auto& pixel = fetch_pixel<uchar3>(ptr, width, x, y);
 		pixel.x = F2UNORM(uint8_t, value.z);
@@ -944,9 +1080,12 @@ static void store_components(void* ptr, uint32_t width, uint32_t x, uint32_t y,
 		pixel.y = F2SINT(int8_t, value.y);
 		pixel.z = F2SINT(int8_t, value.x);
 	} return;
-	//case Format::BGR8Srgb: {
-	//
-	//} return;
+	case Format::BGR8Srgb: {
+		auto& pixel = fetch_pixel<uchar3>(ptr, width, x, y);
+		pixel.x = F2SRGB(value.z);
+		pixel.y = F2SRGB(value.y);
+		pixel.z = F2SRGB(value.x);
+	} return;
 	case Format::RGB16Unorm: {
 		auto& pixel = fetch_pixel<ushort3>(ptr, width, x, y);
 		pixel.x = F2UNORM(uint16_t, value.x);
@@ -983,9 +1122,12 @@ static void store_components(void* ptr, uint32_t width, uint32_t x, uint32_t y,
 		pixel.y = F2SINT(int16_t, value.y);
 		pixel.z = F2SINT(int16_t, value.z);
 	} return;
-	//case Format::RGB16Float: {
-	//
-	//} return;
+	case Format::RGB16Float: {
+		auto& pixel = fetch_pixel<ushort3>(ptr, width, x, y);
+		pixel.x = F2HALF(value.x);
+		pixel.y = F2HALF(value.y);
+		pixel.z = F2HALF(value.z);
+	} return;
 	case Format::RGB32Uint: {
 		auto& pixel = fetch_pixel<uint3>(ptr, width, x, y);
 		pixel.x = F2UINT(uint32_t, value.x);
@@ -1064,9 +1206,13 @@ static void store_components(void* ptr, uint32_t width, uint32_t x, uint32_t y,
 		pixel.z = F2SINT(int8_t, value.z);
 		pixel.w = F2SINT(int8_t, value.w);
 	} return;
-	//case Format::RGBA8Srgb: {
-	//
-	//} return;
+	case Format::RGBA8Srgb: {
+		auto& pixel = fetch_pixel<uchar4>(ptr, width, x, y);
+		pixel.x = F2SRGB(value.x);
+		pixel.y = F2SRGB(value.y);
+		pixel.z = F2SRGB(value.z);
+		pixel.w = F2UNORM(uint8_t, value.w);
+	} return;
 	case Format::BGRA8Unorm: {
 		auto& pixel = fetch_pixel<uchar4>(ptr, width, x, y);
 		pixel.x = F2UNORM(uint8_t, value.z);
@@ -1109,9 +1255,13 @@ static void store_components(void* ptr, uint32_t width, uint32_t x, uint32_t y,
 		pixel.z = F2SINT(int8_t, value.x);
 		pixel.w = F2SINT(int8_t, value.w);
 	} return;
-	//case Format::BGRA8Srgb: {
-	//
-	//} return;
+	case Format::BGRA8Srgb: {
+		auto& pixel = fetch_pixel<uchar4>(ptr, width, x, y);
+		pixel.x = F2SRGB(value.z);
+		pixel.y = F2SRGB(value.y);
+		pixel.z = F2SRGB(value.x);
+		pixel.w = F2UNORM(uint8_t, value.w);
+	} return;
 	case Format::RGBA16Unorm: {
 		auto& pixel = fetch_pixel<ushort4>(ptr, width, x, y);
 		pixel.x = F2UNORM(uint16_t, value.x);
@@ -1154,9 +1304,13 @@ static void store_components(void* ptr, uint32_t width, uint32_t x, uint32_t y,
 		pixel.z = F2SINT(int16_t, value.z);
 		pixel.w = F2SINT(int16_t, value.w);
 	} return;
-	//case Format::RGBA16Float: {
-	//
-	//} return;
+	case Format::RGBA16Float: {
+		auto& pixel = fetch_pixel<ushort4>(ptr, width, x, y);
+		pixel.x = F2HALF(value.x);
+		pixel.y = F2HALF(value.y);
+		pixel.z = F2HALF(value.z);
+		pixel.w = F2HALF(value.w);
+	} return;
 	case Format::RGBA32Uint: {
 		auto& pixel = fetch_pixel<uint4>(ptr, width, x, y);
 		pixel.x = F2UINT(uint32_t, value.x);
@@ -1314,9 +1468,13 @@ static void store_components(void* ptr, uint32_t width, uint32_t x, uint32_t y,
 			(static_cast<int32_t>(value.z) & 0xff) << 16 |
 			(static_cast<int32_t>(value.w) & 0xff) << 24;
 	} return;
-	//case Format::ABGR8SrgbPack32: {
-	//
-	//}
+	case Format::ABGR8SrgbPack32: {
+		fetch_pixel<uint32_t>(ptr, width, x, y) =
+			static_cast<uint32_t>(F2SRGB(value.x)) << 0 |
+			static_cast<uint32_t>(F2SRGB(value.y)) << 8 |
+			static_cast<uint32_t>(F2SRGB(value.z)) << 16 |
+			static_cast<uint32_t>(F2UNORM(uint8_t, value.w)) << 24;
+	} return;
 	case Format::A2RGB10UnormPack32: {
 		fetch_pixel<uint32_t>(ptr, width, x, y) =
 			(static_cast<uint32_t>(value.x * 1023.99f) & 0x3ff) << 20 |
@@ -1409,4 +1567,248 @@ static void store_components(void* ptr, uint32_t width, uint32_t x, uint32_t y,
 	VERA_ASSERT_MSG(false, "unsupported format");
 }
 
+// Compile time counterparts of fetch_components and store_components for the formats the cpu
+// image paths see most, each converts exactly like its case in the switches above. The primary
+// template keeps the runtime switch for every other format. Lossless codecs return every texel
+// unchanged after a load and a store, so copying the Texel is the same as converting it.
+template <Format F>
+struct PixelCodec
+{
+	static constexpr bool Lossless = false;
+	typedef void Texel;
+
+	static VERA_FORCEINLINE float4 load(const void* ptr, uint32_t width, uint32_t x, uint32_t y, Format format)
+	{
+		return fetch_components(ptr, width, x, y, format);
+	}
+
+	static VERA_FORCEINLINE void store(void* ptr, uint32_t width, uint32_t x, uint32_t y, Format format, const float4& value)
+	{
+		store_components(ptr, width, x, y, format, value);
+	}
+};
+
+template <>
+struct PixelCodec<Format::R8Unorm>
+{
+	static constexpr bool Lossless = true;
+	typedef uint8_t Texel;
+
+	static VERA_FORCEINLINE float4 load(const void* ptr, uint32_t width, uint32_t x, uint32_t y, Format)
+	{
+		auto pixel = fetch_pixel<uint8_t>(ptr, width, x, y);
+		return { UNORM2F(pixel), 0.f, 0.f, NOALPHA };
+	}
+
+	static VERA_FORCEINLINE void store(void* ptr, uint32_t width, uint32_t x, uint32_t y, Format, const float4& value)
+	{
+		fetch_pixel<uint8_t>(ptr, width, x, y) = F2UNORM(uint8_t, value.x);
+	}
+};
+
+template <>
+struct PixelCodec<Format::RG8Unorm>
+{
+	static constexpr bool Lossless = true;
+	typedef uchar2 Texel;
+
+	static VERA_FORCEINLINE float4 load(const void* ptr, uint32_t width, uint32_t x, uint32_t y, Format)
+	{
+		auto pixel = fetch_pixel<uchar2>(ptr, width, x, y);
+		return { UNORM2F(pixel.x), UNORM2F(pixel.y), 0.f, NOALPHA };
+	}
+
+	static VERA_FORCEINLINE void store(void* ptr, uint32_t width, uint32_t x, uint32_t y, Format, const float4& value)
+	{
+		auto& pixel = fetch_pixel<uchar2>(ptr, width, x, y);
+		pixel.x = F2UNORM(uint8_t, value.x);
+		pixel.y = F2UNORM(uint8_t, value.y);
+	}
+};
+
+template <>
+struct PixelCodec<Format::RGBA8Unorm>
+{
+	static constexpr bool Lossless = true;
+	typedef uchar4 Texel;
+
+	static VERA_FORCEINLINE float4 load(const void* ptr, uint32_t width, uint32_t x, uint32_t y, Format)
+	{
+		auto pixel = fetch_pixel<uchar4>(ptr, width, x, y);
+		return { UNORM2F(pixel.x), UNORM2F(pixel.y), UNORM2F(pixel.z), UNORM2F(pixel.w) };
+	}
+
+	static VERA_FORCEINLINE void store(void* ptr, uint32_t width, uint32_t x, uint32_t y, Format, const float4& value)
+	{
+		auto& pixel = fetch_pixel<uchar4>(ptr, width, x, y);
+		pixel.x = F2UNORM(uint8_t, value.x);
+		pixel.y = F2UNORM(uint8_t, value.y);
+		pixel.z = F2UNORM(uint8_t, value.z);
+		pixel.w = F2UNORM(uint8_t, value.w);
+	}
+};
+
+template <>
+struct PixelCodec<Format::BGRA8Unorm>
+{
+	static constexpr bool Lossless = true;
+	typedef uchar4 Texel;
+
+	static VERA_FORCEINLINE float4 load(const void* ptr, uint32_t width, uint32_t x, uint32_t y, Format)
+	{
+		auto pixel = fetch_pixel<uchar4>(ptr, width, x, y);
+		return { UNORM2F(pixel.z), UNORM2F(pixel.y), UNORM2F(pixel.x), UNORM2F(pixel.w) };
+	}
+
+	static VERA_FORCEINLINE void store(void* ptr, uint32_t width, uint32_t x, uint32_t y, Format, const float4& value)
+	{
+		auto& pixel = fetch_pixel<uchar4>(ptr, width, x, y);
+		pixel.x = F2UNORM(uint8_t, value.z);
+		pixel.y = F2UNORM(uint8_t, value.y);
+		pixel.z = F2UNORM(uint8_t, value.x);
+		pixel.w = F2UNORM(uint8_t, value.w);
+	}
+};
+
+template <>
+struct PixelCodec<Format::RGBA8Srgb>
+{
+	static constexpr bool Lossless = true;
+	typedef uchar4 Texel;
+
+	static VERA_FORCEINLINE float4 load(const void* ptr, uint32_t width, uint32_t x, uint32_t y, Format)
+	{
+		auto pixel = fetch_pixel<uchar4>(ptr, width, x, y);
+		return { SRGB2F(pixel.x), SRGB2F(pixel.y), SRGB2F(pixel.z), UNORM2F(pixel.w) };
+	}
+
+	static VERA_FORCEINLINE void store(void* ptr, uint32_t width, uint32_t x, uint32_t y, Format, const float4& value)
+	{
+		auto& pixel = fetch_pixel<uchar4>(ptr, width, x, y);
+		pixel.x = F2SRGB(value.x);
+		pixel.y = F2SRGB(value.y);
+		pixel.z = F2SRGB(value.z);
+		pixel.w = F2UNORM(uint8_t, value.w);
+	}
+};
+
+template <>
+struct PixelCodec<Format::BGRA8Srgb>
+{
+	static constexpr bool Lossless = true;
+	typedef uchar4 Texel;
+
+	static VERA_FORCEINLINE float4 load(const void* ptr, uint32_t width, uint32_t x, uint32_t y, Format)
+	{
+		auto pixel = fetch_pixel<uchar4>(ptr, width, x, y);
+		return { SRGB2F(pixel.z), SRGB2F(pixel.y), SRGB2F(pixel.x), UNORM2F(pixel.w) };
+	}
+
+	static VERA_FORCEINLINE void store(void* ptr, uint32_t width, uint32_t x, uint32_t y, Format, const float4& value)
+	{
+		auto& pixel = fetch_pixel<uchar4>(ptr, width, x, y);
+		pixel.x = F2SRGB(value.z);
+		pixel.y = F2SRGB(value.y);
+		pixel.z = F2SRGB(value.x);
+		pixel.w = F2UNORM(uint8_t, value.w);
+	}
+};
+
+template <>
+struct PixelCodec<Format::R16Unorm>
+{
+	static constexpr bool Lossless = true;
+	typedef uint16_t Texel;
+
+	static VERA_FORCEINLINE float4 load(const void* ptr, uint32_t width, uint32_t x, uint32_t y, Format)
+	{
+		auto pixel = fetch_pixel<uint16_t>(ptr, width, x, y);
+		return { UNORM2F(pixel), 0.f, 0.f, NOALPHA };
+	}
+
+	static VERA_FORCEINLINE void store(void* ptr, uint32_t width, uint32_t x, uint32_t y, Format, const float4& value)
+	{
+		fetch_pixel<uint16_t>(ptr, width, x, y) = F2UNORM(uint16_t, value.x);
+	}
+};
+
+template <>
+struct PixelCodec<Format::RGBA16Unorm>
+{
+	static constexpr bool Lossless = true;
+	typedef ushort4 Texel;
+
+	static VERA_FORCEINLINE float4 load(const void* ptr, uint32_t width, uint32_t x, uint32_t y, Format)
+	{
+		auto pixel = fetch_pixel<ushort4>(ptr, width, x, y);
+		return { UNORM2F(pixel.x), UNORM2F(pixel.y), UNORM2F(pixel.z), UNORM2F(pixel.w) };
+	}
+
+	static VERA_FORCEINLINE void store(void* ptr, uint32_t width, uint32_t x, uint32_t y, Format, const float4& value)
+	{
+		auto& pixel = fetch_pixel<ushort4>(ptr, width, x, y);
+		pixel.x = F2UNORM(uint16_t, value.x);
+		pixel.y = F2UNORM(uint16_t, value.y);
+		pixel.z = F2UNORM(uint16_t, value.z);
+		pixel.w = F2UNORM(uint16_t, value.w);
+	}
+};
+
+template <>
+struct PixelCodec<Format::RGBA16Float>
+{
+	static constexpr bool Lossless = true;
+	typedef ushort4 Texel;
+
+	static VERA_FORCEINLINE float4 load(const void* ptr, uint32_t width, uint32_t x, uint32_t y, Format)
+	{
+		auto pixel = fetch_pixel<ushort4>(ptr, width, x, y);
+		return { HALF2F(pixel.x), HALF2F(pixel.y), HALF2F(pixel.z), HALF2F(pixel.w) };
+	}
+
+	static VERA_FORCEINLINE void store(void* ptr, uint32_t width, uint32_t x, uint32_t y, Format, const float4& value)
+	{
+		auto& pixel = fetch_pixel<ushort4>(ptr, width, x, y);
+		pixel.x = F2HALF(value.x);
+		pixel.y = F2HALF(value.y);
+		pixel.z = F2HALF(value.z);
+		pixel.w = F2HALF(value.w);
+	}
+};
+
+template <>
+struct PixelCodec<Format::R32Float>
+{
+	static constexpr bool Lossless = true;
+	typedef float Texel;
+
+	static VERA_FORCEINLINE float4 load(const void* ptr, uint32_t width, uint32_t x, uint32_t y, Format)
+	{
+		auto pixel = fetch_pixel<float>(ptr, width, x, y);
+		return { pixel, 0.f, 0.f, NOALPHA };
+	}
+
+	static VERA_FORCEINLINE void store(void* ptr, uint32_t width, uint32_t x, uint32_t y, Format, const float4& value)
+	{
+		fetch_pixel<float>(ptr, width, x, y) = value.x;
+	}
+};
+
+template <>
+struct PixelCodec<Format::RGBA32Float>
+{
+	static constexpr bool Lossless = true;
+	typedef float4 Texel;
+
+	static VERA_FORCEINLINE float4 load(const void* ptr, uint32_t width, uint32_t x, uint32_t y, Format)
+	{
+		return fetch_pixel<float4>(ptr, width, x, y);
+	}
+
+	static VERA_FORCEINLINE void store(void* ptr, uint32_t width, uint32_t x, uint32_t y, Format, const float4& value)
+	{
+		fetch_pixel<float4>(ptr, width, x, y) = value;
+	}
+};
+
 VERA_NAMESPACE_END
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "pixel.h"
+#include "../../include/vera/graphics/image_sampler.h"
+#include <cmath>
+
+VERA_NAMESPACE_BEGIN
+
+// Texel addressing and filtering shared by ImageSampler and the bulk image paths, both go
+// through these functions so a blit produces exactly what sampling pixel by pixel would.
+
+static float modf(float x, float y)
+{
+	float mod = fmodf(x, y);
+	return 0 < x ? mod : y + mod;
+}
+
+static float repeatf(float x, float size)
+{
+	return modf(x + 0.5f, size) - 0.5f;
+}
+
+static float mirrored_repeatf(float x, float size)
+{
+	return -fabsf(modf(x + 0.5f, 2.f * size) - size) + size - 0.5f;
+}
+
+static float clamp_edge(float x, float size)
+{
+	if (x < 0.5f) return -0.5f;
+	if (size - 0.5f < x) return size - 0.5f;
+	return x;
+}
+
+static float clamp_border(float x, float size)
+{
+	if (x < -0.5f || size - 0.5f < x) return NAN;
+	return x;
+}
+
+static float mirror_clamp_edge(float x, float size)
+{
+	return fminf(fabsf(x + 0.5f) - 0.5f, size - 0.5f);
+}
+
+// Maps a texel space coordinate into the image, returns false when it resolves to the border
+template <ImageSamplerAddressMode Mode>
+static VERA_FORCEINLINE bool resolve_address(float& x, float size)
+{
+	switch (Mode) {
+	case ImageSamplerAddressMode::Repeat:
+		x = repeatf(x, size);
+		break;
+	case ImageSamplerAddressMode::MirroredRepeat:
+		x = mirrored_repeatf(x, size);
+		break;
+	case ImageSamplerAddressMode::ClampToEdge:
+		x = clamp_edge(x, size);
+		break;
+	case ImageSamplerAddressMode::ClampToBorder:
+		if (x < -0.5f || size - 0.5f <= x)
+			return false;
+		break;
+	case ImageSamplerAddressMode::MirrorClampToEdge:
+		x = mirror_clamp_edge(x, size);
+		break;
+	}
+
+	return true;
+}
+
+static VERA_FORCEINLINE uint32_t nearest_texel(float x, float size)
+{
+	uint32_t rnd_x = x <= 0.5f ? 0 : static_cast<uint32_t>(roundf(x));
+	return static_cast<uint32_t>(size - 1 <= x ? size - 1 : rnd_x);
+}
+
+struct LinearTexels
+{
+	uint32_t i0;
+	uint32_t i1;
+	float    t0;
+	float    t1;
+};
+
+static VERA_FORCEINLINE LinearTexels linear_texels(float x, float size)
+{
+	// the floor is -1 for coordinates clamped to -0.5, it is kept signed so the neighbour of that
+	// texel wraps to 0 instead of going through an out of range float conversion, the neighbour
+	// of the last texel wraps to 0 as well rather than reading one past the end of the row
+	LinearTexels result;
+	int64_t      flr_x = static_cast<int64_t>(floorf(x));
+
+	result.t0 = fmodf(x + 1.f, 1.f);
+	result.t1 = 1.f - result.t0;
+	result.i0 = x < 0.f ? static_cast<uint32_t>(size - 1) : static_cast<uint32_t>(flr_x);
+	result.i1 = size - 1.f <= x ? 0 : static_cast<uint32_t>(flr_x + 1);
+
+	return result;
+}
+
+template <class Codec>
+static VERA_FORCEINLINE float4 filter_linear(
+	const void*         ptr,
+	uint32_t            width,
+	Format              format,
+	const LinearTexels& tu,
+	const LinearTexels& tv)
+{
+	float4 color0 = Codec::load(ptr, width, tu.i0, tv.i0, format);
+	float4 color1 = Codec::load(ptr, width, tu.i1, tv.i0, format);
+	float4 color2 = Codec::load(ptr, width, tu.i1, tv.i1, format);
+	float4 color3 = Codec::load(ptr, width, tu.i0, tv.i1, format);
+
+	return
+		tu.t0 * tv.t0 * color0 +
+		tu.t1 * tv.t0 * color1 +
+		tu.t1 * tv.t1 * color2 +
+		tu.t0 * tv.t1 * color3;
+}
+
+template <class Codec, ImageSamplerAddressMode ModeU, ImageSamplerAddressMode ModeV>
+static VERA_FORCEINLINE float4 sample_nearest(
+	const void*   ptr,
+	uint32_t      width,
+	uint32_t      height,
+	Format        format,
+	float         u,
+	float         v,
+	const float4& border_color)
+{
+	const float w = static_cast<float>(width);
+	const float h = static_cast<float>(height);
+
+	if (!resolve_address<ModeU>(u, w) || !resolve_address<ModeV>(v, h))
+		return border_color;
+
+	return Codec::load(ptr, width, nearest_texel(u, w), nearest_texel(v, h), format);
+}
+
+template <class Codec, ImageSamplerAddressMode ModeU, ImageSamplerAddressMode ModeV>
+static VERA_FORCEINLINE float4 sample_linear(
+	const void*   ptr,
+	uint32_t      width,
+	uint32_t      height,
+	Format        format,
+	float         u,
+	float         v,
+	const float4& border_color)
+{
+	const float w = static_cast<float>(width);
+	const float h = static_cast<float>(height);
+
+	if (!resolve_address<ModeU>(u, w) || !resolve_address<ModeV>(v, h))
+		return border_color;
+
+	return filter_linear<Codec>(ptr, width, format, linear_texels(u, w), linear_texels(v, h));
+}
+
+VERA_NAMESPACE_END
@@ -7,14 +7,17 @@ VERA_NAMESPACE_BEGIN
 class BufferImpl
 {
 public:
-	obj<Device>       device    = {};
-	obj<DeviceMemory> memory    = {};
+	obj<Device>         device        = {};
+	obj<DeviceMemory>   memory        = {};
 
-	vk::Buffer        vkBuffer  = {};
+	vk::Buffer          vkBuffer      = {};
 
-	size_t            size      = {};
-	BufferUsageFlags  usage     = {};
-	IndexType         indexType = {};
+	size_t              size          = {};
+	size_t              memoryOffset  = {};
+	uint32_t            allocationID  = {};
+	BufferUsageFlags    usage         = {};
+	MemoryPropertyFlags propertyFlags = {};
+	IndexType           indexType     = {};
 };
 
 class BufferViewImpl
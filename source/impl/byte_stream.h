@@ -0,0 +1,179 @@
+#pragma once
+
+#include "../../include/vera/util/array_view.h"
+#include "../../include/vera/util/hash.h"
+#include <string_view>
+#include <vector>
+#include <bit>
+
+VERA_NAMESPACE_BEGIN
+
+// every value is written little endian so a file written on one host reads on any other
+
+class ByteWriter
+{
+public:
+	void u8(uint8_t value)
+	{
+		m_bytes.push_back(value);
+	}
+
+	void u32(uint32_t value)
+	{
+		for (uint32_t i = 0; i < 4; ++i)
+			m_bytes.push_back(static_cast<uint8_t>(value >> (i * 8)));
+	}
+
+	void u64(uint64_t value)
+	{
+		for (uint32_t i = 0; i < 8; ++i)
+			m_bytes.push_back(static_cast<uint8_t>(value >> (i * 8)));
+	}
+
+	void f32(float value)
+	{
+		u32(std::bit_cast<uint32_t>(value));
+	}
+
+	void key(const hash128_t& value)
+	{
+		u64(value.low);
+		u64(value.high);
+	}
+
+	void bytes(array_view<uint8_t> data)
+	{
+		u32(static_cast<uint32_t>(data.size()));
+		m_bytes.insert(m_bytes.end(), data.begin(), data.end());
+	}
+
+	void str(std::string_view value)
+	{
+		u32(static_cast<uint32_t>(value.size()));
+		m_bytes.insert(m_bytes.end(), value.begin(), value.end());
+	}
+
+	std::vector<uint8_t>& data()
+	{
+		return m_bytes;
+	}
+
+private:
+	std::vector<uint8_t> m_bytes;
+};
+
+// reading past the end sets a sticky failure flag and yields zeros
+class ByteReader
+{
+public:
+	ByteReader(array_view<uint8_t> bytes) :
+		m_ptr(bytes.data()),
+		m_end(bytes.data() + bytes.size()),
+		m_failed(false) {}
+
+	uint8_t u8()
+	{
+		if (!check(1)) return 0;
+		return *m_ptr++;
+	}
+
+	uint32_t u32()
+	{
+		uint32_t result = 0;
+
+		if (!check(4)) return 0;
+		for (uint32_t i = 0; i < 4; ++i)
+			result |= static_cast<uint32_t>(*m_ptr++) << (i * 8);
+
+		return result;
+	}
+
+	uint64_t u64()
+	{
+		uint64_t result = 0;
+
+		if (!check(8)) return 0;
+		for (uint32_t i = 0; i < 8; ++i)
+			result |= static_cast<uint64_t>(*m_ptr++) << (i * 8);
+
+		return result;
+	}
+
+	float f32()
+	{
+		return std::bit_cast<float>(u32());
+	}
+
+	hash128_t key()
+	{
+		hash128_t result;
+		result.low  = u64();
+		result.high = u64();
+
+		return result;
+	}
+
+	array_view<uint8_t> bytes()
+	{
+		uint32_t size = u32();
+
+		if (!check(size)) return {};
+
+		array_view<uint8_t> result(m_ptr, size);
+		m_ptr += size;
+
+		return result;
+	}
+
+	// points into the read bytes, the string is not null terminated
+	std::string_view str()
+	{
+		auto result = bytes();
+		return std::string_view(reinterpret_cast<const char*>(result.data()), result.size());
+	}
+
+	// guards element counts read from the file before anything is resized by them
+	uint32_t count(size_t min_element_size)
+	{
+		uint32_t result = u32();
+
+		if (!check(static_cast<size_t>(result) * min_element_size)) return 0;
+		return result;
+	}
+
+	VERA_NODISCARD bool failed() const
+	{
+		return m_failed;
+	}
+
+	VERA_NODISCARD bool atEnd() const
+	{
+		return m_ptr == m_end;
+	}
+
+private:
+	bool check(size_t size)
+	{
+		if (m_failed || static_cast<size_t>(m_end - m_ptr) < size)
+			m_failed = true;
+		return !m_failed;
+	}
+
+	const uint8_t* m_ptr;
+	const uint8_t* m_end;
+	bool           m_failed;
+};
+
+template <class Enum>
+Enum read_enum(ByteReader& reader)
+{
+	return static_cast<Enum>(reader.u32());
+}
+
+template <class FlagType>
+FlagType read_flags(ByteReader& reader)
+{
+	return FlagType(static_cast<typename FlagType::mask_type>(reader.u32()));
+}
+
+VERA_NAMESPACE_END
@@ -21,17 +21,40 @@ struct CommandBufferTracker
 	uint64_t           submitID  = 0;
 };
 
+// Descriptor sets and push constant bytes last recorded for a pipeline layout, lets repeated
+// shader parameter binds skip state the command buffer already holds.
+struct CommandBufferBindState
+{
+	vk::PipelineBindPoint          bindPoint      = {};
+	vk::PipelineLayout             pipelineLayout = {};
+	std::vector<vk::DescriptorSet> descriptorSets = {}; // indexed by set, null when unknown
+	std::vector<std::byte>         pushConstants  = {}; // empty when unknown
+
+	void reset(vk::PipelineBindPoint bind_point, vk::PipelineLayout layout) VERA_NOEXCEPT
+	{
+		bindPoint      = bind_point;
+		pipelineLayout = layout;
+		descriptorSets.clear();
+		pushConstants.clear();
+	}
+};
+
 class CommandBufferImpl
 {
 public:
 	using DescriptorSetState = std::vector<cref<DescriptorSet>>;
 	using Tracker            = std::shared_ptr<CommandBufferTracker>;
+	using BindState          = CommandBufferBindState;
+	using BindStatistics     = CommandBufferBindStatistics;
 
 	obj<Device>        device                = {};
 
-	vk::CommandPool    vkCommandPool         = {};
+	vk::CommandPool    vkCommandPool         = {}; // null for frame command buffers
 	vk::CommandBuffer  vkCommandBuffer       = {};
 
+	CommandBufferLevel level                 = {};
+	uint32_t           queueFamilyIndex      = {};
+	uint64_t           frameKey              = {}; // frame of the pool, 0 for standalone command buffers
 	SubmitQueueType    submitQueueType       = {};
 	Tracker            tracker               = {};
 	Viewport           currentViewport       = {};
@@ -41,6 +64,8 @@ public:
 	RenderingInfo      currentRenderingInfo  = {};
 	DescriptorSetState currentDescriptorSets = {};
 	cref<Pipeline>     currentPipeline       = {};
+	BindState          boundState            = {};
+	BindStatistics     bindStatistics        = {};
 
 	void submitToDedicatedQueue(const vk::SubmitInfo& submit_info);
 };
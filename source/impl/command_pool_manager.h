@@ -0,0 +1,77 @@
+#pragma once
+
+#include "object_impl.h"
+
+#include "../../include/vera/core/command_sync.h"
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+VERA_NAMESPACE_BEGIN
+
+// Device owned source of command buffers.
+// Standalone command buffers keep a pool of their own, which is reset and put on a free list when
+// the buffer is destroyed instead of being destroyed with it. Frame command buffers come from pools
+// bound to the recording thread, one per thread, queue family and frame. Once the frame is retired
+// and its sync completes, its pools go back to a free list any thread takes them from, so pools of
+// threads that exited are reused as well. A pool is reset by the thread that takes it next.
+class CommandPoolManager
+{
+public:
+	struct StandaloneCommandBuffer
+	{
+		vk::CommandPool   pool;
+		vk::CommandBuffer buffer;
+	};
+
+	CommandPoolManager(ref<Device> device) VERA_NOEXCEPT;
+	~CommandPoolManager() VERA_NOEXCEPT;
+
+	VERA_NODISCARD StandaloneCommandBuffer acquireStandalone(uint32_t queue_family);
+	// the buffer must not be pending any more
+	void releaseStandalone(uint32_t queue_family, const StandaloneCommandBuffer& cmd) VERA_NOEXCEPT;
+
+	// key of a new frame, buffers acquired for it stay valid until the frame is retired and complete
+	VERA_NODISCARD uint64_t beginFrame();
+	// the buffer belongs to a pool of the calling thread and must only be recorded on this thread
+	VERA_NODISCARD vk::CommandBuffer acquireFrameBuffer(uint64_t frame_key, uint32_t queue_family, vk::CommandBufferLevel level);
+	// pools of the frame are freed for reuse once sync completes, an empty sync completes at once
+	void retireFrame(uint64_t frame_key, CommandSync sync);
+
+private:
+	struct FramePool
+	{
+		vk::CommandPool                pool;
+		uint32_t                       queueFamily;
+		std::thread::id                thread;         // recording thread while the frame is open
+		std::vector<vk::CommandBuffer> primaries;
+		std::vector<vk::CommandBuffer> secondaries;
+		uint32_t                       primaryCount;   // handed out since the last reset
+		uint32_t                       secondaryCount; // handed out since the last reset
+	};
+
+	typedef std::vector<std::unique_ptr<FramePool>> FramePools;
+
+	struct FrameState
+	{
+		CommandSync sync;
+		FramePools  pools; // pools holding buffers of the frame
+		bool        retired;
+	};
+
+	// moves pools of retired and complete frames to the free lists, pools beyond the limit are
+	// moved to dropped instead to be destroyed outside the lock
+	void reclaimFrames(FramePools& dropped);
+	void destroyPools(const FramePools& pools) VERA_NOEXCEPT;
+
+	ref<Device>                                                        m_device;
+	std::unordered_map<uint32_t, std::vector<StandaloneCommandBuffer>> m_standalone; // free pools by queue family
+	std::unordered_map<uint32_t, FramePools>                           m_free_frame_pools; // by queue family, not reset yet
+	std::unordered_map<uint64_t, FrameState>                           m_frames;
+	uint64_t                                                           m_next_frame_key;
+	std::mutex                                                         m_mutex;
+};
+
+VERA_NAMESPACE_END
@@ -17,8 +17,17 @@ public:
 	vk::DescriptorSetLayout  vkDescriptorSetLayout = {};
 
 	hash_t                   hashValue             = {};
+	DescriptorSetLayoutCreateFlags flags           = {};
 	LayoutBindings           bindings              = {};
 	BindingMap               bindingMap            = {};
 };
 
+class DeviceImpl;
+
+// also used to rebuild layouts of pipelines recorded in the pipeline index
+vk::DescriptorSetLayout create_vk_descriptor_set_layout(
+	const DeviceImpl&                      device_impl,
+	DescriptorSetLayoutCreateFlags         flags,
+	array_view<DescriptorSetLayoutBinding> bindings);
+
 VERA_NAMESPACE_END
\ No newline at end of file
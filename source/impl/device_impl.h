@@ -1,10 +1,18 @@
 #pragma once
 
 #include "object_impl.h"
+#include "staging_uploader.h"
+#include "pipeline_index.h"
+#include "reflection_cache.h"
+#include "pipeline_compiler.h"
+#include "object_cache.h"
+#include "command_pool_manager.h"
 
 #include "../../include/vera/core/device.h"
 #include <unordered_map>
 #include <bitset>
+#include <memory>
+#include <mutex>
 
 VERA_NAMESPACE_BEGIN
 
@@ -15,16 +23,17 @@ public:
 	using DeviceMemoryProperties       = vk::PhysicalDeviceMemoryProperties;
 	using DescriptorIndexingProperties = vk::PhysicalDeviceDescriptorIndexingProperties;
 
-	using ShaderCacheType              = std::unordered_map<hash_t, ref<Shader>>;
-	using ShaderReflectionCacheType    = std::unordered_map<hash_t, ref<ShaderReflection>>;
-	using ProgramReflectionCacheType   = std::unordered_map<hash_t, ref<ProgramReflection>>;
-	using DescriptorSetLayoutCacheType = std::unordered_map<hash_t, ref<DescriptorSetLayout>>;
-	using PipelineLayoutCacheType      = std::unordered_map<hash_t, ref<PipelineLayout>>;
+	using ShaderCacheType              = ObjectCache<Shader>;
+	using ShaderReflectionCacheType    = ObjectCache<ShaderReflection>;
+	using ProgramReflectionCacheType   = ObjectCache<ProgramReflection>;
+	using DescriptorSetLayoutCacheType = ObjectCache<DescriptorSetLayout>;
+	using PipelineLayoutCacheType      = ObjectCache<PipelineLayout>;
 	using PipelineCacheType            = std::unordered_map<hash_t, ref<Pipeline>>;
-	using SamplerCacheType             = std::unordered_map<hash_t, ref<Sampler>>;
+	using SamplerCacheType             = ObjectCache<Sampler>;
 
 	using DeviceMemoryTypes  = std::vector<DeviceMemoryType>;
 	using DeviceFeatureTypes = std::vector<uint8_t>;
+	using MemoryBlockPools   = std::vector<std::vector<ref<DeviceMemory>>>;
 
 	obj<Context>                 context                          = {};
 
@@ -47,13 +56,21 @@ public:
 	std::string                  pipelineCacheFilePath            = {};
 	DeviceFeatureTypes           enabledFeatures                  = {};
 	DeviceMemoryTypes            memoryTypes                      = {};
+	MemoryBlockPools             memoryBlockPools                 = {}; // [memory type * 2 + is texture]
+	size_t                       memoryBlockSize                  = {};
+	std::unique_ptr<CommandPoolManager> commandPoolManager        = {};
+	std::unique_ptr<StagingUploader>  stagingUploader             = {};
+	std::unique_ptr<PipelineIndex>    pipelineIndex               = {};
+	std::unique_ptr<ReflectionCache>  reflectionCache             = {};
+	std::unique_ptr<PipelineCompiler> pipelineCompiler            = {};
 
 	ShaderCacheType              shaderCache                      = {};
 	ShaderReflectionCacheType    shaderReflectionCache            = {};
 	ProgramReflectionCacheType   programReflectionCache           = {};
 	DescriptorSetLayoutCacheType descriptorSetLayoutCache         = {};
 	PipelineLayoutCacheType      pipelineLayoutCache              = {};
-	PipelineCacheType            pipelineCache                    = {};
+	PipelineCacheType            pipelineCache                    = {}; // guarded by pipelineCacheMutex
+	std::mutex                   pipelineCacheMutex               = {};
 	SamplerCacheType             samplerCache                     = {};
 
 	obj<Sampler>                 defaultSampler                   = {};
@@ -62,78 +79,73 @@ public:
 	VERA_NODISCARD bool isFeatureEnabled(DeviceFeatureType feature) const VERA_NOEXCEPT;
 	VERA_NODISCARD uint32_t findMemoryTypeIndex(MemoryPropertyFlags flags, std::bitset<32> type_mask) VERA_NOEXCEPT;
 
+	// the caches below are safe to use from any thread, pipelines have their own cache in pipeline.cpp
 	template <class CoreObject>
-	obj<CoreObject> findCachedObject(hash_t hash_value)
+	VERA_NODISCARD obj<CoreObject> findCachedObject(hash_t hash_value)
 	{
-		static_assert("unsupported CoreObject type for caching");
+		return getObjectCache<CoreObject>().find(hash_value);
 	}
 
-	template <> obj<Shader> findCachedObject<Shader>(hash_t hash_value);
-	template <> obj<ShaderReflection> findCachedObject<ShaderReflection>(hash_t hash_value);
-	template <> obj<ProgramReflection> findCachedObject<ProgramReflection>(hash_t hash_value);
-	template <> obj<DescriptorSetLayout> findCachedObject<DescriptorSetLayout>(hash_t hash_value);
-	template <> obj<PipelineLayout> findCachedObject<PipelineLayout>(hash_t hash_value);
-	template <> obj<Pipeline> findCachedObject<Pipeline>(hash_t hash_value);
-	template <> obj<Sampler> findCachedObject<Sampler>(hash_t hash_value);
+	// returns the cached object or the one create_func returns, concurrent calls with the same
+	// hash value wait for the first one instead of creating the object again
+	template <class CoreObject, class CreateFunc>
+	VERA_NODISCARD obj<CoreObject> acquireCachedObject(hash_t hash_value, CreateFunc&& create_func)
+	{
+		VERA_ASSERT_MSG(hash_value, "cannot cache object with invalid hash value");
+
+		return getObjectCache<CoreObject>().acquire(hash_value, std::forward<CreateFunc>(create_func));
+	}
 
 	template <class CoreObject>
 	void registerCachedObject(hash_t hash_value, ref<CoreObject> object)
 	{
 		VERA_ASSERT_MSG(hash_value, "cannot cache object with invalid hash value");
 
+		if (getObjectCache<CoreObject>().insert(hash_value, object))
+			return;
+
 		if constexpr (std::is_same_v<CoreObject, Shader>){
-			if (!shaderCache.emplace(hash_value, object).second)
-				throw Exception("Failed to register shader: hash collision(hash= {:016x})", hash_value);
+			throw Exception("Failed to register shader: hash collision(hash= {:016x})", hash_value);
 		} else if constexpr (std::is_same_v<CoreObject, ShaderReflection>) {
-			if (!shaderReflectionCache.emplace(hash_value, object).second)
-				throw Exception("Failed to register shader layout: hash collision(hash= {:016x})", hash_value);
+			throw Exception("Failed to register shader layout: hash collision(hash= {:016x})", hash_value);
 		} else if constexpr (std::is_same_v<CoreObject, ProgramReflection>) {
-			if (!programReflectionCache.emplace(hash_value, object).second)
-				throw Exception("Failed to register program layout: hash collision(hash= {:016x})", hash_value);
+			throw Exception("Failed to register program layout: hash collision(hash= {:016x})", hash_value);
 		} else if constexpr (std::is_same_v<CoreObject, DescriptorSetLayout>) {
-			if (!descriptorSetLayoutCache.emplace(hash_value, object).second)
-				throw Exception("Failed to register descriptor set layout: hash collision(hash= {:016x})", hash_value);
+			throw Exception("Failed to register descriptor set layout: hash collision(hash= {:016x})", hash_value);
 		} else if constexpr (std::is_same_v<CoreObject, PipelineLayout>) {
-			if (!pipelineLayoutCache.emplace(hash_value, object).second)
-				throw Exception("Failed to register pipeline layout: hash collision(hash= {:016x})", hash_value);
-		} else if constexpr (std::is_same_v<CoreObject, Pipeline>) {
-			if (!pipelineCache.emplace(hash_value, object).second)
-				throw Exception("Failed to register pipeline: hash collision(hash= {:016x})", hash_value);
+			throw Exception("Failed to register pipeline layout: hash collision(hash= {:016x})", hash_value);
 		} else if constexpr (std::is_same_v<CoreObject, Sampler>) {
-			if (!samplerCache.emplace(hash_value, object).second)
-				throw Exception("Failed to register sampler: hash collision(hash= {:016x})", hash_value);
-		} else {
-			static_assert("unsupported CoreObject type for caching");
+			throw Exception("Failed to register sampler: hash collision(hash= {:016x})", hash_value);
 		}
 	}
 
 	template <class CoreObject>
-	void unregisterCachedObject(hash_t hash_value) VERA_NOEXCEPT
+	void unregisterCachedObject(hash_t hash_value, const CoreObject* object) VERA_NOEXCEPT
 	{
-		size_t erased;
-
 		VERA_ASSERT_MSG(hash_value, "cannot cache object with invalid hash value");
 
+		getObjectCache<CoreObject>().erase(hash_value, object);
+	}
+
+private:
+	template <class CoreObject>
+	VERA_NODISCARD ObjectCache<CoreObject>& getObjectCache() VERA_NOEXCEPT
+	{
 		if constexpr (std::is_same_v<CoreObject, Shader>){
-			erased = shaderCache.erase(hash_value);
+			return shaderCache;
 		} else if constexpr (std::is_same_v<CoreObject, ShaderReflection>) {
-			erased = shaderReflectionCache.erase(hash_value);
+			return shaderReflectionCache;
 		} else if constexpr (std::is_same_v<CoreObject, ProgramReflection>) {
-			erased = programReflectionCache.erase(hash_value);
+			return programReflectionCache;
 		} else if constexpr (std::is_same_v<CoreObject, DescriptorSetLayout>) {
-			erased = descriptorSetLayoutCache.erase(hash_value);
+			return descriptorSetLayoutCache;
 		} else if constexpr (std::is_same_v<CoreObject, PipelineLayout>) {
-			erased = pipelineLayoutCache.erase(hash_value);
-		} else if constexpr (std::is_same_v<CoreObject, Pipeline>) {
-			erased = pipelineCache.erase(hash_value);
+			return pipelineLayoutCache;
 		} else if constexpr (std::is_same_v<CoreObject, Sampler>) {
-			erased = samplerCache.erase(hash_value);
+			return samplerCache;
 		} else {
-			static_assert("unsupported CoreObject type for caching");
+			static_assert(!sizeof(CoreObject), "unsupported CoreObject type for caching");
 		}
-
-		VERA_ASSERT_MSG(erased == 1, "failed to unregister cached object");
-		(void)erased;
 	}
 };
 
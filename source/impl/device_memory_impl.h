@@ -3,6 +3,8 @@
 #include "object_impl.h"
 
 #include "../../include/vera/core/device_memory.h"
+#include "../../include/vera/util/tlsf_allocator.h"
+#include <memory>
 
 VERA_NAMESPACE_BEGIN
 
@@ -20,18 +22,40 @@ struct MemoryResourceBind
 	void*              resourcePtr;
 };
 
+struct MemoryAllocation
+{
+	obj<DeviceMemory> memory;
+	size_t            offset;
+	uint32_t          allocationID;
+};
+
 class DeviceMemoryImpl
 {
 public:
 	obj<Device>                     device        = {};
 
-	vk::DeviceMemory                vkMemory        = {};
+	vk::DeviceMemory                vkMemory      = {};
 
 	MemoryPropertyFlags             propertyFlags = {};
 	std::vector<MemoryResourceBind> resourceBind  = {};
+	std::unique_ptr<TLSFAllocator>  allocator     = {}; // null for dedicated memory
 	size_t                          allocated     = {};
 	uint32_t                        typeIndex     = {};
+	uint32_t                        poolIndex     = {};
 	void*                           mapPtr        = {};
 };
 
+// Carves the resource out of a shared per memory type block, large resources get dedicated memory.
+// Buffers and textures are kept in separate pools, so bufferImageGranularity never has to be honored.
+MemoryAllocation allocate_device_memory(
+	obj<Device>                   device,
+	const vk::MemoryRequirements& requirements,
+	MemoryPropertyFlags           flags,
+	MemoryResourceType            resource_type);
+
+void free_device_memory(DeviceMemoryImpl& impl, uint32_t allocation_id) VERA_NOEXCEPT;
+
+// flushes the non-coherent atoms covering [offset, offset + size) of mapped memory, no-op for coherent memory
+void flush_device_memory(DeviceMemoryImpl& impl, size_t offset, size_t size);
+
 VERA_NAMESPACE_END
\ No newline at end of file
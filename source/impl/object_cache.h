@@ -0,0 +1,140 @@
+#pragma once
+
+#include "object_impl.h"
+
+#include <condition_variable>
+#include <unordered_map>
+#include <mutex>
+
+VERA_NAMESPACE_BEGIN
+
+// Concurrent cache of core objects by hash value, split into shards locked on their own.
+// Entries do not own their objects, an object removes its entry in its destructor, and entries of
+// objects whose destructor is waiting for the shard lock are treated as missing. acquire() runs
+// the creation of an object once when several threads ask for the same hash, the others wait.
+template <class Object>
+class ObjectCache
+{
+	static constexpr size_t ShardCount = 16;
+
+	struct Shard
+	{
+		std::unordered_map<hash_t, ref<Object>> objects; // null while the object is being created
+		std::condition_variable                 cond;
+		std::mutex                              mutex;
+	};
+
+public:
+	ObjectCache() = default;
+
+	// waits for an object still being created
+	VERA_NODISCARD obj<Object> find(hash_t hash_value)
+	{
+		auto&                        shard = getShard(hash_value);
+		std::unique_lock<std::mutex> lock(shard.mutex);
+
+		while (true) {
+			auto iter = shard.objects.find(hash_value);
+
+			if (iter == shard.objects.end())
+				return {};
+			if (iter->second.get())
+				return try_obj_cast<Object>(iter->second);
+
+			shard.cond.wait(lock);
+		}
+	}
+
+	// false if another live object or one being created has the hash value
+	VERA_NODISCARD bool insert(hash_t hash_value, ref<Object> object)
+	{
+		auto&       shard = getShard(hash_value);
+		obj<Object> existing; // released after the lock, its destructor may erase itself
+
+		std::lock_guard<std::mutex> lock(shard.mutex);
+
+		if (auto iter = shard.objects.find(hash_value); iter != shard.objects.end()) {
+			if (iter->second.get() == object.get())
+				return true;
+			if (!iter->second.get() || (existing = try_obj_cast<Object>(iter->second)))
+				return false;
+		}
+
+		shard.objects.insert_or_assign(hash_value, object);
+
+		return true;
+	}
+
+	// the entry may already belong to an object created while this one was being destroyed
+	void erase(hash_t hash_value, const Object* object) VERA_NOEXCEPT
+	{
+		auto&                       shard = getShard(hash_value);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+
+		if (auto iter = shard.objects.find(hash_value);
+			iter != shard.objects.end() && iter->second.get() == object)
+			shard.objects.erase(iter);
+	}
+
+	// create_func runs without any lock held and must not acquire the same hash value of this cache
+	template <class CreateFunc>
+	VERA_NODISCARD obj<Object> acquire(hash_t hash_value, CreateFunc&& create_func)
+	{
+		auto&       shard = getShard(hash_value);
+		obj<Object> result;
+
+		{
+			std::unique_lock<std::mutex> lock(shard.mutex);
+
+			for (auto iter = shard.objects.find(hash_value); iter != shard.objects.end(); iter = shard.objects.find(hash_value)) {
+				if (iter->second.get()) {
+					if ((result = try_obj_cast<Object>(iter->second)))
+						return result;
+					break;
+				}
+
+				shard.cond.wait(lock);
+			}
+
+			shard.objects.insert_or_assign(hash_value, ref<Object>());
+		}
+
+		try {
+			result = create_func();
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			shard.objects.erase(hash_value);
+			shard.cond.notify_all();
+			throw;
+		}
+
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		shard.objects.insert_or_assign(hash_value, ref<Object>(result));
+		shard.cond.notify_all();
+
+		return result;
+	}
+
+	VERA_NODISCARD bool empty() VERA_NOEXCEPT
+	{
+		for (auto& shard : m_shards) {
+			std::lock_guard<std::mutex> lock(shard.mutex);
+
+			if (!shard.objects.empty())
+				return false;
+		}
+
+		return true;
+	}
+
+private:
+	VERA_NODISCARD Shard& getShard(hash_t hash_value) VERA_NOEXCEPT
+	{
+		// low bits of the hash values are used by the maps of the shards
+		return m_shards[(hash_value >> 56) % ShardCount];
+	}
+
+	Shard m_shards[ShardCount];
+};
+
+VERA_NAMESPACE_END
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "object_impl.h"
+
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+VERA_NAMESPACE_BEGIN
+
+// Worker pool compiling pipelines requested through Pipeline::createAsync, all workers share vkPipelineCache.
+// Threads are only started by the first job, so devices that never compile asynchronously pay nothing.
+class PipelineCompiler
+{
+public:
+	using Job = std::function<void()>;
+
+	PipelineCompiler(uint32_t thread_count) VERA_NOEXCEPT;
+	~PipelineCompiler() VERA_NOEXCEPT;
+
+	void enqueue(Job job);
+
+	// the flag is published under the compiler lock, so a waiter may destroy it as soon as wait() returns
+	void signal(std::atomic<bool>& ready) VERA_NOEXCEPT;
+	void wait(const std::atomic<bool>& ready) VERA_NOEXCEPT;
+
+private:
+	void run() VERA_NOEXCEPT;
+
+	std::vector<std::thread> m_threads;
+	std::deque<Job>          m_jobs;
+	uint32_t                 m_thread_count;
+	bool                     m_stop;
+	std::mutex               m_mutex;
+	std::condition_variable  m_job_cond;
+	std::condition_variable  m_ready_cond;
+};
+
+VERA_NAMESPACE_END
@@ -4,6 +4,8 @@
 
 #include "../../include/vera/core/shader.h"
 #include "../../include/vera/core/pipeline.h"
+#include <exception>
+#include <atomic>
 
 VERA_NAMESPACE_BEGIN
 
@@ -13,11 +15,15 @@ public:
 	obj<Device>              device            = {};
 	obj<PipelineLayout>      pipelineLayout    = {};
 	std::vector<obj<Shader>> shaders           = {};
+	obj<Pipeline>            fallback          = {};
 
 	vk::Pipeline             vkPipeline        = {};
 
 	PipelineBindPoint        pipelineBindPoint = {};
+	hash128_t                pipelineKey       = {};
 	hash_t                   hashValue         = {};
+	std::atomic<bool>        ready             = false; // vkPipeline and compileError are final once set
+	std::exception_ptr       compileError      = {};
 };
 
 static vk::StencilOpState to_vk_stencil_op_state(const StencilOpState& state)
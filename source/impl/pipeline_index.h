@@ -0,0 +1,141 @@
+#pragma once
+
+#include "object_impl.h"
+
+#include "../../include/vera/core/pipeline.h"
+#include "../../include/vera/util/hash.h"
+#include <condition_variable>
+#include <unordered_map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <vector>
+
+VERA_NAMESPACE_BEGIN
+
+class DeviceImpl;
+
+struct PipelineStageRecipe
+{
+	ShaderStageFlagBits stage;
+	hash128_t           codeKey;
+	std::string         entryPoint;
+};
+
+struct PipelineSetLayoutRecipe
+{
+	DescriptorSetLayoutCreateFlags          flags;
+	std::vector<DescriptorSetLayoutBinding> bindings;
+};
+
+struct PipelineVertexBindingRecipe
+{
+	uint32_t                          binding;
+	uint32_t                          stride;
+	bool                              perInstance;
+	std::vector<VertexInputAttribute> attributes;
+};
+
+// Canonical form of a pipeline create info, every optional state is resolved to the value
+// actually handed to the driver so two infos producing the same pipeline serialize identically.
+struct PipelineRecipe
+{
+	PipelineBindPoint                        bindPoint          = {};
+	std::vector<PipelineStageRecipe>         stages             = {};
+	std::vector<PipelineSetLayoutRecipe>     setLayouts         = {};
+	std::vector<PushConstantRange>           pushConstantRanges = {};
+	bool                                     hasVertexInput     = false;
+	std::vector<PipelineVertexBindingRecipe> vertexBindings     = {};
+	PrimitiveInfo                            primitive          = {};
+	uint32_t                                 patchControlPoints = 0;
+	RasterizationInfo                        rasterization      = {};
+	DepthStencilInfo                         depthStencil       = {};
+	ColorBlendInfo                           colorBlend         = {};
+	std::vector<Format>                      colorFormats       = {};
+	std::vector<DynamicState>                dynamicStates      = {};
+
+	VERA_NODISCARD std::vector<uint8_t> serialize() const;
+	VERA_NODISCARD static bool deserialize(PipelineRecipe& recipe, array_view<uint8_t> bytes);
+};
+
+// Builds the driver pipeline of a recipe, modules are given in the order of recipe.stages.
+vk::Pipeline create_vk_pipeline(
+	const DeviceImpl&            device_impl,
+	const PipelineRecipe&        recipe,
+	array_view<vk::ShaderModule> modules,
+	vk::PipelineLayout           layout);
+
+// Persistent list of every pipeline the application has built on this device. On start up the
+// recorded recipes are compiled on a worker thread so Pipeline::create finds them already built.
+class PipelineIndex
+{
+public:
+	PipelineIndex(ref<Device> device, std::string_view path) VERA_NOEXCEPT;
+	~PipelineIndex() VERA_NOEXCEPT;
+
+	void load();
+	void save() VERA_NOEXCEPT;
+
+	void startPrecompile();
+	void stopPrecompile() VERA_NOEXCEPT;
+
+	// takes ownership of a pipeline compiled in the background, waits if it is being compiled right now
+	VERA_NODISCARD vk::Pipeline claim(const hash128_t& key);
+
+	void record(const hash128_t& key, const PipelineRecipe& recipe, array_view<obj<Shader>> shaders);
+
+private:
+	enum class EntryState
+	{
+		Pending,
+		Building,
+		Ready,
+		Claimed
+	};
+
+	struct Entry
+	{
+		hash128_t            key;
+		std::vector<uint8_t> recipe;
+		EntryState           state;
+		vk::Pipeline         pipeline;
+	};
+
+	struct ShaderCode
+	{
+		hash128_t             key;
+		std::vector<uint32_t> spirv;
+		vk::ShaderModule      module;
+	};
+
+	struct SetLayoutEntry
+	{
+		hash128_t               key;
+		vk::DescriptorSetLayout setLayout;
+	};
+
+	struct PipelineLayoutEntry
+	{
+		hash128_t          key;
+		vk::PipelineLayout pipelineLayout;
+	};
+
+	void precompile() VERA_NOEXCEPT;
+	vk::Pipeline build(const PipelineRecipe& recipe);
+
+	ref<Device>                                       m_device;
+	std::string                                       m_path;
+	std::vector<Entry>                                m_entries;
+	std::unordered_map<uint64_t, size_t>              m_entry_map;        // key.low -> entry
+	std::unordered_map<uint64_t, ShaderCode>          m_shaders;          // code key.low -> spir-v
+	std::unordered_map<uint64_t, SetLayoutEntry>      m_set_layouts;      // content key.low -> layout
+	std::unordered_map<uint64_t, PipelineLayoutEntry> m_pipeline_layouts; // content key.low -> layout
+	std::thread                                       m_worker;
+	std::atomic<bool>                                 m_stop;
+	bool                                              m_dirty;
+	std::mutex                                        m_mutex;
+	std::condition_variable                           m_cond;
+};
+
+VERA_NAMESPACE_END
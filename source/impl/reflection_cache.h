@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../../include/vera/util/array_view.h"
+#include "../../include/vera/util/hash.h"
+#include <unordered_map>
+#include <string_view>
+#include <string>
+#include <vector>
+#include <mutex>
+
+VERA_NAMESPACE_BEGIN
+
+// Persistent store of serialized shader reflections keyed by the code key of the shader.
+// A shader whose reflection is found here is never parsed, which is most of the start up cost
+// of an application creating thousands of shader permutations.
+class ReflectionCache
+{
+public:
+	ReflectionCache(std::string_view path) VERA_NOEXCEPT;
+
+	void load();
+	void save() VERA_NOEXCEPT;
+
+	// copies the recorded bytes, a copy keeps them valid while other threads record
+	VERA_NODISCARD bool find(const hash128_t& key, std::vector<uint8_t>& out_bytes) const;
+
+	void record(const hash128_t& key, std::vector<uint8_t>&& bytes);
+
+private:
+	struct Entry
+	{
+		hash128_t            key;
+		std::vector<uint8_t> bytes;
+	};
+
+	std::string                         m_path;
+	std::unordered_map<uint64_t, Entry> m_entries; // key.low -> entry
+	bool                                m_dirty;
+	mutable std::mutex                  m_mutex;
+};
+
+VERA_NAMESPACE_END
@@ -12,6 +12,7 @@ struct RenderContextFrame : RenderFrame
 
 	FrameBuffers        framebuffers = {};
 	obj<CommandStream>  stream       = {};
+	uint64_t            poolFrameKey = {}; // frame of the command pool manager
 };
 
 class RenderContextImpl
@@ -20,6 +20,7 @@ public:
 	std::string_view      entryPointName   = {};
 	ShaderStageFlags      stageFlags       = {};
 	size_t                hashValue        = {};
+	hash128_t             codeKey          = {}; // persistent identity of spirvCode
 };
 
 VERA_NAMESPACE_END
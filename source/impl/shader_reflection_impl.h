@@ -26,6 +26,7 @@ public:
 	array_view<ReflectionSpecConstant>             specConstants      = {};
 	const ReflectionRootNode*                      rootNode           = {};
 	hash_t                                         hashValue          = {};
+	hash128_t                                      codeKey            = {};
 };
 
 VERA_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "object_impl.h"
+
+#include "../../include/vera/core/command_sync.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+VERA_NAMESPACE_BEGIN
+
+// Device owned ring of persistently mapped host memory feeding transfer commands.
+// Copies are gathered into a batch which is recorded into a single command buffer when flushed,
+// ring space of a batch is given back once its fence signals, so uploads only block when the ring runs dry.
+class StagingUploader
+{
+public:
+	StagingUploader(ref<Device> device, size_t ring_size) VERA_NOEXCEPT;
+	~StagingUploader() VERA_NOEXCEPT;
+
+	void uploadTexture(ref<Texture> texture, const void* data, size_t size);
+	// mip levels packed in data, level i starts at level_offsets[i] and is copied to mip level i
+	void uploadTexture(ref<Texture> texture, const void* data, size_t size, array_view<size_t> level_offsets);
+	void uploadBuffer(ref<Buffer> buffer, size_t offset, const void* data, size_t size);
+	void uploadMemory(ref<DeviceMemory> memory, size_t offset, const void* data, size_t size);
+
+	VERA_NODISCARD bool hasPendingUploads() const VERA_NOEXCEPT;
+
+	// submits every copy gathered since the last flush, returns empty sync if there was nothing to do
+	CommandSync flush();
+	void waitIdle();
+
+private:
+	struct StagingRange
+	{
+		vk::Buffer buffer;
+		size_t     offset;
+		void*      mapPtr;
+	};
+
+	struct TextureCopy
+	{
+		ref<Texture>        texture;
+		vk::Buffer          srcBuffer;
+		size_t              srcOffset;
+		std::vector<size_t> levelOffsets;
+	};
+
+	struct BufferCopy
+	{
+		ref<Buffer>    buffer;    // destination, its handle is read when recorded as a resize replaces it
+		vk::Buffer     dstBuffer; // set up front only for memory aliases
+		vk::Buffer     srcBuffer;
+		vk::BufferCopy region;
+	};
+
+	struct Batch
+	{
+		obj<CommandBuffer>           commandBuffer;
+		CommandSync                  sync;
+		std::vector<TextureCopy>     textureCopies;
+		std::vector<BufferCopy>      bufferCopies;
+		std::vector<obj<CoreObject>> resources;       // kept alive until the copies complete
+		std::vector<obj<Buffer>>     overflowBuffers; // uploads larger than the whole ring
+		std::vector<vk::Buffer>      aliasBuffers;    // transfer views of raw device memory
+		size_t                       ringHead;
+		size_t                       ringBytes;
+	};
+
+	StagingRange allocate(size_t size, size_t alignment);
+	bool allocateRing(size_t size, size_t alignment, size_t& out_offset, size_t& out_consumed) VERA_NOEXCEPT;
+	CommandSync submit();
+	void record(Batch& batch);
+	void reclaim(bool wait_oldest);
+	void release(Batch& batch) VERA_NOEXCEPT;
+
+	ref<Device>                     m_device;
+	obj<Buffer>                     m_ring;
+	uint8_t*                        m_ring_ptr;
+	size_t                          m_ring_size;
+	size_t                          m_ring_head;
+	size_t                          m_ring_tail;
+	size_t                          m_ring_used;
+	Batch                           m_pending;
+	std::deque<Batch>               m_in_flight;
+	std::vector<obj<CommandBuffer>> m_free_command_buffers;
+	std::atomic<bool>               m_has_pending;
+	mutable std::mutex              m_mutex;
+};
+
+VERA_NAMESPACE_END
@@ -24,7 +24,10 @@ public:
 	uint32_t             width         = {};
 	uint32_t             height        = {};
 	uint32_t             depth         = {};
+	uint32_t             mipLevels     = {};
 	size_t               size          = {};
+	size_t               memoryOffset  = {};
+	uint32_t             allocationID  = {};
 };
 
 class TextureViewImpl
@@ -3,7 +3,6 @@
 #include "../../include/vera/core/exception.h"
 #include "../../include/vera/core/logger.h"
 #include "../../include/vera/util/static_vector.h"
-#include "../spirv/spirv_reflect.h"
 
 #define MAX_SHADER_STAGE_COUNT 16
 #define INITIAL_MONOTONIC_CHUNK_SIZE VERA_KIB(2)
@@ -158,85 +157,14 @@ static const char* get_shader_stage_string(ShaderStageFlagBits stage)
 	VERA_ERROR_MSG("invalid shader stage");
 }
 
-static DescriptorType to_descriptor_type(SpvReflectDescriptorType type)
+static bool is_unsized_array(const ReflectionArrayTraits& traits)
 {
-	switch (type) {
-	case SPV_REFLECT_DESCRIPTOR_TYPE_SAMPLER:
-		return DescriptorType::Sampler;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
-		return DescriptorType::CombinedTextureSampler;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
-		return DescriptorType::SampledTexture;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_IMAGE:
-		return DescriptorType::StorageTexture;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
-		return DescriptorType::UniformTexelBuffer;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
-		return DescriptorType::StorageTexelBuffer;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
-		return DescriptorType::UniformBuffer;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER:
-		return DescriptorType::StorageBuffer;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
-		return DescriptorType::UniformBufferDynamic;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
-		return DescriptorType::StorageBufferDynamic;
-	case SPV_REFLECT_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
-		return DescriptorType::InputAttachment;
-	}
-
-	VERA_ERROR_MSG("invalid resource type");
-}
-
-static ShaderStageFlagBits to_shader_stage(SpvReflectShaderStageFlagBits stage)
-{
-	switch (stage) {
-	case SPV_REFLECT_SHADER_STAGE_VERTEX_BIT:
-		return ShaderStageFlagBits::Vertex;
-	case SPV_REFLECT_SHADER_STAGE_TESSELLATION_CONTROL_BIT:
-		return ShaderStageFlagBits::TessellationControl;
-	case SPV_REFLECT_SHADER_STAGE_TESSELLATION_EVALUATION_BIT:
-		return ShaderStageFlagBits::TessellationEvaluation;
-	case SPV_REFLECT_SHADER_STAGE_GEOMETRY_BIT:
-		return ShaderStageFlagBits::Geometry;
-	case SPV_REFLECT_SHADER_STAGE_FRAGMENT_BIT:
-		return ShaderStageFlagBits::Fragment;
-	case SPV_REFLECT_SHADER_STAGE_COMPUTE_BIT:
-		return ShaderStageFlagBits::Compute;
-	case SPV_REFLECT_SHADER_STAGE_TASK_BIT_EXT:
-		return ShaderStageFlagBits::Task;
-	case SPV_REFLECT_SHADER_STAGE_MESH_BIT_EXT:
-		return ShaderStageFlagBits::Mesh;
-	case SPV_REFLECT_SHADER_STAGE_RAYGEN_BIT_KHR:
-		return ShaderStageFlagBits::RayGen;
-	case SPV_REFLECT_SHADER_STAGE_ANY_HIT_BIT_KHR:
-		return ShaderStageFlagBits::AnyHit;
-	case SPV_REFLECT_SHADER_STAGE_CLOSEST_HIT_BIT_KHR:
-		return ShaderStageFlagBits::ClosestHit;
-	case SPV_REFLECT_SHADER_STAGE_MISS_BIT_KHR:
-		return ShaderStageFlagBits::Miss;
-	case SPV_REFLECT_SHADER_STAGE_INTERSECTION_BIT_KHR:
-		return ShaderStageFlagBits::Intersection;
-	case SPV_REFLECT_SHADER_STAGE_CALLABLE_BIT_KHR:
-		return ShaderStageFlagBits::Callable;
-	}
-
-	VERA_ERROR_MSG("invalid shader stage");
-}
-
-static bool is_unsized_array(const SpvReflectBindingArrayTraits& traits)
-{
-	return 0 < traits.dims_count && traits.dims[traits.dims_count - 1] <= 1;
+	return !traits.empty() && traits[traits.dims() - 1] <= 1;
 }
 
-static bool is_unsized_array(const SpvReflectArrayTraits& traits)
+static bool is_block_variable(const ReflectionDescriptorBinding& binding)
 {
-	return 0 < traits.dims_count && traits.dims[traits.dims_count - 1] <= 1;
-}
-
-static bool is_block_variable(const SpvReflectDescriptorBinding& binding)
-{
-	return binding.block.name && !(binding.block.members && !binding.block.members->name);
+	return binding.block && !binding.block->members.empty();
 }
 
 static bool is_pc_range_intersect(const PushConstantRange& lhs, const PushConstantRange& rhs)
@@ -246,284 +174,16 @@ static bool is_pc_range_intersect(const PushConstantRange& lhs, const PushConsta
 	return !(lhs_end <= rhs.offset || rhs_end <= lhs.offset);
 }
 
-static uint32_t get_array_stride(const SpvReflectBindingArrayTraits& traits, uint32_t dim)
+static uint32_t get_array_stride(const ReflectionArrayTraits& traits, uint32_t dim)
 {
-	uint32_t result = 1;
+	uint32_t result = traits.stride();
 
-	for (uint32_t i = dim + 1; i < traits.dims_count; ++i)
-		result *= traits.dims[i];
+	for (uint32_t i = dim + 1; i < traits.dims(); ++i)
+		result *= traits[i];
 
 	return result;
 }
 
-static uint32_t get_array_stride(const SpvReflectArrayTraits& traits, uint32_t dim)
-{
-	uint32_t result = traits.stride;
-
-	for (uint32_t i = dim + 1; i < traits.dims_count; ++i)
-		result *= traits.dims[i];
-
-	return result;
-}
-
-static ReflectionPrimitiveType reflect_matrix_type(const SpvReflectBlockVariable& block)
-{
-	if (block.decoration_flags & SPV_REFLECT_DECORATION_ROW_MAJOR) {
-		switch (block.numeric.scalar.width) {
-		case 32:
-			switch (block.numeric.matrix.row_count) {
-			case 2:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::RFloat2x2;
-				case 3: return ReflectionPrimitiveType::RFloat2x3;
-				case 4: return ReflectionPrimitiveType::RFloat2x4;
-				}
-				break;
-			case 3:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::RFloat3x2;
-				case 3: return ReflectionPrimitiveType::RFloat3x3;
-				case 4: return ReflectionPrimitiveType::RFloat3x4;
-				}
-				break;
-			case 4:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::RFloat4x2;
-				case 3: return ReflectionPrimitiveType::RFloat4x3;
-				case 4: return ReflectionPrimitiveType::RFloat4x4;
-				}
-				break;
-			};
-			break;
-		case 64:
-			switch (block.numeric.matrix.row_count) {
-			case 2:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::RDouble2x2;
-				case 3: return ReflectionPrimitiveType::RDouble2x3;
-				case 4: return ReflectionPrimitiveType::RDouble2x4;
-				}
-				break;
-			case 3:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::RDouble3x2;
-				case 3: return ReflectionPrimitiveType::RDouble3x3;
-				case 4: return ReflectionPrimitiveType::RDouble3x4;
-				}
-				break;
-			case 4:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::RDouble4x2;
-				case 3: return ReflectionPrimitiveType::RDouble4x3;
-				case 4: return ReflectionPrimitiveType::RDouble4x4;
-				}
-				break;
-			};
-			break;
-		}
-	} else if (block.decoration_flags & SPV_REFLECT_DECORATION_COLUMN_MAJOR) {
-		switch (block.numeric.scalar.width) {
-		case 32:
-			switch (block.numeric.matrix.row_count) {
-			case 2:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::CFloat2x2;
-				case 3: return ReflectionPrimitiveType::CFloat2x3;
-				case 4: return ReflectionPrimitiveType::CFloat2x4;
-				}
-				break;
-			case 3:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::CFloat3x2;
-				case 3: return ReflectionPrimitiveType::CFloat3x3;
-				case 4: return ReflectionPrimitiveType::CFloat3x4;
-				}
-				break;
-			case 4:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::CFloat4x2;
-				case 3: return ReflectionPrimitiveType::CFloat4x3;
-				case 4: return ReflectionPrimitiveType::CFloat4x4;
-				}
-				break;
-			};
-			break;
-		case 64:
-			switch (block.numeric.matrix.row_count) {
-			case 2:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::CDouble2x2;
-				case 3: return ReflectionPrimitiveType::CDouble2x3;
-				case 4: return ReflectionPrimitiveType::CDouble2x4;
-				}
-				break;
-			case 3:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::CDouble3x2;
-				case 3: return ReflectionPrimitiveType::CDouble3x3;
-				case 4: return ReflectionPrimitiveType::CDouble3x4;
-				}
-				break;
-			case 4:
-				switch (block.numeric.matrix.column_count) {
-				case 2: return ReflectionPrimitiveType::CDouble4x2;
-				case 3: return ReflectionPrimitiveType::CDouble4x3;
-				case 4: return ReflectionPrimitiveType::CDouble4x4;
-				}
-				break;
-			};
-			break;
-		}
-	}
-
-	throw Exception("failed to reflect matrix type");
-}
-
-static ReflectionPrimitiveType reflect_vector_type(const SpvReflectBlockVariable& block)
-{
-	auto type_flags = block.type_description->type_flags;
-
-	if (type_flags & SpvReflectTypeFlagBits::SPV_REFLECT_TYPE_FLAG_FLOAT) {
-		switch (block.numeric.scalar.width) {
-		case 32:
-			switch (block.numeric.vector.component_count) {
-			case 2: return ReflectionPrimitiveType::Float2;
-			case 3: return ReflectionPrimitiveType::Float3;
-			case 4: return ReflectionPrimitiveType::Float4;
-			}
-			break;
-		case 64:
-			switch (block.numeric.vector.component_count) {
-			case 2: return ReflectionPrimitiveType::Double2;
-			case 3: return ReflectionPrimitiveType::Double3;
-			case 4: return ReflectionPrimitiveType::Double4;
-			}
-			break;
-		}
-	} else if (type_flags & SpvReflectTypeFlagBits::SPV_REFLECT_TYPE_FLAG_INT) {
-		if (block.numeric.scalar.signedness) {
-			switch (block.numeric.scalar.width) {
-			case 8:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::Char2;
-				case 3: return ReflectionPrimitiveType::Char3;
-				case 4: return ReflectionPrimitiveType::Char4;
-				}
-				break;
-			case 16:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::Short2;
-				case 3: return ReflectionPrimitiveType::Short3;
-				case 4: return ReflectionPrimitiveType::Short4;
-				}
-				break;
-			case 32:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::Int2;
-				case 3: return ReflectionPrimitiveType::Int3;
-				case 4: return ReflectionPrimitiveType::Int4;
-				}
-				break;
-			case 64:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::Long2;
-				case 3: return ReflectionPrimitiveType::Long3;
-				case 4: return ReflectionPrimitiveType::Long4;
-				}
-				break;
-			}
-		} else {
-			switch (block.numeric.scalar.width) {
-			case 8:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::UChar2;
-				case 3: return ReflectionPrimitiveType::UChar3;
-				case 4: return ReflectionPrimitiveType::UChar4;
-				}
-				break;
-			case 16:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::UShort2;
-				case 3: return ReflectionPrimitiveType::UShort3;
-				case 4: return ReflectionPrimitiveType::UShort4;
-				}
-				break;
-			case 32:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::UInt2;
-				case 3: return ReflectionPrimitiveType::UInt3;
-				case 4: return ReflectionPrimitiveType::UInt4;
-				}
-				break;
-			case 64:
-				switch (block.numeric.vector.component_count) {
-				case 2: return ReflectionPrimitiveType::ULong2;
-				case 3: return ReflectionPrimitiveType::ULong3;
-				case 4: return ReflectionPrimitiveType::ULong4;
-				}
-				break;
-			}
-		}
-	} else if (type_flags & SpvReflectTypeFlagBits::SPV_REFLECT_TYPE_FLAG_BOOL) {
-		switch (block.numeric.scalar.width) {
-		case 2: return ReflectionPrimitiveType::Bool2;
-		case 3: return ReflectionPrimitiveType::Bool3;
-		case 4: return ReflectionPrimitiveType::Bool4;
-		}
-	}
-
-	throw Exception("failed to reflect vector type");
-}
-
-static ReflectionPrimitiveType reflect_float_type(const SpvReflectBlockVariable& block)
-{
-	switch (block.numeric.scalar.width) {
-	case 32: return ReflectionPrimitiveType::Float;
-	case 64: return ReflectionPrimitiveType::Double;
-	}
-
-	throw Exception("failed to reflect float type");
-}
-
-static ReflectionPrimitiveType reflect_int_type(const SpvReflectBlockVariable& block)
-{
-	if (block.numeric.scalar.signedness) {
-		switch (block.numeric.scalar.width) {
-		case 8:  return ReflectionPrimitiveType::Char;
-		case 16: return ReflectionPrimitiveType::Short;
-		case 32: return ReflectionPrimitiveType::Int;
-		case 64: return ReflectionPrimitiveType::Long;
-		}
-	} else {
-		switch (block.numeric.scalar.width) {
-		case 8:  return ReflectionPrimitiveType::UChar;
-		case 16: return ReflectionPrimitiveType::UShort;
-		case 32: return ReflectionPrimitiveType::UInt;
-		case 64: return ReflectionPrimitiveType::ULong;
-		}
-	}
-
-	throw Exception("failed to reflect int type");
-}
-
-static ReflectionPrimitiveType parse_primitive_type(const SpvReflectBlockVariable& block)
-{
-	auto type_flags = block.type_description->type_flags;
-
-	if (type_flags& SPV_REFLECT_TYPE_FLAG_MATRIX)
-		return reflect_matrix_type(block);
-	else if (type_flags & SPV_REFLECT_TYPE_FLAG_VECTOR)
-		return reflect_vector_type(block);
-	else if (type_flags & SPV_REFLECT_TYPE_FLAG_FLOAT)
-		return reflect_float_type(block);
-	else if (type_flags & SPV_REFLECT_TYPE_FLAG_INT)
-		return reflect_int_type(block);
-	else if (type_flags & SPV_REFLECT_TYPE_FLAG_BOOL)
-		return ReflectionPrimitiveType::Bool;
-
-	throw Exception("invalid type flags");
-}
-
 template <class T>
 static T* construct_node(std::pmr::memory_resource* memory)
 {
@@ -547,14 +207,22 @@ static char* construct_string(std::pmr::memory_resource* memory, const char* str
 	return reinterpret_cast<char*>(result);
 }
 
+static char* construct_string(std::pmr::memory_resource* memory, std::string_view str)
+{
+	auto* result = reinterpret_cast<char*>(memory->allocate(str.size() + 1, alignof(char)));
+	std::memcpy(result, str.data(), str.size());
+	result[str.size()] = '\0';
+	return result;
+}
+
 static const ReflectionBlockNode* parse_block_variable(
 	ReflectionContext&             ctx,
-	const SpvReflectBlockVariable& block,
+	const ReflectionBlockVariable& block,
 	const uint32_t                 set,
 	const uint32_t                 binding,
 	const uint32_t                 array_dim = 0
 ) {
-	if (block.array.dims_count != array_dim) {
+	if (block.arrayTraits.dims() != array_dim) {
 		auto* array_node = construct_node<ReflectionArrayNode>(ctx.memory);
 		array_node->type         = ReflectionNodeType::Array;
 		array_node->stageFlags   = ctx.stageFlags;
@@ -562,15 +230,15 @@ static const ReflectionBlockNode* parse_block_variable(
 		array_node->set          = set;
 		array_node->binding      = binding;
 		array_node->offset       = block.offset;
-		array_node->paddedSize   = block.padded_size;
+		array_node->paddedSize   = block.paddedSize;
 		array_node->elementNode  = parse_block_variable(ctx, block, set, binding, array_dim + 1);
-		array_node->elementCount = block.array.dims[array_dim] <= 1 ? UINT32_MAX : block.array.dims[array_dim];
-		array_node->stride       = get_array_stride(block.array, array_dim);
+		array_node->elementCount = block.arrayTraits[array_dim] <= 1 ? UINT32_MAX : block.arrayTraits[array_dim];
+		array_node->stride       = get_array_stride(block.arrayTraits, array_dim);
 
 		return array_node->as<ReflectionBlockNode>();
 	}
 
-	if (block.member_count) {
+	if (!block.members.empty()) {
 		auto* struct_node = construct_node<ReflectionStructNode>(ctx.memory);
 		struct_node->type       = ReflectionNodeType::Struct;
 		struct_node->stageFlags = ctx.stageFlags;
@@ -578,17 +246,16 @@ static const ReflectionBlockNode* parse_block_variable(
 		struct_node->set        = set;
 		struct_node->binding    = binding;
 		struct_node->offset     = block.offset;
-		struct_node->paddedSize = block.padded_size;
+		struct_node->paddedSize = block.paddedSize;
 
 		ReflectionNameMap name_map(ctx.tempMemory);
 
-		uint32_t     member_count = block.member_count;
+		uint32_t     member_count = static_cast<uint32_t>(block.members.size());
 		uint32_t     member_idx   = 0;
 		const auto** member_nodes = construct_array<ReflectionBlockNodePtr>(ctx.memory, member_count);
-		const auto&  last_member  = block.members[member_count - 1];
 
-		for (const auto& member : array_view(block.members, member_count)) {
-			auto* new_node = parse_block_variable(ctx, member, set, binding);
+		for (const auto* member : block.members) {
+			auto* new_node = parse_block_variable(ctx, *member, set, binding);
 
 			member_nodes[member_idx++] = new_node;
 			name_map.insert({ new_node->name, new_node });
@@ -608,22 +275,22 @@ static const ReflectionBlockNode* parse_block_variable(
 	prim_node->set           = set;
 	prim_node->binding       = binding;
 	prim_node->offset        = block.offset;
-	prim_node->paddedSize    = block.padded_size;
-	prim_node->primitiveType = parse_primitive_type(block);
+	prim_node->paddedSize    = block.paddedSize;
+	prim_node->primitiveType = block.primitiveType;
 
 	return prim_node->as<ReflectionBlockNode>();
 }
 
 const ReflectionPushConstantNode* parse_push_constant(
 	ReflectionContext&             ctx,
-	const SpvReflectBlockVariable& block
+	const ReflectionBlockVariable& block
 ) {
 	auto* pc_node = construct_node<ReflectionPushConstantNode>(ctx.memory);
 	pc_node->type       = ReflectionNodeType::PushConstant;
 	pc_node->stageFlags = ctx.stageFlags;
 	pc_node->name       = construct_string(ctx.memory, block.name);
 	pc_node->offset     = block.offset;
-	pc_node->paddedSize = block.padded_size;
+	pc_node->paddedSize = block.paddedSize;
 	pc_node->block      = parse_block_variable(ctx, block, UINT32_MAX, UINT32_MAX)
 		->as<ReflectionStructNode>();
 
@@ -632,11 +299,11 @@ const ReflectionPushConstantNode* parse_push_constant(
 
 static const ReflectionDescriptorNode* parse_descriptor_binding(
 	ReflectionContext&                 ctx,
-	const SpvReflectDescriptorBinding& binding,
+	const ReflectionDescriptorBinding& binding,
 	const uint32_t                     array_dim = 0
 ) {
-	if (array_dim < binding.array.dims_count) {
-		if (array_dim > 1 && is_unsized_array(binding.array))
+	if (array_dim < binding.arrayTraits.dims()) {
+		if (array_dim > 1 && is_unsized_array(binding.arrayTraits))
 			throw Exception("multiple dimension unsized array on descriptor binding is not supported at "
 				SET_BINDING_FMT(binding));
 
@@ -644,11 +311,11 @@ static const ReflectionDescriptorNode* parse_descriptor_binding(
 		array_node->type           = ReflectionNodeType::DescriptorArray;
 		array_node->stageFlags     = ctx.stageFlags;
 		array_node->name           = construct_string(ctx.memory, binding.name);
-		array_node->descriptorType = to_descriptor_type(binding.descriptor_type);
+		array_node->descriptorType = binding.descriptorType;
 		array_node->set            = binding.set;
 		array_node->binding        = binding.binding;
-		array_node->stride         = get_array_stride(binding.array, array_dim);
-		array_node->elementCount   = binding.array.dims[array_dim] <= 1 ? UINT32_MAX : binding.array.dims[array_dim];
+		array_node->stride         = get_array_stride(binding.arrayTraits, array_dim);
+		array_node->elementCount   = binding.arrayTraits[array_dim] <= 1 ? UINT32_MAX : binding.arrayTraits[array_dim];
 		array_node->elementNode    = parse_descriptor_binding(ctx, binding, array_dim + 1);
 
 		return array_node->as<ReflectionDescriptorNode>();
@@ -659,10 +326,10 @@ static const ReflectionDescriptorNode* parse_descriptor_binding(
 		block_node->type           = ReflectionNodeType::DescriptorBlock;
 		block_node->stageFlags     = ctx.stageFlags;
 		block_node->name           = construct_string(ctx.memory, binding.name);
-		block_node->descriptorType = to_descriptor_type(binding.descriptor_type);
+		block_node->descriptorType = binding.descriptorType;
 		block_node->set            = binding.set;
 		block_node->binding        = binding.binding;
-		block_node->block          = parse_block_variable(ctx, binding.block, binding.set, binding.binding)
+		block_node->block          = parse_block_variable(ctx, *binding.block, binding.set, binding.binding)
 			->as<ReflectionStructNode>();
 
 		return block_node->as<ReflectionDescriptorNode>();
@@ -672,7 +339,7 @@ static const ReflectionDescriptorNode* parse_descriptor_binding(
 	desc_node->type           = ReflectionNodeType::Descriptor;
 	desc_node->stageFlags     = ctx.stageFlags;
 	desc_node->name           = construct_string(ctx.memory, binding.name);
-	desc_node->descriptorType = to_descriptor_type(binding.descriptor_type);
+	desc_node->descriptorType = binding.descriptorType;
 	desc_node->set            = binding.set;
 	desc_node->binding        = binding.binding;
 
@@ -680,45 +347,47 @@ static const ReflectionDescriptorNode* parse_descriptor_binding(
 }
 
 static ReflectionRootNode* parse_impl(
-	ReflectionContext&            ctx,
-	const SpvReflectShaderModule& module
+	ReflectionContext&                         ctx,
+	array_view<const ReflectionDescriptorSet*> descriptor_sets,
+	const ReflectionBlockVariable*             push_constant_block
 ) {
-	if (module.entry_point_count != 1)
-		throw Exception("SPIR-V module must have exactly one entry point");
-	if (1 < module.push_constant_block_count)
-		throw Exception("SPIR-V module must have at most one push constant block");
-
 	ReflectionNameMap    name_map(ctx.tempMemory);
 	ReflectionBindingMap binding_map(ctx.tempMemory);
 
-	uint32_t            desc_node_count   = module.descriptor_binding_count;
-	uint32_t            pc_node_count     = module.push_constant_block_count;
-	uint32_t            root_member_count = desc_node_count + pc_node_count;
-	uint32_t            root_member_idx   = 0;
-	const auto**        root_members      = construct_array<ReflectionResourceNodePtr>(ctx.memory, root_member_count);
+	uint32_t            desc_node_count   = 0;
+	uint32_t            pc_node_count     = push_constant_block ? 1 : 0;
 	ReflectionSetRange* set_ranges        = nullptr;
 	uint32_t            set_count         = 0;
 
-	if (desc_node_count > 0) {
-		set_count  = module.descriptor_bindings[desc_node_count - 1].set + 1;
+	for (const auto* set : descriptor_sets)
+		desc_node_count += static_cast<uint32_t>(set->bindings.size());
+
+	uint32_t     root_member_count = desc_node_count + pc_node_count;
+	uint32_t     root_member_idx   = 0;
+	const auto** root_members      = construct_array<ReflectionResourceNodePtr>(ctx.memory, root_member_count);
+
+	// descriptor sets come sorted by set number
+	if (!descriptor_sets.empty()) {
+		set_count  = descriptor_sets.back()->set + 1;
 		set_ranges = construct_array<ReflectionSetRange>(ctx.memory, set_count);
 	}
 
 	auto* root_node = construct_node<ReflectionRootNode>(ctx.memory);
 	root_node->type              = ReflectionNodeType::Root;
-	root_node->stageFlags        = to_shader_stage(module.shader_stage);
+	root_node->stageFlags        = ctx.stageFlags;
 	root_node->targetFlags       = ReflectionTargetFlagBits::Shader;
+	root_node->setCount          = set_count;
 	root_node->descriptorCount   = desc_node_count;
 	root_node->pushConstantCount = pc_node_count;
 	root_node->minSet            = UINT32_MAX;
 	root_node->maxSet            = 0;
 
-	for (const auto& set : array_view(module.descriptor_sets, module.descriptor_set_count)) {
-		const auto* last_binding = set.bindings[set.binding_count - 1];
+	for (const auto* set : descriptor_sets) {
+		const auto* last_binding = set->bindings.back();
 		uint32_t    desc_offset  = root_member_idx;
 
-		for (const auto* binding : array_view(set.bindings, set.binding_count)) {
-			if (binding != last_binding && is_unsized_array(binding->array))
+		for (const auto* binding : set->bindings) {
+			if (binding != last_binding && is_unsized_array(binding->arrayTraits))
 					throw Exception("only last binding of descriptor set can be unsized array at "
 						SET_BINDING_FMT(*binding));
 
@@ -732,19 +401,18 @@ static ReflectionRootNode* parse_impl(
 			});
 		}
 
-		root_node->minSet = std::min(root_node->minSet, set.set);
-		root_node->maxSet = std::max(root_node->maxSet, set.set);
-		set_ranges[set.set] = ReflectionSetRange{
+		root_node->minSet = std::min(root_node->minSet, set->set);
+		root_node->maxSet = std::max(root_node->maxSet, set->set);
+		set_ranges[set->set] = ReflectionSetRange{
 			reinterpret_cast<const ReflectionDescriptorNode* const*>(root_members + desc_offset),
-			set.binding_count
+			set->bindings.size()
 		};
 	}
 
-	if (module.push_constant_blocks) {
-		auto* pc_node = parse_push_constant(ctx, module.push_constant_blocks[0]);
+	if (push_constant_block) {
+		auto* pc_node = parse_push_constant(ctx, *push_constant_block);
 
 		root_members[root_member_idx++] = pc_node->as<ReflectionResourceNode>();
-		root_node->pushConstantCount = 1;
 	}
 	
 	// assign name map with constructed name map
@@ -1324,20 +992,20 @@ static ReflectionRootNode* merge_impl(
 }
 
 const ReflectionRootNode* ReflectionRootNode::create(
-	const spv_reflect::ShaderModule& shader_module,
-	std::pmr::memory_resource*       memory
+	ShaderStageFlags                           stage_flags,
+	array_view<const ReflectionDescriptorSet*> descriptor_sets,
+	const ReflectionBlockVariable*             push_constant_block,
+	std::pmr::memory_resource*                 memory
 ) {
 	std::pmr::monotonic_buffer_resource temp_memory(VERA_KIB(1));
 
-	const SpvReflectShaderModule& module = shader_module.GetShaderModule();
-
 	ReflectionContext ctx = {
 		.memory     = memory,
 		.tempMemory = &temp_memory,
-		.stageFlags = to_shader_stage(module.shader_stage)
+		.stageFlags = stage_flags
 	};
 
-	return parse_impl(ctx, module);
+	return parse_impl(ctx, descriptor_sets, push_constant_block);
 }
 
 const ReflectionRootNode* ReflectionRootNode::merge(array_view<const ReflectionRootNode*> roots, std::pmr::memory_resource* memory)
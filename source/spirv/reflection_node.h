@@ -2,6 +2,7 @@
 
 #include "../../../include/vera/core/enum_types.h"
 #include "../../../include/vera/core/pipeline_layout.h"
+#include "../../../include/vera/core/reflection.h"
 #include "../../../include/vera/util/flat_hash_map.h"
 #include "../../../include/vera/util/array_view.h"
 #include "../../../include/vera/util/range.h"
@@ -10,11 +11,6 @@
 #include <string_view>
 #include <unordered_map>
 
-namespace spv_reflect
-{
-	class ShaderModule;
-}
-
 VERA_NAMESPACE_BEGIN
 
 class ReflectionNode;
@@ -405,8 +401,10 @@ class ReflectionRootNode : public ReflectionNode
 {
 public:
 	static const ReflectionRootNode* create(
-		const spv_reflect::ShaderModule& shader_module,
-		std::pmr::memory_resource*       memory
+		ShaderStageFlags                           stage_flags,
+		array_view<const ReflectionDescriptorSet*> descriptor_sets,
+		const ReflectionBlockVariable*             push_constant_block,
+		std::pmr::memory_resource*                 memory
 	);
 	
 	static const ReflectionRootNode* merge(
@@ -1,77 +1,49 @@
 #include "spirv_parser.h"
 
-#include "../../include/vera/core/logger.h"
-#include "../../include/vera/util/stopwatch.h"
-
 VERA_NAMESPACE_BEGIN
 
-static size_t count_consecutive_op(spv_inst first, spv_inst last, spv::Op op)
+static bool is_constant_op(spv::Op op)
 {
-	size_t count = 0;
-
-	while (first != last && first.op() == op) {
-		++count;
-		++first;
+	switch (op) {
+	case spv::OpConstant:
+	case spv::OpConstantTrue:
+	case spv::OpConstantFalse:
+	case spv::OpSpecConstant:
+	case spv::OpSpecConstantTrue:
+	case spv::OpSpecConstantFalse:
+		return true;
 	}
 
-	return count;
-}
-
-static spv_inst skip_debug_instructions(spv_inst inst, spv_inst last)
-{
-	while (inst != last) {
-		switch (inst.op()) {
-		case spv::Op::OpSourceContinued:
-		case spv::Op::OpSource:
-		case spv::Op::OpSourceExtension:
-		case spv::Op::OpName:
-		case spv::Op::OpMemberName:
-		case spv::Op::OpString:
-		case spv::Op::OpLine:
-		case spv::Op::OpNoLine:
-		case spv::Op::OpModuleProcessed:
-			++inst;
-			break;
-		default:
-			return inst;
-		}
-	}
-	return inst;
-}
-
-static spv_inst skip_annotation_instructions(spv_inst inst, spv_inst last)
-{
-	while (inst != last) {
-		switch (inst.op()) {
-		case spv::Op::OpDecorate:
-		case spv::Op::OpMemberDecorate:
-		case spv::Op::OpDecorationGroup:
-		case spv::Op::OpGroupDecorate:
-		case spv::Op::OpGroupMemberDecorate:
-		case spv::Op::OpDecorateId:
-		case spv::Op::OpDecorateString:
-		case spv::Op::OpMemberDecorateString:
-			++inst;
-			break;
-		default:
-			return inst;
-		}
-	}
-	return inst;
+	return false;
 }
 
 SpvParser::SpvParser() :
-	spirvCode() {}
+	spirvCode(),
+	version(),
+	generatorMagic(0),
+	memoryModel(spv::MemoryModelMax),
+	m_empty_meta(),
+	m_in_function(false) {}
 
 SpvParser::SpvParser(std::vector<uint32_t>&& spirv_code) :
 	spirvStorage(std::move(spirv_code)),
-	spirvCode(spirvStorage)
+	spirvCode(spirvStorage),
+	version(),
+	generatorMagic(0),
+	memoryModel(spv::MemoryModelMax),
+	m_empty_meta(),
+	m_in_function(false)
 {
 	parse();
 }
 
 SpvParser::SpvParser(array_view<uint32_t> spirv_code) :
-	spirvCode(spirv_code)
+	spirvCode(spirv_code),
+	version(),
+	generatorMagic(0),
+	memoryModel(spv::MemoryModelMax),
+	m_empty_meta(),
+	m_in_function(false)
 {
 	parse();
 }
@@ -82,13 +54,12 @@ SpvParser::~SpvParser()
 
 void SpvParser::parse()
 {
-	if (spirvCode[0] != spv::MagicNumber)
-		throw Exception("invalid SPIR-V magic number");
 	if (spirvCode.size() < 5)
 		throw Exception("invalid SPIR-V code size");
+	if (spirvCode[0] != spv::MagicNumber)
+		throw Exception("invalid SPIR-V magic number");
 
 	uint32_t spirv_version = spirvCode[1];
-	uint32_t generator     = spirvCode[2];
 	uint32_t id_bound      = spirvCode[3];
 	
 	version = Version(
@@ -98,201 +69,262 @@ void SpvParser::parse()
 
 	generatorMagic = spirvCode[2];
 
-	StopWatch sw;
-
 	nodes.resize(id_bound);
+	m_metas.resize(id_bound);
 
-	sw.start();
+	const uint32_t* ptr = spirvCode.data() + 5;
+	const uint32_t* end = spirvCode.data() + spirvCode.size();
 
+	while (ptr != end) {
+		spv_inst inst(ptr);
+		uint32_t length = inst.length();
 
-	spv_inst first(spirvCode.data() + 5);
-	spv_inst last(spirvCode.data() + spirvCode.size());
+		if (length == 0 || length > static_cast<size_t>(end - ptr))
+			throw Exception("invalid SPIR-V instruction length {}", length);
 
-	parseNodes(first, last);
+		if (m_in_function)
+			parseFunctionInstruction(inst);
+		else
+			parseInstruction(inst);
 
-	sw.stop();
+		ptr += length;
+	}
 
-	Logger::info("parsing took {:.3f} ms", sw.get_ms());
+	resolveLocalSizeIds();
 }
 
-void SpvParser::parseNodes(spv_inst first, spv_inst last)
+void SpvParser::parseInstruction(spv_inst inst)
 {
-	spv_inst inst = first;
-
-	size_t cap_count = count_consecutive_op(inst, last, spv::Op::OpCapability);
-	capabilities.reserve(cap_count);
-	while (inst != last && inst.op() == spv::Op::OpCapability) {
-		auto capability = inst.get_enum<spv::Capability>(1);
-		capabilities.push_back(capability);
-		++inst;
-	}
-	
-	size_t ext_count = count_consecutive_op(inst, last, spv::Op::OpExtension);
-	extensionNames.reserve(ext_count);
-	while (inst != last && inst.op() == spv::Op::OpExtension) {
-		std::string_view ext_name = inst.get_string(1);
-		extensionNames.push_back(alloc_string(ext_name));
-		++inst;
-	}
-
-	while (inst != last) {
-		switch (inst.op()) {
-		//////// Mode setting section begin ////////
-		case spv::OpExtInstImport: {
-			auto* new_node = alloc<SpvExtInstNode>();
-			new_node->op          = spv::Op::OpExtInstImport;
-			new_node->id          = inst.get_id(1);
-			new_node->extInstName = alloc_string(inst.get_string(2));
-			setNode(new_node);
-		} break;
-		case spv::OpMemoryModel: {
-			memoryModel = inst.get_enum<spv::MemoryModel>(1);
-		} break;
-		case spv::OpEntryPoint: {
-			uint32_t end_off;
-			auto* new_node = alloc<SpvEntryPointNode>();
-			new_node->op             = spv::Op::OpEntryPoint;
-			new_node->executionModel = inst.get_enum<spv::ExecutionModel>(1);
-			new_node->id             = inst.get_id(2);
-			new_node->entryPointName = alloc_string(inst.get_string(3, end_off));
-			new_node->interfaceIds   = inst.get_array<spv::Id>(end_off);
-			setNode(new_node);
-		} break;
-		case spv::OpExecutionMode: {
-
-		} break;
-		case spv::OpExecutionModeId: {
-
-		} break;
-		//////// Mode setting section end ////////
+	switch (inst.op()) {
+	//////// Mode setting section begin ////////
+	case spv::OpCapability: {
+		capabilities.push_back(inst.get_enum<spv::Capability>(1));
+	} break;
+	case spv::OpExtension: {
+		extensionNames.push_back(alloc_string(inst.get_string(1)));
+	} break;
+	case spv::OpExtInstImport: {
+		auto* new_node = createNode<SpvExtInstNode>(spv::OpExtInstImport, inst.get_id(1));
+		new_node->extInstName = alloc_string(inst.get_string(2));
+	} break;
+	case spv::OpMemoryModel: {
+		memoryModel = inst.get_enum<spv::MemoryModel>(2);
+	} break;
+	case spv::OpEntryPoint: {
+		uint32_t end_off;
+		auto* new_node = createNode<SpvEntryPointNode>(spv::OpEntryPoint, inst.get_id(2));
+		new_node->executionModel = inst.get_enum<spv::ExecutionModel>(1);
+		new_node->entryPointName = alloc_string(inst.get_string(3, end_off));
+		new_node->interfaceIds   = inst.get_array<spv::Id>(end_off);
+		entryPoints.push_back(new_node);
+	} break;
+	case spv::OpExecutionMode:
+	case spv::OpExecutionModeId: {
+		auto* entry_node = findNode<SpvEntryPointNode>(inst.get_id(1));
+		auto  mode       = inst.get_enum<spv::ExecutionMode>(2);
+
+		if (entry_node == nullptr || entry_node->op != spv::OpEntryPoint)
+			throw Exception("entry point not found for execution mode");
+
+		if (mode == spv::ExecutionModeLocalSize && inst.length() == 6) {
+			entry_node->localSize[0] = inst.get_u32(3);
+			entry_node->localSize[1] = inst.get_u32(4);
+			entry_node->localSize[2] = inst.get_u32(5);
+		} else if (mode == spv::ExecutionModeLocalSizeId && inst.length() == 6) {
+			entry_node->localSizeIds[0] = inst.get_id(3);
+			entry_node->localSizeIds[1] = inst.get_id(4);
+			entry_node->localSizeIds[2] = inst.get_id(5);
 		}
-		++inst;
-	}
+	} break;
+	//////// Mode setting section end ////////
 
-	spv_inst debug_first      = inst;
-	spv_inst debug_last       = skip_debug_instructions(inst, last);
-	spv_inst annotation_first = debug_last;
-	spv_inst annotation_last  = skip_annotation_instructions(debug_last, last);
-
-	for (inst = annotation_last; inst != last; ++inst) {
-		switch (inst.op()) {
-		case spv::OpTypeVoid: {
-			auto* new_node = alloc<SpvBasicTypeNode>();
-			new_node->op        = spv::Op::OpTypeVoid;
-			new_node->id        = inst.get_id(1);
-			new_node->basicType = SpvBasicType::Void;
-			setTypeNode(new_node);
-		} break;
-		case spv::OpTypeBool: {
-			auto* new_node = alloc<SpvBasicTypeNode>();
-			new_node->op        = spv::Op::OpTypeBool;
-			new_node->id        = inst.get_id(1);
-			new_node->basicType = SpvBasicType::Bool;
-			setTypeNode(new_node);
-		} break;
-		case spv::OpTypeInt: {
-			auto* new_node = alloc<SpvBasicTypeNode>();
-			new_node->op = spv::Op::OpTypeInt;
-			new_node->id = inst.get_id(1);
-			parseIntType(new_node, inst);
-			setTypeNode(new_node);
-		} break;
-		case spv::OpTypeFloat: {
-			auto* new_node = alloc<SpvBasicTypeNode>();
-			new_node->op = spv::Op::OpTypeFloat;
-			new_node->id = inst.get_id(1);
-			parseFloatType(new_node, inst);
-			setTypeNode(new_node);
-		} break;
-		case spv::OpTypeVector: {
-			auto* new_node = alloc<SpvBasicTypeNode>();
-			new_node->op = spv::Op::OpTypeVector;
-			new_node->id = inst.get_id(1);
-			parseVectorType(new_node, inst);
-			setTypeNode(new_node);
-		} break;
-		case spv::OpTypeMatrix: {
-			auto* new_node = alloc<SpvBasicTypeNode>();
-			new_node->op = spv::Op::OpTypeMatrix;
-			new_node->id = inst.get_id(1);
-			parseMatrixType(new_node, inst);
-			setTypeNode(new_node);
-		} break;
-		case spv::OpTypeImage: {
-			auto* new_node = alloc<SpvImageTypeNode>();
-			new_node->op = spv::Op::OpTypeImage;
-			new_node->id = inst.get_id(1);
-			parseImageType(new_node, inst);
-			setTypeNode(new_node);
-		} break;
-		case spv::OpTypeSampler:
-		case spv::OpTypeSampledImage: {
-			auto* new_node = alloc<SpvTypeNode>();
-			new_node->op = spv::Op::OpTypeSampledImage;
-			new_node->id = inst.get_id(1);
-			setTypeNode(new_node);
-		} break;
-		}
-	}
+	//////// Debug section begin ////////
+	case spv::OpName: {
+		getMeta(inst.get_id(1))->name = alloc_string(inst.get_string(2));
+	} break;
+	case spv::OpMemberName: {
+		getMemberMeta(inst.get_id(1), inst.get_u32(2))->name = alloc_string(inst.get_string(3));
+	} break;
+	case spv::OpString: {
+		auto* new_node = createNode<SpvStringNode>(spv::OpString, inst.get_id(1));
+		new_node->string = alloc_string(inst.get_string(2));
+	} break;
+	//////// Debug section end ////////
+
+	//////// Annotation section begin ////////
+	case spv::OpDecorate:
+	case spv::OpMemberDecorate:
+	case spv::OpDecorateId:
+	case spv::OpDecorateString:
+	case spv::OpMemberDecorateString: {
+		setDecoration(inst);
+	} break;
+	case spv::OpDecorationGroup: {
+		(void)createNode<SpvNode>(spv::OpDecorationGroup, inst.get_id(1));
+	} break;
+	case spv::OpGroupDecorate:
+	case spv::OpGroupMemberDecorate: {
+		setGroupDecoration(inst);
+	} break;
+	//////// Annotation section end ////////
 
-	parseDebugSection(debug_first, debug_last);
-	parseAnnotationSection(annotation_first, annotation_last);
+	//////// Type section begin ////////
+	case spv::OpTypeVoid: {
+		auto* new_node = createNode<SpvBasicTypeNode>(spv::OpTypeVoid, inst.get_id(1));
+		new_node->basicType = SpvBasicType::Void;
+		setTypeNode(new_node);
+	} break;
+	case spv::OpTypeBool: {
+		auto* new_node = createNode<SpvBasicTypeNode>(spv::OpTypeBool, inst.get_id(1));
+		new_node->basicType = SpvBasicType::Bool;
+		setTypeNode(new_node);
+	} break;
+	case spv::OpTypeInt: {
+		auto* new_node = createNode<SpvBasicTypeNode>(spv::OpTypeInt, inst.get_id(1));
+		parseIntType(new_node, inst);
+		setTypeNode(new_node);
+	} break;
+	case spv::OpTypeFloat: {
+		auto* new_node = createNode<SpvBasicTypeNode>(spv::OpTypeFloat, inst.get_id(1));
+		parseFloatType(new_node, inst);
+		setTypeNode(new_node);
+	} break;
+	case spv::OpTypeVector: {
+		auto* new_node = createNode<SpvBasicTypeNode>(spv::OpTypeVector, inst.get_id(1));
+		parseVectorType(new_node, inst);
+		setTypeNode(new_node);
+	} break;
+	case spv::OpTypeMatrix: {
+		auto* new_node = createNode<SpvBasicTypeNode>(spv::OpTypeMatrix, inst.get_id(1));
+		parseMatrixType(new_node, inst);
+		setTypeNode(new_node);
+	} break;
+	case spv::OpTypeImage: {
+		auto* new_node = createNode<SpvImageTypeNode>(spv::OpTypeImage, inst.get_id(1));
+		parseImageType(new_node, inst);
+		setTypeNode(new_node);
+	} break;
+	case spv::OpTypeSampler:
+	case spv::OpTypeAccelerationStructureKHR: {
+		setTypeNode(createNode<SpvTypeNode>(inst.op(), inst.get_id(1)));
+	} break;
+	case spv::OpTypeSampledImage: {
+		auto* new_node = createNode<SpvSampledImageTypeNode>(spv::OpTypeSampledImage, inst.get_id(1));
+		new_node->imageTypeId = inst.get_id(2);
+		setTypeNode(new_node);
+	} break;
+	case spv::OpTypeArray:
+	case spv::OpTypeRuntimeArray: {
+		auto* new_node = createNode<SpvArrayTypeNode>(inst.op(), inst.get_id(1));
+		parseArrayType(new_node, inst);
+		setTypeNode(new_node);
+	} break;
+	case spv::OpTypeStruct: {
+		auto* new_node = createNode<SpvStructTypeNode>(spv::OpTypeStruct, inst.get_id(1));
+		parseStructType(new_node, inst);
+		setTypeNode(new_node);
+	} break;
+	case spv::OpTypePointer: {
+		auto* new_node = createNode<SpvPointerTypeNode>(spv::OpTypePointer, inst.get_id(1));
+		new_node->storageClass = inst.get_enum<spv::StorageClass>(2);
+		new_node->typeId       = inst.get_id(3);
+		setTypeNode(new_node);
+	} break;
+	//////// Type section end ////////
+
+	case spv::OpConstant:
+	case spv::OpConstantTrue:
+	case spv::OpConstantFalse:
+	case spv::OpSpecConstant:
+	case spv::OpSpecConstantTrue:
+	case spv::OpSpecConstantFalse: {
+		auto* new_node = createNode<SpvConstantNode>(inst.op(), inst.get_id(2));
+		parseConstant(new_node, inst);
+	} break;
+	case spv::OpVariable: {
+		auto* new_node = createNode<SpvVariableNode>(spv::OpVariable, inst.get_id(2));
+		new_node->typeId       = inst.get_id(1);
+		new_node->storageClass = inst.get_enum<spv::StorageClass>(3);
+		new_node->accessed     = false;
+		variables.push_back(new_node);
+	} break;
+	case spv::OpFunction: {
+		m_in_function = true;
+	} break;
+	}
 }
 
-void SpvParser::parseDebugSection(spv_inst first, spv_inst last)
+// function bodies only matter for which module scope variables they reference
+void SpvParser::parseFunctionInstruction(spv_inst inst)
 {
-	for (spv_inst inst = first; inst != last; ++inst) {
-		switch (inst.op()) {
-		case spv::OpSourceContinued: {
-		} break;
-		case spv::OpSource: {
-
-		} break;
-		case spv::OpSourceExtension: {
-
-		} break;
-		case spv::OpName: {
-			spv::Id          id   = inst.get_id(1);
-			std::string_view name = alloc_string(inst.get_string(2));
-			auto*            node = findNode<SpvNode>(id);
-
-			if (node == nullptr)
-				throw Exception("node not found for name assignment");
-			if (node->meta == nullptr)
-				node->meta = alloc<SpvNodeMeta>();
-
-			node->meta->name = name;
-		} break;
-		case spv::OpString: {
-			auto* new_node   = alloc<SpvStringNode>();
-			new_node->op     = spv::Op::OpString;
-			new_node->id     = inst.get_id(1);
-			new_node->string = alloc_string(inst.get_string(2));
-			setNode(new_node);
-		} break;
-		case spv::OpMemberName: {
-			spv::Id              id         = inst.get_id(1);
-			uint32_t             member_idx = inst.get_u32(2);
-			std::string_view     name       = alloc_string(inst.get_string(3));
-			SpvStructTypeMember& member = findNode<SpvStructTypeNode>(id)->members[member_idx];
-			member.name = name;
-		} break;
-		}
+	switch (inst.op()) {
+	case spv::OpFunctionEnd: {
+		m_in_function = false;
+	} break;
+	case spv::OpStore:
+	case spv::OpAtomicStore: {
+		markAccessed(inst.get_id(1));
+	} break;
+	case spv::OpCopyMemory:
+	case spv::OpCopyMemorySized: {
+		markAccessed(inst.get_id(1));
+		markAccessed(inst.get_id(2));
+	} break;
+	case spv::OpLoad:
+	case spv::OpCopyObject:
+	case spv::OpAccessChain:
+	case spv::OpInBoundsAccessChain:
+	case spv::OpPtrAccessChain:
+	case spv::OpInBoundsPtrAccessChain:
+	case spv::OpImageTexelPointer:
+	case spv::OpArrayLength:
+	case spv::OpAtomicLoad:
+	case spv::OpAtomicExchange:
+	case spv::OpAtomicCompareExchange:
+	case spv::OpAtomicIIncrement:
+	case spv::OpAtomicIDecrement:
+	case spv::OpAtomicIAdd:
+	case spv::OpAtomicISub:
+	case spv::OpAtomicSMin:
+	case spv::OpAtomicUMin:
+	case spv::OpAtomicSMax:
+	case spv::OpAtomicUMax:
+	case spv::OpAtomicAnd:
+	case spv::OpAtomicOr:
+	case spv::OpAtomicXor:
+	case spv::OpAtomicFAddEXT:
+	case spv::OpAtomicFMinEXT:
+	case spv::OpAtomicFMaxEXT: {
+		markAccessed(inst.get_id(3));
+	} break;
+	case spv::OpFunctionCall: {
+		for (uint32_t i = 4; i < inst.length(); ++i)
+			markAccessed(inst.get_id(i));
+	} break;
 	}
 }
 
-void SpvParser::parseAnnotationSection(spv_inst first, spv_inst last)
+void SpvParser::resolveLocalSizeIds()
 {
-	for (spv_inst inst = first; inst != last; ++inst) {
-		switch (inst.op()) {
+	for (auto* entry_node : entryPoints) {
+		for (uint32_t i = 0; i < 3; ++i) {
+			if (entry_node->localSizeIds[i] == 0) continue;
 
+			const auto* const_node = findNode<SpvConstantNode>(entry_node->localSizeIds[i]);
+
+			if (const_node == nullptr || !is_constant_op(const_node->op))
+				throw Exception("constant not found for LocalSizeId");
+
+			entry_node->localSize[i] = const_node->value;
 		}
 	}
 }
 
 void SpvParser::setNode(SpvNode* new_node)
 {
-	VERA_ASSERT_MSG(new_node->id < nodes.size(), "SPIR-V ID is out of range");
+	if (new_node->id >= nodes.size())
+		throw Exception("SPIR-V id {} is out of range", new_node->id);
+
 	VERA_ASSERT_MSG(nodes[new_node->id] == nullptr, "SPIR-V node with the same ID already exists");
 	
 	nodes[new_node->id] = new_node;
@@ -300,38 +332,58 @@ void SpvParser::setNode(SpvNode* new_node)
 
 void SpvParser::setTypeNode(SpvTypeNode* new_node)
 {
-	setNode(new_node);
 	typeNodes.push_back(new_node);
 }
 
+void SpvParser::markAccessed(spv::Id id) VERA_NOEXCEPT
+{
+	if (auto* node = findNode<SpvNode>(id); node && node->op == spv::OpVariable)
+		node->as<SpvVariableNode>()->accessed = true;
+}
+
+SpvNodeMeta* SpvParser::getMeta(spv::Id id)
+{
+	if (id >= m_metas.size())
+		throw Exception("SPIR-V id {} is out of range", id);
+
+	if (m_metas[id] == nullptr)
+		m_metas[id] = alloc<SpvNodeMeta>();
+
+	return m_metas[id];
+}
+
+SpvMemberMeta* SpvParser::getMemberMeta(spv::Id id, uint32_t member_idx)
+{
+	auto* meta = getMeta(id);
+
+	for (auto* member = meta->members; member != nullptr; member = member->next)
+		if (member->index == member_idx)
+			return member;
+
+	// only read while the struct type is parsed
+	auto* new_member = alloc_temp<SpvMemberMeta>();
+	new_member->next  = meta->members;
+	new_member->index = member_idx;
+	meta->members     = new_member;
+
+	return new_member;
+}
+
 void SpvParser::setDecoration(spv_inst inst)
 {
 	spv::Id         id         = inst.get_id(1);
 	uint32_t        off        = inst.op() == spv::OpMemberDecorate || inst.op() == spv::OpMemberDecorateString;
 	spv::Decoration decoration = inst.get_enum<spv::Decoration>(off + 2);
 
-	spv_decoration* deco = nullptr;
-
-	if (off == 0) {
-		auto* node = findNode<SpvNode>(id);
-
-		if (node == nullptr)
-			throw Exception("node not found for decoration");
-		if (node->meta == nullptr)
-			node->meta = alloc<SpvNodeMeta>();
-
-		deco = &node->meta->decoration;
-	} else {
-		auto*    struct_node = findNode<SpvStructTypeNode>(id);
-		uint32_t member_idx  = inst.get_u32(2);
+	if (!spv_decoration::is_tracked(decoration))
+		return;
 
-		if (struct_node == nullptr)
-			throw Exception("struct type node not found for member decoration");
-		if (member_idx >= struct_node->members.size())
-			throw Exception("member index out of range for member decoration");
+	spv_decoration* deco = nullptr;
 
-		deco = &struct_node->members[member_idx].decoration;
-	}
+	if (off == 0)
+		deco = &getMeta(id)->decoration;
+	else
+		deco = &getMemberMeta(id, inst.get_u32(2))->decoration;
 
 	switch (decoration) {
 	case spv::DecorationSpecId:
@@ -396,6 +448,24 @@ void SpvParser::setDecoration(spv_inst inst)
 	}
 }
 
+void SpvParser::setGroupDecoration(spv_inst inst)
+{
+	spv::Id id = inst.get_id(1);
+
+	if (id >= m_metas.size() || m_metas[id] == nullptr)
+		return;
+
+	const auto& group_deco = m_metas[id]->decoration;
+
+	if (inst.op() == spv::OpGroupDecorate) {
+		for (uint32_t i = 2; i < inst.length(); ++i)
+			getMeta(inst.get_id(i))->decoration.merge(group_deco, &memory);
+	} else {
+		for (uint32_t i = 2; i + 1 < inst.length(); i += 2)
+			getMemberMeta(inst.get_id(i), inst.get_u32(i + 1))->decoration.merge(group_deco, &memory);
+	}
+}
+
 void SpvParser::parseIntType(SpvBasicTypeNode* node, spv_inst inst)
 {
 	uint32_t width = inst.get_u32(2);
@@ -640,4 +710,66 @@ void SpvParser::parseImageType(SpvImageTypeNode* node, spv_inst inst)
 		node->accessQualifier = spv::AccessQualifierMax;
 }
 
+void SpvParser::parseArrayType(SpvArrayTypeNode* node, spv_inst inst)
+{
+	node->elementTypeId = inst.get_id(2);
+
+	if (inst.op() == spv::OpTypeRuntimeArray) {
+		node->lengthId    = 0;
+		node->lengthValue = 0;
+		return;
+	}
+
+	const auto* length_node = findNode<SpvConstantNode>(inst.get_id(3));
+
+	if (length_node == nullptr || !is_constant_op(length_node->op))
+		throw Exception("constant not found for array length");
+
+	node->lengthId    = length_node->id;
+	node->lengthValue = length_node->value;
+}
+
+void SpvParser::parseStructType(SpvStructTypeNode* node, spv_inst inst)
+{
+	uint32_t member_count = inst.length() - 2;
+	auto*    members      = alloc<SpvStructTypeMember>(member_count);
+
+	for (uint32_t i = 0; i < member_count; ++i)
+		members[i].id = inst.get_id(i + 2);
+
+	for (auto* member = node->meta->members; member != nullptr; member = member->next) {
+		if (member->index >= member_count)
+			throw Exception("member index out of range for struct type");
+
+		members[member->index].name       = member->name;
+		members[member->index].decoration = member->decoration;
+	}
+
+	node->members = array_view<SpvStructTypeMember>(members, member_count);
+}
+
+void SpvParser::parseConstant(SpvConstantNode* node, spv_inst inst)
+{
+	node->typeId = inst.get_id(1);
+	node->isSpec = inst.op() == spv::OpSpecConstant ||
+		inst.op() == spv::OpSpecConstantTrue ||
+		inst.op() == spv::OpSpecConstantFalse;
+
+	switch (inst.op()) {
+	case spv::OpConstantTrue:
+	case spv::OpSpecConstantTrue:
+		node->value = 1;
+		break;
+	case spv::OpConstantFalse:
+	case spv::OpSpecConstantFalse:
+		node->value = 0;
+		break;
+	default:
+		node->value = inst.length() > 3 ? inst.get_u32(3) : 0;
+	}
+
+	if (node->isSpec)
+		specConstants.push_back(node);
+}
+
 VERA_NAMESPACE_END
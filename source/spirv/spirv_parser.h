@@ -37,8 +37,8 @@ enum class SpvBasicType VERA_ENUM
 	Float16    = 11,	
 	Float32    = 12,
 	Float64    = 13,
-	Float8E4M3 = 12,
-	Float8E5M2 = 13,
+	Float8E4M3 = 14,
+	Float8E5M2 = 15,
 
 	// vector types
 	Bool_2    = MAKE_BASIC_TYPE(Bool, 2, 1),
@@ -321,6 +321,7 @@ class spv_decoration
 	{
 		const deco_node* next;
 		spv::Decoration  deco;
+		uint32_t         count;
 		uint32_t         values[];
 	};
 
@@ -342,13 +343,24 @@ public:
 		m_builtin(spv::BuiltInMax),
 		m_location(0),
 		m_binding(0),
+		m_index(0),
 		m_desc_set(0),
-		m_offset(0) {}
+		m_offset(0),
+		m_alignment(0) {}
+
+	static constexpr size_t npos = SIZE_MAX;
+
+	// decorations without a mask bit are dropped by set and never reported by has
+	VERA_NODISCARD static VERA_INLINE bool is_tracked(spv::Decoration deco) VERA_NOEXCEPT
+	{
+		return deco_index(deco) != npos;
+	}
 
 	template <class... Args>
 	VERA_INLINE void set(spv::Decoration deco) VERA_NOEXCEPT
 	{
-		m_mask.set(deco_index(deco));
+		if (auto index = deco_index(deco); index != npos)
+			m_mask.set(index);
 	}
 
 	VERA_INLINE void set(spv::Decoration deco, std::pmr::memory_resource* memory, uint32_t value_or_id) VERA_NOEXCEPT
@@ -402,17 +414,17 @@ public:
 			auto* new_node = allocate_node(memory, 1);
 			new_node->deco      = deco;
 			new_node->values[0] = value_or_id;
-		}
+		} break;
 		}
 
-		m_mask.set(deco_index(deco));
+		set(deco);
 	}
 
 	VERA_INLINE void set(spv::Decoration deco, std::pmr::memory_resource* memory, spv::BuiltIn builtin) VERA_NOEXCEPT
 	{
 		VERA_ASSERT_MSG(deco == spv::DecorationBuiltIn, "decoration type mismatch");
 		m_builtin = builtin;
-		m_mask.set(deco_index(deco));
+		set(deco);
 	}
 
 	VERA_INLINE void set(spv::Decoration deco, std::pmr::memory_resource* memory, spv::FunctionParameterAttribute func_param_attr) VERA_NOEXCEPT
@@ -421,8 +433,7 @@ public:
 		auto* new_node = allocate_node(memory, 1);
 		new_node->deco      = deco;
 		new_node->values[0] = static_cast<uint32_t>(func_param_attr);
-		m_mask.set(deco_index(deco));
-
+		set(deco);
 	}
 
 	VERA_INLINE void set(spv::Decoration deco, std::pmr::memory_resource* memory, spv::FPRoundingMode fp_rounding_mode) VERA_NOEXCEPT
@@ -431,7 +442,7 @@ public:
 		auto* new_node = allocate_node(memory, 1);
 		new_node->deco      = deco;
 		new_node->values[0] = static_cast<uint32_t>(fp_rounding_mode);
-		m_mask.set(deco_index(deco));
+		set(deco);
 	}
 
 	VERA_INLINE void set(spv::Decoration deco, std::pmr::memory_resource* memory, spv::FPFastMathModeMask fp_fast_math_mode) VERA_NOEXCEPT
@@ -440,7 +451,7 @@ public:
 		auto* new_node = allocate_node(memory, 1);
 		new_node->deco      = deco;
 		new_node->values[0] = static_cast<uint32_t>(fp_fast_math_mode);
-		m_mask.set(deco_index(deco));
+		set(deco);
 	}
 
 	VERA_INLINE void set(spv::Decoration deco, std::pmr::memory_resource* memory, std::string_view name, spv::LinkageType linkage_type) VERA_NOEXCEPT
@@ -449,8 +460,9 @@ public:
 		auto*    new_node = allocate_node(memory, 1 + (name.length() + 4) / 4);
 		new_node->deco      = deco;
 		new_node->values[0] = static_cast<uint32_t>(linkage_type);
-		memcpy(&new_node->values[1], name.data(), name.length() * 4);
-		m_mask.set(deco_index(deco));
+		memcpy(&new_node->values[1], name.data(), name.length());
+		reinterpret_cast<char*>(&new_node->values[1])[name.length()] = '\0';
+		set(deco);
 	}
 
 	VERA_INLINE void set(spv::Decoration deco, std::pmr::memory_resource* memory, std::string_view name) VERA_NOEXCEPT
@@ -458,13 +470,38 @@ public:
 		VERA_ASSERT_MSG(deco == spv::DecorationUserSemantic, "decoration type mismatch");
 		auto*    new_node = allocate_node(memory, (name.length() + 4) / 4);
 		new_node->deco      = deco;
-		memcpy(&new_node->values[0], name.data(), name.length() * 4);
-		m_mask.set(deco_index(deco));
+		memcpy(&new_node->values[0], name.data(), name.length());
+		reinterpret_cast<char*>(&new_node->values[0])[name.length()] = '\0';
+		set(deco);
 	}
 
 	VERA_INLINE bool has(spv::Decoration deco) const VERA_NOEXCEPT
 	{
-		return m_mask.test(deco_index(deco));
+		auto index = deco_index(deco);
+		return index != npos && m_mask.test(index);
+	}
+
+	// applies the decorations of a decoration group, value nodes are copied into memory
+	VERA_INLINE void merge(const spv_decoration& other, std::pmr::memory_resource* memory) VERA_NOEXCEPT
+	{
+		for (auto* node = other.m_head; node != nullptr; node = node->next) {
+			auto* new_node = allocate_node(memory, node->count);
+			new_node->deco = node->deco;
+			memcpy(new_node->values, node->values, sizeof(uint32_t) * node->count);
+		}
+
+		if (other.has(spv::DecorationSpecId))        m_spec_id       = other.m_spec_id;
+		if (other.has(spv::DecorationArrayStride))   m_array_stride  = other.m_array_stride;
+		if (other.has(spv::DecorationMatrixStride))  m_matrix_stride = other.m_matrix_stride;
+		if (other.has(spv::DecorationBuiltIn))       m_builtin       = other.m_builtin;
+		if (other.has(spv::DecorationLocation))      m_location      = other.m_location;
+		if (other.has(spv::DecorationIndex))         m_index         = other.m_index;
+		if (other.has(spv::DecorationBinding))       m_binding       = other.m_binding;
+		if (other.has(spv::DecorationDescriptorSet)) m_desc_set      = other.m_desc_set;
+		if (other.has(spv::DecorationOffset))        m_offset        = other.m_offset;
+		if (other.has(spv::DecorationAlignment))     m_alignment     = other.m_alignment;
+
+		m_mask |= other.m_mask;
 	}
 
 	template <class T>
@@ -574,7 +611,7 @@ public:
 	}
 
 private:
-	VERA_INLINE size_t deco_index(spv::Decoration deco) const VERA_NOEXCEPT
+	static VERA_INLINE size_t deco_index(spv::Decoration deco) VERA_NOEXCEPT
 	{
 		if (deco < 48)
 			return static_cast<size_t>(deco);
@@ -610,16 +647,19 @@ private:
 		case spv::DecorationBindlessImageNV:                 return 75;
 		case spv::DecorationBoundSamplerNV:                  return 76;
 		case spv::DecorationBoundImageNV:                    return 77;
+		case spv::DecorationUserSemantic:                    return 78;
+		case spv::DecorationCounterBuffer:                   return 79;
 		}
 
-		VERA_ERROR_MSG("unsupported decoration value");
+		return npos;
 	}
 
 	VERA_INLINE deco_node* allocate_node(std::pmr::memory_resource* memory, size_t value_count)
 	{
 		auto* ptr = memory->allocate(sizeof(deco_node) + sizeof(uint32_t) * value_count, alignof(deco_node));
 		auto* node = new (ptr) deco_node();
-		node->next = m_head;
+		node->next  = m_head;
+		node->count = static_cast<uint32_t>(value_count);
 
 		m_head = node;
 
@@ -649,19 +689,29 @@ private:
 	uint32_t         m_alignment;
 };
 
+class SpvMemberMeta
+{
+public:
+	SpvMemberMeta*   next;
+	uint32_t         index;
+	std::string_view name;
+	spv_decoration   decoration;
+};
+
 class SpvNodeMeta
 {
 public:
 	std::string_view name;
 	spv_decoration   decoration;
+	SpvMemberMeta*   members; // names and decorations of struct members, most recent first
 };
 
 class SpvNode
 {
 public:
-	spv::Op      op;
-	spv::Id      id;
-	SpvNodeMeta* meta;
+	spv::Op            op;
+	spv::Id            id;
+	const SpvNodeMeta* meta;
 
 	template <class T>
 	VERA_NODISCARD VERA_INLINE const T* as() const VERA_NOEXCEPT
@@ -690,6 +740,8 @@ public:
 	spv::ExecutionModel	executionModel;
 	std::string_view    entryPointName;
 	array_view<spv::Id> interfaceIds;
+	uint32_t            localSize[3];
+	spv::Id             localSizeIds[3]; // LocalSizeId operands, resolved into localSize after parsing
 };
 
 class SpvStringNode : public SpvNode
@@ -727,6 +779,7 @@ public:
 	SpvBasicType basicType;
 };
 
+// OpTypeArray and OpTypeRuntimeArray, runtime arrays have no length
 class SpvArrayTypeNode : public SpvTypeNode
 {
 public:
@@ -746,7 +799,7 @@ public:
 class SpvStructTypeNode : public SpvTypeNode
 {
 public:
-	std::pmr::vector<SpvStructTypeMember> members;
+	array_view<SpvStructTypeMember> members;
 };
 
 class SpvImageTypeNode : public SpvTypeNode
@@ -762,11 +815,39 @@ public:
 	spv::AccessQualifier accessQualifier;
 };
 
+class SpvSampledImageTypeNode : public SpvTypeNode
+{
+public:
+	spv::Id imageTypeId;
+};
+
+class SpvPointerTypeNode : public SpvTypeNode
+{
+public:
+	spv::StorageClass storageClass;
+	spv::Id           typeId;
+};
+
+// scalar constants and specialization constants, wider values keep their low word
+class SpvConstantNode : public SpvNode
+{
+public:
+	spv::Id  typeId;
+	uint32_t value;
+	bool     isSpec;
+};
+
 class SpvVariableNode : public SpvNode
 {
 public:
+	spv::Id           typeId; // pointer type
+	spv::StorageClass storageClass;
+	bool              accessed; // referenced by a function body
 };
 
+// Parses a module in one forward pass. Names and decorations come before the nodes they belong
+// to, so they are collected per id and attached when the node is created. Nodes live in memory,
+// the parser does not run destructors of them.
 class SpvParser
 {
 public:
@@ -777,6 +858,18 @@ public:
 	SpvParser(array_view<uint32_t> spirv_code);
 	~SpvParser();
 
+	template <class T>
+	VERA_NODISCARD VERA_INLINE const T* findNode(spv::Id id) const VERA_NOEXCEPT
+	{
+		return id < nodes.size() ? static_cast<const T*>(nodes[id]) : nullptr;
+	}
+
+	template <class T>
+	VERA_NODISCARD VERA_INLINE T* findNode(spv::Id id) VERA_NOEXCEPT
+	{
+		return id < nodes.size() ? static_cast<T*>(nodes[id]) : nullptr;
+	}
+
 	std::pmr::monotonic_buffer_resource memory;
 	std::pmr::monotonic_buffer_resource tempMemory;
 
@@ -788,16 +881,18 @@ public:
 	std::vector<spv::Capability>        capabilities;
 	std::vector<std::string_view>       extensionNames;
 	spv::MemoryModel                    memoryModel;
-	std::string                         source;
 	std::vector<SpvNode*>               nodes;
 	std::vector<SpvTypeNode*>           typeNodes;
+	std::vector<SpvEntryPointNode*>     entryPoints;
+	std::vector<SpvVariableNode*>       variables; // module scope variables
+	std::vector<SpvConstantNode*>       specConstants;
 
 private:
 	template <class T>
 	VERA_NODISCARD VERA_INLINE T* alloc(size_t count = 1)
 	{
 		auto* ptr = reinterpret_cast<T*>(memory.allocate(sizeof(T) * count, alignof(T)));
-		std::uninitialized_default_construct_n(ptr, count);
+		std::uninitialized_value_construct_n(ptr, count);
 		return ptr;
 	}
 
@@ -805,7 +900,7 @@ private:
 	VERA_NODISCARD VERA_INLINE T* alloc_temp(size_t count = 1)
 	{
 		auto* ptr = reinterpret_cast<T*>(tempMemory.allocate(sizeof(T) * count, alignof(T)));
-		std::uninitialized_default_construct_n(ptr, count);
+		std::uninitialized_value_construct_n(ptr, count);
 		return ptr;
 	}
 
@@ -817,32 +912,43 @@ private:
 		return std::string_view(ptr, str.size());
 	}
 
+	template <class T>
+	VERA_NODISCARD VERA_INLINE T* createNode(spv::Op op, spv::Id id)
+	{
+		auto* new_node = alloc<T>();
+		new_node->op   = op;
+		new_node->id   = id;
+		new_node->meta = id < m_metas.size() && m_metas[id] ? m_metas[id] : &m_empty_meta;
+		setNode(new_node);
+		return new_node;
+	}
+
 	void parse();
-	void parseNodes(spv_inst first, spv_inst last);
-	void parseDebugSection(spv_inst first, spv_inst last);
-	void parseAnnotationSection(spv_inst first, spv_inst last);
+	void parseInstruction(spv_inst inst);
+	void parseFunctionInstruction(spv_inst inst);
+	void resolveLocalSizeIds();
 
 	void setNode(SpvNode* new_node);
 	void setTypeNode(SpvTypeNode* new_node);
+	void markAccessed(spv::Id id) VERA_NOEXCEPT;
 
-	template <class T>
-	VERA_NODISCARD VERA_INLINE const T* findNode(spv::Id id) const VERA_NOEXCEPT
-	{
-		return static_cast<const T*>(nodes[id]);
-	}
-
-	template <class T>
-	VERA_NODISCARD VERA_INLINE T* findNode(spv::Id id) VERA_NOEXCEPT
-	{
-		return static_cast<const T*>(nodes[id]);
-	}
+	SpvNodeMeta* getMeta(spv::Id id);
+	SpvMemberMeta* getMemberMeta(spv::Id id, uint32_t member_idx);
 
 	void setDecoration(spv_inst inst);
+	void setGroupDecoration(spv_inst inst);
 	void parseIntType(SpvBasicTypeNode* node, spv_inst inst);
 	void parseFloatType(SpvBasicTypeNode* node, spv_inst inst);
 	void parseVectorType(SpvBasicTypeNode* node, spv_inst inst);
 	void parseMatrixType(SpvBasicTypeNode* node, spv_inst inst);
 	void parseImageType(SpvImageTypeNode* node, spv_inst inst);
+	void parseArrayType(SpvArrayTypeNode* node, spv_inst inst);
+	void parseStructType(SpvStructTypeNode* node, spv_inst inst);
+	void parseConstant(SpvConstantNode* node, spv_inst inst);
+
+	std::vector<SpvNodeMeta*> m_metas;
+	SpvNodeMeta               m_empty_meta;
+	bool                      m_in_function;
 };
 
-VERA_NAMESPACE_END
+VERA_NAMESPACE_END
\ No newline at end of file
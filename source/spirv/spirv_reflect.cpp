@@ -1,4 +0,0 @@
-//
-// This file exists to force compiling spirv_reflect.c as C++.
-//
-#include "spirv_reflect.c"
\ No newline at end of file
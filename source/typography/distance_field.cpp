@@ -0,0 +1,1189 @@
+#include "distance_field.h"
+
+#include "../../include/vera/graphics/format_traits.h"
+#include "../../include/vera/math/vector_math.h"
+#include "../util/parallel_for.h"
+#include <algorithm>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#define GRID_CELL_SIZE    8  // texels per side of an edge grid cell
+#define GLYPHS_PER_TASK   16
+#define ROWS_PER_TASK     16
+#define CHANNEL_RED       0x1u
+#define CHANNEL_GREEN     0x2u
+#define CHANNEL_BLUE      0x4u
+#define CHANNEL_ALL       0x7u
+#define SIGN_TOLERANCE    0.015625f // distance below which the edge sign may disagree with the row winding
+#define PI                3.14159265358979323846f
+
+VERA_NAMESPACE_BEGIN
+
+struct SignedDistance
+{
+	float distance;
+	float dot;
+};
+
+struct EdgeSegment
+{
+	float2   p0;
+	float2   p1; // same as p0 for lines
+	float2   p2;
+	uint32_t color;
+	uint32_t contour;
+	uint32_t prev;
+	uint32_t next;
+};
+
+// y monotone piece of an edge, a scanline crosses it at most once
+struct WindingSegment
+{
+	float2   p0;
+	float2   p1;
+	float2   p2;
+	uint32_t contour;
+};
+
+struct RowCrossing
+{
+	float    x;
+	float    nextX; // next crossing of the same contour along the row
+	int32_t  direction;
+	uint32_t contour;
+};
+
+struct DistanceShape
+{
+	std::vector<EdgeSegment>    edges;           // stored contour after contour
+	std::vector<WindingSegment> windingSegments;
+	std::vector<int32_t>        windings;        // orientation of every contour
+	std::vector<uint32_t>       cellOffsets;
+	std::vector<uint32_t>       cellEdges;       // edges within reach of each grid cell
+	float2                      origin;          // corner of the top left texel in pixels
+	uint2                       position;
+	uint32_t                    width;
+	uint32_t                    height;
+	uint32_t                    cellColumns;
+	uint32_t                    layer;
+};
+
+static float median(float a, float b, float c)
+{
+	return std::max(std::min(a, b), std::min(std::max(a, b), c));
+}
+
+static float shoelace(const float2& a, const float2& b)
+{
+	return (b.x - a.x) * (a.y + b.y);
+}
+
+static float2 normalize_allow_zero(const float2& v)
+{
+	float len = length(v);
+	return len > 0.f ? v / len : float2(0.f);
+}
+
+static bool compare_signed_distance(const SignedDistance& dist_a, const SignedDistance& dist_b)
+{
+	float da = std::abs(dist_a.distance);
+	float db = std::abs(dist_b.distance);
+
+	return da < db || (da == db && dist_a.dot < dist_b.dot);
+}
+
+static void merge_signed_distance(SignedDistance& dst, const SignedDistance& src)
+{
+	float da = std::abs(dst.distance);
+	float db = std::abs(src.distance);
+
+	if (da > db || (da == db && dst.dot > src.dot))
+		dst = src;
+}
+
+static int32_t solve_quadratic(float x[3], float a, float b, float c)
+{
+	if (a == 0.f || 1e12f * std::abs(a) < std::abs(b)) {
+		if (b == 0.f)
+			return c == 0.f ? -1 : 0;
+
+		x[0] = -c / b;
+		return 1;
+	}
+
+	float dscr = b * b - 4.f * a * c;
+
+	if (0.f < dscr) {
+		float sqrt_dscr = std::sqrt(dscr);
+
+		x[0] = (-b + sqrt_dscr) / (2.f * a);
+		x[1] = (-b - sqrt_dscr) / (2.f * a);
+		return 2;
+	} else if (dscr == 0.f) {
+		x[0] = -b / (2.f * a);
+		return 1;
+	}
+
+	return 0;
+}
+
+static int32_t solve_cubic_normed(float x[3], float a, float b, float c)
+{
+	float a2 = a * a;
+	float q  = (a2 - 3.f * b) / 9.f;
+	float r  = (a * (2.f * a2 - 9.f * b) + 27.f * c) / 54.f;
+	float r2 = r * r;
+	float q3 = q * q * q;
+
+	a /= 3.f;
+
+	if (r2 < q3) {
+		float t = std::clamp(r / std::sqrt(q3), -1.f, 1.f);
+
+		t = std::acos(t);
+		q = -2.f * std::sqrt(q);
+
+		x[0] = q * std::cos(t / 3.f) - a;
+		x[1] = q * std::cos((t + 2.f * PI) / 3.f) - a;
+		x[2] = q * std::cos((t - 2.f * PI) / 3.f) - a;
+		return 3;
+	}
+
+	float u = (r < 0.f ? 1.f : -1.f) * std::cbrt(std::abs(r) + std::sqrt(r2 - q3));
+	float v = u == 0.f ? 0.f : q / u;
+
+	x[0] = (u + v) - a;
+
+	if (u == v || std::abs(u - v) < 1e-5f * std::abs(u + v)) {
+		x[1] = -0.5f * (u + v) - a;
+		return 2;
+	}
+
+	return 1;
+}
+
+static int32_t solve_cubic(float x[3], float a, float b, float c, float d)
+{
+	if (a != 0.f) {
+		float bn = b / a;
+		if (std::abs(bn) < 1e3f)
+			return solve_cubic_normed(x, bn, c / a, d / a);
+	}
+
+	return solve_quadratic(x, b, c, d);
+}
+
+static SignedDistance line_sdf(const float2& p0, const float2& p1, const float2& p, float& param)
+{
+	float2 aq = p - p0;
+	float2 ab = p1 - p0;
+
+	param = dot(aq, ab) / dot(ab, ab);
+
+	float2 eq = 0.5f < param ? p1 - p : p0 - p;
+	float  ed = length(eq);
+
+	if (0.f < param && param < 1.f) {
+		float l  = length(ab);
+		float od = dot(float2(ab.y / l, -ab.x / l), aq);
+
+		if (std::abs(od) < ed)
+			return { od, 0.f };
+	}
+
+	if (cross(aq, ab) < 0.f)
+		ed = -ed;
+
+	return { ed, std::abs(dot(normalize_allow_zero(ab), normalize_allow_zero(eq))) };
+}
+
+static SignedDistance quadratic_sdf(const float2& p0, const float2& p1, const float2& p2, const float2& p, float& param)
+{
+	float2 qa = p0 - p;
+	float2 qb = p2 - p;
+	float2 ab = p1 - p0;
+	float2 br = p2 - p1 - ab;
+
+	float a = dot(br, br);
+	float b = 3.f * dot(ab, br);
+	float c = 2.f * dot(ab, ab) + dot(qa, br);
+	float d = dot(qa, ab);
+
+	float2 ep_dir;
+	float  min_dist;
+	float  dist_a = length(qa);
+	float  dist_b = length(qb);
+
+	if (dist_a < dist_b) {
+		ep_dir   = p1 - p0;
+		min_dist = cross(ep_dir, qa) < 0.f ? -dist_a : dist_a;
+		param    = -dot(qa, ep_dir) / dot(ep_dir, ep_dir);
+	} else {
+		ep_dir   = p2 - p1;
+		min_dist = cross(ep_dir, qb) < 0.f ? -dist_b : dist_b;
+		param    = dot(p - p1, ep_dir) / dot(ep_dir, ep_dir);
+	}
+
+	float   x[3];
+	int32_t solutions = solve_cubic(x, a, b, c, d);
+
+	for (int32_t i = 0; i < solutions; ++i) {
+		float t = x[i];
+
+		if (0.f < t && t < 1.f) {
+			float2 qe   = qa + ab * (2.f * t) + br * (t * t);
+			float  dist = length(qe);
+
+			if (dist <= std::abs(min_dist)) {
+				min_dist = cross(ab + br * t, qe) < 0.f ? -dist : dist;
+				param    = t;
+			}
+		}
+	}
+
+	if (0.f <= param && param <= 1.f)
+		return { min_dist, 0.f };
+	else if (param < 0.5f)
+		return { min_dist, std::abs(dot(normalize_allow_zero(p1 - p0), normalize_allow_zero(qa))) };
+	else
+		return { min_dist, std::abs(dot(normalize_allow_zero(p2 - p1), normalize_allow_zero(qb))) };
+}
+
+static SignedDistance edge_sdf(const EdgeSegment& edge, const float2& p, float& param)
+{
+	if (edge.p0 == edge.p1)
+		return line_sdf(edge.p0, edge.p2, p, param);
+	else
+		return quadratic_sdf(edge.p0, edge.p1, edge.p2, p, param);
+}
+
+static float2 edge_direction0(const EdgeSegment& edge)
+{
+	if (edge.p0 == edge.p1)
+		return normalize_allow_zero(edge.p2 - edge.p0);
+
+	return normalize_allow_zero(edge.p1 - edge.p0);
+}
+
+static float2 edge_direction1(const EdgeSegment& edge)
+{
+	if (edge.p0 == edge.p1 || edge.p1 == edge.p2)
+		return normalize_allow_zero(edge.p2 - edge.p0);
+
+	return normalize_allow_zero(edge.p2 - edge.p1);
+}
+
+static bool get_perpendicular_distance(float& dist, const float2& ep, const float2& edge_dir)
+{
+	float ts = dot(ep, edge_dir);
+
+	if (ts > 0.f) {
+		float perp_dist = cross(ep, edge_dir);
+
+		if (std::abs(perp_dist) < std::abs(dist)) {
+			dist = perp_dist;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// extends the nearest edge past its end points when the point lies beyond them
+static void distance_to_perpendicular_distance(SignedDistance& dist, const EdgeSegment& edge, const float2& p, float param)
+{
+	float2 dir;
+	float2 ep;
+
+	if (param < 0.f) {
+		dir = edge_direction0(edge);
+		ep  = p - edge.p0;
+
+		if (dot(ep, dir) >= 0.f) return;
+	} else if (param > 1.f) {
+		dir = edge_direction1(edge);
+		ep  = p - edge.p2;
+
+		if (dot(ep, dir) <= 0.f) return;
+	} else {
+		return;
+	}
+
+	float perp_dist = cross(ep, dir);
+
+	if (std::abs(perp_dist) <= std::abs(dist.distance)) {
+		dist.distance = perp_dist;
+		dist.dot      = 0.f;
+	}
+}
+
+// true distance of an edge and the perpendicular distances to the corners it shares with its
+// neighbours, computed once and handed to every channel the edge is colored with
+struct EdgeDistance
+{
+	SignedDistance distance;
+	float          param;
+	float          perpendicularDistances[2];
+	uint32_t       perpendicularCount;
+};
+
+static EdgeDistance compute_edge_distance(
+	const EdgeSegment& prev,
+	const EdgeSegment& curr,
+	const EdgeSegment& next,
+	const float2&      p
+) {
+	EdgeDistance result;
+	result.distance           = edge_sdf(curr, p, result.param);
+	result.perpendicularCount = 0;
+
+	float2 ap       = p - curr.p0;
+	float2 bp       = p - curr.p2;
+	float2 a_dir    = edge_direction0(curr);
+	float2 b_dir    = edge_direction1(curr);
+	float2 prev_dir = edge_direction1(prev);
+	float2 next_dir = edge_direction0(next);
+	float  add      = dot(ap, normalize_allow_zero(prev_dir + a_dir));
+	float  bdd      = -dot(bp, normalize_allow_zero(b_dir + next_dir));
+
+	if (add > 0.f) {
+		float perp_dist = result.distance.distance;
+
+		if (get_perpendicular_distance(perp_dist, ap, -a_dir))
+			result.perpendicularDistances[result.perpendicularCount++] = -perp_dist;
+	}
+
+	if (bdd > 0.f) {
+		float perp_dist = result.distance.distance;
+
+		if (get_perpendicular_distance(perp_dist, bp, b_dir))
+			result.perpendicularDistances[result.perpendicularCount++] = perp_dist;
+	}
+
+	return result;
+}
+
+struct TrueDistanceSelector
+{
+	typedef float DistanceType;
+
+	SignedDistance minDistance;
+
+	void reset()
+	{
+		minDistance = { -FLT_MAX, 0.f };
+	}
+
+	void addEdge(const EdgeSegment& prev, const EdgeSegment& curr, const EdgeSegment& next, const float2& p)
+	{
+		float param;
+		merge_signed_distance(minDistance, edge_sdf(curr, p, param));
+	}
+
+	void setFarDistance(float dist)
+	{
+		minDistance = { dist, 0.f };
+	}
+
+	void merge(const TrueDistanceSelector& rhs)
+	{
+		merge_signed_distance(minDistance, rhs.minDistance);
+	}
+
+	float distance(const float2& p) const
+	{
+		return minDistance.distance;
+	}
+};
+
+struct PerpendicularSelector
+{
+	typedef float DistanceType;
+
+	SignedDistance     minTrueDistance;
+	const EdgeSegment* nearEdge;
+	float              nearEdgeParam;
+	float              minNegativePerpendicularDistance;
+	float              minPositivePerpendicularDistance;
+
+	void reset()
+	{
+		minTrueDistance                  = { -FLT_MAX, 0.f };
+		nearEdge                         = nullptr;
+		nearEdgeParam                    = 0.f;
+		minNegativePerpendicularDistance = -FLT_MAX;
+		minPositivePerpendicularDistance = FLT_MAX;
+	}
+
+	void addEdgeDistance(const EdgeSegment& edge, const EdgeDistance& dist)
+	{
+		if (compare_signed_distance(dist.distance, minTrueDistance)) {
+			minTrueDistance = dist.distance;
+			nearEdge        = &edge;
+			nearEdgeParam   = dist.param;
+		}
+
+		for (uint32_t i = 0; i < dist.perpendicularCount; ++i) {
+			float perp_dist = dist.perpendicularDistances[i];
+
+			if (perp_dist <= 0.f && perp_dist > minNegativePerpendicularDistance)
+				minNegativePerpendicularDistance = perp_dist;
+			if (perp_dist >= 0.f && perp_dist < minPositivePerpendicularDistance)
+				minPositivePerpendicularDistance = perp_dist;
+		}
+	}
+
+	void addEdge(const EdgeSegment& prev, const EdgeSegment& curr, const EdgeSegment& next, const float2& p)
+	{
+		addEdgeDistance(curr, compute_edge_distance(prev, curr, next, p));
+	}
+
+	void setFarDistance(float dist)
+	{
+		minTrueDistance                  = { dist, 0.f };
+		nearEdge                         = nullptr;
+		nearEdgeParam                    = 0.f;
+		minNegativePerpendicularDistance = dist < 0.f ? dist : -FLT_MAX;
+		minPositivePerpendicularDistance = dist > 0.f ? dist : FLT_MAX;
+	}
+
+	void merge(const PerpendicularSelector& rhs)
+	{
+		if (compare_signed_distance(rhs.minTrueDistance, minTrueDistance)) {
+			minTrueDistance = rhs.minTrueDistance;
+			nearEdge        = rhs.nearEdge;
+			nearEdgeParam   = rhs.nearEdgeParam;
+		}
+
+		minNegativePerpendicularDistance = std::max(minNegativePerpendicularDistance, rhs.minNegativePerpendicularDistance);
+		minPositivePerpendicularDistance = std::min(minPositivePerpendicularDistance, rhs.minPositivePerpendicularDistance);
+	}
+
+	float distance(const float2& p) const
+	{
+		float min_dist =
+			minTrueDistance.distance < 0.f ?
+			minNegativePerpendicularDistance :
+			minPositivePerpendicularDistance;
+
+		if (nearEdge) {
+			SignedDistance dist = minTrueDistance;
+
+			distance_to_perpendicular_distance(dist, *nearEdge, p, nearEdgeParam);
+
+			if (std::abs(dist.distance) < std::abs(min_dist))
+				min_dist = dist.distance;
+		}
+
+		return min_dist;
+	}
+};
+
+struct MultiSelector
+{
+	typedef float3 DistanceType;
+
+	PerpendicularSelector r;
+	PerpendicularSelector g;
+	PerpendicularSelector b;
+
+	void reset()
+	{
+		r.reset();
+		g.reset();
+		b.reset();
+	}
+
+	void addEdge(const EdgeSegment& prev, const EdgeSegment& curr, const EdgeSegment& next, const float2& p)
+	{
+		const EdgeDistance dist = compute_edge_distance(prev, curr, next, p);
+
+		if (curr.color & CHANNEL_RED)   r.addEdgeDistance(curr, dist);
+		if (curr.color & CHANNEL_GREEN) g.addEdgeDistance(curr, dist);
+		if (curr.color & CHANNEL_BLUE)  b.addEdgeDistance(curr, dist);
+	}
+
+	void setFarDistance(float dist)
+	{
+		r.setFarDistance(dist);
+		g.setFarDistance(dist);
+		b.setFarDistance(dist);
+	}
+
+	void merge(const MultiSelector& rhs)
+	{
+		r.merge(rhs.r);
+		g.merge(rhs.g);
+		b.merge(rhs.b);
+	}
+
+	float3 distance(const float2& p) const
+	{
+		return float3(r.distance(p), g.distance(p), b.distance(p));
+	}
+};
+
+struct MultiTrueSelector : public MultiSelector
+{
+	typedef float4 DistanceType;
+
+	float4 distance(const float2& p) const
+	{
+		SignedDistance true_dist = r.minTrueDistance;
+
+		if (compare_signed_distance(g.minTrueDistance, true_dist))
+			true_dist = g.minTrueDistance;
+		if (compare_signed_distance(b.minTrueDistance, true_dist))
+			true_dist = b.minTrueDistance;
+
+		return float4(r.distance(p), g.distance(p), b.distance(p), true_dist.distance);
+	}
+};
+
+static float resolve_distance(float dist)
+{
+	return dist;
+}
+
+static float resolve_distance(const float3& dist)
+{
+	return median(dist.x, dist.y, dist.z);
+}
+
+static float resolve_distance(const float4& dist)
+{
+	return median(dist.x, dist.y, dist.z);
+}
+
+static float saturate_channel(float dist, float outside_dist)
+{
+	return std::abs(dist) < std::abs(outside_dist) ? dist : outside_dist;
+}
+
+// Texels out of reach of every binned edge, or whose distance passes the range, take the
+// saturated distance signed by the scanline winding, so the grid never flips a sign.
+static void saturate_distance(float& dist, float outside_dist)
+{
+	dist = saturate_channel(dist, outside_dist);
+}
+
+static void saturate_distance(float3& dist, float outside_dist)
+{
+	if (std::abs(resolve_distance(dist)) >= std::abs(outside_dist)) {
+		dist = float3(outside_dist);
+	} else {
+		dist.x = saturate_channel(dist.x, outside_dist);
+		dist.y = saturate_channel(dist.y, outside_dist);
+		dist.z = saturate_channel(dist.z, outside_dist);
+	}
+}
+
+static void saturate_distance(float4& dist, float outside_dist)
+{
+	if (std::abs(resolve_distance(dist)) >= std::abs(outside_dist)) {
+		dist = float4(outside_dist);
+	} else {
+		dist.x = saturate_channel(dist.x, outside_dist);
+		dist.y = saturate_channel(dist.y, outside_dist);
+		dist.z = saturate_channel(dist.z, outside_dist);
+		dist.w = saturate_channel(dist.w, outside_dist);
+	}
+}
+
+static void write_texel(uint8_t* row, uint32_t x, float dist, float range)
+{
+	float value = std::clamp(0.5f + dist / (2.f * range), 0.f, 1.f);
+	row[x] = static_cast<uint8_t>(value * 255.f + 0.5f);
+}
+
+static void write_texel(uint8_t* row, uint32_t x, const float3& dist, float range)
+{
+	float* texel = reinterpret_cast<float*>(row) + 4 * static_cast<size_t>(x);
+	texel[0] = dist.x;
+	texel[1] = dist.y;
+	texel[2] = dist.z;
+	texel[3] = 1.f;
+}
+
+static void write_texel(uint8_t* row, uint32_t x, const float4& dist, float range)
+{
+	float* texel = reinterpret_cast<float*>(row) + 4 * static_cast<size_t>(x);
+	texel[0] = dist.x;
+	texel[1] = dist.y;
+	texel[2] = dist.z;
+	texel[3] = dist.w;
+}
+
+static bool decode_glyph_point(float2& point, uint32_t& color, bool multi_channel)
+{
+	uint32_t float_bits_x = std::bit_cast<uint32_t>(point.x);
+	uint32_t float_bits_y = std::bit_cast<uint32_t>(point.y);
+
+	if (multi_channel) {
+		point.x = std::bit_cast<float>(float_bits_x & 0xfffffffc);
+		point.y = std::bit_cast<float>(float_bits_y & 0xfffffffc);
+		color   =
+			(float_bits_x & 0x2u ? CHANNEL_RED   : 0x0u) |
+			(float_bits_y & 0x1u ? CHANNEL_GREEN : 0x0u) |
+			(float_bits_y & 0x2u ? CHANNEL_BLUE  : 0x0u);
+	} else {
+		point.x = std::bit_cast<float>(float_bits_x & 0xfffffffe);
+		color   = CHANNEL_ALL;
+	}
+
+	return float_bits_x & 0x1u;
+}
+
+static void push_edge(DistanceShape& shape, EdgeSegment edge, float& winding_score)
+{
+	// repeated points would leave a zero length edge without a direction
+	if (edge.p0 == edge.p2 && edge.p1 == edge.p0) return;
+
+	if (edge.p1 == edge.p2)
+		edge.p1 = edge.p0;
+
+	edge.contour   = static_cast<uint32_t>(shape.windings.size());
+	winding_score += shoelace(edge.p0, edge.p2);
+
+	shape.edges.push_back(edge);
+}
+
+// Decodes the glyph stream the same way the mesh shaders walk it. SDF streams leave every contour
+// open, multi channel streams repeat the first point to close it.
+static void decode_shape(
+	DistanceShape&            shape,
+	array_view<SDFGlyphPoint> glyph_points,
+	uint32_t                  storage_offset,
+	float                     scale,
+	bool                      multi_channel
+) {
+	const float end_marker = static_cast<float>(FLOAT_INF);
+
+	size_t point_idx = storage_offset;
+	bool   end_glyph = false;
+
+	shape.edges.clear();
+	shape.windings.clear();
+
+	while (!end_glyph && point_idx < glyph_points.size()) {
+		EdgeSegment edge          = {};
+		float2      start         = {};
+		float       winding_score = 0.f;
+		uint32_t    first_edge    = static_cast<uint32_t>(shape.edges.size());
+		uint32_t    state         = 0;
+
+		while (point_idx < glyph_points.size()) {
+			float2   gp = glyph_points[point_idx++];
+			uint32_t color;
+
+			if (gp.x == end_marker) {
+				end_glyph = gp.y == end_marker;
+				break;
+			}
+
+			bool on_curve = decode_glyph_point(gp, color, multi_channel);
+			gp *= scale;
+
+			switch (state) {
+			case 0: // starting point
+				edge.p0    = gp;
+				edge.color = color;
+				start      = gp;
+				state      = 1;
+				break;
+			case 1: // previous point is on-curve
+				if (on_curve) {
+					edge.p1 = edge.p0;
+					edge.p2 = gp;
+					push_edge(shape, edge, winding_score);
+					edge.p0    = gp;
+					edge.color = color;
+				} else {
+					edge.p1 = gp;
+					state   = 2;
+				}
+				break;
+			case 2: // previous point is off-curve
+				if (on_curve) {
+					edge.p2 = gp;
+					push_edge(shape, edge, winding_score);
+					edge.p0    = gp;
+					edge.color = color;
+					state      = 1;
+				} else {
+					float2 mid = (edge.p1 + gp) * 0.5f;
+
+					edge.p2 = mid;
+					push_edge(shape, edge, winding_score);
+					edge.p0    = mid;
+					edge.p1    = gp;
+					edge.color = color;
+				}
+				break;
+			}
+		}
+
+		if (!multi_channel && state != 0) {
+			if (state == 1)
+				edge.p1 = edge.p0;
+
+			edge.p2 = start;
+			push_edge(shape, edge, winding_score);
+		}
+
+		const uint32_t last_edge = static_cast<uint32_t>(shape.edges.size());
+
+		if (first_edge == last_edge) continue;
+
+		for (uint32_t i = first_edge; i < last_edge; ++i) {
+			shape.edges[i].prev = i == first_edge ? last_edge - 1 : i - 1;
+			shape.edges[i].next = i + 1 == last_edge ? first_edge : i + 1;
+		}
+
+		shape.windings.push_back(winding_score > 0.f ? 1 : (winding_score < 0.f ? -1 : 0));
+	}
+}
+
+static void push_winding_segment(DistanceShape& shape, const float2& p0, const float2& p1, const float2& p2, uint32_t contour)
+{
+	if (p0.y != p2.y)
+		shape.windingSegments.push_back(WindingSegment{ p0, p1, p2, contour });
+}
+
+// splits quadratics at their vertical extremum so every piece is crossed at most once per row
+static void build_winding_segments(DistanceShape& shape)
+{
+	shape.windingSegments.clear();
+
+	for (const auto& edge : shape.edges) {
+		if (edge.p0 == edge.p1) {
+			push_winding_segment(shape, edge.p0, (edge.p0 + edge.p2) * 0.5f, edge.p2, edge.contour);
+			continue;
+		}
+
+		float denom = edge.p0.y - 2.f * edge.p1.y + edge.p2.y;
+		float t     = denom != 0.f ? (edge.p0.y - edge.p1.y) / denom : -1.f;
+
+		if (0.f < t && t < 1.f) {
+			float2 q0  = lerp(edge.p0, edge.p1, t);
+			float2 q1  = lerp(edge.p1, edge.p2, t);
+			float2 mid = lerp(q0, q1, t);
+
+			push_winding_segment(shape, edge.p0, q0, mid, edge.contour);
+			push_winding_segment(shape, mid, q1, edge.p2, edge.contour);
+		} else {
+			push_winding_segment(shape, edge.p0, edge.p1, edge.p2, edge.contour);
+		}
+	}
+}
+
+// Bins every edge into the grid cells its control box reaches after growing it by the radius,
+// a texel then finds every edge closer than the radius in its own cell.
+static void build_edge_grid(DistanceShape& shape, float radius)
+{
+	const uint32_t cell_columns = (shape.width + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE;
+	const uint32_t cell_rows    = (shape.height + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE;
+	const float    inv_cell     = 1.f / static_cast<float>(GRID_CELL_SIZE);
+
+	shape.cellColumns = cell_columns;
+	shape.cellOffsets.assign(static_cast<size_t>(cell_columns) * cell_rows + 1, 0);
+
+	auto for_each_cell = [&](const EdgeSegment& edge, auto&& func) {
+		float min_x = std::min({ edge.p0.x, edge.p1.x, edge.p2.x }) - shape.origin.x - radius;
+		float max_x = std::max({ edge.p0.x, edge.p1.x, edge.p2.x }) - shape.origin.x + radius;
+		float min_y = shape.origin.y - std::max({ edge.p0.y, edge.p1.y, edge.p2.y }) - radius;
+		float max_y = shape.origin.y - std::min({ edge.p0.y, edge.p1.y, edge.p2.y }) + radius;
+
+		if (max_x < 0.f || max_y < 0.f) return;
+		if (min_x >= static_cast<float>(shape.width) || min_y >= static_cast<float>(shape.height)) return;
+
+		uint32_t col_begin = static_cast<uint32_t>(std::max(min_x, 0.f) * inv_cell);
+		uint32_t col_end   = std::min(cell_columns - 1, static_cast<uint32_t>(max_x * inv_cell));
+		uint32_t row_begin = static_cast<uint32_t>(std::max(min_y, 0.f) * inv_cell);
+		uint32_t row_end   = std::min(cell_rows - 1, static_cast<uint32_t>(max_y * inv_cell));
+
+		for (uint32_t row = row_begin; row <= row_end; ++row)
+			for (uint32_t col = col_begin; col <= col_end; ++col)
+				func(row * cell_columns + col);
+	};
+
+	for (const auto& edge : shape.edges)
+		for_each_cell(edge, [&](uint32_t cell) { shape.cellOffsets[cell + 1]++; });
+
+	for (size_t i = 1; i < shape.cellOffsets.size(); ++i)
+		shape.cellOffsets[i] += shape.cellOffsets[i - 1];
+
+	std::vector<uint32_t> cursors(shape.cellOffsets.begin(), shape.cellOffsets.end() - 1);
+	shape.cellEdges.resize(shape.cellOffsets.back());
+
+	// edges go in by index, so the edges of a contour stay adjacent within every cell
+	for (uint32_t i = 0; i < static_cast<uint32_t>(shape.edges.size()); ++i)
+		for_each_cell(shape.edges[i], [&](uint32_t cell) { shape.cellEdges[cursors[cell]++] = i; });
+}
+
+static float solve_monotone_crossing(const WindingSegment& seg, float y)
+{
+	float a = seg.p0.y - 2.f * seg.p1.y + seg.p2.y;
+	float b = 2.f * (seg.p1.y - seg.p0.y);
+	float c = seg.p0.y - y;
+	float t;
+
+	if (std::abs(a) <= 1e-6f * std::abs(b)) {
+		t = -c / b;
+	} else {
+		float dscr = std::sqrt(std::max(b * b - 4.f * a * c, 0.f));
+		float q    = -0.5f * (b + std::copysign(dscr, b));
+		float t0   = q / a;
+
+		t = (-1e-4f <= t0 && t0 <= 1.f + 1e-4f) || q == 0.f ? t0 : c / q;
+	}
+
+	return std::clamp(t, 0.f, 1.f);
+}
+
+struct RowState
+{
+	std::vector<RowCrossing> crossings;
+	std::vector<int32_t>     contourWindings; // winding of every contour left of the texel
+	std::vector<float>       contourLeftX;
+	std::vector<float>       contourRightX;
+	std::vector<uint32_t>    enclosing;       // contours with a non zero winding at the texel
+};
+
+template <class Selector>
+struct DistanceScratch : public RowState
+{
+	typedef typename Selector::DistanceType DistanceType;
+
+	std::vector<Selector>     selectors; // indexed by contour
+	std::vector<DistanceType> distances; // indexed like contours
+	std::vector<uint32_t>     contours;  // contours taking part in the texel
+	std::vector<uint32_t>     stamps;    // texel a contour was last added for
+	uint32_t                  stamp;
+};
+
+static void collect_crossings(RowState& state, const DistanceShape& shape, float y)
+{
+	state.crossings.clear();
+	state.enclosing.clear();
+	std::fill(VERA_SPAN(state.contourWindings), 0);
+
+	for (const auto& seg : shape.windingSegments) {
+		float y_min = std::min(seg.p0.y, seg.p2.y);
+		float y_max = std::max(seg.p0.y, seg.p2.y);
+
+		if (y < y_min || y_max <= y) continue;
+
+		auto& crossing = state.crossings.emplace_back();
+		crossing.x         = quadratic(seg.p0, seg.p1, seg.p2, solve_monotone_crossing(seg, y)).x;
+		crossing.direction = seg.p2.y > seg.p0.y ? 1 : -1;
+		crossing.contour   = seg.contour;
+	}
+
+	std::sort(VERA_SPAN(state.crossings), [](const auto& lhs, const auto& rhs) {
+		return lhs.x < rhs.x;
+	});
+
+	std::fill(VERA_SPAN(state.contourRightX), FLT_MAX);
+
+	for (auto it = state.crossings.rbegin(); it != state.crossings.rend(); ++it) {
+		it->nextX                         = state.contourRightX[it->contour];
+		state.contourRightX[it->contour] = it->x;
+	}
+}
+
+static void advance_crossing(RowState& state, const RowCrossing& crossing)
+{
+	int32_t&   winding  = state.contourWindings[crossing.contour];
+	const bool enclosed = winding != 0;
+
+	winding += crossing.direction;
+
+	state.contourLeftX[crossing.contour]  = crossing.x;
+	state.contourRightX[crossing.contour] = crossing.nextX;
+
+	if (!enclosed && winding != 0)
+		state.enclosing.push_back(crossing.contour);
+	else if (enclosed && winding == 0)
+		state.enclosing.erase(std::find(VERA_SPAN(state.enclosing), crossing.contour));
+}
+
+// Resolves overlapping contours the way the mesh shaders do over the contours near the texel and
+// the far ones enclosing it. Far contours not enclosing the texel only matter past the range.
+template <class Selector>
+static typename Selector::DistanceType combine_contours(
+	DistanceScratch<Selector>& scratch,
+	const DistanceShape&       shape,
+	const float2&              p
+) {
+	typedef typename Selector::DistanceType DistanceType;
+
+	Selector shape_selector;
+	Selector inner_selector;
+	Selector outer_selector;
+
+	shape_selector.reset();
+	inner_selector.reset();
+	outer_selector.reset();
+
+	const uint32_t count = static_cast<uint32_t>(scratch.contours.size());
+
+	for (uint32_t i = 0; i < count; ++i) {
+		const Selector& selector = scratch.selectors[scratch.contours[i]];
+		const int32_t   winding  = shape.windings[scratch.contours[i]];
+
+		scratch.distances[i] = selector.distance(p);
+		shape_selector.merge(selector);
+
+		float dist = resolve_distance(scratch.distances[i]);
+
+		if (winding > 0 && dist >= 0.f)
+			inner_selector.merge(selector);
+		if (winding < 0 && dist <= 0.f)
+			outer_selector.merge(selector);
+	}
+
+	DistanceType shape_dist  = shape_selector.distance(p);
+	DistanceType inner_dist  = inner_selector.distance(p);
+	DistanceType outer_dist  = outer_selector.distance(p);
+	DistanceType result_dist = shape_dist;
+	float        inner       = resolve_distance(inner_dist);
+	float        outer       = resolve_distance(outer_dist);
+	int32_t      winding     = 0;
+
+	if (inner >= 0.f && std::abs(inner) <= std::abs(outer)) {
+		result_dist = inner_dist;
+		winding     = 1;
+
+		for (uint32_t i = 0; i < count; ++i) {
+			float dist = resolve_distance(scratch.distances[i]);
+
+			if (shape.windings[scratch.contours[i]] > 0 && std::abs(dist) < std::abs(outer) && dist > resolve_distance(result_dist))
+				result_dist = scratch.distances[i];
+		}
+	} else if (outer <= 0.f && std::abs(outer) < std::abs(inner)) {
+		result_dist = outer_dist;
+		winding     = -1;
+
+		for (uint32_t i = 0; i < count; ++i) {
+			float dist = resolve_distance(scratch.distances[i]);
+
+			if (shape.windings[scratch.contours[i]] < 0 && std::abs(dist) < std::abs(inner) && dist < resolve_distance(result_dist))
+				result_dist = scratch.distances[i];
+		}
+	} else {
+		return shape_dist;
+	}
+
+	for (uint32_t i = 0; i < count; ++i) {
+		if (shape.windings[scratch.contours[i]] == winding) continue;
+
+		float dist   = resolve_distance(scratch.distances[i]);
+		float result = resolve_distance(result_dist);
+
+		if (dist * result >= 0.f && std::abs(dist) < std::abs(result))
+			result_dist = scratch.distances[i];
+	}
+
+	if (resolve_distance(result_dist) == resolve_distance(shape_dist))
+		result_dist = shape_dist;
+
+	return result_dist;
+}
+
+template <class Selector>
+static void generate_row(
+	DistanceScratch<Selector>& scratch,
+	const DistanceShape&       shape,
+	Image&                     layer,
+	uint32_t                   y,
+	float                      range,
+	float                      radius
+) {
+	typedef typename Selector::DistanceType DistanceType;
+
+	const float     py           = shape.origin.y - (static_cast<float>(y) + 0.5f);
+	const uint32_t* cell_offsets = shape.cellOffsets.data() + (y / GRID_CELL_SIZE) * shape.cellColumns;
+	const size_t    texel_size   = get_format_size(layer.format());
+
+	uint8_t* row = static_cast<uint8_t*>(layer.data());
+	row += (static_cast<size_t>(shape.position.y + y) * layer.width() + shape.position.x) * texel_size;
+
+	collect_crossings(scratch, shape, py);
+
+	size_t  crossing_idx = 0;
+	int32_t winding      = 0;
+
+	for (uint32_t x = 0; x < shape.width; ++x) {
+		const float2 p(shape.origin.x + static_cast<float>(x) + 0.5f, py);
+
+		while (crossing_idx < scratch.crossings.size() && scratch.crossings[crossing_idx].x < p.x) {
+			winding += scratch.crossings[crossing_idx].direction;
+			advance_crossing(scratch, scratch.crossings[crossing_idx++]);
+		}
+
+		const float     outside_dist = winding != 0 ? range : -range;
+		const uint32_t  cell         = x / GRID_CELL_SIZE;
+		const uint32_t* first        = shape.cellEdges.data() + cell_offsets[cell];
+		const uint32_t* last         = shape.cellEdges.data() + cell_offsets[cell + 1];
+		DistanceType    dist;
+
+		if (first == last) {
+			dist = DistanceType(outside_dist);
+		} else {
+			scratch.contours.clear();
+			scratch.stamp++;
+
+			for (const uint32_t* it = first; it != last; ++it) {
+				const EdgeSegment& edge = shape.edges[*it];
+
+				if (scratch.contours.empty() || scratch.contours.back() != edge.contour) {
+					scratch.selectors[edge.contour].reset();
+					scratch.contours.push_back(edge.contour);
+					scratch.stamps[edge.contour] = scratch.stamp;
+				}
+
+				scratch.selectors[edge.contour].addEdge(shape.edges[edge.prev], edge, shape.edges[edge.next], p);
+			}
+
+			// a far contour around the texel is as far as its nearest crossing on the row at most
+			for (uint32_t contour : scratch.enclosing) {
+				if (scratch.stamps[contour] == scratch.stamp || shape.windings[contour] == 0) continue;
+
+				float reach = std::min(p.x - scratch.contourLeftX[contour], scratch.contourRightX[contour] - p.x);
+
+				scratch.selectors[contour].setFarDistance(static_cast<float>(shape.windings[contour]) * std::max(reach, radius));
+				scratch.contours.push_back(contour);
+			}
+
+			dist = combine_contours(scratch, shape, p);
+
+			float resolved = resolve_distance(dist);
+
+			if (std::abs(resolved) > SIGN_TOLERANCE && (resolved > 0.f) != (winding != 0))
+				dist = DistanceType(outside_dist);
+			else
+				saturate_distance(dist, outside_dist);
+		}
+
+		write_texel(row, x, dist, range);
+	}
+}
+
+template <class Selector>
+static void generate_rows(
+	std::vector<Image>&               layers,
+	const std::vector<DistanceShape>& shapes,
+	float                             range,
+	float                             radius
+) {
+	std::vector<uint32_t> row_offsets(shapes.size() + 1, 0);
+	uint32_t              max_contours = 0;
+
+	for (size_t i = 0; i < shapes.size(); ++i) {
+		row_offsets[i + 1] = row_offsets[i] + shapes[i].height;
+		max_contours       = std::max(max_contours, static_cast<uint32_t>(shapes[i].windings.size()));
+	}
+
+	// rows of every glyph are flattened so a few large glyphs spread as well as many small ones
+	parallel_for(row_offsets.back(), ROWS_PER_TASK, [&](uint32_t begin, uint32_t end) {
+		DistanceScratch<Selector> scratch;
+		scratch.selectors.resize(max_contours);
+		scratch.distances.resize(max_contours);
+		scratch.contours.reserve(max_contours);
+		scratch.stamps.resize(max_contours, 0);
+		scratch.stamp = 0;
+		scratch.contourWindings.resize(max_contours);
+		scratch.contourLeftX.resize(max_contours);
+		scratch.contourRightX.resize(max_contours);
+
+		size_t shape_idx = std::upper_bound(VERA_SPAN(row_offsets), begin) - row_offsets.begin() - 1;
+
+		for (uint32_t row = begin; row < end; ++row) {
+			while (row_offsets[shape_idx + 1] <= row)
+				++shape_idx;
+
+			const DistanceShape& shape = shapes[shape_idx];
+
+			generate_row(scratch, shape, layers[shape.layer], row - row_offsets[shape_idx], range, radius);
+		}
+	});
+}
+
+static void append_distance_field_layer(std::vector<Image>& layers, const DistanceFieldInfo& info)
+{
+	const bool multi_channel = info.type == AtlasType::MSDF || info.type == AtlasType::MTSDF;
+	const auto format        = multi_channel ? Format::RGBA32Float : Format::R8Unorm;
+
+	auto& layer = layers.emplace_back(info.layerWidth, info.layerHeight, format);
+
+	if (!multi_channel) {
+		memset(layer.data(), 0, layer.size());
+	} else {
+		float* texels = static_cast<float*>(layer.data());
+		std::fill(texels, texels + layer.size() / sizeof(float), -info.sdfPadding);
+	}
+}
+
+void generate_distance_fields(
+	std::vector<Image>&       layers,
+	array_view<SDFVertex>     vertices,
+	array_view<SDFGlyphPoint> glyph_points,
+	const DistanceFieldInfo&  info
+) {
+	while (layers.size() < info.layerCount)
+		append_distance_field_layer(layers, info);
+
+	if (vertices.empty()) return;
+
+	const bool  multi_channel = info.type == AtlasType::MSDF || info.type == AtlasType::MTSDF;
+	const float range         = std::max(info.sdfPadding, 1.f);
+	// pseudo distances reach past the true distance along the corner bisectors, so those edges
+	// are searched farther out, pseudo distances of edges beyond twice the range are dropped
+	const float radius        = info.type == AtlasType::SDF ? range : 2.f * range;
+	const float padding2      = 2.f * info.sdfPadding;
+
+	std::vector<DistanceShape> shapes(vertices.size());
+
+	parallel_for(static_cast<uint32_t>(vertices.size()), GLYPHS_PER_TASK, [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; ++i) {
+			const SDFVertex& vertex = vertices[i];
+			DistanceShape&   shape  = shapes[i];
+			const float2     size   = vertex.fontCoordMax - vertex.fontCoordMin;
+
+			// same rect and texel centers the mesh shader quad covers
+			shape.position = vertex.position;
+			shape.layer    = vertex.layerIndex;
+			shape.width    = static_cast<uint32_t>(std::round(info.scale * size.x + padding2));
+			shape.height   = static_cast<uint32_t>(std::round(info.scale * size.y + padding2));
+			shape.origin   = float2(
+				info.scale * vertex.fontCoordMin.x - info.sdfPadding,
+				info.scale * vertex.fontCoordMax.y + info.sdfPadding);
+
+			decode_shape(shape, glyph_points, vertex.storageOffset, info.scale, multi_channel);
+			build_winding_segments(shape);
+			build_edge_grid(shape, radius);
+		}
+	});
+
+	switch (info.type) {
+	case AtlasType::SDF:
+		generate_rows<TrueDistanceSelector>(layers, shapes, range, radius);
+		break;
+	case AtlasType::PSDF:
+		generate_rows<PerpendicularSelector>(layers, shapes, range, radius);
+		break;
+	case AtlasType::MSDF:
+		generate_rows<MultiSelector>(layers, shapes, range, radius);
+		break;
+	case AtlasType::MTSDF:
+		generate_rows<MultiTrueSelector>(layers, shapes, range, radius);
+		break;
+	default:
+		VERA_ASSERT_MSG(false, "invalid distance field atlas type");
+	}
+}
+
+VERA_NAMESPACE_END
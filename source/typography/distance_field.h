@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../../include/vera/graphics/image.h"
+#include "../../include/vera/typography/font_atlas.h"
+#include "../../include/vera/util/array_view.h"
+#include <vector>
+
+#define FLOAT_INF         0x7f800000
+#define END_CONTOUR       { FLOAT_INF, 0.0 }
+#define END_GLYPH         { FLOAT_INF, FLOAT_INF }
+
+VERA_NAMESPACE_BEGIN
+
+// Outline point of the distance field glyph streams. The low mantissa bits of x carry the on curve
+// flag, multi channel streams keep the edge color in the next bit of x and the two low bits of y.
+typedef float2 SDFGlyphPoint;
+
+struct SDFVertex
+{
+	uint2    position;
+	float2   fontCoordMin;
+	float2   fontCoordMax;
+	uint32_t storageOffset;
+	uint32_t layerIndex;
+};
+
+struct DistanceFieldInfo
+{
+	AtlasType type;
+	uint32_t  layerWidth;
+	uint32_t  layerHeight;
+	uint32_t  layerCount; // layers are appended up to this count, cleared to the outside distance
+	float     scale;      // font units to pixels
+	float     sdfPadding; // distance range in pixels, farther texels saturate
+};
+
+// CPU counterpart of the mesh shader atlas passes, reads the same vertex and glyph point streams.
+// Distances to quadratic edges are solved exactly and each texel only visits the edges binned into
+// its cell of a per glyph grid, glyph setup and the texel rows are spread over the hardware threads.
+// SDF and PSDF layers store 0.5 + distance / (2 * sdfPadding) in R8Unorm, MSDF and MTSDF layers
+// store the distances in pixels clamped to the padding.
+void generate_distance_fields(
+	std::vector<Image>&       layers,
+	array_view<SDFVertex>     vertices,
+	array_view<SDFGlyphPoint> glyph_points,
+	const DistanceFieldInfo&  info);
+
+VERA_NAMESPACE_END
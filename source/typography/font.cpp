@@ -3,7 +3,6 @@
 #include "../../include/vera/core/exception.h"
 #include "open_type.h"
 #include <filesystem>
-#include <fstream>
 #include <vector>
 
 VERA_NAMESPACE_BEGIN
@@ -44,36 +43,28 @@ void Font::load(std::string_view path)
 	if (m_impl != nullptr)
 		throw Exception("font is already loaded");
 
-	std::ifstream file(path.data(), std::ios::binary | std::ios::ate);
-	
-	if (!file.is_open())
-		throw Exception("failed to open font file");
-
-	std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+	std::string ext = std::filesystem::path(path).extension().string();
 
-	file.seekg(0, std::ios::beg);
-	file.read(reinterpret_cast<char*>(data.data()), data.size());
-	file.close();
+	if (ext != ".ttc" && ext != ".ttf" && ext != ".otf")
+		throw Exception("unsupported font format: {}", ext);
 
-	std::string ext = std::filesystem::path(path).extension().string();
+	auto file = std::make_shared<const MappedFile>(path);
 
 	if (ext == ".ttc") {
-		auto offsets = OpenTypeImpl::getTTCFontOffsets(data.data(), data.size());
+		auto offsets = OpenTypeImpl::getTTCFontOffsets(file->data(), file->size());
 
 		if (offsets.empty())
 			throw Exception("no fonts found in TTC file");
 		if (offsets.size() > 1)
 			throw Exception("too many fonts in TTC file, consider using FontManager for collection of fonts");
 
-		m_impl = std::make_unique<OpenTypeImpl>(data.data(), data.size(), offsets.front());
-		m_impl->format  = FontFormat::TrueTypeCollection;
-		m_impl->manager = {};
-	} else if (ext == ".ttf" || ext == ".otf") {
-		m_impl = std::make_unique<OpenTypeImpl>(data.data(), data.size(), 0);
+		m_impl = std::make_unique<OpenTypeImpl>(std::move(file), offsets.front());
 		m_impl->format  = FontFormat::TrueTypeCollection;
 		m_impl->manager = {};
 	} else {
-		throw Exception("unsupported font format: {}", ext);
+		m_impl = std::make_unique<OpenTypeImpl>(std::move(file), 0);
+		m_impl->format  = FontFormat::OpenType;
+		m_impl->manager = {};
 	}
 }
 
@@ -124,6 +115,11 @@ GlyphID Font::getGlyphID(char32_t codepoint) const
 	return m_impl->getGlyphID(codepoint);
 }
 
+bool Font::tryGetGlyphID(char32_t codepoint, GlyphID& glyph_id) const VERA_NOEXCEPT
+{
+	return m_impl ? m_impl->tryGetGlyphID(codepoint, glyph_id) : false;
+}
+
 const Glyph& Font::findGlyph(GlyphID glyph_id) const
 {
 	if (!m_impl)
@@ -6,12 +6,17 @@
 #include "../../include/vera/core/command_buffer.h"
 #include "../../include/vera/core/descriptor_pool.h"
 #include "../../include/vera/core/buffer.h"
+#include "../../include/vera/core/device.h"
 #include "../../include/vera/math/vector_math.h"
+#include "../../include/vera/typography/glyph_rasterizer.h"
 #include "../../include/vera/util/rect_packer.h"
 #include "../../include/vera/util/static_vector.h"
+#include "distance_field.h"
 #include "font_impl_base.h"
+#include "glyph_index.h"
+#include <algorithm>
+#include <functional>
 
-#define FLOAT_INF         0x7f800000
 #define FLAG_NONE         0x0u
 #define FLAG_ON_CURVE     0x1u
 #define FLAG_END_CONTOUR  0x2u
@@ -19,8 +24,6 @@
 #define MAX_CONTOUR_COUNT 128
 #define MAX_EDGE_COUNT    1024
 #define MAX_POINT_COUNT   1024
-#define END_CONTOUR       { FLOAT_INF, 0.0 }
-#define END_GLYPH         { FLOAT_INF, FLOAT_INF }
 
 VERA_NAMESPACE_BEGIN
 VERA_PRIV_NAMESPACE_BEGIN
@@ -50,16 +53,42 @@ public:
 	obj<Buffer>                  storageBuffer;
 	ShaderStageFlags             pcStageFlags;
 	CommandSync            commandBufferSync;
+	bool                         cpuGenerator; // distance fields are generated on the cpu and uploaded
 };
 
+// packed glyph of a page with what eviction needs, lookups reach it through the page index
+struct ResidentGlyph : PackedGlyph
+{
+	std::vector<char32_t>         codepoints;    // published in the page index
+	mutable std::atomic<uint32_t> lastUsedFrame;
+};
+
+using GlyphMap = std::unordered_map<GlyphID, ResidentGlyph>;
+
 struct GlyphPage
 {
-	std::vector<obj<Texture>>                textures;
-	std::unordered_map<GlyphID, PackedGlyph> glyphMap;
-	std::unique_ptr<RectPacker>              packer;
-	uint32_t                                 textureCount;
-	uint32_t                                 fullyPackedCount; // number of fully packed textures
-	uint32_t                                 px;
+	std::vector<obj<Texture>>                 textures;
+	GlyphMap                                  glyphMap;
+	std::vector<Image>                        cpuLayers;     // masks and cpu generated distance fields
+	std::vector<std::unique_ptr<RectPacker>>  packers;       // one per layer, evicted rects are packed again
+	std::vector<GlyphMap::node_type>          retired;       // evicted glyphs lookups may still hold until the next frame
+	std::vector<std::pair<uint32_t, GlyphID>> evictionQueue; // last used frame and glyph, oldest at the back
+	GlyphIndex                                index;         // codepoints resolved to the entries of glyphMap
+	GlyphPage*                                next;          // pages form a list readers walk without locking
+	mutable std::atomic<uint32_t>             lastUsedFrame;
+	uint32_t                                  evictionFrame; // frame the eviction queue was built in
+	uint32_t                                  px;
+};
+
+struct GlyphResidency
+{
+	std::unordered_map<uint32_t, GlyphPage>* pages;
+	uint32_t                                 maxLayerCount;
+	uint32_t                                 layerCount;    // over all pages
+	std::atomic<uint32_t>                    frameIndex;
+	std::atomic<uint64_t>                    hitCount;
+	std::atomic<uint64_t>                    missCount;
+	std::atomic<uint64_t>                    evictCount;
 };
 
 VERA_PRIV_NAMESPACE_END
@@ -78,8 +107,6 @@ enum EdgeColor : uint8_t
 
 static wref<priv::FontAtlasGlobalResource> g_global_resource;
 
-typedef float2 SDFGlyphPoint;
-
 struct BitmapVertex
 {
 	float2 pos;
@@ -91,15 +118,6 @@ struct BitmapVertex
 	VERA_VERTEX_DESCRIPTOR_END
 };
 
-struct SDFVertex
-{
-	uint2    position;
-	float2   fontCoordMin;
-	float2   fontCoordMax;
-	uint32_t storageOffset;
-	uint32_t layerIndex;
-};
-
 struct MSDFGlyphPoint
 {
 	float2    position;
@@ -309,12 +327,41 @@ static Format get_font_atlas_format(AtlasType type)
 	return {};
 }
 
+static GlyphMaskType get_glyph_mask_type(AtlasType type)
+{
+	return type == AtlasType::HardMask ? GlyphMaskType::Hard : GlyphMaskType::Soft;
+}
+
+static bool use_cpu_generator(const obj<Device>& device, const FontAtlasCreateInfo& info)
+{
+	switch (info.generator) {
+	case AtlasGenerator::Auto:
+		return !device || !device->isFeatureEnabled(DeviceFeatureType::MeshShader);
+	case AtlasGenerator::MeshShader:
+		if (!device)
+			throw Exception("mesh shader atlas generator requires a device");
+		return false;
+	case AtlasGenerator::CPU:
+		return true;
+	}
+
+	VERA_ASSERT_MSG(false, "invalid atlas generator");
+	return true;
+}
+
 static std::unique_ptr<priv::FontAtlasResource> create_font_atlas_resource(
 	obj<Device>                device,
 	const FontAtlasCreateInfo& info
 ) {
 	auto resource = std::make_unique<priv::FontAtlasResource>();
 
+	resource->device       = device;
+	resource->cpuGenerator = use_cpu_generator(device, info);
+
+	// the cpu generator only needs the device to upload the layers
+	if (resource->cpuGenerator)
+		return resource;
+
 	if (!g_global_resource) {
 		resource->globalResource = make_obj<priv::FontAtlasGlobalResource>();
 
@@ -328,10 +375,6 @@ static std::unique_ptr<priv::FontAtlasResource> create_font_atlas_resource(
 	}
 
 	switch (info.type) {
-	case AtlasType::HardMask: {
-	} break;
-	case AtlasType::SoftMask: {
-	} break;
 	case AtlasType::SDF: {
 		if (!g_global_resource->sdfPipeline) {
 			auto mesh = Shader::create(device, "spirv/font_atlas/mesh_sdf.mesh.slang.spv");
@@ -403,7 +446,6 @@ static std::unique_ptr<priv::FontAtlasResource> create_font_atlas_resource(
 	auto pipeline_layout = resource->pipeline->getPipelineLayout();
 	auto desc_set_layout = pipeline_layout->getDescriptorSetLayout(0);
 
-	resource->device         = device;
 	resource->descriptorPool = DescriptorPool::create(device);
 	resource->descriptorSet  = resource->descriptorPool->allocate(desc_set_layout, 64);
 	resource->commandBuffer  = CommandBuffer::create(device);
@@ -642,39 +684,252 @@ static void simple_coloring(
 	glyph_points.back() = END_GLYPH;
 }
 
+static urect2d get_packed_rect(const PackedGlyph& glyph)
+{
+	const float2 size = glyph.rect.size();
+
+	return urect2d(
+		static_cast<uint32_t>(glyph.rect.min().x),
+		static_cast<uint32_t>(glyph.rect.min().y),
+		static_cast<uint32_t>(size.x),
+		static_cast<uint32_t>(size.y));
+}
+
+static void mark_glyph_used(const PackedGlyph& glyph, uint32_t frame)
+{
+	// every glyph in a page index is a resident glyph, stores are skipped to keep the line shared
+	auto& last_used_frame = static_cast<const priv::ResidentGlyph&>(glyph).lastUsedFrame;
+
+	if (last_used_frame.load(std::memory_order_relaxed) != frame)
+		last_used_frame.store(frame, std::memory_order_relaxed);
+}
+
+static void mark_page_used(const priv::GlyphPage& page, uint32_t frame)
+{
+	if (page.lastUsedFrame.load(std::memory_order_relaxed) != frame)
+		page.lastUsedFrame.store(frame, std::memory_order_relaxed);
+}
+
+static void publish_glyph(priv::GlyphPage& page, char32_t codepoint, priv::ResidentGlyph& glyph)
+{
+	if (std::find(VERA_SPAN(glyph.codepoints), codepoint) == glyph.codepoints.end())
+		glyph.codepoints.push_back(codepoint);
+
+	page.index.publish(codepoint, &glyph);
+}
+
+// resets the texels of an evicted rect, so a smaller glyph packed there does not bleed old texels
+static void clear_layer_rect(Image& layer, const urect2d& rect, const FontAtlasCreateInfo& info)
+{
+	if (layer.format() == Format::RGBA32Float) {
+		for (uint32_t y = rect.min_y(); y < rect.max_y(); ++y) {
+			float* row = static_cast<float*>(layer.data()) + (static_cast<size_t>(y) * layer.width() + rect.x) * 4;
+			std::fill(row, row + rect.width * 4, -static_cast<float>(info.sdfPadding));
+		}
+	} else {
+		for (uint32_t y = rect.min_y(); y < rect.max_y(); ++y) {
+			uint8_t* row = static_cast<uint8_t*>(layer.data()) + static_cast<size_t>(y) * layer.width() + rect.x;
+			memset(row, 0, rect.width);
+		}
+	}
+}
+
+// the node is retired instead of freed, lookups of other threads may still read it this frame
+static void evict_glyph(
+	priv::GlyphResidency&      residency,
+	priv::GlyphPage&           page,
+	const FontAtlasCreateInfo& info,
+	priv::GlyphMap::iterator   it
+) {
+	const priv::ResidentGlyph& glyph = it->second;
+	const urect2d              rect  = get_packed_rect(glyph);
+
+	for (char32_t codepoint : glyph.codepoints)
+		page.index.publish(codepoint, nullptr);
+
+	if (rect.width != 0 && rect.height != 0) {
+		page.packers[glyph.layer]->release(rect);
+
+		if (glyph.layer < page.cpuLayers.size())
+			clear_layer_rect(page.cpuLayers[glyph.layer], rect, info);
+	}
+
+	page.retired.push_back(page.glyphMap.extract(it));
+	residency.evictCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// drops every glyph and layer of the page, the page itself stays in the list readers walk
+static void reset_glyph_page(priv::GlyphResidency& residency, priv::GlyphPage& page)
+{
+	for (auto it = page.glyphMap.begin(); it != page.glyphMap.end();) {
+		for (char32_t codepoint : it->second.codepoints)
+			page.index.publish(codepoint, nullptr);
+
+		page.retired.push_back(page.glyphMap.extract(it++));
+	}
+
+	residency.layerCount -= static_cast<uint32_t>(page.packers.size());
+
+	page.textures.clear();
+	page.cpuLayers.clear();
+	page.packers.clear();
+	page.evictionQueue.clear();
+	page.evictionFrame = UINT32_MAX;
+}
+
+// frees all layers of the size used longest ago, sizes used in the current frame are kept
+static bool evict_stale_page(priv::GlyphResidency& residency, const priv::GlyphPage& keep)
+{
+	const uint32_t   frame  = residency.frameIndex.load(std::memory_order_relaxed);
+	priv::GlyphPage* oldest = nullptr;
+
+	for (auto& [px, page] : *residency.pages) {
+		if (&page == &keep || page.packers.empty()) continue;
+
+		const uint32_t last_used_frame = page.lastUsedFrame.load(std::memory_order_relaxed);
+
+		if (last_used_frame == frame) continue;
+
+		if (!oldest || last_used_frame < oldest->lastUsedFrame.load(std::memory_order_relaxed))
+			oldest = &page;
+	}
+
+	if (!oldest) return false;
+
+	residency.evictCount.fetch_add(oldest->glyphMap.size(), std::memory_order_relaxed);
+	reset_glyph_page(residency, *oldest);
+
+	return true;
+}
+
+// evicts the least recently used glyph of the page that was not used in the current frame
+static bool evict_lru_glyph(
+	priv::GlyphResidency&      residency,
+	priv::GlyphPage&           page,
+	const FontAtlasCreateInfo& info,
+	uint32_t&                  out_layer
+) {
+	const uint32_t frame = residency.frameIndex.load(std::memory_order_relaxed);
+
+	// built once per frame, glyphs used since then are skipped when they come up
+	if (page.evictionFrame != frame) {
+		page.evictionQueue.clear();
+
+		for (const auto& [glyph_id, glyph] : page.glyphMap) {
+			const uint32_t last_used_frame = glyph.lastUsedFrame.load(std::memory_order_relaxed);
+
+			if (last_used_frame != frame)
+				page.evictionQueue.emplace_back(last_used_frame, glyph_id);
+		}
+
+		std::sort(VERA_SPAN(page.evictionQueue), std::greater<>());
+		page.evictionFrame = frame;
+	}
+
+	while (!page.evictionQueue.empty()) {
+		const GlyphID glyph_id = page.evictionQueue.back().second;
+		page.evictionQueue.pop_back();
+
+		auto it = page.glyphMap.find(glyph_id);
+
+		if (it == page.glyphMap.end() || it->second.lastUsedFrame.load(std::memory_order_relaxed) == frame)
+			continue;
+
+		out_layer = it->second.layer;
+		evict_glyph(residency, page, info, it);
+
+		return true;
+	}
+
+	return false;
+}
+
+static void append_page_layer(
+	priv::GlyphResidency&      residency,
+	priv::GlyphPage&           page,
+	const FontAtlasCreateInfo& info
+) {
+	page.packers.push_back(RectPacker::createUnique(
+		info.packingMethod,
+		info.atlasWidth,
+		info.atlasHeight,
+		info.padding));
+
+	residency.layerCount++;
+}
+
+// Finds room for a glyph in the layers of the page. A new layer is opened while the atlas is
+// below its layer budget, past it stale sizes and then the least recently used glyphs of the page
+// are evicted until the glyph fits. Throws once only glyphs of the current frame are left.
+static void allocate_glyph_rect(
+	priv::GlyphResidency&      residency,
+	priv::GlyphPage&           page,
+	const FontAtlasCreateInfo& info,
+	const extent2d&            extent,
+	uint32_t&                  out_layer,
+	urect2d&                   out_rect
+) {
+	mark_page_used(page, residency.frameIndex.load(std::memory_order_relaxed));
+
+	// newest layer first, older layers only have room where glyphs were released
+	for (size_t i = page.packers.size(); i-- > 0;) {
+		if (page.packers[i]->pack(extent, out_rect)) {
+			out_layer = static_cast<uint32_t>(i);
+			return;
+		}
+	}
+
+	if (residency.maxLayerCount != 0)
+		while (residency.layerCount >= residency.maxLayerCount && evict_stale_page(residency, page));
+
+	if (residency.maxLayerCount == 0 || residency.layerCount < residency.maxLayerCount) {
+		append_page_layer(residency, page, info);
+
+		if (!page.packers.back()->pack(extent, out_rect))
+			throw Exception("unable to pack glyph into the atlas texture");
+
+		out_layer = static_cast<uint32_t>(page.packers.size() - 1);
+		return;
+	}
+
+	uint32_t layer;
+	while (evict_lru_glyph(residency, page, info, layer)) {
+		if (page.packers[layer]->pack(extent, out_rect)) {
+			out_layer = layer;
+			return;
+		}
+	}
+
+	throw Exception("glyphs used in this frame exceed the font atlas layer budget of {}", residency.maxLayerCount);
+}
+
 static void fill_msdf_vertices(
 	std::vector<SDFVertex>&     vertices,
 	std::vector<SDFGlyphPoint>& glyph_points,
+	priv::GlyphResidency&       residency,
 	priv::GlyphPage&            page,
+	const FontAtlasCreateInfo&  info,
 	const Glyph&                glyph,
 	float                       scale,
 	float                       sdf_padding2
 ) {
 	if (page.glyphMap.contains(glyph.glyphID)) return;
 
-	if (page.textureCount == 0)
-		page.textureCount = 1;
-
 	const float2   size   = glyph.aabb.size();
 	const extent2d extent = {
 		static_cast<uint32_t>(round(scale * size.x + sdf_padding2)),
 		static_cast<uint32_t>(round(scale * size.y + sdf_padding2))
 	};
 
-	urect2d rect;
-	if (!page.packer->pack(extent, rect)) {
-		page.packer->clear();
-
-		if (!page.packer->pack(extent, rect))
-			throw Exception("unable to pack glyph into the atlas texture");
+	uint32_t layer;
+	urect2d  rect;
+	allocate_glyph_rect(residency, page, info, extent, layer, rect);
 
-		page.textureCount++;
-	}
-
-	auto& packed_glyph = page.glyphMap.emplace(glyph.glyphID, PackedGlyph{}).first->second;
+	auto& packed_glyph = page.glyphMap.try_emplace(glyph.glyphID).first->second;
+	packed_glyph.lastUsedFrame.store(residency.frameIndex.load(std::memory_order_relaxed), std::memory_order_relaxed);
 	packed_glyph.glyphID = glyph.glyphID;
 	packed_glyph.px      = page.px;
-	packed_glyph.layer   = page.textureCount - 1;
+	packed_glyph.layer   = layer;
 	packed_glyph.rect	 = AABB2D(
 		static_cast<float>(rect.min_x()),
 		static_cast<float>(rect.min_y()),
@@ -682,6 +937,9 @@ static void fill_msdf_vertices(
 		static_cast<float>(rect.max_y())
 	);
 
+	// glyphs without contours keep their rect but have nothing to render
+	if (glyph.contours.empty()) return;
+
 	vertices.push_back(SDFVertex{
 		.position      = uint2{ rect.min_x(), rect.min_y() },
 		.fontCoordMin  = glyph.aabb.min(),
@@ -705,36 +963,30 @@ static void fill_msdf_vertices(
 static void fill_sdf_vertices(
 	std::vector<SDFVertex>&     vertices,
 	std::vector<SDFGlyphPoint>& glyph_points,
+	priv::GlyphResidency&       residency,
 	priv::GlyphPage&            page,
+	const FontAtlasCreateInfo&  info,
 	const Glyph&                glyph,
 	float                       scale,
 	float                       sdf_padding2
 ) {
 	if (page.glyphMap.contains(glyph.glyphID)) return;
 
-	if (page.textureCount == 0)
-		page.textureCount = 1;
-
 	const float2   size   = glyph.aabb.size();
 	const extent2d extent = {
 		static_cast<uint32_t>(round(scale * size.x + sdf_padding2)),
 		static_cast<uint32_t>(round(scale * size.y + sdf_padding2))
 	};
 
-	urect2d rect;
-	if (!page.packer->pack(extent, rect)) {
-		page.packer->clear();
-
-		if (!page.packer->pack(extent, rect))
-			throw Exception("unable to pack glyph into the atlas texture");
+	uint32_t layer;
+	urect2d  rect;
+	allocate_glyph_rect(residency, page, info, extent, layer, rect);
 
-		page.textureCount++;
-	}
-
-	auto& packed_glyph = page.glyphMap.emplace(glyph.glyphID, PackedGlyph{}).first->second;
+	auto& packed_glyph = page.glyphMap.try_emplace(glyph.glyphID).first->second;
+	packed_glyph.lastUsedFrame.store(residency.frameIndex.load(std::memory_order_relaxed), std::memory_order_relaxed);
 	packed_glyph.glyphID = glyph.glyphID;
 	packed_glyph.px      = page.px;
-	packed_glyph.layer   = page.textureCount - 1;
+	packed_glyph.layer   = layer;
 	packed_glyph.rect	 = AABB2D(
 		static_cast<float>(rect.min_x()),
 		static_cast<float>(rect.min_y()),
@@ -742,6 +994,9 @@ static void fill_sdf_vertices(
 		static_cast<float>(rect.max_y())
 	);
 
+	// glyphs without contours keep their rect but have nothing to render
+	if (glyph.contours.empty()) return;
+
 	vertices.push_back(SDFVertex{
 		.position      = uint2{ rect.min_x(), rect.min_y() },
 		.fontCoordMin  = glyph.aabb.min(),
@@ -790,6 +1045,19 @@ static void update_storage_descriptor_set(
 	storage_descriptor_set->write(dst_binding, buffer_info);
 }
 
+static obj<Buffer> create_sdf_buffer(obj<Device> device, size_t size)
+{
+	// filled through the device staging ring, so the buffer can live in device local memory
+	BufferCreateInfo info;
+	info.size         = size;
+	info.usage        =
+		BufferUsageFlagBits::StorageBuffer |
+		BufferUsageFlagBits::TransferDst;
+	info.propetyFlags = MemoryPropertyFlagBits::DeviceLocal;
+
+	return Buffer::create(std::move(device), info);
+}
+
 static void upload_sdf_buffer(
 	priv::FontAtlasResource&  resource,
 	array_view<SDFVertex>     vertices,
@@ -799,7 +1067,7 @@ static void upload_sdf_buffer(
 	size_t stor_bytes = sizeof(SDFGlyphPoint) * glyph_points.size();
 
 	if (!resource.vertexBuffer) {
-		resource.vertexBuffer = Buffer::createStorage(resource.device, vert_bytes);
+		resource.vertexBuffer = create_sdf_buffer(resource.device, vert_bytes);
 		update_storage_descriptor_set(resource.descriptorSet, resource.vertexBuffer, 0);
 	} else if (resource.vertexBuffer->size() < vert_bytes) {
 		resource.vertexBuffer->resize(vert_bytes);
@@ -807,21 +1075,29 @@ static void upload_sdf_buffer(
 	}
 
 	if (!resource.storageBuffer) {
-		resource.storageBuffer = Buffer::createStorage(resource.device, stor_bytes);
+		resource.storageBuffer = create_sdf_buffer(resource.device, stor_bytes);
 		update_storage_descriptor_set(resource.descriptorSet, resource.storageBuffer, 1);
 	} else if (resource.storageBuffer->size() < stor_bytes) {
 		resource.storageBuffer->resize(stor_bytes);
 		update_storage_descriptor_set(resource.descriptorSet, resource.storageBuffer, 1);
 	}
 
-	auto* vert_map = resource.vertexBuffer->getDeviceMemory()->map();
-	auto* stor_map = resource.storageBuffer->getDeviceMemory()->map();
+	resource.vertexBuffer->upload(vertices);
+	resource.storageBuffer->upload(glyph_points);
+}
+
+// layers written by the vertices in ascending order, reused layers may come before new ones
+static std::vector<uint32_t> get_written_layers(array_view<SDFVertex> vertices)
+{
+	std::vector<uint32_t> layers;
+
+	for (const auto& vertex : vertices)
+		layers.push_back(vertex.layerIndex);
 
-	memcpy(vert_map, vertices.data(), vert_bytes);
-	memcpy(stor_map, glyph_points.data(), stor_bytes);
+	std::sort(VERA_SPAN(layers));
+	layers.erase(std::unique(VERA_SPAN(layers)), layers.end());
 
-	resource.vertexBuffer->getDeviceMemory()->flush();
-	resource.storageBuffer->getDeviceMemory()->flush();
+	return layers;
 }
 
 static void prepare_page_textures(
@@ -829,31 +1105,76 @@ static void prepare_page_textures(
 	priv::GlyphPage&           page,
 	const FontAtlasCreateInfo& info
 ) {
-	uint32_t dst_array_idx        = 0;
-	uint32_t curr_texture_count   = static_cast<uint32_t>(page.textures.size());
-	uint32_t needed_texture_count = page.textureCount;
-
-	for (uint32_t i = curr_texture_count; i < needed_texture_count; ++i) {
-		if (page.fullyPackedCount == page.textures.size()) {
-			TextureCreateInfo texture_info = {
-				.format = get_font_atlas_format(info.type),
-				.usage  = TextureUsageFlagBits::Storage | TextureUsageFlagBits::Sampled,
-				.width  = info.atlasWidth,
-				.height = info.atlasHeight
-			};
-
-			page.textures.push_back(Texture::create(resource.device, texture_info));
-			page.packer->clear();
-		}
+	for (size_t i = page.textures.size(); i < page.packers.size(); ++i) {
+		TextureCreateInfo texture_info = {
+			.format = get_font_atlas_format(info.type),
+			.usage  = TextureUsageFlagBits::Storage | TextureUsageFlagBits::Sampled,
+			.width  = info.atlasWidth,
+			.height = info.atlasHeight
+		};
+
+		page.textures.push_back(Texture::create(resource.device, texture_info));
+	}
 
+	// vertices address the layers by index, so every layer is bound at its own array element
+	for (uint32_t i = 0; i < page.textures.size(); ++i) {
 		DescriptorTextureInfo texture_info;
-		texture_info.textureView = TextureView::create(page.textures.back());
+		texture_info.textureView = TextureView::create(page.textures[i]);
 		texture_info.layout      = TextureLayout::General;
 
-		resource.descriptorSet->write(2, texture_info, dst_array_idx++);
+		resource.descriptorSet->write(2, texture_info, i);
+	}
+}
 
-		page.fullyPackedCount++;
+static CommandSync upload_cpu_layers(
+	const obj<Device>&         device,
+	priv::GlyphPage&           page,
+	const FontAtlasCreateInfo& info,
+	array_view<uint32_t>       written_layers
+) {
+	// atlases baked without a device only keep the cpu layers
+	if (!device) return {};
+
+	while (page.textures.size() < page.cpuLayers.size()) {
+		TextureCreateInfo texture_info = {
+			.format = get_font_atlas_format(info.type),
+			.usage  = TextureUsageFlagBits::TransferDst | TextureUsageFlagBits::Sampled,
+			.width  = info.atlasWidth,
+			.height = info.atlasHeight
+		};
+
+		page.textures.push_back(Texture::create(device, texture_info));
 	}
+
+	for (uint32_t layer : written_layers)
+		page.textures[layer]->upload(page.cpuLayers[layer]);
+
+	return device->flushUploads();
+}
+
+// generates SDF, PSDF, MSDF and MTSDF glyphs on the cpu from the same streams the mesh shaders read
+static CommandSync generate_sdf_glyph(
+	priv::FontAtlasResource&          resource,
+	priv::GlyphPage&                  page,
+	const FontAtlasCreateInfo&        info,
+	const std::vector<SDFVertex>&     vertices,
+	const std::vector<SDFGlyphPoint>& glyph_points,
+	float                             scale
+) {
+	DistanceFieldInfo field_info = {
+		.type        = info.type,
+		.layerWidth  = info.atlasWidth,
+		.layerHeight = info.atlasHeight,
+		.layerCount  = static_cast<uint32_t>(page.packers.size()),
+		.scale       = scale,
+		.sdfPadding  = static_cast<float>(info.sdfPadding)
+	};
+
+	const std::vector<uint32_t> written_layers = get_written_layers(vertices);
+
+	generate_distance_fields(page.cpuLayers, vertices, glyph_points, field_info);
+
+	return upload_cpu_layers(resource.device, page, info, written_layers);
 }
 
 // renders SDF, PSDF font glyphs into the atlas textures
@@ -873,6 +1194,9 @@ static CommandSync render_sdf_glyph(
 		float2   resolution;
 	};
 
+	if (resource.cpuGenerator)
+		return generate_sdf_glyph(resource, page, info, vertices, glyph_points, scale);
+
 	Viewport viewport = {
 		.posX     = 0.f,
 		.posY     = 0.f,
@@ -906,13 +1230,30 @@ static CommandSync render_sdf_glyph(
 	if (!resource.commandBufferSync.empty())
 		resource.commandBufferSync.wait();
 
-	uint32_t texture_offset = page.textures.size();
+	const uint32_t              texture_offset = static_cast<uint32_t>(page.textures.size());
+	const std::vector<uint32_t> written_layers = get_written_layers(vertices);
 
 	upload_sdf_buffer(resource, vertices, glyph_points);
 	prepare_page_textures(resource, page, info);
 
 	cmd_buffer->reset();
 	cmd_buffer->begin();
+
+	// new layers start undefined, reused layers are read by text rendering until now
+	for (uint32_t layer : written_layers) {
+		const bool new_layer = layer >= texture_offset;
+
+		cmd_buffer->transitionImageLayout(
+			page.textures[layer],
+			new_layer ? PipelineStageFlagBits::TopOfPipe : PipelineStageFlagBits::FragmentShader,
+			PipelineStageFlagBits::FragmentShader,
+			new_layer ? AccessFlagBits::None : AccessFlagBits::ShaderRead,
+			AccessFlagBits::ShaderWrite,
+			new_layer ? TextureLayout::Undefined : TextureLayout::ShaderReadOnlyOptimal,
+			TextureLayout::General
+		);
+	}
+
 	cmd_buffer->setViewport(viewport);
 	cmd_buffer->setScissor(scissor);
 	cmd_buffer->bindDescriptorSet(pipeline_layout, 0, resource.descriptorSet);
@@ -922,14 +1263,14 @@ static CommandSync render_sdf_glyph(
 	cmd_buffer->drawMeshTask((pc_data.vertexCount - 1) / 64 + 1, 1, 1);
 	cmd_buffer->endRendering();
 
-	for (uint32_t i = texture_offset; i < page.textures.size(); ++i) {
+	for (uint32_t layer : written_layers) {
 		cmd_buffer->transitionImageLayout(
-			page.textures[i],
+			page.textures[layer],
 			PipelineStageFlagBits::FragmentShader,
 			PipelineStageFlagBits::FragmentShader,
 			AccessFlagBits::ShaderWrite,
 			AccessFlagBits::ShaderRead,
-			TextureLayout::Undefined,
+			TextureLayout::General,
 			TextureLayout::ShaderReadOnlyOptimal
 		);
 	}
@@ -939,9 +1280,50 @@ static CommandSync render_sdf_glyph(
 	return resource.commandBufferSync = cmd_buffer->submit();
 }
 
+// codepoints the font does not map are skipped, code ranges usually span whole unicode blocks
+static void get_code_range_glyph_ids(
+	std::vector<GlyphID>&     glyph_ids,
+	const priv::FontImplBase& impl,
+	const CodeRange&          range
+) {
+	GlyphID glyph_id;
+
+	for (const char32_t codepoint : range)
+		if (impl.tryGetGlyphID(codepoint, glyph_id))
+			glyph_ids.push_back(glyph_id);
+}
+
+// indexes the codepoints of the range whose glyphs are packed in the page
+static void publish_code_range(
+	priv::GlyphPage&          page,
+	const priv::FontImplBase& impl,
+	const CodeRange&          range
+) {
+	GlyphID glyph_id;
+
+	for (const char32_t codepoint : range) {
+		if (!impl.tryGetGlyphID(codepoint, glyph_id)) continue;
+
+		if (auto it = page.glyphMap.find(glyph_id); it != page.glyphMap.end())
+			publish_glyph(page, codepoint, it->second);
+	}
+}
+
+static const priv::GlyphPage* find_glyph_page(
+	const std::atomic<priv::GlyphPage*>& page_list,
+	uint32_t                             px
+) {
+	const priv::GlyphPage* page = page_list.load(std::memory_order_acquire);
+
+	while (page && page->px != px)
+		page = page->next;
+
+	return page;
+}
+
 static priv::GlyphPage* get_glyph_page(
 	std::unordered_map<uint32_t, priv::GlyphPage>& pages,
-	const FontAtlasCreateInfo&                     info,
+	std::atomic<priv::GlyphPage*>&                 page_list,
 	uint32_t                                       px
 ) {
 	auto it = pages.find(px);
@@ -949,27 +1331,25 @@ static priv::GlyphPage* get_glyph_page(
 	if (it != pages.end())
 		return &it->second;
 	
-	auto [iter, success] = pages.emplace(px, priv::GlyphPage{});
+	// pages hold atomics and are built in place, map nodes never move once inserted
+	auto [iter, success] = pages.try_emplace(px);
 	auto& new_page       = iter->second;
-	new_page.px               = px;
-	new_page.fullyPackedCount = 0;
-	new_page.textureCount     = 0;
-	new_page.packer           = RectPacker::createUnique(
-		info.packingMethod,
-		info.atlasWidth,
-		info.atlasHeight,
-		info.padding
-	);
+	new_page.px            = px;
+	new_page.evictionFrame = UINT32_MAX;
+
+	new_page.next = page_list.load(std::memory_order_relaxed);
+	page_list.store(&new_page, std::memory_order_release);
 
 	return &new_page;
 }
 
 static CommandSync load_msdf_glyph(
-	priv::FontAtlasResource&    resource,
-	const FontAtlasCreateInfo&  info,
-	const priv::FontImplBase&   impl,
-	priv::GlyphPage&            page,
-	const basic_range<GlyphID>& range
+	priv::FontAtlasResource&   resource,
+	priv::GlyphResidency&      residency,
+	const FontAtlasCreateInfo& info,
+	const priv::FontImplBase&  impl,
+	priv::GlyphPage&           page,
+	array_view<GlyphID>        glyph_ids
 ) {
 	std::vector<SDFVertex>     vertices;
 	std::vector<SDFGlyphPoint> glyph_points;
@@ -977,11 +1357,13 @@ static CommandSync load_msdf_glyph(
 	float scale        = get_font_scale(impl, page.px);
 	float sdf_padding2 = 2.f * info.sdfPadding;
 	
-	for (GlyphID glyph_id : range) {
+	for (GlyphID glyph_id : glyph_ids) {
 		fill_msdf_vertices(
 			vertices,
 			glyph_points,
+			residency,
 			page,
+			info,
 			impl.findGlyph(glyph_id),
 			scale,
 			sdf_padding2
@@ -1000,22 +1382,55 @@ static CommandSync load_msdf_glyph(
 	);
 }
 
+static CommandSync load_msdf_glyph(
+	priv::FontAtlasResource&    resource,
+	priv::GlyphResidency&       residency,
+	const FontAtlasCreateInfo&  info,
+	const priv::FontImplBase&   impl,
+	priv::GlyphPage&            page,
+	const basic_range<GlyphID>& range
+) {
+	std::vector<GlyphID> glyph_ids;
+	glyph_ids.reserve(range.size());
+
+	for (GlyphID glyph_id : range)
+		glyph_ids.push_back(glyph_id);
+
+	return load_msdf_glyph(resource, residency, info, impl, page, glyph_ids);
+}
+
 static CommandSync load_msdf_glyph(
 	priv::FontAtlasResource&   resource,
+	priv::GlyphResidency&      residency,
 	const FontAtlasCreateInfo& info,
 	const priv::FontImplBase&  impl,
 	priv::GlyphPage&           page,
 	const CodeRange&           range
 ) {
-	return {};
+	if (range.getUnicodeRange() == UnicodeRange::ALL) {
+		return load_msdf_glyph(
+			resource,
+			residency,
+			info,
+			impl,
+			page,
+			basic_range<GlyphID>{ 0, impl.getGlyphCount() }
+		);
+	}
+
+	std::vector<GlyphID> glyph_ids;
+	get_code_range_glyph_ids(glyph_ids, impl, range);
+
+	return load_msdf_glyph(resource, residency, info, impl, page, glyph_ids);
 }
 
 static CommandSync load_sdf_glyph(
-	priv::FontAtlasResource&    resource,
-	const FontAtlasCreateInfo&  info,
-	const priv::FontImplBase&   impl,
-	priv::GlyphPage&            page,
-	const basic_range<GlyphID>& range
+	priv::FontAtlasResource&   resource,
+	priv::GlyphResidency&      residency,
+	const FontAtlasCreateInfo& info,
+	const priv::FontImplBase&  impl,
+	priv::GlyphPage&           page,
+	array_view<GlyphID>        glyph_ids
 ) {
 	std::vector<SDFVertex>     vertices;
 	std::vector<SDFGlyphPoint> glyph_points;
@@ -1023,11 +1438,13 @@ static CommandSync load_sdf_glyph(
 	float scale        = get_font_scale(impl, page.px);
 	float sdf_padding2 = 2.f * info.sdfPadding;
 	
-	for (GlyphID glyph_id : range) {
+	for (GlyphID glyph_id : glyph_ids) {
 		fill_sdf_vertices(
 			vertices,
 			glyph_points,
+			residency,
 			page,
+			info,
 			impl.findGlyph(glyph_id),
 			scale,
 			sdf_padding2
@@ -1046,8 +1463,26 @@ static CommandSync load_sdf_glyph(
 	);
 }
 
+static CommandSync load_sdf_glyph(
+	priv::FontAtlasResource&    resource,
+	priv::GlyphResidency&       residency,
+	const FontAtlasCreateInfo&  info,
+	const priv::FontImplBase&   impl,
+	priv::GlyphPage&            page,
+	const basic_range<GlyphID>& range
+) {
+	std::vector<GlyphID> glyph_ids;
+	glyph_ids.reserve(range.size());
+
+	for (GlyphID glyph_id : range)
+		glyph_ids.push_back(glyph_id);
+
+	return load_sdf_glyph(resource, residency, info, impl, page, glyph_ids);
+}
+
 static CommandSync load_sdf_glyph(
 	priv::FontAtlasResource&   resource,
+	priv::GlyphResidency&      residency,
 	const FontAtlasCreateInfo& info,
 	const priv::FontImplBase&  impl,
 	priv::GlyphPage&           page,
@@ -1056,51 +1491,178 @@ static CommandSync load_sdf_glyph(
 	if (range.getUnicodeRange() == UnicodeRange::ALL) {
 		return load_sdf_glyph(
 			resource,
+			residency,
 			info,
 			impl,
 			page,
-			basic_range<GlyphID>{ 0, info.font->getGlyphCount() + 1 }
+			basic_range<GlyphID>{ 0, impl.getGlyphCount() }
 		);
-	} 
+	}
 
-	std::vector<SDFVertex>     vertices;
-	std::vector<SDFGlyphPoint> glyph_points;
+	std::vector<GlyphID> glyph_ids;
+	get_code_range_glyph_ids(glyph_ids, impl, range);
 
-	float scale        = get_font_scale(impl, page.px);
-	float sdf_padding2 = 2.f * info.sdfPadding;
+	return load_sdf_glyph(resource, residency, info, impl, page, glyph_ids);
+}
 
-	for (const char32_t codepoint : range) {
-		GlyphID glyph_id = info.font->getGlyphID(codepoint);
-		if (page.glyphMap.contains(glyph_id)) continue;
+static CommandSync load_mask_glyph(
+	const obj<Device>&         device,
+	priv::GlyphResidency&      residency,
+	const FontAtlasCreateInfo& info,
+	const priv::FontImplBase&  impl,
+	priv::GlyphPage&           page,
+	std::vector<GlyphID>&      glyph_ids
+) {
+	std::sort(VERA_SPAN(glyph_ids));
+	glyph_ids.erase(std::unique(VERA_SPAN(glyph_ids)), glyph_ids.end());
 
-		fill_sdf_vertices(
-			vertices,
-			glyph_points,
-			page,
-			impl.findGlyph(glyph_id),
-			scale,
-			sdf_padding2
-		);
+	const float scale = get_font_scale(impl, page.px);
+
+	std::vector<std::pair<extent2d, const Glyph*>> missing_glyphs;
+	missing_glyphs.reserve(glyph_ids.size());
+
+	for (GlyphID glyph_id : glyph_ids) {
+		if (!page.glyphMap.contains(glyph_id)) {
+			const Glyph& glyph = impl.findGlyph(glyph_id);
+			missing_glyphs.emplace_back(GlyphRasterizer::getGlyphExtent(glyph, scale), &glyph);
+		}
 	}
 
-	if (vertices.empty()) return {};
+	if (missing_glyphs.empty()) return {};
 
-	return render_sdf_glyph(
-		resource,
-		page,
-		info,
-		vertices,
-		glyph_points,
-		scale
-	);
+	// taller masks first, the short ones fill the gaps they leave
+	std::stable_sort(VERA_SPAN(missing_glyphs), [](const auto& lhs, const auto& rhs) {
+		return lhs.first.height > rhs.first.height;
+	});
+
+	const uint32_t frame = residency.frameIndex.load(std::memory_order_relaxed);
+
+	std::vector<PackedGlyph>  packed_glyphs;
+	std::vector<const Glyph*> glyphs;
+	std::vector<uint32_t>     written_layers;
+
+	packed_glyphs.reserve(missing_glyphs.size());
+	glyphs.reserve(missing_glyphs.size());
+
+	// packing is sequential, the glyphs are rasterized once their rects are known
+	for (const auto& [extent, glyph] : missing_glyphs) {
+		auto& packed = packed_glyphs.emplace_back();
+		packed.glyphID = glyph->glyphID;
+		packed.px      = page.px;
+		packed.layer   = 0;
+		packed.rect    = AABB2D(0.f, 0.f, 0.f, 0.f);
+
+		glyphs.push_back(glyph);
+
+		if (extent.width == 0) continue;
+
+		urect2d rect;
+		allocate_glyph_rect(residency, page, info, extent, packed.layer, rect);
+
+		packed.rect = AABB2D(
+			static_cast<float>(rect.min_x()),
+			static_cast<float>(rect.min_y()),
+			static_cast<float>(rect.max_x()),
+			static_cast<float>(rect.max_y()));
+
+		if (std::find(VERA_SPAN(written_layers), packed.layer) == written_layers.end())
+			written_layers.push_back(packed.layer);
+	}
+
+	while (page.cpuLayers.size() < page.packers.size()) {
+		auto& layer = page.cpuLayers.emplace_back(info.atlasWidth, info.atlasHeight, Format::R8Unorm);
+		memset(layer.data(), 0, layer.size());
+	}
+
+	GlyphMaskBakeInfo bake_info = {
+		.type  = get_glyph_mask_type(info.type),
+		.scale = scale,
+		.px    = page.px
+	};
+
+	bake_glyph_masks(page.cpuLayers, packed_glyphs, glyphs, bake_info);
+
+	for (const auto& packed_glyph : packed_glyphs) {
+		auto& resident = page.glyphMap.try_emplace(packed_glyph.glyphID).first->second;
+		static_cast<PackedGlyph&>(resident) = packed_glyph;
+		resident.lastUsedFrame.store(frame, std::memory_order_relaxed);
+	}
+
+	std::sort(VERA_SPAN(written_layers));
+
+	return upload_cpu_layers(device, page, info, written_layers);
+}
+
+static CommandSync load_mask_glyph(
+	const obj<Device>&          device,
+	priv::GlyphResidency&       residency,
+	const FontAtlasCreateInfo&  info,
+	const priv::FontImplBase&   impl,
+	priv::GlyphPage&            page,
+	const basic_range<GlyphID>& range
+) {
+	std::vector<GlyphID> glyph_ids;
+
+	for (GlyphID glyph_id : range)
+		glyph_ids.push_back(glyph_id);
+
+	return load_mask_glyph(device, residency, info, impl, page, glyph_ids);
+}
+
+static CommandSync load_mask_glyph(
+	const obj<Device>&         device,
+	priv::GlyphResidency&      residency,
+	const FontAtlasCreateInfo& info,
+	const priv::FontImplBase&  impl,
+	priv::GlyphPage&           page,
+	const CodeRange&           range
+) {
+	std::vector<GlyphID> glyph_ids;
+	get_code_range_glyph_ids(glyph_ids, impl, range);
+
+	return load_mask_glyph(device, residency, info, impl, page, glyph_ids);
+}
+
+// loads glyphs of a page by id, the outlines must already be loaded in the font
+static CommandSync load_glyph_ids(
+	const obj<Device>&                        device,
+	std::unique_ptr<priv::FontAtlasResource>& resource,
+	priv::GlyphResidency&                     residency,
+	const FontAtlasCreateInfo&                info,
+	const priv::FontImplBase&                 impl,
+	priv::GlyphPage&                          page,
+	std::vector<GlyphID>&                     glyph_ids
+) {
+	if (info.type == AtlasType::HardMask || info.type == AtlasType::SoftMask)
+		return load_mask_glyph(device, residency, info, impl, page, glyph_ids);
+
+	if (!resource)
+		resource = create_font_atlas_resource(device, info);
+
+	switch (info.type) {
+	case AtlasType::SDF:
+	case AtlasType::PSDF:
+		return load_sdf_glyph(*resource, residency, info, impl, page, glyph_ids);
+	case AtlasType::MSDF:
+	case AtlasType::MTSDF:
+		return load_msdf_glyph(*resource, residency, info, impl, page, glyph_ids);
+	}
+
+	VERA_ASSERT_MSG(false, "invalid atlas type");
+	return {};
 }
 
 obj<FontAtlas> FontAtlas::create(obj<Device> device, const FontAtlasCreateInfo& info)
 {
 	auto new_obj = obj<FontAtlas>(new FontAtlas());
 
-	new_obj->m_device = std::move(device);
-	new_obj->m_info   = info;
+	new_obj->m_device    = std::move(device);
+	new_obj->m_info      = info;
+	new_obj->m_residency = std::make_unique<priv::GlyphResidency>();
+
+	new_obj->m_residency->pages         = &new_obj->m_pages;
+	new_obj->m_residency->maxLayerCount = info.maxLayerCount;
+	new_obj->m_residency->layerCount    = 0;
 
 	if (info.sdfFontSize == 0)
 		new_obj->m_info.sdfFontSize = 48; // default size
@@ -1138,6 +1700,17 @@ uint32_t FontAtlas::getTextureCount(uint32_t px) const VERA_NOEXCEPT
 	return 0;
 }
 
+const Image* FontAtlas::getLayerImage(uint32_t px, uint32_t layer) const VERA_NOEXCEPT
+{
+	px = get_font_size(m_info, px);
+
+	if (auto it = m_pages.find(px); it != m_pages.cend())
+		if (layer < it->second.cpuLayers.size())
+			return &it->second.cpuLayers[layer];
+
+	return nullptr;
+}
+
 extent2d FontAtlas::getTextureSize() const VERA_NOEXCEPT
 {
 	return extent2d{ m_info.atlasWidth, m_info.atlasHeight };
@@ -1148,19 +1721,27 @@ CommandSync FontAtlas::loadGlyphRange(const basic_range<GlyphID>& range, uint32_
 	m_info.font->loadGlyphRange(range);
 
 	uint32_t         font_px = get_font_size(m_info, px);
-	priv::GlyphPage* page = get_glyph_page(m_pages, m_info, font_px);
+	priv::GlyphPage* page = get_glyph_page(m_pages, m_pageList, font_px);
+
+	if (m_info.type == AtlasType::HardMask || m_info.type == AtlasType::SoftMask)
+		return load_mask_glyph(
+			m_device,
+			*m_residency,
+			m_info,
+			*m_info.font->m_impl,
+			*page,
+			range
+		);
 
 	if (!m_resource)
 		m_resource = create_font_atlas_resource(m_device, m_info);
 
 	switch (m_info.type) {
-	case AtlasType::HardMask:
-	case AtlasType::SoftMask:
-		break;
 	case AtlasType::SDF:
 	case AtlasType::PSDF:
 		return load_sdf_glyph(
 			*m_resource,
+			*m_residency,
 			m_info,
 			*m_info.font->m_impl,
 			*page,
@@ -1170,6 +1751,7 @@ CommandSync FontAtlas::loadGlyphRange(const basic_range<GlyphID>& range, uint32_
 	case AtlasType::MTSDF:
 		return load_msdf_glyph(
 			*m_resource,
+			*m_residency,
 			m_info,
 			*m_info.font->m_impl,
 			*page,
@@ -1187,58 +1769,279 @@ CommandSync FontAtlas::loadCodeRange(const CodeRange& range, uint32_t px)
 	m_info.font->loadCodeRange(range);
 	
 	uint32_t         font_px = get_font_size(m_info, px);
-	priv::GlyphPage* page = get_glyph_page(m_pages, m_info, font_px);
+	priv::GlyphPage* page = get_glyph_page(m_pages, m_pageList, font_px);
+	CommandSync      sync;
 
-	if (!m_resource)
-		m_resource = create_font_atlas_resource(m_device, m_info);
-
-	switch (m_info.type) {
-	case AtlasType::HardMask:
-	case AtlasType::SoftMask:
-		break;
-	case AtlasType::SDF:
-	case AtlasType::PSDF:
-		return load_sdf_glyph(
-			*m_resource,
+	if (m_info.type == AtlasType::HardMask || m_info.type == AtlasType::SoftMask) {
+		sync = load_mask_glyph(
+			m_device,
+			*m_residency,
 			m_info,
 			*m_info.font->m_impl,
 			*page,
 			range
 		);
-		break;
-	case AtlasType::MSDF:
-	case AtlasType::MTSDF:
-		return load_msdf_glyph(
-			*m_resource,
-			m_info,
-			*m_info.font->m_impl,
-			*page,
-			range
-		);
-		break;
+	} else {
+		if (!m_resource)
+			m_resource = create_font_atlas_resource(m_device, m_info);
+
+		switch (m_info.type) {
+		case AtlasType::SDF:
+		case AtlasType::PSDF:
+			sync = load_sdf_glyph(
+				*m_resource,
+				*m_residency,
+				m_info,
+				*m_info.font->m_impl,
+				*page,
+				range
+			);
+			break;
+		case AtlasType::MSDF:
+		case AtlasType::MTSDF:
+			sync = load_msdf_glyph(
+				*m_resource,
+				*m_residency,
+				m_info,
+				*m_info.font->m_impl,
+				*page,
+				range
+			);
+			break;
+		default:
+			VERA_ASSERT_MSG(false, "invalid atlas type");
+			return {};
+		}
 	}
 
-	VERA_ASSERT_MSG(false, "invalid atlas type");
-	return {};
+	publish_code_range(*page, *m_info.font->m_impl, range);
+
+	return sync;
 }
 
 const PackedGlyph& FontAtlas::getGlyph(char32_t codepoint, uint32_t px)
 {
-	uint32_t font_px  = get_font_size(m_info, px);
-	auto     page_it  = m_pages.find(font_px);
-	
-	if (page_it == m_pages.end())
+	uint32_t font_px = get_font_size(m_info, px);
+	uint32_t frame   = m_residency->frameIndex.load(std::memory_order_relaxed);
+
+	if (const priv::GlyphPage* page = find_glyph_page(m_pageList, font_px)) {
+		if (const PackedGlyph* packed_glyph = page->index.find(codepoint)) {
+			mark_glyph_used(*packed_glyph, frame);
+			mark_page_used(*page, frame);
+			m_residency->hitCount.fetch_add(1, std::memory_order_relaxed);
+			return *packed_glyph;
+		}
+	}
+
+	m_residency->missCount.fetch_add(1, std::memory_order_relaxed);
+
+	GlyphID          glyph_id = m_info.font->getGlyphID(codepoint);
+	priv::GlyphPage* page     = get_glyph_page(m_pages, m_pageList, font_px);
+
+	// glyphs loaded by glyph id are packed but not indexed by codepoint yet
+	auto it = page->glyphMap.find(glyph_id);
+	if (it == page->glyphMap.end()) {
 		loadCodeRange(codepoint, font_px).wait();
 
-	GlyphID glyph_id = m_info.font->getGlyphID(codepoint);
+		if (it = page->glyphMap.find(glyph_id); it == page->glyphMap.end())
+			throw Exception("glyph not found in font atlas");
+	}
 
-	auto it = page_it->second.glyphMap.find(glyph_id);
-	if (it == page_it->second.glyphMap.end())
-		throw Exception("glyph not found in font atlas");
+	publish_glyph(*page, codepoint, it->second);
+	mark_glyph_used(it->second, frame);
 
 	return it->second;
 }
 
+uint32_t FontAtlas::getGlyphs(std::u32string_view text, uint32_t px, std::span<const PackedGlyph*> out_glyphs)
+{
+	VERA_ASSERT_MSG(text.size() <= out_glyphs.size(), "output span is smaller than the text");
+
+	if (findGlyphs(text, px, out_glyphs) == 0) return 0;
+
+	const priv::FontImplBase& impl    = *m_info.font->m_impl;
+	uint32_t                  font_px = get_font_size(m_info, px);
+	uint32_t                  frame   = m_residency->frameIndex.load(std::memory_order_relaxed);
+	priv::GlyphPage*          page    = get_glyph_page(m_pages, m_pageList, font_px);
+	std::vector<GlyphID>      glyph_ids;
+	GlyphID                   glyph_id;
+
+	// glyphs packed by id but not indexed yet must survive the loads below
+	for (size_t i = 0; i < text.size(); ++i) {
+		if (out_glyphs[i] || !impl.tryGetGlyphID(text[i], glyph_id)) continue;
+
+		if (auto it = page->glyphMap.find(glyph_id); it != page->glyphMap.end())
+			mark_glyph_used(it->second, frame);
+		else
+			glyph_ids.push_back(glyph_id);
+	}
+
+	if (!glyph_ids.empty()) {
+		for (GlyphID id : glyph_ids)
+			(void)m_info.font->getGlyph(id);
+
+		load_glyph_ids(m_device, m_resource, *m_residency, m_info, impl, *page, glyph_ids).wait();
+	}
+
+	uint32_t miss_count = 0;
+
+	for (size_t i = 0; i < text.size(); ++i) {
+		if (out_glyphs[i]) continue;
+
+		if (impl.tryGetGlyphID(text[i], glyph_id)) {
+			if (auto it = page->glyphMap.find(glyph_id); it != page->glyphMap.end()) {
+				publish_glyph(*page, text[i], it->second);
+				out_glyphs[i] = &it->second;
+				continue;
+			}
+		}
+
+		++miss_count;
+	}
+
+	return miss_count;
+}
+
+const PackedGlyph* FontAtlas::findGlyph(char32_t codepoint, uint32_t px) const VERA_NOEXCEPT
+{
+	const uint32_t         frame = m_residency->frameIndex.load(std::memory_order_relaxed);
+	const priv::GlyphPage* page  = find_glyph_page(m_pageList, get_font_size(m_info, px));
+	const PackedGlyph*     glyph = page ? page->index.find(codepoint) : nullptr;
+
+	if (glyph) {
+		mark_glyph_used(*glyph, frame);
+		mark_page_used(*page, frame);
+		m_residency->hitCount.fetch_add(1, std::memory_order_relaxed);
+	} else {
+		m_residency->missCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	return glyph;
+}
+
+uint32_t FontAtlas::findGlyphs(std::u32string_view text, uint32_t px, std::span<const PackedGlyph*> out_glyphs) const VERA_NOEXCEPT
+{
+	VERA_ASSERT_MSG(text.size() <= out_glyphs.size(), "output span is smaller than the text");
+
+	const priv::GlyphPage* page = find_glyph_page(m_pageList, get_font_size(m_info, px));
+
+	if (!page) {
+		std::fill_n(out_glyphs.begin(), text.size(), nullptr);
+		m_residency->missCount.fetch_add(text.size(), std::memory_order_relaxed);
+		return static_cast<uint32_t>(text.size());
+	}
+
+	const uint32_t frame      = m_residency->frameIndex.load(std::memory_order_relaxed);
+	uint32_t       miss_count = 0;
+
+	for (size_t i = 0; i < text.size(); ++i) {
+		out_glyphs[i] = page->index.find(text[i]);
+
+		if (out_glyphs[i])
+			mark_glyph_used(*out_glyphs[i], frame);
+		else
+			++miss_count;
+	}
+
+	mark_page_used(*page, frame);
+
+	// one update per call, the counters are shared by every reading thread
+	m_residency->hitCount.fetch_add(text.size() - miss_count, std::memory_order_relaxed);
+	m_residency->missCount.fetch_add(miss_count, std::memory_order_relaxed);
+
+	return miss_count;
+}
+
+void FontAtlas::nextFrame() VERA_NOEXCEPT
+{
+	// lookups of the frame that ends are done, evicted glyphs can no longer be reached
+	for (auto& [px, page] : m_pages)
+		page.retired.clear();
+
+	m_residency->frameIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+CommandSync FontAtlas::compact(uint32_t px)
+{
+	auto it = m_pages.find(get_font_size(m_info, px));
+
+	if (it == m_pages.end() || it->second.glyphMap.empty()) return {};
+
+	priv::GlyphPage& page = it->second;
+
+	struct ResidentInfo
+	{
+		GlyphID               glyphID;
+		float                 height;
+		uint32_t              lastUsedFrame;
+		std::vector<char32_t> codepoints;
+	};
+
+	std::vector<ResidentInfo> residents;
+	std::vector<GlyphID>      glyph_ids;
+
+	residents.reserve(page.glyphMap.size());
+
+	for (const auto& [glyph_id, glyph] : page.glyphMap) {
+		residents.push_back(ResidentInfo{
+			.glyphID       = glyph_id,
+			.height        = glyph.rect.size().y,
+			.lastUsedFrame = glyph.lastUsedFrame.load(std::memory_order_relaxed),
+			.codepoints    = glyph.codepoints
+		});
+	}
+
+	// tallest first, the mask path sorts by its own extents again
+	std::stable_sort(VERA_SPAN(residents), [](const ResidentInfo& lhs, const ResidentInfo& rhs) {
+		return lhs.height > rhs.height;
+	});
+
+	glyph_ids.reserve(residents.size());
+	for (const auto& resident : residents)
+		glyph_ids.push_back(resident.glyphID);
+
+	reset_glyph_page(*m_residency, page);
+
+	CommandSync sync = load_glyph_ids(m_device, m_resource, *m_residency, m_info, *m_info.font->m_impl, page, glyph_ids);
+
+	// the regenerated glyphs keep their codepoints and age
+	for (const auto& resident : residents) {
+		auto glyph_it = page.glyphMap.find(resident.glyphID);
+
+		if (glyph_it == page.glyphMap.end()) continue;
+
+		for (char32_t codepoint : resident.codepoints)
+			publish_glyph(page, codepoint, glyph_it->second);
+
+		glyph_it->second.lastUsedFrame.store(resident.lastUsedFrame, std::memory_order_relaxed);
+	}
+
+	return sync;
+}
+
+FontAtlasStatistics FontAtlas::getStatistics() const VERA_NOEXCEPT
+{
+	uint32_t resident_count = 0;
+
+	for (const auto& [px, page] : m_pages)
+		resident_count += static_cast<uint32_t>(page.glyphMap.size());
+
+	return FontAtlasStatistics{
+		.hitCount           = m_residency->hitCount.load(std::memory_order_relaxed),
+		.missCount          = m_residency->missCount.load(std::memory_order_relaxed),
+		.evictCount         = m_residency->evictCount.load(std::memory_order_relaxed),
+		.residentGlyphCount = resident_count,
+		.layerCount         = m_residency->layerCount
+	};
+}
+
+void FontAtlas::resetStatistics() VERA_NOEXCEPT
+{
+	m_residency->hitCount.store(0, std::memory_order_relaxed);
+	m_residency->missCount.store(0, std::memory_order_relaxed);
+	m_residency->evictCount.store(0, std::memory_order_relaxed);
+}
+
 AtlasType FontAtlas::getAtlasType() const VERA_NOEXCEPT
 {
 	return m_info.type;
@@ -2,6 +2,7 @@
 
 #include "../../include/vera/core/intrusive_ptr.h"
 #include "../../include/vera/typography/font.h"
+#include "shaping_tables.h"
 
 VERA_NAMESPACE_BEGIN
 
@@ -22,10 +23,12 @@ public:
 
 	virtual uint32_t getGlyphCount() const VERA_NOEXCEPT = 0;
 	virtual GlyphID getGlyphID(char32_t codepoint) const = 0;
+	virtual bool tryGetGlyphID(char32_t codepoint, GlyphID& glyph_id) const VERA_NOEXCEPT = 0;
 	virtual const Glyph& findGlyph(GlyphID glyph_id) const = 0;
 	virtual const Glyph& getGlyph(GlyphID glyph_id) = 0;
 	virtual const Glyph& findGlyphByCodepoint(char32_t codepoint) const = 0;
 	virtual const Glyph& getGlyphByCodepoint(char32_t codepoint) = 0;
+	virtual const ShapingTables& getShapingTables() = 0; // built on first use
 
 	FontFormat       format;
 	ref<FontManager> manager;
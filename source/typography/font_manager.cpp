@@ -3,7 +3,6 @@
 #include "../../include/vera/core/exception.h"
 #include "open_type.h"
 #include <filesystem>
-#include <fstream>
 
 VERA_NAMESPACE_BEGIN
 
@@ -23,23 +22,18 @@ FontManager::~FontManager()
 
 void FontManager::loadFont(std::string_view path)
 {
-	std::ifstream file(path.data(), std::ios::binary | std::ios::ate);
-	
-	if (!file.is_open())
-		throw Exception("failed to open font file");
-
-	std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+	std::string ext = std::filesystem::path(path).extension().string();
 
-	file.seekg(0, std::ios::beg);
-	file.read(reinterpret_cast<char*>(data.data()), data.size());
-	file.close();
+	if (ext != ".ttc" && ext != ".ttf" && ext != ".otf")
+		throw Exception("unsupported font format: {}", ext);
 
-	std::string ext = std::filesystem::path(path).extension().string();
+	// every face of a collection reads from the same mapping, which lives as long as any of them
+	auto file = std::make_shared<const MappedFile>(path);
 
 	if (ext == ".ttc") {
 		std::vector<obj<Font>> new_fonts;
 
-		auto offsets = OpenTypeImpl::getTTCFontOffsets(data.data(), data.size());
+		auto offsets = OpenTypeImpl::getTTCFontOffsets(file->data(), file->size());
 
 		if (offsets.empty())
 			throw Exception("no fonts found in TTC file");
@@ -47,22 +41,20 @@ void FontManager::loadFont(std::string_view path)
 		for (const uint32_t offset : offsets) {
 			auto& new_font = new_fonts.emplace_back(new Font);
 
-			new_font->m_impl = std::make_unique<OpenTypeImpl>(data.data(), data.size(), offset);
+			new_font->m_impl = std::make_unique<OpenTypeImpl>(file, offset);
 			new_font->m_impl->format  = FontFormat::TrueTypeCollection;
 			new_font->m_impl->manager = this;
 		}
 
 		for (auto& font : new_fonts)
 			m_fonts.emplace(font->getName(), font);
-	} else if (ext == ".ttf" || ext == ".otf") {
+	} else {
 		auto new_font = obj<Font>(new Font);
-		new_font->m_impl = std::make_unique<OpenTypeImpl>(data.data(), data.size(), 0);
+		new_font->m_impl = std::make_unique<OpenTypeImpl>(std::move(file), 0);
 		new_font->m_impl->format  = FontFormat::OpenType;
 		new_font->m_impl->manager = this;
 
 		m_fonts.emplace(new_font->getName(), new_font);
-	} else {
-		throw Exception("unsupported font format: {}", ext);
 	}
 }
 
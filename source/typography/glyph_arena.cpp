@@ -0,0 +1,106 @@
+#include "glyph_arena.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+VERA_NAMESPACE_BEGIN
+
+GlyphArena::GlyphArena() VERA_NOEXCEPT :
+	m_blocks(),
+	m_offset(0),
+	m_used(0) {}
+
+GlyphArena::GlyphArena(GlyphArena&& rhs) VERA_NOEXCEPT :
+	m_blocks(std::move(rhs.m_blocks)),
+	m_offset(std::exchange(rhs.m_offset, 0)),
+	m_used(std::exchange(rhs.m_used, 0)) {}
+
+GlyphArena::~GlyphArena() VERA_NOEXCEPT
+{
+	// nothing to do
+}
+
+GlyphArena& GlyphArena::operator=(GlyphArena&& rhs) VERA_NOEXCEPT
+{
+	if (this != &rhs) {
+		m_blocks = std::move(rhs.m_blocks);
+		m_offset = std::exchange(rhs.m_offset, 0);
+		m_used   = std::exchange(rhs.m_used, 0);
+	}
+
+	return *this;
+}
+
+void GlyphArena::merge(GlyphArena&& other)
+{
+	if (other.m_blocks.empty()) return;
+
+	if (m_blocks.empty()) {
+		*this = std::move(other);
+		return;
+	}
+
+	// the full blocks of other go in front of the block still being filled
+	m_blocks.insert(
+		m_blocks.end() - 1,
+		std::make_move_iterator(other.m_blocks.begin()),
+		std::make_move_iterator(other.m_blocks.end()));
+	m_used += other.m_used;
+
+	other.clear();
+}
+
+void GlyphArena::clear() VERA_NOEXCEPT
+{
+	m_blocks.clear();
+	m_offset = 0;
+	m_used   = 0;
+}
+
+size_t GlyphArena::getAllocatedSize() const VERA_NOEXCEPT
+{
+	size_t size = 0;
+
+	for (const auto& block : m_blocks)
+		size += block.size;
+
+	return size;
+}
+
+size_t GlyphArena::getUsedSize() const VERA_NOEXCEPT
+{
+	return m_used;
+}
+
+bool GlyphArena::owns(const void* ptr) const VERA_NOEXCEPT
+{
+	const std::byte* byte_ptr = static_cast<const std::byte*>(ptr);
+
+	for (const auto& block : m_blocks)
+		if (std::less_equal<>{}(block.data.get(), byte_ptr) && std::less<>{}(byte_ptr, block.data.get() + block.size))
+			return true;
+
+	return false;
+}
+
+void* GlyphArena::allocateBytes(size_t size, size_t alignment)
+{
+	if (size == 0) return nullptr;
+
+	size_t offset = (m_offset + alignment - 1) & ~(alignment - 1);
+
+	if (m_blocks.empty() || m_blocks.back().size < offset + size) {
+		const size_t block_size = std::max<size_t>(size, GLYPH_ARENA_BLOCK_SIZE);
+
+		m_blocks.push_back(Block{ std::make_unique_for_overwrite<std::byte[]>(block_size), block_size });
+		offset = 0;
+	}
+
+	m_offset = offset + size;
+	m_used  += size;
+
+	return m_blocks.back().data.get() + offset;
+}
+
+VERA_NAMESPACE_END
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../../include/vera/typography/glyph.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#define GLYPH_ARENA_BLOCK_SIZE (256 * 1024) // bytes, larger outlines get a block of their own
+
+VERA_NAMESPACE_BEGIN
+
+// Bump allocator for glyph outlines. Points and contour ends of a whole font are carved out of a
+// few large blocks that are neither moved nor freed before the arena, so the views held by loaded
+// glyphs stay valid while more glyphs are loaded. Every parsing thread fills an arena of its own
+// which is merged into the font afterwards.
+class GlyphArena
+{
+public:
+	GlyphArena() VERA_NOEXCEPT;
+	GlyphArena(GlyphArena&& rhs) VERA_NOEXCEPT;
+	~GlyphArena() VERA_NOEXCEPT;
+
+	GlyphArena& operator=(GlyphArena&& rhs) VERA_NOEXCEPT;
+
+	GlyphArena(const GlyphArena&) = delete;
+	GlyphArena& operator=(const GlyphArena&) = delete;
+
+	template <class T>
+	VERA_NODISCARD T* allocate(size_t count)
+	{
+		static_assert(std::is_trivially_destructible_v<T> && alignof(T) <= alignof(std::max_align_t));
+		return static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T)));
+	}
+
+	// takes over the blocks of other, views into them stay valid
+	void merge(GlyphArena&& other);
+	void clear() VERA_NOEXCEPT;
+
+	VERA_NODISCARD size_t getAllocatedSize() const VERA_NOEXCEPT;
+	VERA_NODISCARD size_t getUsedSize() const VERA_NOEXCEPT;
+
+	// whether ptr points into one of the blocks of this arena
+	VERA_NODISCARD bool owns(const void* ptr) const VERA_NOEXCEPT;
+
+private:
+	struct Block
+	{
+		std::unique_ptr<std::byte[]> data;
+		size_t                       size;
+	};
+
+	void* allocateBytes(size_t size, size_t alignment);
+
+	std::vector<Block> m_blocks; // the last block is the one being filled
+	size_t             m_offset; // into the last block
+	size_t             m_used;
+};
+
+VERA_NAMESPACE_END
@@ -0,0 +1,62 @@
+#include "glyph_index.h"
+
+VERA_NAMESPACE_BEGIN
+
+GlyphIndex::GlyphIndex() VERA_NOEXCEPT
+{
+	for (auto& block : m_bmp)
+		block.store(nullptr, std::memory_order_relaxed);
+	for (auto& plane : m_planes)
+		plane.store(nullptr, std::memory_order_relaxed);
+}
+
+GlyphIndex::~GlyphIndex() VERA_NOEXCEPT
+{
+	for (auto& block : m_bmp)
+		delete block.load(std::memory_order_relaxed);
+
+	for (auto& plane_ptr : m_planes) {
+		Plane* plane = plane_ptr.load(std::memory_order_relaxed);
+
+		if (!plane) continue;
+
+		for (auto& block : plane->blocks)
+			delete block.load(std::memory_order_relaxed);
+
+		delete plane;
+	}
+}
+
+void GlyphIndex::publish(char32_t codepoint, const PackedGlyph* glyph)
+{
+	std::atomic<Block*>* slot;
+
+	if (codepoint < 0x10000) {
+		slot = &m_bmp[codepoint >> GLYPH_INDEX_BLOCK_BITS];
+	} else {
+		const uint32_t plane_idx = (codepoint >> 16) - 1;
+
+		if (plane_idx >= GLYPH_INDEX_PLANE_COUNT) return;
+
+		Plane* plane = m_planes[plane_idx].load(std::memory_order_relaxed);
+
+		if (!plane) {
+			plane = new Plane();
+			m_planes[plane_idx].store(plane, std::memory_order_release);
+		}
+
+		slot = &plane->blocks[(codepoint >> GLYPH_INDEX_BLOCK_BITS) & 0xFF];
+	}
+
+	Block* block = slot->load(std::memory_order_relaxed);
+
+	// the block is zeroed before readers can reach it through the release store
+	if (!block) {
+		block = new Block();
+		slot->store(block, std::memory_order_release);
+	}
+
+	block->entries[codepoint & (GLYPH_INDEX_BLOCK_SIZE - 1)].store(glyph, std::memory_order_release);
+}
+
+VERA_NAMESPACE_END
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../../include/vera/typography/glyph.h"
+#include <atomic>
+
+#define GLYPH_INDEX_BLOCK_BITS  8
+#define GLYPH_INDEX_BLOCK_SIZE  (1u << GLYPH_INDEX_BLOCK_BITS)
+#define GLYPH_INDEX_BMP_BLOCKS  (0x10000u >> GLYPH_INDEX_BLOCK_BITS)
+#define GLYPH_INDEX_PLANE_COUNT 16 // astral planes 1 to 16
+
+VERA_NAMESPACE_BEGIN
+
+// Codepoint to packed glyph index of an atlas page. The basic multilingual plane is direct mapped
+// through a fixed directory of 256 codepoint blocks, astral planes get their block directory once
+// a codepoint of the plane is published. Blocks are allocated on first use and live as long as the
+// index, so lookups are a few dependent loads without any lock and may run on any thread while the
+// single writer publishes new entries. Published glyphs must stay alive as long as readers may
+// still reach them, publishing null removes a codepoint.
+class GlyphIndex
+{
+	struct Block
+	{
+		std::atomic<const PackedGlyph*> entries[GLYPH_INDEX_BLOCK_SIZE];
+	};
+
+	struct Plane
+	{
+		std::atomic<Block*> blocks[GLYPH_INDEX_BMP_BLOCKS];
+	};
+
+public:
+	GlyphIndex() VERA_NOEXCEPT;
+	~GlyphIndex() VERA_NOEXCEPT;
+
+	GlyphIndex(const GlyphIndex&) = delete;
+	GlyphIndex& operator=(const GlyphIndex&) = delete;
+
+	// nullptr when the codepoint was never published
+	VERA_NODISCARD VERA_INLINE const PackedGlyph* find(char32_t codepoint) const VERA_NOEXCEPT
+	{
+		const Block* block;
+
+		if (codepoint < 0x10000) {
+			block = m_bmp[codepoint >> GLYPH_INDEX_BLOCK_BITS].load(std::memory_order_acquire);
+		} else {
+			const uint32_t plane_idx = (codepoint >> 16) - 1;
+
+			if (plane_idx >= GLYPH_INDEX_PLANE_COUNT) return nullptr;
+
+			const Plane* plane = m_planes[plane_idx].load(std::memory_order_acquire);
+
+			if (!plane) return nullptr;
+
+			block = plane->blocks[(codepoint >> GLYPH_INDEX_BLOCK_BITS) & 0xFF].load(std::memory_order_acquire);
+		}
+
+		if (!block) return nullptr;
+
+		return block->entries[codepoint & (GLYPH_INDEX_BLOCK_SIZE - 1)].load(std::memory_order_acquire);
+	}
+
+	// only one thread may publish at a time, codepoints past U+10FFFF are ignored
+	void publish(char32_t codepoint, const PackedGlyph* glyph);
+
+private:
+	std::atomic<Block*> m_bmp[GLYPH_INDEX_BMP_BLOCKS];
+	std::atomic<Plane*> m_planes[GLYPH_INDEX_PLANE_COUNT];
+};
+
+VERA_NAMESPACE_END
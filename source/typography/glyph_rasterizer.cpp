@@ -0,0 +1,370 @@
+#include "../../include/vera/typography/glyph_rasterizer.h"
+
+#include "../../include/vera/core/exception.h"
+#include "../../include/vera/math/vector_math.h"
+#include "../util/parallel_for.h"
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+#define FLATTEN_TOLERANCE    0.015625f // max distance in pixels between a curve and its flattened segments
+#define MAX_CURVE_SEGMENTS   64
+#define GLYPHS_PER_TASK      16
+
+VERA_NAMESPACE_BEGIN
+
+struct CellBuffer
+{
+	float*   cells;
+	uint32_t width;
+	uint32_t height;
+	uint32_t stride; // two cells past the width take the spill of edges touching the right border
+};
+
+struct GlyphTransform
+{
+	float2 origin; // glyph aabb (min.x, max.y) in font units
+	float  scale;
+
+	VERA_NODISCARD VERA_INLINE float2 operator()(const float2& p) const VERA_NOEXCEPT
+	{
+		return float2((p.x - origin.x) * scale, (origin.y - p.y) * scale);
+	}
+};
+
+// Adds the signed area a line covers to the cells of every row it crosses, a prefix sum of a row
+// afterwards gives the winding weighted coverage of each texel.
+static void accumulate_line(CellBuffer& buffer, float2 p0, float2 p1)
+{
+	const float max_x = static_cast<float>(buffer.width);
+	const float max_y = static_cast<float>(buffer.height);
+
+	p0 = float2(std::clamp(p0.x, 0.f, max_x), std::clamp(p0.y, 0.f, max_y));
+	p1 = float2(std::clamp(p1.x, 0.f, max_x), std::clamp(p1.y, 0.f, max_y));
+
+	if (p0.y == p1.y) return;
+
+	float dir = 1.f;
+
+	if (p1.y < p0.y) {
+		std::swap(p0, p1);
+		dir = -1.f;
+	}
+
+	const float    dxdy   = (p1.x - p0.x) / (p1.y - p0.y);
+	const uint32_t y_end  = std::min(buffer.height, static_cast<uint32_t>(std::ceil(p1.y)));
+	float          x      = p0.x;
+
+	for (uint32_t y = static_cast<uint32_t>(p0.y); y < y_end; ++y) {
+		float* row   = buffer.cells + static_cast<size_t>(y) * buffer.stride;
+		float  dy    = std::min(static_cast<float>(y + 1), p1.y) - std::max(static_cast<float>(y), p0.y);
+		float  x_nxt = std::clamp(x + dxdy * dy, 0.f, max_x); // rounding may step past the border
+		float  d     = dy * dir;
+		float  x0    = std::min(x, x_nxt);
+		float  x1    = std::max(x, x_nxt);
+
+		float    x0_floor = std::floor(x0);
+		float    x1_ceil  = std::ceil(x1);
+		uint32_t x0i      = static_cast<uint32_t>(x0_floor);
+		uint32_t x1i      = static_cast<uint32_t>(x1_ceil);
+
+		if (x1i <= x0i + 1) {
+			// the edge stays within one texel column on this row
+			float xm = 0.5f * (x + x_nxt) - x0_floor;
+
+			row[x0i]     += d - d * xm;
+			row[x0i + 1] += d * xm;
+		} else {
+			float s   = 1.f / (x1 - x0);
+			float x0f = x0 - x0_floor;
+			float a0  = 0.5f * s * (1.f - x0f) * (1.f - x0f);
+			float x1f = x1 - x1_ceil + 1.f;
+			float am  = 0.5f * s * x1f * x1f;
+
+			row[x0i] += d * a0;
+
+			if (x1i == x0i + 2) {
+				row[x0i + 1] += d * (1.f - a0 - am);
+			} else {
+				float a1 = s * (1.5f - x0f);
+
+				row[x0i + 1] += d * (a1 - a0);
+
+				for (uint32_t xi = x0i + 2; xi < x1i - 1; ++xi)
+					row[xi] += d * s;
+
+				float a2 = a1 + static_cast<float>(x1i - x0i - 3) * s;
+
+				row[x1i - 1] += d * (1.f - a2 - am);
+			}
+
+			row[x1i] += d * am;
+		}
+
+		x = x_nxt;
+	}
+}
+
+// Splits the curve into uniform segments, n segments keep within |p0 - 2p1 + p2| / (8n^2) of it.
+static void accumulate_quadratic(CellBuffer& buffer, const float2& p0, const float2& p1, const float2& p2)
+{
+	float dev   = length(p0 - p1 * 2.f + p2);
+	float count = std::ceil(std::sqrt(dev / (8.f * FLATTEN_TOLERANCE)));
+
+	if (count <= 1.f) {
+		accumulate_line(buffer, p0, p2);
+		return;
+	}
+
+	uint32_t n    = std::min(static_cast<uint32_t>(count), static_cast<uint32_t>(MAX_CURVE_SEGMENTS));
+	float    step = 1.f / static_cast<float>(n);
+	float2   prev = p0;
+
+	for (uint32_t i = 1; i < n; ++i) {
+		float2 next = quadratic(p0, p1, p2, step * static_cast<float>(i));
+		accumulate_line(buffer, prev, next);
+		prev = next;
+	}
+
+	accumulate_line(buffer, prev, p2);
+}
+
+// Walks a TrueType contour, two consecutive off curve points imply an on curve point halfway
+// between them and the contour may start on an off curve point.
+static void accumulate_contour(CellBuffer& buffer, const Glyph::ContourType& contour, const GlyphTransform& transform)
+{
+	const size_t point_count = contour.size();
+
+	if (point_count < 2) return;
+
+	size_t first = 0;
+	while (first < point_count && !contour[first].onCurve)
+		++first;
+
+	float2 start;
+	size_t begin;
+	size_t visit_count;
+
+	if (first == point_count) {
+		start       = transform((contour.back().position + contour.front().position) * 0.5f);
+		begin       = 0;
+		visit_count = point_count;
+	} else {
+		start       = transform(contour[first].position);
+		begin       = first + 1;
+		visit_count = point_count - 1;
+	}
+
+	float2 curr        = start;
+	float2 control     = {};
+	bool   has_control = false;
+
+	for (size_t i = 0; i < visit_count; ++i) {
+		const GlyphPoint& point = contour[(begin + i) % point_count];
+		const float2      p     = transform(point.position);
+
+		if (point.onCurve) {
+			if (has_control)
+				accumulate_quadratic(buffer, curr, control, p);
+			else
+				accumulate_line(buffer, curr, p);
+
+			curr        = p;
+			has_control = false;
+		} else {
+			if (has_control) {
+				float2 mid = (control + p) * 0.5f;
+				accumulate_quadratic(buffer, curr, control, mid);
+				curr = mid;
+			}
+
+			control     = p;
+			has_control = true;
+		}
+	}
+
+	if (has_control)
+		accumulate_quadratic(buffer, curr, control, start);
+	else
+		accumulate_line(buffer, curr, start);
+}
+
+// Turns the accumulated cells into texels and leaves the cells zeroed for the next glyph.
+static void resolve_cells(uint8_t* dst, size_t row_pitch, CellBuffer& buffer, GlyphMaskType type)
+{
+	for (uint32_t y = 0; y < buffer.height; ++y) {
+		float*   row = buffer.cells + static_cast<size_t>(y) * buffer.stride;
+		uint8_t* out = dst + y * row_pitch;
+		float    acc = 0.f;
+
+		if (type == GlyphMaskType::Hard) {
+			for (uint32_t x = 0; x < buffer.width; ++x) {
+				acc   += row[x];
+				out[x] = std::abs(acc) >= 0.5f ? 255 : 0;
+			}
+		} else {
+			for (uint32_t x = 0; x < buffer.width; ++x) {
+				acc   += row[x];
+				out[x] = static_cast<uint8_t>(std::min(std::abs(acc), 1.f) * 255.f + 0.5f);
+			}
+		}
+
+		memset(row, 0, buffer.stride * sizeof(float));
+	}
+}
+
+extent2d GlyphRasterizer::getGlyphExtent(const Glyph& glyph, float scale) VERA_NOEXCEPT
+{
+	if (glyph.contours.empty()) return { 0, 0 };
+
+	const float2 size = glyph.aabb.size() * scale;
+
+	return {
+		std::max(1u, static_cast<uint32_t>(std::ceil(size.x))),
+		std::max(1u, static_cast<uint32_t>(std::ceil(size.y)))
+	};
+}
+
+GlyphRasterizer::GlyphRasterizer(GlyphMaskType type) VERA_NOEXCEPT :
+	m_type(type) {}
+
+void GlyphRasterizer::rasterize(void* dst, size_t row_pitch, const Glyph& glyph, float scale)
+{
+	const extent2d extent = getGlyphExtent(glyph, scale);
+
+	if (extent.width == 0) return;
+
+	CellBuffer buffer;
+	buffer.width  = extent.width;
+	buffer.height = extent.height;
+	buffer.stride = extent.width + 2;
+
+	const size_t cell_count = static_cast<size_t>(buffer.stride) * buffer.height;
+
+	// grown cells are zeroed by the vector and resolve_cells zeroes the ones it reads
+	if (m_cells.size() < cell_count)
+		m_cells.resize(cell_count);
+
+	buffer.cells = m_cells.data();
+
+	GlyphTransform transform;
+	transform.origin = float2(glyph.aabb.min().x, glyph.aabb.max().y);
+	transform.scale  = scale;
+
+	for (const auto& contour : glyph.contours)
+		accumulate_contour(buffer, contour, transform);
+
+	resolve_cells(static_cast<uint8_t*>(dst), row_pitch, buffer, m_type);
+}
+
+Image GlyphRasterizer::rasterize(const Glyph& glyph, float scale)
+{
+	const extent2d extent = getGlyphExtent(glyph, scale);
+
+	if (extent.width == 0) return {};
+
+	Image image(extent.width, extent.height, Format::R8Unorm);
+	rasterize(image.data(), extent.width, glyph, scale);
+
+	return image;
+}
+
+GlyphMaskType GlyphRasterizer::getMaskType() const VERA_NOEXCEPT
+{
+	return m_type;
+}
+
+static void append_mask_layer(std::vector<Image>& layers, const RectPacker& packer)
+{
+	auto& layer = layers.emplace_back(packer.getWidth(), packer.getHeight(), Format::R8Unorm);
+	memset(layer.data(), 0, layer.size());
+}
+
+uint32_t bake_glyph_masks(
+	std::vector<Image>&       layers,
+	RectPacker&               packer,
+	std::vector<PackedGlyph>& out_glyphs,
+	array_view<const Glyph*>  glyphs,
+	const GlyphMaskBakeInfo&  info
+) {
+	const size_t first_glyph = out_glyphs.size();
+	uint32_t     first_layer = UINT32_MAX;
+
+	out_glyphs.reserve(out_glyphs.size() + glyphs.size());
+
+	if (layers.empty())
+		append_mask_layer(layers, packer);
+
+	// packing is sequential, the glyphs are rasterized once their rects are known
+	for (const Glyph* glyph : glyphs) {
+		const extent2d extent = GlyphRasterizer::getGlyphExtent(*glyph, info.scale);
+
+		auto& packed = out_glyphs.emplace_back();
+		packed.glyphID = glyph->glyphID;
+		packed.px      = info.px;
+		packed.layer   = static_cast<uint32_t>(layers.size() - 1);
+		packed.rect    = AABB2D(0.f, 0.f, 0.f, 0.f);
+
+		if (extent.width == 0) continue;
+
+		urect2d rect;
+		if (!packer.pack(extent, rect)) {
+			packer.clear();
+
+			if (!packer.pack(extent, rect))
+				throw Exception("unable to pack glyph into the atlas layer");
+
+			append_mask_layer(layers, packer);
+		}
+
+		packed.layer = static_cast<uint32_t>(layers.size() - 1);
+		packed.rect  = AABB2D(
+			static_cast<float>(rect.min_x()),
+			static_cast<float>(rect.min_y()),
+			static_cast<float>(rect.max_x()),
+			static_cast<float>(rect.max_y()));
+
+		first_layer = std::min(first_layer, packed.layer);
+	}
+
+	if (first_layer == UINT32_MAX)
+		return static_cast<uint32_t>(layers.size());
+
+	bake_glyph_masks(
+		layers,
+		array_view<PackedGlyph>(out_glyphs.data() + first_glyph, glyphs.size()),
+		glyphs,
+		info);
+
+	return first_layer;
+}
+
+void bake_glyph_masks(
+	std::vector<Image>&      layers,
+	array_view<PackedGlyph>  packed_glyphs,
+	array_view<const Glyph*> glyphs,
+	const GlyphMaskBakeInfo& info
+) {
+	VERA_ASSERT_MSG(packed_glyphs.size() == glyphs.size(), "every glyph needs a packed rect");
+
+	// every glyph owns its rect, so threads write disjoint texels of the layers
+	parallel_for(static_cast<uint32_t>(glyphs.size()), GLYPHS_PER_TASK, [&](uint32_t begin, uint32_t end) {
+		GlyphRasterizer rasterizer(info.type);
+
+		for (uint32_t i = begin; i < end; ++i) {
+			const PackedGlyph& packed = packed_glyphs[i];
+			const float2       size   = packed.rect.size();
+
+			if (size.x <= 0.f || size.y <= 0.f) continue;
+
+			Image&   layer = layers[packed.layer];
+			uint8_t* dst   = static_cast<uint8_t*>(layer.data());
+
+			dst += static_cast<size_t>(packed.rect.min().y) * layer.width() + static_cast<size_t>(packed.rect.min().x);
+
+			rasterizer.rasterize(dst, layer.width(), *glyphs[i], info.scale);
+		}
+	});
+}
+
+VERA_NAMESPACE_END
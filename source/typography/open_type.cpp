@@ -1,11 +1,15 @@
 #include "open_type.h"
 
 #include "../../include/vera/core/exception.h"
-#include "../../include/vera/util/static_vector.h"
+#include "../util/parallel_for.h"
 #include "../parse.h"
 #include <algorithm>
+#include <bit>
+#include <exception>
 
-#define MAX_CONTOUR_COUNT 128
+#define GLYPHS_PER_TASK           256
+#define LOOKUP_FLAG_REQUIRED      0x1 // applied whenever the font is shaped
+#define LOOKUP_FLAG_DISCRETIONARY 0x2 // ligatures and kerning the layout may turn off
 
 #define CHECK(expression)                          \
 	do {                                               \
@@ -200,6 +204,399 @@ static uint32_t parse_glyph_header(OTFGlyphHeader& header, const uint8_t* data,
 	return offset;
 }
 
+// size of a component record without its instructions
+static uint32_t get_glyph_component_size(const uint8_t* data, uint32_t offset)
+{
+	auto     flags = parse_enum_be<OTFComponentGlyphFlagBits>(data, offset);
+	uint32_t size  = sizeof(OTFUint16) * 2;
+
+	size += has_flag(flags, OTFComponentGlyphFlagBits::Arg1And2AreWords) ? 4 : 2;
+
+	if (has_flag(flags, OTFComponentGlyphFlagBits::WeHaveAScale))
+		size += 2;
+	else if (has_flag(flags, OTFComponentGlyphFlagBits::WeHaveAnXAndYScale))
+		size += 4;
+	else if (has_flag(flags, OTFComponentGlyphFlagBits::WeHaveATwoByTwo))
+		size += 8;
+
+	return size;
+}
+
+// transform is the row major 2x2 matrix followed by the offset
+static uint32_t parse_glyph_component(
+	OTFComponentGlyphFlagBits& flags,
+	OTFGlyphID&                glyph_id,
+	float                      transform[6],
+	const uint8_t*             data,
+	uint32_t                   offset
+) {
+	float arg1;
+	float arg2;
+
+	flags    = parse_enum_be<OTFComponentGlyphFlagBits>(data, offset);
+	glyph_id = parse_u16_be(data, offset);
+
+	transform[0] = 1.f;
+	transform[1] = 0.f;
+	transform[2] = 0.f;
+	transform[3] = 1.f;
+	transform[4] = 0.f;
+	transform[5] = 0.f;
+
+	if (has_flag(flags, OTFComponentGlyphFlagBits::Arg1And2AreWords)) {
+		if (has_flag(flags, OTFComponentGlyphFlagBits::ArgsAreXYValues)) {
+			arg1 = static_cast<float>(parse_i16_be(data, offset));
+			arg2 = static_cast<float>(parse_i16_be(data, offset));
+		} else {
+			arg1 = static_cast<float>(parse_u16_be(data, offset));
+			arg2 = static_cast<float>(parse_u16_be(data, offset));
+		}
+	} else {
+		if (has_flag(flags, OTFComponentGlyphFlagBits::ArgsAreXYValues)) {
+			arg1 = static_cast<float>(parse_i8_be(data, offset));
+			arg2 = static_cast<float>(parse_i8_be(data, offset));
+		} else {
+			arg1 = static_cast<float>(parse_u8_be(data, offset));
+			arg2 = static_cast<float>(parse_u8_be(data, offset));
+		}
+	}
+
+	if (has_flag(flags, OTFComponentGlyphFlagBits::WeHaveAScale)) {
+		float scale = f2dot14_to_float(parse_i16_be(data, offset));
+
+		transform[0] = scale;
+		transform[3] = scale;
+	} else if (has_flag(flags, OTFComponentGlyphFlagBits::WeHaveAnXAndYScale)) {
+		transform[0] = f2dot14_to_float(parse_i16_be(data, offset));
+		transform[3] = f2dot14_to_float(parse_i16_be(data, offset));
+	} else if (has_flag(flags, OTFComponentGlyphFlagBits::WeHaveATwoByTwo)) {
+		transform[0] = f2dot14_to_float(parse_i16_be(data, offset));
+		transform[1] = f2dot14_to_float(parse_i16_be(data, offset));
+		transform[2] = f2dot14_to_float(parse_i16_be(data, offset));
+		transform[3] = f2dot14_to_float(parse_i16_be(data, offset));
+	}
+
+	if (has_flag(flags, OTFComponentGlyphFlagBits::ArgsAreXYValues)) {
+		transform[4] = arg1;
+		transform[5] = arg2;
+
+		if (has_flag(flags, OTFComponentGlyphFlagBits::ScaledComponentOffset)) {
+			transform[4] *= transform[0];
+			transform[5] *= transform[3];
+		}
+	}
+
+	return offset;
+}
+
+static uint32_t parse_layout_table_header(OTFLayoutTableHeader& header, const uint8_t* data, uint32_t offset)
+{
+	header.majorVersion      = parse_u16_be(data, offset);
+	header.minorVersion      = parse_u16_be(data, offset);
+	header.scriptListOffset  = parse_u16_be(data, offset);
+	header.featureListOffset = parse_u16_be(data, offset);
+	header.lookupListOffset  = parse_u16_be(data, offset);
+	return offset;
+}
+
+static uint32_t parse_lookup_header(OTFLookupHeader& header, const uint8_t* data, uint32_t offset)
+{
+	header.lookupType    = parse_u16_be(data, offset);
+	header.lookupFlag    = parse_u16_be(data, offset);
+	header.subTableCount = parse_u16_be(data, offset);
+	return offset;
+}
+
+static uint32_t parse_kern_subtable_header(OTFKERNSubtableHeader& header, const uint8_t* data, uint32_t offset)
+{
+	header.version  = parse_u16_be(data, offset);
+	header.length   = parse_u16_be(data, offset);
+	header.coverage = parse_u16_be(data, offset);
+	return offset;
+}
+
+static bool in_bounds(size_t size, uint32_t offset, size_t length)
+{
+	return static_cast<size_t>(offset) + length <= size;
+}
+
+// Glyphs of a coverage table in coverage index order, which is ascending glyph order.
+static OTFResult parse_coverage(std::vector<uint16_t>& glyphs, const uint8_t* data, size_t size, uint32_t offset)
+{
+	if (!in_bounds(size, offset, 4))
+		return { OTFResultType::OutOfBounds, "coverage table out of bounds" };
+
+	uint16_t format = parse_u16_be(data, offset);
+	uint16_t count  = parse_u16_be(data, offset);
+
+	glyphs.clear();
+
+	if (format == 1) {
+		if (!in_bounds(size, offset, count * 2))
+			return { OTFResultType::OutOfBounds, "coverage glyph array out of bounds" };
+
+		for (uint16_t i = 0; i < count; ++i)
+			glyphs.push_back(parse_u16_be(data, offset));
+	} else if (format == 2) {
+		if (!in_bounds(size, offset, count * 6))
+			return { OTFResultType::OutOfBounds, "coverage range records out of bounds" };
+
+		for (uint16_t i = 0; i < count; ++i) {
+			uint16_t start       = parse_u16_be(data, offset);
+			uint16_t end         = parse_u16_be(data, offset);
+			uint16_t start_index = parse_u16_be(data, offset);
+
+			if (end < start) continue;
+
+			glyphs.resize(std::max<size_t>(glyphs.size(), start_index + end - start + 1));
+
+			for (uint32_t glyph = start; glyph <= end; ++glyph)
+				glyphs[start_index + glyph - start] = static_cast<uint16_t>(glyph);
+		}
+	} else {
+		return { OTFResultType::InvalidFormat, "invalid coverage table format" };
+	}
+
+	return OTFResultType::Success;
+}
+
+// Class ranges sorted by glyph, class 0 is left out since it is what every other glyph gets.
+static OTFResult parse_class_def(std::vector<ClassRange>& ranges, const uint8_t* data, size_t size, uint32_t offset)
+{
+	if (!in_bounds(size, offset, 4))
+		return { OTFResultType::OutOfBounds, "class definition table out of bounds" };
+
+	uint16_t format = parse_u16_be(data, offset);
+
+	ranges.clear();
+
+	if (format == 1) {
+		uint16_t start_glyph = parse_u16_be(data, offset);
+		uint16_t count       = parse_u16_be(data, offset);
+
+		if (!in_bounds(size, offset, count * 2))
+			return { OTFResultType::OutOfBounds, "class value array out of bounds" };
+
+		for (uint16_t i = 0; i < count; ++i) {
+			uint16_t glyph = static_cast<uint16_t>(start_glyph + i);
+			uint16_t value = parse_u16_be(data, offset);
+
+			if (value == 0) continue;
+
+			if (!ranges.empty() && ranges.back().last + 1 == glyph && ranges.back().value == value)
+				ranges.back().last = glyph;
+			else
+				ranges.push_back(ClassRange{ glyph, glyph, value });
+		}
+	} else if (format == 2) {
+		uint16_t count = parse_u16_be(data, offset);
+
+		if (!in_bounds(size, offset, count * 6))
+			return { OTFResultType::OutOfBounds, "class range records out of bounds" };
+
+		for (uint16_t i = 0; i < count; ++i) {
+			ClassRange range;
+			range.first = parse_u16_be(data, offset);
+			range.last  = parse_u16_be(data, offset);
+			range.value = parse_u16_be(data, offset);
+
+			if (range.value != 0 && range.first <= range.last)
+				ranges.push_back(range);
+		}
+
+		std::sort(VERA_SPAN(ranges), [](const ClassRange& lhs, const ClassRange& rhs) {
+			return lhs.first < rhs.first;
+		});
+	} else {
+		return { OTFResultType::InvalidFormat, "invalid class definition table format" };
+	}
+
+	return OTFResultType::Success;
+}
+
+// Marks the lookups the selected features of the default language system reference, the 'DFLT'
+// script is preferred over 'latn' and then over the first script of the font.
+static OTFResult select_feature_lookups(
+	std::vector<uint8_t>&       lookup_flags,
+	const uint8_t*              data,
+	size_t                      size,
+	const OTFLayoutTableHeader& header,
+	array_view<OTFFeatureTag>   features,
+	array_view<uint8_t>         feature_flags
+) {
+	uint32_t offset = header.scriptListOffset;
+
+	if (!in_bounds(size, offset, 2))
+		return { OTFResultType::OutOfBounds, "script list out of bounds" };
+
+	uint16_t script_count = parse_u16_be(data, offset);
+	uint32_t dflt_offset  = 0;
+	uint32_t latn_offset  = 0;
+	uint32_t first_offset = 0;
+
+	if (!in_bounds(size, offset, script_count * 6))
+		return { OTFResultType::OutOfBounds, "script records out of bounds" };
+
+	for (uint16_t i = 0; i < script_count; ++i) {
+		auto     tag    = parse_enum_be<OTFScriptTag>(data, offset);
+		uint32_t record = header.scriptListOffset + parse_u16_be(data, offset);
+
+		if (i == 0)
+			first_offset = record;
+		if (tag == OTFScriptTag::DFLT)
+			dflt_offset = record;
+		if (tag == OTFScriptTag::LATN)
+			latn_offset = record;
+	}
+
+	uint32_t script_offset = dflt_offset ? dflt_offset : latn_offset ? latn_offset : first_offset;
+
+	if (script_offset == 0) return OTFResultType::Success;
+
+	offset = script_offset;
+
+	if (!in_bounds(size, offset, 4))
+		return { OTFResultType::OutOfBounds, "script table out of bounds" };
+
+	uint16_t default_lang_sys = parse_u16_be(data, offset);
+	uint16_t lang_sys_count   = parse_u16_be(data, offset);
+	uint32_t lang_sys_offset  = script_offset + default_lang_sys;
+
+	if (default_lang_sys == 0) {
+		if (lang_sys_count == 0 || !in_bounds(size, offset, 6))
+			return OTFResultType::Success;
+
+		offset         += sizeof(OTFUint32);
+		lang_sys_offset = script_offset + parse_u16_be(data, offset);
+	}
+
+	offset = lang_sys_offset;
+
+	if (!in_bounds(size, offset, 6))
+		return { OTFResultType::OutOfBounds, "language system table out of bounds" };
+
+/*  OTFOffset16 lookupOrderOffset = parse_u16_be(data, offset); */ offset += sizeof(OTFUint16);
+	uint16_t required_feature = parse_u16_be(data, offset);
+	uint16_t feature_count    = parse_u16_be(data, offset);
+
+	if (!in_bounds(size, offset, feature_count * 2))
+		return { OTFResultType::OutOfBounds, "feature indices out of bounds" };
+
+	std::vector<uint16_t> feature_indices;
+	feature_indices.reserve(feature_count + 1);
+
+	if (required_feature != 0xFFFF)
+		feature_indices.push_back(required_feature);
+
+	for (uint16_t i = 0; i < feature_count; ++i)
+		feature_indices.push_back(parse_u16_be(data, offset));
+
+	uint32_t feature_list = header.featureListOffset;
+
+	if (!in_bounds(size, feature_list, 2))
+		return { OTFResultType::OutOfBounds, "feature list out of bounds" };
+
+	offset = feature_list;
+
+	uint16_t total_features = parse_u16_be(data, offset);
+
+	for (uint16_t feature_idx : feature_indices) {
+		if (feature_idx >= total_features) continue;
+
+		offset = feature_list + 2 + feature_idx * 6;
+
+		if (!in_bounds(size, offset, 6))
+			return { OTFResultType::OutOfBounds, "feature record out of bounds" };
+
+		auto     tag             = parse_enum_be<OTFFeatureTag>(data, offset);
+		uint32_t feature_offset  = feature_list + parse_u16_be(data, offset);
+		auto     it              = std::find(VERA_SPAN(features), tag);
+
+		if (it == features.end()) continue;
+
+		uint8_t flag = feature_flags[it - features.begin()];
+
+		offset = feature_offset;
+
+		if (!in_bounds(size, offset, 4))
+			return { OTFResultType::OutOfBounds, "feature table out of bounds" };
+
+/*      OTFOffset16 featureParamsOffset = parse_u16_be(data, offset); */ offset += sizeof(OTFUint16);
+		uint16_t lookup_count = parse_u16_be(data, offset);
+
+		if (!in_bounds(size, offset, lookup_count * 2))
+			return { OTFResultType::OutOfBounds, "feature lookup indices out of bounds" };
+
+		for (uint16_t i = 0; i < lookup_count; ++i) {
+			uint16_t lookup_idx = parse_u16_be(data, offset);
+
+			if (lookup_idx < lookup_flags.size())
+				lookup_flags[lookup_idx] |= flag;
+		}
+	}
+
+	return OTFResultType::Success;
+}
+
+// Resolves extension subtables, every subtable offset is returned relative to the table start.
+static OTFResult get_lookup_subtables(
+	uint16_t&              lookup_type,
+	std::vector<uint32_t>& subtables,
+	const uint8_t*         data,
+	size_t                 size,
+	uint32_t               lookup_offset,
+	uint16_t               extension_type
+) {
+	OTFLookupHeader header;
+
+	if (!in_bounds(size, lookup_offset, 6))
+		return { OTFResultType::OutOfBounds, "lookup table out of bounds" };
+
+	uint32_t offset = parse_lookup_header(header, data, lookup_offset);
+
+	if (!in_bounds(size, offset, header.subTableCount * 2))
+		return { OTFResultType::OutOfBounds, "lookup subtable offsets out of bounds" };
+
+	lookup_type = header.lookupType;
+	subtables.clear();
+
+	for (uint16_t i = 0; i < header.subTableCount; ++i)
+		subtables.push_back(lookup_offset + parse_u16_be(data, offset));
+
+	if (lookup_type != extension_type) return OTFResultType::Success;
+
+	for (auto& subtable : subtables) {
+		offset = subtable;
+
+		if (!in_bounds(size, offset, 8))
+			return { OTFResultType::OutOfBounds, "extension subtable out of bounds" };
+
+/*      OTFUint16 format = parse_u16_be(data, offset); */ offset += sizeof(OTFUint16);
+		lookup_type = parse_u16_be(data, offset);
+		subtable   += parse_u32_be(data, offset);
+	}
+
+	return OTFResultType::Success;
+}
+
+static uint32_t get_value_record_size(uint16_t value_format)
+{
+	return 2 * std::popcount(static_cast<uint16_t>(value_format & 0xFF));
+}
+
+static int16_t parse_x_advance(const uint8_t* data, uint32_t offset, uint16_t value_format)
+{
+	if (!(value_format & static_cast<uint16_t>(OTFValueFormatBits::XAdvance)))
+		return 0;
+
+	constexpr uint16_t placement_bits =
+		static_cast<uint16_t>(OTFValueFormatBits::XPlacement) |
+		static_cast<uint16_t>(OTFValueFormatBits::YPlacement);
+
+	offset += get_value_record_size(value_format & placement_bits);
+	return parse_i16_be(data, offset);
+}
+
 static bool supported_cmap_encoding_format4(OTFEncodingID encoding_id) {
 	switch (encoding_id) {
 	case OTFEncodingID::Unicode_1_0_Semantics:
@@ -215,6 +612,25 @@ static bool supported_cmap_encoding_format4(OTFEncodingID encoding_id) {
 	}
 }
 
+// Subtables this implementation can look up in place, higher ranks cover more codepoints and 0 is
+// unsupported. Symbol and legacy encodings are never picked.
+static uint32_t get_cmap_subtable_rank(OTFCMAPFormat format, OTFEncodingID encoding_id)
+{
+	switch (format) {
+	case OTFCMAPFormat::SegmentedCoverage:
+		return
+			encoding_id == OTFEncodingID::Unicode_Full_Repertoire ||
+			encoding_id == OTFEncodingID::Unicode_ISO_10646 ||
+			encoding_id == OTFEncodingID::Windows_Uniocde_Full_Repertoire ? 3 : 0;
+	case OTFCMAPFormat::SegmentMappingToDeltaValues:
+		return supported_cmap_encoding_format4(encoding_id) ? 2 : 0;
+	case OTFCMAPFormat::TrimmedTableMapping:
+		return supported_cmap_encoding_format4(encoding_id) ? 1 : 0;
+	default:
+		return 0;
+	}
+}
+
 static bool compare_name_entry(const OTFNameEntry& a, const OTFNameEntry& b) {
 	if (a.platformID != b.platformID)
 		return a.platformID < b.platformID;
@@ -512,22 +928,21 @@ std::vector<uint32_t> OpenTypeImpl::getTTCFontOffsets(const uint8_t* data, const
 	return result;
 }
 
-OpenTypeImpl::OpenTypeImpl(const uint8_t* data, size_t size, uint32_t offset)
+OpenTypeImpl::OpenTypeImpl(FileRef file_ref, uint32_t offset) :
+	file(std::move(file_ref))
 {
-	const uint8_t* ttc_data = data;
+	const uint8_t* data = file->data();
+	const size_t   size = file->size();
 
-	data += offset;
-	size -= offset;
-
-	if (size < sizeof(TTFHeader))
+	if (size < offset + sizeof(TTFHeader))
 		throw Exception("data size too small for TTF header");
 
 	TTFHeader      header;
 	OTFTableRecord record;
 
-	offset = parse_ttf_header(header, data, 0);
+	offset = parse_ttf_header(header, data, offset);
 
-	if (size < sizeof(TTFHeader) + header.numTables * sizeof(OTFTableRecord))
+	if (size < offset + header.numTables * sizeof(OTFTableRecord))
 		throw Exception("data size too small for TTF table records");
 
 	for (uint16_t i = 0; i < header.numTables; ++i) {
@@ -535,15 +950,12 @@ OpenTypeImpl::OpenTypeImpl(const uint8_t* data, size_t size, uint32_t offset)
 		tableMap[record.tableTag] = record;
 	}
 
-	if (OTFResult result = parseTable(ttc_data, size); result != OTFResultType::Success) {
+	// table offsets are relative to the start of the file, also for faces of a collection
+	if (OTFResult result = parseTable(data, size); result != OTFResultType::Success) {
 		postScript.glyphNames.clear();
 		tableMap.clear();
-		charToGlyphMap.clear();
-		glyphs.clear();
 		nameEntries.clear();
 		languageTags.clear();
-		glyphOffsets.clear();
-		glyphBinary.clear();
 		controlValues.clear();
 		programData.clear();
 
@@ -573,16 +985,55 @@ std::string_view OpenTypeImpl::getName() const VERA_NOEXCEPT
 
 void OpenTypeImpl::loadAllGlyphs()
 {
-	for (GlyphID glyph_id = 0; glyph_id < maxProfile.numGlyphs; ++glyph_id)
-		if (OTFResult result = loadGlyph(glyph_id); result != OTFResultType::Success)
-			throw Exception("failed to load glyph ID {}: {}", glyph_id, result.what());
+	if (maxProfile.numGlyphs != 0)
+		loadGlyphRange({ 0, maxProfile.numGlyphs });
 }
 
 void OpenTypeImpl::loadGlyphRange(const basic_range<GlyphID>& range)
 {
+	if (range.empty()) return;
+
 	if (maxProfile.numGlyphs < range.last())
 		throw Exception("glyph ID range out of bounds");
 
+	allocateGlyphs();
+
+	std::exception_ptr error;
+	std::mutex         arena_mutex;
+
+	// simple glyphs only touch their own directory entry and the arena of their slice, composites
+	// read their components and are loaded on this thread afterwards
+	parallel_for(static_cast<uint32_t>(range.size()), GLYPHS_PER_TASK, [&](uint32_t begin, uint32_t end) {
+		GlyphArena arena;
+
+		try {
+			for (uint32_t i = begin; i < end; ++i)
+				(void)loadGlyph(range.first() + i, arena, false);
+
+			std::lock_guard<std::mutex> lock(arena_mutex);
+			glyphArena.merge(std::move(arena));
+		} catch (...) {
+			// the glyphs of this slice view its arena, which is gone once the slice returns
+			for (uint32_t i = begin; i < end; ++i) {
+				GlyphID glyph_id = range.first() + i;
+
+				if (glyphStates[glyph_id] == OTFGlyphState::Loading ||
+					arena.owns(glyphs[glyph_id].contours.ends().data())) {
+					glyphs[glyph_id]      = Glyph{};
+					glyphStates[glyph_id] = OTFGlyphState::Unloaded;
+				}
+			}
+
+			std::lock_guard<std::mutex> lock(arena_mutex);
+			if (!error)
+				error = std::current_exception();
+		}
+	});
+
+	if (error)
+		std::rethrow_exception(error);
+
+	// also reports the glyphs that failed above
 	for (GlyphID glyph_id : range)
 		if (OTFResult result = loadGlyph(glyph_id); result != OTFResultType::Success)
 			throw Exception("failed to load glyph ID {}: {}", glyph_id, result.what());
@@ -590,18 +1041,23 @@ void OpenTypeImpl::loadGlyphRange(const basic_range<GlyphID>& range)
 
 void OpenTypeImpl::loadCodeRange(const CodeRange& range)
 {
-	if (range == CodeRange(UnicodeRange::ALL))
+	if (range == CodeRange(UnicodeRange::ALL)) {
+		loadAllGlyphs();
+		return;
+	}
 
-	if (range.end() > 0x10FFFF)
+	if (range.empty()) return;
+
+	if (range.last() > 0x110000)
 		throw Exception("codepoint range out of bounds");
 
+	// ranges span whole unicode blocks, codepoints the font does not map are skipped
 	for (char32_t codepoint : range) {
-		auto it = charToGlyphMap.find(codepoint);
+		GlyphID glyph_id;
 
-		if (it == charToGlyphMap.cend())
-			throw Exception("codepoint not found in character map");
+		if (!tryGetGlyphID(codepoint, glyph_id)) continue;
 		
-		if (OTFResult result = loadGlyph(it->second); result != OTFResultType::Success)
+		if (OTFResult result = loadGlyph(glyph_id); result != OTFResultType::Success)
 			throw Exception("failed to load glyph for codepoint U+{:04X}: {}",
 				static_cast<uint32_t>(codepoint), result.what());
 	}
@@ -614,12 +1070,38 @@ uint32_t OpenTypeImpl::getGlyphCount() const VERA_NOEXCEPT
 
 GlyphID OpenTypeImpl::getGlyphID(char32_t codepoint) const
 {
-	auto it = charToGlyphMap.find(codepoint);
+	GlyphID glyph_id;
 	
-	if (it == charToGlyphMap.cend())
+	if (!tryGetGlyphID(codepoint, glyph_id))
 		throw Exception("codepoint not found in character map");
 	
-	return it->second;
+	return glyph_id;
+}
+
+bool OpenTypeImpl::tryGetGlyphID(char32_t codepoint, GlyphID& glyph_id) const VERA_NOEXCEPT
+{
+	OTFGlyphID result;
+
+	switch (charMapFormat) {
+	case OTFCMAPFormat::SegmentMappingToDeltaValues:
+		result = findCmapFormat4(codepoint);
+		break;
+	case OTFCMAPFormat::TrimmedTableMapping:
+		result = findCmapFormat6(codepoint);
+		break;
+	case OTFCMAPFormat::SegmentedCoverage:
+		result = findCmapFormat12(codepoint);
+		break;
+	default:
+		return false;
+	}
+
+	// glyph 0 is the missing glyph, the codepoint is not mapped then
+	if (result == 0 || maxProfile.numGlyphs <= result)
+		return false;
+
+	glyph_id = result;
+	return true;
 }
 
 const Glyph& OpenTypeImpl::findGlyph(GlyphID glyph_id) const
@@ -627,12 +1109,10 @@ const Glyph& OpenTypeImpl::findGlyph(GlyphID glyph_id) const
 	if (glyph_id >= maxProfile.numGlyphs)
 		throw Exception("glyph ID out of bounds");
 
-	auto it = glyphs.find(glyph_id);
-
-	if (it == glyphs.cend())
+	if (glyphStates.empty() || glyphStates[glyph_id] != OTFGlyphState::Loaded)
 		throw Exception("glyph not loaded");
 
-	return it->second;
+	return glyphs[glyph_id];
 }
 
 const Glyph& OpenTypeImpl::getGlyph(GlyphID glyph_id)
@@ -640,18 +1120,10 @@ const Glyph& OpenTypeImpl::getGlyph(GlyphID glyph_id)
 	if (glyph_id >= maxProfile.numGlyphs)
 		throw Exception("glyph ID out of bounds");
 
-	auto it = glyphs.find(glyph_id);
-
-	if (it == glyphs.cend()) {
-		auto result = loadGlyph(glyph_id);
+	if (OTFResult result = loadGlyph(glyph_id); result != OTFResultType::Success)
+		throw Exception("failed to load glyph: " + std::string(result.what()));
 
-		if (result != OTFResultType::Success)
-			throw Exception("failed to load glyph: " + std::string(result.what()));
-		
-		return glyphs.find(glyph_id)->second;
-	}
-
-	return it->second;
+	return glyphs[glyph_id];
 }
 
 const Glyph& OpenTypeImpl::findGlyphByCodepoint(char32_t codepoint) const
@@ -664,104 +1136,204 @@ const Glyph& OpenTypeImpl::getGlyphByCodepoint(char32_t codepoint)
 	return getGlyph(getGlyphID(codepoint));
 }
 
+const ShapingTables& OpenTypeImpl::getShapingTables()
+{
+	std::call_once(shapingFlag, [this]() {
+		parseShapingTables(file->data(), file->size());
+	});
+
+	return shaping;
+}
+
+void OpenTypeImpl::allocateGlyphs()
+{
+	// the directory never grows afterwards, so references to loaded glyphs stay valid
+	if (glyphStates.empty()) {
+		glyphs.resize(maxProfile.numGlyphs);
+		glyphStates.resize(maxProfile.numGlyphs, OTFGlyphState::Unloaded);
+	}
+}
+
 OTFResult OpenTypeImpl::loadGlyph(uint32_t glyph_id)
 {
-	auto glyph_it = glyphs.find(glyph_id);
-	if (glyph_it != glyphs.cend())
+	return loadGlyph(glyph_id, glyphArena, true);
+}
+
+OTFResult OpenTypeImpl::loadGlyph(uint32_t glyph_id, GlyphArena& arena, bool load_composite)
+{
+	if (maxProfile.numGlyphs <= glyph_id)
+		return { OTFResultType::InvalidID, "glyph ID out of bounds" };
+
+	allocateGlyphs();
+
+	if (glyphStates[glyph_id] == OTFGlyphState::Loaded)
+		return OTFResultType::Success;
+	if (glyphStates[glyph_id] == OTFGlyphState::Loading)
+		return { OTFResultType::InvalidFormat, "composite glyph references itself" };
+
+	uint32_t glyph_begin;
+	uint32_t glyph_end;
+
+	CHECK(findGlyphLocation(glyph_id, glyph_begin, glyph_end));
+
+	Glyph& glyph = glyphs[glyph_id];
+
+	glyph         = Glyph{};
+	glyph.glyphID = glyph_id;
+
+	// glyphs without an outline like the space have no data at all
+	if (glyph_begin == glyph_end) {
+		glyphStates[glyph_id] = OTFGlyphState::Loaded;
 		return OTFResultType::Success;
+	}
 
-	glyph_it = glyphs.emplace(glyph_id, Glyph{}).first;
+	if (glyph_end - glyph_begin < sizeof(OTFInt16) * 5)
+		return { OTFResultType::InvalidSize, "glyph data too small for glyph header" };
 
 	OTFGlyphHeader glyph_header;
-	uint32_t       glyph_offset = glyphOffsets[glyph_id];
+	uint32_t       glyph_offset = parse_glyph_header(glyph_header, glyphData.data(), glyph_begin);
+	OTFResult      result;
+
+	if (glyph_header.numberOfContours < 0 && !load_composite)
+		return OTFResultType::Success;
 
-	glyph_offset = parse_glyph_header(glyph_header, glyphBinary.data(), glyph_offset);
+	glyphStates[glyph_id] = OTFGlyphState::Loading;
 
-	if (glyph_header.numberOfContours >= 0) {
-		CHECK(parseSimpleGlyph(
-			glyph_it->second,
-			glyph_header,
-			glyph_offset));
-	} else {
-		CHECK(parseCompositeGlyph(
-			glyph_it->second,
-			glyph_header,
-			glyph_offset));
+	if (glyph_header.numberOfContours >= 0)
+		result = parseSimpleGlyph(glyph, glyph_header, glyph_offset, glyph_end, arena);
+	else
+		result = parseCompositeGlyph(glyph, glyph_header, glyph_offset, glyph_end, arena);
+
+	if (result != OTFResultType::Success) {
+		glyph                 = Glyph{};
+		glyphStates[glyph_id] = OTFGlyphState::Unloaded;
+		return result;
 	}
 
-	glyph_it->second.glyphID = glyph_id;
-	glyph_it->second.aabb    = AABB2D{
+	glyph.aabb = AABB2D{
 		static_cast<float>(glyph_header.xMin),
 		static_cast<float>(glyph_header.yMin),
 		static_cast<float>(glyph_header.xMax),
 		static_cast<float>(glyph_header.yMax)
 	};
 
+	glyphStates[glyph_id] = OTFGlyphState::Loaded;
+
+	return OTFResultType::Success;
+}
+
+OTFResult OpenTypeImpl::findGlyphLocation(uint32_t glyph_id, uint32_t& begin, uint32_t& end) const
+{
+	if (maxProfile.numGlyphs <= glyph_id)
+		return { OTFResultType::InvalidID, "glyph ID out of bounds" };
+
+	const uint8_t* data = locationData.data();
+
+	if (header.indexToLocFormat == OTFIndexFormat::ShortOffsets) {
+		uint32_t offset = glyph_id * sizeof(OTFUint16);
+
+		begin = parse_u16_be(data, offset) * 2;
+		end   = parse_u16_be(data, offset) * 2;
+	} else {
+		uint32_t offset = glyph_id * sizeof(OTFUint32);
+
+		begin = parse_u32_be(data, offset);
+		end   = parse_u32_be(data, offset);
+	}
+
+	if (end < begin || glyphData.size() < end)
+		return { OTFResultType::OutOfBounds, "glyph location out of 'glyf' table" };
+
 	return OTFResultType::Success;
 }
 
-OTFResult OpenTypeImpl::parseSimpleGlyph(Glyph& glyph, const OTFGlyphHeader& glyph_header, uint32_t offset)
+OTFResult OpenTypeImpl::parseSimpleGlyph(Glyph& glyph, const OTFGlyphHeader& glyph_header, uint32_t offset, uint32_t end, GlyphArena& arena)
 {
-	static_vector<OTFUint16, MAX_CONTOUR_COUNT> end_indicies;
+	const uint32_t num_contours = glyph_header.numberOfContours;
+	const uint8_t* data         = glyphData.data();
 
-	uint32_t       num_contours = glyph_header.numberOfContours;
-	const uint8_t* data         = glyphBinary.data();
+	if (num_contours == 0)
+		return OTFResultType::Success;
+
+	if (end < offset + num_contours * sizeof(OTFUint16) + sizeof(OTFUint16))
+		return { OTFResultType::InvalidSize, "glyph data too small for contour end points" };
 
-	glyph.contours.resize(num_contours);
-	end_indicies.resize(num_contours);
-	parse_array_be(end_indicies.data(), num_contours, data, offset);
+	// end points are read in place, so any number of contours is fine
+	uint32_t end_offset  = offset;
+	uint32_t last_offset = offset + (num_contours - 1) * sizeof(OTFUint16);
+	uint32_t num_points  = static_cast<uint32_t>(parse_u16_be(data, last_offset)) + 1;
+
+	offset += num_contours * sizeof(OTFUint16);
 
 	OTFUint16 inst_length = parse_u16_be(data, offset);
 
+	if (end < offset + inst_length)
+		return { OTFResultType::InvalidSize, "glyph data too small for instructions" };
+
 	glyph.instructions = array_view<uint8_t>(data + offset, inst_length);
 	offset            += inst_length;
 
-	uint32_t point_count    = static_cast<uint32_t>(end_indicies.back() + 1);
+	uint32_t point_count    = num_points;
 	uint32_t x_point_offset = offset;
 	uint32_t y_point_offset = 0;
 	uint32_t x_point_size   = 0;
+	uint32_t y_point_size   = 0;
 
+	// the flags are followed by all x coordinates and then all y coordinates, sizes of both
+	// arrays are summed up front so each coordinate stream is read by its own cursor below
 	while (0 < point_count) {
-		OTFGlyphFlagBits flags = parse_enum_be<OTFGlyphFlagBits>(data, x_point_offset);
+		if (end <= x_point_offset)
+			return { OTFResultType::InvalidSize, "glyph data too small for flags" };
+
+		OTFGlyphFlagBits flags        = parse_enum_be<OTFGlyphFlagBits>(data, x_point_offset);
+		uint32_t         repeat_count = 1;
 
 		if (has_flag(flags, OTFGlyphFlagBits::RepeatFlag)) {
-			uint32_t repeat_count = static_cast<uint32_t>(parse_u8_be(data, x_point_offset) + 1);
+			if (end <= x_point_offset)
+				return { OTFResultType::InvalidSize, "glyph data too small for flags" };
 
-			if (point_count < repeat_count)
-				return { OTFResultType::InvalidFormat, "glyph data is corrupted" };
+			repeat_count = static_cast<uint32_t>(parse_u8_be(data, x_point_offset) + 1);
+		}
 
-			point_count -= repeat_count;
+		if (point_count < repeat_count)
+			return { OTFResultType::InvalidFormat, "glyph data is corrupted" };
 
-			if (has_flag(flags, OTFGlyphFlagBits::XShortVector))
-				x_point_size += repeat_count;
-			else if (!has_flag(flags, OTFGlyphFlagBits::XIsSameOrPositive))
-				x_point_size += repeat_count * sizeof(OTFInt16);
-		} else {
-			point_count -= 1;
+		point_count -= repeat_count;
 
-			if (has_flag(flags, OTFGlyphFlagBits::XShortVector))
-				x_point_size += 1;
-			else if (!has_flag(flags, OTFGlyphFlagBits::XIsSameOrPositive))
-				x_point_size += sizeof(OTFInt16);
-		}
+		if (has_flag(flags, OTFGlyphFlagBits::XShortVector))
+			x_point_size += repeat_count;
+		else if (!has_flag(flags, OTFGlyphFlagBits::XIsSameOrPositive))
+			x_point_size += repeat_count * sizeof(OTFInt16);
+
+		if (has_flag(flags, OTFGlyphFlagBits::YShortVector))
+			y_point_size += repeat_count;
+		else if (!has_flag(flags, OTFGlyphFlagBits::YIsSameOrPositive))
+			y_point_size += repeat_count * sizeof(OTFInt16);
 	}
 
 	y_point_offset = x_point_offset + x_point_size;
-	point_count    = static_cast<uint32_t>(end_indicies.back() + 1);
+	point_count    = num_points;
+
+	if (end < y_point_offset + y_point_size)
+		return { OTFResultType::InvalidSize, "glyph data too small for coordinates" };
 
 	OTFGlyphFlagBits flags;
-	float2           curr_point;
-	float2           prev_point;
-	float            delta_x;
-	float            delta_y;
-
-	auto     curr_path    = glyph.contours.begin();
-	auto     curr_end     = end_indicies.begin();
-	uint32_t point_comp   = 0;
-	uint32_t repeat_count = 0;
-	float    curr_x       = 0.f;
-	float    curr_y       = 0.f;
-	bool     on_curve     = false;
+	int32_t          delta_x;
+	int32_t          delta_y;
+
+	// repeated points are dropped, so the outline never needs more than the glyph declares
+	GlyphPoint* points = arena.allocate<GlyphPoint>(num_points);
+	uint32_t*   ends   = arena.allocate<uint32_t>(num_contours);
+
+	uint32_t contour_idx   = 0;
+	uint32_t contour_end   = parse_u16_be(data, end_offset);
+	uint32_t contour_count = 0;
+	uint32_t contour_first = 0;
+	uint32_t point_idx     = 0;
+	uint32_t repeat_count  = 0;
+	int32_t  curr_x        = 0;
+	int32_t  curr_y        = 0;
+	bool     on_curve      = false;
 
 	for (uint32_t i = 0; i < point_count; ++i) {
 		if (repeat_count == 0) {
@@ -775,146 +1347,129 @@ OTFResult OpenTypeImpl::parseSimpleGlyph(Glyph& glyph, const OTFGlyphHeader& gly
 			on_curve = has_flag(flags, OTFGlyphFlagBits::OnCurvePoint);
 		}
 
+		// short vectors are one unsigned byte with the sign in the flags, long ones a signed word
 		if (has_flag(flags, OTFGlyphFlagBits::XShortVector)) {
-			delta_x = static_cast<float>(static_cast<int32_t>(parse_u16_be(data, x_point_offset)));
+			delta_x = static_cast<int32_t>(parse_u8_be(data, x_point_offset));
 			delta_x = has_flag(flags, OTFGlyphFlagBits::XIsSameOrPositive) ? delta_x : -delta_x;
 		} else {
 			if (has_flag(flags, OTFGlyphFlagBits::XIsSameOrPositive))
-				delta_x = 0.f;
+				delta_x = 0;
 			else
-				delta_x = static_cast<float>(static_cast<int32_t>(parse_u32_be(data, x_point_offset)));
+				delta_x = static_cast<int32_t>(parse_i16_be(data, x_point_offset));
 		}
 
 		if (has_flag(flags, OTFGlyphFlagBits::YShortVector)) {
-			float delta_y = static_cast<float>(static_cast<int32_t>(parse_u16_be(data, y_point_offset)));
+			delta_y = static_cast<int32_t>(parse_u8_be(data, y_point_offset));
 			delta_y = has_flag(flags, OTFGlyphFlagBits::YIsSameOrPositive) ? delta_y : -delta_y;
 		} else {
 			if (has_flag(flags, OTFGlyphFlagBits::YIsSameOrPositive))
-				delta_y = 0.f;
+				delta_y = 0;
 			else
-				delta_y = static_cast<float>(static_cast<int32_t>(parse_u32_be(data, y_point_offset)));
+				delta_y = static_cast<int32_t>(parse_i16_be(data, y_point_offset));
 		}
 
-		if (delta_x != 0.f || delta_y != 0.f) {
-			curr_x += delta_x;
-			curr_y += delta_y;
-			curr_path->emplace_back(float2(curr_x, curr_y), on_curve);
-		}
+		curr_x += delta_x;
+		curr_y += delta_y;
 
-		if (i == *curr_end) {
-			point_comp = 0;
-			++curr_path;
-			++curr_end;
+		if (num_contours <= contour_idx)
+			return { OTFResultType::InvalidFormat, "glyph contour end points are not ascending" };
+
+		// repeated points only add degenerate segments, an on curve duplicate pins the previous point
+		if (point_idx == contour_first || delta_x != 0 || delta_y != 0)
+			points[point_idx++] = GlyphPoint{ float2(static_cast<float>(curr_x), static_cast<float>(curr_y)), on_curve };
+		else if (on_curve)
+			points[point_idx - 1].onCurve = true;
+
+		// empty contours are dropped
+		while (i == contour_end && contour_idx < num_contours) {
+			if (contour_first != point_idx)
+				ends[contour_count++] = point_idx;
+
+			contour_first = point_idx;
+
+			if (++contour_idx < num_contours)
+				contour_end = parse_u16_be(data, end_offset);
 		}
 
 		--repeat_count;
 	}
 
+	glyph.contours = GlyphContourList(points, ends, contour_count);
+
 	return OTFResultType::Success;
 }
 
-OTFResult OpenTypeImpl::parseCompositeGlyph(Glyph& glyph, const OTFGlyphHeader& glyph_header, uint32_t offset)
+OTFResult OpenTypeImpl::parseCompositeGlyph(Glyph& glyph, const OTFGlyphHeader& glyph_header, uint32_t offset, uint32_t end, GlyphArena& arena)
 {
 	OTFComponentGlyphFlagBits flags;
 	OTFGlyphID                glyph_id;
 
-	float transform[6] = { 1.f, 0.f, 0.f, 1.f, 0.f, 0.f };
-	float arg1;
-	float arg2;
+	float transform[6];
 
-	const uint8_t* data = glyphBinary.data();
+	const uint8_t* data          = glyphData.data();
+	uint32_t       first_offset  = offset;
+	uint32_t       point_count   = 0;
+	uint32_t       contour_count = 0;
 
+	// components are loaded and counted first, so the outline is allocated once
 	do {
-		flags    = parse_enum_be<OTFComponentGlyphFlagBits>(data, offset);
-		glyph_id = parse_u16_be(data, offset);
+		if (end < offset + sizeof(OTFUint16) * 2)
+			return { OTFResultType::InvalidSize, "glyph data too small for component" };
+		if (end < offset + get_glyph_component_size(data, offset))
+			return { OTFResultType::InvalidSize, "glyph data too small for component" };
 
-		if (has_flag(flags, OTFComponentGlyphFlagBits::Arg1And2AreWords)) {
-			if (has_flag(flags, OTFComponentGlyphFlagBits::ArgsAreXYValues)) {
-				arg1 = static_cast<float>(parse_i16_be(data, offset));
-				arg2 = static_cast<float>(parse_i16_be(data, offset));
-			} else {
-				arg1 = static_cast<float>(parse_u16_be(data, offset));
-				arg2 = static_cast<float>(parse_u16_be(data, offset));
-			}
-		} else {
-			if (has_flag(flags, OTFComponentGlyphFlagBits::ArgsAreXYValues)) {
-				arg1 = static_cast<float>(parse_i8_be(data, offset));
-				arg2 = static_cast<float>(parse_i8_be(data, offset));
-			} else {
-				arg1 = static_cast<float>(parse_u8_be(data, offset));
-				arg2 = static_cast<float>(parse_u8_be(data, offset));
-			}
-		}
-
-		if (has_flag(flags, OTFComponentGlyphFlagBits::WeHaveAScale)) {
-			float scale = f2dot14_to_float(parse_i16_be(data, offset));
-
-			transform[0] = scale;
-			transform[1] = 0.f;
-			transform[2] = 0.f;
-			transform[3] = scale;
-		} else if (has_flag(flags, OTFComponentGlyphFlagBits::WeHaveAnXAndYScale)) {
-			float x_scale = f2dot14_to_float(parse_i16_be(data, offset));
-			float y_scale = f2dot14_to_float(parse_i16_be(data, offset));
-
-			transform[0] = x_scale;
-			transform[1] = 0.f;
-			transform[2] = 0.f;
-			transform[3] = y_scale;
-		} else if (has_flag(flags, OTFComponentGlyphFlagBits::WeHaveATwoByTwo)) {
-			transform[0] = f2dot14_to_float(parse_i16_be(data, offset));
-			transform[1] = f2dot14_to_float(parse_i16_be(data, offset));
-			transform[2] = f2dot14_to_float(parse_i16_be(data, offset));
-			transform[3] = f2dot14_to_float(parse_i16_be(data, offset));
-		}
-
-		if (has_flag(flags, OTFComponentGlyphFlagBits::ArgsAreXYValues)) {
-			transform[4] = arg1;
-			transform[5] = arg2;
-
-			if (has_flag(flags, OTFComponentGlyphFlagBits::ScaledComponentOffset)) {
-				transform[4] *= transform[0];
-				transform[5] *= transform[3];
-			}
-		}
+		offset = parse_glyph_component(flags, glyph_id, transform, data, offset);
 
 		if (has_flag(flags, OTFComponentGlyphFlagBits::WeHaveInstructions)) {
+			if (end < offset + sizeof(OTFUint16))
+				return { OTFResultType::InvalidSize, "glyph data too small for instructions" };
+
 			OTFUint16 inst_length = parse_u16_be(data, offset);
 
+			if (end < offset + inst_length)
+				return { OTFResultType::InvalidSize, "glyph data too small for instructions" };
+
 			glyph.instructions = array_view<uint8_t>(data + offset, inst_length);
 			offset            += inst_length;
 		}
 
-		auto it = glyphs.find(glyph_id);
+		CHECK(loadGlyph(glyph_id, arena, true));
 
-		if (it == glyphs.end()) {
-			CHECK(loadGlyph(glyph_id));
-			it = glyphs.find(glyph_id);
-		}
+		const GlyphContourList& contours = glyphs[glyph_id].contours;
 
-		const Glyph& composite_glyph = it->second;
+		point_count   += static_cast<uint32_t>(contours.points().size());
+		contour_count += static_cast<uint32_t>(contours.size());
+	} while (has_flag(flags, OTFComponentGlyphFlagBits::MoreComponents));
+
+	GlyphPoint* points = arena.allocate<GlyphPoint>(point_count);
+	uint32_t*   ends   = arena.allocate<uint32_t>(contour_count);
 
-		if (composite_glyph.contours.empty())
-			return { OTFResultType::InvalidFormat, "invalid composite glyph component format" };
+	uint32_t point_idx   = 0;
+	uint32_t contour_idx = 0;
 
-		// TODO: optimize transform
+	offset = first_offset;
 
-		glyph.contours.reserve(glyph.contours.size() + composite_glyph.contours.size());
+	do {
+		offset = parse_glyph_component(flags, glyph_id, transform, data, offset);
 
-		for (const auto& contour : composite_glyph.contours) {
-			auto& curr_path = glyph.contours.emplace_back();
+		if (has_flag(flags, OTFComponentGlyphFlagBits::WeHaveInstructions))
+			offset += parse_u16_be(data, offset);
 
-			curr_path.reserve(contour.size());
+		const GlyphContourList& contours = glyphs[glyph_id].contours;
 
-			for (const auto& p : contour) {
-				float x = transform[0] * p.position.x + transform[1] * p.position.y + transform[4];
-				float y = transform[2] * p.position.x + transform[3] * p.position.y + transform[5];
+		for (const uint32_t contour_end : contours.ends())
+			ends[contour_idx++] = point_idx + contour_end;
 
-				curr_path.emplace_back(float2{ x, y }, p.onCurve);
-			}
+		for (const auto& p : contours.points()) {
+			float x = transform[0] * p.position.x + transform[1] * p.position.y + transform[4];
+			float y = transform[2] * p.position.x + transform[3] * p.position.y + transform[5];
+
+			points[point_idx++] = GlyphPoint{ float2{ x, y }, p.onCurve };
 		}
 	} while (has_flag(flags, OTFComponentGlyphFlagBits::MoreComponents));
 
+	glyph.contours = GlyphContourList(points, ends, contour_count);
+
 	return OTFResultType::Success;
 }
 
@@ -960,7 +1515,7 @@ OTFResult OpenTypeImpl::parseTable(const uint8_t* data, const size_t size)
 		if (size < it->second.offset + it->second.length)
 			return { OTFResultType::InvalidSize, "data size too small for 'hmtx' table" };
 
-		CHECK(parseHmtxTable(data + it->second.offset, it->second.length));
+		// metrics are only needed for shaping and parsed with the layout tables
 	} else {
 		return { OTFResultType::MissingTable, "missing 'hmtx' table" };
 	}
@@ -1021,13 +1576,56 @@ OTFResult OpenTypeImpl::parseTable(const uint8_t* data, const size_t size)
 		if (size < it->second.offset + it->second.length)
 			return { OTFResultType::InvalidSize, "data size too small for 'glyf' table" };
 
-		uint32_t offset = it->second.offset;
-		uint32_t length = it->second.length;
-
-		glyphBinary.assign(data + offset, data + offset + length);
+		// outlines are parsed in place on first use
+		glyphData = array_view<uint8_t>(data + it->second.offset, it->second.length);
 	} else {
 		return { OTFResultType::MissingTable, "missing 'glyf' table" };
 	}
+
+	return OTFResultType::Success;
+}
+
+OTFResult OpenTypeImpl::parseShapingTables(const uint8_t* data, const size_t size)
+{
+	// parseTable already checked the bounds of the table, glyphs without metrics do not advance
+	if (auto it = tableMap.find(OTFTableTag::HMTX); it != tableMap.cend()) {
+		if (parseHmtxTable(data + it->second.offset, it->second.length) != OTFResultType::Success)
+			horizontalMetrics = {};
+	}
+
+	shaping.ascender  = horizontalHeader.ascender;
+	shaping.descender = horizontalHeader.descender;
+	shaping.lineGap   = horizontalHeader.lineGap;
+	shaping.advances.resize(maxProfile.numGlyphs);
+
+	for (uint32_t i = 0; i < maxProfile.numGlyphs; ++i) {
+		const auto& metrics = horizontalMetrics.longHorMetrics;
+
+		if (!metrics.empty())
+			shaping.advances[i] = metrics[std::min<size_t>(i, metrics.size() - 1)].advanceWidth;
+	}
+
+	// layout tables are optional, a malformed one leaves the text unshaped instead of failing the font
+	if (auto it = tableMap.find(OTFTableTag::GSUB); it != tableMap.cend()) {
+		if (size < it->second.offset + it->second.length ||
+			parseGsubTable(data + it->second.offset, it->second.length) != OTFResultType::Success)
+			shaping.substitutions.clear();
+	}
+
+	if (auto it = tableMap.find(OTFTableTag::GPOS); it != tableMap.cend()) {
+		if (size < it->second.offset + it->second.length ||
+			parseGposTable(data + it->second.offset, it->second.length) != OTFResultType::Success)
+			shaping.kerning.clear();
+	}
+
+	// the legacy table only applies to fonts without GPOS kerning
+	if (auto it = tableMap.find(OTFTableTag::KERN); it != tableMap.cend() && shaping.kerning.empty()) {
+		if (size < it->second.offset + it->second.length ||
+			parseKernTable(data + it->second.offset, it->second.length) != OTFResultType::Success)
+			shaping.kerning.clear();
+	}
+
+	return OTFResultType::Success;
 }
 
 OTFResult OpenTypeImpl::parseHeadTable(const uint8_t* data, const size_t size)
@@ -1089,46 +1687,60 @@ OTFResult OpenTypeImpl::parseCmapTable(const uint8_t* data, const size_t size)
 {
 	OTFCMAPTableHeader header;
 	OTFEncodingRecord  encoding_record;
-	
+	OTFEncodingRecord  best_record = {};
+	OTFCMAPFormat      best_format = {};
+	uint32_t           best_rank   = 0;
+
+	if (size < sizeof(OTFUint16) * 2)
+		return { OTFResultType::InvalidSize, "data size too small for 'cmap' table" };
+
 	uint32_t encoding_offset = parse_cmap_table_header(header, data, 0);
 
+	if (size < encoding_offset + header.numSubtables * (sizeof(OTFUint16) * 2 + sizeof(OTFUint32)))
+		return { OTFResultType::InvalidSize, "data size too small for cmap encoding records" };
+
+	// a single unicode subtable is looked up in place, the one covering the most codepoints wins
 	for (uint16_t i = 0; i < header.numSubtables; ++i) {
 		encoding_offset = parse_encoding_record(encoding_record, data, encoding_offset);
 
-		uint32_t       subtable_offset = encoding_record.subtableOffset;
-		OTFCMAPFormat  format          = parse_enum_be<OTFCMAPFormat>(data, subtable_offset);
-		const uint8_t* subtable_data   = data + subtable_offset;
-		size_t         subtable_size   = size - subtable_offset;
-
-		// TODO: check size of subtable
-
-		switch (format) {
-		case OTFCMAPFormat::ByteEncodingTable:
-			return { OTFResultType::Unsupported, "unsupported cmap subtable format" };
-		case OTFCMAPFormat::HighByteMappingThroughTable:
-			return { OTFResultType::Unsupported, "unsupported cmap subtable format" };
-		case OTFCMAPFormat::SegmentMappingToDeltaValues:
-			CHECK(parseCmapFormat4(subtable_data, subtable_size, encoding_record));
-			break;
-		case OTFCMAPFormat::TrimmedTableMapping:
-			CHECK(parseCmapFormat6(subtable_data, subtable_size, encoding_record));
-			break;
-		case OTFCMAPFormat::Mixed16And32BitMapping:
-			return { OTFResultType::Unsupported, "unsupported cmap subtable format" };
-		case OTFCMAPFormat::TrimmedArray:
-			return { OTFResultType::Unsupported, "unsupported cmap subtable format" };
-		case OTFCMAPFormat::SegmentedCoverage:
-			CHECK(parseCmapFormat12(subtable_data, subtable_size, encoding_record));
-			break;
-		case OTFCMAPFormat::ManyToOneRangeMappings:
-			return { OTFResultType::Unsupported, "unsupported cmap subtable format" };
-		case OTFCMAPFormat::UnicodeVariationSequences:
-			return { OTFResultType::Unsupported, "unsupported cmap subtable format" };
-		default:
-			return { OTFResultType::InvalidFormat, "invalid cmap subtable format" };
+		uint32_t subtable_offset = encoding_record.subtableOffset;
+
+		if (size < subtable_offset + sizeof(OTFUint16))
+			return { OTFResultType::InvalidSize, "data size too small for cmap subtable" };
+
+		OTFCMAPFormat format = parse_enum_be<OTFCMAPFormat>(data, subtable_offset);
+		uint32_t      rank   = get_cmap_subtable_rank(format, encoding_record.encodingID);
+
+		if (best_rank < rank) {
+			best_record = encoding_record;
+			best_format = format;
+			best_rank   = rank;
 		}
 	}
 
+	if (best_rank == 0)
+		return { OTFResultType::Unsupported, "no supported unicode cmap subtable" };
+
+	uint32_t       subtable_offset = best_record.subtableOffset + sizeof(OTFUint16);
+	const uint8_t* subtable_data   = data + subtable_offset;
+	size_t         subtable_size   = size - subtable_offset;
+
+	switch (best_format) {
+	case OTFCMAPFormat::SegmentMappingToDeltaValues:
+		CHECK(parseCmapFormat4(subtable_data, subtable_size, best_record));
+		break;
+	case OTFCMAPFormat::TrimmedTableMapping:
+		CHECK(parseCmapFormat6(subtable_data, subtable_size, best_record));
+		break;
+	case OTFCMAPFormat::SegmentedCoverage:
+		CHECK(parseCmapFormat12(subtable_data, subtable_size, best_record));
+		break;
+	default:
+		return { OTFResultType::InvalidFormat, "invalid cmap subtable format" };
+	}
+
+	charMapFormat = best_format;
+
 	return OTFResultType::Success;
 }
 
@@ -1165,6 +1777,10 @@ OTFResult OpenTypeImpl::parseHmtxTable(const uint8_t* data, const size_t size)
 	uint32_t         offset      = 0;
 	uint16_t         num_metrics = horizontalHeader.numberOfHMetrics;
 	uint16_t         num_glyphs  = maxProfile.numGlyphs;
+	size_t           bearings    = num_metrics < num_glyphs ? num_glyphs - num_metrics : 0;
+
+	if (size < num_metrics * sizeof(OTFUint16) * 2 + bearings * sizeof(OTFFWORD))
+		return { OTFResultType::InvalidSize, "data size too small for 'hmtx' table" };
 	
 	for (uint16_t i = 0; i < num_metrics; ++i) {
 		offset = parse_long_hor_metric(metric, data, offset);
@@ -1359,97 +1975,443 @@ OTFResult OpenTypeImpl::parseFpgmTable(const uint8_t* data, const size_t size)
 
 OTFResult OpenTypeImpl::parseLocaTable(const uint8_t* data, const size_t size)
 {
-	uint32_t offset = 0;
-	uint32_t count  = maxProfile.numGlyphs + 1;
-
-	glyphOffsets.resize(count);
+	uint32_t count = maxProfile.numGlyphs + 1;
 
+	// offsets are read in place by findGlyphLocation
 	if (header.indexToLocFormat == OTFIndexFormat::ShortOffsets) {
 		if (size < count * sizeof(OTFUint16))
 			return { OTFResultType::InvalidSize, "data size too small for 'loca' table" };
-
-		for (uint32_t i = 0; i < count; ++i)
-			glyphOffsets[i] = parse_u16_be(data, offset) * 2;
 	} else if (header.indexToLocFormat == OTFIndexFormat::LongOffsets) {
 		if (size < count * sizeof(OTFUint32))
 			return { OTFResultType::InvalidSize, "data size too small for 'loca' table" };
-
-		for (uint32_t i = 0; i < count; ++i)
-			glyphOffsets[i] = parse_u32_be(data, offset);
 	} else {
 		return { OTFResultType::InvalidFormat, "invalid 'loca' table index format" };
 	}
 
+	locationData = array_view<uint8_t>(data, size);
+
 	return OTFResultType::Success;
 }
 
-OTFResult OpenTypeImpl::parseCmapFormat4(const uint8_t* data, const size_t size, const OTFEncodingRecord& encoding_record)
+OTFResult OpenTypeImpl::parseGsubTable(const uint8_t* data, const size_t size)
 {
-	uint32_t      offset         = 0;
-	OTFUint16     length         = parse_u16_be(data, offset);
-	OTFLanguageID language       = parse_language_id(data, offset, encoding_record.platformID);
-	OTFUint16     seg_count      = parse_u16_be(data, offset) / 2;
-/*  OTFUint16     search_range   = parse_u16_be(data, offset); */ offset += sizeof(OTFUint16);
-/*  OTFUint16     entry_selector = parse_u16_be(data, offset); */ offset += sizeof(OTFUint16);
-/*  OTFUint16     range_shift    = parse_u16_be(data, offset); */ offset += sizeof(OTFUint16);
-	
-	uint32_t seg_count_size      = seg_count * sizeof(OTFUint16);
-	uint32_t start_code_offset   = offset + seg_count_size + sizeof(uint16_t);
-	uint32_t end_code_offset     = offset;
-	uint32_t id_delta_offset     = start_code_offset + seg_count_size;
-	uint32_t id_range_off_offset = id_delta_offset + seg_count_size;
+	static const OTFFeatureTag features[] = {
+		OTFFeatureTag::CCMP,
+		OTFFeatureTag::LOCL,
+		OTFFeatureTag::RLIG,
+		OTFFeatureTag::LIGA,
+		OTFFeatureTag::CLIG
+	};
+
+	static const uint8_t feature_flags[] = {
+		LOOKUP_FLAG_REQUIRED,
+		LOOKUP_FLAG_REQUIRED,
+		LOOKUP_FLAG_REQUIRED,
+		LOOKUP_FLAG_DISCRETIONARY,
+		LOOKUP_FLAG_DISCRETIONARY
+	};
+
+	OTFLayoutTableHeader header;
+
+	if (size < 10)
+		return { OTFResultType::InvalidSize, "data size too small for 'GSUB' table header" };
+
+	parse_layout_table_header(header, data, 0);
+
+	uint32_t offset = header.lookupListOffset;
+
+	if (!in_bounds(size, offset, 2))
+		return { OTFResultType::OutOfBounds, "lookup list out of bounds" };
+
+	uint16_t lookup_count = parse_u16_be(data, offset);
+
+	if (!in_bounds(size, offset, lookup_count * 2))
+		return { OTFResultType::OutOfBounds, "lookup offsets out of bounds" };
+
+	std::vector<uint8_t>  lookup_flags(lookup_count, 0);
+	std::vector<uint32_t> subtables;
+	std::vector<uint16_t> coverage;
+
+	CHECK(select_feature_lookups(lookup_flags, data, size, header, features, feature_flags));
+
+	for (uint16_t lookup_idx = 0; lookup_idx < lookup_count; ++lookup_idx) {
+		if (lookup_flags[lookup_idx] == 0) continue;
 
-	if (!supported_cmap_encoding_format4(encoding_record.encodingID))
-		return { OTFResultType::Unsupported, "unsupported cmap format4 encoding" };
+		uint16_t lookup_type;
+		offset = header.lookupListOffset + 2 + lookup_idx * 2;
+		uint32_t lookup_offset = header.lookupListOffset + parse_u16_be(data, offset);
 
-	for (uint16_t i = 0; i < seg_count; ++i) {
-		char32_t start_code      = static_cast<char32_t>(parse_u16_be(data, start_code_offset));
-		char32_t end_code        = static_cast<char32_t>(parse_u16_be(data, end_code_offset));
-		uint32_t array_offset    = id_range_off_offset;
-		uint32_t id_range_offset = static_cast<uint32_t>(parse_u16_be(data, id_range_off_offset));
-		int16_t  id_delta        = parse_i16_be(data, id_delta_offset);
+		CHECK(get_lookup_subtables(
+			lookup_type,
+			subtables,
+			data,
+			size,
+			lookup_offset,
+			static_cast<uint16_t>(OTFGSUBLookupType::Extension)));
 
-		if (id_range_offset == 0) {
-			for (char32_t i = start_code; i <= end_code; ++i) {
-				auto glyph_idx = static_cast<OTFUint16>(i + id_delta);
-				charToGlyphMap[i] = glyph_idx;
+		if (lookup_type != static_cast<uint16_t>(OTFGSUBLookupType::Single) &&
+			lookup_type != static_cast<uint16_t>(OTFGSUBLookupType::Ligature))
+			continue;
+
+		auto& lookup = shaping.substitutions.emplace_back();
+		lookup.discretionary = !(lookup_flags[lookup_idx] & LOOKUP_FLAG_REQUIRED);
+
+		for (uint32_t subtable : subtables) {
+			if (!in_bounds(size, subtable, 6))
+				return { OTFResultType::OutOfBounds, "substitution subtable out of bounds" };
+
+			offset = subtable;
+
+			uint16_t format          = parse_u16_be(data, offset);
+			uint32_t coverage_offset = subtable + parse_u16_be(data, offset);
+
+			CHECK(parse_coverage(coverage, data, size, coverage_offset));
+
+			if (lookup_type == static_cast<uint16_t>(OTFGSUBLookupType::Single)) {
+				if (format == 1) {
+					uint16_t delta = parse_u16_be(data, offset);
+
+					for (uint16_t glyph : coverage)
+						lookup.singles.push_back({ glyph, static_cast<uint16_t>(glyph + delta) });
+				} else if (format == 2) {
+					uint16_t glyph_count = parse_u16_be(data, offset);
+
+					if (!in_bounds(size, offset, glyph_count * 2))
+						return { OTFResultType::OutOfBounds, "substitute glyph array out of bounds" };
+
+					for (uint16_t i = 0; i < std::min<size_t>(glyph_count, coverage.size()); ++i)
+						lookup.singles.push_back({ coverage[i], parse_u16_be(data, offset) });
+				} else {
+					return { OTFResultType::InvalidFormat, "invalid single substitution format" };
+				}
+
+				continue;
 			}
-		} else {
-			for (char32_t i = start_code; i <= end_code; ++i) {
-				uint32_t  idx_offset = id_range_offset + 2 * (i - start_code) + array_offset;
-				OTFUint16 glyph_idx  = parse_u16_be(data, idx_offset);
 
-				if (glyph_idx != 0)
-					glyph_idx += id_delta;
+			uint16_t set_count = parse_u16_be(data, offset);
+
+			if (!in_bounds(size, offset, set_count * 2))
+				return { OTFResultType::OutOfBounds, "ligature set offsets out of bounds" };
+
+			for (uint16_t set_idx = 0; set_idx < std::min<size_t>(set_count, coverage.size()); ++set_idx) {
+				offset = subtable + 6 + set_idx * 2;
+				uint32_t set_offset = subtable + parse_u16_be(data, offset);
+
+				if (!in_bounds(size, set_offset, 2))
+					return { OTFResultType::OutOfBounds, "ligature set out of bounds" };
+
+				offset = set_offset;
+				uint16_t ligature_count = parse_u16_be(data, offset);
+
+				if (!in_bounds(size, offset, ligature_count * 2))
+					return { OTFResultType::OutOfBounds, "ligature offsets out of bounds" };
+
+				for (uint16_t i = 0; i < ligature_count; ++i) {
+					offset = set_offset + 2 + i * 2;
+					uint32_t ligature_offset = set_offset + parse_u16_be(data, offset);
+
+					if (!in_bounds(size, ligature_offset, 4))
+						return { OTFResultType::OutOfBounds, "ligature table out of bounds" };
+
+					Ligature ligature;
+					ligature.first           = coverage[set_idx];
+					ligature.glyph           = parse_u16_be(data, ligature_offset);
+					ligature.componentCount  = parse_u16_be(data, ligature_offset);
+					ligature.componentOffset = static_cast<uint32_t>(lookup.components.size());
+
+					if (ligature.componentCount == 0) continue;
+					if (!in_bounds(size, ligature_offset, (ligature.componentCount - 1) * 2))
+						return { OTFResultType::OutOfBounds, "ligature components out of bounds" };
+
+					ligature.componentCount--;
+
+					for (uint16_t c = 0; c < ligature.componentCount; ++c)
+						lookup.components.push_back(parse_u16_be(data, ligature_offset));
+
+					lookup.ligatures.push_back(ligature);
+				}
+			}
+		}
+
+		// the first subtable covering a glyph wins, stable sorts keep the font order
+		std::stable_sort(VERA_SPAN(lookup.singles), [](const auto& lhs, const auto& rhs) {
+			return lhs.glyph < rhs.glyph;
+		});
+		lookup.singles.erase(std::unique(VERA_SPAN(lookup.singles), [](const auto& lhs, const auto& rhs) {
+			return lhs.glyph == rhs.glyph;
+		}), lookup.singles.end());
+
+		std::stable_sort(VERA_SPAN(lookup.ligatures), [](const auto& lhs, const auto& rhs) {
+			return lhs.first < rhs.first;
+		});
+	}
+
+	return OTFResultType::Success;
+}
+
+OTFResult OpenTypeImpl::parseGposTable(const uint8_t* data, const size_t size)
+{
+	static const OTFFeatureTag features[]      = { OTFFeatureTag::KERN };
+	static const uint8_t       feature_flags[] = { LOOKUP_FLAG_DISCRETIONARY };
+
+	OTFLayoutTableHeader header;
+
+	if (size < 10)
+		return { OTFResultType::InvalidSize, "data size too small for 'GPOS' table header" };
+
+	parse_layout_table_header(header, data, 0);
+
+	uint32_t offset = header.lookupListOffset;
+
+	if (!in_bounds(size, offset, 2))
+		return { OTFResultType::OutOfBounds, "lookup list out of bounds" };
+
+	uint16_t lookup_count = parse_u16_be(data, offset);
+
+	if (!in_bounds(size, offset, lookup_count * 2))
+		return { OTFResultType::OutOfBounds, "lookup offsets out of bounds" };
+
+	std::vector<uint8_t>  lookup_flags(lookup_count, 0);
+	std::vector<uint32_t> subtables;
+	std::vector<uint16_t> coverage;
+	std::vector<uint64_t> pairs; // (key << 16) | value, sorted afterwards by key in subtable order
+
+	CHECK(select_feature_lookups(lookup_flags, data, size, header, features, feature_flags));
+
+	for (uint16_t lookup_idx = 0; lookup_idx < lookup_count; ++lookup_idx) {
+		if (lookup_flags[lookup_idx] == 0) continue;
+
+		uint16_t lookup_type;
+		offset = header.lookupListOffset + 2 + lookup_idx * 2;
+		uint32_t lookup_offset = header.lookupListOffset + parse_u16_be(data, offset);
+
+		CHECK(get_lookup_subtables(
+			lookup_type,
+			subtables,
+			data,
+			size,
+			lookup_offset,
+			static_cast<uint16_t>(OTFGPOSLookupType::Extension)));
+
+		if (lookup_type != static_cast<uint16_t>(OTFGPOSLookupType::Pair)) continue;
 
-				charToGlyphMap[i] = glyph_idx;
+		auto& lookup = shaping.kerning.emplace_back();
+		pairs.clear();
+
+		for (uint32_t subtable : subtables) {
+			if (!in_bounds(size, subtable, 10))
+				return { OTFResultType::OutOfBounds, "pair adjustment subtable out of bounds" };
+
+			offset = subtable;
+
+			uint16_t format          = parse_u16_be(data, offset);
+			uint32_t coverage_offset = subtable + parse_u16_be(data, offset);
+			uint16_t value_format1   = parse_u16_be(data, offset);
+			uint16_t value_format2   = parse_u16_be(data, offset);
+			uint32_t value_size1     = get_value_record_size(value_format1);
+			uint32_t value_size2     = get_value_record_size(value_format2);
+
+			CHECK(parse_coverage(coverage, data, size, coverage_offset));
+
+			if (format == 1) {
+				uint16_t set_count   = parse_u16_be(data, offset);
+				uint32_t record_size = 2 + value_size1 + value_size2;
+
+				if (!in_bounds(size, offset, set_count * 2))
+					return { OTFResultType::OutOfBounds, "pair set offsets out of bounds" };
+
+				for (uint16_t set_idx = 0; set_idx < std::min<size_t>(set_count, coverage.size()); ++set_idx) {
+					offset = subtable + 10 + set_idx * 2;
+					uint32_t set_offset = subtable + parse_u16_be(data, offset);
+
+					if (!in_bounds(size, set_offset, 2))
+						return { OTFResultType::OutOfBounds, "pair set out of bounds" };
+
+					offset = set_offset;
+					uint16_t pair_count = parse_u16_be(data, offset);
+
+					if (!in_bounds(size, offset, pair_count * record_size))
+						return { OTFResultType::OutOfBounds, "pair value records out of bounds" };
+
+					for (uint16_t i = 0; i < pair_count; ++i, offset += record_size) {
+						uint32_t record = offset;
+						uint16_t second = parse_u16_be(data, record);
+						int16_t  value  = parse_x_advance(data, record, value_format1);
+						uint32_t key    = (static_cast<uint32_t>(coverage[set_idx]) << 16) | second;
+
+						pairs.push_back((static_cast<uint64_t>(key) << 16) | static_cast<uint16_t>(value));
+					}
+				}
+			} else if (format == 2) {
+				uint32_t class_def1   = subtable + parse_u16_be(data, offset);
+				uint32_t class_def2   = subtable + parse_u16_be(data, offset);
+				uint16_t class1_count = parse_u16_be(data, offset);
+				uint16_t class2_count = parse_u16_be(data, offset);
+				uint32_t record_size  = value_size1 + value_size2;
+
+				// without classes there are no values, every pair in coverage would index past them
+				if (class1_count == 0 || class2_count == 0) continue;
+
+				if (!in_bounds(size, offset, static_cast<size_t>(class1_count) * class2_count * record_size))
+					return { OTFResultType::OutOfBounds, "class records out of bounds" };
+
+				auto& table = lookup.classTables.emplace_back();
+
+				CHECK(parse_class_def(table.firstClasses, data, size, class_def1));
+				CHECK(parse_class_def(table.secondClasses, data, size, class_def2));
+
+				table.coverage         = coverage;
+				table.secondClassCount = class2_count;
+				table.values.resize(static_cast<size_t>(class1_count) * class2_count);
+
+				for (auto& value : table.values) {
+					value   = parse_x_advance(data, offset, value_format1);
+					offset += record_size;
+				}
+
+				// classes past the counts of a malformed font would index out of the values
+				std::erase_if(table.firstClasses, [=](const ClassRange& range) { return range.value >= class1_count; });
+				std::erase_if(table.secondClasses, [=](const ClassRange& range) { return range.value >= class2_count; });
+			} else {
+				return { OTFResultType::InvalidFormat, "invalid pair adjustment format" };
 			}
 		}
+
+		std::stable_sort(VERA_SPAN(pairs), [](uint64_t lhs, uint64_t rhs) {
+			return (lhs >> 16) < (rhs >> 16);
+		});
+		pairs.erase(std::unique(VERA_SPAN(pairs), [](uint64_t lhs, uint64_t rhs) {
+			return (lhs >> 16) == (rhs >> 16);
+		}), pairs.end());
+
+		lookup.pairKeys.reserve(pairs.size());
+		lookup.pairValues.reserve(pairs.size());
+
+		for (uint64_t pair : pairs) {
+			lookup.pairKeys.push_back(static_cast<uint32_t>(pair >> 16));
+			lookup.pairValues.push_back(static_cast<int16_t>(pair & 0xFFFF));
+		}
+	}
+
+	return OTFResultType::Success;
+}
+
+OTFResult OpenTypeImpl::parseKernTable(const uint8_t* data, const size_t size)
+{
+	uint32_t offset = 0;
+
+	if (size < 4)
+		return { OTFResultType::InvalidSize, "data size too small for 'kern' table header" };
+
+	// apple kerning tables start with a 32 bit version of 1.0 and are not supported
+	uint16_t version     = parse_u16_be(data, offset);
+	uint16_t table_count = parse_u16_be(data, offset);
+
+	if (version != 0) return OTFResultType::Success;
+
+	OTFKERNSubtableHeader subtable;
+	KerningLookup         lookup;
+
+	for (uint16_t i = 0; i < table_count; ++i) {
+		if (!in_bounds(size, offset, 6))
+			return { OTFResultType::OutOfBounds, "'kern' subtable out of bounds" };
+
+		uint32_t next = offset;
+		offset        = parse_kern_subtable_header(subtable, data, offset);
+		next         += subtable.length;
+
+		// format 0 with horizontal values, minimum and cross stream subtables are skipped
+		if ((subtable.coverage >> 8) != 0 || (subtable.coverage & 0x7) != 0x1) {
+			offset = next;
+			continue;
+		}
+
+		if (!in_bounds(size, offset, 8))
+			return { OTFResultType::OutOfBounds, "'kern' subtable out of bounds" };
+
+		uint16_t pair_count = parse_u16_be(data, offset);
+		offset += 3 * sizeof(OTFUint16); // searchRange, entrySelector, rangeShift
+
+		if (!in_bounds(size, offset, pair_count * 6))
+			return { OTFResultType::OutOfBounds, "'kern' pairs out of bounds" };
+
+		for (uint16_t p = 0; p < pair_count; ++p) {
+			lookup.pairKeys.push_back(parse_u32_be(data, offset));
+			lookup.pairValues.push_back(parse_i16_be(data, offset));
+		}
+
+		// the subtable length field overflows for large pair counts, the pairs tell the real size
+		offset = std::max(next, offset);
 	}
 
+	if (lookup.pairKeys.empty()) return OTFResultType::Success;
+
+	std::vector<uint32_t> order(lookup.pairKeys.size());
+
+	for (uint32_t i = 0; i < order.size(); ++i)
+		order[i] = i;
+
+	std::stable_sort(VERA_SPAN(order), [&](uint32_t lhs, uint32_t rhs) {
+		return lookup.pairKeys[lhs] < lookup.pairKeys[rhs];
+	});
+
+	auto& sorted = shaping.kerning.emplace_back();
+
+	for (uint32_t i : order) {
+		if (!sorted.pairKeys.empty() && sorted.pairKeys.back() == lookup.pairKeys[i]) continue;
+
+		sorted.pairKeys.push_back(lookup.pairKeys[i]);
+		sorted.pairValues.push_back(lookup.pairValues[i]);
+	}
+
+	return OTFResultType::Success;
+}
+
+OTFResult OpenTypeImpl::parseCmapFormat4(const uint8_t* data, const size_t size, const OTFEncodingRecord& encoding_record)
+{
+	if (size < sizeof(OTFUint16) * 6)
+		return { OTFResultType::InvalidSize, "data size too small for cmap format4 header" };
+
+	uint32_t      offset         = 0;
+/*  OTFUint16     length         = parse_u16_be(data, offset); */ offset += sizeof(OTFUint16);
+	OTFLanguageID language       = parse_language_id(data, offset, encoding_record.platformID);
+	OTFUint16     seg_count      = parse_u16_be(data, offset) / 2;
+/*  OTFUint16     search_range   = parse_u16_be(data, offset); */ offset += sizeof(OTFUint16);
+/*  OTFUint16     entry_selector = parse_u16_be(data, offset); */ offset += sizeof(OTFUint16);
+/*  OTFUint16     range_shift    = parse_u16_be(data, offset); */ offset += sizeof(OTFUint16);
+
+	// the length field overflows in large fonts, the glyph id array is bounded by the cmap table
+	if (size < offset + seg_count * sizeof(OTFUint16) * 4 + sizeof(OTFUint16))
+		return { OTFResultType::InvalidSize, "data size too small for cmap format4 segments" };
+
+	charMapData = array_view<uint8_t>(data, size);
+
 	return OTFResultType::Success;
 }
 
 OTFResult OpenTypeImpl::parseCmapFormat6(const uint8_t* data, const size_t size, const OTFEncodingRecord& encoding_record)
 {
+	if (size < sizeof(OTFUint16) * 4)
+		return { OTFResultType::InvalidSize, "data size too small for cmap format6 header" };
+
 	uint32_t      offset      = 0;
+/*  OTFUint16     length      = parse_u16_be(data, offset); */ offset += sizeof(OTFUint16);
 	OTFLanguageID language    = parse_language_id(data, offset, encoding_record.platformID);
 	OTFUint16     first_code  = parse_u16_be(data, offset);
 	OTFUint16     entry_count = parse_u16_be(data, offset);
 
-	for (uint16_t i = 0; i < entry_count; ++i) {
-		char32_t  code     = static_cast<char32_t>(first_code + i);
-		OTFUint16 glyph_id = parse_u16_be(data, offset);
+	if (size < offset + entry_count * sizeof(OTFUint16))
+		return { OTFResultType::InvalidSize, "data size too small for cmap format6 glyph ids" };
 
-		charToGlyphMap[code] = glyph_id;
-	}
+	charMapData = array_view<uint8_t>(data, offset + entry_count * sizeof(OTFUint16));
 
 	return OTFResultType::Success;
 }
 
 OTFResult OpenTypeImpl::parseCmapFormat12(const uint8_t* data, const size_t size, const OTFEncodingRecord& encoding_record)
 {
-	OTFSequentialMapGroup map_group;
+	if (size < sizeof(OTFUint16) + sizeof(OTFUint32) * 3)
+		return { OTFResultType::InvalidSize, "data size too small for cmap format12 header" };
 
 	uint32_t offset      = 0;
 /*  OTFUint16 reserved   = parse_u16_be(data, offset); */ offset += sizeof(OTFUint16);
@@ -1457,21 +2419,130 @@ OTFResult OpenTypeImpl::parseCmapFormat12(const uint8_t* data, const size_t size
 	OTFUint32 language   = parse_u32_be(data, offset);
 	OTFUint32 num_groups = parse_u32_be(data, offset);
 
-	for (uint32_t i = 0; i < num_groups; ++i) {
-		offset = parse_sequential_map_group(map_group, data, offset);
-		
-		uint32_t code_count      = map_group.endCharCode - map_group.startCharCode + 1;
-		uint32_t first_glyph_idx = map_group.startGlyphID;
-		uint32_t last_glyph_idx  = first_glyph_idx + code_count;
-		char32_t code            = static_cast<char32_t>(map_group.startCharCode);
+	if ((size - offset) / (sizeof(OTFUint32) * 3) < num_groups)
+		return { OTFResultType::InvalidSize, "data size too small for cmap format12 groups" };
 
-		for (uint32_t i = first_glyph_idx; i < last_glyph_idx; ++i, ++ code)
-			charToGlyphMap[code] = i;
-	}
+	charMapData = array_view<uint8_t>(data, offset + num_groups * sizeof(OTFUint32) * 3);
 
 	return OTFResultType::Success;
 }
 
+OTFGlyphID OpenTypeImpl::findCmapFormat4(char32_t codepoint) const VERA_NOEXCEPT
+{
+	if (0xFFFF < codepoint)
+		return 0;
+
+	const uint8_t* data   = charMapData.data();
+	uint32_t       offset = sizeof(OTFUint16) * 2;
+
+	uint32_t seg_count           = parse_u16_be(data, offset) / 2;
+	uint32_t seg_count_size      = seg_count * sizeof(OTFUint16);
+	uint32_t end_code_offset     = offset + sizeof(OTFUint16) * 3;
+	uint32_t start_code_offset   = end_code_offset + seg_count_size + sizeof(OTFUint16);
+	uint32_t id_delta_offset     = start_code_offset + seg_count_size;
+	uint32_t id_range_off_offset = id_delta_offset + seg_count_size;
+
+	// first segment whose end code is not below the codepoint
+	uint32_t first = 0;
+	uint32_t count = seg_count;
+
+	while (0 < count) {
+		uint32_t step       = count / 2;
+		uint32_t end_offset = end_code_offset + (first + step) * sizeof(OTFUint16);
+
+		if (parse_u16_be(data, end_offset) < codepoint) {
+			first += step + 1;
+			count -= step + 1;
+		} else {
+			count = step;
+		}
+	}
+
+	if (first == seg_count)
+		return 0;
+
+	uint32_t seg_offset   = first * sizeof(OTFUint16);
+	uint32_t start_offset = start_code_offset + seg_offset;
+	uint32_t delta_offset = id_delta_offset + seg_offset;
+	uint32_t array_offset = id_range_off_offset + seg_offset;
+	uint32_t range_offset = array_offset;
+
+	char32_t  start_code      = static_cast<char32_t>(parse_u16_be(data, start_offset));
+	OTFUint16 id_delta        = parse_u16_be(data, delta_offset);
+	uint32_t  id_range_offset = static_cast<uint32_t>(parse_u16_be(data, range_offset));
+
+	if (codepoint < start_code)
+		return 0;
+
+	if (id_range_offset == 0)
+		return static_cast<OTFGlyphID>(codepoint + id_delta);
+
+	uint32_t idx_offset = id_range_offset + 2 * (codepoint - start_code) + array_offset;
+
+	if (charMapData.size() < idx_offset + sizeof(OTFUint16))
+		return 0;
+
+	OTFGlyphID glyph_idx = parse_u16_be(data, idx_offset);
+
+	return glyph_idx != 0 ? static_cast<OTFGlyphID>(glyph_idx + id_delta) : 0;
+}
+
+OTFGlyphID OpenTypeImpl::findCmapFormat6(char32_t codepoint) const VERA_NOEXCEPT
+{
+	const uint8_t* data   = charMapData.data();
+	uint32_t       offset = sizeof(OTFUint16) * 2;
+
+	OTFUint16 first_code  = parse_u16_be(data, offset);
+	OTFUint16 entry_count = parse_u16_be(data, offset);
+
+	if (codepoint < first_code || first_code + entry_count <= codepoint)
+		return 0;
+
+	offset += (codepoint - first_code) * sizeof(OTFUint16);
+
+	return parse_u16_be(data, offset);
+}
+
+OTFGlyphID OpenTypeImpl::findCmapFormat12(char32_t codepoint) const VERA_NOEXCEPT
+{
+	OTFSequentialMapGroup map_group;
+
+	const uint8_t* data   = charMapData.data();
+	uint32_t       offset = sizeof(OTFUint16) + sizeof(OTFUint32) * 2;
+
+	uint32_t num_groups   = parse_u32_be(data, offset);
+	uint32_t group_offset = offset;
+	uint32_t group_size   = sizeof(OTFUint32) * 3;
+
+	// first group whose end code is not below the codepoint
+	uint32_t first = 0;
+	uint32_t count = num_groups;
+
+	while (0 < count) {
+		uint32_t step       = count / 2;
+		uint32_t end_offset = group_offset + (first + step) * group_size + sizeof(OTFUint32);
+
+		if (parse_u32_be(data, end_offset) < codepoint) {
+			first += step + 1;
+			count -= step + 1;
+		} else {
+			count = step;
+		}
+	}
+
+	if (first == num_groups)
+		return 0;
+
+	parse_sequential_map_group(map_group, data, group_offset + first * group_size);
+
+	if (codepoint < map_group.startCharCode)
+		return 0;
+
+	uint32_t glyph_idx = map_group.startGlyphID + (codepoint - map_group.startCharCode);
+
+	return glyph_idx <= 0xFFFF ? static_cast<OTFGlyphID>(glyph_idx) : 0;
+}
+
 OTFNameEntry* OpenTypeImpl::findNameEntry(OTFPlatformID platform_id, OTFEncodingID encoding_id, OTFLanguageID language_id)
 {
 	auto cmp_entry = OTFNameEntry{ platform_id, encoding_id, language_id, {} };
@@ -3,9 +3,12 @@
 #include "../../include/vera/typography/glyph.h"
 #include "../../include/vera/util/result_message.h"
 #include "../../include/vera/util/ranged_set.h"
+#include "../../include/vera/util/mapped_file.h"
 #include "font_impl_base.h"
+#include "glyph_arena.h"
 #include <unordered_map>
-#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 
 VERA_NAMESPACE_BEGIN
@@ -204,9 +207,9 @@ enum class OTFEncodingID : uint16_t
 	Windows_Wansung                 = 773,
 	Windows_Johab                   = 774,
 	Windows_Reserved0               = 775,
-	Windows_Reserved1               = 775,
-	Windows_Reserved2               = 775,
-	Windows_Uniocde_Full_Repertoire = 776,
+	Windows_Reserved1               = 776,
+	Windows_Reserved2               = 777,
+	Windows_Uniocde_Full_Repertoire = 778,
 
 	__Platform_Offset__             = 256
 };
@@ -673,16 +676,103 @@ struct OTFGlyphHeader
 	OTFInt16 yMax;
 };
 
+// GSUB, GPOS: Glyph Substitution and Glyph Positioning Tables
+
+enum class OTFScriptTag : uint32_t
+{
+	DFLT = 0x44464C54, // 'DFLT'
+	LATN = 0x6C61746E  // 'latn'
+};
+
+enum class OTFFeatureTag : uint32_t
+{
+	CCMP = 0x63636D70, // 'ccmp'
+	LOCL = 0x6C6F636C, // 'locl'
+	RLIG = 0x726C6967, // 'rlig'
+	LIGA = 0x6C696761, // 'liga'
+	CLIG = 0x636C6967, // 'clig'
+	KERN = 0x6B65726E  // 'kern'
+};
+
+enum class OTFGSUBLookupType : uint16_t
+{
+	Single                = 1,
+	Multiple              = 2,
+	Alternate             = 3,
+	Ligature              = 4,
+	Context               = 5,
+	ChainedContext        = 6,
+	Extension             = 7,
+	ReverseChainedContext = 8
+};
+
+enum class OTFGPOSLookupType : uint16_t
+{
+	Single         = 1,
+	Pair           = 2,
+	Cursive        = 3,
+	MarkToBase     = 4,
+	MarkToLigature = 5,
+	MarkToMark     = 6,
+	Context        = 7,
+	ChainedContext = 8,
+	Extension      = 9
+};
+
+enum class OTFValueFormatBits : uint16_t
+{
+	XPlacement       = 0x0001,
+	YPlacement       = 0x0002,
+	XAdvance         = 0x0004,
+	YAdvance         = 0x0008,
+	XPlacementDevice = 0x0010,
+	YPlacementDevice = 0x0020,
+	XAdvanceDevice   = 0x0040,
+	YAdvanceDevice   = 0x0080
+};
+
+struct OTFLayoutTableHeader
+{
+	OTFUint16 majorVersion;
+	OTFUint16 minorVersion;
+	OTFUint16 scriptListOffset;
+	OTFUint16 featureListOffset;
+	OTFUint16 lookupListOffset;
+};
+
+struct OTFLookupHeader
+{
+	OTFUint16 lookupType;
+	OTFUint16 lookupFlag;
+	OTFUint16 subTableCount;
+};
+
+// KERN: Kerning Table
+
+struct OTFKERNSubtableHeader
+{
+	OTFUint16 version;
+	OTFUint16 length;
+	OTFUint16 coverage;
+};
+
+enum class OTFGlyphState : uint8_t
+{
+	Unloaded,
+	Loading,
+	Loaded
+};
+
 class OpenTypeImpl : public priv::FontImplBase
 {
 public:
+	using FileRef  = std::shared_ptr<const MappedFile>;
 	using TableMap = std::unordered_map<OTFTableTag, OTFTableRecord>;
-	using CharMap  = std::unordered_map<char32_t, OTFGlyphID>;
-	using GlyphMap = std::map<OTFGlyphID, Glyph>;
 
 	static std::vector<uint32_t> getTTCFontOffsets(const uint8_t* data, const size_t size);
 
-	OpenTypeImpl(const uint8_t* data, size_t size, uint32_t offset);
+	// faces of a collection share the mapping, tables are read in place and outlines on first use
+	OpenTypeImpl(FileRef file, uint32_t offset);
 	~OpenTypeImpl() VERA_NOEXCEPT override;
 
 	std::string_view getName() const VERA_NOEXCEPT override;
@@ -693,33 +783,45 @@ public:
 
 	uint32_t getGlyphCount() const VERA_NOEXCEPT override;
 	GlyphID getGlyphID(char32_t codepoint) const override;
+	bool tryGetGlyphID(char32_t codepoint, GlyphID& glyph_id) const VERA_NOEXCEPT override;
 	const Glyph& findGlyph(GlyphID glyph_id) const override;
 	const Glyph& getGlyph(GlyphID glyph_id) override;
 	const Glyph& findGlyphByCodepoint(char32_t codepoint) const override;
 	const Glyph& getGlyphByCodepoint(char32_t codepoint) override;
-
-	OTFHEADTable              header            = {};
-	OTFMAXPTable              maxProfile        = {};
-	OTFHHEATable              horizontalHeader  = {};
-	OTFHMTXTable              horizontalMetrics = {};
-	OTFOS2Table               os2Metrics        = {};
-	OTFPOSTTable              postScript        = {};
-	TableMap                  tableMap          = {};
-	CharMap                   charToGlyphMap    = {};
-	GlyphMap                  glyphs            = {};
-	std::vector<OTFNameEntry> nameEntries       = {};
-	std::vector<std::string>  languageTags      = {};
-	std::vector<uint32_t>     glyphOffsets      = {};
-	std::vector<uint8_t>      glyphBinary       = {};
-	std::vector<OTFInt16>     controlValues     = {}; // cvt table
-	std::vector<OTFUint8>     programData       = {}; // fpgm table
+	const ShapingTables& getShapingTables() override;
+
+	FileRef                    file              = {};
+	OTFHEADTable               header            = {};
+	OTFMAXPTable               maxProfile        = {};
+	OTFHHEATable               horizontalHeader  = {};
+	OTFHMTXTable               horizontalMetrics = {}; // parsed with the shaping tables
+	OTFOS2Table                os2Metrics        = {};
+	OTFPOSTTable               postScript        = {};
+	TableMap                   tableMap          = {};
+	std::vector<Glyph>         glyphs            = {}; // indexed by glyph id, allocated with the first glyph
+	std::vector<OTFGlyphState> glyphStates       = {};
+	GlyphArena                 glyphArena        = {};
+	std::vector<OTFNameEntry>  nameEntries       = {};
+	std::vector<std::string>   languageTags      = {};
+	OTFCMAPFormat              charMapFormat     = {};
+	array_view<uint8_t>        charMapData       = {}; // selected cmap subtable
+	array_view<uint8_t>        locationData      = {}; // loca table
+	array_view<uint8_t>        glyphData         = {}; // glyf table
+	std::vector<OTFInt16>      controlValues     = {}; // cvt table
+	std::vector<OTFUint8>      programData       = {}; // fpgm table
+	ShapingTables              shaping           = {};
+	std::once_flag             shapingFlag       = {};
 
 private:
+	void allocateGlyphs();
 	OTFResult loadGlyph(uint32_t glyph_id);
-	OTFResult parseSimpleGlyph(Glyph& glyph, const OTFGlyphHeader& glyph_header, uint32_t offset);
-	OTFResult parseCompositeGlyph(Glyph& glyph, const OTFGlyphHeader& glyph_header, uint32_t offset);
+	OTFResult loadGlyph(uint32_t glyph_id, GlyphArena& arena, bool load_composite);
+	OTFResult parseSimpleGlyph(Glyph& glyph, const OTFGlyphHeader& glyph_header, uint32_t offset, uint32_t end, GlyphArena& arena);
+	OTFResult parseCompositeGlyph(Glyph& glyph, const OTFGlyphHeader& glyph_header, uint32_t offset, uint32_t end, GlyphArena& arena);
+	OTFResult findGlyphLocation(uint32_t glyph_id, uint32_t& begin, uint32_t& end) const;
 
 	OTFResult parseTable(const uint8_t* data, const size_t size);
+	OTFResult parseShapingTables(const uint8_t* data, const size_t size);
 	OTFResult parseHeadTable(const uint8_t* data, const size_t size);
 	OTFResult parseMaxpTable(const uint8_t* data, const size_t size);
 	OTFResult parseCmapTable(const uint8_t* data, const size_t size);
@@ -731,11 +833,18 @@ private:
 	OTFResult parseCvtTable(const uint8_t* data, const size_t size);
 	OTFResult parseFpgmTable(const uint8_t* data, const size_t size);
 	OTFResult parseLocaTable(const uint8_t* data, const size_t size);
+	OTFResult parseGsubTable(const uint8_t* data, const size_t size);
+	OTFResult parseGposTable(const uint8_t* data, const size_t size);
+	OTFResult parseKernTable(const uint8_t* data, const size_t size);
 
 	OTFResult parseCmapFormat4(const uint8_t* data, const size_t size, const OTFEncodingRecord& encoding_record);
 	OTFResult parseCmapFormat6(const uint8_t* data, const size_t size, const OTFEncodingRecord& encoding_record);
 	OTFResult parseCmapFormat12(const uint8_t* data, const size_t size, const OTFEncodingRecord& encoding_record);
 
+	OTFGlyphID findCmapFormat4(char32_t codepoint) const VERA_NOEXCEPT;
+	OTFGlyphID findCmapFormat6(char32_t codepoint) const VERA_NOEXCEPT;
+	OTFGlyphID findCmapFormat12(char32_t codepoint) const VERA_NOEXCEPT;
+
 	OTFNameEntry* findNameEntry(OTFPlatformID platform_id, OTFEncodingID encoding_id, OTFLanguageID language_id);
 
 	static uint16_t getGlyphNameCount(OTFUint16 num_glyphs, const uint8_t* data, uint32_t offset);
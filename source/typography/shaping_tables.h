@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../../include/vera/typography/glyph.h"
+#include <vector>
+
+VERA_NAMESPACE_BEGIN
+
+struct SingleSubstitution
+{
+	uint16_t glyph;
+	uint16_t substitute;
+};
+
+struct Ligature
+{
+	uint16_t first;
+	uint16_t glyph;
+	uint16_t componentCount;  // components following the first glyph
+	uint32_t componentOffset; // into SubstitutionLookup::components
+};
+
+// One GSUB lookup, either single substitutions sorted by glyph or ligatures sorted by their first
+// glyph. Ligatures sharing a first glyph keep the preference order of the font.
+struct SubstitutionLookup
+{
+	std::vector<SingleSubstitution> singles;
+	std::vector<Ligature>           ligatures;
+	std::vector<uint16_t>           components;
+	bool                            discretionary; // from 'liga' or 'clig', may be turned off
+};
+
+struct ClassRange
+{
+	uint16_t first;
+	uint16_t last;
+	uint16_t value;
+};
+
+// class based pair adjustments of a GPOS format 2 subtable
+struct ClassKerning
+{
+	std::vector<uint16_t>   coverage;      // sorted first glyphs
+	std::vector<ClassRange> firstClasses;  // sorted, glyphs outside the ranges are class 0
+	std::vector<ClassRange> secondClasses;
+	uint16_t                secondClassCount;
+	std::vector<int16_t>    values;        // first class major
+};
+
+// One GPOS pair adjustment lookup or the legacy 'kern' table. Explicit pairs win over the class
+// tables, which are tried in subtable order.
+struct KerningLookup
+{
+	std::vector<uint32_t>     pairKeys;    // (first << 16) | second, sorted
+	std::vector<int16_t>      pairValues;
+	std::vector<ClassKerning> classTables;
+};
+
+// Compact lookup tables a TextLayout shapes with, built the first time the font is shaped. Only the
+// horizontal advance adjustment of the first glyph of a pair is kept and lookup flags are ignored.
+struct ShapingTables
+{
+	std::vector<uint16_t>           advances;      // hmtx advance of every glyph in font units
+	int16_t                         ascender;
+	int16_t                         descender;
+	int16_t                         lineGap;
+	std::vector<SubstitutionLookup> substitutions; // in lookup list order
+	std::vector<KerningLookup>      kerning;
+};
+
+VERA_NAMESPACE_END
@@ -0,0 +1,486 @@
+#include "../../include/vera/typography/text_layout.h"
+
+#include "../../include/vera/core/exception.h"
+#include "font_impl_base.h"
+#include <algorithm>
+
+#define REPLACEMENT_CHARACTER 0xFFFD
+
+VERA_NAMESPACE_BEGIN
+VERA_PRIV_NAMESPACE_BEGIN
+
+struct ShapingGlyph
+{
+	uint16_t glyph;
+	uint32_t cluster; // index of the first codepoint the glyph was made from
+};
+
+class TextShaper
+{
+public:
+	void shape(ShapedText& out, FontImplBase& impl, std::u32string_view text, const TextLayoutInfo& info);
+
+private:
+	void shapeParagraph(ShapedText& out, FontImplBase& impl, std::u32string_view text, const TextLayoutInfo& info);
+	void emitLine(ShapedText& out, std::u32string_view text, size_t begin, size_t end);
+
+	std::vector<ShapingGlyph> m_glyphs;
+	std::vector<float>        m_pens;     // pen position before every glyph of the paragraph
+	std::vector<float>        m_advances; // kerned advances
+	float                     m_baseline;
+	float                     m_lineHeight;
+};
+
+VERA_PRIV_NAMESPACE_END
+
+// Invalid and truncated sequences decode to U+FFFD, one per offending byte.
+static void decode_utf8(std::u32string& out, std::string_view text)
+{
+	const auto*  data = reinterpret_cast<const uint8_t*>(text.data());
+	const size_t size = text.size();
+
+	out.clear();
+	out.reserve(size);
+
+	for (size_t i = 0; i < size;) {
+		uint8_t  lead = data[i];
+		uint32_t count;
+		char32_t codepoint;
+
+		if (lead < 0x80) {
+			out.push_back(lead);
+			++i;
+			continue;
+		} else if ((lead & 0xE0) == 0xC0) {
+			count     = 1;
+			codepoint = lead & 0x1F;
+		} else if ((lead & 0xF0) == 0xE0) {
+			count     = 2;
+			codepoint = lead & 0x0F;
+		} else if ((lead & 0xF8) == 0xF0) {
+			count     = 3;
+			codepoint = lead & 0x07;
+		} else {
+			out.push_back(REPLACEMENT_CHARACTER);
+			++i;
+			continue;
+		}
+
+		if (i + count >= size) {
+			out.push_back(REPLACEMENT_CHARACTER);
+			++i;
+			continue;
+		}
+
+		bool valid = true;
+
+		for (uint32_t j = 1; j <= count; ++j) {
+			if ((data[i + j] & 0xC0) != 0x80) {
+				valid = false;
+				break;
+			}
+
+			codepoint = (codepoint << 6) | (data[i + j] & 0x3F);
+		}
+
+		static const char32_t min_codepoint[] = { 0, 0x80, 0x800, 0x10000 };
+
+		// overlong forms, surrogates and values past U+10FFFF are rejected
+		if (!valid || codepoint < min_codepoint[count] || codepoint > 0x10FFFF ||
+			(0xD800 <= codepoint && codepoint <= 0xDFFF)) {
+			out.push_back(REPLACEMENT_CHARACTER);
+			++i;
+			continue;
+		}
+
+		out.push_back(codepoint);
+		i += count + 1;
+	}
+}
+
+// whitespace advances the pen without producing a glyph
+static bool is_space(char32_t codepoint)
+{
+	switch (codepoint) {
+	case U' ':
+	case U'\t':
+	case U'\r':
+	case 0x00A0: // no-break space
+	case 0x1680:
+	case 0x202F: // narrow no-break space
+	case 0x205F:
+	case 0x3000:
+		return true;
+	default:
+		return 0x2000 <= codepoint && codepoint <= 0x200B;
+	}
+}
+
+static bool is_break_space(char32_t codepoint)
+{
+	return is_space(codepoint) && codepoint != 0x00A0 && codepoint != 0x202F;
+}
+
+static void apply_substitution(std::vector<priv::ShapingGlyph>& glyphs, const SubstitutionLookup& lookup)
+{
+	if (!lookup.singles.empty()) {
+		for (auto& glyph : glyphs) {
+			auto it = std::lower_bound(VERA_SPAN(lookup.singles), glyph.glyph,
+				[](const SingleSubstitution& subst, uint16_t glyph) {
+					return subst.glyph < glyph;
+				});
+
+			if (it != lookup.singles.end() && it->glyph == glyph.glyph)
+				glyph.glyph = it->substitute;
+		}
+	}
+
+	if (lookup.ligatures.empty()) return;
+
+	size_t out = 0;
+
+	for (size_t i = 0; i < glyphs.size();) {
+		auto it = std::lower_bound(VERA_SPAN(lookup.ligatures), glyphs[i].glyph,
+			[](const Ligature& ligature, uint16_t glyph) {
+				return ligature.first < glyph;
+			});
+
+		const Ligature* match = nullptr;
+
+		for (; it != lookup.ligatures.end() && it->first == glyphs[i].glyph; ++it) {
+			if (i + it->componentCount >= glyphs.size()) continue;
+
+			const uint16_t* components = lookup.components.data() + it->componentOffset;
+			uint32_t        c          = 0;
+
+			while (c < it->componentCount && glyphs[i + 1 + c].glyph == components[c])
+				++c;
+
+			if (c == it->componentCount) {
+				match = &*it;
+				break;
+			}
+		}
+
+		// glyphs only shrink, so the compacted run never overtakes the one being read
+		if (match) {
+			glyphs[out++] = priv::ShapingGlyph{ match->glyph, glyphs[i].cluster };
+			i += 1 + match->componentCount;
+		} else {
+			glyphs[out++] = glyphs[i++];
+		}
+	}
+
+	glyphs.resize(out);
+}
+
+static uint16_t find_class(const std::vector<ClassRange>& ranges, uint16_t glyph)
+{
+	auto it = std::upper_bound(VERA_SPAN(ranges), glyph,
+		[](uint16_t glyph, const ClassRange& range) {
+			return glyph < range.first;
+		});
+
+	if (it == ranges.begin()) return 0;
+	--it;
+
+	return glyph <= it->last ? it->value : 0;
+}
+
+static int32_t get_pair_adjustment(const KerningLookup& lookup, uint16_t first, uint16_t second)
+{
+	const uint32_t key = (static_cast<uint32_t>(first) << 16) | second;
+
+	auto it = std::lower_bound(VERA_SPAN(lookup.pairKeys), key);
+	if (it != lookup.pairKeys.end() && *it == key)
+		return lookup.pairValues[it - lookup.pairKeys.begin()];
+
+	for (const auto& table : lookup.classTables) {
+		if (!std::binary_search(VERA_SPAN(table.coverage), first)) continue;
+
+		uint32_t first_class  = find_class(table.firstClasses, first);
+		uint32_t second_class = find_class(table.secondClasses, second);
+
+		return table.values[first_class * table.secondClassCount + second_class];
+	}
+
+	return 0;
+}
+
+void priv::TextShaper::shape(ShapedText& out, FontImplBase& impl, std::u32string_view text, const TextLayoutInfo& info)
+{
+	const ShapingTables& tables = impl.getShapingTables();
+	const float          scale  = static_cast<float>(info.px) / impl.unitsPerEM;
+	const float          height = static_cast<float>(tables.ascender - tables.descender + tables.lineGap);
+
+	m_baseline   = static_cast<float>(tables.ascender) * scale;
+	m_lineHeight = height * scale * info.lineSpacing;
+
+	out.glyphs.clear();
+	out.size      = float2(0.f);
+	out.lineCount = 0;
+
+	if (text.empty()) return;
+
+	// substitutions and kerning never cross a hard line break
+	for (size_t begin = 0; begin <= text.size();) {
+		size_t end = std::min(text.find(U'\n', begin), text.size());
+
+		shapeParagraph(out, impl, text.substr(begin, end - begin), info);
+
+		begin = end + 1;
+	}
+
+	out.size.y = static_cast<float>(out.lineCount) * m_lineHeight;
+}
+
+void priv::TextShaper::shapeParagraph(ShapedText& out, FontImplBase& impl, std::u32string_view text, const TextLayoutInfo& info)
+{
+	const ShapingTables& tables = impl.getShapingTables();
+	const float          scale  = static_cast<float>(info.px) / impl.unitsPerEM;
+
+	m_glyphs.clear();
+
+	for (size_t i = 0; i < text.size(); ++i) {
+		GlyphID glyph_id = 0; // unmapped codepoints show the missing glyph
+
+		impl.tryGetGlyphID(text[i], glyph_id);
+
+		m_glyphs.push_back(ShapingGlyph{ static_cast<uint16_t>(glyph_id), static_cast<uint32_t>(i) });
+	}
+
+	for (const auto& lookup : tables.substitutions)
+		if (info.ligatures || !lookup.discretionary)
+			apply_substitution(m_glyphs, lookup);
+
+	const size_t count = m_glyphs.size();
+	float        pen   = 0.f;
+
+	m_pens.resize(count);
+	m_advances.resize(count);
+
+	for (size_t i = 0; i < count; ++i) {
+		const uint16_t glyph   = m_glyphs[i].glyph;
+		int32_t        advance = glyph < tables.advances.size() ? tables.advances[glyph] : 0;
+
+		if (info.kerning && i + 1 < count)
+			for (const auto& lookup : tables.kerning)
+				advance += get_pair_adjustment(lookup, glyph, m_glyphs[i + 1].glyph);
+
+		m_pens[i]     = pen;
+		m_advances[i] = static_cast<float>(advance) * scale;
+		pen          += m_advances[i];
+	}
+
+	// Greedy wrapping, a line ends after the last break space that keeps it within the width and a
+	// word wider than the whole line is broken between glyphs. The scan resumes at the new line start.
+	const bool wrap       = info.maxWidth > 0.f;
+	size_t     line_begin = 0;
+	size_t     break_at   = 0;
+
+	for (size_t i = 0; i < count;) {
+		const char32_t codepoint = text[m_glyphs[i].cluster];
+
+		if (is_space(codepoint)) {
+			if (is_break_space(codepoint))
+				break_at = i + 1;
+
+			++i;
+			continue;
+		}
+
+		if (wrap && i > line_begin && m_pens[i] + m_advances[i] - m_pens[line_begin] > info.maxWidth) {
+			size_t line_end = break_at > line_begin ? break_at : i;
+
+			emitLine(out, text, line_begin, line_end);
+
+			line_begin = line_end;
+			i          = line_end;
+			continue;
+		}
+
+		++i;
+	}
+
+	emitLine(out, text, line_begin, count);
+}
+
+void priv::TextShaper::emitLine(ShapedText& out, std::u32string_view text, size_t begin, size_t end)
+{
+	const float y      = m_baseline + static_cast<float>(out.lineCount) * m_lineHeight;
+	const float origin = begin < m_pens.size() ? m_pens[begin] : 0.f;
+	float       width  = 0.f;
+
+	for (size_t i = begin; i < end; ++i) {
+		if (is_space(text[m_glyphs[i].cluster])) continue;
+
+		out.glyphs.push_back(ShapedGlyph{ m_glyphs[i].glyph, float2(m_pens[i] - origin, y) });
+
+		// trailing spaces hang past the line and do not widen it
+		width = std::max(width, m_pens[i] + m_advances[i] - origin);
+	}
+
+	out.size.x = std::max(out.size.x, width);
+	out.lineCount++;
+}
+
+// texts kept by a new layout before the least recently shaped ones are evicted
+static constexpr size_t DEFAULT_CACHE_CAPACITY = 4096;
+
+template <class Char>
+static hash128_t hash_text(std::basic_string_view<Char> text)
+{
+	return hash_bytes_128(text.data(), text.size() * sizeof(Char));
+}
+
+bool TextLayout::CacheKey::operator==(const CacheKey& rhs) const VERA_NOEXCEPT
+{
+	return
+		font             == rhs.font &&
+		info.px          == rhs.info.px &&
+		info.maxWidth    == rhs.info.maxWidth &&
+		info.lineSpacing == rhs.info.lineSpacing &&
+		info.kerning     == rhs.info.kerning &&
+		info.ligatures   == rhs.info.ligatures &&
+		textHash         == rhs.textHash &&
+		textSize         == rhs.textSize &&
+		utf32            == rhs.utf32;
+}
+
+size_t TextLayout::CacheKeyHash::operator()(const CacheKey& key) const VERA_NOEXCEPT
+{
+	hash_t seed = key.textHash.low;
+	hash_combine(seed, key.font);
+	hash_combine(seed, key.info.px);
+	hash_combine(seed, key.info.maxWidth);
+	hash_combine(seed, key.info.lineSpacing);
+	hash_combine(seed, key.info.kerning);
+	hash_combine(seed, key.info.ligatures);
+	return static_cast<size_t>(seed);
+}
+
+TextLayout::TextLayout() VERA_NOEXCEPT :
+	m_shaper(std::make_unique<priv::TextShaper>()),
+	m_cache_capacity(DEFAULT_CACHE_CAPACITY),
+	m_use_count(0) {}
+
+obj<TextLayout> TextLayout::create() VERA_NOEXCEPT
+{
+	return obj<TextLayout>(new TextLayout());
+}
+
+TextLayout::~TextLayout() VERA_NOEXCEPT
+{
+	// nothing to do
+}
+
+const ShapedText& TextLayout::shape(const obj<Font>& font, std::string_view text, const TextLayoutInfo& info)
+{
+	CacheKey key = { font.get(), info, hash_text(text), text.size(), false };
+
+	if (auto it = m_cache.find(key); it != m_cache.end()) {
+		it->second.lastUse = ++m_use_count;
+		return it->second.text;
+	}
+
+	if (!font || font->empty())
+		throw Exception("font is not loaded");
+
+	decode_utf8(m_codepoints, text);
+
+	return shapeIntoCache(font, key, m_codepoints);
+}
+
+const ShapedText& TextLayout::shape(const obj<Font>& font, std::u32string_view text, const TextLayoutInfo& info)
+{
+	CacheKey key = { font.get(), info, hash_text(text), text.size(), true };
+
+	if (auto it = m_cache.find(key); it != m_cache.end()) {
+		it->second.lastUse = ++m_use_count;
+		return it->second.text;
+	}
+
+	if (!font || font->empty())
+		throw Exception("font is not loaded");
+
+	return shapeIntoCache(font, key, text);
+}
+
+void TextLayout::shapeUncached(ShapedText& out, const obj<Font>& font, std::string_view text, const TextLayoutInfo& info)
+{
+	if (!font || font->empty())
+		throw Exception("font is not loaded");
+
+	decode_utf8(m_codepoints, text);
+
+	m_shaper->shape(out, *font->m_impl, m_codepoints, info);
+}
+
+void TextLayout::shapeUncached(ShapedText& out, const obj<Font>& font, std::u32string_view text, const TextLayoutInfo& info)
+{
+	if (!font || font->empty())
+		throw Exception("font is not loaded");
+
+	m_shaper->shape(out, *font->m_impl, text, info);
+}
+
+void TextLayout::setCacheCapacity(size_t capacity) VERA_NOEXCEPT
+{
+	m_cache_capacity = capacity;
+}
+
+size_t TextLayout::getCacheCapacity() const VERA_NOEXCEPT
+{
+	return m_cache_capacity;
+}
+
+size_t TextLayout::getCachedTextCount() const VERA_NOEXCEPT
+{
+	return m_cache.size();
+}
+
+void TextLayout::clearCache() VERA_NOEXCEPT
+{
+	m_cache.clear();
+}
+
+// the key missed the cache, the text is shaped into a new entry
+const ShapedText& TextLayout::shapeIntoCache(const obj<Font>& font, const CacheKey& key, std::u32string_view text)
+{
+	if (m_cache_capacity != 0 && m_cache.size() >= m_cache_capacity)
+		evictLeastRecent();
+
+	ShapedText shaped;
+	m_shaper->shape(shaped, *font->m_impl, text, key.info);
+
+	auto& entry = m_cache[key];
+	entry.font    = font;
+	entry.lastUse = ++m_use_count;
+	entry.text    = std::move(shaped);
+
+	return entry.text;
+}
+
+// evicts a quarter of the capacity at once, so a cache that keeps missing sorts its entries rarely
+void TextLayout::evictLeastRecent()
+{
+	const size_t keep_count = m_cache_capacity - std::max<size_t>(m_cache_capacity / 4, 1);
+
+	if (m_cache.size() <= keep_count) return;
+
+	std::vector<uint64_t> last_uses;
+	last_uses.reserve(m_cache.size());
+
+	for (const auto& [key, entry] : m_cache)
+		last_uses.push_back(entry.lastUse);
+
+	// uses are unique, every entry used before the threshold goes
+	auto threshold = last_uses.begin() + (m_cache.size() - keep_count);
+	std::nth_element(last_uses.begin(), threshold, last_uses.end());
+
+	std::erase_if(m_cache, [use = *threshold](const auto& item) {
+		return item.second.lastUse < use;
+	});
+}
+
+VERA_NAMESPACE_END
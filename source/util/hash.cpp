@@ -0,0 +1,555 @@
+#include "../../include/vera/util/hash.h"
+
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define VERA_HASH_X64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#ifdef VERA_HASH_X64
+#if defined(_MSC_VER) && !defined(__clang__)
+#define VERA_TARGET_AVX2
+#else
+#define VERA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+VERA_NAMESPACE_BEGIN
+
+// XXH3 128-bit variant (xxHash 0.8), hashes are equal to XXH3_128bits_withSeed() and the byte order
+// is fixed so persisted keys stay valid across platforms. Inputs longer than 240 bytes, which covers
+// nearly every SPIR-V module, run through 64-byte stripes that are vectorized on x64.
+
+static constexpr uint32_t PRIME32_1 = 0x9E3779B1U;
+static constexpr uint32_t PRIME32_2 = 0x85EBCA77U;
+static constexpr uint32_t PRIME32_3 = 0xC2B2AE3DU;
+static constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87LLU;
+static constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FLLU;
+static constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9LLU;
+static constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63LLU;
+static constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5LLU;
+static constexpr uint64_t PRIME_MX1 = 0x165667919E3779F9LLU;
+static constexpr uint64_t PRIME_MX2 = 0x9FB21C651E98DF25LLU;
+
+static constexpr size_t SECRET_SIZE       = 192;
+static constexpr size_t SECRET_SIZE_MIN   = 136;
+static constexpr size_t STRIPE_SIZE       = 64;
+static constexpr size_t SECRET_STEP       = 8; // secret offset between two stripes
+static constexpr size_t STRIPES_PER_BLOCK = (SECRET_SIZE - STRIPE_SIZE) / SECRET_STEP;
+static constexpr size_t BLOCK_SIZE        = STRIPE_SIZE * STRIPES_PER_BLOCK;
+static constexpr size_t MIDSIZE_MAX       = 240;
+
+alignas(64) static const uint8_t DEFAULT_SECRET[SECRET_SIZE] = {
+	0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+	0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+	0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+	0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+	0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+	0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+	0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+	0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+	0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+	0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+	0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+	0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+// Runs the given number of stripes of input into the eight accumulators, secret moves by
+// SECRET_STEP bytes per stripe
+typedef void (*AccumulateFunc)(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t stripe_count);
+
+// Scrambles the accumulators at the end of every block
+typedef void (*ScrambleFunc)(uint64_t* acc, const uint8_t* secret);
+
+struct HashKernels
+{
+	AccumulateFunc accumulate;
+	ScrambleFunc   scramble;
+};
+
+static uint32_t load_u32_le(const uint8_t* ptr)
+{
+	uint32_t result;
+	memcpy(&result, ptr, sizeof(uint32_t));
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	result = __builtin_bswap32(result);
+#endif
+
+	return result;
+}
+
+static uint64_t load_u64_le(const uint8_t* ptr)
+{
+	uint64_t result;
+	memcpy(&result, ptr, sizeof(uint64_t));
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	result = __builtin_bswap64(result);
+#endif
+
+	return result;
+}
+
+static void store_u64_le(uint8_t* ptr, uint64_t value)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	value = __builtin_bswap64(value);
+#endif
+
+	memcpy(ptr, &value, sizeof(uint64_t));
+}
+
+static uint32_t swap32(uint32_t x)
+{
+	return
+		((x << 24) & 0xff000000U) |
+		((x << 8)  & 0x00ff0000U) |
+		((x >> 8)  & 0x0000ff00U) |
+		((x >> 24) & 0x000000ffU);
+}
+
+static uint64_t swap64(uint64_t x)
+{
+	return (static_cast<uint64_t>(swap32(static_cast<uint32_t>(x))) << 32) | swap32(static_cast<uint32_t>(x >> 32));
+}
+
+static uint32_t rotl32(uint32_t x, int r)
+{
+	return (x << r) | (x >> (32 - r));
+}
+
+static hash128_t mul_64_to_128(uint64_t lhs, uint64_t rhs)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+
+	return hash128_t{ static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64) };
+#elif defined(_MSC_VER) && defined(_M_X64)
+	uint64_t high;
+	uint64_t low = _umul128(lhs, rhs, &high);
+
+	return hash128_t{ low, high };
+#else
+	uint64_t lo_lo = (lhs & 0xffffffff) * (rhs & 0xffffffff);
+	uint64_t hi_lo = (lhs >> 32) * (rhs & 0xffffffff);
+	uint64_t lo_hi = (lhs & 0xffffffff) * (rhs >> 32);
+	uint64_t hi_hi = (lhs >> 32) * (rhs >> 32);
+	uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+	uint64_t upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+	uint64_t lower = (cross << 32) | (lo_lo & 0xffffffff);
+
+	return hash128_t{ lower, upper };
+#endif
+}
+
+static uint64_t mul_128_fold_64(uint64_t lhs, uint64_t rhs)
+{
+	hash128_t product = mul_64_to_128(lhs, rhs);
+
+	return product.low ^ product.high;
+}
+
+static uint64_t xorshift64(uint64_t x, int shift)
+{
+	return x ^ (x >> shift);
+}
+
+static uint64_t xxh64_avalanche(uint64_t x)
+{
+	x ^= x >> 33;
+	x *= PRIME64_2;
+	x ^= x >> 29;
+	x *= PRIME64_3;
+	x ^= x >> 32;
+
+	return x;
+}
+
+static uint64_t xxh3_avalanche(uint64_t x)
+{
+	x  = xorshift64(x, 37);
+	x *= PRIME_MX1;
+	x  = xorshift64(x, 32);
+
+	return x;
+}
+
+////////// short inputs ///////////////////////////////////////////////////////////////////////////
+
+static hash128_t hash_len_1_to_3(const uint8_t* input, size_t size, const uint8_t* secret, uint64_t seed)
+{
+	uint8_t  c1        = input[0];
+	uint8_t  c2        = input[size >> 1];
+	uint8_t  c3        = input[size - 1];
+	uint32_t combinedl = (uint32_t(c1) << 16) | (uint32_t(c2) << 24) | uint32_t(c3) | (uint32_t(size) << 8);
+	uint32_t combinedh = rotl32(swap32(combinedl), 13);
+	uint64_t bitflipl  = (load_u32_le(secret) ^ load_u32_le(secret + 4)) + seed;
+	uint64_t bitfliph  = (load_u32_le(secret + 8) ^ load_u32_le(secret + 12)) - seed;
+
+	return hash128_t{
+		xxh64_avalanche(combinedl ^ bitflipl),
+		xxh64_avalanche(combinedh ^ bitfliph)
+	};
+}
+
+static hash128_t hash_len_4_to_8(const uint8_t* input, size_t size, const uint8_t* secret, uint64_t seed)
+{
+	seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+
+	uint64_t input_lo = load_u32_le(input);
+	uint64_t input_hi = load_u32_le(input + size - 4);
+	uint64_t bitflip  = (load_u64_le(secret + 16) ^ load_u64_le(secret + 24)) + seed;
+	uint64_t keyed    = (input_lo + (input_hi << 32)) ^ bitflip;
+
+	hash128_t m128 = mul_64_to_128(keyed, PRIME64_1 + (size << 2));
+
+	m128.high += m128.low << 1;
+	m128.low  ^= m128.high >> 3;
+	m128.low   = xorshift64(m128.low, 35);
+	m128.low  *= PRIME_MX2;
+	m128.low   = xorshift64(m128.low, 28);
+	m128.high  = xxh3_avalanche(m128.high);
+
+	return m128;
+}
+
+static hash128_t hash_len_9_to_16(const uint8_t* input, size_t size, const uint8_t* secret, uint64_t seed)
+{
+	uint64_t bitflipl = (load_u64_le(secret + 32) ^ load_u64_le(secret + 40)) - seed;
+	uint64_t bitfliph = (load_u64_le(secret + 48) ^ load_u64_le(secret + 56)) + seed;
+	uint64_t input_lo = load_u64_le(input);
+	uint64_t input_hi = load_u64_le(input + size - 8);
+
+	hash128_t m128 = mul_64_to_128(input_lo ^ input_hi ^ bitflipl, PRIME64_1);
+
+	m128.low  += static_cast<uint64_t>(size - 1) << 54;
+	input_hi  ^= bitfliph;
+	m128.high += input_hi + static_cast<uint64_t>(static_cast<uint32_t>(input_hi)) * (PRIME32_2 - 1);
+	m128.low  ^= swap64(m128.high);
+
+	hash128_t h128 = mul_64_to_128(m128.low, PRIME64_2);
+
+	h128.high += m128.high * PRIME64_2;
+	h128.low   = xxh3_avalanche(h128.low);
+	h128.high  = xxh3_avalanche(h128.high);
+
+	return h128;
+}
+
+static hash128_t hash_len_0_to_16(const uint8_t* input, size_t size, const uint8_t* secret, uint64_t seed)
+{
+	if (size > 8)
+		return hash_len_9_to_16(input, size, secret, seed);
+	if (size >= 4)
+		return hash_len_4_to_8(input, size, secret, seed);
+	if (size)
+		return hash_len_1_to_3(input, size, secret, seed);
+
+	return hash128_t{
+		xxh64_avalanche(seed ^ load_u64_le(secret + 64) ^ load_u64_le(secret + 72)),
+		xxh64_avalanche(seed ^ load_u64_le(secret + 80) ^ load_u64_le(secret + 88))
+	};
+}
+
+static uint64_t mix_16(const uint8_t* input, const uint8_t* secret, uint64_t seed)
+{
+	return mul_128_fold_64(
+		load_u64_le(input) ^ (load_u64_le(secret) + seed),
+		load_u64_le(input + 8) ^ (load_u64_le(secret + 8) - seed));
+}
+
+static void mix_32(hash128_t& acc, const uint8_t* input1, const uint8_t* input2, const uint8_t* secret, uint64_t seed)
+{
+	acc.low  += mix_16(input1, secret, seed);
+	acc.low  ^= load_u64_le(input2) + load_u64_le(input2 + 8);
+	acc.high += mix_16(input2, secret + 16, seed);
+	acc.high ^= load_u64_le(input1) + load_u64_le(input1 + 8);
+}
+
+static hash128_t finish_mid_size(const hash128_t& acc, size_t size, uint64_t seed)
+{
+	uint64_t low  = acc.low + acc.high;
+	uint64_t high = acc.low * PRIME64_1 + acc.high * PRIME64_4 + (size - seed) * PRIME64_2;
+
+	return hash128_t{ xxh3_avalanche(low), 0 - xxh3_avalanche(high) };
+}
+
+static hash128_t hash_len_17_to_128(const uint8_t* input, size_t size, const uint8_t* secret, uint64_t seed)
+{
+	hash128_t acc = { size * PRIME64_1, 0 };
+
+	if (size > 32) {
+		if (size > 64) {
+			if (size > 96)
+				mix_32(acc, input + 48, input + size - 64, secret + 96, seed);
+			mix_32(acc, input + 32, input + size - 48, secret + 64, seed);
+		}
+		mix_32(acc, input + 16, input + size - 32, secret + 32, seed);
+	}
+	mix_32(acc, input, input + size - 16, secret, seed);
+
+	return finish_mid_size(acc, size, seed);
+}
+
+static hash128_t hash_len_129_to_240(const uint8_t* input, size_t size, const uint8_t* secret, uint64_t seed)
+{
+	hash128_t acc = { size * PRIME64_1, 0 };
+
+	for (size_t i = 32; i < 160; i += 32)
+		mix_32(acc, input + i - 32, input + i - 16, secret + i - 32, seed);
+
+	acc.low  = xxh3_avalanche(acc.low);
+	acc.high = xxh3_avalanche(acc.high);
+
+	for (size_t i = 160; i <= size; i += 32)
+		mix_32(acc, input + i - 32, input + i - 16, secret + 3 + i - 160, seed);
+
+	mix_32(acc, input + size - 16, input + size - 32, secret + SECRET_SIZE_MIN - 17 - 16, 0 - seed);
+
+	return finish_mid_size(acc, size, seed);
+}
+
+////////// long inputs ////////////////////////////////////////////////////////////////////////////
+
+#ifndef VERA_HASH_X64
+
+static void accumulate_scalar(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t stripe_count)
+{
+	for (size_t n = 0; n < stripe_count; ++n) {
+		const uint8_t* stripe = input + n * STRIPE_SIZE;
+		const uint8_t* key    = secret + n * SECRET_STEP;
+
+		for (size_t i = 0; i < 8; ++i) {
+			uint64_t data     = load_u64_le(stripe + 8 * i);
+			uint64_t data_key = data ^ load_u64_le(key + 8 * i);
+
+			acc[i ^ 1] += data;
+			acc[i]     += (data_key & 0xffffffff) * (data_key >> 32);
+		}
+	}
+}
+
+static void scramble_scalar(uint64_t* acc, const uint8_t* secret)
+{
+	for (size_t i = 0; i < 8; ++i) {
+		uint64_t value = acc[i];
+
+		value ^= value >> 47;
+		value ^= load_u64_le(secret + 8 * i);
+		value *= PRIME32_1;
+
+		acc[i] = value;
+	}
+}
+
+#else // VERA_HASH_X64
+
+static bool cpu_supports_avx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+
+	__cpuid(info, 0);
+	if (info[0] < 7) return false;
+
+	// avx needs both cpu support and the os saving ymm registers on context switches
+	__cpuid(info, 1);
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) return false;
+	if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+// The 32x32 products of a lane take the low and the high half of the keyed data, the data itself
+// is added to the neighbouring 64-bit lane, shuffles below are the SIMD form of acc[i ^ 1]
+
+static void accumulate_sse2(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t stripe_count)
+{
+	auto* acc_ptr = reinterpret_cast<__m128i*>(acc);
+
+	__m128i acc0 = _mm_loadu_si128(acc_ptr);
+	__m128i acc1 = _mm_loadu_si128(acc_ptr + 1);
+	__m128i acc2 = _mm_loadu_si128(acc_ptr + 2);
+	__m128i acc3 = _mm_loadu_si128(acc_ptr + 3);
+
+	auto round = [](__m128i acc_vec, const uint8_t* data, const uint8_t* key) {
+		__m128i data_vec    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		__m128i key_vec     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+		__m128i data_key    = _mm_xor_si128(data_vec, key_vec);
+		__m128i data_key_hi = _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+		__m128i product     = _mm_mul_epu32(data_key, data_key_hi);
+		__m128i data_swap   = _mm_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+
+		return _mm_add_epi64(product, _mm_add_epi64(acc_vec, data_swap));
+	};
+
+	for (size_t n = 0; n < stripe_count; ++n) {
+		const uint8_t* stripe = input + n * STRIPE_SIZE;
+		const uint8_t* key    = secret + n * SECRET_STEP;
+
+		acc0 = round(acc0, stripe, key);
+		acc1 = round(acc1, stripe + 16, key + 16);
+		acc2 = round(acc2, stripe + 32, key + 32);
+		acc3 = round(acc3, stripe + 48, key + 48);
+	}
+
+	_mm_storeu_si128(acc_ptr, acc0);
+	_mm_storeu_si128(acc_ptr + 1, acc1);
+	_mm_storeu_si128(acc_ptr + 2, acc2);
+	_mm_storeu_si128(acc_ptr + 3, acc3);
+}
+
+static void scramble_sse2(uint64_t* acc, const uint8_t* secret)
+{
+	const __m128i prime = _mm_set1_epi32(static_cast<int>(PRIME32_1));
+
+	for (size_t i = 0; i < 4; ++i) {
+		auto*   acc_ptr     = reinterpret_cast<__m128i*>(acc) + i;
+		__m128i acc_vec     = _mm_loadu_si128(acc_ptr);
+		__m128i key_vec     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i);
+		__m128i data_vec    = _mm_xor_si128(acc_vec, _mm_srli_epi64(acc_vec, 47));
+		__m128i data_key    = _mm_xor_si128(data_vec, key_vec);
+		__m128i data_key_hi = _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+		__m128i product_lo  = _mm_mul_epu32(data_key, prime);
+		__m128i product_hi  = _mm_mul_epu32(data_key_hi, prime);
+
+		_mm_storeu_si128(acc_ptr, _mm_add_epi64(product_lo, _mm_slli_epi64(product_hi, 32)));
+	}
+}
+
+VERA_TARGET_AVX2
+static void accumulate_avx2(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t stripe_count)
+{
+	auto* acc_ptr = reinterpret_cast<__m256i*>(acc);
+
+	__m256i acc0 = _mm256_loadu_si256(acc_ptr);
+	__m256i acc1 = _mm256_loadu_si256(acc_ptr + 1);
+
+	for (size_t n = 0; n < stripe_count; ++n) {
+		const auto* stripe = reinterpret_cast<const __m256i*>(input + n * STRIPE_SIZE);
+		const auto* key    = reinterpret_cast<const __m256i*>(secret + n * SECRET_STEP);
+
+		__m256i data0     = _mm256_loadu_si256(stripe);
+		__m256i data1     = _mm256_loadu_si256(stripe + 1);
+		__m256i data_key0 = _mm256_xor_si256(data0, _mm256_loadu_si256(key));
+		__m256i data_key1 = _mm256_xor_si256(data1, _mm256_loadu_si256(key + 1));
+		__m256i product0  = _mm256_mul_epu32(data_key0, _mm256_shuffle_epi32(data_key0, _MM_SHUFFLE(0, 3, 0, 1)));
+		__m256i product1  = _mm256_mul_epu32(data_key1, _mm256_shuffle_epi32(data_key1, _MM_SHUFFLE(0, 3, 0, 1)));
+
+		acc0 = _mm256_add_epi64(product0, _mm256_add_epi64(acc0, _mm256_shuffle_epi32(data0, _MM_SHUFFLE(1, 0, 3, 2))));
+		acc1 = _mm256_add_epi64(product1, _mm256_add_epi64(acc1, _mm256_shuffle_epi32(data1, _MM_SHUFFLE(1, 0, 3, 2))));
+	}
+
+	_mm256_storeu_si256(acc_ptr, acc0);
+	_mm256_storeu_si256(acc_ptr + 1, acc1);
+}
+
+VERA_TARGET_AVX2
+static void scramble_avx2(uint64_t* acc, const uint8_t* secret)
+{
+	const __m256i prime = _mm256_set1_epi32(static_cast<int>(PRIME32_1));
+
+	for (size_t i = 0; i < 2; ++i) {
+		auto*   acc_ptr     = reinterpret_cast<__m256i*>(acc) + i;
+		__m256i acc_vec     = _mm256_loadu_si256(acc_ptr);
+		__m256i key_vec     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i);
+		__m256i data_vec    = _mm256_xor_si256(acc_vec, _mm256_srli_epi64(acc_vec, 47));
+		__m256i data_key    = _mm256_xor_si256(data_vec, key_vec);
+		__m256i data_key_hi = _mm256_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+		__m256i product_lo  = _mm256_mul_epu32(data_key, prime);
+		__m256i product_hi  = _mm256_mul_epu32(data_key_hi, prime);
+
+		_mm256_storeu_si256(acc_ptr, _mm256_add_epi64(product_lo, _mm256_slli_epi64(product_hi, 32)));
+	}
+}
+
+#endif // VERA_HASH_X64
+
+static HashKernels get_hash_kernels()
+{
+#ifdef VERA_HASH_X64
+	static const bool has_avx2 = cpu_supports_avx2();
+
+	if (has_avx2)
+		return { accumulate_avx2, scramble_avx2 };
+	return { accumulate_sse2, scramble_sse2 };
+#else
+	return { accumulate_scalar, scramble_scalar };
+#endif
+}
+
+static uint64_t merge_accumulators(const uint64_t* acc, const uint8_t* secret, uint64_t start)
+{
+	uint64_t result = start;
+
+	for (size_t i = 0; i < 4; ++i)
+		result += mul_128_fold_64(
+			acc[2 * i] ^ load_u64_le(secret + 16 * i),
+			acc[2 * i + 1] ^ load_u64_le(secret + 16 * i + 8));
+
+	return xxh3_avalanche(result);
+}
+
+static hash128_t hash_long(const uint8_t* input, size_t size, uint64_t seed)
+{
+	alignas(32) uint8_t custom_secret[SECRET_SIZE];
+	const uint8_t*      secret = DEFAULT_SECRET;
+
+	if (seed != 0) {
+		for (size_t i = 0; i < SECRET_SIZE; i += 16) {
+			store_u64_le(custom_secret + i, load_u64_le(DEFAULT_SECRET + i) + seed);
+			store_u64_le(custom_secret + i + 8, load_u64_le(DEFAULT_SECRET + i + 8) - seed);
+		}
+		secret = custom_secret;
+	}
+
+	static const HashKernels kernels = get_hash_kernels();
+
+	alignas(32) uint64_t acc[8] = {
+		PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3,
+		PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1
+	};
+
+	size_t block_count = (size - 1) / BLOCK_SIZE;
+
+	for (size_t n = 0; n < block_count; ++n) {
+		kernels.accumulate(acc, input + n * BLOCK_SIZE, secret, STRIPES_PER_BLOCK);
+		kernels.scramble(acc, secret + SECRET_SIZE - STRIPE_SIZE);
+	}
+
+	// the last stripe overlaps the previous one and uses a secret offset unaligned on purpose
+	size_t stripe_count = ((size - 1) - BLOCK_SIZE * block_count) / STRIPE_SIZE;
+
+	kernels.accumulate(acc, input + block_count * BLOCK_SIZE, secret, stripe_count);
+	kernels.accumulate(acc, input + size - STRIPE_SIZE, secret + SECRET_SIZE - STRIPE_SIZE - 7, 1);
+
+	return hash128_t{
+		merge_accumulators(acc, secret + 11, size * PRIME64_1),
+		merge_accumulators(acc, secret + SECRET_SIZE - sizeof(acc) - 11, ~(size * PRIME64_2))
+	};
+}
+
+hash128_t hash_bytes_128(const void* data, size_t size, uint64_t seed) VERA_NOEXCEPT
+{
+	const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+
+	if (size <= 16)
+		return hash_len_0_to_16(bytes, size, DEFAULT_SECRET, seed);
+	if (size <= 128)
+		return hash_len_17_to_128(bytes, size, DEFAULT_SECRET, seed);
+	if (size <= MIDSIZE_MAX)
+		return hash_len_129_to_240(bytes, size, DEFAULT_SECRET, seed);
+
+	return hash_long(bytes, size, seed);
+}
+
+VERA_NAMESPACE_END
@@ -0,0 +1,162 @@
+#include "../../include/vera/util/mapped_file.h"
+
+#include "../../include/vera/core/exception.h"
+#include <utility>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+VERA_NAMESPACE_BEGIN
+
+MappedFile::MappedFile() VERA_NOEXCEPT :
+	m_data(nullptr),
+	m_size(0),
+	m_mapping(nullptr) {}
+
+MappedFile::MappedFile(std::string_view path) :
+	MappedFile()
+{
+	open(path);
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) VERA_NOEXCEPT :
+	m_data(std::exchange(rhs.m_data, nullptr)),
+	m_size(std::exchange(rhs.m_size, 0)),
+	m_mapping(std::exchange(rhs.m_mapping, nullptr)) {}
+
+MappedFile::~MappedFile() VERA_NOEXCEPT
+{
+	close();
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) VERA_NOEXCEPT
+{
+	if (this != &rhs) {
+		close();
+
+		m_data    = std::exchange(rhs.m_data, nullptr);
+		m_size    = std::exchange(rhs.m_size, 0);
+		m_mapping = std::exchange(rhs.m_mapping, nullptr);
+	}
+
+	return *this;
+}
+
+#ifdef _WIN32
+
+void MappedFile::open(std::string_view path)
+{
+	close();
+
+	std::string path_str(path);
+
+	HANDLE file = CreateFileA(
+		path_str.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		NULL,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+		NULL);
+
+	if (file == INVALID_HANDLE_VALUE)
+		throw Exception("failed to open file named {}", path_str);
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size)) {
+		CloseHandle(file);
+		throw Exception("failed to query size of file named {}", path_str);
+	}
+
+	// an empty file cannot be mapped, it is represented by a null view
+	if (file_size.QuadPart == 0) {
+		CloseHandle(file);
+		return;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+
+	if (mapping == NULL)
+		throw Exception("failed to map file named {}", path_str);
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	if (view == NULL) {
+		CloseHandle(mapping);
+		throw Exception("failed to map file named {}", path_str);
+	}
+
+	m_data    = static_cast<const uint8_t*>(view);
+	m_size    = static_cast<size_t>(file_size.QuadPart);
+	m_mapping = mapping;
+}
+
+void MappedFile::close() VERA_NOEXCEPT
+{
+	if (m_data)
+		UnmapViewOfFile(m_data);
+	if (m_mapping)
+		CloseHandle(static_cast<HANDLE>(m_mapping));
+
+	m_data    = nullptr;
+	m_size    = 0;
+	m_mapping = nullptr;
+}
+
+#else
+
+void MappedFile::open(std::string_view path)
+{
+	close();
+
+	std::string path_str(path);
+
+	int fd = ::open(path_str.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw Exception("failed to open file named {}", path_str);
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0) {
+		::close(fd);
+		throw Exception("failed to query size of file named {}", path_str);
+	}
+
+	if (file_stat.st_size == 0) {
+		::close(fd);
+		return;
+	}
+
+	void* view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+
+	if (view == MAP_FAILED)
+		throw Exception("failed to map file named {}", path_str);
+
+	madvise(view, static_cast<size_t>(file_stat.st_size), MADV_SEQUENTIAL);
+
+	m_data = static_cast<const uint8_t*>(view);
+	m_size = static_cast<size_t>(file_stat.st_size);
+}
+
+void MappedFile::close() VERA_NOEXCEPT
+{
+	if (m_data)
+		munmap(const_cast<uint8_t*>(m_data), m_size);
+
+	m_data    = nullptr;
+	m_size    = 0;
+	m_mapping = nullptr;
+}
+
+#endif
+
+VERA_NAMESPACE_END
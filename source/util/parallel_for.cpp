@@ -0,0 +1,106 @@
+#include "parallel_for.h"
+
+VERA_NAMESPACE_BEGIN
+
+ParallelPool& ParallelPool::get() VERA_NOEXCEPT
+{
+	static ParallelPool pool;
+	return pool;
+}
+
+ParallelPool::ParallelPool() VERA_NOEXCEPT :
+	m_thread_count(std::max(std::thread::hardware_concurrency(), 2u) - 1),
+	m_stop(false) {}
+
+ParallelPool::~ParallelPool() VERA_NOEXCEPT
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+
+	m_job_cond.notify_all();
+
+	for (auto& thread : m_threads)
+		thread.join();
+}
+
+void ParallelPool::run(uint32_t slice_count, Task task, void* context) VERA_NOEXCEPT
+{
+	Job job;
+	job.task        = task;
+	job.context     = context;
+	job.sliceCount  = slice_count;
+	job.nextSlice   = 0;
+	job.doneCount   = 0;
+	job.workerCount = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (m_threads.empty())
+			for (uint32_t i = 0; i < m_thread_count; ++i)
+				m_threads.emplace_back(&ParallelPool::loop, this);
+
+		m_jobs.push_back(&job);
+	}
+
+	m_job_cond.notify_all();
+
+	runSlices(job);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	// no worker may pick the job up once it is off the queue, the ones inside it are waited for
+	if (auto iter = std::find(m_jobs.begin(), m_jobs.end(), &job); iter != m_jobs.end())
+		m_jobs.erase(iter);
+
+	m_done_cond.wait(lock, [&] {
+		return job.workerCount == 0 && job.doneCount.load(std::memory_order_acquire) == job.sliceCount;
+	});
+}
+
+void ParallelPool::runSlices(Job& job) VERA_NOEXCEPT
+{
+	for (uint32_t slice; (slice = job.nextSlice.fetch_add(1, std::memory_order_relaxed)) < job.sliceCount;) {
+		job.task(job.context, slice);
+		job.doneCount.fetch_add(1, std::memory_order_release);
+	}
+}
+
+void ParallelPool::loop() VERA_NOEXCEPT
+{
+	while (true) {
+		Job* job;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			m_job_cond.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+
+			if (m_jobs.empty())
+				return;
+
+			job = m_jobs.front();
+
+			// every slice is taken, the remaining ones finish on the threads that took them
+			if (job->nextSlice.load(std::memory_order_relaxed) >= job->sliceCount) {
+				m_jobs.pop_front();
+				continue;
+			}
+
+			job->workerCount++;
+		}
+
+		runSlices(*job);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			job->workerCount--;
+		}
+
+		m_done_cond.notify_all();
+	}
+}
+
+VERA_NAMESPACE_END
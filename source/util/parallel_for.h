@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../../include/vera/core/coredefs.h"
+#include <condition_variable>
+#include <algorithm>
+#include <cstdint>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+VERA_NAMESPACE_BEGIN
+
+// Process wide workers running the slices of parallel_for, one less than the hardware threads as
+// the calling thread runs slices too. Threads are only started by the first parallel call.
+class ParallelPool
+{
+public:
+	using Task = void (*)(void* context, uint32_t slice);
+
+	VERA_NODISCARD static ParallelPool& get() VERA_NOEXCEPT;
+
+	ParallelPool() VERA_NOEXCEPT;
+	~ParallelPool() VERA_NOEXCEPT;
+
+	// returns once task ran for every slice in [0, slice_count), the caller takes slices of its own
+	// job as well, so a task may run parallel_for again without waiting on busy workers
+	void run(uint32_t slice_count, Task task, void* context) VERA_NOEXCEPT;
+
+private:
+	struct Job
+	{
+		Task                  task;
+		void*                 context;
+		uint32_t              sliceCount;
+		std::atomic<uint32_t> nextSlice;
+		std::atomic<uint32_t> doneCount;
+		uint32_t              workerCount; // workers inside runSlices, guarded by the pool lock
+	};
+
+	static void runSlices(Job& job) VERA_NOEXCEPT;
+
+	void loop() VERA_NOEXCEPT;
+
+	std::vector<std::thread> m_threads;
+	std::deque<Job*>         m_jobs;
+	uint32_t                 m_thread_count;
+	bool                     m_stop;
+	std::mutex               m_mutex;
+	std::condition_variable  m_job_cond;
+	std::condition_variable  m_done_cond;
+};
+
+// Runs func(begin, end) over contiguous slices of [0, count), at most one slice per hardware
+// thread and no slice smaller than min_grain items, so small workloads stay on the calling
+// thread. The calling thread processes slices itself. func must not throw.
+template <class Func>
+static void parallel_for(uint32_t count, uint32_t min_grain, Func&& func)
+{
+	const uint32_t hw_threads  = std::max(1u, std::thread::hardware_concurrency());
+	const uint32_t max_slices  = std::max(1u, count / std::max(1u, min_grain));
+	const uint32_t slice_count = std::min(hw_threads, max_slices);
+
+	if (slice_count <= 1) {
+		if (count != 0)
+			func(0u, count);
+		return;
+	}
+
+	auto run_slice = [&](uint32_t slice) {
+		const uint32_t begin = static_cast<uint32_t>(static_cast<uint64_t>(count) * slice / slice_count);
+		const uint32_t end   = static_cast<uint32_t>(static_cast<uint64_t>(count) * (slice + 1) / slice_count);
+
+		func(begin, end);
+	};
+
+	using RunSlice = decltype(run_slice);
+
+	ParallelPool::get().run(slice_count, [](void* context, uint32_t slice) {
+		(*static_cast<RunSlice*>(context))(slice);
+	}, &run_slice);
+}
+
+VERA_NAMESPACE_END
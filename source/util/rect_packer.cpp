@@ -1,7 +1,102 @@
 #include "../../include/vera/util/rect_packer.h"
 
+#include <algorithm>
+#include <numeric>
+
+#define UNPACKED_POSITION UINT32_MAX
+
 VERA_NAMESPACE_BEGIN
 
+// taller rects first, the short ones fill the gaps they leave
+template <class Fn>
+static void sort_pack_order(std::vector<uint32_t>& order, size_t count, Fn&& get_extent)
+{
+	order.resize(count);
+	std::iota(order.begin(), order.end(), 0);
+
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) {
+		const extent2d lhs_extent = get_extent(lhs);
+		const extent2d rhs_extent = get_extent(rhs);
+
+		if (lhs_extent.height != rhs_extent.height)
+			return lhs_extent.height > rhs_extent.height;
+		return lhs_extent.width > rhs_extent.width;
+	});
+}
+
+static bool contains(const urect2d& outer, const urect2d& inner)
+{
+	return
+		inner.x >= outer.x && inner.max_x() <= outer.max_x() &&
+		inner.y >= outer.y && inner.max_y() <= outer.max_y();
+}
+
+static bool intersects(const urect2d& lhs, const urect2d& rhs)
+{
+	return
+		lhs.x < rhs.max_x() && rhs.x < lhs.max_x() &&
+		lhs.y < rhs.max_y() && rhs.y < lhs.max_y();
+}
+
+// rect spanning both along x over the rows they share, it lies in their union when they overlap or
+// touch along x
+static bool join_along_x(const urect2d& lhs, const urect2d& rhs, urect2d& out_rect)
+{
+	const uint32_t min_y = std::max(lhs.y, rhs.y);
+	const uint32_t max_y = std::min(lhs.max_y(), rhs.max_y());
+
+	if (min_y >= max_y || lhs.x > rhs.max_x() || rhs.x > lhs.max_x())
+		return false;
+
+	const uint32_t min_x = std::min(lhs.x, rhs.x);
+	const uint32_t max_x = std::max(lhs.max_x(), rhs.max_x());
+
+	out_rect = urect2d(min_x, min_y, max_x - min_x, max_y - min_y);
+	return true;
+}
+
+static bool join_along_y(const urect2d& lhs, const urect2d& rhs, urect2d& out_rect)
+{
+	const uint32_t min_x = std::max(lhs.x, rhs.x);
+	const uint32_t max_x = std::min(lhs.max_x(), rhs.max_x());
+
+	if (min_x >= max_x || lhs.y > rhs.max_y() || rhs.y > lhs.max_y())
+		return false;
+
+	const uint32_t min_y = std::min(lhs.y, rhs.y);
+	const uint32_t max_y = std::max(lhs.max_y(), rhs.max_y());
+
+	out_rect = urect2d(min_x, min_y, max_x - min_x, max_y - min_y);
+	return true;
+}
+
+// index of the free rect leaving the shortest side after the rect is placed, size of free_rects if none fits
+static size_t find_best_short_side_fit(const std::vector<urect2d>& free_rects, uint32_t width, uint32_t height)
+{
+	size_t   best_idx        = free_rects.size();
+	uint32_t best_short_side = UINT32_MAX;
+	uint32_t best_long_side  = UINT32_MAX;
+
+	for (size_t i = 0; i < free_rects.size(); ++i) {
+		const auto& free_rect = free_rects[i];
+
+		if (free_rect.width < width || free_rect.height < height) continue;
+
+		const uint32_t leftover_x = free_rect.width - width;
+		const uint32_t leftover_y = free_rect.height - height;
+		const uint32_t short_side = std::min(leftover_x, leftover_y);
+		const uint32_t long_side  = std::max(leftover_x, leftover_y);
+
+		if (short_side < best_short_side || (short_side == best_short_side && long_side < best_long_side)) {
+			best_idx        = i;
+			best_short_side = short_side;
+			best_long_side  = long_side;
+		}
+	}
+
+	return best_idx;
+}
+
 std::unique_ptr<RectPacker> RectPacker::createUnique(
 	PackingMethod method,
 	uint32_t      width,
@@ -11,16 +106,26 @@ std::unique_ptr<RectPacker> RectPacker::createUnique(
 	switch (method) {
 	case PackingMethod::Shelf:
 		return std::make_unique<ShelfPacker>(width, height, padding);
+	case PackingMethod::Skyline:
+		return std::make_unique<SkylinePacker>(width, height, padding);
+	case PackingMethod::MaxRects:
+		return std::make_unique<MaxRectsPacker>(width, height, padding);
 	}
 
 	VERA_ASSERT_MSG(false, "Unsupported packing method");
 	return nullptr;
 }
 
+bool RectPacker::isPacked(const urect2d& rect) VERA_NOEXCEPT
+{
+	return rect.x != UNPACKED_POSITION;
+}
+
 RectPacker::RectPacker(uint32_t width, uint32_t height, uint32_t padding) VERA_NOEXCEPT :
 	m_width(width),
 	m_height(height),
-	m_padding(padding) {}
+	m_padding(padding),
+	m_used_area(0) {}
 
 uint32_t RectPacker::getWidth() const VERA_NOEXCEPT
 {
@@ -42,6 +147,67 @@ uint32_t RectPacker::getPadding() const VERA_NOEXCEPT
 	return m_padding;
 }
 
+uint64_t RectPacker::getUsedArea() const VERA_NOEXCEPT
+{
+	return m_used_area;
+}
+
+float RectPacker::getOccupancy() const VERA_NOEXCEPT
+{
+	const uint64_t area = static_cast<uint64_t>(m_width) * m_height;
+
+	return area ? static_cast<float>(static_cast<double>(m_used_area) / area) : 0.f;
+}
+
+VERA_NODISCARD uint32_t RectPacker::pack(
+	array_view<extent2d>  extents,
+	std::vector<urect2d>& out_rects
+) VERA_NOEXCEPT {
+	std::vector<uint32_t> order;
+	urect2d               rect;
+	uint32_t              packed_count = 0;
+
+	sort_pack_order(order, extents.size(), [&](uint32_t idx) { return extents[idx]; });
+
+	out_rects.resize(extents.size());
+
+	for (uint32_t idx : order) {
+		const auto& extent = extents[idx];
+
+		if (pack(extent, rect) == 0) {
+			out_rects[idx] = urect2d(UNPACKED_POSITION, UNPACKED_POSITION, extent.width, extent.height);
+			continue;
+		}
+
+		out_rects[idx] = rect;
+		packed_count++;
+	}
+
+	return packed_count;
+}
+
+VERA_NODISCARD uint32_t RectPacker::packInplace(std::span<urect2d> out_rects) VERA_NOEXCEPT
+{
+	std::vector<uint32_t> order;
+	urect2d               rect;
+	uint32_t              packed_count = 0;
+
+	sort_pack_order(order, out_rects.size(), [&](uint32_t idx) { return out_rects[idx].extent(); });
+
+	for (uint32_t idx : order) {
+		if (pack(out_rects[idx].extent(), rect) == 0) {
+			out_rects[idx].x = UNPACKED_POSITION;
+			out_rects[idx].y = UNPACKED_POSITION;
+			continue;
+		}
+
+		out_rects[idx] = rect;
+		packed_count++;
+	}
+
+	return packed_count;
+}
+
 ShelfPacker::ShelfPacker(uint32_t width, uint32_t height, uint32_t padding) VERA_NOEXCEPT :
 	RectPacker(width, height, padding),
 	m_cursor(padding, padding),
@@ -56,8 +222,9 @@ VERA_NODISCARD uint32_t ShelfPacker::pack(const extent2d& extent, urect2d& out_r
 		return 0;
 
 	if (m_cursor.x + width + m_padding > m_width) {
-		m_cursor.x  = m_padding;
-		m_cursor.y += m_max_height + m_padding;
+		m_cursor.x   = m_padding;
+		m_cursor.y  += m_max_height + m_padding;
+		m_max_height = 0;
 	}
 
 	if (m_cursor.y + height + m_padding > m_height)
@@ -67,46 +234,467 @@ VERA_NODISCARD uint32_t ShelfPacker::pack(const extent2d& extent, urect2d& out_r
 
 	m_cursor.x  += width + m_padding;
 	m_max_height = std::max(m_max_height, height);
+	m_used_area += static_cast<uint64_t>(width) * height;
 
 	return 1;
 }
 
-VERA_NODISCARD uint32_t ShelfPacker::pack(
-	array_view<extent2d>  extents,
-	std::vector<urect2d>& out_rects
-) VERA_NOEXCEPT {
-	urect2d rect;
-	
-	out_rects.clear();
-	out_rects.reserve(extents.size());
+void ShelfPacker::release(const urect2d& rect) VERA_NOEXCEPT
+{
+	m_used_area -= static_cast<uint64_t>(rect.width) * rect.height;
+
+	if (m_used_area == 0) {
+		clear();
+		return;
+	}
+
+	// the last rect of the open shelf gives its space back to the cursor
+	if (rect.y == m_cursor.y && rect.x + rect.width + m_padding == m_cursor.x)
+		m_cursor.x = rect.x;
+}
+
+void ShelfPacker::clear() VERA_NOEXCEPT
+{
+	m_cursor     = uint2(m_padding, m_padding);
+	m_max_height = 0;
+	m_used_area  = 0;
+}
+
+SkylinePacker::SkylinePacker(uint32_t width, uint32_t height, uint32_t padding) VERA_NOEXCEPT :
+	RectPacker(width, height, padding)
+{
+	clear();
+}
+
+VERA_NODISCARD uint32_t SkylinePacker::pack(const extent2d& extent, urect2d& out_rect) VERA_NOEXCEPT
+{
+	uint32_t width  = extent.width;
+	uint32_t height = extent.height;
+
+	if (width + m_padding * 2 > m_width || height + m_padding * 2 > m_height)
+		return 0;
 
-	for (size_t i = 0; i < extents.size(); ++i) {
-		if (pack(extents[i], rect) == 0)
-			return static_cast<uint32_t>(i);
+	// every rect reserves the padding to its right and bottom neighbours
+	const uint32_t padded_width  = width + m_padding;
+	const uint32_t padded_height = height + m_padding;
 
-		out_rects.push_back(rect);
+	urect2d free_rect;
+	if (findFreeRect(padded_width, padded_height, free_rect)) {
+		out_rect     = urect2d(free_rect.x, free_rect.y, width, height);
+		m_used_area += static_cast<uint64_t>(width) * height;
+		return 1;
 	}
 
-	return extents.size();
+	size_t   best_idx   = m_nodes.size();
+	uint32_t best_y     = 0;
+	uint32_t best_top   = UINT32_MAX;
+	uint32_t best_width = UINT32_MAX;
+
+	for (size_t i = 0; i < m_nodes.size(); ++i) {
+		uint32_t y;
+
+		if (!fitNode(i, padded_width, padded_height, y)) continue;
+
+		const uint32_t top = y + padded_height;
+
+		if (top < best_top || (top == best_top && m_nodes[i].width < best_width)) {
+			best_idx   = i;
+			best_y     = y;
+			best_top   = top;
+			best_width = m_nodes[i].width;
+		}
+	}
+
+	if (best_idx == m_nodes.size())
+		return 0;
+
+	const uint32_t x = m_nodes[best_idx].x;
+
+	addNode(best_idx, x, best_y, padded_width, padded_height);
+
+	out_rect     = urect2d(x, best_y, width, height);
+	m_used_area += static_cast<uint64_t>(width) * height;
+
+	return 1;
 }
 
-VERA_NODISCARD uint32_t ShelfPacker::packInplace(std::span<urect2d> out_rects) VERA_NOEXCEPT {
-	urect2d rect;
+void SkylinePacker::release(const urect2d& rect) VERA_NOEXCEPT
+{
+	m_used_area -= static_cast<uint64_t>(rect.width) * rect.height;
+
+	if (m_used_area == 0) {
+		clear();
+		return;
+	}
 
-	for (size_t i = 0; i < out_rects.size(); ++i) {
-		if (pack(out_rects[i].extent(), rect) == 0)
-			return static_cast<uint32_t>(i);
+	const urect2d padded_rect(rect.x, rect.y, rect.width + m_padding, rect.height + m_padding);
 
-		out_rects[i] = rect;
+	if (!lowerNodes(padded_rect))
+		addFreeRect(padded_rect);
+}
+
+void SkylinePacker::clear() VERA_NOEXCEPT
+{
+	m_nodes.clear();
+	m_free_rects.clear();
+	m_used_area = 0;
+
+	if (m_padding < m_width)
+		m_nodes.push_back(Node{ m_padding, m_padding, m_width - m_padding });
+}
+
+bool SkylinePacker::findFreeRect(uint32_t width, uint32_t height, urect2d& out_rect) VERA_NOEXCEPT
+{
+	const size_t idx = find_best_short_side_fit(m_free_rects, width, height);
+
+	if (idx == m_free_rects.size())
+		return false;
+
+	const urect2d free_rect = m_free_rects[idx];
+
+	m_free_rects[idx] = m_free_rects.back();
+	m_free_rects.pop_back();
+
+	// guillotine split along the shorter leftover axis, the pieces stay disjoint
+	const uint32_t leftover_x = free_rect.width - width;
+	const uint32_t leftover_y = free_rect.height - height;
+
+	urect2d right_rect;
+	urect2d bottom_rect;
+
+	if (leftover_x < leftover_y) {
+		right_rect  = urect2d(free_rect.x + width, free_rect.y, leftover_x, height);
+		bottom_rect = urect2d(free_rect.x, free_rect.y + height, free_rect.width, leftover_y);
+	} else {
+		right_rect  = urect2d(free_rect.x + width, free_rect.y, leftover_x, free_rect.height);
+		bottom_rect = urect2d(free_rect.x, free_rect.y + height, width, leftover_y);
 	}
 
-	return out_rects.size();
+	if (right_rect.area() != 0)
+		m_free_rects.push_back(right_rect);
+	if (bottom_rect.area() != 0)
+		m_free_rects.push_back(bottom_rect);
+
+	out_rect = urect2d(free_rect.x, free_rect.y, width, height);
+	return true;
 }
 
-void ShelfPacker::clear() VERA_NOEXCEPT
+bool SkylinePacker::fitNode(size_t idx, uint32_t width, uint32_t height, uint32_t& out_y) const VERA_NOEXCEPT
 {
-	m_cursor     = uint2(m_padding, m_padding);
-	m_max_height = 0;
+	if (m_nodes[idx].x + width > m_width)
+		return false;
+
+	uint32_t width_left = width;
+	uint32_t y          = 0;
+
+	for (size_t i = idx; i < m_nodes.size(); ++i) {
+		y = std::max(y, m_nodes[i].y);
+
+		if (y + height > m_height)
+			return false;
+
+		if (m_nodes[i].width >= width_left) {
+			out_y = y;
+			return true;
+		}
+
+		width_left -= m_nodes[i].width;
+	}
+
+	return false;
+}
+
+void SkylinePacker::addNode(size_t idx, uint32_t x, uint32_t y, uint32_t width, uint32_t height) VERA_NOEXCEPT
+{
+	const uint32_t right = x + width;
+
+	// the rect rests on the highest node it spans, the space above the lower ones is kept
+	for (size_t i = idx; i < m_nodes.size() && m_nodes[i].x < right; ++i) {
+		const auto& node = m_nodes[i];
+
+		if (node.y < y) {
+			const uint32_t waste_right = std::min(node.x + node.width, right);
+			addFreeRect(urect2d(node.x, node.y, waste_right - node.x, y - node.y));
+		}
+	}
+
+	m_nodes.insert(m_nodes.begin() + idx, Node{ x, y + height, width });
+
+	for (size_t i = idx + 1; i < m_nodes.size();) {
+		auto& node = m_nodes[i];
+
+		if (node.x >= right) break;
+
+		const uint32_t shrink = right - node.x;
+
+		if (node.width <= shrink) {
+			m_nodes.erase(m_nodes.begin() + i);
+			continue;
+		}
+
+		node.x     += shrink;
+		node.width -= shrink;
+		break;
+	}
+
+	mergeNodes();
+}
+
+bool SkylinePacker::lowerNodes(const urect2d& rect) VERA_NOEXCEPT
+{
+	const uint32_t right = rect.max_x();
+
+	size_t first = 0;
+	while (first < m_nodes.size() && m_nodes[first].x + m_nodes[first].width <= rect.x)
+		++first;
+
+	// only a rect the skyline rests on along its whole width gives its space back to the skyline
+	size_t last = first;
+	for (; last < m_nodes.size() && m_nodes[last].x < right; ++last)
+		if (m_nodes[last].y != rect.max_y())
+			return false;
+
+	if (first == last)
+		return false;
+
+	const Node     first_node = m_nodes[first];
+	const Node     last_node  = m_nodes[last - 1];
+	const uint32_t last_right = last_node.x + last_node.width;
+
+	Node   pieces[3];
+	size_t piece_count = 0;
+
+	if (first_node.x < rect.x)
+		pieces[piece_count++] = Node{ first_node.x, first_node.y, rect.x - first_node.x };
+	pieces[piece_count++] = Node{ rect.x, rect.y, rect.width };
+	if (right < last_right)
+		pieces[piece_count++] = Node{ right, last_node.y, last_right - right };
+
+	m_nodes.erase(m_nodes.begin() + first, m_nodes.begin() + last);
+	m_nodes.insert(m_nodes.begin() + first, pieces, pieces + piece_count);
+
+	mergeNodes();
+
+	return true;
+}
+
+void SkylinePacker::mergeNodes() VERA_NOEXCEPT
+{
+	for (size_t i = 0; i + 1 < m_nodes.size();) {
+		if (m_nodes[i].y == m_nodes[i + 1].y) {
+			m_nodes[i].width += m_nodes[i + 1].width;
+			m_nodes.erase(m_nodes.begin() + i + 1);
+		} else {
+			++i;
+		}
+	}
+}
+
+void SkylinePacker::addFreeRect(const urect2d& rect) VERA_NOEXCEPT
+{
+	urect2d merged = rect;
+
+	// joins free rects sharing a whole edge, so released neighbours can take a larger rect again
+	for (size_t i = 0; i < m_free_rects.size();) {
+		const auto& free_rect = m_free_rects[i];
+
+		const bool same_row =
+			free_rect.y == merged.y && free_rect.height == merged.height &&
+			(free_rect.max_x() == merged.x || merged.max_x() == free_rect.x);
+		const bool same_column =
+			free_rect.x == merged.x && free_rect.width == merged.width &&
+			(free_rect.max_y() == merged.y || merged.max_y() == free_rect.y);
+
+		if (!same_row && !same_column) {
+			++i;
+			continue;
+		}
+
+		if (same_row)
+			merged = urect2d(std::min(free_rect.x, merged.x), merged.y, free_rect.width + merged.width, merged.height);
+		else
+			merged = urect2d(merged.x, std::min(free_rect.y, merged.y), merged.width, free_rect.height + merged.height);
+
+		m_free_rects[i] = m_free_rects.back();
+		m_free_rects.pop_back();
+		i = 0;
+	}
+
+	m_free_rects.push_back(merged);
+}
+
+MaxRectsPacker::MaxRectsPacker(uint32_t width, uint32_t height, uint32_t padding) VERA_NOEXCEPT :
+	RectPacker(width, height, padding)
+{
+	clear();
+}
+
+VERA_NODISCARD uint32_t MaxRectsPacker::pack(const extent2d& extent, urect2d& out_rect) VERA_NOEXCEPT
+{
+	uint32_t width  = extent.width;
+	uint32_t height = extent.height;
+
+	if (width + m_padding * 2 > m_width || height + m_padding * 2 > m_height)
+		return 0;
+
+	const uint32_t padded_width  = width + m_padding;
+	const uint32_t padded_height = height + m_padding;
+
+	const size_t idx = find_best_short_side_fit(m_free_rects, padded_width, padded_height);
+
+	if (idx == m_free_rects.size())
+		return 0;
+
+	const uint32_t x = m_free_rects[idx].x;
+	const uint32_t y = m_free_rects[idx].y;
+
+	splitFreeRects(urect2d(x, y, padded_width, padded_height));
+	pruneFreeRects();
+
+	out_rect     = urect2d(x, y, width, height);
+	m_used_area += static_cast<uint64_t>(width) * height;
+
+	return 1;
+}
+
+void MaxRectsPacker::release(const urect2d& rect) VERA_NOEXCEPT
+{
+	m_used_area -= static_cast<uint64_t>(rect.width) * rect.height;
+
+	if (m_used_area == 0) {
+		clear();
+		return;
+	}
+
+	const urect2d padded_rect(rect.x, rect.y, rect.width + m_padding, rect.height + m_padding);
+
+	// every maximal rect through the released space is the space joined with free rects one at a
+	// time, so joining each new rect with the others until none is left rebuilds all of them
+	m_new_rects.clear();
+	m_new_rects.push_back(padded_rect);
+
+	// a joined rect shares the rows or the columns of both rects it is made of
+	m_cross_rects.clear();
+	for (const auto& free_rect : m_free_rects) {
+		if ((free_rect.y < padded_rect.max_y() && padded_rect.y < free_rect.max_y()) ||
+			(free_rect.x < padded_rect.max_x() && padded_rect.x < free_rect.max_x()))
+			m_cross_rects.push_back(free_rect);
+	}
+
+	for (size_t i = 0; i < m_new_rects.size(); ++i) {
+		const urect2d new_rect = m_new_rects[i];
+
+		for (const auto& cross_rect : m_cross_rects)
+			joinReleasedRect(new_rect, cross_rect);
+		for (size_t j = 0; j < i; ++j)
+			joinReleasedRect(new_rect, m_new_rects[j]);
+	}
+
+	std::erase_if(m_free_rects, [&](const urect2d& free_rect) {
+		return std::any_of(m_new_rects.begin(), m_new_rects.end(), [&](const urect2d& new_rect) {
+			return contains(new_rect, free_rect);
+		});
+	});
+
+	// a rect joined later may contain earlier ones, never the other way around
+	for (size_t i = 0; i < m_new_rects.size(); ++i) {
+		const urect2d new_rect = m_new_rects[i];
+
+		const bool redundant = std::any_of(m_new_rects.begin() + i + 1, m_new_rects.end(), [&](const urect2d& rect) {
+			return contains(rect, new_rect);
+		});
+
+		if (!redundant)
+			m_free_rects.push_back(new_rect);
+	}
+}
+
+void MaxRectsPacker::clear() VERA_NOEXCEPT
+{
+	m_free_rects.clear();
+	m_used_area = 0;
+
+	if (m_padding < m_width && m_padding < m_height)
+		m_free_rects.push_back(urect2d(m_padding, m_padding, m_width - m_padding, m_height - m_padding));
+}
+
+void MaxRectsPacker::splitFreeRects(const urect2d& rect) VERA_NOEXCEPT
+{
+	m_new_rects.clear();
+
+	for (size_t i = 0; i < m_free_rects.size();) {
+		const urect2d free_rect = m_free_rects[i];
+
+		if (!intersects(free_rect, rect)) {
+			++i;
+			continue;
+		}
+
+		// up to four maximal rects around the placed one
+		if (rect.x > free_rect.x)
+			m_new_rects.push_back(urect2d(free_rect.x, free_rect.y, rect.x - free_rect.x, free_rect.height));
+		if (rect.max_x() < free_rect.max_x())
+			m_new_rects.push_back(urect2d(rect.max_x(), free_rect.y, free_rect.max_x() - rect.max_x(), free_rect.height));
+		if (rect.y > free_rect.y)
+			m_new_rects.push_back(urect2d(free_rect.x, free_rect.y, free_rect.width, rect.y - free_rect.y));
+		if (rect.max_y() < free_rect.max_y())
+			m_new_rects.push_back(urect2d(free_rect.x, rect.max_y(), free_rect.width, free_rect.max_y() - rect.max_y()));
+
+		m_free_rects[i] = m_free_rects.back();
+		m_free_rects.pop_back();
+	}
+}
+
+void MaxRectsPacker::joinReleasedRect(const urect2d& lhs, urect2d rhs) VERA_NOEXCEPT
+{
+	urect2d joined_rects[2];
+	size_t  joined_count = 0;
+
+	if (join_along_x(lhs, rhs, joined_rects[joined_count]))
+		joined_count++;
+	if (join_along_y(lhs, rhs, joined_rects[joined_count]))
+		joined_count++;
+
+	// the released rect comes first, a joined rect missing it is never part of a new maximal one,
+	// and one overlapping it cannot lie inside a free rect from before the release
+	for (size_t i = 0; i < joined_count; ++i) {
+		const urect2d& joined_rect = joined_rects[i];
+
+		if (!intersects(joined_rect, m_new_rects.front()))
+			continue;
+
+		if (std::any_of(m_new_rects.begin(), m_new_rects.end(), [&](const urect2d& new_rect) {
+			return contains(new_rect, joined_rect);
+		}))
+			continue;
+
+		m_new_rects.push_back(joined_rect);
+	}
+}
+
+void MaxRectsPacker::pruneFreeRects() VERA_NOEXCEPT
+{
+	// new rects are pieces of removed ones, so no untouched free rect can lie inside them
+	for (size_t i = 0; i < m_new_rects.size();) {
+		const urect2d new_rect = m_new_rects[i];
+
+		bool redundant = std::any_of(m_free_rects.begin(), m_free_rects.end(), [&](const urect2d& free_rect) {
+			return contains(free_rect, new_rect);
+		});
+
+		// of two equal rects only the later one is dropped
+		for (size_t j = 0; j < m_new_rects.size() && !redundant; ++j)
+			redundant = j != i && contains(m_new_rects[j], new_rect) && (j < i || !contains(new_rect, m_new_rects[j]));
+
+		if (redundant) {
+			m_new_rects[i] = m_new_rects.back();
+			m_new_rects.pop_back();
+		} else {
+			++i;
+		}
+	}
+
+	m_free_rects.insert(m_free_rects.end(), m_new_rects.begin(), m_new_rects.end());
 }
 
-VERA_NAMESPACE_END
\ No newline at end of file
+VERA_NAMESPACE_END
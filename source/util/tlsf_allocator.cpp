@@ -0,0 +1,305 @@
+#include "../../include/vera/util/tlsf_allocator.h"
+
+#include <algorithm>
+#include <bit>
+
+VERA_NAMESPACE_BEGIN
+
+static void map_size(size_t size, uint32_t sl_bits, uint32_t& fl, uint32_t& sl)
+{
+	if (size < (size_t(1) << sl_bits)) {
+		fl = 0;
+		sl = static_cast<uint32_t>(size);
+	} else {
+		uint32_t msb = static_cast<uint32_t>(std::bit_width(size)) - 1;
+
+		fl = msb - sl_bits + 1;
+		sl = static_cast<uint32_t>(size >> (msb - sl_bits)) & ((1 << sl_bits) - 1);
+	}
+}
+
+static size_t round_up_size(size_t size, uint32_t sl_bits)
+{
+	if (size < (size_t(1) << sl_bits))
+		return size;
+
+	uint32_t msb   = static_cast<uint32_t>(std::bit_width(size)) - 1;
+	size_t   round = (size_t(1) << (msb - sl_bits)) - 1;
+
+	// sizes close to SIZE_MAX can not be served anyway, let the search fail
+	return size + round < size ? SIZE_MAX : size + round;
+}
+
+static size_t align_up(size_t value, size_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+TLSFAllocator::TLSFAllocator(size_t size) VERA_NOEXCEPT :
+	m_size(size)
+{
+	VERA_ASSERT_MSG(size != 0, "cannot create allocator with zero size");
+
+	clear();
+}
+
+bool TLSFAllocator::allocate(size_t size, size_t alignment, TLSFAllocation& out_allocation) VERA_NOEXCEPT
+{
+	VERA_ASSERT_MSG(size != 0, "cannot allocate zero size");
+	VERA_ASSERT_MSG(alignment != 0 && (alignment & (alignment - 1)) == 0, "alignment must be power of 2");
+
+	if (m_size < size || m_size - size < alignment - 1)
+		return false;
+
+	uint32_t id = findFreeNode(round_up_size(size + alignment - 1, SL_BITS));
+
+	if (id == INVALID_ID)
+		return false;
+
+	removeFreeNode(id);
+
+	size_t offset  = m_nodes[id].offset;
+	size_t aligned = align_up(offset, alignment);
+
+	// give the alignment padding back as a free range in front of the allocation
+	if (size_t padding = aligned - offset) {
+		uint32_t front = createNode(offset, padding);
+		auto&    node  = m_nodes[id];
+
+		m_nodes[front].prevPhysical = node.prevPhysical;
+		m_nodes[front].nextPhysical = id;
+
+		if (node.prevPhysical != INVALID_ID)
+			m_nodes[node.prevPhysical].nextPhysical = front;
+
+		node.prevPhysical = front;
+		node.offset       = aligned;
+		node.size        -= padding;
+
+		insertFreeNode(front);
+	}
+
+	if (size_t remain = m_nodes[id].size - size) {
+		uint32_t back = createNode(aligned + size, remain);
+		auto&    node = m_nodes[id];
+
+		m_nodes[back].prevPhysical = id;
+		m_nodes[back].nextPhysical = node.nextPhysical;
+
+		if (node.nextPhysical != INVALID_ID)
+			m_nodes[node.nextPhysical].prevPhysical = back;
+
+		node.nextPhysical = back;
+		node.size         = size;
+
+		insertFreeNode(back);
+	}
+
+	m_nodes[id].used = true;
+
+	m_used_size        += size;
+	m_allocation_count += 1;
+
+	out_allocation.id     = id;
+	out_allocation.offset = aligned;
+	out_allocation.size   = size;
+
+	return true;
+}
+
+void TLSFAllocator::free(uint32_t id) VERA_NOEXCEPT
+{
+	VERA_ASSERT_MSG(id < m_nodes.size() && m_nodes[id].used, "invalid allocation id");
+
+	m_nodes[id].used    = false;
+	m_used_size        -= m_nodes[id].size;
+	m_allocation_count -= 1;
+
+	// merge with previous range
+	if (uint32_t prev = m_nodes[id].prevPhysical; prev != INVALID_ID && !m_nodes[prev].used) {
+		removeFreeNode(prev);
+
+		auto& node = m_nodes[id];
+
+		node.offset       = m_nodes[prev].offset;
+		node.size        += m_nodes[prev].size;
+		node.prevPhysical = m_nodes[prev].prevPhysical;
+
+		if (node.prevPhysical != INVALID_ID)
+			m_nodes[node.prevPhysical].nextPhysical = id;
+
+		releaseNode(prev);
+	}
+
+	// merge with next range
+	if (uint32_t next = m_nodes[id].nextPhysical; next != INVALID_ID && !m_nodes[next].used) {
+		removeFreeNode(next);
+
+		auto& node = m_nodes[id];
+
+		node.size        += m_nodes[next].size;
+		node.nextPhysical = m_nodes[next].nextPhysical;
+
+		if (node.nextPhysical != INVALID_ID)
+			m_nodes[node.nextPhysical].prevPhysical = id;
+
+		releaseNode(next);
+	}
+
+	insertFreeNode(id);
+}
+
+void TLSFAllocator::clear() VERA_NOEXCEPT
+{
+	for (auto& heads : m_heads)
+		heads.fill(INVALID_ID);
+
+	m_nodes.clear();
+	m_unused_nodes.clear();
+	m_sl_bitmaps.fill(0);
+	m_fl_bitmap        = 0;
+	m_used_size        = 0;
+	m_allocation_count = 0;
+	m_free_count       = 0;
+
+	insertFreeNode(createNode(0, m_size));
+}
+
+size_t TLSFAllocator::size() const VERA_NOEXCEPT
+{
+	return m_size;
+}
+
+size_t TLSFAllocator::usedSize() const VERA_NOEXCEPT
+{
+	return m_used_size;
+}
+
+uint32_t TLSFAllocator::allocationCount() const VERA_NOEXCEPT
+{
+	return m_allocation_count;
+}
+
+bool TLSFAllocator::empty() const VERA_NOEXCEPT
+{
+	return m_allocation_count == 0;
+}
+
+TLSFStatistics TLSFAllocator::getStatistics() const VERA_NOEXCEPT
+{
+	TLSFStatistics result;
+	result.totalSize        = m_size;
+	result.usedSize         = m_used_size;
+	result.largestFreeRange = 0;
+	result.allocationCount  = m_allocation_count;
+	result.freeRangeCount   = m_free_count;
+
+	// only the highest non-empty list can hold the largest range
+	if (m_fl_bitmap) {
+		uint32_t fl = 63 - std::countl_zero(m_fl_bitmap);
+		uint32_t sl = 31 - std::countl_zero(m_sl_bitmaps[fl]);
+
+		for (uint32_t id = m_heads[fl][sl]; id != INVALID_ID; id = m_nodes[id].nextFree)
+			result.largestFreeRange = std::max(result.largestFreeRange, m_nodes[id].size);
+	}
+
+	return result;
+}
+
+uint32_t TLSFAllocator::createNode(size_t offset, size_t size) VERA_NOEXCEPT
+{
+	uint32_t id;
+
+	if (m_unused_nodes.empty()) {
+		id = static_cast<uint32_t>(m_nodes.size());
+		m_nodes.emplace_back();
+	} else {
+		id = m_unused_nodes.back();
+		m_unused_nodes.pop_back();
+	}
+
+	auto& node = m_nodes[id];
+	node.offset       = offset;
+	node.size         = size;
+	node.prevPhysical = INVALID_ID;
+	node.nextPhysical = INVALID_ID;
+	node.prevFree     = INVALID_ID;
+	node.nextFree     = INVALID_ID;
+	node.used         = false;
+
+	return id;
+}
+
+void TLSFAllocator::releaseNode(uint32_t id) VERA_NOEXCEPT
+{
+	m_unused_nodes.push_back(id);
+}
+
+void TLSFAllocator::insertFreeNode(uint32_t id) VERA_NOEXCEPT
+{
+	uint32_t fl, sl;
+	map_size(m_nodes[id].size, SL_BITS, fl, sl);
+
+	auto& node = m_nodes[id];
+	auto& head = m_heads[fl][sl];
+
+	node.prevFree = INVALID_ID;
+	node.nextFree = head;
+
+	if (head != INVALID_ID)
+		m_nodes[head].prevFree = id;
+
+	head             = id;
+	m_sl_bitmaps[fl] |= 1u << sl;
+	m_fl_bitmap      |= uint64_t(1) << fl;
+	m_free_count     += 1;
+}
+
+void TLSFAllocator::removeFreeNode(uint32_t id) VERA_NOEXCEPT
+{
+	uint32_t fl, sl;
+	map_size(m_nodes[id].size, SL_BITS, fl, sl);
+
+	auto& node = m_nodes[id];
+
+	if (node.prevFree != INVALID_ID)
+		m_nodes[node.prevFree].nextFree = node.nextFree;
+	else
+		m_heads[fl][sl] = node.nextFree;
+
+	if (node.nextFree != INVALID_ID)
+		m_nodes[node.nextFree].prevFree = node.prevFree;
+
+	if (m_heads[fl][sl] == INVALID_ID) {
+		m_sl_bitmaps[fl] &= ~(1u << sl);
+
+		if (m_sl_bitmaps[fl] == 0)
+			m_fl_bitmap &= ~(uint64_t(1) << fl);
+	}
+
+	node.prevFree  = INVALID_ID;
+	node.nextFree  = INVALID_ID;
+	m_free_count  -= 1;
+}
+
+uint32_t TLSFAllocator::findFreeNode(size_t size) const VERA_NOEXCEPT
+{
+	uint32_t fl, sl;
+	map_size(size, SL_BITS, fl, sl);
+
+	uint32_t sl_map = m_sl_bitmaps[fl] & (~0u << sl);
+
+	if (sl_map == 0) {
+		uint64_t fl_map = fl + 1 < FL_COUNT ? m_fl_bitmap & (~uint64_t(0) << (fl + 1)) : 0;
+
+		if (fl_map == 0)
+			return INVALID_ID;
+
+		fl     = std::countr_zero(fl_map);
+		sl_map = m_sl_bitmaps[fl];
+	}
+
+	return m_heads[fl][std::countr_zero(sl_map)];
+}
+
+VERA_NAMESPACE_END
@@ -36,8 +36,8 @@ struct Vertex3D
 
 void map_mesh_data(vr::GraphicsPass* pass, vr::ref<vr::scene::MeshAttribute> mesh_attr)
 {
-	auto* vtx_map = reinterpret_cast<Vertex3D*>(pass->getVertexBuffer()->getDeviceMemory()->map());
-	auto* idx_map = reinterpret_cast<uint32_t*>(pass->getIndexBuffer()->getDeviceMemory()->map());
+	auto* vtx_map = reinterpret_cast<Vertex3D*>(pass->getVertexBuffer()->map());
+	auto* idx_map = reinterpret_cast<uint32_t*>(pass->getIndexBuffer()->map());
 
 	auto& vertices = mesh_attr->getVertices();
 	auto& indicies = mesh_attr->getIndices();
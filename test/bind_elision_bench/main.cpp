@@ -0,0 +1,81 @@
+#include <vera/vera.h>
+#include <vector>
+
+using namespace std;
+
+// binds one shader parameter per draw, the push constant changes every change_every draws and
+// the descriptor set never does, so only the changes may reach the command buffer
+static bool run_case(
+	const vr::obj<vr::CommandBuffer>&   cmd,
+	const vr::obj<vr::ShaderParameter>& params,
+	uint32_t                            draw_count,
+	uint32_t                            change_every
+) {
+	auto root_var = params->getRootVariable();
+
+	cmd->reset();
+	cmd->begin();
+
+	vr::StopWatch watch;
+	watch.start();
+
+	for (uint32_t i = 0; i < draw_count; ++i) {
+		if (i % change_every == 0)
+			root_var["pc"]["mat"] = vr::float4x4(1.f + i / change_every);
+
+		cmd->bindShaderParameter(params);
+	}
+
+	float ms = watch.get_ms();
+
+	cmd->end();
+
+	const auto     stats        = cmd->getBindStatistics();
+	const uint32_t change_count = (draw_count + change_every - 1) / change_every;
+
+	bool ok =
+		stats.descriptorSetBinds == 1 &&
+		stats.descriptorSetsBound == 1 &&
+		stats.descriptorSetsSkipped == draw_count - 1 &&
+		stats.pushConstantRanges == change_count &&
+		stats.pushConstantRangesSkipped == draw_count - change_count;
+
+	vr::Logger::info("{:>6} binds, push constant changes every {:>3}: {:7.3f}ms, {} set binds, {} of {} pushes skipped [{}]",
+		draw_count,
+		change_every,
+		ms,
+		stats.descriptorSetBinds,
+		stats.pushConstantRangesSkipped,
+		draw_count,
+		ok ? "ok" : "FAILED");
+
+	return ok;
+}
+
+int main()
+{
+	auto device = vr::Device::create(vr::Context::create());
+	auto cmd    = vr::CommandBuffer::create(device);
+
+	auto vert_shader = vr::Shader::create(device, "spirv/obj_loading.vert.glsl.spv");
+	auto frag_shader = vr::Shader::create(device, "spirv/obj_loading.frag.glsl.spv");
+
+	auto reflection = vr::ProgramReflection::create(
+		device,
+		{
+			vr::ShaderReflection::create(device, vert_shader),
+			vr::ShaderReflection::create(device, frag_shader)
+		});
+
+	auto params  = vr::ShaderParameter::create(device, reflection);
+	auto texture = vr::Texture::create(device, vr::Image(4, 4, vr::Format::RGBA8Unorm));
+
+	params->getRootVariable()["sTexture"] = texture;
+
+	bool ok = true;
+
+	for (uint32_t change_every : { 1u, 4u, 64u })
+		ok &= run_case(cmd, params, 10000, change_every);
+
+	return ok ? 0 : 1;
+}
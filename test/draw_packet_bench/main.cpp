@@ -0,0 +1,115 @@
+#include <vera/vera.h>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+struct Instance
+{
+	uint32_t drawID;
+	uint32_t bucket;
+	uint32_t mesh;
+	uint32_t padding;
+	float    transform[12];
+};
+
+static vr::DrawMeshRange get_mesh_range(uint32_t mesh)
+{
+	vr::DrawMeshRange range;
+	range.indexCount   = 36 + mesh * 3;
+	range.firstIndex   = mesh * 1024;
+	range.vertexOffset = static_cast<int32_t>(mesh * 256);
+	return range;
+}
+
+// every draw must appear once, in the packet of its bucket and the command of its mesh
+static bool verify(const vr::DrawPacketBuilder& builder, const vector<std::byte>& instance_data, uint32_t draw_count)
+{
+	auto*        instances = reinterpret_cast<const Instance*>(instance_data.data());
+	vector<bool> seen(draw_count);
+
+	for (const auto& packet : builder.getPackets()) {
+		for (uint32_t i = 0; i < packet.commandCount; ++i) {
+			const auto& cmd = builder.getCommands()[packet.firstCommand + i];
+
+			for (uint32_t j = 0; j < cmd.instanceCount; ++j) {
+				const auto& instance = instances[cmd.firstInstance + j];
+				const auto  range    = get_mesh_range(instance.mesh);
+
+				if (instance.bucket != packet.bucket ||
+					range.indexCount != cmd.indexCount ||
+					range.firstIndex != cmd.firstIndex ||
+					range.vertexOffset != cmd.vertexOffset ||
+					seen[instance.drawID])
+					return false;
+
+				seen[instance.drawID] = true;
+			}
+		}
+	}
+
+	for (bool s : seen)
+		if (!s) return false;
+
+	return true;
+}
+
+static void run_case(uint32_t draw_count, uint32_t bucket_count, uint32_t mesh_count)
+{
+	const uint32_t repeat = 10;
+
+	mt19937          rng(0x5eed);
+	vector<Instance> scene(draw_count);
+
+	for (uint32_t i = 0; i < draw_count; ++i) {
+		scene[i]        = {};
+		scene[i].drawID = i;
+		scene[i].bucket = rng() % bucket_count;
+		scene[i].mesh   = rng() % mesh_count;
+	}
+
+	vr::DrawPacketBuilder builder(sizeof(Instance));
+	vector<std::byte>     command_data;
+	vector<std::byte>     instance_data;
+	float                 best_ms = 0.f;
+
+	builder.reserve(draw_count);
+
+	for (uint32_t i = 0; i < repeat; ++i) {
+		vr::StopWatch watch;
+		watch.start();
+
+		builder.clear();
+		for (const auto& instance : scene)
+			builder.add(instance.bucket, get_mesh_range(instance.mesh), instance);
+		builder.build();
+
+		command_data.resize(builder.getCommandSize());
+		instance_data.resize(builder.getInstanceDataSize());
+		builder.write(command_data.data(), instance_data.data());
+
+		float ms = watch.get_ms();
+		if (i == 0 || ms < best_ms)
+			best_ms = ms;
+	}
+
+	vr::Logger::info("{:>7} draws, {:>4} buckets, {:>5} meshes: {:7.3f}ms ({:6.2f} M draws/s), {:>6} commands in {:>4} packets [{}]",
+		draw_count,
+		bucket_count,
+		mesh_count,
+		best_ms,
+		draw_count / (best_ms * 1000.0),
+		builder.getCommands().size(),
+		builder.getPackets().size(),
+		verify(builder, instance_data, draw_count) ? "ok" : "FAILED");
+}
+
+int main()
+{
+	run_case(1000, 8, 64);
+	run_case(10000, 32, 256);
+	run_case(50000, 64, 1024);
+	run_case(200000, 128, 4096);
+
+	return 0;
+}
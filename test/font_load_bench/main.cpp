@@ -0,0 +1,62 @@
+#include <vera/vera.h>
+#include <vector>
+
+using namespace std;
+
+// bytes the outlines took when every glyph was a std::map node owning one std::vector per contour,
+// each heap block is counted with a 16 byte allocator header
+static size_t get_node_layout_size(size_t glyph_count, size_t contour_count, size_t point_count)
+{
+	const size_t header   = 16;
+	const size_t node     = 32 + sizeof(vr::GlyphID) + sizeof(vr::AABB2D) + sizeof(vector<vector<vr::GlyphPoint>>) + sizeof(vr::array_view<uint8_t>);
+	const size_t contours = sizeof(vector<vr::GlyphPoint>);
+
+	return
+		glyph_count * (node + header) +
+		glyph_count * header + contour_count * contours +
+		contour_count * header + point_count * sizeof(vr::GlyphPoint);
+}
+
+static void run_case(string_view path)
+{
+	vr::StopWatch watch;
+	watch.start();
+
+	auto font = vr::Font::create(path);
+
+	float open_ms = watch.get_ms();
+
+	watch.start();
+	font->loadAllGlyphs();
+
+	float load_ms = watch.get_ms();
+
+	size_t glyph_count   = font->getGlyphCount();
+	size_t contour_count = 0;
+	size_t point_count   = 0;
+
+	for (vr::GlyphID glyph_id = 0; glyph_id < glyph_count; ++glyph_id) {
+		const vr::Glyph& glyph = font->findGlyph(glyph_id);
+
+		contour_count += glyph.contours.size();
+		point_count   += glyph.contours.points().size();
+	}
+
+	size_t arena_size = glyph_count * sizeof(vr::Glyph) + contour_count * sizeof(uint32_t) + point_count * sizeof(vr::GlyphPoint);
+	size_t node_size  = get_node_layout_size(glyph_count, contour_count, point_count);
+
+	vr::Logger::info("{}: {} glyphs, {} contours, {} points", font->getName(), glyph_count, contour_count, point_count);
+	vr::Logger::info("  open {:8.2f}ms, load all glyphs {:8.2f}ms", open_ms, load_ms);
+	vr::Logger::info("  outlines {:8.1f}KB in the arena, {:8.1f}KB and {} allocations as map nodes and vectors",
+		arena_size / 1024.0,
+		node_size / 1024.0,
+		glyph_count * 2 + contour_count);
+}
+
+int main()
+{
+	run_case("C:\\Windows\\Fonts\\consola.ttf");
+	run_case("C:\\Windows\\Fonts\\msyh.ttc");
+
+	return 0;
+}
@@ -0,0 +1,89 @@
+#include <vera/vera.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const char* get_atlas_type_name(vr::AtlasType type)
+{
+	switch (type) {
+	case vr::AtlasType::HardMask: return "hard mask";
+	case vr::AtlasType::SoftMask: return "soft mask";
+	case vr::AtlasType::SDF:      return "sdf";
+	case vr::AtlasType::PSDF:     return "psdf";
+	case vr::AtlasType::MSDF:     return "msdf";
+	case vr::AtlasType::MTSDF:    return "mtsdf";
+	default:                      return "";
+	}
+}
+
+// bakes the glyphs without any device, only the cpu layers are produced
+static void run_case(vr::obj<vr::Font> font, vr::AtlasType type, uint32_t px)
+{
+	vr::FontAtlasCreateInfo atlas_info = {
+		.font        = font,
+		.type        = type,
+		.atlasWidth  = 1024,
+		.atlasHeight = 1024,
+		.padding     = 1,
+		.sdfFontSize = px,
+		.generator   = vr::AtlasGenerator::CPU
+	};
+
+	auto atlas = vr::FontAtlas::create({}, atlas_info);
+
+	vr::StopWatch watch;
+	watch.start();
+
+	(void)atlas->loadGlyphRange({ 0, font->getGlyphCount() }, px);
+
+	float ms = watch.get_ms();
+
+	// every glyph is packed already, the text only fills the codepoint index
+	const u32string_view           text = U"Sphinx of black quartz, judge my vow";
+	vector<const vr::PackedGlyph*> packed(text.size());
+
+	uint32_t miss_count = atlas->getGlyphs(text, px, packed);
+
+	if (miss_count != 0 || atlas->findGlyphs(text, px, packed) != 0)
+		vr::Logger::warn("{} codepoints of the sample text are not in the atlas", miss_count);
+
+	uint32_t layer_count = 0;
+	while (atlas->getLayerImage(px, layer_count))
+		++layer_count;
+
+	vr::Logger::info("{:>10} {:>3}px {} glyphs into {} layers: {:8.2f}ms",
+		get_atlas_type_name(type),
+		px,
+		font->getGlyphCount(),
+		layer_count,
+		ms);
+
+	// multi channel layers hold float distances, only the 8 bit layers are written out
+	if (layer_count != 0 && atlas->getLayerImage(px, 0)->format() == vr::Format::R8Unorm) {
+		vr::Image layer = *atlas->getLayerImage(px, 0);
+		layer.saveToFile("glyph_bake_" + to_string(static_cast<int>(type)) + "_" + to_string(px) + ".png");
+	}
+}
+
+int main()
+{
+	auto font_manager = vr::FontManager::create();
+	font_manager->loadFont("C:\\Windows\\Fonts\\consola.ttf");
+
+	auto font = font_manager->getFonts()[0];
+
+	for (uint32_t px : { 12u, 16u, 32u }) {
+		run_case(font, vr::AtlasType::HardMask, px);
+		run_case(font, vr::AtlasType::SoftMask, px);
+	}
+
+	for (uint32_t px : { 32u, 64u }) {
+		run_case(font, vr::AtlasType::SDF, px);
+		run_case(font, vr::AtlasType::PSDF, px);
+		run_case(font, vr::AtlasType::MSDF, px);
+		run_case(font, vr::AtlasType::MTSDF, px);
+	}
+
+	return 0;
+}
@@ -0,0 +1,76 @@
+#include <vera/vera.h>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+// the word loop shaders were keyed with before the code key became the cache key
+static size_t hash_words(const vector<uint32_t>& words)
+{
+	size_t seed = 0;
+
+	for (uint32_t word : words)
+		vr::hash_combine(seed, word);
+
+	return seed;
+}
+
+static void run_case(size_t byte_size, uint32_t module_count)
+{
+	const uint32_t repeat = 5;
+	const double   gbytes = static_cast<double>(byte_size) * module_count / (1024.0 * 1024.0 * 1024.0);
+
+	mt19937                  rng(0x5eed);
+	vector<vector<uint32_t>> modules(module_count);
+
+	for (auto& words : modules) {
+		words.resize(byte_size / sizeof(uint32_t));
+		for (uint32_t& word : words)
+			word = rng();
+	}
+
+	float  combine_ms = 0.f;
+	float  xxh3_ms    = 0.f;
+	size_t checksum   = 0;
+
+	for (uint32_t i = 0; i < repeat; ++i) {
+		vr::StopWatch watch;
+		watch.start();
+
+		for (const auto& words : modules)
+			checksum ^= hash_words(words);
+
+		float ms = watch.get_ms();
+		if (i == 0 || ms < combine_ms)
+			combine_ms = ms;
+
+		watch.start();
+
+		for (const auto& words : modules)
+			checksum ^= vr::hash_bytes_128(words.data(), words.size() * sizeof(uint32_t)).low;
+
+		ms = watch.get_ms();
+		if (i == 0 || ms < xxh3_ms)
+			xxh3_ms = ms;
+	}
+
+	vr::Logger::info("{:>8} bytes x {:>6}: hash_combine {:8.2f}ms ({:6.2f} GB/s), hash_bytes_128 {:8.2f}ms ({:6.2f} GB/s) [{:x}]",
+		byte_size,
+		module_count,
+		combine_ms,
+		gbytes / (combine_ms / 1000.0),
+		xxh3_ms,
+		gbytes / (xxh3_ms / 1000.0),
+		checksum);
+}
+
+int main()
+{
+	// sizes of small fragment shaders up to large compute kernels
+	run_case(1024, 16384);
+	run_case(16 * 1024, 2048);
+	run_case(256 * 1024, 128);
+	run_case(4 * 1024 * 1024, 8);
+
+	return 0;
+}
@@ -0,0 +1,598 @@
+#include <vera/vera.h>
+#include <functional>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <random>
+
+using namespace std;
+
+static vr::Image make_noise_image(uint32_t width, uint32_t height)
+{
+	vr::Image image(width, height, vr::Format::RGBA8Unorm);
+
+	mt19937 rng(0x5eed);
+	auto*   ptr   = reinterpret_cast<uint32_t*>(image.data());
+	size_t  count = static_cast<size_t>(width) * height;
+
+	for (size_t i = 0; i < count; ++i)
+		ptr[i] = rng();
+
+	return image;
+}
+
+static void run_case(const char* name, const vr::Image& image, const function<vr::Image(const vr::Image&)>& op)
+{
+	const uint32_t repeat = 3;
+	const double   mbytes = static_cast<double>(image.width()) * image.height() * 4 / (1024.0 * 1024.0);
+
+	float best_ms = 0.f;
+
+	for (uint32_t i = 0; i < repeat; ++i) {
+		vr::StopWatch watch;
+		watch.start();
+
+		vr::Image result = op(image);
+
+		float ms = watch.get_ms();
+		if (i == 0 || ms < best_ms)
+			best_ms = ms;
+	}
+
+	vr::Logger::info("{:>12} {}x{}: {:8.2f}ms ({:.1f} MB/s)",
+		name,
+		image.width(),
+		image.height(),
+		best_ms,
+		mbytes / (best_ms / 1000.0));
+}
+
+enum class EditOp
+{
+	FlipH,
+	FlipV,
+	Rotate180,
+	RotateCW,
+	RotateCCW
+};
+
+static const char* const edit_op_names[] = { "flip h", "flip v", "rotate 180", "rotate cw", "rotate ccw" };
+
+// one format per pixel size with its own kernel, the others take the scalar template
+static const vr::Format edit_formats[] = {
+	vr::Format::R8Unorm,     // 1
+	vr::Format::RG8Unorm,    // 2
+	vr::Format::RGB8Unorm,   // 3
+	vr::Format::RGBA8Unorm,  // 4
+	vr::Format::RGB16Unorm,  // 6
+	vr::Format::RGBA16Unorm, // 8
+	vr::Format::RGB32Float,  // 12
+	vr::Format::RGBA32Float, // 16
+	vr::Format::RGB64Float,  // 24
+	vr::Format::RGBA64Float  // 32
+};
+
+static void fill_noise(vr::ImageView view, mt19937& rng)
+{
+	for (uint32_t y = 0; y < view.height(); ++y)
+		for (size_t i = 0; i < view.rowSize(); ++i)
+			view.row(y)[i] = static_cast<uint8_t>(rng());
+}
+
+static bool is_transposing(EditOp op)
+{
+	return op == EditOp::RotateCW || op == EditOp::RotateCCW;
+}
+
+// the edits by their definition, one pixel at a time
+static void reference_edit(vr::ImageView dst, vr::ConstImageView src, EditOp op)
+{
+	const uint32_t w = src.width();
+	const uint32_t h = src.height();
+
+	for (uint32_t y = 0; y < dst.height(); ++y) {
+		for (uint32_t x = 0; x < dst.width(); ++x) {
+			uint32_t sx = x;
+			uint32_t sy = y;
+
+			switch (op) {
+			case EditOp::FlipH:     sx = w - 1 - x; break;
+			case EditOp::FlipV:     sy = h - 1 - y; break;
+			case EditOp::Rotate180: sx = w - 1 - x; sy = h - 1 - y; break;
+			case EditOp::RotateCW:  sx = y; sy = h - 1 - x; break;
+			case EditOp::RotateCCW: sx = w - 1 - y; sy = x; break;
+			}
+
+			memcpy(dst.pixel(x, y), src.pixel(sx, sy), src.pixelSize());
+		}
+	}
+}
+
+static void apply_edit(vr::ImageView dst, vr::ConstImageView src, EditOp op)
+{
+	switch (op) {
+	case EditOp::FlipH:     vr::ImageEdit::flip(dst, src, true, false); break;
+	case EditOp::FlipV:     vr::ImageEdit::flip(dst, src, false, true); break;
+	case EditOp::Rotate180: vr::ImageEdit::rotate(dst, src, vr::Rotation::_180Deg); break;
+	case EditOp::RotateCW:  vr::ImageEdit::rotateCW(dst, src); break;
+	case EditOp::RotateCCW: vr::ImageEdit::rotateCCW(dst, src); break;
+	}
+}
+
+static vr::Image apply_edit(const vr::Image& image, EditOp op)
+{
+	switch (op) {
+	case EditOp::FlipH:     return vr::ImageEdit::flip(image, true, false);
+	case EditOp::FlipV:     return vr::ImageEdit::flip(image, false, true);
+	case EditOp::Rotate180: return vr::ImageEdit::rotate(image, vr::Rotation::_180Deg);
+	case EditOp::RotateCW:  return vr::ImageEdit::rotateCW(image);
+	case EditOp::RotateCCW: return vr::ImageEdit::rotateCCW(image);
+	}
+	return {};
+}
+
+static bool is_same_view(vr::ConstImageView lhs, vr::ConstImageView rhs)
+{
+	if (lhs.width() != rhs.width() || lhs.height() != rhs.height())
+		return false;
+
+	for (uint32_t y = 0; y < lhs.height(); ++y)
+		if (memcmp(lhs.row(y), rhs.row(y), lhs.rowSize()) != 0)
+			return false;
+
+	return true;
+}
+
+// Checks whole images, tiles of larger images with the border left untouched and in place flips
+// against the reference, for every pixel size and extents that leave partial blocks and tiles.
+static bool verify_edits()
+{
+	const uint32_t extents[][2] = {
+		{ 1, 1 }, { 1, 19 }, { 23, 1 }, { 8, 8 }, { 7, 3 }, { 13, 29 },
+		{ 64, 17 }, { 100, 64 }, { 257, 131 }, { 131, 257 }, { 1000, 9 }
+	};
+
+	const uint32_t border = 3;
+
+	mt19937 rng(0x5eed);
+	bool    ok = true;
+
+	for (vr::Format format : edit_formats) {
+		for (const auto& extent : extents) {
+			vr::Image src(extent[0], extent[1], format);
+			fill_noise(src.view(), rng);
+
+			for (uint32_t op_idx = 0; op_idx < VERA_LENGTHOF(edit_op_names); ++op_idx) {
+				auto     op         = static_cast<EditOp>(op_idx);
+				uint32_t dst_width  = is_transposing(op) ? src.height() : src.width();
+				uint32_t dst_height = is_transposing(op) ? src.width() : src.height();
+
+				vr::Image expected(dst_width, dst_height, format);
+				reference_edit(expected.view(), src.view(), op);
+
+				bool passed = is_same_view(apply_edit(src, op).view(), expected.view());
+
+				vr::Image src_canvas(src.width() + 2 * border, src.height() + 2 * border, format);
+				vr::Image dst_canvas(dst_width + 2 * border, dst_height + 2 * border, format);
+				fill_noise(src_canvas.view(), rng);
+				fill_noise(dst_canvas.view(), rng);
+				vr::ImageEdit::copy(src_canvas.view(border, border, src.width(), src.height()), src.view());
+
+				vr::Image dst_before = dst_canvas;
+				apply_edit(dst_canvas.view(border, border, dst_width, dst_height), src_canvas.view(border, border, src.width(), src.height()), op);
+				vr::ImageEdit::copy(dst_before.view(border, border, dst_width, dst_height), expected.view());
+
+				passed &= is_same_view(dst_canvas.view(), dst_before.view());
+
+				if (!is_transposing(op)) {
+					vr::Image in_place = src;
+					apply_edit(in_place.view(), in_place.view(), op);
+					passed &= is_same_view(in_place.view(), expected.view());
+				}
+
+				if (!passed)
+					vr::Logger::warn("{} mismatch on {}x{} with {} byte pixels",
+						edit_op_names[op_idx],
+						src.width(),
+						src.height(),
+						vr::get_format_size(format));
+
+				ok &= passed;
+			}
+		}
+	}
+
+	return ok;
+}
+
+// the kernels are picked once per process, the SSE2 ones are checked by running this bench again
+static bool verify_edits_without_avx2(const char* self_path)
+{
+#ifdef _MSC_VER
+	_putenv_s("VERA_DISABLE_AVX2", "1");
+#else
+	setenv("VERA_DISABLE_AVX2", "1", 1);
+#endif
+
+	return std::system(std::format("\"{}\" --verify", self_path).c_str()) == 0;
+}
+
+static vr::ImageSampler make_sampler(vr::ImageSamplerFilter filter)
+{
+	return vr::ImageSampler(vr::ImageSamplerCreateInfo{
+		.filter       = filter,
+		.addressModeU = vr::ImageSamplerAddressMode::ClampToEdge,
+		.addressModeV = vr::ImageSamplerAddressMode::ClampToEdge
+	});
+}
+
+static vr::ImageBlitInfo make_downscale_info(const vr::Image& image, uint32_t factor)
+{
+	return vr::ImageBlitInfo{
+		.dstWidth  = image.width() / factor,
+		.dstHeight = image.height() / factor,
+		.uv0       = { 0.f, 0.f },
+		.uv1       = { 1.f, 0.f },
+		.uv2       = { 1.f, 1.f },
+		.uv3       = { 0.f, 1.f }
+	};
+}
+
+////////// reference sampler ///////////////////////////////////////////////////////////////////////
+
+// The scalar sampler ImageSampler used before it shared its kernels with blit, kept verbatim apart
+// from two reads that were undefined: the floor of a coordinate clamped to -0.5 is taken signed,
+// and the right neighbour of the last texel wraps to 0 instead of reading past the row.
+
+struct BlitFormat
+{
+	vr::Format format;
+	uint32_t   channels;
+	uint32_t   channelSize; // 1 and 2 are unorm, 4 and 8 are float
+	bool       bgr;
+};
+
+// every format blit has its own kernel for, and a few that take the runtime switch
+static const BlitFormat blit_formats[] = {
+	{ vr::Format::R8Unorm,     1, 1, false },
+	{ vr::Format::RG8Unorm,    2, 1, false },
+	{ vr::Format::RGB8Unorm,   3, 1, false },
+	{ vr::Format::RGBA8Unorm,  4, 1, false },
+	{ vr::Format::BGRA8Unorm,  4, 1, true  },
+	{ vr::Format::R16Unorm,    1, 2, false },
+	{ vr::Format::RG16Unorm,   2, 2, false },
+	{ vr::Format::RGBA16Unorm, 4, 2, false },
+	{ vr::Format::R32Float,    1, 4, false },
+	{ vr::Format::RG32Float,   2, 4, false },
+	{ vr::Format::RGBA32Float, 4, 4, false },
+	{ vr::Format::RGBA64Float, 4, 8, false }
+};
+
+static float reference_modf(float x, float y)
+{
+	float mod = fmodf(x, y);
+	return 0 < x ? mod : y + mod;
+}
+
+static float reference_address(vr::ImageSamplerAddressMode mode, float x, float size, bool& border)
+{
+	switch (mode) {
+	case vr::ImageSamplerAddressMode::Repeat:
+		return reference_modf(x + 0.5f, size) - 0.5f;
+	case vr::ImageSamplerAddressMode::MirroredRepeat:
+		return -fabsf(reference_modf(x + 0.5f, 2.f * size) - size) + size - 0.5f;
+	case vr::ImageSamplerAddressMode::ClampToEdge:
+		if (x < 0.5f) return -0.5f;
+		if (size - 0.5f < x) return size - 0.5f;
+		return x;
+	case vr::ImageSamplerAddressMode::ClampToBorder:
+		border |= x < -0.5f || size - 0.5f <= x;
+		return x;
+	case vr::ImageSamplerAddressMode::MirrorClampToEdge:
+		return fminf(fabsf(x + 0.5f) - 0.5f, size - 0.5f);
+	}
+	return x;
+}
+
+static float reference_decode(const uint8_t* ptr, uint32_t channel_size)
+{
+	switch (channel_size) {
+	case 1: {
+		return *ptr / 255.f;
+	}
+	case 2: {
+		uint16_t value;
+		memcpy(&value, ptr, sizeof(value));
+		return value / 65535.f;
+	}
+	case 4: {
+		float value;
+		memcpy(&value, ptr, sizeof(value));
+		return value;
+	}
+	default: {
+		double value;
+		memcpy(&value, ptr, sizeof(value));
+		return static_cast<float>(value);
+	}
+	}
+}
+
+static void reference_encode(uint8_t* ptr, uint32_t channel_size, float value)
+{
+	switch (channel_size) {
+	case 1: {
+		*ptr = static_cast<uint8_t>(value * (255.f + 0.99f));
+	} break;
+	case 2: {
+		auto v = static_cast<uint16_t>(value * (65535.f + 0.99f));
+		memcpy(ptr, &v, sizeof(v));
+	} break;
+	case 4: {
+		memcpy(ptr, &value, sizeof(value));
+	} break;
+	default: {
+		auto v = static_cast<double>(value);
+		memcpy(ptr, &v, sizeof(v));
+	} break;
+	}
+}
+
+static vr::float4 reference_fetch(const vr::Image& image, const BlitFormat& format, uint32_t x, uint32_t y)
+{
+	const auto* ptr = reinterpret_cast<const uint8_t*>(image.data()) +
+		(static_cast<size_t>(image.width()) * y + x) * format.channels * format.channelSize;
+
+	float c[4] = { 0.f, 0.f, 0.f, 1.f };
+	for (uint32_t i = 0; i < format.channels; ++i)
+		c[i] = reference_decode(ptr + i * format.channelSize, format.channelSize);
+
+	if (format.bgr)
+		swap(c[0], c[2]);
+
+	return { c[0], c[1], c[2], c[3] };
+}
+
+static void reference_store(vr::Image& image, const BlitFormat& format, uint32_t x, uint32_t y, const vr::float4& color)
+{
+	auto* ptr = reinterpret_cast<uint8_t*>(image.data()) +
+		(static_cast<size_t>(image.width()) * y + x) * format.channels * format.channelSize;
+
+	float c[4] = { color.x, color.y, color.z, color.w };
+
+	if (format.bgr)
+		swap(c[0], c[2]);
+
+	for (uint32_t i = 0; i < format.channels; ++i)
+		reference_encode(ptr + i * format.channelSize, format.channelSize, c[i]);
+}
+
+static vr::float4 reference_sample(
+	const vr::Image&                    image,
+	const BlitFormat&                   format,
+	const vr::ImageSamplerCreateInfo&   info,
+	float                               u,
+	float                               v)
+{
+	const float width  = static_cast<float>(image.width());
+	const float height = static_cast<float>(image.height());
+
+	if (!info.unnormalizedCoordinates) {
+		u *= image.width();
+		v *= image.height();
+	}
+
+	bool border = false;
+	u = reference_address(info.addressModeU, u, width, border);
+	v = reference_address(info.addressModeV, v, height, border);
+
+	if (border)
+		return info.borderColor;
+
+	if (info.filter == vr::ImageSamplerFilter::Nearest) {
+		uint32_t rnd_u = u <= 0.5f ? 0 : static_cast<uint32_t>(roundf(u));
+		uint32_t rnd_v = v <= 0.5f ? 0 : static_cast<uint32_t>(roundf(v));
+		uint32_t x     = static_cast<uint32_t>(width - 1 <= u ? width - 1 : rnd_u);
+		uint32_t y     = static_cast<uint32_t>(height - 1 <= v ? height - 1 : rnd_v);
+
+		return reference_fetch(image, format, x, y);
+	}
+
+	float    tx0   = fmodf(u + 1.f, 1.f);
+	float    ty0   = fmodf(v + 1.f, 1.f);
+	float    tx1   = 1.f - tx0;
+	float    ty1   = 1.f - ty0;
+	int64_t  flr_u = static_cast<int64_t>(floorf(u));
+	int64_t  flr_v = static_cast<int64_t>(floorf(v));
+	uint32_t x0    = static_cast<uint32_t>(u < 0.f ? width - 1 : flr_u);
+	uint32_t x1    = static_cast<uint32_t>(width - 1.f <= u ? 0 : flr_u + 1);
+	uint32_t y0    = static_cast<uint32_t>(v < 0.f ? height - 1 : flr_v);
+	uint32_t y1    = static_cast<uint32_t>(height - 1.f <= v ? 0 : flr_v + 1);
+
+	vr::float4 color0 = reference_fetch(image, format, x0, y0);
+	vr::float4 color1 = reference_fetch(image, format, x1, y0);
+	vr::float4 color2 = reference_fetch(image, format, x1, y1);
+	vr::float4 color3 = reference_fetch(image, format, x0, y1);
+
+	return
+		tx0 * ty0 * color0 +
+		tx1 * ty0 * color1 +
+		tx1 * ty1 * color2 +
+		tx0 * ty1 * color3;
+}
+
+static vr::Image reference_blit(const vr::Image& image, const BlitFormat& format, const vr::ImageSamplerCreateInfo& sampler_info, const vr::ImageBlitInfo& info)
+{
+	vr::Image result(info.dstWidth, info.dstHeight, format.format);
+
+	for (uint32_t y = 0; y < info.dstHeight; ++y) {
+		for (uint32_t x = 0; x < info.dstWidth; ++x) {
+			float      tx = static_cast<float>(x) / info.dstWidth;
+			float      ty = static_cast<float>(y) / info.dstHeight;
+			vr::float2 p  = vr::lerp(vr::lerp(info.uv0, info.uv1, tx), vr::lerp(info.uv3, info.uv2, tx), ty);
+
+			reference_store(result, format, x, y, reference_sample(image, format, sampler_info, p.x, p.y));
+		}
+	}
+
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void fill_unit_noise(vr::Image& image, const BlitFormat& format, mt19937& rng)
+{
+	if (format.channelSize < 4) {
+		fill_noise(image.view(), rng);
+		return;
+	}
+
+	// float texels stay in the unit range, random bits would be mostly nan and inf
+	uniform_real_distribution<float> dist(0.f, 1.f);
+
+	auto*  ptr   = reinterpret_cast<uint8_t*>(image.data());
+	size_t count = static_cast<size_t>(image.width()) * image.height() * format.channels;
+
+	for (size_t i = 0; i < count; ++i)
+		reference_encode(ptr + i * format.channelSize, format.channelSize, dist(rng));
+}
+
+static vr::ImageBlitInfo make_quad_info(uint32_t width, uint32_t height, vr::float2 uv0, vr::float2 uv1, vr::float2 uv2, vr::float2 uv3)
+{
+	return vr::ImageBlitInfo{
+		.dstWidth  = width,
+		.dstHeight = height,
+		.uv0       = uv0,
+		.uv1       = uv1,
+		.uv2       = uv2,
+		.uv3       = uv3
+	};
+}
+
+static bool check_blit(const vr::Image& src, const BlitFormat& format, const vr::ImageSamplerCreateInfo& sampler_info, vr::ImageBlitInfo info)
+{
+	if (sampler_info.unnormalizedCoordinates) {
+		vr::float2 scale(static_cast<float>(src.width()), static_cast<float>(src.height()));
+
+		info.uv0 *= scale;
+		info.uv1 *= scale;
+		info.uv2 *= scale;
+		info.uv3 *= scale;
+	}
+
+	vr::Image result   = vr::ImageEdit::blit(src, vr::ImageSampler(sampler_info), info);
+	vr::Image expected = reference_blit(src, format, sampler_info, info);
+
+	if (is_same_view(result.view(), expected.view()))
+		return true;
+
+	vr::Logger::warn("blit mismatch on {}x{} to {}x{}, format {}, filter {}, address modes {} {}{}",
+		src.width(),
+		src.height(),
+		info.dstWidth,
+		info.dstHeight,
+		static_cast<uint32_t>(format.format),
+		static_cast<uint32_t>(sampler_info.filter),
+		static_cast<uint32_t>(sampler_info.addressModeU),
+		static_cast<uint32_t>(sampler_info.addressModeV),
+		sampler_info.unnormalizedCoordinates ? ", unnormalized" : "");
+
+	return false;
+}
+
+// Blits every format with both filters, every pair of address modes and normalized as well as
+// unnormalized coordinates, and compares each result byte for byte with the reference sampler.
+// The quads cover the image exactly, reach past it on every side, mirror it and skew it. A quad
+// large enough to be split across worker threads runs once per address mode.
+static bool verify_blit()
+{
+	const uint32_t src_extents[][2] = { { 1, 1 }, { 7, 3 }, { 13, 29 }, { 64, 17 } };
+
+	const vr::ImageBlitInfo quads[] = {
+		make_quad_info(23, 11, { 0.f, 0.f }, { 1.f, 0.f }, { 1.f, 1.f }, { 0.f, 1.f }),
+		make_quad_info(9, 31, { -0.7f, -1.3f }, { 1.6f, -1.3f }, { 1.6f, 2.1f }, { -0.7f, 2.1f }),
+		make_quad_info(17, 5, { 1.f, 1.f }, { 0.f, 1.f }, { 0.f, 0.f }, { 1.f, 0.f }),
+		make_quad_info(31, 19, { -0.2f, 0.1f }, { 1.3f, -0.1f }, { 0.9f, 1.2f }, { 0.1f, 0.8f })
+	};
+
+	const vr::ImageBlitInfo threaded_quad =
+		make_quad_info(263, 131, { -0.1f, 0.2f }, { 1.1f, 0.f }, { 1.2f, 0.9f }, { 0.f, 1.1f });
+
+	const vr::ImageSamplerAddressMode address_modes[] = {
+		vr::ImageSamplerAddressMode::Repeat,
+		vr::ImageSamplerAddressMode::MirroredRepeat,
+		vr::ImageSamplerAddressMode::ClampToEdge,
+		vr::ImageSamplerAddressMode::ClampToBorder,
+		vr::ImageSamplerAddressMode::MirrorClampToEdge
+	};
+
+	mt19937 rng(0x5eed);
+	bool    ok = true;
+
+	for (const auto& format : blit_formats) {
+		for (const auto& extent : src_extents) {
+			vr::Image src(extent[0], extent[1], format.format);
+			fill_unit_noise(src, format, rng);
+
+			for (auto filter : { vr::ImageSamplerFilter::Nearest, vr::ImageSamplerFilter::Linear }) {
+				for (auto mode_u : address_modes) {
+					for (auto mode_v : address_modes) {
+						for (bool unnormalized : { false, true }) {
+							vr::ImageSamplerCreateInfo sampler_info = {
+								.filter                  = filter,
+								.addressModeU            = mode_u,
+								.addressModeV            = mode_v,
+								.borderColor             = { 0.25f, 0.5f, 0.75f, 0.125f },
+								.unnormalizedCoordinates = unnormalized
+							};
+
+							for (const auto& info : quads)
+								ok &= check_blit(src, format, sampler_info, info);
+
+							if (mode_u == mode_v && !unnormalized)
+								ok &= check_blit(src, format, sampler_info, threaded_quad);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return ok;
+}
+
+int main(int argc, char** argv)
+{
+	bool ok = verify_edits();
+	vr::Logger::info("rotate and flip verification {}", ok ? "passed" : "FAILED");
+
+	bool blit_ok = verify_blit();
+	vr::Logger::info("blit verification {}", blit_ok ? "passed" : "FAILED");
+	ok &= blit_ok;
+
+	if (argc > 1 && strcmp(argv[1], "--verify") == 0)
+		return ok ? 0 : 1;
+
+	if (!verify_edits_without_avx2(argv[0])) {
+		vr::Logger::warn("verification without AVX2 FAILED");
+		ok = false;
+	}
+
+	for (uint32_t size : { 4096u, 16384u }) {
+		vr::Image image = make_noise_image(size, size);
+
+		run_case("rotate cw", image, [](const vr::Image& img) { return vr::ImageEdit::rotateCW(img); });
+		run_case("rotate ccw", image, [](const vr::Image& img) { return vr::ImageEdit::rotateCCW(img); });
+		run_case("rotate 180", image, [](const vr::Image& img) { return vr::ImageEdit::rotate(img, vr::Rotation::_180Deg); });
+		run_case("flip h", image, [](const vr::Image& img) { return vr::ImageEdit::flip(img, true, false); });
+		run_case("flip v", image, [](const vr::Image& img) { return vr::ImageEdit::flip(img, false, true); });
+		run_case("blit nearest", image, [](const vr::Image& img) {
+			return vr::ImageEdit::blit(img, make_sampler(vr::ImageSamplerFilter::Nearest), make_downscale_info(img, 4));
+		});
+		run_case("blit linear", image, [](const vr::Image& img) {
+			return vr::ImageEdit::blit(img, make_sampler(vr::ImageSamplerFilter::Linear), make_downscale_info(img, 4));
+		});
+	}
+
+	return ok ? 0 : 1;
+}
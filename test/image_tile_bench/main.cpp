@@ -0,0 +1,112 @@
+#include <vera/vera.h>
+#include <filesystem>
+#include <vector>
+
+using namespace std;
+
+#define IMAGE_SIZE  16384
+#define BAND_HEIGHT 512
+
+// writes a gradient bitmap band by band, only one band is ever in memory
+static void write_gradient(const string& path)
+{
+	vr::Image       band(IMAGE_SIZE, BAND_HEIGHT, vr::Format::BGR8Unorm);
+	vr::ImageWriter writer(path, IMAGE_SIZE, IMAGE_SIZE, vr::Format::BGR8Unorm);
+
+	vr::StopWatch watch;
+	watch.start();
+
+	for (uint32_t band_y = 0; band_y < IMAGE_SIZE; band_y += BAND_HEIGHT) {
+		for (uint32_t y = 0; y < BAND_HEIGHT; ++y) {
+			uint8_t* row = band.view().row(y);
+
+			for (uint32_t x = 0; x < IMAGE_SIZE; ++x) {
+				row[3 * x + 0] = static_cast<uint8_t>(x);
+				row[3 * x + 1] = static_cast<uint8_t>(band_y + y);
+				row[3 * x + 2] = static_cast<uint8_t>((x ^ (band_y + y)) >> 6);
+			}
+		}
+
+		writer.write(band.view());
+	}
+
+	writer.close();
+
+	float ms = watch.get_ms();
+
+	vr::Logger::info("write {}x{} in bands of {} rows: {:.0f} ms, {:.0f} MB/s",
+		IMAGE_SIZE, IMAGE_SIZE, BAND_HEIGHT, ms, IMAGE_SIZE * 3.0 * IMAGE_SIZE / (1 << 20) / (ms / 1000.0));
+}
+
+// reads tiles of the mapped file and flips each one in place, the tiles are views of one buffer
+static void flip_tiles(const string& path, uint32_t tile_size)
+{
+	vr::ImageReader reader(path);
+	vr::Image       tiles(tile_size * 2, tile_size * 2, reader.format());
+	uint64_t        checksum = 0;
+
+	vr::StopWatch watch;
+	watch.start();
+
+	for (uint32_t y = 0; y + tile_size <= reader.height(); y += tile_size) {
+		for (uint32_t x = 0; x + tile_size <= reader.width(); x += tile_size) {
+			vr::ImageView tile = tiles.view(tile_size / 2, tile_size / 2, tile_size, tile_size);
+
+			reader.read(tile, x, y);
+			vr::ImageEdit::flip(tile, tile, true, true);
+
+			checksum += tile.pixel(0, 0)[0];
+		}
+	}
+
+	float ms = watch.get_ms();
+
+	vr::Logger::info("read and flip {}px tiles: {:.0f} ms, {:.0f} MB/s, checksum {}",
+		tile_size, ms, reader.width() * 3.0 * reader.height() / (1 << 20) / (ms / 1000.0), checksum);
+}
+
+// rotates the whole image clockwise band by band, each output band is a column strip of the input
+static void rotate_in_bands(const string& src_path, const string& dst_path)
+{
+	vr::ImageReader reader(src_path);
+	vr::ImageWriter writer(dst_path, reader.height(), reader.width(), reader.format());
+	vr::Image       band(reader.height(), BAND_HEIGHT, reader.format());
+
+	vr::StopWatch watch;
+	watch.start();
+
+	for (uint32_t x = 0; x < reader.width(); x += BAND_HEIGHT) {
+		const uint32_t strip_width = min<uint32_t>(BAND_HEIGHT, reader.width() - x);
+
+		vr::ImageView dst = band.view(0, 0, reader.height(), strip_width);
+
+		vr::ImageEdit::rotateCW(dst, reader.view().subview(x, 0, strip_width, reader.height()));
+		writer.write(dst);
+	}
+
+	writer.close();
+
+	float ms = watch.get_ms();
+
+	vr::Logger::info("rotate in bands of {} rows, {} MB buffer: {:.0f} ms",
+		BAND_HEIGHT, band.size() >> 20, ms);
+}
+
+int main()
+{
+	auto temp_dir = filesystem::temp_directory_path();
+	auto src_path = (temp_dir / "vera_tile_bench.bmp").string();
+	auto dst_path = (temp_dir / "vera_tile_bench_rotated.bmp").string();
+
+	write_gradient(src_path);
+
+	for (uint32_t tile_size : { 256u, 1024u })
+		flip_tiles(src_path, tile_size);
+
+	rotate_in_bands(src_path, dst_path);
+
+	filesystem::remove(src_path);
+	filesystem::remove(dst_path);
+
+	return 0;
+}
@@ -0,0 +1,124 @@
+#include <vera/vera.h>
+#include <cstring>
+#include <random>
+
+using namespace std;
+
+static vr::Image make_noise_image(uint32_t width, uint32_t height, vr::Format format)
+{
+	vr::Image image(width, height, format);
+
+	mt19937 rng(0x5eed);
+	size_t  count = static_cast<size_t>(width) * height * 4;
+
+	if (format == vr::Format::RGBA16Float) {
+		// random bits would hit nan and inf, keep every channel in [0.5, 2)
+		auto* ptr = reinterpret_cast<uint16_t*>(image.data());
+		for (size_t i = 0; i < count; ++i)
+			ptr[i] = static_cast<uint16_t>((rng() & 1 ? 0x3800 : 0x3c00) | (rng() & 0x3ff));
+	} else {
+		auto* ptr = reinterpret_cast<uint8_t*>(image.data());
+		for (size_t i = 0; i < count; ++i)
+			ptr[i] = static_cast<uint8_t>(rng());
+	}
+
+	return image;
+}
+
+static const char* get_filter_name(vr::MipFilter filter)
+{
+	switch (filter) {
+	case vr::MipFilter::Box:     return "box";
+	case vr::MipFilter::Kaiser:  return "kaiser";
+	case vr::MipFilter::Lanczos: return "lanczos";
+	}
+	return "";
+}
+
+static void run_case(const char* name, const vr::Image& image, const vr::MipGenerateInfo& info)
+{
+	const uint32_t repeat = 3;
+	const double   mbytes = static_cast<double>(image.size()) / (1024.0 * 1024.0);
+
+	float    best_ms     = 0.f;
+	uint32_t level_count = 0;
+
+	for (uint32_t i = 0; i < repeat; ++i) {
+		vr::StopWatch watch;
+		watch.start();
+
+		vr::MipImage result = vr::MipImage::generate(image, info);
+
+		float ms = watch.get_ms();
+		if (i == 0 || ms < best_ms)
+			best_ms = ms;
+
+		level_count = result.levelCount();
+	}
+
+	vr::Logger::info("{:>12} {:>8} {}x{} ({} levels): {:8.2f}ms ({:.1f} MB/s)",
+		name,
+		get_filter_name(info.filter),
+		image.width(),
+		image.height(),
+		level_count,
+		best_ms,
+		mbytes / (best_ms / 1000.0));
+}
+
+// a constant image must stay constant through every level and every filter
+static bool verify_constant(vr::Format format, vr::MipFilter filter)
+{
+	vr::Image image(61, 37, format);
+
+	const size_t pixel_size = vr::get_format_size(format);
+	auto*        ptr        = reinterpret_cast<uint8_t*>(image.data());
+
+	for (size_t i = 0; i < pixel_size; ++i)
+		ptr[i] = static_cast<uint8_t>(0x35 + i * 0x11);
+	for (size_t i = 1; i < static_cast<size_t>(image.width()) * image.height(); ++i)
+		memcpy(ptr + i * pixel_size, ptr, pixel_size);
+
+	vr::MipImage mip = vr::MipImage::generate(image, vr::MipGenerateInfo{ .filter = filter });
+
+	for (uint32_t level = 0; level < mip.levelCount(); ++level) {
+		const auto* level_ptr   = reinterpret_cast<const uint8_t*>(mip.levelData(level));
+		const auto  pixel_count = static_cast<size_t>(mip.width(level)) * mip.height(level);
+
+		for (size_t i = 0; i < pixel_count; ++i)
+			if (memcmp(level_ptr + i * pixel_size, ptr, pixel_size) != 0) {
+				vr::Logger::warn("{} changed a constant image at level {}", get_filter_name(filter), level);
+				return false;
+			}
+	}
+
+	return true;
+}
+
+int main()
+{
+	const vr::MipFilter filters[] = { vr::MipFilter::Box, vr::MipFilter::Kaiser, vr::MipFilter::Lanczos };
+
+	{
+		bool ok = true;
+		for (auto filter : filters) {
+			ok &= verify_constant(vr::Format::RGBA8Unorm, filter);
+			ok &= verify_constant(vr::Format::RGBA8Srgb, filter);
+			ok &= verify_constant(vr::Format::RGBA16Float, filter);
+		}
+
+		vr::Logger::info("mip verification {}", ok ? "passed" : "FAILED");
+	}
+
+	vr::Image rgba8  = make_noise_image(4096, 4096, vr::Format::RGBA8Unorm);
+	vr::Image rgba16 = make_noise_image(4096, 4096, vr::Format::RGBA16Float);
+
+	for (auto filter : filters) {
+		run_case("rgba8", rgba8, vr::MipGenerateInfo{ .filter = filter });
+		run_case("rgba8 srgb", rgba8, vr::MipGenerateInfo{ .filter = filter, .srgb = true });
+		run_case("rgba8 alpha", rgba8, vr::MipGenerateInfo{ .filter = filter, .alphaCutoff = 0.5f });
+		run_case("rgba16f", rgba16, vr::MipGenerateInfo{ .filter = filter });
+	}
+
+	return 0;
+}
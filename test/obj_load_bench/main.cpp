@@ -0,0 +1,196 @@
+#include <vera/vera.h>
+#include <filesystem>
+#include <fstream>
+#include <format>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#ifndef _MSC_VER
+#define sscanf_s sscanf
+#endif
+
+using namespace std;
+
+#define GRID_SIZE 640
+
+struct ObjStreams
+{
+	vector<vr::float3> vertices;
+	vector<vr::float3> normals;
+	vector<vr::float2> uvs;
+};
+
+// a noisy grid of GRID_SIZE x GRID_SIZE quads as v/vt/vn triangles, the only form the old loader reads
+static void write_obj(const string& path)
+{
+	mt19937                          rng(0x5eed);
+	uniform_real_distribution<float> noise(-0.01f, 0.01f);
+	ofstream                         file(path, ios::binary | ios::trunc);
+	string                           text;
+
+	const uint32_t side = GRID_SIZE + 1;
+
+	for (uint32_t y = 0; y < side; ++y) {
+		for (uint32_t x = 0; x < side; ++x) {
+			// drawn one at a time, the order arguments are evaluated in is unspecified
+			float u  = static_cast<float>(x) / GRID_SIZE;
+			float v  = static_cast<float>(y) / GRID_SIZE;
+			float px = u + noise(rng);
+			float py = noise(rng);
+			float pz = v + noise(rng);
+			float nx = noise(rng);
+			float nz = noise(rng);
+
+			text += format("v {:.6f} {:.6f} {:.6f}\n", px, py, pz);
+			text += format("vt {:.6f} {:.6f}\n", u, v);
+			text += format("vn {:.6f} {:.6f} {:.6f}\n", nx, 1.f, nz);
+		}
+
+		file.write(text.data(), text.size());
+		text.clear();
+	}
+
+	for (uint32_t y = 0; y < GRID_SIZE; ++y) {
+		for (uint32_t x = 0; x < GRID_SIZE; ++x) {
+			uint32_t i0 = y * side + x + 1;
+			uint32_t i1 = i0 + 1;
+			uint32_t i2 = i0 + side + 1;
+			uint32_t i3 = i0 + side;
+
+			text += format("f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2}\n", i0, i1, i2);
+			text += format("f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2}\n", i0, i2, i3);
+		}
+
+		file.write(text.data(), text.size());
+		text.clear();
+	}
+}
+
+// the loader before the mapped parser: istringstream per line and de-indexed triangle streams
+static ObjStreams load_obj_stream(const string& path)
+{
+	ifstream   file(path);
+	ObjStreams out;
+
+	vector<vr::float3> vertices;
+	vector<vr::float3> normals;
+	vector<vr::float2> uvs;
+
+	string line;
+	string line_header;
+	while (getline(file, line)) {
+		istringstream ss(line);
+		ss >> line_header;
+
+		if (line_header == "v") {
+			auto& v = vertices.emplace_back();
+			ss >> v.x >> v.z >> v.y;
+		} else if (line_header == "vt") {
+			auto& uv = uvs.emplace_back();
+			ss >> uv.x >> uv.y;
+			uv.y = 1.f - uv.y;
+		} else if (line_header == "vn") {
+			auto& n = normals.emplace_back();
+			ss >> n.x >> n.z >> n.y;
+		} else if (line_header == "f") {
+			int v0_idx, v1_idx, v2_idx;
+			int n0_idx, n1_idx, n2_idx;
+			int uv0_idx, uv1_idx, uv2_idx;
+
+			if (sscanf_s(line.c_str(),
+				"f %d/%d/%d %d/%d/%d %d/%d/%d",
+					&v0_idx, &uv0_idx, &n0_idx,
+					&v1_idx, &uv1_idx, &n1_idx,
+					&v2_idx, &uv2_idx, &n2_idx) != 9)
+				throw vr::Exception("invalid file format");
+
+			out.vertices.push_back(vertices[v0_idx - 1]);
+			out.vertices.push_back(vertices[v1_idx - 1]);
+			out.vertices.push_back(vertices[v2_idx - 1]);
+			out.normals.push_back(normals[n0_idx - 1]);
+			out.normals.push_back(normals[n1_idx - 1]);
+			out.normals.push_back(normals[n2_idx - 1]);
+			out.uvs.push_back(uvs[uv0_idx - 1]);
+			out.uvs.push_back(uvs[uv1_idx - 1]);
+			out.uvs.push_back(uvs[uv2_idx - 1]);
+		}
+	}
+
+	return out;
+}
+
+// the welded mesh read through its indices must give back the triangles of the old loader
+static bool verify(const vr::ModelLoader& loader, const ObjStreams& expected)
+{
+	if (loader.indices.size() != expected.vertices.size())
+		return false;
+
+	for (size_t i = 0; i < loader.indices.size(); ++i) {
+		uint32_t idx = loader.indices[i];
+
+		if (loader.vertices[idx] != expected.vertices[i] ||
+			loader.normals[idx] != expected.normals[i] ||
+			loader.uvs[idx] != expected.uvs[i])
+			return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	const uint32_t repeat = 3;
+
+	auto path = (filesystem::temp_directory_path() / "vera_obj_load_bench.obj").string();
+	write_obj(path);
+
+	const double mbytes = static_cast<double>(filesystem::file_size(path)) / (1024.0 * 1024.0);
+
+	ObjStreams      streams;
+	vr::ModelLoader loader;
+	float           stream_ms = 0.f;
+	float           mapped_ms = 0.f;
+
+	for (uint32_t i = 0; i < repeat; ++i) {
+		vr::StopWatch watch;
+		watch.start();
+
+		streams = load_obj_stream(path);
+
+		float ms = watch.get_ms();
+		if (i == 0 || ms < stream_ms)
+			stream_ms = ms;
+	}
+
+	for (uint32_t i = 0; i < repeat; ++i) {
+		vr::StopWatch watch;
+		watch.start();
+
+		loader.clear();
+		loader.load(path);
+
+		float ms = watch.get_ms();
+		if (i == 0 || ms < mapped_ms)
+			mapped_ms = ms;
+	}
+
+	bool ok = verify(loader, streams);
+
+	vr::Logger::info("{:.1f} MB, {} triangles", mbytes, streams.vertices.size() / 3);
+	vr::Logger::info("stream loader: {:8.2f}ms ({:7.1f} MB/s), {} vertices",
+		stream_ms,
+		mbytes / (stream_ms / 1000.0),
+		streams.vertices.size());
+	vr::Logger::info("mapped loader: {:8.2f}ms ({:7.1f} MB/s), {} vertices, {} indices, {:.1f}x [{}]",
+		mapped_ms,
+		mbytes / (mapped_ms / 1000.0),
+		loader.vertices.size(),
+		loader.indices.size(),
+		stream_ms / mapped_ms,
+		ok ? "ok" : "FAILED");
+
+	filesystem::remove(path);
+
+	return ok ? 0 : 1;
+}
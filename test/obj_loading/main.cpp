@@ -1,4 +1,5 @@
 #include <vera/vera.h>
+#include <filesystem>
 #include <chrono>
 #include <thread>
 #include <iostream>
@@ -48,25 +49,45 @@ public:
 			.presentMode = vr::PresentMode::Immediate
 		});
 
-		vr::ModelLoader loader("resource/viking room/viking_room.obj");
-		vr::Image       image("resource/viking room/viking_room.png");
+		const char* model_path = "resource/viking room/viking_room.obj";
+
+		vr::StopWatch watch;
+		watch.start();
+
+		vr::ModelLoader loader(model_path);
+
+		watch.stop();
+
+		auto model_mb = static_cast<float>(filesystem::file_size(model_path)) / (1024.f * 1024.f);
+		vr::Logger::info("loaded {} vertices, {} indices in {:.2f}ms ({:.1f} MB/s)",
+			loader.vertices.size(),
+			loader.indices.size(),
+			watch.get_ms(),
+			model_mb / watch.get_s());
+
+		vr::Image image("resource/viking room/viking_room.png");
 
 		m_pass = std::make_unique<vr::GraphicsPass>(m_device, vr::GraphicsPassCreateInfo{
 			.vertexShader   = vr::Shader::create(m_device, "shader/obj_loading.vert.glsl.spv"),
 			.fragmentShader = vr::Shader::create(m_device, "shader/obj_loading.frag.glsl.spv"),
 			.vertexInput    = VERA_REFLECT_VERTEX(Vertex3D),
 			.vertexCount    = static_cast<uint32_t>(loader.vertices.size()),
+			.indexType      = vr::IndexType::UInt32,
+			.indexCount     = static_cast<uint32_t>(loader.indices.size()),
 			.depthFormat    = vr::DepthFormat::D32Float
 		});
 
-		auto* map = reinterpret_cast<Vertex3D*>(m_pass->getVertexBuffer()->getDeviceMemory()->map());
+		auto* map = reinterpret_cast<Vertex3D*>(m_pass->getVertexBuffer()->map());
 
 		for (size_t i = 0; i < loader.vertices.size(); ++i) {
 			map[i].pos    = loader.vertices[i];
-			map[i].normal = loader.normals[i];
-			map[i].uv     = loader.uvs[i];
+			map[i].normal = loader.normals.empty() ? vr::float3{} : loader.normals[i];
+			map[i].uv     = loader.uvs.empty() ? vr::float2{} : loader.uvs[i];
 		}
 
+		auto* index_map = reinterpret_cast<uint32_t*>(m_pass->getIndexBuffer()->map());
+		memcpy(index_map, loader.indices.data(), loader.indices.size() * sizeof(uint32_t));
+
 		auto texture = vr::Texture::create(m_device,
 			vr::TextureCreateInfo{
 				.format = image.format(),
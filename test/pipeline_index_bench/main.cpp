@@ -0,0 +1,118 @@
+#include <vera/vera.h>
+#include <filesystem>
+#include <thread>
+#include <chrono>
+#include <vector>
+
+using namespace std;
+
+// fixed-function variants of one shader pair, each must key a pipeline of its own
+static vector<vr::GraphicsPipelineCreateInfo> make_variants(const vr::obj<vr::Device>& device)
+{
+	auto vert_shader = vr::Shader::create(device, "spirv/triangle_minimal.vert.glsl.spv");
+	auto frag_shader = vr::Shader::create(device, "spirv/triangle_minimal.frag.glsl.spv");
+
+	const vr::CompareOp compare_ops[] = {
+		vr::CompareOp::Less,
+		vr::CompareOp::LessOrEqual,
+		vr::CompareOp::Greater,
+		vr::CompareOp::Always
+	};
+
+	vector<vr::GraphicsPipelineCreateInfo> infos;
+
+	for (bool blend_enable : { false, true }) {
+		for (vr::CullModeFlagBits cull_mode : { vr::CullModeFlagBits::None, vr::CullModeFlagBits::Back }) {
+			for (vr::PrimitiveTopology topology : { vr::PrimitiveTopology::TriangleList, vr::PrimitiveTopology::TriangleStrip }) {
+				for (vr::CompareOp compare_op : compare_ops) {
+					auto& info = infos.emplace_back();
+					info.vertexShader           = vert_shader;
+					info.fragmentShader         = frag_shader;
+					info.primitiveInfo          = vr::PrimitiveInfo{ .topology = topology };
+					info.rasterizationInfo      = vr::RasterizationInfo{ .cullMode = cull_mode };
+					info.depthStencilInfo       = vr::DepthStencilInfo{
+						.depthFormat      = vr::DepthFormat::D32Float,
+						.depthWriteEnable = true,
+						.depthCompareOp   = compare_op
+					};
+					info.colorBlendInfo         = vr::ColorBlendInfo{ .attachments = { { .blendEnable = blend_enable } } };
+					info.colorAttachmentFormats = { vr::Format::RGBA8Unorm };
+				}
+			}
+		}
+	}
+
+	return infos;
+}
+
+// every variant builds a distinct pipeline and the same info gives the cached one back
+static bool create_pipelines(const vr::obj<vr::Device>& device, vector<vr::obj<vr::Pipeline>>& pipelines, float& out_ms)
+{
+	auto infos = make_variants(device);
+
+	vr::StopWatch watch;
+	watch.start();
+
+	for (const auto& info : infos)
+		pipelines.push_back(vr::Pipeline::create(device, info));
+
+	out_ms = watch.get_ms();
+
+	for (size_t i = 0; i < pipelines.size(); ++i) {
+		if (vr::Pipeline::create(device, infos[i]) != pipelines[i])
+			return false;
+
+		for (size_t j = i + 1; j < pipelines.size(); ++j)
+			if (pipelines[i] == pipelines[j])
+				return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	auto path = (filesystem::temp_directory_path() / "vera_pipeline_index_bench.bin").string();
+	filesystem::remove(path);
+
+	vr::DeviceCreateInfo device_info;
+	device_info.pipelineIndexFilePath = path;
+
+	bool   ok         = true;
+	float  cold_ms    = 0.f;
+	float  indexed_ms = 0.f;
+	size_t count      = 0;
+
+	// the index is written when the device is destroyed
+	{
+		auto device = vr::Device::create(vr::Context::create(), device_info);
+
+		vector<vr::obj<vr::Pipeline>> pipelines;
+		ok   &= create_pipelines(device, pipelines, cold_ms);
+		count = pipelines.size();
+	}
+
+	ok &= filesystem::exists(path) && filesystem::file_size(path) != 0;
+
+	// the recorded pipelines are rebuilt while the application loads, stood in for by a sleep as
+	// long as the cold builds took
+	{
+		auto device = vr::Device::create(vr::Context::create(), device_info);
+
+		this_thread::sleep_for(chrono::duration<float, milli>(cold_ms));
+
+		vector<vr::obj<vr::Pipeline>> pipelines;
+		ok &= create_pipelines(device, pipelines, indexed_ms);
+	}
+
+	vr::Logger::info("{} pipelines: cold {:8.2f}ms, from the index {:8.2f}ms, {:.1f}x [{}]",
+		count,
+		cold_ms,
+		indexed_ms,
+		cold_ms / indexed_ms,
+		ok ? "ok" : "FAILED");
+
+	filesystem::remove(path);
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,239 @@
+#include <vera/vera.h>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static const char* get_packing_method_name(vr::PackingMethod method)
+{
+	switch (method) {
+	case vr::PackingMethod::Shelf:    return "shelf";
+	case vr::PackingMethod::Skyline:  return "skyline";
+	case vr::PackingMethod::MaxRects: return "maxrects";
+	default:                          return "";
+	}
+}
+
+// glyph boxes of the font at px, scaled by the height of 'H' since the em size is not exposed
+static vector<vr::extent2d> get_glyph_extents(const vr::obj<vr::Font>& font, uint32_t px, uint32_t sdf_padding)
+{
+	const float cap_height = font->findGlyphByCodepoint(U'H').aabb.size().y;
+	const float scale      = 0.7f * px / cap_height;
+
+	vector<vr::extent2d> extents;
+
+	for (vr::GlyphID glyph_id = 0; glyph_id < font->getGlyphCount(); ++glyph_id) {
+		const vr::float2 size = font->findGlyph(glyph_id).aabb.size();
+
+		if (size.x <= 0.f || size.y <= 0.f) continue;
+
+		extents.emplace_back(
+			static_cast<uint32_t>(round(scale * size.x)) + sdf_padding * 2,
+			static_cast<uint32_t>(round(scale * size.y)) + sdf_padding * 2);
+	}
+
+	return extents;
+}
+
+// packs one rect at a time in glyph order like the atlas does, a full layer opens the next one
+static void run_streaming(vr::PackingMethod method, const vector<vr::extent2d>& extents)
+{
+	auto packer = vr::RectPacker::createUnique(method, 1024, 1024, 2);
+
+	uint32_t layer_count = 1;
+	uint64_t used_area   = 0;
+	vr::urect2d rect;
+
+	vr::StopWatch watch;
+	watch.start();
+
+	for (const auto& extent : extents) {
+		if (!packer->pack(extent, rect)) {
+			used_area += packer->getUsedArea();
+			packer->clear();
+			layer_count++;
+
+			(void)packer->pack(extent, rect);
+		}
+	}
+
+	float ms = watch.get_ms();
+
+	used_area += packer->getUsedArea();
+
+	vr::Logger::info("  {:>8} streaming: {} layers, {:5.1f}% of the last layer, {:5.1f}% overall, {:8.0f} packs/s",
+		get_packing_method_name(method),
+		layer_count,
+		packer->getOccupancy() * 100.f,
+		100.0 * used_area / (layer_count * 1024.0 * 1024.0),
+		extents.size() / (ms / 1000.0));
+}
+
+// sorts then packs the whole set, the rects left over go to the next layer
+static void run_batch(vr::PackingMethod method, vector<vr::extent2d> extents)
+{
+	auto packer = vr::RectPacker::createUnique(method, 1024, 1024, 2);
+
+	uint32_t             layer_count = 0;
+	uint64_t             used_area   = 0;
+	size_t               total_count = extents.size();
+	vector<vr::urect2d>  rects;
+	vector<vr::extent2d> remaining;
+
+	vr::StopWatch watch;
+	watch.start();
+
+	while (!extents.empty()) {
+		packer->clear();
+		layer_count++;
+
+		if (packer->pack(extents, rects) == 0) break;
+
+		used_area += packer->getUsedArea();
+
+		remaining.clear();
+		for (const auto& rect : rects)
+			if (!vr::RectPacker::isPacked(rect))
+				remaining.push_back(rect.extent());
+
+		swap(extents, remaining);
+	}
+
+	float ms = watch.get_ms();
+
+	vr::Logger::info("  {:>8} batch:     {} layers, {:5.1f}% of the last layer, {:5.1f}% overall, {:8.0f} packs/s",
+		get_packing_method_name(method),
+		layer_count,
+		packer->getOccupancy() * 100.f,
+		100.0 * used_area / (layer_count * 1024.0 * 1024.0),
+		total_count / (ms / 1000.0));
+}
+
+static bool overlaps(const vr::urect2d& lhs, const vr::urect2d& rhs)
+{
+	return
+		lhs.x < rhs.max_x() && rhs.x < lhs.max_x() &&
+		lhs.y < rhs.max_y() && rhs.y < lhs.max_y();
+}
+
+// live rects must stay inside the packer, apart from each other by the padding
+static bool verify_live_rects(const vr::RectPacker& packer, const vector<vr::urect2d>& live)
+{
+	const uint32_t padding = packer.getPadding();
+
+	for (size_t i = 0; i < live.size(); ++i) {
+		const vr::urect2d padded(live[i].x, live[i].y, live[i].width + padding, live[i].height + padding);
+
+		if (live[i].x < padding || live[i].y < padding ||
+			padded.max_x() > packer.getWidth() || padded.max_y() > packer.getHeight())
+			return false;
+
+		for (size_t j = i + 1; j < live.size(); ++j) {
+			const vr::urect2d other(live[j].x, live[j].y, live[j].width + padding, live[j].height + padding);
+
+			if (overlaps(padded, other))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+// a released rect must join the free space around it, not only take rects fitting inside it
+static bool check_release_reuse(vr::PackingMethod method)
+{
+	auto packer = vr::RectPacker::createUnique(method, 100, 100);
+
+	vr::urect2d tall_rect;
+	vr::urect2d small_rect;
+	vr::urect2d wide_rect;
+
+	if (!packer->pack(vr::extent2d(50, 100), tall_rect) ||
+		!packer->pack(vr::extent2d(10, 10), small_rect))
+		return false;
+
+	packer->release(tall_rect);
+
+	return
+		packer->pack(vr::extent2d(100, 50), wide_rect) &&
+		verify_live_rects(*packer, { small_rect, wide_rect });
+}
+
+// a long running atlas: fills one layer, then keeps evicting random glyphs and packing new ones
+static bool run_eviction(vr::PackingMethod method, const vector<vr::extent2d>& extents)
+{
+	auto packer = vr::RectPacker::createUnique(method, 1024, 1024, 2);
+
+	mt19937             rng(7);
+	vector<vr::urect2d> live;
+	vr::urect2d         rect;
+	uint32_t            packed_count = 0;
+	uint32_t            failed_count = 0;
+
+	for (const auto& extent : extents) {
+		if (!packer->pack(extent, rect)) break;
+		live.push_back(rect);
+	}
+
+	vr::StopWatch watch;
+	watch.start();
+
+	for (uint32_t i = 0; i < 20000; ++i) {
+		size_t evict_idx = rng() % live.size();
+		packer->release(live[evict_idx]);
+		live[evict_idx] = live.back();
+		live.pop_back();
+
+		if (packer->pack(extents[rng() % extents.size()], rect)) {
+			live.push_back(rect);
+			packed_count++;
+		} else {
+			failed_count++;
+		}
+	}
+
+	float ms = watch.get_ms();
+
+	// the shelf packer only reclaims the end of its last shelf
+	bool ok = verify_live_rects(*packer, live) &&
+		(method == vr::PackingMethod::Shelf || check_release_reuse(method));
+
+	vr::Logger::info("  {:>8} eviction:  {} of {} repacked, {:5.1f}% occupied after, {:8.0f} packs/s [{}]",
+		get_packing_method_name(method),
+		packed_count,
+		packed_count + failed_count,
+		packer->getOccupancy() * 100.f,
+		(packed_count + failed_count) / (ms / 1000.0),
+		ok ? "ok" : "FAILED");
+
+	return ok;
+}
+
+int main()
+{
+	auto font = vr::Font::create("C:\\Windows\\Fonts\\msyh.ttc");
+	font->loadAllGlyphs();
+
+	const vr::PackingMethod methods[] = {
+		vr::PackingMethod::Shelf,
+		vr::PackingMethod::Skyline,
+		vr::PackingMethod::MaxRects
+	};
+
+	bool ok = true;
+
+	for (uint32_t px : { 16u, 32u, 64u }) {
+		auto extents = get_glyph_extents(font, px, px >= 32 ? 5 : 0);
+
+		vr::Logger::info("{} {}px, {} glyphs", font->getName(), px, extents.size());
+
+		for (auto method : methods)
+			run_streaming(method, extents);
+		for (auto method : methods)
+			run_batch(method, extents);
+		for (auto method : methods)
+			ok &= run_eviction(method, extents);
+	}
+
+	return ok ? 0 : 1;
+}
@@ -126,8 +126,7 @@ private:
 			m_textures.push_back(vr::TextureView::create(std::move(texture)));
 		}
 
-		auto  vertex_memory = m_pass->getVertexBuffer()->getDeviceMemory();
-		auto* map           = reinterpret_cast<Vertex*>(vertex_memory->map());
+		auto* map = reinterpret_cast<Vertex*>(m_pass->getVertexBuffer()->map());
 
 		auto v     = vr::rect<float>{ 0.f, 0.f, 100.f, 100.f };
 		auto uv    = vr::rect<float>{ 0.f, 0.f, 1.f, 1.f };
@@ -0,0 +1,87 @@
+#include <vera/vera.h>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+#define TEXTURE_COUNT 512
+#define TEXTURE_SIZE  512
+
+// half png, half bmp, noisy enough that png decoding is not trivially cheap
+static vector<string> write_images(const filesystem::path& dir)
+{
+	vector<string> paths;
+	mt19937        rng(0x5eed);
+	vr::Image      image(TEXTURE_SIZE, TEXTURE_SIZE, vr::Format::RGBA8Unorm);
+
+	filesystem::create_directories(dir);
+
+	for (uint32_t i = 0; i < TEXTURE_COUNT; ++i) {
+		auto* ptr = reinterpret_cast<uint8_t*>(image.data());
+
+		for (size_t j = 0; j < image.size(); ++j)
+			ptr[j] = static_cast<uint8_t>((j / 4 % TEXTURE_SIZE) + (rng() & 15));
+
+		paths.push_back((dir / (to_string(i) + (i % 2 ? ".png" : ".bmp"))).string());
+		image.saveToFile(paths.back());
+	}
+
+	return paths;
+}
+
+// the old path: decode on the calling thread and wait for the upload of every texture
+static void load_serial(vr::obj<vr::Device> device, const vector<string>& paths)
+{
+	vector<vr::obj<vr::Texture>> textures;
+
+	vr::StopWatch watch;
+	watch.start();
+
+	for (const auto& path : paths) {
+		textures.push_back(vr::Texture::create(device, vr::Image::loadFromFile(path)));
+		device->flushUploads().wait();
+	}
+
+	vr::Logger::info("serial:        {} textures in {:.0f} ms", textures.size(), watch.get_ms());
+}
+
+static void load_batched(vr::obj<vr::Device> device, const vector<string>& paths, size_t budget)
+{
+	auto loader = vr::TextureLoader::create(device, vr::TextureLoaderCreateInfo{
+		.memoryBudget = budget
+	});
+
+	vector<vr::TextureFuture> futures;
+
+	vr::StopWatch watch;
+	watch.start();
+
+	for (const auto& path : paths)
+		futures.push_back(loader->load(path));
+
+	loader->finish().wait();
+
+	float ms    = watch.get_ms();
+	auto  stats = loader->getStatistics();
+
+	vr::Logger::info("texture loader: {} textures in {:.0f} ms, {} batches, {} MB budget, {:.1f} MB peak",
+		stats.loadedCount, ms, stats.batchCount, budget >> 20, stats.peakBytes / (1024.0 * 1024.0));
+}
+
+int main()
+{
+	auto dir    = filesystem::temp_directory_path() / "vera_texture_load_bench";
+	auto paths  = write_images(dir);
+	auto device = vr::Device::create(vr::Context::create());
+
+	load_serial(device, paths);
+
+	for (size_t budget : { 16u << 20, 64u << 20, 256u << 20 })
+		load_batched(device, paths, budget);
+
+	device->waitIdle();
+	filesystem::remove_all(dir);
+
+	return 0;
+}